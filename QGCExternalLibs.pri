@@ -105,6 +105,7 @@ DEFINES += NOMINMAX
 # [REQUIRED] shapelib library
 INCLUDEPATH += libs/shapelib
 SOURCES += \
+    libs/shapelib/dbfopen.c \
     libs/shapelib/shpopen.c \
     libs/shapelib/safileio.c
 
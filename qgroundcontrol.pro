@@ -463,21 +463,27 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory { APMFirmwarePlugin {
         src/qgcunittest
 
     HEADERS += \
+        src/AnalyzeView/MAVLinkChartDataTest.h \
+        src/AnalyzeView/ULogFileTest.h \
         src/Audio/AudioOutputTest.h \
         src/FactSystem/FactSystemTestBase.h \
         src/FactSystem/FactSystemTestGeneric.h \
         src/FactSystem/FactSystemTestPX4.h \
         src/FactSystem/ParameterManagerTest.h \
+        src/FirmwarePlugin/ParameterMetaDataIndexTest.h \
         src/MissionManager/CameraCalcTest.h \
         src/MissionManager/CameraSectionTest.h \
         src/MissionManager/CorridorScanComplexItemTest.h \
         src/MissionManager/FWLandingPatternTest.h \
+        src/MissionManager/GeoFenceIndexBenchmark.h \
+        src/MissionManager/GeoFenceIndexTest.h \
         src/MissionManager/MissionCommandTreeTest.h \
         src/MissionManager/MissionControllerManagerTest.h \
         src/MissionManager/MissionControllerTest.h \
         src/MissionManager/MissionItemTest.h \
         src/MissionManager/MissionManagerTest.h \
         src/MissionManager/MissionSettingsTest.h \
+        src/MissionManager/PlanCacheTest.h \
         src/MissionManager/PlanMasterControllerTest.h \
         src/MissionManager/QGCMapPolygonTest.h \
         src/MissionManager/QGCMapPolylineTest.h \
@@ -486,18 +492,34 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory { APMFirmwarePlugin {
         src/MissionManager/SpeedSectionTest.h \
         src/MissionManager/StructureScanComplexItemTest.h \
         src/MissionManager/SurveyComplexItemTest.h \
+        src/MissionManager/SurveyCoverageTest.h \
         src/MissionManager/TransectStyleComplexItemTest.h \
         src/MissionManager/VisualMissionItemTest.h \
+        src/Terrain/TerrainQueryTest.h \
+        src/qgcunittest/FileManagerStreamTest.h \
+        src/qgcunittest/FileRangeSetTest.h \
         src/qgcunittest/GeoTest.h \
         src/qgcunittest/LinkManagerTest.h \
         src/qgcunittest/MavlinkLogTest.h \
         src/qgcunittest/MultiSignalSpy.h \
+        src/qgcunittest/QGCFrameSchedulerTest.h \
+        src/qgcunittest/ShapeFileImporterTest.h \
         src/qgcunittest/TCPLinkTest.h \
+        src/qgcunittest/TLogExporterTest.h \
+        src/qgcunittest/TLogIndexTest.h \
         src/qgcunittest/TCPLoopBackServer.h \
         src/qgcunittest/UnitTest.h \
+        src/Vehicle/CameraTriggerPointsTest.h \
+        src/Vehicle/FactGroupBenchmark.h \
+        src/Vehicle/FactGroupTest.h \
+        src/Vehicle/GeoFenceBreachMonitorTest.h \
+        src/Vehicle/MultiVehicleManagerTest.h \
+        src/Vehicle/ObserverVehicleTableBenchmark.h \
+        src/Vehicle/ObserverVehicleTableTest.h \
         src/Vehicle/SendMavCommandTest.h \
+        src/Vehicle/TrajectoryStoreTest.h \
         #src/qgcunittest/RadioConfigTest.h \
-        #src/AnalyzeView/LogDownloadTest.h \
+        src/AnalyzeView/LogDownloadTest.h \
         #src/qgcunittest/FileDialogTest.h \
         #src/qgcunittest/FileManagerTest.h \
         #src/qgcunittest/FlightGearTest.h \
@@ -505,21 +527,27 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory { APMFirmwarePlugin {
         #src/qgcunittest/MessageBoxTest.h \
 
     SOURCES += \
+        src/AnalyzeView/MAVLinkChartDataTest.cc \
+        src/AnalyzeView/ULogFileTest.cc \
         src/Audio/AudioOutputTest.cc \
         src/FactSystem/FactSystemTestBase.cc \
         src/FactSystem/FactSystemTestGeneric.cc \
         src/FactSystem/FactSystemTestPX4.cc \
         src/FactSystem/ParameterManagerTest.cc \
+        src/FirmwarePlugin/ParameterMetaDataIndexTest.cc \
         src/MissionManager/CameraCalcTest.cc \
         src/MissionManager/CameraSectionTest.cc \
         src/MissionManager/CorridorScanComplexItemTest.cc \
         src/MissionManager/FWLandingPatternTest.cc \
+        src/MissionManager/GeoFenceIndexBenchmark.cc \
+        src/MissionManager/GeoFenceIndexTest.cc \
         src/MissionManager/MissionCommandTreeTest.cc \
         src/MissionManager/MissionControllerManagerTest.cc \
         src/MissionManager/MissionControllerTest.cc \
         src/MissionManager/MissionItemTest.cc \
         src/MissionManager/MissionManagerTest.cc \
         src/MissionManager/MissionSettingsTest.cc \
+        src/MissionManager/PlanCacheTest.cc \
         src/MissionManager/PlanMasterControllerTest.cc \
         src/MissionManager/QGCMapPolygonTest.cc \
         src/MissionManager/QGCMapPolylineTest.cc \
@@ -528,19 +556,35 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory { APMFirmwarePlugin {
         src/MissionManager/SpeedSectionTest.cc \
         src/MissionManager/StructureScanComplexItemTest.cc \
         src/MissionManager/SurveyComplexItemTest.cc \
+        src/MissionManager/SurveyCoverageTest.cc \
         src/MissionManager/TransectStyleComplexItemTest.cc \
         src/MissionManager/VisualMissionItemTest.cc \
+        src/Terrain/TerrainQueryTest.cc \
+        src/qgcunittest/FileManagerStreamTest.cc \
+        src/qgcunittest/FileRangeSetTest.cc \
         src/qgcunittest/GeoTest.cc \
         src/qgcunittest/LinkManagerTest.cc \
         src/qgcunittest/MavlinkLogTest.cc \
         src/qgcunittest/MultiSignalSpy.cc \
+        src/qgcunittest/QGCFrameSchedulerTest.cc \
+        src/qgcunittest/ShapeFileImporterTest.cc \
         src/qgcunittest/TCPLinkTest.cc \
+        src/qgcunittest/TLogExporterTest.cc \
+        src/qgcunittest/TLogIndexTest.cc \
         src/qgcunittest/TCPLoopBackServer.cc \
         src/qgcunittest/UnitTest.cc \
         src/qgcunittest/UnitTestList.cc \
+        src/Vehicle/CameraTriggerPointsTest.cc \
+        src/Vehicle/FactGroupBenchmark.cc \
+        src/Vehicle/FactGroupTest.cc \
+        src/Vehicle/GeoFenceBreachMonitorTest.cc \
+        src/Vehicle/MultiVehicleManagerTest.cc \
+        src/Vehicle/ObserverVehicleTableBenchmark.cc \
+        src/Vehicle/ObserverVehicleTableTest.cc \
         src/Vehicle/SendMavCommandTest.cc \
+        src/Vehicle/TrajectoryStoreTest.cc \
         #src/qgcunittest/RadioConfigTest.cc \
-        #src/AnalyzeView/LogDownloadTest.cc \
+        src/AnalyzeView/LogDownloadTest.cc \
         #src/qgcunittest/FileDialogTest.cc \
         #src/qgcunittest/FileManagerTest.cc \
         #src/qgcunittest/FlightGearTest.cc \
@@ -556,6 +600,7 @@ HEADERS += \
     src/ADSB/ADSBVehicleManager.h \
     src/AnalyzeView/LogDownloadController.h \
     src/AnalyzeView/PX4LogParser.h \
+    src/AnalyzeView/ULogFile.h \
     src/AnalyzeView/ULogParser.h \
     src/AnalyzeView/MavlinkConsoleController.h \
     src/Audio/AudioOutput.h \
@@ -571,7 +616,6 @@ HEADERS += \
     src/Joystick/JoystickManager.h \
     src/JsonHelper.h \
     src/KMLFileHelper.h \
-    src/LogCompressor.h \
     src/MissionManager/CameraCalc.h \
     src/MissionManager/CameraSection.h \
     src/MissionManager/CameraSpec.h \
@@ -581,6 +625,7 @@ HEADERS += \
     src/MissionManager/BlankPlanCreator.h \
     src/MissionManager/FixedWingLandingComplexItem.h \
     src/MissionManager/GeoFenceController.h \
+    src/MissionManager/GeoFenceIndex.h \
     src/MissionManager/GeoFenceManager.h \
     src/MissionManager/KML.h \
     src/MissionManager/MissionCommandList.h \
@@ -592,6 +637,7 @@ HEADERS += \
     src/MissionManager/MissionSettingsItem.h \
     src/MissionManager/PlanElementController.h \
     src/MissionManager/PlanCreator.h \
+    src/MissionManager/PlanCache.h \
     src/MissionManager/PlanManager.h \
     src/MissionManager/PlanMasterController.h \
     src/MissionManager/QGCFenceCircle.h \
@@ -608,6 +654,7 @@ HEADERS += \
     src/MissionManager/StructureScanComplexItem.h \
     src/MissionManager/StructureScanPlanCreator.h \
     src/MissionManager/SurveyComplexItem.h \
+    src/MissionManager/SurveyCoverage.h \
     src/MissionManager/SurveyPlanCreator.h \
     src/MissionManager/TakeoffMissionItem.h \
     src/MissionManager/TransectStyleComplexItem.h \
@@ -627,6 +674,7 @@ HEADERS += \
     src/QGCComboBox.h \
     src/QGCConfig.h \
     src/QGCFileDownload.h \
+    src/QGCFrameScheduler.h \
     src/QGCLoggingCategory.h \
     src/QGCMapPalette.h \
     src/QGCPalette.h \
@@ -660,13 +708,19 @@ HEADERS += \
     src/Settings/UnitsSettings.h \
     src/Settings/VideoSettings.h \
     src/ShapeFileHelper.h \
+    src/ShapeFileImporter.h \
     src/SHPFileHelper.h \
     src/Terrain/TerrainQuery.h \
     src/TerrainTile.h \
+    src/TLogExporter.h \
+    src/Vehicle/CameraTriggerPoints.h \
+    src/Vehicle/GeoFenceBreachMonitor.h \
     src/Vehicle/GPSRTKFactGroup.h \
     src/Vehicle/MAVLinkLogManager.h \
     src/Vehicle/MultiVehicleManager.h \
+    src/Vehicle/ObserverVehicleTable.h \
     src/Vehicle/TrajectoryPoints.h \
+    src/Vehicle/TrajectoryStore.h \
     src/Vehicle/Vehicle.h \
     src/Vehicle/VehicleObjectAvoidance.h \
     src/VehicleSetup/JoystickConfigController.h \
@@ -677,6 +731,7 @@ HEADERS += \
     src/comm/MAVLinkProtocol.h \
     src/comm/QGCMAVLink.h \
     src/comm/TCPLink.h \
+    src/comm/TLogIndex.h \
     src/comm/UDPLink.h \
     src/comm/UdpIODevice.h \
     src/uas/UAS.h \
@@ -685,6 +740,7 @@ HEADERS += \
     src/AnalyzeView/GeoTagController.h \
     src/AnalyzeView/ExifParser.h \
     src/uas/FileManager.h \
+    src/uas/FileRangeSet.h \
 
 contains (DEFINES, QGC_ENABLE_PAIRING) {
     HEADERS += \
@@ -764,6 +820,7 @@ SOURCES += \
     src/ADSB/ADSBVehicleManager.cc \
     src/AnalyzeView/LogDownloadController.cc \
     src/AnalyzeView/PX4LogParser.cc \
+    src/AnalyzeView/ULogFile.cc \
     src/AnalyzeView/ULogParser.cc \
     src/AnalyzeView/MavlinkConsoleController.cc \
     src/Audio/AudioOutput.cc \
@@ -778,7 +835,6 @@ SOURCES += \
     src/Joystick/JoystickManager.cc \
     src/JsonHelper.cc \
     src/KMLFileHelper.cc \
-    src/LogCompressor.cc \
     src/MissionManager/CameraCalc.cc \
     src/MissionManager/CameraSection.cc \
     src/MissionManager/CameraSpec.cc \
@@ -788,6 +844,7 @@ SOURCES += \
     src/MissionManager/BlankPlanCreator.cc \
     src/MissionManager/FixedWingLandingComplexItem.cc \
     src/MissionManager/GeoFenceController.cc \
+    src/MissionManager/GeoFenceIndex.cc \
     src/MissionManager/GeoFenceManager.cc \
     src/MissionManager/KML.cc \
     src/MissionManager/MissionCommandList.cc \
@@ -799,6 +856,7 @@ SOURCES += \
     src/MissionManager/MissionSettingsItem.cc \
     src/MissionManager/PlanElementController.cc \
     src/MissionManager/PlanCreator.cc \
+    src/MissionManager/PlanCache.cc \
     src/MissionManager/PlanManager.cc \
     src/MissionManager/PlanMasterController.cc \
     src/MissionManager/QGCFenceCircle.cc \
@@ -814,6 +872,7 @@ SOURCES += \
     src/MissionManager/StructureScanComplexItem.cc \
     src/MissionManager/StructureScanPlanCreator.cc \
     src/MissionManager/SurveyComplexItem.cc \
+    src/MissionManager/SurveyCoverage.cc \
     src/MissionManager/SurveyPlanCreator.cc \
     src/MissionManager/TakeoffMissionItem.cc \
     src/MissionManager/TransectStyleComplexItem.cc \
@@ -831,6 +890,7 @@ SOURCES += \
     src/QGCApplication.cc \
     src/QGCComboBox.cc \
     src/QGCFileDownload.cc \
+    src/QGCFrameScheduler.cc \
     src/QGCLoggingCategory.cc \
     src/QGCMapPalette.cc \
     src/QGCPalette.cc \
@@ -864,13 +924,19 @@ SOURCES += \
     src/Settings/UnitsSettings.cc \
     src/Settings/VideoSettings.cc \
     src/ShapeFileHelper.cc \
+    src/ShapeFileImporter.cc \
     src/SHPFileHelper.cc \
     src/Terrain/TerrainQuery.cc \
     src/TerrainTile.cc\
+    src/TLogExporter.cc \
+    src/Vehicle/CameraTriggerPoints.cc \
+    src/Vehicle/GeoFenceBreachMonitor.cc \
     src/Vehicle/GPSRTKFactGroup.cc \
     src/Vehicle/MAVLinkLogManager.cc \
     src/Vehicle/MultiVehicleManager.cc \
+    src/Vehicle/ObserverVehicleTable.cc \
     src/Vehicle/TrajectoryPoints.cc \
+    src/Vehicle/TrajectoryStore.cc \
     src/Vehicle/Vehicle.cc \
     src/Vehicle/VehicleObjectAvoidance.cc \
     src/VehicleSetup/JoystickConfigController.cc \
@@ -881,6 +947,7 @@ SOURCES += \
     src/comm/MAVLinkProtocol.cc \
     src/comm/QGCMAVLink.cc \
     src/comm/TCPLink.cc \
+    src/comm/TLogIndex.cc \
     src/comm/UDPLink.cc \
     src/comm/UdpIODevice.cc \
     src/main.cc \
@@ -889,6 +956,7 @@ SOURCES += \
     src/AnalyzeView/GeoTagController.cc \
     src/AnalyzeView/ExifParser.cc \
     src/uas/FileManager.cc \
+    src/uas/FileRangeSet.cc \
 
 contains (DEFINES, QGC_ENABLE_PAIRING) {
     SOURCES += \
@@ -957,6 +1025,7 @@ HEADERS+= \
     src/FirmwarePlugin/CameraMetaData.h \
     src/FirmwarePlugin/FirmwarePlugin.h \
     src/FirmwarePlugin/FirmwarePluginManager.h \
+    src/FirmwarePlugin/ParameterMetaDataIndex.h \
     src/VehicleSetup/VehicleComponent.h \
 
 !MobileBuild { !NoSerialBuild {
@@ -979,6 +1048,7 @@ SOURCES += \
     src/FirmwarePlugin/CameraMetaData.cc \
     src/FirmwarePlugin/FirmwarePlugin.cc \
     src/FirmwarePlugin/FirmwarePluginManager.cc \
+    src/FirmwarePlugin/ParameterMetaDataIndex.cc \
     src/VehicleSetup/VehicleComponent.cc \
 
 !MobileBuild { !NoSerialBuild {
@@ -1137,7 +1207,9 @@ HEADERS += \
     src/FactSystem/FactGroup.h \
     src/FactSystem/FactMetaData.h \
     src/FactSystem/FactSystem.h \
+    src/FactSystem/FactValue.h \
     src/FactSystem/FactValueSliderListModel.h \
+    src/FactSystem/PackedParameterFile.h \
     src/FactSystem/ParameterManager.h \
     src/FactSystem/SettingsFact.h \
 
@@ -1147,7 +1219,9 @@ SOURCES += \
     src/FactSystem/FactGroup.cc \
     src/FactSystem/FactMetaData.cc \
     src/FactSystem/FactSystem.cc \
+    src/FactSystem/FactValue.cc \
     src/FactSystem/FactValueSliderListModel.cc \
+    src/FactSystem/PackedParameterFile.cc \
     src/FactSystem/ParameterManager.cc \
     src/FactSystem/SettingsFact.cc \
 
@@ -1155,8 +1229,10 @@ SOURCES += \
 # MAVLink Inspector
 contains (DEFINES, QGC_ENABLE_MAVLINK_INSPECTOR) {
     HEADERS += \
+        src/AnalyzeView/MAVLinkChartData.h \
         src/AnalyzeView/MAVLinkInspectorController.h
     SOURCES += \
+        src/AnalyzeView/MAVLinkChartData.cc \
         src/AnalyzeView/MAVLinkInspectorController.cc
     QT += \
         charts
@@ -12,6 +12,7 @@
 #include "QGCApplication.h"
 #include "SettingsManager.h"
 #include "ADSBVehicleManagerSettings.h"
+#include "QGCFrameScheduler.h"
 
 #include <QDebug>
 
@@ -24,9 +25,7 @@ void ADSBVehicleManager::setToolbox(QGCToolbox* toolbox)
 {
     QGCTool::setToolbox(toolbox);
 
-    connect(&_adsbVehicleCleanupTimer, &QTimer::timeout, this, &ADSBVehicleManager::_cleanupStaleVehicles);
-    _adsbVehicleCleanupTimer.setSingleShot(false);
-    _adsbVehicleCleanupTimer.start(1000);
+    toolbox->frameScheduler()->registerTask(this, 1000, [this]() { _cleanupStaleVehicles(); });
 
     ADSBVehicleManagerSettings* settings = qgcApp()->toolbox()->settingsManager()->adsbVehicleManagerSettings();
     if (settings->adsbServerConnectEnabled()->rawValue().toBool()) {
@@ -70,6 +70,5 @@ private slots:
 private:
     QmlObjectListModel              _adsbVehicles;
     QMap<uint32_t, ADSBVehicle*>    _adsbICAOMap;
-    QTimer                          _adsbVehicleCleanupTimer;
     ADSBTCPLink*                    _tcpLink = nullptr;
 };
@@ -23,20 +23,30 @@
 #include <QSettings>
 #include <QUrl>
 #include <QBitArray>
+#include <QDataStream>
 #include <QtCore/qmath.h>
 
-#define kTimeOutMilliseconds 500
-#define kGUIRateMilliseconds 17
-#define kTableBins           512
-#define kChunkSize           (kTableBins * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN)
+#define kTimeOutMilliseconds    500
+#define kGUIRateMilliseconds    17
+#define kBinSize                MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN
+#define kMinRequestBins         16
+#define kInitialRequestBins     512
+#define kMaxRequestBins         8192
+#define kRequestMilliseconds    2000                // Size requests to cover this much time at the measured data rate
+#define kWriteBufferSize        (64 * 1024)
+#define kResumeFileSuffix       ".resume"
+#define kResumeFileMagic        0x4c524553          // "LRES"
 
 QGC_LOGGING_CATEGORY(LogDownloadLog, "LogDownloadLog")
 
 //-----------------------------------------------------------------------------
 struct LogDownloadData {
     LogDownloadData(QGCLogEntry* entry);
-    QBitArray     chunk_table;
-    uint32_t      current_chunk;
+    QBitArray     bin_table;        ///< One bit per kBinSize bin for the whole file
+    uint32_t      bins_received;
+    uint32_t      first_missing;    ///< No bins before this one are missing
+    uint32_t      request_end;      ///< One past the last bin of the outstanding request
+    uint32_t      request_bins;     ///< Number of bins to ask for in the next request
     QFile         file;
     QString       filename;
     uint          ID;
@@ -45,41 +55,99 @@ struct LogDownloadData {
     size_t        rate_bytes;
     qreal         rate_avg;
     QElapsedTimer elapsed;
+    QByteArray    write_buffer;     ///< Contiguous data waiting to be written to file
+    uint32_t      write_offset;     ///< File offset of the first byte in write_buffer
 
-    void advanceChunk()
+    // The number of kBinSize bins in the file
+    uint32_t numBins() const
     {
-           current_chunk++;
-           chunk_table = QBitArray(chunkBins(), false);
+        return qCeil(entry->size() / static_cast<qreal>(kBinSize));
     }
 
-    // The number of MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bins in the current chunk
-    uint32_t chunkBins() const
+    bool complete() const
     {
-        return qMin(qCeil((entry->size() - current_chunk*kChunkSize)/static_cast<qreal>(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN)),
-                    kTableBins);
+        return bins_received == static_cast<uint32_t>(bin_table.size());
     }
 
-    // The number of kChunkSize chunks in the file
-    uint32_t numChunks() const
+    QString resumeFileName() const
     {
-        return qCeil(entry->size() / static_cast<qreal>(kChunkSize));
+        return file.fileName() + QStringLiteral(kResumeFileSuffix);
     }
 
-    // True if all bins in the chunk have been set to val
-    bool chunkEquals(const bool val) const
+    // Queues data for writing. Packets usually arrive in order so they are coalesced into a single write.
+    bool write(uint32_t ofs, const uint8_t* data, uint8_t count)
     {
-        return chunk_table == QBitArray(chunk_table.size(), val);
+        if (!write_buffer.isEmpty() && ofs != write_offset + static_cast<uint32_t>(write_buffer.size())) {
+            if (!flush()) {
+                return false;
+            }
+        }
+        if (write_buffer.isEmpty()) {
+            write_offset = ofs;
+        }
+        write_buffer.append(reinterpret_cast<const char*>(data), count);
+        return write_buffer.size() < kWriteBufferSize || flush();
+    }
+
+    bool flush()
+    {
+        if (write_buffer.isEmpty()) {
+            return true;
+        }
+        if (!file.seek(write_offset) || file.write(write_buffer) != write_buffer.size()) {
+            return false;
+        }
+        write_buffer.clear();
+        return true;
+    }
+
+    // Saves the received bin table next to the partial file so an interrupted download can be picked up again
+    void saveResumeState()
+    {
+        if (!flush()) {
+            return;
+        }
+        QFile resumeFile(resumeFileName());
+        if (resumeFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            QDataStream ds(&resumeFile);
+            ds << static_cast<quint32>(kResumeFileMagic) << static_cast<quint32>(ID) << static_cast<quint32>(entry->size()) << entry->time() << bin_table;
+        }
     }
 
+    bool loadResumeState()
+    {
+        QFile resumeFile(resumeFileName());
+        if (!resumeFile.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        QDataStream ds(&resumeFile);
+        quint32     magic, id, size;
+        QDateTime   time;
+        QBitArray   bins;
+        ds >> magic >> id >> size >> time >> bins;
+        if (ds.status() != QDataStream::Ok || magic != kResumeFileMagic || id != ID || size != entry->size() || time != entry->time() ||
+                bins.size() != static_cast<int>(numBins())) {
+            return false;
+        }
+        bin_table = bins;
+        bins_received = static_cast<uint32_t>(bin_table.count(true));
+        written = qMin(bins_received * kBinSize, entry->size());
+        return true;
+    }
 };
 
 //----------------------------------------------------------------------------------------
 LogDownloadData::LogDownloadData(QGCLogEntry* entry_)
-    : ID(entry_->id())
+    : bins_received(0)
+    , first_missing(0)
+    , request_end(0)
+    , request_bins(kInitialRequestBins)
+    , ID(entry_->id())
     , entry(entry_)
     , written(0)
     , rate_bytes(0)
     , rate_avg(0)
+    , write_offset(0)
 {
 
 }
@@ -134,6 +202,7 @@ void
 LogDownloadController::_setActiveVehicle(Vehicle* vehicle)
 {
     if(_uas) {
+        _suspendDownload();
         _logEntriesModel.clear();
         disconnect(_uas, &UASInterface::logEntry, this, &LogDownloadController::_logEntry);
         disconnect(_uas, &UASInterface::logData,  this, &LogDownloadController::_logData);
@@ -325,80 +394,66 @@ LogDownloadController::_logData(UASInterface* uas, uint32_t ofs, uint16_t id, ui
         return;
     }
 
-    if ((ofs % MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) != 0) {
+    if ((ofs % kBinSize) != 0) {
         qWarning() << "Ignored misaligned incoming packet @" << ofs;
         return;
     }
 
-    bool result = false;
-    uint32_t timeout_time = kTimeOutMilliseconds;
-    if(ofs <= _downloadData->entry->size()) {
-        const uint32_t chunk = ofs / kChunkSize;
-        if (chunk != _downloadData->current_chunk) {
-            qWarning() << "Ignored packet for out of order chunk actual:expected" << chunk << _downloadData->current_chunk;
+    if(ofs >= _downloadData->entry->size() || count == 0) {
+        qWarning() << "Received log offset greater than expected";
+        return;
+    }
+
+    //-- Data for any offset is accepted, the bin table covers the whole file
+    const uint32_t bin = ofs / kBinSize;
+    const bool newBin = !_downloadData->bin_table.testBit(bin);
+    if (newBin) {
+        if(!_downloadData->write(ofs, data, count)) {
+            qWarning() << "Error while writing log file chunk";
+            _downloadData->entry->setStatus(tr("Error"));
             return;
         }
-        const uint16_t bin = (ofs - chunk*kChunkSize) / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
-        if (bin >= _downloadData->chunk_table.size()) {
-            qWarning() << "Out of range bin received";
-        } else
-            _downloadData->chunk_table.setBit(bin);
-        if (_downloadData->file.pos() != ofs) {
-            // Seek to correct position
-            if (!_downloadData->file.seek(ofs)) {
-                qWarning() << "Error while seeking log file offset";
-                return;
-            }
-        }
+        _downloadData->bin_table.setBit(bin);
+        _downloadData->bins_received++;
+        _downloadData->written += count;
+        _downloadData->rate_bytes += count;
+        _updateDataRate();
+    }
 
-        //-- Write chunk to file
-        if(_downloadData->file.write((const char*)data, count)) {
-            _downloadData->written += count;
-            _downloadData->rate_bytes += count;
-            _updateDataRate();
-            result = true;
-            //-- reset retries
-            _retries = 0;
-            //-- Reset timer
-            _timer.start(timeout_time);
-            //-- Do we have it all?
-            if(_logComplete()) {
-                _downloadData->entry->setStatus(tr("Downloaded"));
-                //-- Check for more
-                _receivedAllData();
-            } else if (_chunkComplete()) {
-                _downloadData->advanceChunk();
-                _requestLogData(_downloadData->ID,
-                                _downloadData->current_chunk*kChunkSize,
-                                _downloadData->chunk_table.size()*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-            } else if (bin < _downloadData->chunk_table.size() - 1 && _downloadData->chunk_table.at(bin+1)) {
-                // Likely to be grabbing fragments and got to the end of a gap
-                _findMissingData();
-            }
+    //-- reset retries
+    _retries = 0;
+    //-- Reset timer
+    _timer.start(kTimeOutMilliseconds);
+
+    //-- Do we have it all?
+    if(_logComplete()) {
+        if (_downloadData->flush()) {
+            _downloadData->file.close();
+            QFile::remove(_downloadData->resumeFileName());
+            _downloadData->entry->setStatus(tr("Downloaded"));
         } else {
             qWarning() << "Error while writing log file chunk";
+            _downloadData->entry->setStatus(tr("Error"));
         }
-    } else {
-        qWarning() << "Received log offset greater than expected";
-    }
-    if(!result) {
-        _downloadData->entry->setStatus(tr("Error"));
+        //-- Check for more
+        _receivedAllData();
+    } else if (newBin && bin + 1 == _downloadData->request_end) {
+        //-- End of the current request, grow the next one to match the measured data rate. Late or repeated packets from
+        //   earlier requests must not trigger a request, the vehicle would drop the one it is still sending.
+        if (_downloadData->rate_avg > 0) {
+            _downloadData->request_bins = qBound<uint32_t>(kMinRequestBins,
+                                                           static_cast<uint32_t>(_downloadData->rate_avg * kRequestMilliseconds / 1000.0 / kBinSize),
+                                                           kMaxRequestBins);
+        }
+        _requestNextRange();
     }
 }
 
-
-//----------------------------------------------------------------------------------------
-bool
-LogDownloadController::_chunkComplete() const
-{
-    return _downloadData->chunkEquals(true);
-}
-
 //----------------------------------------------------------------------------------------
 bool
 LogDownloadController::_logComplete() const
 {
-    return _chunkComplete() && (_downloadData->current_chunk+1) == _downloadData->numChunks();
+    return _downloadData->complete();
 }
 
 //----------------------------------------------------------------------------------------
@@ -409,7 +464,7 @@ LogDownloadController::_receivedAllData()
     //-- Anything queued up for download?
     if(_prepareLogDownload()) {
         //-- Request Log
-        _requestLogData(_downloadData->ID, 0, _downloadData->chunk_table.size()*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
+        _requestNextRange();
         _timer.start(kTimeOutMilliseconds);
     } else {
         _resetSelection();
@@ -424,8 +479,6 @@ LogDownloadController::_findMissingData()
     if (_logComplete()) {
          _receivedAllData();
          return;
-    } else if (_chunkComplete()) {
-        _downloadData->advanceChunk();
     }
 
     _retries++;
@@ -443,25 +496,57 @@ LogDownloadController::_findMissingData()
 
     _updateDataRate();
 
-    uint16_t start = 0, end = 0;
-    const int size = _downloadData->chunk_table.size();
-    for (; start < size; start++) {
-        if (!_downloadData->chunk_table.testBit(start)) {
-            break;
-        }
+    //-- The link stalled, back off on the request size and keep what we have safe in case the link is gone for good
+    _downloadData->request_bins = qMax<uint32_t>(kMinRequestBins, _downloadData->request_bins / 2);
+    _downloadData->saveResumeState();
+
+    _requestNextRange();
+}
+
+//----------------------------------------------------------------------------------------
+void
+LogDownloadController::_requestNextRange()
+{
+    //-- The vehicle only services a single request at a time, so ask for the first run of missing bins. Bins which arrived
+    //   out of order are skipped by ending the request at the next bin which has already been received.
+    const uint32_t size = static_cast<uint32_t>(_downloadData->bin_table.size());
+    uint32_t start = _downloadData->first_missing;
+    while (start < size && _downloadData->bin_table.testBit(start)) {
+        start++;
+    }
+    _downloadData->first_missing = start;
+    if (start >= size) {
+        return;
     }
 
-    for (end = start; end < size; end++) {
-        if (_downloadData->chunk_table.testBit(end)) {
-            break;
-        }
+    uint32_t end = start + 1;
+    const uint32_t maxEnd = qMin(size, start + _downloadData->request_bins);
+    while (end < maxEnd && !_downloadData->bin_table.testBit(end)) {
+        end++;
     }
+    _downloadData->request_end = end;
 
-    const uint32_t pos = _downloadData->current_chunk*kChunkSize + start*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN,
-                   len = (end - start)*MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    const uint32_t pos = start * kBinSize;
+    const uint32_t len = qMin(end * kBinSize, _downloadData->entry->size()) - pos;
     _requestLogData(_downloadData->ID, pos, len, _retries);
 }
 
+//----------------------------------------------------------------------------------------
+void
+LogDownloadController::_suspendDownload()
+{
+    //-- Keep the partial file along with its resume state, downloading the same log again will pick up where we left off
+    if(_downloadData) {
+        _downloadData->saveResumeState();
+        _downloadData->file.close();
+        _downloadData->entry->setStatus(tr("Interrupted"));
+        delete _downloadData;
+        _downloadData = nullptr;
+    }
+    _timer.stop();
+    _setDownloading(false);
+}
+
 //----------------------------------------------------------------------------------------
 void
 LogDownloadController::_requestLogData(uint16_t id, uint32_t offset, uint32_t count, int retryCount)
@@ -616,6 +701,18 @@ LogDownloadController::_prepareLogDownload()
         _downloadData->filename += ".bin";
     }
     _downloadData->file.setFileName(_downloadPath + _downloadData->filename);
+    //-- Pick up an interrupted download of the same log
+    if (_downloadData->file.exists() && _downloadData->loadResumeState()) {
+        if (_downloadData->file.open(QIODevice::ReadWrite)) {
+            qCDebug(LogDownloadLog) << "Resuming log download" << _downloadData->filename << "bins received" << _downloadData->bins_received;
+            _downloadData->entry->setStatus(tr("Resuming"));
+            _downloadData->elapsed.start();
+            return true;
+        }
+        _downloadData->bin_table = QBitArray();
+        _downloadData->bins_received = 0;
+        _downloadData->written = 0;
+    }
     //-- Append a number to the end if the filename already exists
     if (_downloadData->file.exists()){
         uint num_dups = 0;
@@ -633,8 +730,7 @@ LogDownloadController::_prepareLogDownload()
         if(!_downloadData->file.resize(entry->size())) {
             qWarning() << "Failed to allocate space for log file:" <<  _downloadData->filename;
         } else {
-            _downloadData->current_chunk = 0;
-            _downloadData->chunk_table = QBitArray(_downloadData->chunkBins(), false);
+            _downloadData->bin_table = QBitArray(static_cast<int>(_downloadData->numBins()), false);
             _downloadData->elapsed.start();
             result = true;
         }
@@ -701,6 +797,7 @@ LogDownloadController::cancel(void)
         if (_downloadData->file.exists()) {
             _downloadData->file.remove();
         }
+        QFile::remove(_downloadData->resumeFileName());
         delete _downloadData;
         _downloadData = 0;
     }
@@ -145,13 +145,14 @@ private slots:
 
 private:
     bool _entriesComplete   ();
-    bool _chunkComplete     () const;
     bool _logComplete       () const;
     void _findMissingEntries();
     void _receivedAllEntries();
     void _receivedAllData   ();
     void _resetSelection    (bool canceled = false);
     void _findMissingData   ();
+    void _requestNextRange  ();
+    void _suspendDownload   ();
     void _requestLogList    (uint32_t start, uint32_t end);
     void _requestLogData    (uint16_t id, uint32_t offset, uint32_t count, int retryCount = 0);
     bool _prepareLogDownload();
@@ -12,16 +12,30 @@
 #include "MockLink.h"
 
 #include <QDir>
+#include <QTemporaryDir>
 
 LogDownloadTest::LogDownloadTest(void)
+    : _multiSpyLogDownloadController(nullptr)
 {
 
 }
 
 void LogDownloadTest::downloadTest(void)
 {
+    _downloadLog(false /* disorder */, 1);
+}
 
+/// A lost bin, swapped bins and a late repeat of an earlier bin must still produce the original file. Only the newly
+/// received last bin of a request may trigger the next one, so the lost bin is fetched with exactly one more request.
+void LogDownloadTest::_outOfOrderLatePackets(void)
+{
+    _downloadLog(true /* disorder */, 2);
+}
+
+void LogDownloadTest::_downloadLog(bool disorder, int expectedRequestCount)
+{
     _connectMockLink(MAV_AUTOPILOT_PX4);
+    _mockLink->setLogDownloadDisorder(disorder);
 
     LogDownloadController* controller = new LogDownloadController();
 
@@ -43,12 +57,12 @@ void LogDownloadTest::downloadTest(void)
 
     QGCLogModel* model = controller->model();
     QVERIFY(model);
-    qDebug() << model->count();
+    QVERIFY(model->count() > 0);
     (*model)[0]->setSelected(true);
 
-    QString downloadTo = QDir::currentPath();
-    qDebug() << "download to:" << downloadTo;
-    controller->downloadToDirectory(downloadTo);
+    QTemporaryDir downloadDir;
+    QVERIFY(downloadDir.isValid());
+    controller->downloadToDirectory(downloadDir.path());
     QVERIFY(_multiSpyLogDownloadController->waitForSignalByIndex(downloadingLogsChangedSignalIndex, 10000));
     _multiSpyLogDownloadController->clearAllSignals();
     if (controller->downloadingLogs()) {
@@ -57,10 +71,14 @@ void LogDownloadTest::downloadTest(void)
     }
     _multiSpyLogDownloadController->clearAllSignals();
 
-    QString downloadFile = QDir(downloadTo).filePath("log_0_UnknownDate.ulg");
-    QVERIFY(UnitTest::fileCompare(downloadFile, _mockLink->logDownloadFile()));
+    QCOMPARE(_mockLink->logDownloadRequestCount(), expectedRequestCount);
 
-    QFile::remove(downloadFile);
+    // The resume file is removed once the log is complete, only the log itself is left
+    QStringList downloadedFiles = QDir(downloadDir.path()).entryList(QDir::Files);
+    QCOMPARE(downloadedFiles.count(), 1);
+    QVERIFY(UnitTest::fileCompare(QDir(downloadDir.path()).filePath(downloadedFiles[0]), _mockLink->logDownloadFile()));
 
+    delete _multiSpyLogDownloadController;
+    _multiSpyLogDownloadController = nullptr;
     delete controller;
 }
@@ -24,9 +24,12 @@ private slots:
     //void init(void);
     //void cleanup(void) { _cleanup(); }
 
-    void downloadTest(void);
+    void downloadTest           (void);
+    void _outOfOrderLatePackets (void);
 
 private:
+    void _downloadLog(bool disorder, int expectedRequestCount);
+
     // LogDownloadController signals
 
     enum {
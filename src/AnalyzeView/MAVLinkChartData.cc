@@ -0,0 +1,190 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkChartData.h"
+
+#include <QtMath>
+
+MAVLinkChartData::MAVLinkChartData(void)
+    : _head         (0)
+    , _count        (0)
+    , _maxPoints    (kDefaultMaxPoints)
+    , _history      (60 * 1000)
+    , _firstSequence(0)
+    , _revision     (0)
+{
+
+}
+
+void MAVLinkChartData::clear(void)
+{
+    _points.clear();
+    _head = 0;
+    _count = 0;
+    _firstSequence = 0;
+    _minQueue.clear();
+    _maxQueue.clear();
+    _revision++;
+}
+
+void MAVLinkChartData::setMaxPoints(int maxPoints)
+{
+    _maxPoints = qMax(2, maxPoints);
+    while (_count > _maxPoints) {
+        _removeFirst();
+    }
+    _revision++;
+}
+
+qreal MAVLinkChartData::min(void) const
+{
+    return _minQueue.empty() ? 0 : _y(_minQueue.front());
+}
+
+qreal MAVLinkChartData::max(void) const
+{
+    return _maxQueue.empty() ? 0 : _y(_maxQueue.front());
+}
+
+void MAVLinkChartData::_removeFirst(void)
+{
+    if (!_minQueue.empty() && _minQueue.front() == _firstSequence) {
+        _minQueue.pop_front();
+    }
+    if (!_maxQueue.empty() && _maxQueue.front() == _firstSequence) {
+        _maxQueue.pop_front();
+    }
+    _head = (_head + 1) % _points.count();
+    _count--;
+    _firstSequence++;
+}
+
+void MAVLinkChartData::_grow(void)
+{
+    int newSize = qMin(_maxPoints, qMax(64, _points.count() * 2));
+
+    QVector<QPointF> points;
+    points.reserve(newSize);
+    for (int i=0; i<_count; i++) {
+        points.append(at(i));
+    }
+    points.resize(newSize);
+
+    _points = points;
+    _head = 0;
+}
+
+void MAVLinkChartData::append(qreal x, qreal y)
+{
+    while (_count > 0 && at(0).x() < x - _history) {
+        _removeFirst();
+    }
+    if (_count >= _maxPoints) {
+        _removeFirst();
+    }
+    if (_count == _points.count()) {
+        _grow();
+    }
+
+    _points[(_head + _count) % _points.count()] = QPointF(x, y);
+    quint64 sequence = _firstSequence + static_cast<quint64>(_count);
+    _count++;
+    _revision++;
+
+    // NaN can't be ordered so it never becomes the min or max
+    if (!qIsNaN(y)) {
+        while (!_minQueue.empty() && _y(_minQueue.back()) >= y) {
+            _minQueue.pop_back();
+        }
+        _minQueue.push_back(sequence);
+        while (!_maxQueue.empty() && _y(_maxQueue.back()) <= y) {
+            _maxQueue.pop_back();
+        }
+        _maxQueue.push_back(sequence);
+    }
+}
+
+int MAVLinkChartData::_lowerBound(qreal x) const
+{
+    int low = 0;
+    int high = _count;
+    while (low < high) {
+        int mid = low + ((high - low) / 2);
+        if (at(mid).x() < x) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+void MAVLinkChartData::decimate(qreal xMin, qreal xMax, int columns, QVector<QPointF>& points) const
+{
+    points.clear();
+    if (_count == 0 || xMax <= xMin) {
+        return;
+    }
+
+    // Include the samples just outside the range so the line runs to the edges of the chart
+    int first = qMax(0, _lowerBound(xMin) - 1);
+    int last = qMin(_count, _lowerBound(xMax) + 1);
+    if (first >= last) {
+        return;
+    }
+
+    columns = qMax(1, columns);
+    if (last - first <= columns * 4) {
+        points.reserve(last - first);
+        for (int i=first; i<last; i++) {
+            points.append(at(i));
+        }
+        return;
+    }
+
+    points.reserve(columns * 4 + 2);
+
+    const qreal columnWidth = (xMax - xMin) / columns;
+    auto columnForX = [xMin, columnWidth, columns](qreal x) {
+        return qBound(-1, static_cast<int>(qFloor((x - xMin) / columnWidth)), columns);
+    };
+
+    int i = first;
+    while (i < last) {
+        const int column = columnForX(at(i).x());
+        const int firstIndex = i;
+        int minIndex = i;
+        int maxIndex = i;
+
+        for (i++; i < last && columnForX(at(i).x()) == column; i++) {
+            const qreal y = at(i).y();
+            if (y < at(minIndex).y()) {
+                minIndex = i;
+            }
+            if (y > at(maxIndex).y()) {
+                maxIndex = i;
+            }
+        }
+        const int lastIndex = i - 1;
+
+        // Output in time order so the line doesn't double back on itself
+        const int lowIndex = qMin(minIndex, maxIndex);
+        const int highIndex = qMax(minIndex, maxIndex);
+        points.append(at(firstIndex));
+        if (lowIndex != firstIndex) {
+            points.append(at(lowIndex));
+        }
+        if (highIndex != lowIndex && highIndex != lastIndex) {
+            points.append(at(highIndex));
+        }
+        if (lastIndex != firstIndex) {
+            points.append(at(lastIndex));
+        }
+    }
+}
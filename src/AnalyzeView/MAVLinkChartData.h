@@ -0,0 +1,72 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QPointF>
+#include <QVector>
+
+#include <deque>
+
+/// Time series storage for a single MAVLink Inspector chart field.
+///
+/// Samples are kept in a ring buffer which holds a configurable amount of history. The minimum and maximum of the samples
+/// currently held are tracked with monotonic queues so auto ranging costs O(1) amortized per sample instead of a rescan of
+/// the whole buffer. Points handed to the chart are decimated to at most four points per pixel column (first, min, max, last)
+/// which keeps the plotted shape, including spikes, while bounding the work done by the chart for high rate fields.
+class MAVLinkChartData
+{
+public:
+    MAVLinkChartData(void);
+
+    /// Adds a new sample. Samples must be added in increasing x order.
+    void    append          (qreal x, qreal y);
+    void    clear           (void);
+
+    /// Sets the amount of history, in x units, to keep. Older samples are discarded as new samples arrive.
+    void    setHistory      (qreal history) { _history = history; }
+    qreal   history         (void) const    { return _history; }
+
+    /// Sets the hard limit on the number of samples held regardless of history
+    void    setMaxPoints    (int maxPoints);
+    int     maxPoints       (void) const    { return _maxPoints; }
+
+    int     count           (void) const    { return _count; }
+    QPointF at              (int index) const { return _points[(_head + index) % _points.count()]; }
+
+    /// @return true: min/max are valid (at least one non-NaN sample held)
+    bool    hasRange        (void) const    { return !_minQueue.empty(); }
+    qreal   min             (void) const;
+    qreal   max             (void) const;
+
+    /// Incremented each time the samples change. Used to skip redrawing unchanged series.
+    quint64 revision        (void) const    { return _revision; }
+
+    /// Returns the samples within [xMin, xMax] reduced to at most four points per column
+    ///     @param columns Number of pixel columns the range is drawn into
+    void    decimate        (qreal xMin, qreal xMax, int columns, QVector<QPointF>& points) const;
+
+    static const int kDefaultMaxPoints = 200 * 60 * 5;     ///< Five minutes at 200Hz
+
+private:
+    void    _removeFirst    (void);
+    void    _grow           (void);
+    qreal   _y              (quint64 sequence) const { return at(static_cast<int>(sequence - _firstSequence)).y(); }
+    int     _lowerBound     (qreal x) const;
+
+    QVector<QPointF>    _points;
+    int                 _head;
+    int                 _count;
+    int                 _maxPoints;
+    qreal               _history;
+    quint64             _firstSequence;     ///< Sequence number of the oldest sample held
+    quint64             _revision;
+    std::deque<quint64> _minQueue;          ///< Sequence numbers with increasing values, front is the minimum
+    std::deque<quint64> _maxQueue;          ///< Sequence numbers with decreasing values, front is the maximum
+};
@@ -0,0 +1,192 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkChartDataTest.h"
+#include "MAVLinkChartData.h"
+
+#include <QtMath>
+
+/// Samples beyond the point limit push out the oldest ones, across buffer growth and wrap around
+void MAVLinkChartDataTest::_ringBuffer(void)
+{
+    MAVLinkChartData data;
+
+    data.setHistory(1.0e9);
+    data.setMaxPoints(100);
+    QCOMPARE(data.count(), 0);
+
+    quint64 revision = data.revision();
+    for (int i=0; i<250; i++) {
+        data.append(i, i * 2);
+    }
+    QVERIFY(data.revision() != revision);
+    QCOMPARE(data.count(), 100);
+    for (int i=0; i<data.count(); i++) {
+        QCOMPARE(data.at(i), QPointF(150 + i, (150 + i) * 2));
+    }
+
+    // Lowering the limit drops the oldest samples
+    data.setMaxPoints(10);
+    QCOMPARE(data.count(), 10);
+    QCOMPARE(data.at(0).x(), 240.0);
+    QCOMPARE(data.at(9).x(), 249.0);
+    QCOMPARE(data.min(), 480.0);
+    QCOMPARE(data.max(), 498.0);
+
+    revision = data.revision();
+    data.clear();
+    QVERIFY(data.revision() != revision);
+    QCOMPARE(data.count(), 0);
+    QVERIFY(!data.hasRange());
+    data.append(1, 5);
+    QCOMPARE(data.count(), 1);
+    QCOMPARE(data.at(0), QPointF(1, 5));
+}
+
+void MAVLinkChartDataTest::_history(void)
+{
+    MAVLinkChartData data;
+
+    data.setHistory(5);
+    for (int i=0; i<=20; i++) {
+        data.append(i, i);
+    }
+
+    // Samples older than the history before the newest one are gone
+    QCOMPARE(data.count(), 6);
+    QCOMPARE(data.at(0).x(), 15.0);
+    QCOMPARE(data.min(), 15.0);
+    QCOMPARE(data.max(), 20.0);
+}
+
+/// The incremental range must always match a full scan of the samples held
+void MAVLinkChartDataTest::_minMax(void)
+{
+    MAVLinkChartData data;
+
+    data.setHistory(50);
+    data.setMaxPoints(40);
+
+    for (int i=0; i<2000; i++) {
+        // Runs of falling values between scattered ones exercise both ends of the monotonic queues
+        qreal y = (i / 37) % 2 ? -(i % 53) : (i * 7919) % 1000 - 500;
+        data.append(i * 0.5, y);
+
+        qreal minY = data.at(0).y();
+        qreal maxY = minY;
+        for (int j=1; j<data.count(); j++) {
+            minY = qMin(minY, data.at(j).y());
+            maxY = qMax(maxY, data.at(j).y());
+        }
+        QVERIFY(data.hasRange());
+        QCOMPARE(data.min(), minY);
+        QCOMPARE(data.max(), maxY);
+    }
+}
+
+void MAVLinkChartDataTest::_nanSamples(void)
+{
+    MAVLinkChartData data;
+
+    data.setMaxPoints(3);
+    data.append(0, qQNaN());
+    QCOMPARE(data.count(), 1);
+    QVERIFY(!data.hasRange());
+
+    data.append(1, 7);
+    data.append(2, qQNaN());
+    QVERIFY(data.hasRange());
+    QCOMPARE(data.min(), 7.0);
+    QCOMPARE(data.max(), 7.0);
+
+    // Range goes away with the last real sample
+    data.append(3, qQNaN());
+    data.append(4, qQNaN());
+    QVERIFY(!data.hasRange());
+}
+
+/// Ranges with few samples per column are passed through, including the samples just outside the range
+void MAVLinkChartDataTest::_decimateSmall(void)
+{
+    MAVLinkChartData data;
+    QVector<QPointF> points;
+
+    for (int i=0; i<20; i++) {
+        data.append(i, i);
+    }
+
+    data.decimate(5, 10, 100, points);
+    QCOMPARE(points.count(), 7);
+    QCOMPARE(points.first().x(), 4.0);
+    QCOMPARE(points.last().x(), 10.0);
+
+    data.decimate(10, 5, 100, points);
+    QVERIFY(points.isEmpty());
+
+    MAVLinkChartData().decimate(0, 10, 100, points);
+    QVERIFY(points.isEmpty());
+}
+
+void MAVLinkChartDataTest::_decimate(void)
+{
+    const int           columns = 50;
+    MAVLinkChartData    data;
+    QVector<QPointF>    points;
+
+    data.setHistory(1.0e9);
+    for (int i=0; i<10000; i++) {
+        data.append(i, qSin(i / 100.0));
+    }
+    // Single sample spikes must survive decimation
+    data.append(10000, 50);
+    data.append(10001, 0);
+    data.append(10002, -50);
+    for (int i=10003; i<20000; i++) {
+        data.append(i, qSin(i / 100.0));
+    }
+
+    data.decimate(0, 20000, columns, points);
+    QVERIFY(points.count() <= columns * 4 + 2);
+    QVERIFY(points.count() >= columns * 2);
+    QCOMPARE(points.first(), data.at(0));
+    QCOMPARE(points.last(), data.at(data.count() - 1));
+
+    bool foundMax = false;
+    bool foundMin = false;
+    for (int i=0; i<points.count(); i++) {
+        if (i > 0) {
+            QVERIFY(points[i].x() > points[i - 1].x());
+        }
+        foundMax |= points[i] == QPointF(10000, 50);
+        foundMin |= points[i] == QPointF(10002, -50);
+    }
+    QVERIFY(foundMax);
+    QVERIFY(foundMin);
+
+    // Each column keeps the extremes of its samples
+    const qreal columnWidth = 20000.0 / columns;
+    for (int column=0; column<columns; column++) {
+        qreal minY = 1000, maxY = -1000;
+        qreal pointMinY = 1000, pointMaxY = -1000;
+        for (int i=0; i<data.count(); i++) {
+            if (static_cast<int>(data.at(i).x() / columnWidth) == column) {
+                minY = qMin(minY, data.at(i).y());
+                maxY = qMax(maxY, data.at(i).y());
+            }
+        }
+        for (const QPointF& point: points) {
+            if (static_cast<int>(point.x() / columnWidth) == column) {
+                pointMinY = qMin(pointMinY, point.y());
+                pointMaxY = qMax(pointMaxY, point.y());
+            }
+        }
+        QCOMPARE(pointMinY, minY);
+        QCOMPARE(pointMaxY, maxY);
+    }
+}
@@ -0,0 +1,25 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkChartDataTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _ringBuffer        (void);
+    void _history           (void);
+    void _minMax            (void);
+    void _nanSamples        (void);
+    void _decimateSmall     (void);
+    void _decimate          (void);
+};
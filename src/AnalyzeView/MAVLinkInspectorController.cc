@@ -10,6 +10,7 @@
 #include "MAVLinkInspectorController.h"
 #include "QGCApplication.h"
 #include "MultiVehicleManager.h"
+#include "QGCFrameScheduler.h"
 #include <QtCharts/QLineSeries>
 
 QGC_LOGGING_CATEGORY(MAVLinkInspectorLog, "MAVLinkInspectorLog")
@@ -19,6 +20,7 @@ QT_CHARTS_USE_NAMESPACE
 Q_DECLARE_METATYPE(QAbstractSeries*)
 
 #define UPDATE_FREQUENCY (1000 / 15)    // 15Hz
+#define DISPLAY_FREQUENCY (1000 / 5)    // 5Hz
 
 //-----------------------------------------------------------------------------
 QGCMAVLinkMessageField::QGCMAVLinkMessageField(QGCMAVLinkMessage *parent, QString name, QString type)
@@ -38,7 +40,8 @@ QGCMAVLinkMessageField::addSeries(MAVLinkChartController* chart, QAbstractSeries
         _chart = chart;
         _pSeries = series;
         emit seriesChanged();
-        _dataIndex = 0;
+        _data.clear();
+        _data.setHistory(chart->history());
         _msg->updateFieldSelection();
     }
 }
@@ -48,9 +51,10 @@ void
 QGCMAVLinkMessageField::delSeries()
 {
     if(_pSeries) {
-        _values.clear();
+        _data.clear();
+        _seriesPoints.clear();
         QLineSeries* lineSeries = static_cast<QLineSeries*>(_pSeries);
-        lineSeries->replace(_values);
+        lineSeries->replace(_seriesPoints);
         _pSeries = nullptr;
         _chart   = nullptr;
         emit seriesChanged();
@@ -87,33 +91,24 @@ QGCMAVLinkMessageField::chartIndex()
 
 //-----------------------------------------------------------------------------
 void
-QGCMAVLinkMessageField::updateValue(QString newValue, qreal v)
+QGCMAVLinkMessageField::updateValue(const QString& newValue)
 {
     if(_value != newValue) {
         _value = newValue;
         emit valueChanged();
     }
+}
+
+//-----------------------------------------------------------------------------
+void
+QGCMAVLinkMessageField::addSample(qreal v)
+{
     if(_pSeries && _chart) {
-        int count = _values.count();
-        //-- Arbitrary limit of 1 minute of data at 50Hz for now
-        if(count < (50 * 60)) {
-            QPointF p(QGC::bootTimeMilliseconds(), v);
-            _values.append(p);
-        } else {
-            if(_dataIndex >= count) _dataIndex = 0;
-            _values[_dataIndex].setX(QGC::bootTimeMilliseconds());
-            _values[_dataIndex].setY(v);
-            _dataIndex++;
-        }
+        _data.append(QGC::bootTimeMilliseconds(), v);
         //-- Auto Range
-        if(_chart->rangeYIndex() == 0) {
-            qreal vmin  = std::numeric_limits<qreal>::max();
-            qreal vmax  = std::numeric_limits<qreal>::min();
-            for(int i = 0; i < _values.count(); i++) {
-                qreal v = _values[i].y();
-                if(vmax < v) vmax = v;
-                if(vmin > v) vmin = v;
-            }
+        if(_chart->rangeYIndex() == 0 && _data.hasRange()) {
+            qreal vmin  = _data.min();
+            qreal vmax  = _data.max();
             bool changed = false;
             if(std::abs(_rangeMin - vmin) > 0.000001) {
                 _rangeMin = vmin;
@@ -134,18 +129,19 @@ QGCMAVLinkMessageField::updateValue(QString newValue, qreal v)
 void
 QGCMAVLinkMessageField::updateSeries()
 {
-    int count = _values.count();
-    if (count > 1) {
-        QList<QPointF> s;
-        s.reserve(count);
-        int idx = _dataIndex;
-        for(int i = 0; i < count; i++, idx++) {
-            if(idx >= count) idx = 0;
-            QPointF p(_values[idx]);
-            s.append(p);
-        }
+    //-- Nothing new to draw
+    if(_data.revision() == _seriesRevision && _chart->plotWidth() == _seriesColumns) {
+        return;
+    }
+    _seriesRevision = _data.revision();
+    _seriesColumns  = _chart->plotWidth();
+    _data.decimate(static_cast<qreal>(_chart->rangeXMin().toMSecsSinceEpoch()),
+                   static_cast<qreal>(_chart->rangeXMax().toMSecsSinceEpoch()),
+                   _seriesColumns,
+                   _seriesPoints);
+    if (_seriesPoints.count() > 1) {
         QLineSeries* lineSeries = static_cast<QLineSeries*>(_pSeries);
-        lineSeries->replace(s);
+        lineSeries->replace(_seriesPoints);
     }
 }
 
@@ -212,9 +208,102 @@ void
 QGCMAVLinkMessage::updateFreq()
 {
     quint64 msgCount = _count - _lastCount;
-    _messageHz = (0.2 * _messageHz) + (0.8 * msgCount);
+    qreal messageHz = (0.2 * _messageHz) + (0.8 * msgCount);
     _lastCount = _count;
-    emit freqChanged();
+    if(std::abs(messageHz - _messageHz) > 0.01) {
+        _messageHz = messageHz;
+        emit freqChanged();
+    }
+}
+
+//-----------------------------------------------------------------------------
+/// Decodes a numeric field from the payload
+///     @param text Formatted value returned here, formatting is skipped if nullptr
+/// @return Value of the field (first element for arrays)
+template<typename T>
+static qreal
+_decodeNumericField(const uint8_t* p, unsigned int arrayLength, QString* text)
+{
+    T value;
+    memcpy(&value, p, sizeof(T));
+    if(text) {
+        if(arrayLength > 0) {
+            text->clear();
+            for(unsigned int j = 0; j < arrayLength; ++j) {
+                T element;
+                memcpy(&element, p + (j * sizeof(T)), sizeof(T));
+                if(j) {
+                    text->append(QStringLiteral(", "));
+                }
+                text->append(QString::number(element));
+            }
+        } else {
+            *text = QString::number(value);
+        }
+    }
+    return static_cast<qreal>(value);
+}
+
+//-----------------------------------------------------------------------------
+qreal
+QGCMAVLinkMessage::_decodeField(const mavlink_field_info_t& field, QString* text)
+{
+    const uint8_t* m = reinterpret_cast<const uint8_t*>(&_message.payload64[0]);
+    const uint8_t* p = m + field.wire_offset;
+    const unsigned int array_length = field.array_length;
+    switch (field.type) {
+    case MAVLINK_TYPE_CHAR:
+        if(text) {
+            if (array_length > 0) {
+                //-- Not guaranteed to be null terminated
+                *text = QString::fromLatin1(reinterpret_cast<const char*>(p), static_cast<int>(qstrnlen(reinterpret_cast<const char*>(p), array_length)));
+            } else {
+                // Single char
+                *text = QString(QChar(*reinterpret_cast<const char*>(p)));
+            }
+        }
+        return 0;
+    case MAVLINK_TYPE_UINT8_T:
+        return _decodeNumericField<uint8_t>(p, array_length, text);
+    case MAVLINK_TYPE_INT8_T:
+        return _decodeNumericField<int8_t>(p, array_length, text);
+    case MAVLINK_TYPE_UINT16_T:
+        return _decodeNumericField<uint16_t>(p, array_length, text);
+    case MAVLINK_TYPE_INT16_T:
+        return _decodeNumericField<int16_t>(p, array_length, text);
+    case MAVLINK_TYPE_UINT32_T:
+        //-- Special case
+        if(array_length == 0 && _message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME) {
+            qreal v = _decodeNumericField<uint32_t>(p, array_length, nullptr);
+            if(text) {
+                QDateTime d = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(v),Qt::UTC,0);
+                *text = d.toString("HH:mm:ss");
+            }
+            return v;
+        }
+        return _decodeNumericField<uint32_t>(p, array_length, text);
+    case MAVLINK_TYPE_INT32_T:
+        return _decodeNumericField<int32_t>(p, array_length, text);
+    case MAVLINK_TYPE_FLOAT:
+        return _decodeNumericField<float>(p, array_length, text);
+    case MAVLINK_TYPE_DOUBLE:
+        return _decodeNumericField<double>(p, array_length, text);
+    case MAVLINK_TYPE_UINT64_T:
+        //-- Special case
+        if(array_length == 0 && _message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME) {
+            uint64_t n;
+            memcpy(&n, p, sizeof(uint64_t));
+            if(text) {
+                QDateTime d = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(n/1000),Qt::UTC,0);
+                *text = d.toString("yyyy MM dd HH:mm:ss");
+            }
+            return static_cast<qreal>(n);
+        }
+        return _decodeNumericField<uint64_t>(p, array_length, text);
+    case MAVLINK_TYPE_INT64_T:
+        return _decodeNumericField<int64_t>(p, array_length, text);
+    }
+    return 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -222,237 +311,65 @@ void
 QGCMAVLinkMessage::update(mavlink_message_t* message)
 {
     _count++;
-    //-- If we are not consuming this message, no need to parse it
-    if(!_selected && !_fieldSelected) {
-        return;
-    }
+    //-- Keep the raw payload, fields are only decoded when needed
     _message = *message;
-    const mavlink_message_info_t* msgInfo = mavlink_get_message_info(message);
-    if (!msgInfo) {
-        qWarning() << QStringLiteral("QGCMAVLinkMessage::update NULL msgInfo msgid(%1)").arg(message->msgid);
-        return;
+    _dirty = true;
+    //-- Charted fields need every sample, but not the formatted text
+    if(_fieldSelected) {
+        const mavlink_message_info_t* msgInfo = _messageInfo();
+        if(msgInfo) {
+            for (unsigned int i = 0; i < msgInfo->num_fields; ++i) {
+                QGCMAVLinkMessageField* f = qobject_cast<QGCMAVLinkMessageField*>(_fields.get(static_cast<int>(i)));
+                if(f && f->selected()) {
+                    f->addSample(_decodeField(msgInfo->fields[i], nullptr));
+                }
+            }
+        }
     }
-    if(_fields.count() != static_cast<int>(msgInfo->num_fields)) {
-        qWarning() << QStringLiteral("QGCMAVLinkMessage::update msgInfo field count mismatch msgid(%1)").arg(message->msgid);
+}
+
+//-----------------------------------------------------------------------------
+void
+QGCMAVLinkMessage::updateDisplay()
+{
+    if(!_dirty) {
         return;
     }
-    uint8_t* m = reinterpret_cast<uint8_t*>(&message->payload64[0]);
-    for (unsigned int i = 0; i < msgInfo->num_fields; ++i) {
-        QGCMAVLinkMessageField* f = qobject_cast<QGCMAVLinkMessageField*>(_fields.get(static_cast<int>(i)));
-        if(f) {
-            const unsigned int offset = msgInfo->fields[i].wire_offset;
-            const unsigned int array_length = msgInfo->fields[i].array_length;
-            static const unsigned int array_buffer_length = (MAVLINK_MAX_PAYLOAD_LEN + MAVLINK_NUM_CHECKSUM_BYTES + 7);
-            switch (msgInfo->fields[i].type) {
-            case MAVLINK_TYPE_CHAR:
-                f->setSelectable(false);
-                if (array_length > 0) {
-                    char* str = reinterpret_cast<char*>(m + offset);
-                    // Enforce null termination
-                    str[array_length - 1] = '\0';
-                    QString v(str);
-                    f->updateValue(v, 0);
-                } else {
-                    // Single char
-                    char b = *(reinterpret_cast<char*>(m + offset));
-                    QString v(b);
-                    f->updateValue(v, 0);
-                }
-                break;
-            case MAVLINK_TYPE_UINT8_T:
-                if (array_length > 0) {
-                    uint8_t* nums = m + offset;
-                    QString tmp("%1, ");
-                    QString string;
-                    for (unsigned int j = 0; j < array_length - 1; ++j) {
-                        string += tmp.arg(nums[j]);
-                    }
-                    string += QString::number(nums[array_length - 1]);
-                    f->updateValue(string, static_cast<qreal>(nums[0]));
-                } else {
-                    // Single value
-                    uint8_t u = *(m + offset);
-                    f->updateValue(QString::number(u), static_cast<qreal>(u));
+    _dirty = false;
+    const mavlink_message_info_t* msgInfo = _messageInfo();
+    if(msgInfo) {
+        QString text;
+        for (unsigned int i = 0; i < msgInfo->num_fields; ++i) {
+            QGCMAVLinkMessageField* f = qobject_cast<QGCMAVLinkMessageField*>(_fields.get(static_cast<int>(i)));
+            if(f) {
+                if(msgInfo->fields[i].type == MAVLINK_TYPE_CHAR) {
+                    f->setSelectable(false);
                 }
-                break;
-            case MAVLINK_TYPE_INT8_T:
-                if (array_length > 0) {
-                    int8_t* nums = reinterpret_cast<int8_t*>(m + offset);
-                    QString tmp("%1, ");
-                    QString string;
-                    for (unsigned int j = 0; j < array_length - 1; ++j) {
-                        string += tmp.arg(nums[j]);
-                    }
-                    string += QString::number(nums[array_length - 1]);
-                    f->updateValue(string, static_cast<qreal>(nums[0]));
-                } else {
-                    // Single value
-                    int8_t n = *(reinterpret_cast<int8_t*>(m + offset));
-                    f->updateValue(QString::number(n), static_cast<qreal>(n));
-                }
-                break;
-            case MAVLINK_TYPE_UINT16_T:
-                if (array_length > 0) {
-                    uint16_t nums[array_buffer_length / sizeof(uint16_t)];
-                    memcpy(nums, m + offset,  sizeof(uint16_t) * array_length);
-                    QString tmp("%1, ");
-                    QString string;
-                    for (unsigned int j = 0; j < array_length - 1; ++j) {
-                        string += tmp.arg(nums[j]);
-                    }
-                    string += QString::number(nums[array_length - 1]);
-                    f->updateValue(string, static_cast<qreal>(nums[0]));
-                } else {
-                    // Single value
-                    uint16_t n;
-                    memcpy(&n, m + offset, sizeof(uint16_t));
-                    f->updateValue(QString::number(n), static_cast<qreal>(n));
-                }
-                break;
-            case MAVLINK_TYPE_INT16_T:
-                if (array_length > 0) {
-                    int16_t nums[array_buffer_length / sizeof(int16_t)];
-                    memcpy(nums, m + offset,  sizeof(int16_t) * array_length);
-                    QString tmp("%1, ");
-                    QString string;
-                    for (unsigned int j = 0; j < array_length - 1; ++j) {
-                        string += tmp.arg(nums[j]);
-                    }
-                    string += QString::number(nums[array_length - 1]);
-                    f->updateValue(string, static_cast<qreal>(nums[0]));
-                } else {
-                    // Single value
-                    int16_t n;
-                    memcpy(&n, m + offset, sizeof(int16_t));
-                    f->updateValue(QString::number(n), static_cast<qreal>(n));
-                }
-                break;
-            case MAVLINK_TYPE_UINT32_T:
-                if (array_length > 0) {
-                    uint32_t nums[array_buffer_length / sizeof(uint32_t)];
-                    memcpy(nums, m + offset,  sizeof(uint32_t) * array_length);
-                    QString tmp("%1, ");
-                    QString string;
-                    for (unsigned int j = 0; j < array_length - 1; ++j) {
-                        string += tmp.arg(nums[j]);
-                    }
-                    string += QString::number(nums[array_length - 1]);
-                    f->updateValue(string, static_cast<qreal>(nums[0]));
-                } else {
-                    // Single value
-                    uint32_t n;
-                    memcpy(&n, m + offset, sizeof(uint32_t));
-                    //-- Special case
-                    if(_message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME) {
-                        QDateTime d = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(n),Qt::UTC,0);
-                        f->updateValue(d.toString("HH:mm:ss"), static_cast<qreal>(n));
-                    } else {
-                        f->updateValue(QString::number(n), static_cast<qreal>(n));
-                    }
-                }
-                break;
-            case MAVLINK_TYPE_INT32_T:
-                if (array_length > 0) {
-                    int32_t nums[array_buffer_length / sizeof(int32_t)];
-                    memcpy(nums, m + offset,  sizeof(int32_t) * array_length);
-                    QString tmp("%1, ");
-                    QString string;
-                    for (unsigned int j = 0; j < array_length - 1; ++j) {
-                        string += tmp.arg(nums[j]);
-                    }
-                    string += QString::number(nums[array_length - 1]);
-                    f->updateValue(string, static_cast<qreal>(nums[0]));
-                } else {
-                    // Single value
-                    int32_t n;
-                    memcpy(&n, m + offset, sizeof(int32_t));
-                    f->updateValue(QString::number(n), static_cast<qreal>(n));
-                }
-                break;
-            case MAVLINK_TYPE_FLOAT:
-                if (array_length > 0) {
-                    float nums[array_buffer_length / sizeof(float)];
-                    memcpy(nums, m + offset,  sizeof(float) * array_length);
-                    QString tmp("%1, ");
-                    QString string;
-                    for (unsigned int j = 0; j < array_length - 1; ++j) {
-                       string += tmp.arg(static_cast<double>(nums[j]));
-                    }
-                    string += QString::number(static_cast<double>(nums[array_length - 1]));
-                    f->updateValue(string, static_cast<qreal>(nums[0]));
-                } else {
-                    // Single value
-                    float fv;
-                    memcpy(&fv, m + offset, sizeof(float));
-                    f->updateValue(QString::number(static_cast<double>(fv)), static_cast<qreal>(fv));
-                }
-                break;
-            case MAVLINK_TYPE_DOUBLE:
-                if (array_length > 0) {
-                    double nums[array_buffer_length / sizeof(double)];
-                    memcpy(nums, m + offset,  sizeof(double) * array_length);
-                    QString tmp("%1, ");
-                    QString string;
-                    for (unsigned int j = 0; j < array_length - 1; ++j) {
-                        string += tmp.arg(nums[j]);
-                    }
-                    string += QString::number(static_cast<double>(nums[array_length - 1]));
-                    f->updateValue(string, static_cast<qreal>(nums[0]));
-                } else {
-                    // Single value
-                    double d;
-                    memcpy(&d, m + offset, sizeof(double));
-                    f->updateValue(QString::number(d), static_cast<qreal>(d));
-                }
-                break;
-            case MAVLINK_TYPE_UINT64_T:
-                if (array_length > 0) {
-                    uint64_t nums[array_buffer_length / sizeof(uint64_t)];
-                    memcpy(nums, m + offset,  sizeof(uint64_t) * array_length);
-                    QString tmp("%1, ");
-                    QString string;
-                    for (unsigned int j = 0; j < array_length - 1; ++j) {
-                        string += tmp.arg(nums[j]);
-                    }
-                    string += QString::number(nums[array_length - 1]);
-                    f->updateValue(string, static_cast<qreal>(nums[0]));
-                } else {
-                    // Single value
-                    uint64_t n;
-                    memcpy(&n, m + offset, sizeof(uint64_t));
-                    //-- Special case
-                    if(_message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME) {
-                        QDateTime d = QDateTime::fromMSecsSinceEpoch(n/1000,Qt::UTC,0);
-                        f->updateValue(d.toString("yyyy MM dd HH:mm:ss"), static_cast<qreal>(n));
-                    } else {
-                        f->updateValue(QString::number(n), static_cast<qreal>(n));
-                    }
-                }
-                break;
-            case MAVLINK_TYPE_INT64_T:
-                if (array_length > 0) {
-                    int64_t nums[array_buffer_length / sizeof(int64_t)];
-                    memcpy(nums, m + offset,  sizeof(int64_t) * array_length);
-                    QString tmp("%1, ");
-                    QString string;
-                    for (unsigned int j = 0; j < array_length - 1; ++j) {
-                        string += tmp.arg(nums[j]);
-                    }
-                    string += QString::number(nums[array_length - 1]);
-                    f->updateValue(string, static_cast<qreal>(nums[0]));
-                } else {
-                    // Single value
-                    int64_t n;
-                    memcpy(&n, m + offset, sizeof(int64_t));
-                    f->updateValue(QString::number(n), static_cast<qreal>(n));
-                }
-                break;
+                _decodeField(msgInfo->fields[i], &text);
+                f->updateValue(text);
             }
         }
     }
+    emit countChanged();
     emit messageChanged();
 }
 
+//-----------------------------------------------------------------------------
+const mavlink_message_info_t*
+QGCMAVLinkMessage::_messageInfo()
+{
+    const mavlink_message_info_t* msgInfo = mavlink_get_message_info(&_message);
+    if (!msgInfo) {
+        qWarning() << QStringLiteral("QGCMAVLinkMessage NULL msgInfo msgid(%1)").arg(_message.msgid);
+        return nullptr;
+    }
+    if(_fields.count() != static_cast<int>(msgInfo->num_fields)) {
+        qWarning() << QStringLiteral("QGCMAVLinkMessage msgInfo field count mismatch msgid(%1)").arg(_message.msgid);
+        return nullptr;
+    }
+    return msgInfo;
+}
+
 //-----------------------------------------------------------------------------
 QGCMAVLinkVehicle::QGCMAVLinkVehicle(QObject* parent, quint8 id)
     : QObject(parent)
@@ -468,18 +385,12 @@ QGCMAVLinkVehicle::~QGCMAVLinkVehicle()
 }
 
 //-----------------------------------------------------------------------------
-QGCMAVLinkMessage*
-QGCMAVLinkVehicle::findMessage(uint32_t id, uint8_t cid)
+void
+QGCMAVLinkVehicle::clearMessages()
 {
-    for(int i = 0; i < _messages.count(); i++) {
-        QGCMAVLinkMessage* m = qobject_cast<QGCMAVLinkMessage*>(_messages.get(i));
-        if(m) {
-            if(m->id() == id && m->cid() == cid) {
-                return m;
-            }
-        }
-    }
-    return nullptr;
+    _messageMap.clear();
+    _messages.clearAndDeleteContents();
+    emit messagesChanged();
 }
 
 //-----------------------------------------------------------------------------
@@ -548,6 +459,7 @@ QGCMAVLinkVehicle::append(QGCMAVLinkMessage* message)
         message->setSelected(true);
     }
     _messages.append(message);
+    _messageMap[_messageKey(message->id(), message->cid())] = message;
     //-- Sort messages by id and then cid
     if(_messages.count() > 0) {
         std::sort(_messages.objectList()->begin(), _messages.objectList()->end(), messages_sort);
@@ -591,7 +503,8 @@ MAVLinkChartController::MAVLinkChartController(MAVLinkInspectorController *paren
     , _index(index)
     , _controller(parent)
 {
-    connect(&_updateSeriesTimer, &QTimer::timeout, this, &MAVLinkChartController::_refreshSeries);
+    _updateSeriesTaskId = qgcApp()->toolbox()->frameScheduler()->registerTask(this, UPDATE_FREQUENCY, [this]() { _refreshSeries(); });
+    qgcApp()->toolbox()->frameScheduler()->setTaskActive(_updateSeriesTaskId, false);
     updateXRange();
 }
 
@@ -620,6 +533,36 @@ MAVLinkChartController::setRangeXIndex(quint32 t)
     _rangeXIndex = t;
     emit rangeXIndexChanged();
     updateXRange();
+    //-- Only keep as much data as can be displayed
+    qreal h = history();
+    for(int i = 0; i < _chartFields.count(); i++) {
+        QObject* object = qvariant_cast<QObject*>(_chartFields.at(i));
+        QGCMAVLinkMessageField* pField = qobject_cast<QGCMAVLinkMessageField*>(object);
+        if(pField) {
+            pField->setHistory(h);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+qreal
+MAVLinkChartController::history()
+{
+    if(_rangeXIndex < static_cast<quint32>(_controller->timeScaleSt().count())) {
+        return _controller->timeScaleSt()[static_cast<int>(_rangeXIndex)]->timeScale;
+    }
+    return _controller->timeScaleSt().count() ? _controller->timeScaleSt().last()->timeScale : 60 * 1000;
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkChartController::setPlotWidth(int width)
+{
+    width = qMax(1, width);
+    if(_plotWidth != width) {
+        _plotWidth = width;
+        emit plotWidthChanged();
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -641,7 +584,7 @@ MAVLinkChartController::updateYRange()
 {
     if(_chartFields.count()) {
         qreal vmin  = std::numeric_limits<qreal>::max();
-        qreal vmax  = std::numeric_limits<qreal>::min();
+        qreal vmax  = std::numeric_limits<qreal>::lowest();
         for(int i = 0; i < _chartFields.count(); i++) {
             QObject* object = qvariant_cast<QObject*>(_chartFields.at(i));
             QGCMAVLinkMessageField* pField = qobject_cast<QGCMAVLinkMessageField*>(object);
@@ -689,7 +632,7 @@ MAVLinkChartController::addSeries(QGCMAVLinkMessageField* field, QAbstractSeries
         _chartFields.append(f);
         field->addSeries(this, series);
         emit chartFieldsChanged();
-        _updateSeriesTimer.start(UPDATE_FREQUENCY);
+        qgcApp()->toolbox()->frameScheduler()->setTaskActive(_updateSeriesTaskId, true);
     }
 }
 
@@ -706,7 +649,7 @@ MAVLinkChartController::delSeries(QGCMAVLinkMessageField* field)
                 emit chartFieldsChanged();
                 if(_chartFields.count() == 0) {
                     updateXRange();
-                    _updateSeriesTimer.stop();
+                    qgcApp()->toolbox()->frameScheduler()->setTaskActive(_updateSeriesTaskId, false);
                 }
                 return;
             }
@@ -722,8 +665,9 @@ MAVLinkInspectorController::MAVLinkInspectorController()
     connect(multiVehicleManager, &MultiVehicleManager::vehicleRemoved, this, &MAVLinkInspectorController::_vehicleRemoved);
     MAVLinkProtocol* mavlinkProtocol = qgcApp()->toolbox()->mavlinkProtocol();
     connect(mavlinkProtocol, &MAVLinkProtocol::messageReceived, this, &MAVLinkInspectorController::_receiveMessage);
-    connect(&_updateFrequencyTimer, &QTimer::timeout, this, &MAVLinkInspectorController::_refreshFrequency);
-    _updateFrequencyTimer.start(1000);
+    QGCFrameScheduler* scheduler = qgcApp()->toolbox()->frameScheduler();
+    scheduler->registerTask(this, 1000,                 [this]() { _refreshFrequency(); });
+    scheduler->registerTask(this, DISPLAY_FREQUENCY,    [this]() { _refreshDisplay(); });
     MultiVehicleManager *manager = qgcApp()->toolbox()->multiVehicleManager();
     connect(manager, &MultiVehicleManager::activeVehicleChanged, this, &MAVLinkInspectorController::_setActiveVehicle);
     _timeScaleSt.append(new TimeScale_st(this, tr("5 Sec"),   5 * 1000));
@@ -792,21 +736,6 @@ MAVLinkInspectorController::_setActiveVehicle(Vehicle* vehicle)
     emit activeVehiclesChanged();
 }
 
-//-----------------------------------------------------------------------------
-QGCMAVLinkVehicle*
-MAVLinkInspectorController::_findVehicle(uint8_t id)
-{
-    for(int i = 0; i < _vehicles.count(); i++) {
-        QGCMAVLinkVehicle* v = qobject_cast<QGCMAVLinkVehicle*>(_vehicles.get(i));
-        if(v) {
-            if(v->id() == id) {
-                return v;
-            }
-        }
-    }
-    return nullptr;
-}
-
 //-----------------------------------------------------------------------------
 void
 MAVLinkInspectorController::_refreshFrequency()
@@ -824,17 +753,30 @@ MAVLinkInspectorController::_refreshFrequency()
     }
 }
 
+//-----------------------------------------------------------------------------
+void
+MAVLinkInspectorController::_refreshDisplay()
+{
+    //-- Only the selected message of the active vehicle is displayed
+    if(_activeVehicle && _activeVehicle->messages()->count()) {
+        QGCMAVLinkMessage* m = qobject_cast<QGCMAVLinkMessage*>(_activeVehicle->messages()->get(_activeVehicle->selected()));
+        if(m) {
+            m->updateDisplay();
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 void
 MAVLinkInspectorController::_vehicleAdded(Vehicle* vehicle)
 {
     QGCMAVLinkVehicle* v = _findVehicle(static_cast<uint8_t>(vehicle->id()));
     if(v) {
-        v->messages()->clearAndDeleteContents();
-        emit v->messagesChanged();
+        v->clearMessages();
     } else {
         v = new QGCMAVLinkVehicle(this, static_cast<uint8_t>(vehicle->id()));
         _vehicles.append(v);
+        _vehicleMap[v->id()] = v;
         _vehicleNames.append(tr("Vehicle %1").arg(vehicle->id()));
     }
     emit vehiclesChanged();
@@ -848,6 +790,11 @@ MAVLinkInspectorController::_vehicleRemoved(Vehicle* vehicle)
     if(v) {
         v->deleteLater();
         _vehicles.removeOne(v);
+        _vehicleMap.remove(v->id());
+        if(_activeVehicle == v) {
+            _activeVehicle = nullptr;
+            emit activeVehiclesChanged();
+        }
         QString vs = tr("Vehicle %1").arg(vehicle->id());
         _vehicleNames.removeOne(vs);
         emit vehiclesChanged();
@@ -863,6 +810,7 @@ MAVLinkInspectorController::_receiveMessage(LinkInterface*, mavlink_message_t me
     if(!v) {
         v = new QGCMAVLinkVehicle(this, message.sysid);
         _vehicles.append(v);
+        _vehicleMap[v->id()] = v;
         _vehicleNames.append(tr("Vehicle %1").arg(message.sysid));
         emit vehiclesChanged();
         if(!_activeVehicle) {
@@ -14,10 +14,12 @@
 #pragma once
 
 #include "MAVLinkProtocol.h"
+#include "MAVLinkChartData.h"
 #include "Vehicle.h"
 
 #include <QObject>
 #include <QString>
+#include <QHash>
 #include <QDebug>
 #include <QVariantList>
 #include <QtCharts/QAbstractSeries>
@@ -53,17 +55,19 @@ public:
     bool            selectable      () { return _selectable; }
     bool            selected        () { return _pSeries != nullptr; }
     QAbstractSeries*series          () { return _pSeries; }
-    QList<QPointF>* values          () { return &_values;}
+    MAVLinkChartData* data          () { return &_data; }
     qreal           rangeMin        () { return _rangeMin; }
     qreal           rangeMax        () { return _rangeMax; }
     int             chartIndex      ();
 
     void            setSelectable   (bool sel);
-    void            updateValue     (QString newValue, qreal v);
+    void            updateValue     (const QString& newValue);
+    void            addSample       (qreal v);
 
     void            addSeries       (MAVLinkChartController* chart, QAbstractSeries* series);
     void            delSeries       ();
     void            updateSeries    ();
+    void            setHistory      (qreal msecs) { _data.setHistory(msecs); }
 
 signals:
     void            seriesChanged       ();
@@ -75,14 +79,16 @@ private:
     QString     _name;
     QString     _value;
     bool        _selectable = true;
-    int         _dataIndex  = 0;
     qreal       _rangeMin   = 0;
     qreal       _rangeMax   = 0;
 
     QAbstractSeries*    _pSeries = nullptr;
     QGCMAVLinkMessage*  _msg     = nullptr;
     MAVLinkChartController*      _chart   = nullptr;
-    QList<QPointF>      _values;
+    MAVLinkChartData    _data;
+    QVector<QPointF>    _seriesPoints;                  ///< Decimated points last handed to the series
+    quint64             _seriesRevision = 0;            ///< Data revision of _seriesPoints
+    int                 _seriesColumns  = 0;            ///< Plot width used for _seriesPoints
 };
 
 //-----------------------------------------------------------------------------
@@ -94,7 +100,7 @@ public:
     Q_PROPERTY(quint32              cid             READ cid            NOTIFY indexChanged)
     Q_PROPERTY(QString              name            READ name           NOTIFY indexChanged)
     Q_PROPERTY(qreal                messageHz       READ messageHz      NOTIFY freqChanged)
-    Q_PROPERTY(quint64              count           READ count          NOTIFY messageChanged)
+    Q_PROPERTY(quint64              count           READ count          NOTIFY countChanged)
     Q_PROPERTY(QmlObjectListModel*  fields          READ fields         NOTIFY indexChanged)
     Q_PROPERTY(bool                 fieldSelected   READ fieldSelected  NOTIFY fieldSelectedChanged)
     Q_PROPERTY(bool                 selected        READ selected       NOTIFY selectedChanged)
@@ -114,25 +120,31 @@ public:
 
     void                updateFieldSelection();
     void                update          (mavlink_message_t* message);
+    void                updateDisplay   ();     ///< Formats field values from the latest payload, called at display rate
     void                updateFreq      ();
     void                setSelected     (bool sel) { _selected = sel; }
 
 signals:
     void messageChanged                 ();
+    void countChanged                   ();
     void freqChanged                    ();
     void indexChanged                   ();
     void fieldSelectedChanged           ();
     void selectedChanged                ();
 
 private:
+    qreal                           _decodeField    (const mavlink_field_info_t& field, QString* text);
+    const mavlink_message_info_t*   _messageInfo    ();
+
     QmlObjectListModel  _fields;
     QString             _name;
     qreal               _messageHz  = 0.0;
     uint64_t            _count      = 0;
     uint64_t            _lastCount  = 0;
-    mavlink_message_t   _message;   //-- List of QGCMAVLinkMessageField
+    mavlink_message_t   _message;   //-- Latest payload
     bool                _fieldSelected   = false;
     bool                _selected   = false;
+    bool                _dirty      = true;     ///< _message has not been formatted into the fields yet
 };
 
 //-----------------------------------------------------------------------------
@@ -157,9 +169,10 @@ public:
     int                 selected        () { return _selected; }
 
     void                setSelected     (int sel);
-    QGCMAVLinkMessage*  findMessage     (uint32_t id, uint8_t cid);
+    QGCMAVLinkMessage*  findMessage     (uint32_t id, uint8_t cid) { return _messageMap.value(_messageKey(id, cid), nullptr); }
     int                 findMessage     (QGCMAVLinkMessage* message);
     void                append          (QGCMAVLinkMessage* message);
+    void                clearMessages   ();
 
 signals:
     void messagesChanged                ();
@@ -170,11 +183,14 @@ private:
     void _checkCompID                   (QGCMAVLinkMessage *message);
     void _resetSelection                ();
 
+    static quint32 _messageKey          (uint32_t id, uint8_t cid) { return (id << 8) | cid; }
+
 private:
     quint8              _id;
     QList<int>          _compIDs;
     QStringList         _compIDsStr;
     QmlObjectListModel  _messages;      //-- List of QGCMAVLinkMessage
+    QHash<quint32, QGCMAVLinkMessage*> _messageMap;     ///< Message lookup by msgid and compid
     int                 _selected = 0;
 };
 
@@ -191,6 +207,7 @@ public:
     Q_PROPERTY(qreal        rangeYMin           READ rangeYMin              NOTIFY rangeYMinChanged)
     Q_PROPERTY(qreal        rangeYMax           READ rangeYMax              NOTIFY rangeYMaxChanged)
     Q_PROPERTY(int          chartIndex          READ chartIndex             CONSTANT)
+    Q_PROPERTY(int          plotWidth           READ plotWidth              WRITE setPlotWidth      NOTIFY plotWidthChanged)   ///< Pixel width of the plot area, series are decimated to this
 
     Q_PROPERTY(quint32      rangeYIndex         READ rangeYIndex            WRITE setRangeYIndex    NOTIFY rangeYIndexChanged)
     Q_PROPERTY(quint32      rangeXIndex         READ rangeXIndex            WRITE setRangeXIndex    NOTIFY rangeXIndexChanged)
@@ -208,8 +225,11 @@ public:
     quint32                 rangeXIndex         () { return _rangeXIndex; }
     quint32                 rangeYIndex         () { return _rangeYIndex; }
     int                     chartIndex          () { return _index; }
+    int                     plotWidth           () { return _plotWidth; }
+    qreal                   history             ();
 
     void                    setRangeXIndex      (quint32 t);
+    void                    setPlotWidth        (int width);
     void                    setRangeYIndex      (quint32 r);
     void                    updateXRange        ();
     void                    updateYRange        ();
@@ -222,12 +242,13 @@ signals:
     void rangeYMaxChanged   ();
     void rangeYIndexChanged ();
     void rangeXIndexChanged ();
+    void plotWidthChanged   ();
 
 private slots:
     void _refreshSeries     ();
 
 private:
-    QTimer              _updateSeriesTimer;
+    int                 _updateSeriesTaskId  = 0;  ///< QGCFrameScheduler task
     QDateTime           _rangeXMin;
     QDateTime           _rangeXMax;
     int                 _index               = 0;
@@ -235,6 +256,7 @@ private:
     qreal               _rangeYMax           = 1;
     quint32             _rangeXIndex         = 0;                    ///< 5 Seconds
     quint32             _rangeYIndex         = 0;                    ///< Auto Range
+    int                 _plotWidth           = 1000;
     QVariantList        _chartFields;
     MAVLinkInspectorController* _controller  = nullptr;
 };
@@ -295,9 +317,10 @@ private slots:
     void _vehicleRemoved            (Vehicle* vehicle);
     void _setActiveVehicle          (Vehicle* vehicle);
     void _refreshFrequency          ();
+    void _refreshDisplay            ();
 
 private:
-    QGCMAVLinkVehicle* _findVehicle (uint8_t id);
+    QGCMAVLinkVehicle* _findVehicle (uint8_t id) { return _vehicleMap.value(id, nullptr); }
 
 private:
 
@@ -306,9 +329,9 @@ private:
     QStringList         _timeScales;
     QStringList         _rangeList;
     QGCMAVLinkVehicle*  _activeVehicle          = nullptr;
-    QTimer              _updateFrequencyTimer;
     QStringList         _vehicleNames;
     QmlObjectListModel  _vehicles;                                      ///< List of QGCMAVLinkVehicle
+    QHash<quint8, QGCMAVLinkVehicle*> _vehicleMap;                      ///< Vehicle lookup by system id
     QmlObjectListModel  _charts;                                        ///< List of MAVLinkCharts
     QList<TimeScale_st*>_timeScaleSt;
     QList<Range_st*>    _rangeSt;
@@ -0,0 +1,659 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ULogFile.h"
+
+#include <QFile>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+QGC_LOGGING_CATEGORY(ULogFileLog, "ULogFileLog")
+
+const char ULogFile::_magic[7] = { 'U', 'L', 'o', 'g', 0x01, 0x12, 0x35 };
+
+namespace {
+
+enum class ULogMessageType : quint8 {
+    FORMAT              = 'F',
+    DATA                = 'D',
+    INFO                = 'I',
+    INFO_MULTIPLE       = 'M',
+    PARAMETER           = 'P',
+    ADD_LOGGED_MSG      = 'A',
+    REMOVE_LOGGED_MSG   = 'R',
+    SYNC                = 'S',
+    DROPOUT             = 'O',
+    LOGGING             = 'L',
+    FLAG_BITS           = 'B',
+};
+
+// DATA payload: uint16 msg_id followed by the topic, which always starts with a uint64 timestamp
+const int _dataMsgIdLen     = 2;
+const int _dataMinSize      = _dataMsgIdLen + 8;
+
+template<typename T>
+double _columnValue(const char* data)
+{
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return static_cast<double>(value);
+}
+
+bool _timestampLess(quint64 timestamp, const ULogFile::IndexEntry& entry)
+{
+    return timestamp < entry.timestamp;
+}
+
+}
+
+ULogFile::ULogFile(void)
+    : _device           (nullptr)
+    , _ownsDevice       (false)
+    , _version          (0)
+    , _startTimestamp   (0)
+    , _endTimestamp     (0)
+    , _bufferPos        (0)
+    , _bufferOffset     (0)
+{
+
+}
+
+ULogFile::~ULogFile()
+{
+    close();
+}
+
+int ULogFile::sizeOfType(ValueType type)
+{
+    switch (type) {
+    case TypeInt8:
+    case TypeUInt8:
+    case TypeBool:
+    case TypeChar:
+        return 1;
+    case TypeInt16:
+    case TypeUInt16:
+        return 2;
+    case TypeInt32:
+    case TypeUInt32:
+    case TypeFloat:
+        return 4;
+    case TypeInt64:
+    case TypeUInt64:
+    case TypeDouble:
+        return 8;
+    case TypeNested:
+        break;
+    }
+    return 0;
+}
+
+bool ULogFile::_typeFromString(const QString& typeName, ValueType& type)
+{
+    static const QHash<QString, ValueType> typeMap = {
+        { QStringLiteral("int8_t"),     TypeInt8 },
+        { QStringLiteral("uint8_t"),    TypeUInt8 },
+        { QStringLiteral("int16_t"),    TypeInt16 },
+        { QStringLiteral("uint16_t"),   TypeUInt16 },
+        { QStringLiteral("int32_t"),    TypeInt32 },
+        { QStringLiteral("uint32_t"),   TypeUInt32 },
+        { QStringLiteral("int64_t"),    TypeInt64 },
+        { QStringLiteral("uint64_t"),   TypeUInt64 },
+        { QStringLiteral("float"),      TypeFloat },
+        { QStringLiteral("double"),     TypeDouble },
+        { QStringLiteral("bool"),       TypeBool },
+        { QStringLiteral("char"),       TypeChar },
+    };
+
+    auto it = typeMap.constFind(typeName);
+    if (it == typeMap.constEnd()) {
+        return false;
+    }
+    type = it.value();
+    return true;
+}
+
+bool ULogFile::open(const QString& fileName, QString& errorMessage)
+{
+    close();
+
+    QFile* file = new QFile(fileName);
+    if (!file->open(QIODevice::ReadOnly)) {
+        errorMessage = tr("Unable to open log file %1: %2").arg(fileName).arg(file->errorString());
+        delete file;
+        return false;
+    }
+
+    if (!open(file, errorMessage)) {
+        delete file;
+        return false;
+    }
+    _ownsDevice = true;
+
+    return true;
+}
+
+bool ULogFile::open(QIODevice* device, QString& errorMessage)
+{
+    close();
+    errorMessage.clear();
+
+    if (!device || !device->isReadable() || device->isSequential()) {
+        errorMessage = tr("ULog requires a readable random access device");
+        return false;
+    }
+
+    _device = device;
+    // Reserved capacity keeps the read buffer allocated across seeks
+    _buffer.reserve(_readChunkSize * 2);
+
+    if (!_buildIndex(errorMessage)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void ULogFile::close(void)
+{
+    if (_ownsDevice) {
+        delete _device;
+    }
+    _device         = nullptr;
+    _ownsDevice     = false;
+    _version        = 0;
+    _startTimestamp = 0;
+    _endTimestamp   = 0;
+    _bufferPos      = 0;
+    _bufferOffset   = 0;
+    _formats.clear();
+    _subscriptions.clear();
+    _msgIdToSubscription.clear();
+    _info.clear();
+    _buffer.clear();
+}
+
+void ULogFile::_seek(qint64 offset)
+{
+    _device->seek(offset);
+    _buffer.resize(0);
+    _bufferPos      = 0;
+    _bufferOffset   = offset;
+}
+
+/// Makes sure at least the specified number of bytes are available in the buffer at _bufferPos
+///     @return false: end of file reached
+bool ULogFile::_fill(int bytes)
+{
+    if (_buffer.size() - _bufferPos >= bytes) {
+        return true;
+    }
+
+    if (_bufferPos > 0) {
+        _buffer.remove(0, _bufferPos);
+        _bufferOffset += _bufferPos;
+        _bufferPos = 0;
+    }
+
+    while (_buffer.size() < bytes) {
+        int     currentSize = _buffer.size();
+        _buffer.resize(currentSize + _readChunkSize);
+        qint64  bytesRead = _device->read(_buffer.data() + currentSize, _readChunkSize);
+        _buffer.resize(currentSize + static_cast<int>(qMax(bytesRead, static_cast<qint64>(0))));
+        if (bytesRead <= 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Returns the next message in the log. The payload pointer is only valid until the next call.
+///     @return false: end of file, or the log is truncated within the next message
+bool ULogFile::_nextMessage(quint8& type, const char*& payload, int& size, qint64& offset)
+{
+    if (!_fill(_msgHeaderLen)) {
+        return false;
+    }
+
+    const uchar* header = reinterpret_cast<const uchar*>(_buffer.constData() + _bufferPos);
+    int msgSize = qFromLittleEndian<quint16>(header);
+    type = header[2];
+
+    if (!_fill(_msgHeaderLen + msgSize)) {
+        return false;
+    }
+
+    offset  = _bufferOffset + _bufferPos;
+    payload = _buffer.constData() + _bufferPos + _msgHeaderLen;
+    size    = msgSize;
+
+    _bufferPos += _msgHeaderLen + msgSize;
+
+    return true;
+}
+
+bool ULogFile::_buildIndex(QString& errorMessage)
+{
+    _seek(0);
+
+    if (!_fill(_fileHeaderLen) || memcmp(_buffer.constData(), _magic, sizeof(_magic)) != 0) {
+        errorMessage = tr("Could not detect ULog file header magic");
+        return false;
+    }
+    _version = static_cast<quint8>(_buffer.constData()[sizeof(_magic)]);
+    _bufferPos = _fileHeaderLen;
+
+    _startTimestamp = std::numeric_limits<quint64>::max();
+    _endTimestamp   = 0;
+
+    quint8      type;
+    const char* payload;
+    int         size;
+    qint64      offset;
+    quint64     dataCount = 0;
+
+    while (_nextMessage(type, payload, size, offset)) {
+        switch (static_cast<ULogMessageType>(type)) {
+        case ULogMessageType::DATA:
+        {
+            if (size < _dataMinSize) {
+                break;
+            }
+            auto it = _msgIdToSubscription.constFind(qFromLittleEndian<quint16>(payload));
+            if (it == _msgIdToSubscription.constEnd()) {
+                break;
+            }
+
+            Subscription&   sub         = _subscriptions[it.value()];
+            quint64         timestamp   = qFromLittleEndian<quint64>(payload + _dataMsgIdLen);
+
+            if (sub.sampleCount % kIndexStride == 0) {
+                sub.index.append({ timestamp, offset });
+            }
+            if (sub.sampleCount == 0) {
+                sub.firstTimestamp = timestamp;
+            }
+            sub.lastTimestamp = timestamp;
+            sub.sampleCount++;
+
+            _startTimestamp = qMin(_startTimestamp, timestamp);
+            _endTimestamp   = qMax(_endTimestamp, timestamp);
+            dataCount++;
+            break;
+        }
+
+        case ULogMessageType::FORMAT:
+            _parseFormat(payload, size);
+            break;
+
+        case ULogMessageType::ADD_LOGGED_MSG:
+        {
+            if (size < 3) {
+                break;
+            }
+            Subscription sub;
+            sub.multiId         = static_cast<quint8>(payload[0]);
+            sub.msgId           = qFromLittleEndian<quint16>(payload + 1);
+            sub.topic           = QString::fromLatin1(payload + 3, static_cast<int>(strnlen(payload + 3, static_cast<size_t>(size - 3))));
+            sub.sampleCount     = 0;
+            sub.firstTimestamp  = 0;
+            sub.lastTimestamp   = 0;
+            sub.endOffset       = std::numeric_limits<qint64>::max();
+
+            // A msg_id may be added again without being removed first, the new subscription replaces the old one
+            auto it = _msgIdToSubscription.constFind(sub.msgId);
+            if (it != _msgIdToSubscription.constEnd()) {
+                _subscriptions[it.value()].endOffset = offset;
+            }
+            _msgIdToSubscription[sub.msgId] = _subscriptions.count();
+            _subscriptions.append(sub);
+            break;
+        }
+
+        case ULogMessageType::REMOVE_LOGGED_MSG:
+            if (size >= 2) {
+                auto it = _msgIdToSubscription.constFind(qFromLittleEndian<quint16>(payload));
+                if (it != _msgIdToSubscription.constEnd()) {
+                    _subscriptions[it.value()].endOffset = offset;
+                    _msgIdToSubscription.erase(it);
+                }
+            }
+            break;
+
+        case ULogMessageType::INFO:
+        {
+            // uint8 key_len, "type name" key, value
+            int keyLen = size > 0 ? static_cast<quint8>(payload[0]) : 0;
+            if (keyLen == 0 || 1 + keyLen > size) {
+                break;
+            }
+            QString key = QString::fromLatin1(payload + 1, keyLen);
+            QString name = key.mid(key.indexOf(' ') + 1);
+            _info[name] = QByteArray(payload + 1 + keyLen, size - 1 - keyLen);
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    if (dataCount == 0) {
+        _startTimestamp = 0;
+    }
+
+    for (const QString& name: _formats.keys()) {
+        _resolveFormatSize(name, 0);
+    }
+
+    qCDebug(ULogFileLog) << "Indexed ULog version:formats:subscriptions:samples" << _version << _formats.count() << _subscriptions.count() << dataCount;
+
+    return true;
+}
+
+/// Parses a FORMAT message: "name:type field;type field;..." where type may be an array "type[n]" or another format name
+bool ULogFile::_parseFormat(const char* data, int size)
+{
+    QString format      = QString::fromLatin1(data, static_cast<int>(strnlen(data, static_cast<size_t>(size))));
+    int     separator   = format.indexOf(':');
+
+    if (separator <= 0) {
+        qCWarning(ULogFileLog) << "Invalid format message" << format;
+        return false;
+    }
+
+    Format      parsedFormat;
+    QString     name = format.left(separator);
+
+    parsedFormat.size = -1;
+
+    const QStringList fields = format.mid(separator + 1).split(';', QString::SkipEmptyParts);
+    for (const QString& fieldString: fields) {
+        int spacePos = fieldString.indexOf(' ');
+        if (spacePos <= 0) {
+            qCWarning(ULogFileLog) << "Invalid field in format" << name << fieldString;
+            return false;
+        }
+
+        QString typeName = fieldString.left(spacePos);
+        Field   field;
+
+        field.name      = fieldString.mid(spacePos + 1);
+        field.arraySize = 1;
+
+        int arrayStart = typeName.indexOf('[');
+        if (arrayStart != -1) {
+            field.arraySize = typeName.midRef(arrayStart + 1, typeName.indexOf(']') - arrayStart - 1).toInt();
+            typeName = typeName.left(arrayStart);
+        }
+
+        if (!_typeFromString(typeName, field.type)) {
+            field.type          = TypeNested;
+            field.nestedFormat  = typeName;
+        }
+
+        parsedFormat.fields.append(field);
+    }
+
+    _formats[name] = parsedFormat;
+
+    return true;
+}
+
+/// Computes and caches the payload size for the specified format
+///     @return -1: format or one of its nested formats is unknown
+int ULogFile::_resolveFormatSize(const QString& name, int depth)
+{
+    auto it = _formats.find(name);
+    if (it == _formats.end() || depth > _maxNestingDepth) {
+        return -1;
+    }
+    if (it->size >= 0) {
+        return it->size;
+    }
+
+    int size = 0;
+    // Copy the fields since resolving nested formats may rehash _formats
+    const QList<Field> fields = it->fields;
+    for (const Field& field: fields) {
+        int fieldSize = field.type == TypeNested ? _resolveFormatSize(field.nestedFormat, depth + 1) : sizeOfType(field.type);
+        if (fieldSize < 0) {
+            qCWarning(ULogFileLog) << "Unknown type in format" << name << field.nestedFormat;
+            return -1;
+        }
+        size += fieldSize * field.arraySize;
+    }
+
+    _formats[name].size = size;
+
+    return size;
+}
+
+void ULogFile::_flattenColumns(const QString& formatName, const QString& prefix, int offset, int depth, QList<ColumnInfo>& columns) const
+{
+    auto it = _formats.constFind(formatName);
+    if (it == _formats.constEnd() || depth > _maxNestingDepth) {
+        return;
+    }
+
+    int fieldOffset = offset;
+    for (const Field& field: it->fields) {
+        int elementSize = field.type == TypeNested ? _formats.value(field.nestedFormat, { QList<Field>(), -1 }).size : sizeOfType(field.type);
+        if (elementSize < 0) {
+            return;
+        }
+
+        // Padding must be skipped over but is never exposed. Char arrays are strings, not plottable values.
+        if (!field.name.startsWith(QLatin1String("_padding")) && field.type != TypeChar) {
+            for (int i=0; i<field.arraySize; i++) {
+                QString name = prefix + field.name;
+                if (field.arraySize > 1) {
+                    name += QStringLiteral("[%1]").arg(i);
+                }
+                if (field.type == TypeNested) {
+                    _flattenColumns(field.nestedFormat, name + QStringLiteral("."), fieldOffset + (i * elementSize), depth + 1, columns);
+                } else {
+                    columns.append({ name, field.type, fieldOffset + (i * elementSize) });
+                }
+            }
+        }
+
+        fieldOffset += elementSize * field.arraySize;
+    }
+}
+
+QStringList ULogFile::topics(void) const
+{
+    QStringList topicList;
+
+    for (const Subscription& sub: _subscriptions) {
+        if (!topicList.contains(sub.topic)) {
+            topicList.append(sub.topic);
+        }
+    }
+
+    return topicList;
+}
+
+const ULogFile::Subscription* ULogFile::subscription(const QString& topic, int multiId) const
+{
+    for (const Subscription& sub: _subscriptions) {
+        if (sub.multiId == multiId && sub.topic == topic) {
+            return &sub;
+        }
+    }
+    return nullptr;
+}
+
+QList<ULogFile::ColumnInfo> ULogFile::columns(const QString& topic) const
+{
+    QList<ColumnInfo> columnList;
+    _flattenColumns(topic, QString(), 0, 0, columnList);
+    return columnList;
+}
+
+bool ULogFile::readTopic(const QString& topic, int multiId, quint64 startUs, quint64 endUs, TopicData& data, QString& errorMessage, const QStringList& fields)
+{
+    errorMessage.clear();
+
+    data = TopicData();
+    data.topic      = topic;
+    data.multiId    = multiId;
+
+    if (!_device) {
+        errorMessage = tr("No log file open");
+        return false;
+    }
+
+    const Subscription* sub = subscription(topic, multiId);
+    if (!sub) {
+        errorMessage = tr("Topic %1 instance %2 is not in the log").arg(topic).arg(multiId);
+        return false;
+    }
+
+    // The timestamp is returned separately, it is never decoded as a column
+    QList<ColumnInfo> selectedColumns;
+    const QList<ColumnInfo> allColumns = columns(topic);
+    if (fields.isEmpty()) {
+        for (const ColumnInfo& info: allColumns) {
+            if (info.offset != 0) {
+                selectedColumns.append(info);
+            }
+        }
+    } else {
+        for (const QString& field: fields) {
+            auto it = std::find_if(allColumns.cbegin(), allColumns.cend(), [&field](const ColumnInfo& info) { return info.name == field; });
+            if (it == allColumns.cend()) {
+                errorMessage = tr("Topic %1 has no field %2").arg(topic).arg(field);
+                return false;
+            }
+            selectedColumns.append(*it);
+        }
+    }
+
+    for (const ColumnInfo& info: selectedColumns) {
+        data.columns.append({ info.name, info.type, QByteArray() });
+    }
+
+    if (sub->index.isEmpty() || startUs > endUs) {
+        return true;
+    }
+
+    // Start at the last index entry at or before the range start, stop at the first index entry past the range end
+    auto first = std::upper_bound(sub->index.cbegin(), sub->index.cend(), startUs, _timestampLess);
+    if (first != sub->index.cbegin()) {
+        first--;
+    }
+    auto last = std::upper_bound(first, sub->index.cend(), endUs, _timestampLess);
+    qint64 endOffset = last == sub->index.cend() ? std::numeric_limits<qint64>::max() : last->offset;
+
+    // msg_ids can be reused once a subscription is removed, data past that point is for another subscription
+    endOffset = qMin(endOffset, sub->endOffset);
+
+    int reserveCount = static_cast<int>(qMin(static_cast<quint64>(last - first) * kIndexStride, sub->sampleCount));
+    data.timestamps.reserve(reserveCount);
+    for (int i=0; i<selectedColumns.count(); i++) {
+        data.columns[i].data.reserve(reserveCount * sizeOfType(selectedColumns[i].type));
+    }
+
+    quint8      type;
+    const char* payload;
+    int         size;
+    qint64      offset;
+
+    _seek(first->offset);
+    while (_nextMessage(type, payload, size, offset) && offset < endOffset) {
+        if (static_cast<ULogMessageType>(type) != ULogMessageType::DATA || size < _dataMinSize || qFromLittleEndian<quint16>(payload) != sub->msgId) {
+            continue;
+        }
+
+        const char* topicPayload    = payload + _dataMsgIdLen;
+        int         topicSize       = size - _dataMsgIdLen;
+        quint64     timestamp       = qFromLittleEndian<quint64>(topicPayload);
+
+        if (timestamp < startUs) {
+            continue;
+        }
+        if (timestamp > endUs) {
+            break;
+        }
+
+        data.timestamps.append(timestamp);
+        for (int i=0; i<selectedColumns.count(); i++) {
+            const ColumnInfo&   info    = selectedColumns[i];
+            int                 bytes   = sizeOfType(info.type);
+            QByteArray&         column  = data.columns[i].data;
+
+            // ULog is little endian, as are all platforms QGC runs on, so values are stored as is
+            if (info.offset + bytes <= topicSize) {
+                column.append(topicPayload + info.offset, bytes);
+            } else {
+                column.append(bytes, '\0');
+            }
+        }
+    }
+
+    qCDebug(ULogFileLog) << "Read topic:multiId:samples" << topic << multiId << data.count();
+
+    return true;
+}
+
+double ULogFile::Column::value(int index) const
+{
+    const char* p = data.constData() + (index * ULogFile::sizeOfType(type));
+
+    switch (type) {
+    case TypeInt8:
+        return _columnValue<qint8>(p);
+    case TypeUInt8:
+    case TypeBool:
+    case TypeChar:
+        return _columnValue<quint8>(p);
+    case TypeInt16:
+        return _columnValue<qint16>(p);
+    case TypeUInt16:
+        return _columnValue<quint16>(p);
+    case TypeInt32:
+        return _columnValue<qint32>(p);
+    case TypeUInt32:
+        return _columnValue<quint32>(p);
+    case TypeInt64:
+        return _columnValue<qint64>(p);
+    case TypeUInt64:
+        return _columnValue<quint64>(p);
+    case TypeFloat:
+        return _columnValue<float>(p);
+    case TypeDouble:
+        return _columnValue<double>(p);
+    case TypeNested:
+        break;
+    }
+    return 0;
+}
+
+int ULogFile::TopicData::columnIndex(const QString& name) const
+{
+    for (int i=0; i<columns.count(); i++) {
+        if (columns[i].name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const ULogFile::Column* ULogFile::TopicData::column(const QString& name) const
+{
+    int index = columnIndex(name);
+    return index == -1 ? nullptr : &columns[index];
+}
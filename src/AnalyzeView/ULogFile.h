@@ -0,0 +1,192 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QHash>
+#include <QIODevice>
+#include <QMap>
+#include <QStringList>
+#include <QVector>
+
+#include "QGCLoggingCategory.h"
+
+Q_DECLARE_LOGGING_CATEGORY(ULogFileLog)
+
+/// Random access reader for PX4 ULog files.
+///
+/// Opening a log makes a single streaming pass over it which collects the message formats, the logged topics and a sparse
+/// timestamp index for each topic (one entry every kIndexStride samples). Topics can then be decoded into columnar typed
+/// arrays for any time range by seeking straight to the nearest index entry, without rescanning the log. Only a fixed size
+/// read buffer plus the index is held in memory, so multi-gigabyte logs can be opened without loading them.
+class ULogFile
+{
+    Q_DECLARE_TR_FUNCTIONS(ULogFile)
+
+public:
+    ULogFile(void);
+    ~ULogFile();
+
+    enum ValueType {
+        TypeInt8,
+        TypeUInt8,
+        TypeInt16,
+        TypeUInt16,
+        TypeInt32,
+        TypeUInt32,
+        TypeInt64,
+        TypeUInt64,
+        TypeFloat,
+        TypeDouble,
+        TypeBool,
+        TypeChar,
+        TypeNested,
+    };
+
+    /// Field of a message format as specified in the log
+    struct Field {
+        QString     name;
+        ValueType   type;
+        QString     nestedFormat;   ///< Format name for TypeNested fields
+        int         arraySize;      ///< 1 for non-array fields
+    };
+
+    /// Primitive value within a topic sample, nested and array fields are flattened to "parent.child" and "name[index]"
+    struct ColumnInfo {
+        QString     name;
+        ValueType   type;
+        int         offset;         ///< Byte offset within the topic payload
+    };
+
+    /// Decoded values of a single column, stored as a packed array of the column type
+    class Column {
+    public:
+        QString     name;
+        ValueType   type;
+        QByteArray  data;
+
+        int     count   (void) const { return data.count() / ULogFile::sizeOfType(type); }
+        double  value   (int index) const;
+
+        template<typename T>
+        const T* values(void) const { return reinterpret_cast<const T*>(data.constData()); }
+    };
+
+    /// Columnar samples of one topic instance
+    struct TopicData {
+        QString             topic;
+        int                 multiId;
+        QVector<quint64>    timestamps;     ///< Sample timestamps in microseconds
+        QList<Column>       columns;
+
+        int             count       (void) const { return timestamps.count(); }
+        int             columnIndex (const QString& name) const;
+        const Column*   column      (const QString& name) const;
+    };
+
+    /// Sparse index entry: timestamp and file offset of a sample
+    struct IndexEntry {
+        quint64 timestamp;
+        qint64  offset;
+    };
+
+    /// A topic instance logged through ADD_LOGGED_MSG
+    struct Subscription {
+        QString             topic;
+        int                 multiId;
+        quint16             msgId;
+        quint64             sampleCount;
+        quint64             firstTimestamp;
+        quint64             lastTimestamp;
+        qint64              endOffset;      ///< msg_id belongs to another subscription from here on, max if never removed
+        QVector<IndexEntry> index;
+    };
+
+    /// Opens and indexes the specified log file
+    ///     @return false: errorMessage set
+    bool open(const QString& fileName, QString& errorMessage);
+
+    /// Opens and indexes a log from an already open device. The device must remain valid until the log is closed.
+    ///     @return false: errorMessage set
+    bool open(QIODevice* device, QString& errorMessage);
+
+    void close(void);
+
+    bool        isOpen          (void) const { return _device != nullptr; }
+    quint8      version         (void) const { return _version; }
+    quint64     startTimestamp  (void) const { return _startTimestamp; }
+    quint64     endTimestamp    (void) const { return _endTimestamp; }
+
+    /// @return Names of all logged topics
+    QStringList topics(void) const;
+
+    const QList<Subscription>&      subscriptions   (void) const { return _subscriptions; }
+    const QMap<QString, QByteArray>& info           (void) const { return _info; }
+
+    /// @return Subscription for the specified topic instance, nullptr if it was not logged
+    const Subscription* subscription(const QString& topic, int multiId = 0) const;
+
+    /// @return Flattened columns for the specified topic format, empty if the format is unknown
+    QList<ColumnInfo> columns(const QString& topic) const;
+
+    /// Decodes all samples of a topic instance with startUs <= timestamp <= endUs.
+    ///     @param fields Column names to decode, all columns if empty
+    ///     @return false: errorMessage set
+    bool readTopic(const QString&       topic,
+                   int                  multiId,
+                   quint64              startUs,
+                   quint64              endUs,
+                   TopicData&           data,
+                   QString&             errorMessage,
+                   const QStringList&   fields = QStringList());
+
+    static int sizeOfType(ValueType type);
+
+    /// Number of samples between entries in the per topic timestamp index
+    static const int kIndexStride = 256;
+
+private:
+    struct Format {
+        QList<Field>    fields;
+        int             size;       ///< -1 until resolved
+    };
+
+    bool    _buildIndex         (QString& errorMessage);
+    bool    _parseFormat        (const char* data, int size);
+    int     _resolveFormatSize  (const QString& name, int depth);
+    void    _flattenColumns     (const QString& formatName, const QString& prefix, int offset, int depth, QList<ColumnInfo>& columns) const;
+    bool    _fill               (int bytes);
+    void    _seek               (qint64 offset);
+    bool    _nextMessage        (quint8& type, const char*& payload, int& size, qint64& offset);
+
+    static bool _typeFromString(const QString& typeName, ValueType& type);
+
+    QIODevice*                  _device;
+    bool                        _ownsDevice;
+    quint8                      _version;
+    quint64                     _startTimestamp;
+    quint64                     _endTimestamp;
+    QHash<QString, Format>      _formats;
+    QList<Subscription>         _subscriptions;
+    QHash<quint16, int>         _msgIdToSubscription;
+    QMap<QString, QByteArray>   _info;
+
+    // Streaming read buffer
+    QByteArray                  _buffer;
+    int                         _bufferPos;
+    qint64                      _bufferOffset;
+
+    static const int            _readChunkSize      = 1024 * 1024;
+    static const int            _fileHeaderLen      = 16;
+    static const int            _msgHeaderLen       = 3;
+    static const int            _maxNestingDepth    = 16;
+    static const char           _magic[7];
+};
@@ -0,0 +1,435 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ULogFileTest.h"
+#include "ULogFile.h"
+#include "ULogParser.h"
+
+#include <QBuffer>
+#include <QTemporaryFile>
+#include <QtEndian>
+
+#include <cstring>
+#include <limits>
+
+namespace {
+
+template<typename T>
+void _append(QByteArray& bytes, T value)
+{
+    char buffer[sizeof(T)];
+    memcpy(buffer, &value, sizeof(T));
+    bytes.append(buffer, sizeof(T));
+}
+
+void _writeMessage(QIODevice& device, char type, const QByteArray& payload)
+{
+    QByteArray message;
+    _append<quint16>(message, static_cast<quint16>(payload.size()));
+    message.append(type);
+    message.append(payload);
+    device.write(message);
+}
+
+void _writeData(QIODevice& device, quint16 msgId, const QByteArray& topicPayload)
+{
+    QByteArray payload;
+    _append<quint16>(payload, msgId);
+    payload.append(topicPayload);
+    _writeMessage(device, 'D', payload);
+}
+
+void _writeAddLogged(QIODevice& device, quint8 multiId, quint16 msgId, const QByteArray& topic)
+{
+    QByteArray payload;
+    _append<quint8>(payload, multiId);
+    _append<quint16>(payload, msgId);
+    payload.append(topic);
+    _writeMessage(device, 'A', payload);
+}
+
+const quint16 _sensorMsgId          = 0;
+const quint16 _sensorInstance1MsgId = 1;
+const quint16 _cameraMsgId          = 2;
+
+const int       _defaultSampleCount = 10000;
+const int       _benchmarkSamples   = 100000;
+const int       _cameraInterval     = 100;
+const quint64   _firstTimestamp     = 1000;
+const quint64   _sampleIntervalUs   = 1000;
+
+quint64 _timestamp(int sample)
+{
+    return _firstTimestamp + (static_cast<quint64>(sample) * _sampleIntervalUs);
+}
+
+}
+
+/// Writes a log with two instances of sensor_test and a camera_capture every _cameraInterval samples. sensor_test has a
+/// nested type, arrays and padding in the middle of the topic. camera_capture has its trailing padding removed, like PX4 does.
+void ULogFileTest::_writeLog(QIODevice& device, int sampleCount)
+{
+    QByteArray header("ULog\x01\x12\x35", 7);
+    _append<quint8>(header, 1);
+    _append<quint64>(header, 0);
+    device.write(header);
+
+    QByteArray infoKey("char[3] ver");
+    QByteArray info;
+    _append<quint8>(info, static_cast<quint8>(infoKey.size()));
+    info.append(infoKey);
+    info.append("abc");
+    _writeMessage(device, 'I', info);
+
+    _writeMessage(device, 'F', "vec3:float x;float y;float z;");
+    _writeMessage(device, 'F', "sensor_test:uint64_t timestamp;int32_t count;uint8_t[3] flags;uint8_t[1] _padding0;vec3 accel;double value;");
+    _writeMessage(device, 'F', "camera_capture:uint64_t timestamp;uint64_t timestamp_utc;double lat;double lon;float alt;float ground_distance;float[4] q;uint32_t seq;int8_t result;uint8_t[3] _padding0;");
+
+    _writeAddLogged(device, 0, _sensorMsgId,            "sensor_test");
+    _writeAddLogged(device, 1, _sensorInstance1MsgId,   "sensor_test");
+    _writeAddLogged(device, 0, _cameraMsgId,            "camera_capture");
+
+    for (int i=0; i<sampleCount; i++) {
+        quint64 timestamp = _timestamp(i);
+
+        QByteArray sensor;
+        _append<quint64>(sensor, timestamp);
+        _append<qint32>(sensor, i);
+        _append<quint8>(sensor, static_cast<quint8>(i & 0xff));
+        _append<quint8>(sensor, 1);
+        _append<quint8>(sensor, 2);
+        _append<quint8>(sensor, 0xaa);
+        _append<float>(sensor, i * 0.5f);
+        _append<float>(sensor, -i);
+        _append<float>(sensor, 1.0f);
+        _append<double>(sensor, i * 0.25);
+        _writeData(device, _sensorMsgId, sensor);
+
+        if (i % 2 == 0) {
+            // Second instance only differs in count
+            qint32 negCount = -i;
+            memcpy(sensor.data() + 8, &negCount, sizeof(negCount));
+            _writeData(device, _sensorInstance1MsgId, sensor);
+        }
+
+        if (i % _cameraInterval == 0) {
+            QByteArray camera;
+            _append<quint64>(camera, timestamp);
+            _append<quint64>(camera, 1500000000000000ull + timestamp);
+            _append<double>(camera, 47.0 + (i * 1.0e-6));
+            _append<double>(camera, 368.0 + (i * 1.0e-6)); // Out of range longitude must be wrapped
+            _append<float>(camera, 100.0f);
+            _append<float>(camera, 50.0f);
+            _append<float>(camera, 1.0f);
+            _append<float>(camera, 0.0f);
+            _append<float>(camera, 0.0f);
+            _append<float>(camera, 0.0f);
+            _append<quint32>(camera, static_cast<quint32>(i / _cameraInterval));
+            _append<qint8>(camera, 1);
+            _writeData(device, _cameraMsgId, camera);
+        }
+    }
+}
+
+void ULogFileTest::_testIndex(void)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    _writeLog(buffer, _defaultSampleCount);
+
+    ULogFile    ulog;
+    QString     errorMessage;
+    QVERIFY2(ulog.open(&buffer, errorMessage), qPrintable(errorMessage));
+
+    QCOMPARE(ulog.version(), static_cast<quint8>(1));
+    QCOMPARE(ulog.topics(), QStringList({ "sensor_test", "camera_capture" }));
+    QCOMPARE(ulog.subscriptions().count(), 3);
+    QCOMPARE(ulog.info().value("ver"), QByteArray("abc"));
+    QCOMPARE(ulog.startTimestamp(), _timestamp(0));
+    QCOMPARE(ulog.endTimestamp(), _timestamp(_defaultSampleCount - 1));
+
+    const ULogFile::Subscription* sub = ulog.subscription("sensor_test", 0);
+    QVERIFY(sub);
+    QCOMPARE(sub->msgId, _sensorMsgId);
+    QCOMPARE(sub->sampleCount, static_cast<quint64>(_defaultSampleCount));
+    QCOMPARE(sub->firstTimestamp, _timestamp(0));
+    QCOMPARE(sub->lastTimestamp, _timestamp(_defaultSampleCount - 1));
+    QCOMPARE(sub->index.count(), (_defaultSampleCount + ULogFile::kIndexStride - 1) / ULogFile::kIndexStride);
+    QCOMPARE(sub->index[1].timestamp, _timestamp(ULogFile::kIndexStride));
+
+    sub = ulog.subscription("sensor_test", 1);
+    QVERIFY(sub);
+    QCOMPARE(sub->sampleCount, static_cast<quint64>(_defaultSampleCount / 2));
+    QVERIFY(!ulog.subscription("sensor_test", 2));
+    QVERIFY(!ulog.subscription("missing_topic"));
+
+    // Nested types and arrays are flattened, padding is skipped over
+    const QList<ULogFile::ColumnInfo> columns = ulog.columns("sensor_test");
+    QStringList names;
+    for (const ULogFile::ColumnInfo& column: columns) {
+        names.append(column.name);
+    }
+    QCOMPARE(names, QStringList({ "timestamp", "count", "flags[0]", "flags[1]", "flags[2]", "accel.x", "accel.y", "accel.z", "value" }));
+    QCOMPARE(columns[5].offset, 16);
+    QCOMPARE(columns[8].offset, 28);
+    QCOMPARE(columns[8].type, ULogFile::TypeDouble);
+}
+
+void ULogFileTest::_testReadTopic(void)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    _writeLog(buffer, _defaultSampleCount);
+
+    ULogFile    ulog;
+    QString     errorMessage;
+    QVERIFY2(ulog.open(&buffer, errorMessage), qPrintable(errorMessage));
+
+    ULogFile::TopicData data;
+    QVERIFY2(ulog.readTopic("sensor_test", 0, 0, std::numeric_limits<quint64>::max(), data, errorMessage), qPrintable(errorMessage));
+    QCOMPARE(data.count(), _defaultSampleCount);
+    QCOMPARE(data.columns.count(), 8);
+
+    const ULogFile::Column* count = data.column("count");
+    const ULogFile::Column* flags0 = data.column("flags[0]");
+    const ULogFile::Column* accelY = data.column("accel.y");
+    const ULogFile::Column* value = data.column("value");
+    QVERIFY(count && flags0 && accelY && value);
+    QCOMPARE(count->type, ULogFile::TypeInt32);
+    QCOMPARE(count->count(), _defaultSampleCount);
+
+    for (int i: { 0, 1, 255, 256, 257, 5000, _defaultSampleCount - 1 }) {
+        QCOMPARE(data.timestamps[i], _timestamp(i));
+        QCOMPARE(count->values<qint32>()[i], i);
+        QCOMPARE(flags0->value(i), static_cast<double>(i & 0xff));
+        QCOMPARE(accelY->values<float>()[i], static_cast<float>(-i));
+        QCOMPARE(value->value(i), i * 0.25);
+    }
+
+    // Second instance
+    QVERIFY2(ulog.readTopic("sensor_test", 1, 0, std::numeric_limits<quint64>::max(), data, errorMessage), qPrintable(errorMessage));
+    QCOMPARE(data.count(), _defaultSampleCount / 2);
+    QCOMPARE(data.column("count")->values<qint32>()[10], -20);
+    QCOMPARE(data.timestamps[10], _timestamp(20));
+
+    // Field selection
+    QVERIFY2(ulog.readTopic("sensor_test", 0, 0, std::numeric_limits<quint64>::max(), data, errorMessage, { "value", "accel.x" }), qPrintable(errorMessage));
+    QCOMPARE(data.columns.count(), 2);
+    QCOMPARE(data.columnIndex("value"), 0);
+    QCOMPARE(data.columnIndex("accel.x"), 1);
+    QCOMPARE(data.columns[1].value(100), 50.0);
+
+    QVERIFY(!ulog.readTopic("sensor_test", 0, 0, std::numeric_limits<quint64>::max(), data, errorMessage, { "missing" }));
+    QVERIFY(!errorMessage.isEmpty());
+    QVERIFY(!ulog.readTopic("missing_topic", 0, 0, std::numeric_limits<quint64>::max(), data, errorMessage));
+    QVERIFY(!errorMessage.isEmpty());
+}
+
+void ULogFileTest::_testSeek(void)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    _writeLog(buffer, _defaultSampleCount);
+
+    ULogFile    ulog;
+    QString     errorMessage;
+    QVERIFY2(ulog.open(&buffer, errorMessage), qPrintable(errorMessage));
+
+    struct Range {
+        int first;
+        int last;
+    };
+
+    // Ranges starting/ending on and off index entries, within a single stride and at both ends of the log
+    for (const Range& range: { Range{ 3000, 3999 }, Range{ 256, 511 }, Range{ 300, 310 }, Range{ 0, 0 }, Range{ _defaultSampleCount - 10, _defaultSampleCount - 1 } }) {
+        ULogFile::TopicData data;
+        QVERIFY2(ulog.readTopic("sensor_test", 0, _timestamp(range.first), _timestamp(range.last), data, errorMessage, { "count" }), qPrintable(errorMessage));
+        QCOMPARE(data.count(), range.last - range.first + 1);
+        QCOMPARE(data.timestamps.first(), _timestamp(range.first));
+        QCOMPARE(data.timestamps.last(), _timestamp(range.last));
+        QCOMPARE(data.columns[0].values<qint32>()[0], range.first);
+    }
+
+    // Range between samples, before the log and after the log
+    ULogFile::TopicData data;
+    QVERIFY(ulog.readTopic("sensor_test", 0, _timestamp(10) + 1, _timestamp(11) - 1, data, errorMessage));
+    QCOMPARE(data.count(), 0);
+    QVERIFY(ulog.readTopic("sensor_test", 0, 0, _timestamp(0) - 1, data, errorMessage));
+    QCOMPARE(data.count(), 0);
+    QVERIFY(ulog.readTopic("sensor_test", 0, _timestamp(_defaultSampleCount), std::numeric_limits<quint64>::max(), data, errorMessage));
+    QCOMPARE(data.count(), 0);
+}
+
+void ULogFileTest::_testTruncated(void)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    _writeLog(buffer, 1000);
+
+    // Cut the last message (sensor_test instance 0) in half, as happens when logging stops unexpectedly
+    QByteArray truncated = buffer.data();
+    truncated.chop(10);
+    QBuffer truncatedBuffer(&truncated);
+    truncatedBuffer.open(QIODevice::ReadOnly);
+
+    ULogFile    ulog;
+    QString     errorMessage;
+    QVERIFY2(ulog.open(&truncatedBuffer, errorMessage), qPrintable(errorMessage));
+    QCOMPARE(ulog.subscription("sensor_test", 0)->sampleCount, static_cast<quint64>(999));
+    QCOMPARE(ulog.subscription("sensor_test", 1)->sampleCount, static_cast<quint64>(500));
+
+    QByteArray notULog("This is not a ULog file");
+    QBuffer notULogBuffer(&notULog);
+    notULogBuffer.open(QIODevice::ReadOnly);
+    QVERIFY(!ulog.open(&notULogBuffer, errorMessage));
+    QVERIFY(!errorMessage.isEmpty());
+    QVERIFY(!ulog.isOpen());
+}
+
+void ULogFileTest::_testGeoTags(void)
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    _writeLog(file, _defaultSampleCount);
+    file.close();
+
+    QList<GeoTagWorker::cameraFeedbackPacket>   feedback;
+    QString                                     errorMessage;
+    ULogParser                                  parser;
+    QVERIFY2(parser.getTagsFromLog(file.fileName(), feedback, errorMessage), qPrintable(errorMessage));
+    QCOMPARE(feedback.count(), _defaultSampleCount / _cameraInterval);
+
+    const GeoTagWorker::cameraFeedbackPacket& packet = feedback[10];
+    QCOMPARE(packet.imageSequence, static_cast<uint32_t>(10));
+    QCOMPARE(packet.timestamp, _timestamp(10 * _cameraInterval) / 1.0e6);
+    QCOMPARE(packet.timestampUTC, (1500000000000000ull + _timestamp(10 * _cameraInterval)) / 1.0e6);
+    QCOMPARE(packet.latitude, 47.0 + (10 * _cameraInterval * 1.0e-6));
+    QVERIFY(qAbs(packet.longitude - (8.0 + (10 * _cameraInterval * 1.0e-6))) < 1.0e-9);
+    QCOMPARE(packet.altitude, 100.0f);
+    QCOMPARE(packet.groundDistance, 50.0f);
+    QCOMPARE(packet.attitudeQuaternion[0], 1.0f);
+    QCOMPARE(packet.captureResult, static_cast<uint8_t>(1));
+}
+
+/// Data for a msg_id belongs to whichever subscription last added it, reading a topic must not pick up samples logged
+/// under the same msg_id for another topic
+void ULogFileTest::_testMsgIdReuse(void)
+{
+    const quint16 reusedMsgId = 7;
+
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+
+    QByteArray header("ULog\x01\x12\x35", 7);
+    _append<quint8>(header, 1);
+    _append<quint64>(header, 0);
+    buffer.write(header);
+
+    _writeMessage(buffer, 'F', "first_test:uint64_t timestamp;int32_t count;");
+    _writeMessage(buffer, 'F', "second_test:uint64_t timestamp;int32_t count;");
+
+    auto writeSamples = [&buffer, reusedMsgId](int firstCount, int sampleCount) {
+        for (int i=firstCount; i<firstCount+sampleCount; i++) {
+            QByteArray sample;
+            _append<quint64>(sample, _timestamp(i));
+            _append<qint32>(sample, i);
+            _writeData(buffer, reusedMsgId, sample);
+        }
+    };
+
+    // Removed and then added for another topic
+    _writeAddLogged(buffer, 0, reusedMsgId, "first_test");
+    writeSamples(0, 10);
+    QByteArray remove;
+    _append<quint16>(remove, reusedMsgId);
+    _writeMessage(buffer, 'R', remove);
+    _writeAddLogged(buffer, 0, reusedMsgId, "second_test");
+    writeSamples(100, 20);
+
+    // Added again without a remove
+    _writeAddLogged(buffer, 1, reusedMsgId, "first_test");
+    writeSamples(200, 5);
+
+    ULogFile    ulog;
+    QString     errorMessage;
+    QVERIFY2(ulog.open(&buffer, errorMessage), qPrintable(errorMessage));
+    QCOMPARE(ulog.subscriptions().count(), 3);
+
+    struct {
+        const char* topic;
+        int         multiId;
+        int         firstCount;
+        int         sampleCount;
+    } rgExpected[] = {
+        { "first_test",     0,  0,      10 },
+        { "second_test",    0,  100,    20 },
+        { "first_test",     1,  200,    5 },
+    };
+
+    for (const auto& expected: rgExpected) {
+        const ULogFile::Subscription* sub = ulog.subscription(expected.topic, expected.multiId);
+        QVERIFY(sub);
+        QCOMPARE(sub->sampleCount, static_cast<quint64>(expected.sampleCount));
+
+        ULogFile::TopicData data;
+        QVERIFY2(ulog.readTopic(expected.topic, expected.multiId, 0, std::numeric_limits<quint64>::max(), data, errorMessage), qPrintable(errorMessage));
+        QCOMPARE(data.count(), expected.sampleCount);
+        const ULogFile::Column* count = data.column("count");
+        QVERIFY(count);
+        QCOMPARE(count->value(0), static_cast<double>(expected.firstCount));
+        QCOMPARE(count->value(expected.sampleCount - 1), static_cast<double>(expected.firstCount + expected.sampleCount - 1));
+    }
+}
+
+int ULogFileTest::_writeBenchmarkLog(QTemporaryFile& file)
+{
+    int sampleCount = qEnvironmentVariableIsSet("QGC_ULOG_BENCHMARK_SAMPLES") ? qEnvironmentVariableIntValue("QGC_ULOG_BENCHMARK_SAMPLES") : _benchmarkSamples;
+
+    if (file.open()) {
+        _writeLog(file, sampleCount);
+        file.flush();
+    }
+    return sampleCount;
+}
+
+void ULogFileTest::_benchmarkOpen(void)
+{
+    QTemporaryFile  file;
+    int             sampleCount = _writeBenchmarkLog(file);
+    QVERIFY(file.isOpen());
+
+    ULogFile    ulog;
+    QString     errorMessage;
+
+    QBENCHMARK {
+        QVERIFY2(ulog.open(file.fileName(), errorMessage), qPrintable(errorMessage));
+    }
+    QCOMPARE(ulog.subscription("sensor_test", 0)->sampleCount, static_cast<quint64>(sampleCount));
+}
+
+void ULogFileTest::_benchmarkReadTopic(void)
+{
+    QTemporaryFile  file;
+    int             sampleCount = _writeBenchmarkLog(file);
+    QVERIFY(file.isOpen());
+
+    ULogFile    ulog;
+    QString     errorMessage;
+    QVERIFY2(ulog.open(file.fileName(), errorMessage), qPrintable(errorMessage));
+
+    // One second of data from the middle of the log, all columns
+    int first = sampleCount / 2;
+    int last = qMin(first + static_cast<int>(1000000 / _sampleIntervalUs), sampleCount) - 1;
+    ULogFile::TopicData data;
+    QBENCHMARK {
+        QVERIFY2(ulog.readTopic("sensor_test", 0, _timestamp(first), _timestamp(last), data, errorMessage), qPrintable(errorMessage));
+    }
+    QCOMPARE(data.count(), last - first + 1);
+    QCOMPARE(data.column("count")->values<qint32>()[0], first);
+}
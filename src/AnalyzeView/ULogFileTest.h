@@ -0,0 +1,36 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class QIODevice;
+class QTemporaryFile;
+
+/// Tests ULogFile against generated logs. The benchmarks measure index build and time range decode,
+/// set QGC_ULOG_BENCHMARK_SAMPLES to benchmark a larger log.
+class ULogFileTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testIndex(void);
+    void _testReadTopic(void);
+    void _testSeek(void);
+    void _testTruncated(void);
+    void _testMsgIdReuse(void);
+    void _testGeoTags(void);
+    void _benchmarkOpen(void);
+    void _benchmarkReadTopic(void);
+
+private:
+    void _writeLog(QIODevice& device, int sampleCount);
+    int  _writeBenchmarkLog(QTemporaryFile& file);
+};
@@ -12,16 +12,19 @@
 #include "QGCMAVLink.h"
 #include "QGCApplication.h"
 #include "QGCCorePlugin.h"
+#include "QGCLoggingCategory.h"
 
 #include <QtQml>
 #include <QQmlEngine>
+#include <QMetaMethod>
+
+QGC_LOGGING_CATEGORY(FactLog, "FactLog")
 
 static const char* kMissingMetadata = "Meta data pointer missing";
 
 Fact::Fact(QObject* parent)
     : QObject                   (parent)
     , _componentId              (-1)
-    , _rawValue                 (0)
     , _type                     (FactMetaData::valueTypeInt32)
     , _metaData                 (nullptr)
     , _sendValueChangedSignals  (true)
@@ -39,7 +42,6 @@ Fact::Fact(int componentId, QString name, FactMetaData::ValueType_t type, QObjec
     : QObject                   (parent)
     , _name                     (name)
     , _componentId              (componentId)
-    , _rawValue                 (0)
     , _type                     (type)
     , _metaData                 (nullptr)
     , _sendValueChangedSignals  (true)
@@ -57,7 +59,6 @@ Fact::Fact(const QString& settingsGroup, FactMetaData* metaData, QObject* parent
     : QObject(parent)
     , _name                     (metaData->name())
     , _componentId              (0)
-    , _rawValue                 (0)
     , _type                     (metaData->type())
     , _metaData                 (nullptr)
     , _sendValueChangedSignals  (true)
@@ -96,7 +97,7 @@ const Fact& Fact::operator=(const Fact& other)
     _valueSliderModel           = nullptr;
     _ignoreQGCRebootRequired    = other._ignoreQGCRebootRequired;
     if (_metaData && other._metaData) {
-        *_metaData = *other._metaData;
+        *_metaDataForWrite() = *other._metaData;
     } else {
         _metaData = nullptr;
     }
@@ -107,15 +108,9 @@ const Fact& Fact::operator=(const Fact& other)
 void Fact::forceSetRawValue(const QVariant& value)
 {
     if (_metaData) {
-        QVariant    typedValue;
-        QString     errorString;
-        
-        if (_metaData->convertAndValidateRaw(value, true /* convertOnly */, typedValue, errorString)) {
-            _rawValue.setValue(typedValue);
-            _sendValueChangedSignal(cookedValue());
-            //-- Must be in this order
-            emit _containerRawValueChanged(rawValue());
-            emit rawValueChanged(_rawValue);
+        if (_rawValue.setFromVariant(_type, value)) {
+            _sendValueChangedSignal();
+            _sendRawValueChangedSignals(true /* containerSignal */);
         }
     } else {
         qWarning() << kMissingMetadata << name();
@@ -125,16 +120,13 @@ void Fact::forceSetRawValue(const QVariant& value)
 void Fact::setRawValue(const QVariant& value)
 {
     if (_metaData) {
-        QVariant    typedValue;
-        QString     errorString;
-        
-        if (_metaData->convertAndValidateRaw(value, true /* convertOnly */, typedValue, errorString)) {
+        // Typed conversion matches FactMetaData::convertAndValidateRaw(convertOnly) without the QVariant/QString overhead
+        FactValue typedValue;
+        if (typedValue.setFromVariant(_type, value)) {
             if (typedValue != _rawValue) {
-                _rawValue.setValue(typedValue);
-                _sendValueChangedSignal(cookedValue());
-                //-- Must be in this order
-                emit _containerRawValueChanged(rawValue());
-                emit rawValueChanged(_rawValue);
+                _rawValue = typedValue;
+                _sendValueChangedSignal();
+                _sendRawValueChangedSignals(true /* containerSignal */);
             }
         }
     } else {
@@ -179,14 +171,18 @@ void Fact::setEnumIndex(int index)
 
 void Fact::_containerSetRawValue(const QVariant& value)
 {
-    if(_rawValue != value) {
-        _rawValue = value;
-        _sendValueChangedSignal(cookedValue());
-        emit rawValueChanged(_rawValue);
+    FactValue typedValue;
+    if (!typedValue.setFromVariant(_type, value)) {
+        // The current value is kept, usually this means telemetry is decoded into a Fact of the wrong type
+        qCWarning(FactLog) << "Unable to convert value for fact:type:value" << _name << _type << value;
+    } else if (typedValue != _rawValue) {
+        _rawValue = typedValue;
+        _sendValueChangedSignal();
+        _sendRawValueChangedSignals(false /* containerSignal */);
     }
 
     // This always need to be signalled in order to support forceSetRawValue usage and waiting for vehicleUpdated signal
-    emit vehicleUpdated(_rawValue);
+    emit vehicleUpdated(rawValue());
 }
 
 QString Fact::name(void) const
@@ -202,10 +198,10 @@ int Fact::componentId(void) const
 QVariant Fact::cookedValue(void) const
 {
     if (_metaData) {
-        return _metaData->rawTranslator()(_rawValue);
+        return _metaData->rawTranslator()(rawValue());
     } else {
         qWarning() << kMissingMetadata << name();
-        return _rawValue;
+        return rawValue();
     }
 }
 
@@ -244,7 +240,7 @@ int Fact::enumIndex(void)
                 index ++;
             }
             // Current value is not in list, add it manually
-            _metaData->addEnumInfo(tr("Unknown: %1").arg(rawValue().toString()), rawValue());
+            _metaDataForWrite()->addEnumInfo(tr("Unknown: %1").arg(rawValue().toString()), rawValue());
             emit enumsChanged();
             return index;
         }
@@ -277,7 +273,7 @@ QVariantList Fact::enumValues(void) const
 void Fact::setEnumInfo(const QStringList& strings, const QVariantList& values)
 {
     if (_metaData) {
-        _metaData->setEnumInfo(strings, values);
+        _metaDataForWrite()->setEnumInfo(strings, values);
     } else {
         qWarning() << kMissingMetadata << name();
     }
@@ -543,6 +539,16 @@ QString Fact::group(void) const
     }
 }
 
+FactMetaData* Fact::_metaDataForWrite(void)
+{
+    // Meta data which this fact does not own may be shared with other facts, for example by all vehicles using the same
+    // parameter meta data. It is copied before the first change so the change only applies to this fact.
+    if (_metaData && _metaData->parent() != this) {
+        _metaData = new FactMetaData(*_metaData, this);
+    }
+    return _metaData;
+}
+
 void Fact::setMetaData(FactMetaData* metaData, bool setDefaultFromMetaData)
 {
     _metaData = metaData;
@@ -637,16 +643,36 @@ void Fact::setSendValueChangedSignals (bool sendValueChangedSignals)
     }
 }
 
-void Fact::_sendValueChangedSignal(QVariant value)
+void Fact::_sendValueChangedSignal(void)
 {
     if (_sendValueChangedSignals) {
-        emit valueChanged(value);
+        emit valueChanged(cookedValue());
         _deferredValueChangeSignal = false;
     } else {
         _deferredValueChangeSignal = true;
     }
 }
 
+/// Most telemetry facts have no raw value listeners, so the QVariant for the signals is only built when someone is connected
+void Fact::_sendRawValueChangedSignals(bool containerSignal)
+{
+    static const QMetaMethod rawValueChangedSignal =            QMetaMethod::fromSignal(&Fact::rawValueChanged);
+    static const QMetaMethod containerRawValueChangedSignal =   QMetaMethod::fromSignal(&Fact::_containerRawValueChanged);
+
+    bool sendContainer =    containerSignal && isSignalConnected(containerRawValueChangedSignal);
+    bool sendRaw =          isSignalConnected(rawValueChangedSignal);
+    if (sendContainer || sendRaw) {
+        QVariant newRawValue = rawValue();
+        //-- Must be in this order
+        if (sendContainer) {
+            emit _containerRawValueChanged(newRawValue);
+        }
+        if (sendRaw) {
+            emit rawValueChanged(newRawValue);
+        }
+    }
+}
+
 void Fact::sendDeferredValueChangedSignal(void)
 {
     if (_deferredValueChangeSignal) {
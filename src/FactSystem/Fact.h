@@ -15,6 +15,7 @@
 #define Fact_H
 
 #include "FactMetaData.h"
+#include "FactValue.h"
 
 #include <QObject>
 #include <QString>
@@ -86,7 +87,7 @@ public:
     Q_INVOKABLE QVariant clamp(const QString& cookedValue);
 
     QVariant        cookedValue             (void) const;   /// Value after translation
-    QVariant        rawValue                (void) const { return _rawValue; }  /// value prior to translation, careful
+    QVariant        rawValue                (void) const { return _rawValue.toVariant(_type); }  /// value prior to translation, careful
     int             componentId             (void) const;
     int             decimalPlaces           (void) const;
     QVariant        rawDefaultValue         (void) const;
@@ -146,7 +147,8 @@ public:
     int  valueIndex         (const QString& value);
 
     // The following methods allow you to defer sending of the valueChanged signals in order to implement
-    // rate limited signalling for ui performance. Used by FactGroup for example.
+    // rate limited signalling for ui performance. Used by FactGroup for example. While signals are deferred
+    // the cooked value is not calculated until the deferred signal is sent.
 
     void setSendValueChangedSignals (bool sendValueChangedSignals);
     bool sendValueChangedSignals (void) const { return _sendValueChangedSignals; }
@@ -166,6 +168,11 @@ public:
     
     FactMetaData* metaData() { return _metaData; }
 
+    /// Use this instead of metaData() to change the meta data of a single fact. Meta data which the fact does not own is
+    /// copied before it is returned.
+    /// @return Meta data which can be modified without affecting other facts, nullptr if there is no meta data
+    FactMetaData* _metaDataForWrite(void);
+
     //-- Value coming from Vehicle. This does NOT send a _containerRawValueChanged signal.
     void _containerSetRawValue(const QVariant& value);
     
@@ -203,11 +210,12 @@ private:
     
 protected:
     QString _variantToString(const QVariant& variant, int decimalPlaces) const;
-    void _sendValueChangedSignal(QVariant value);
+    void _sendValueChangedSignal(void);
+    void _sendRawValueChangedSignals(bool containerSignal);
 
     QString                     _name;
     int                         _componentId;
-    QVariant                    _rawValue;
+    FactValue                   _rawValue;
     FactMetaData::ValueType_t   _type;
     FactMetaData*               _metaData;
     bool                        _sendValueChangedSignals;
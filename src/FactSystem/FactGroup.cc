@@ -10,6 +10,8 @@
 
 #include "FactGroup.h"
 #include "JsonHelper.h"
+#include "QGCApplication.h"
+#include "QGCFrameScheduler.h"
 
 #include <QJsonDocument>
 #include <QJsonParseError>
@@ -25,7 +27,7 @@ FactGroup::FactGroup(int updateRateMsecs, const QString& metaDataFile, QObject*
     , _updateRateMSecs(updateRateMsecs)
 {
     _setupTimer();
-    _nameToFactMetaDataMap = FactMetaData::createMapFromJsonFile(metaDataFile, this);
+    _nameToFactMetaDataMap = FactMetaData::sharedMapFromJsonFile(metaDataFile);
 }
 
 FactGroup::FactGroup(int updateRateMsecs, QObject* parent)
@@ -43,11 +45,19 @@ void FactGroup::_loadFromJsonArray(const QJsonArray jsonArray)
 
 void FactGroup::_setupTimer()
 {
-    if (_updateRateMSecs > 0) {
-        connect(&_updateTimer, &QTimer::timeout, this, &FactGroup::_updateAllValues);
-        _updateTimer.setSingleShot(false);
-        _updateTimer.setInterval(_updateRateMSecs);
-        _updateTimer.start();
+    if (_updateRateMSecs <= 0) {
+        return;
+    }
+
+    QGCToolbox* toolbox = qgcApp() ? qgcApp()->toolbox() : nullptr;
+    _frameScheduler = toolbox ? toolbox->frameScheduler() : nullptr;
+
+    if (_frameScheduler) {
+        _updateTaskId = _frameScheduler->registerTask(this, _updateRateMSecs, [this]() { _updateAllValues(); });
+    } else {
+        // Groups created while the toolbox is being constructed have nothing to defer their signals to
+        qCWarning(FactGroupLog) << "No frame scheduler, value changes are signalled immediately" << this;
+        _updateRateMSecs = 0;
     }
 }
 
@@ -122,22 +132,27 @@ void FactGroup::_addFactGroup(FactGroup* factGroup, const QString& name)
 
 void FactGroup::_updateAllValues(void)
 {
+    int signalCount = 0;
+
     for(Fact* fact: _nameToFactMap) {
+        if (fact->deferredValueChangeSignal()) {
+            signalCount++;
+        }
         fact->sendDeferredValueChangedSignal();
     }
+
+    if (_frameScheduler) {
+        _frameScheduler->addSignalsEmitted(signalCount);
+    }
 }
 
 void FactGroup::setLiveUpdates(bool liveUpdates)
 {
-    if (_updateTimer.interval() == 0) {
+    if (_updateTaskId == 0) {
         return;
     }
 
-    if (liveUpdates) {
-        _updateTimer.stop();
-    } else {
-        _updateTimer.start();
-    }
+    _frameScheduler->setTaskActive(_updateTaskId, !liveUpdates);
     for(Fact* fact: _nameToFactMap) {
         fact->setSendValueChangedSignals(liveUpdates);
     }
@@ -20,6 +20,8 @@
 
 Q_DECLARE_LOGGING_CATEGORY(VehicleLog)
 
+class QGCFrameScheduler;
+
 /// Used to group Facts together into an object hierarachy.
 class FactGroup : public QObject
 {
@@ -49,14 +51,16 @@ protected:
     void _addFactGroup(FactGroup* factGroup, const QString& name);
     void _loadFromJsonArray(const QJsonArray jsonArray);
 
-    int _updateRateMSecs;   ///< Update rate for Fact::valueChanged signals, 0: immediate update
+    int _updateRateMSecs;   ///< Update rate for Fact::valueChanged signals, 0: immediate update. Deferred signals from all
+                            ///< groups are sent together by QGCFrameScheduler.
 
 protected slots:
     virtual void _updateAllValues(void);
 
 private:
     void _setupTimer();
-    QTimer _updateTimer;
+    int                 _updateTaskId   = 0;        ///< QGCFrameScheduler task, 0 for none
+    QGCFrameScheduler*  _frameScheduler = nullptr;  ///< Scheduler running _updateTaskId, set whenever there is a task
 
 protected:
     QMap<QString, Fact*>            _nameToFactMap;
@@ -16,6 +16,9 @@
 #include <QtMath>
 #include <QJsonParseError>
 #include <QJsonArray>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 
 #include <limits>
 #include <cmath>
@@ -1220,18 +1223,10 @@ QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonFile(const QString&
 {
     QMap<QString, FactMetaData*> metaDataMap;
 
-    QFile jsonFile(jsonFilename);
-    if (!jsonFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Unable to open file" << jsonFilename << jsonFile.errorString();
-        return metaDataMap;
-    }
-
-    QByteArray bytes = jsonFile.readAll();
-    jsonFile.close();
-    QJsonParseError jsonParseError;
-    QJsonDocument doc = QJsonDocument::fromJson(bytes, &jsonParseError);
-    if (jsonParseError.error != QJsonParseError::NoError) {
-        qWarning() <<  "Unable to parse json document filename:error:offset" << jsonFilename << jsonParseError.errorString() << jsonParseError.offset;
+    QString         errorString;
+    QJsonDocument   doc;
+    if (!JsonHelper::openJsonFile(jsonFilename, doc, errorString)) {
+        qWarning() << errorString;
         return metaDataMap;
     }
 
@@ -1240,7 +1235,6 @@ QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonFile(const QString&
 
     if (doc.isObject()) {
         // Check for Defines/Facts format
-        QString errorString;
         QList<JsonHelper::KeyValidateInfo> keyInfoList = {
             { FactMetaData::_jsonMetaDataDefinesName,   QJsonValue::Object, true },
             { FactMetaData::_jsonMetaDataFactsName,     QJsonValue::Array, true },
@@ -1262,6 +1256,21 @@ QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonFile(const QString&
     return createMapFromJsonArray(factArray, defineMap, metaDataParent);
 }
 
+QMap<QString, FactMetaData*> FactMetaData::sharedMapFromJsonFile(const QString& jsonFilename)
+{
+    static QMutex                                           sharedMutex;
+    static QHash<QString, QMap<QString, FactMetaData*>>     sharedMaps;
+
+    QMutexLocker lock(&sharedMutex);
+
+    auto it = sharedMaps.constFind(jsonFilename);
+    if (it == sharedMaps.constEnd()) {
+        it = sharedMaps.insert(jsonFilename, createMapFromJsonFile(jsonFilename, nullptr /* metaDataParent */));
+    }
+
+    return it.value();
+}
+
 QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonArray(const QJsonArray jsonArray, QMap<QString, QString>& defineMap, QObject* metaDataParent)
 {
     QMap<QString, FactMetaData*> metaDataMap;
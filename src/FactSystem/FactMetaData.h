@@ -54,6 +54,10 @@ public:
     FactMetaData(const FactMetaData& other, QObject* parent = nullptr);
 
     static QMap<QString, FactMetaData*> createMapFromJsonFile(const QString& jsonFilename, QObject* metaDataParent);
+
+    /// Returns the meta data for a json file, created on first use and then shared by every caller for the lifetime of the
+    /// application. The shared meta data must not be modified, copy it first for per instance changes.
+    static QMap<QString, FactMetaData*> sharedMapFromJsonFile(const QString& jsonFilename);
     static QMap<QString, FactMetaData*> createMapFromJsonArray(const QJsonArray jsonArray, QMap<QString, QString>& defineMap, QObject* metaDataParent);
 
     static FactMetaData* createFromJsonObject(const QJsonObject& json, QMap<QString, QString>& defineMap, QObject* metaDataParent);
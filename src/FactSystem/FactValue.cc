@@ -0,0 +1,114 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FactValue.h"
+
+#include <cstring>
+
+FactValue::FactValue(void)
+{
+    _value.u = 0;
+}
+
+bool FactValue::setFromVariant(FactMetaData::ValueType_t type, const QVariant& value)
+{
+    bool convertOk = false;
+
+    // The whole union is cleared first so that operator== can compare it bitwise regardless of which member is in use
+    decltype(_value) newValue;
+    newValue.u = 0;
+
+    switch (type) {
+    case FactMetaData::valueTypeInt8:
+    case FactMetaData::valueTypeInt16:
+    case FactMetaData::valueTypeInt32:
+        newValue.i = value.toInt(&convertOk);
+        break;
+    case FactMetaData::valueTypeInt64:
+        newValue.i = value.toLongLong(&convertOk);
+        break;
+    case FactMetaData::valueTypeUint8:
+    case FactMetaData::valueTypeUint16:
+    case FactMetaData::valueTypeUint32:
+        newValue.u = value.toUInt(&convertOk);
+        break;
+    case FactMetaData::valueTypeUint64:
+        newValue.u = value.toULongLong(&convertOk);
+        break;
+    case FactMetaData::valueTypeFloat:
+        newValue.f = value.toFloat(&convertOk);
+        break;
+    case FactMetaData::valueTypeElapsedTimeInSeconds:
+    case FactMetaData::valueTypeDouble:
+        newValue.d = value.toDouble(&convertOk);
+        break;
+    case FactMetaData::valueTypeBool:
+        newValue.b = value.toBool();
+        convertOk = true;
+        break;
+    case FactMetaData::valueTypeString:
+        _value = newValue;
+        _variant = QVariant(value.toString());
+        return true;
+    case FactMetaData::valueTypeCustom:
+        _value = newValue;
+        _variant = QVariant(value.toByteArray());
+        return true;
+    }
+
+    if (convertOk) {
+        _value = newValue;
+        _variant.clear();
+    }
+
+    return convertOk;
+}
+
+QVariant FactValue::toVariant(FactMetaData::ValueType_t type) const
+{
+    switch (type) {
+    case FactMetaData::valueTypeInt8:
+    case FactMetaData::valueTypeInt16:
+    case FactMetaData::valueTypeInt32:
+        return QVariant(static_cast<int>(_value.i));
+    case FactMetaData::valueTypeInt64:
+        return QVariant(static_cast<qlonglong>(_value.i));
+    case FactMetaData::valueTypeUint8:
+    case FactMetaData::valueTypeUint16:
+    case FactMetaData::valueTypeUint32:
+        return QVariant(static_cast<uint>(_value.u));
+    case FactMetaData::valueTypeUint64:
+        return QVariant(static_cast<qulonglong>(_value.u));
+    case FactMetaData::valueTypeFloat:
+        return QVariant(_value.f);
+    case FactMetaData::valueTypeElapsedTimeInSeconds:
+    case FactMetaData::valueTypeDouble:
+        return QVariant(_value.d);
+    case FactMetaData::valueTypeBool:
+        return QVariant(_value.b);
+    case FactMetaData::valueTypeString:
+        return _variant.isValid() ? _variant : QVariant(QString());
+    case FactMetaData::valueTypeCustom:
+        return _variant.isValid() ? _variant : QVariant(QByteArray());
+    }
+
+    return QVariant();
+}
+
+bool FactValue::operator==(const FactValue& other) const
+{
+    // Bitwise comparison also means a NaN value compares equal to itself, so repeated NaN updates do not signal a change
+    if (std::memcmp(&_value, &other._value, sizeof(_value)) != 0) {
+        return false;
+    }
+    if (_variant.isValid() || other._variant.isValid()) {
+        return _variant == other._variant;
+    }
+    return true;
+}
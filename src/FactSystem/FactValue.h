@@ -0,0 +1,45 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "FactMetaData.h"
+
+#include <QVariant>
+
+/// Raw value storage for a Fact. Numeric and bool values are held in a fixed size union so that high rate telemetry updates
+/// do not go through QVariant conversion and comparison. Only string and custom values are kept in a QVariant.
+///
+/// The value type is not stored, it is always supplied by the owning Fact.
+class FactValue
+{
+public:
+    FactValue(void);
+
+    /// Converts the specified value to the storage for type. Conversion rules match FactMetaData::convertAndValidateRaw with
+    /// convertOnly set.
+    ///     @return false: conversion failed, value is unchanged
+    bool setFromVariant(FactMetaData::ValueType_t type, const QVariant& value);
+
+    /// @return Value as a QVariant with the same variant type FactMetaData::convertAndValidateRaw produces for type
+    QVariant toVariant(FactMetaData::ValueType_t type) const;
+
+    bool operator==(const FactValue& other) const;
+    bool operator!=(const FactValue& other) const { return !(*this == other); }
+
+private:
+    union {
+        qint64  i;
+        quint64 u;
+        double  d;
+        float   f;
+        bool    b;
+    } _value;
+    QVariant _variant;  ///< Only used for string and custom types
+};
@@ -0,0 +1,206 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "PackedParameterFile.h"
+
+#include <QtEndian>
+#include <cstring>
+
+QGC_LOGGING_CATEGORY(PackedParameterFileLog, "PackedParameterFileLog")
+
+int PackedParameterFile::_typeSize(int paramType)
+{
+    switch (paramType) {
+    case ParamTypeInt8:
+        return 1;
+    case ParamTypeInt16:
+        return 2;
+    case ParamTypeInt32:
+    case ParamTypeFloat:
+        return 4;
+    default:
+        return -1;
+    }
+}
+
+int PackedParameterFile::_mavTypeToParamType(MAV_PARAM_TYPE mavType)
+{
+    switch (mavType) {
+    case MAV_PARAM_TYPE_INT8:
+    case MAV_PARAM_TYPE_UINT8:
+        return ParamTypeInt8;
+    case MAV_PARAM_TYPE_INT16:
+    case MAV_PARAM_TYPE_UINT16:
+        return ParamTypeInt16;
+    case MAV_PARAM_TYPE_INT32:
+    case MAV_PARAM_TYPE_UINT32:
+        return ParamTypeInt32;
+    case MAV_PARAM_TYPE_REAL32:
+        return ParamTypeFloat;
+    default:
+        return ParamTypeNone;
+    }
+}
+
+bool PackedParameterFile::decode(const QByteArray& fileContents, QList<Parameter>& parameters, int& totalParameterCount, QString& errorString)
+{
+    parameters.clear();
+    totalParameterCount = 0;
+    errorString.clear();
+
+    const uchar*    data =      reinterpret_cast<const uchar*>(fileContents.constData());
+    const int       dataSize =  fileContents.size();
+
+    if (dataSize < _headerSize) {
+        errorString = QStringLiteral("File too short for header");
+        return false;
+    }
+
+    quint16 magic = qFromLittleEndian<quint16>(data);
+    if (magic != _magicNoDefaults && magic != _magicWithDefaults) {
+        errorString = QStringLiteral("Unsupported magic 0x%1").arg(magic, 4, 16, QLatin1Char('0'));
+        return false;
+    }
+    bool        withDefaults =  magic == _magicWithDefaults;
+    int         fileCount =     qFromLittleEndian<quint16>(data + 2);
+    totalParameterCount =       qFromLittleEndian<quint16>(data + 4);
+
+    parameters.reserve(fileCount);
+
+    char    name[_maxNameLength + 1];
+    int     nameLength =    0;
+    int     offset =        _headerSize;
+
+    while (parameters.count() < fileCount) {
+        // Skip padding
+        while (offset < dataSize && data[offset] == 0) {
+            offset++;
+        }
+        if (offset + 2 > dataSize) {
+            errorString = QStringLiteral("Truncated file, decoded %1 of %2 parameters").arg(parameters.count()).arg(fileCount);
+            return false;
+        }
+
+        int type =          data[offset] & 0x0F;
+        int flags =         (data[offset] >> 4) & 0x0F;
+        int commonLength =  data[offset + 1] & 0x0F;
+        int suffixLength =  ((data[offset + 1] >> 4) & 0x0F) + 1;
+        offset += 2;
+
+        int valueSize = _typeSize(type);
+        if (valueSize < 0) {
+            errorString = QStringLiteral("Invalid parameter type %1").arg(type);
+            return false;
+        }
+        if (commonLength > nameLength || commonLength + suffixLength > _maxNameLength) {
+            errorString = QStringLiteral("Invalid parameter name length");
+            return false;
+        }
+        int defaultSize = (withDefaults && (flags & 0x01)) ? valueSize : 0;
+        if (offset + suffixLength + valueSize + defaultSize > dataSize) {
+            errorString = QStringLiteral("Truncated file, decoded %1 of %2 parameters").arg(parameters.count()).arg(fileCount);
+            return false;
+        }
+
+        // Names are delta encoded against the previous name
+        memcpy(&name[commonLength], &data[offset], static_cast<size_t>(suffixLength));
+        nameLength = commonLength + suffixLength;
+        name[nameLength] = '\0';
+        offset += suffixLength;
+
+        Parameter parameter;
+        parameter.name = QString::fromLatin1(name, nameLength);
+        switch (type) {
+        case ParamTypeInt8:
+            parameter.mavType = MAV_PARAM_TYPE_INT8;
+            parameter.value = QVariant(static_cast<qint8>(data[offset]));
+            break;
+        case ParamTypeInt16:
+            parameter.mavType = MAV_PARAM_TYPE_INT16;
+            parameter.value = QVariant(qFromLittleEndian<qint16>(&data[offset]));
+            break;
+        case ParamTypeInt32:
+            parameter.mavType = MAV_PARAM_TYPE_INT32;
+            parameter.value = QVariant(qFromLittleEndian<qint32>(&data[offset]));
+            break;
+        case ParamTypeFloat:
+        {
+            quint32 bits = qFromLittleEndian<quint32>(&data[offset]);
+            float   value;
+            memcpy(&value, &bits, sizeof(value));
+            parameter.mavType = MAV_PARAM_TYPE_REAL32;
+            parameter.value = QVariant(value);
+        }
+            break;
+        }
+        offset += valueSize + defaultSize;
+
+        parameters.append(parameter);
+    }
+
+    qCDebug(PackedParameterFileLog) << "Decoded parameters count:total:fileSize" << parameters.count() << totalParameterCount << dataSize;
+
+    return true;
+}
+
+QByteArray PackedParameterFile::encode(const QList<Parameter>& parameters)
+{
+    QByteArray  fileContents(_headerSize, 0);
+
+    QByteArray  previousName;
+    int         encodedCount = 0;
+    for (const Parameter& parameter: parameters) {
+        int paramType = _mavTypeToParamType(parameter.mavType);
+        if (paramType == ParamTypeNone) {
+            qCWarning(PackedParameterFileLog) << "Skipping unsupported type" << parameter.name << parameter.mavType;
+            continue;
+        }
+
+        QByteArray name = parameter.name.toLatin1().left(_maxNameLength);
+        int commonLength = 0;
+        while (commonLength < name.length() - 1 && commonLength < previousName.length() && commonLength < 15 && name[commonLength] == previousName[commonLength]) {
+            commonLength++;
+        }
+        previousName = name;
+
+        fileContents.append(static_cast<char>(paramType));
+        fileContents.append(static_cast<char>(commonLength | ((name.length() - commonLength - 1) << 4)));
+        fileContents.append(name.mid(commonLength));
+
+        uchar value[4];
+        switch (paramType) {
+        case ParamTypeInt8:
+            value[0] = static_cast<uchar>(static_cast<qint8>(parameter.value.toInt()));
+            break;
+        case ParamTypeInt16:
+            qToLittleEndian<qint16>(static_cast<qint16>(parameter.value.toInt()), value);
+            break;
+        case ParamTypeInt32:
+            qToLittleEndian<qint32>(static_cast<qint32>(parameter.value.toLongLong()), value);
+            break;
+        case ParamTypeFloat:
+        {
+            float   floatValue = parameter.value.toFloat();
+            quint32 bits;
+            memcpy(&bits, &floatValue, sizeof(bits));
+            qToLittleEndian<quint32>(bits, value);
+        }
+            break;
+        }
+        fileContents.append(reinterpret_cast<const char*>(value), _typeSize(paramType));
+        encodedCount++;
+    }
+
+    uchar* header = reinterpret_cast<uchar*>(fileContents.data());
+    qToLittleEndian<quint16>(_magicNoDefaults, header);
+    qToLittleEndian<quint16>(static_cast<quint16>(encodedCount), header + 2);
+    qToLittleEndian<quint16>(static_cast<quint16>(encodedCount), header + 4);
+
+    return fileContents;
+}
@@ -0,0 +1,71 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QVariant>
+
+#include "QGCMAVLink.h"
+#include "QGCLoggingCategory.h"
+
+Q_DECLARE_LOGGING_CATEGORY(PackedParameterFileLog)
+
+/// Encodes/Decodes the packed parameter file format used by ArduPilot to provide the full parameter set over MAVLink FTP
+/// (@PARAM/param.pck). The file is:
+///     uint16_t magic (0x671B, or 0x671C if default values are included)
+///     uint16_t count of parameters in file
+///     uint16_t total count of parameters on the vehicle
+///     followed by a packed entry for each parameter:
+///         uint8_t type:4, flags:4
+///         uint8_t common_len:4, name_len:4    - bytes shared with the previous name, non-shared name length - 1
+///         char    name[name_len + 1]          - non-shared portion of name
+///         uint8_t value[]                     - little endian, size specified by type
+///         uint8_t default[]                   - only if magic is 0x671C and flags bit 0 is set
+///     Zero bytes may be inserted as padding ahead of any entry.
+class PackedParameterFile
+{
+public:
+    struct Parameter {
+        QString         name;
+        MAV_PARAM_TYPE  mavType;
+        QVariant        value;
+    };
+
+    /// Decodes the specified file contents
+    ///     @param fileContents Raw file contents
+    ///     @param[out] parameters Decoded parameters, in file order
+    ///     @param[out] totalParameterCount Total number of parameters on vehicle as reported by the file header
+    ///     @param[out] errorString Error if return is false
+    /// @return true: success, false: file is corrupt or unsupported
+    static bool decode(const QByteArray& fileContents, QList<Parameter>& parameters, int& totalParameterCount, QString& errorString);
+
+    /// Encodes the specified parameters into packed file format. Parameters must be sorted by name to get the benefit of
+    /// the common prefix compression. Used by MockLink to serve the file.
+    static QByteArray encode(const QList<Parameter>& parameters);
+
+private:
+    enum ParamType {
+        ParamTypeNone =     0,
+        ParamTypeInt8 =     1,
+        ParamTypeInt16 =    2,
+        ParamTypeInt32 =    3,
+        ParamTypeFloat =    4,
+    };
+
+    static int      _typeSize           (int paramType);
+    static int      _mavTypeToParamType (MAV_PARAM_TYPE mavType);
+
+    static const quint16    _magicNoDefaults =      0x671B;
+    static const quint16    _magicWithDefaults =    0x671C;
+    static const int        _headerSize =           6;
+    static const int        _maxNameLength =        16;
+};
@@ -15,6 +15,8 @@
 #include "FirmwarePlugin.h"
 #include "UAS.h"
 #include "JsonHelper.h"
+#include "FileManager.h"
+#include "PackedParameterFile.h"
 
 #include <QEasingCurve>
 #include <QFile>
@@ -63,6 +65,8 @@ const QHash<int, QString> _mavlinkCompIdHash {
     { MAV_COMP_ID_GPS2,     "GPS2" }
 };
 
+QHash<QString, QWeakPointer<QObject>> ParameterManager::_sharedParameterMetaData;
+
 const char* ParameterManager::_cachedMetaDataFilePrefix =   "ParameterFactMetaData";
 const char* ParameterManager::_jsonParametersKey =          "parameters";
 const char* ParameterManager::_jsonCompIdKey =              "compId";
@@ -82,7 +86,6 @@ ParameterManager::ParameterManager(Vehicle* vehicle)
     , _metaDataAddedToFacts             (false)
     , _logReplay                        (vehicle->priorityLink() && vehicle->priorityLink()->isLogReplay())
     , _parameterSetMajorVersion         (-1)
-    , _parameterMetaData                (nullptr)
     , _prevWaitingReadParamIndexCount   (0)
     , _prevWaitingReadParamNameCount    (0)
     , _prevWaitingWriteParamNameCount   (0)
@@ -122,13 +125,16 @@ ParameterManager::ParameterManager(Vehicle* vehicle)
         emit parametersReadyChanged(_parametersReady);
         emit missingParametersChanged(_missingParameters);
     } else if (!_logReplay){
-        refreshAllParameters();
+        if (!_startFtpParameterLoad()) {
+            refreshAllParameters();
+        }
     }
 }
 
 ParameterManager::~ParameterManager()
 {
-    delete _parameterMetaData;
+    _finishFtpParameterLoad();
+    _clearMetaData();
 }
 
 void ParameterManager::_updateProgressBar(void)
@@ -212,6 +218,16 @@ void ParameterManager::_parameterUpdate(int vehicleId, int componentId, QString
         return;
     }
 
+    if (_ftpLoadActive) {
+        if (componentId == _vehicle->defaultComponentId()) {
+            // Anything streamed prior to the FTP load completing is picked up by the full parameter set from the file
+            qCDebug(ParameterManagerVerbose1Log) << "Disregarding param update during FTP load" << parameterName;
+            return;
+        }
+        // The file only holds the default component parameters, other components are handled as usual
+        _ftpOtherComponentIds.insert(componentId);
+    }
+
     _initialRequestTimeoutTimer.stop();
 
 #if 0
@@ -951,7 +967,7 @@ void ParameterManager::_tryCacheHashLoad(int vehicleId, int componentId, QVarian
     for (const QString& name: cacheMap.keys()) {
         bool volatileValue = false;
 
-        FactMetaData* metaData = firmwarePlugin->getMetaDataForFact(_parameterMetaData, name, _vehicle->vehicleType());
+        FactMetaData* metaData = firmwarePlugin->getMetaDataForFact(_parameterMetaData.data(), name, _vehicle->vehicleType());
         if (metaData) {
             volatileValue = metaData->volatileValue();
         }
@@ -1201,9 +1217,15 @@ FactMetaData::ValueType_t ParameterManager::_mavTypeToFactType(MAV_PARAM_TYPE ma
 
 void ParameterManager::_clearMetaData(void)
 {
-    if (_parameterMetaData) {
-        _parameterMetaData->deleteLater();
-        _parameterMetaData = nullptr;
+    _parameterMetaData.reset();
+
+    // Drop the registry entries for meta data which has been released by the last vehicle using it
+    for (auto it = _sharedParameterMetaData.begin(); it != _sharedParameterMetaData.end(); ) {
+        if (it.value().isNull()) {
+            it = _sharedParameterMetaData.erase(it);
+        } else {
+            it++;
+        }
     }
 }
 
@@ -1218,8 +1240,21 @@ void ParameterManager::_loadMetaData(void)
 
     // Load best parameter meta data set
     metaDataFile = parameterMetaDataFile(_vehicle, _vehicle->firmwareType(), _parameterSetMajorVersion, majorVersion, minorVersion);
+    FirmwarePlugin* firmwarePlugin  = _vehicle->firmwarePlugin();
+    QString         sharedKey       = QStringLiteral("%1:%2").arg(firmwarePlugin->metaObject()->className()).arg(metaDataFile);
+
+    _parameterMetaData = _sharedParameterMetaData.value(sharedKey).toStrongRef();
+    if (_parameterMetaData) {
+        qCDebug(ParameterManagerLog) << "Using shared meta data file" << metaDataFile;
+        return;
+    }
+
     qCDebug(ParameterManagerLog) << "Loading meta data file:major:minor" << metaDataFile << majorVersion << minorVersion;
-    _parameterMetaData = _vehicle->firmwarePlugin()->loadParameterMetaData(metaDataFile);
+    QObject* metaData = firmwarePlugin->loadParameterMetaData(metaDataFile);
+    if (metaData) {
+        _parameterMetaData = QSharedPointer<QObject>(metaData, &QObject::deleteLater);
+        _sharedParameterMetaData[sharedKey] = _parameterMetaData;
+    }
 }
 
 void ParameterManager::_addMetaDataToDefaultComponent(void)
@@ -1234,7 +1269,7 @@ void ParameterManager::_addMetaDataToDefaultComponent(void)
     // Loop over all parameters in default component adding meta data
     QVariantMap& factMap = _mapParameterName2Variant[_vehicle->defaultComponentId()];
     for (const QString& key: factMap.keys()) {
-        _vehicle->firmwarePlugin()->addMetaDataToFact(_parameterMetaData, factMap[key].value<Fact*>(), _vehicle->vehicleType());
+        _vehicle->firmwarePlugin()->addMetaDataToFact(_parameterMetaData.data(), factMap[key].value<Fact*>(), _vehicle->vehicleType());
     }
 }
 
@@ -1751,3 +1786,133 @@ bool ParameterManager::pendingWrites(void)
 
     return false;
 }
+
+/// Starts loading the full set of parameters for the default component from the packed parameter file through MAVLink FTP.
+/// This is much faster than the PARAM_REQUEST_LIST protocol on slow links with large parameter sets. Parameters for other
+/// components are not part of the file, they are requested from each component heard from once the file is loaded.
+/// @return true: FTP load started, false: not supported, caller should use PARAM_REQUEST_LIST
+bool ParameterManager::_startFtpParameterLoad(void)
+{
+    QString ftpPath = _vehicle->firmwarePlugin()->packedParameterFilePath();
+    if (ftpPath.isEmpty() || !_vehicle->uas() || _vehicle->highLatencyLink()) {
+        return false;
+    }
+    if (_vehicle->capabilitiesKnown() && !(_vehicle->capabilityBits() & MAV_PROTOCOL_CAPABILITY_FTP)) {
+        return false;
+    }
+
+    _ftpDownloadDir = new QTemporaryDir();
+    if (!_ftpDownloadDir->isValid()) {
+        qCWarning(ParameterManagerLog) << _logVehiclePrefix(-1) << "Unable to create temp dir for FTP parameter load";
+        delete _ftpDownloadDir;
+        _ftpDownloadDir = nullptr;
+        return false;
+    }
+
+    FileManager* fileManager = _vehicle->uas()->getFileManager();
+
+    // Use a short timeout so that vehicles which do not respond to FTP fall back to the standard protocol quickly
+    _ftpSavedAckTimeoutMsecs =  fileManager->_ackTimerTimeoutMsecs;
+    _ftpSavedAckMaxRetries =    fileManager->_ackTimerMaxRetries;
+    fileManager->_ackTimerTimeoutMsecs =    _ftpAckTimeoutMsecs;
+    fileManager->_ackTimerMaxRetries =      _ftpAckMaxRetries;
+
+    _ftpConnections.append(connect(fileManager, &FileManager::commandComplete,    this, &ParameterManager::_ftpDownloadComplete));
+    _ftpConnections.append(connect(fileManager, &FileManager::commandError,       this, &ParameterManager::_ftpDownloadError));
+    _ftpConnections.append(connect(fileManager, &FileManager::commandProgress,    this, &ParameterManager::_ftpDownloadProgress));
+    _ftpConnections.append(connect(_vehicle,    &Vehicle::mavlinkMessageReceived,   this, &ParameterManager::_ftpMavlinkMessageReceived));
+
+    qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "Starting FTP parameter load" << ftpPath;
+
+    _ftpLoadActive = true;
+    fileManager->streamPath(ftpPath, QDir(_ftpDownloadDir->path()));
+
+    return true;
+}
+
+/// Restores FileManager state and cleans up after an FTP parameter load attempt
+void ParameterManager::_finishFtpParameterLoad(void)
+{
+    if (!_ftpDownloadDir) {
+        return;
+    }
+
+    for (const QMetaObject::Connection& connection: _ftpConnections) {
+        disconnect(connection);
+    }
+    _ftpConnections.clear();
+
+    FileManager* fileManager = _vehicle->uas() ? _vehicle->uas()->getFileManager() : nullptr;
+    if (fileManager) {
+        fileManager->_ackTimerTimeoutMsecs =    _ftpSavedAckTimeoutMsecs;
+        fileManager->_ackTimerMaxRetries =      _ftpSavedAckMaxRetries;
+    }
+
+    delete _ftpDownloadDir;
+    _ftpDownloadDir = nullptr;
+    _ftpLoadActive = false;
+    _ftpOtherComponentIds.clear();
+}
+
+/// Keeps track of the other components of the vehicle while the FTP load is active
+void ParameterManager::_ftpMavlinkMessageReceived(const mavlink_message_t& message)
+{
+    if (message.msgid == MAVLINK_MSG_ID_HEARTBEAT && message.sysid == _vehicle->id() && message.compid != _vehicle->defaultComponentId()) {
+        _ftpOtherComponentIds.insert(message.compid);
+    }
+}
+
+void ParameterManager::_ftpDownloadProgress(int value)
+{
+    _setLoadProgress(static_cast<double>(value) / 100.0);
+}
+
+void ParameterManager::_ftpDownloadError(const QString& errorMsg)
+{
+    qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "FTP parameter load failed, falling back to PARAM_REQUEST_LIST:" << errorMsg;
+
+    _finishFtpParameterLoad();
+    _setLoadProgress(0.0);
+    refreshAllParameters();
+}
+
+void ParameterManager::_ftpDownloadComplete(void)
+{
+    QFile                                   file(QDir(_ftpDownloadDir->path()).filePath(QFileInfo(_vehicle->firmwarePlugin()->packedParameterFilePath()).fileName()));
+    QList<PackedParameterFile::Parameter>   parameters;
+    int                                     totalParameterCount = 0;
+    QString                                 errorString;
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        _ftpDownloadError(file.errorString());
+        return;
+    }
+    QByteArray fileContents = file.readAll();
+    file.close();
+
+    if (!PackedParameterFile::decode(fileContents, parameters, totalParameterCount, errorString)) {
+        _ftpDownloadError(errorString);
+        return;
+    }
+    if (parameters.isEmpty() || parameters.count() != totalParameterCount) {
+        _ftpDownloadError(QStringLiteral("Incomplete parameter file count:total %1:%2").arg(parameters.count()).arg(totalParameterCount));
+        return;
+    }
+
+    qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "FTP parameter load complete count:bytes" << parameters.count() << fileContents.count();
+
+    QSet<int> otherComponentIds = _ftpOtherComponentIds;
+    _finishFtpParameterLoad();
+
+    // Feed the parameters through the same path as PARAM_VALUE so all waiting lists and the initial load complete logic work as usual
+    int componentId = _vehicle->defaultComponentId();
+    for (int index=0; index<parameters.count(); index++) {
+        const PackedParameterFile::Parameter& parameter = parameters[index];
+        _parameterUpdate(_vehicle->id(), componentId, parameter.name, parameters.count(), index, parameter.mavType, parameter.value);
+    }
+
+    // PARAM_REQUEST_LIST was never sent, so the remaining components have only streamed what they chose to
+    for (int otherComponentId: otherComponentIds) {
+        refreshAllParameters(static_cast<uint8_t>(otherComponentId));
+    }
+}
@@ -16,6 +16,10 @@
 #include <QMutex>
 #include <QDir>
 #include <QJsonObject>
+#include <QTemporaryDir>
+#include <QSharedPointer>
+#include <QHash>
+#include <QSet>
 
 #include "FactSystem.h"
 #include "MAVLinkProtocol.h"
@@ -135,6 +139,8 @@ protected:
     void _initialRequestTimeout(void);
 
 private:
+    friend class ParameterManagerTest;
+
     static QVariant         _stringToTypedVariant(const QString& string, FactMetaData::ValueType_t type, bool failOk = false);
     static FirmwarePlugin*  _anyVehicleTypeFirmwarePlugin(MAV_AUTOPILOT firmwareType);
 
@@ -154,6 +160,12 @@ private:
     void    _setLoadProgress(double loadProgress);
     bool    _fillIndexBatchQueue(bool waitingParamTimeout);
     void    _updateProgressBar(void);
+    bool    _startFtpParameterLoad(void);
+    void    _ftpDownloadComplete(void);
+    void    _ftpDownloadError(const QString& errorMsg);
+    void    _ftpDownloadProgress(int value);
+    void    _ftpMavlinkMessageReceived(const mavlink_message_t& message);
+    void    _finishFtpParameterLoad(void);
 
     MAV_PARAM_TYPE _factTypeToMavType(FactMetaData::ValueType_t factType);
     FactMetaData::ValueType_t _mavTypeToFactType(MAV_PARAM_TYPE mavType);
@@ -178,7 +190,12 @@ private:
     bool        _logReplay;                     ///< true: running with log replay link
     QString     _versionParam;                  ///< Parameter which contains parameter set version
     int         _parameterSetMajorVersion;      ///< Version for parameter set, -1 if not known
-    QObject*    _parameterMetaData;             ///< Opaque data from FirmwarePlugin::loadParameterMetaDataCall
+    QSharedPointer<QObject> _parameterMetaData; ///< Opaque data from FirmwarePlugin::loadParameterMetaDataCall, shared with other vehicles
+
+    /// Parameter meta data currently loaded by any vehicle, keyed by firmware plugin and meta data file. The meta data is
+    /// immutable once loaded so vehicles using the same firmware version share a single copy. It is released along with the
+    /// last vehicle which uses it.
+    static QHash<QString, QWeakPointer<QObject>> _sharedParameterMetaData;
 
     typedef QPair<int /* FactMetaData::ValueType_t */, QVariant /* Fact::rawValue */> ParamTypeVal;
     typedef QMap<QString /* parameter name */, ParamTypeVal> CacheMapName2ParamTypeVal;
@@ -218,6 +235,16 @@ private:
     QTimer _initialRequestTimeoutTimer;
     QTimer _waitingParamTimeoutTimer;
 
+    bool                            _ftpLoadActive =        false;  ///< true: Initial load is being done through MAVLink FTP
+    QTemporaryDir*                  _ftpDownloadDir =       nullptr;
+    QList<QMetaObject::Connection>  _ftpConnections;
+    int                             _ftpSavedAckTimeoutMsecs =  0;
+    int                             _ftpSavedAckMaxRetries =    0;
+    QSet<int>                       _ftpOtherComponentIds;          ///< Components other than the default component heard from during the FTP load
+
+    static const int _ftpAckTimeoutMsecs =  1000;   ///< FTP ack timeout used for parameter load, short so fallback to PARAM_REQUEST_LIST is fast
+    static const int _ftpAckMaxRetries =    2;
+
     QMutex _dataMutex;
 
     Fact _defaultFact;   ///< Used to return default fact, when parameter not found
@@ -12,6 +12,7 @@
 #include "MultiVehicleManager.h"
 #include "QGCApplication.h"
 #include "ParameterManager.h"
+#include "PackedParameterFile.h"
 
 /// Test failure modes which should still lead to param load success
 void ParameterManagerTest::_noFailureWorker(MockConfiguration::FailureMode_t failureMode)
@@ -138,3 +139,75 @@ void ParameterManagerTest::_requestListMissingParamFail(void)
     // User should have been notified
     checkExpectedMessageBox();
 }
+
+void ParameterManagerTest::_packedParameterFileRoundTrip(void)
+{
+    QList<PackedParameterFile::Parameter> parameters = {
+        { "ARMING_CHECK",   MAV_PARAM_TYPE_INT8,    QVariant(1) },
+        { "ARMING_RUDDER",  MAV_PARAM_TYPE_INT8,    QVariant(-2) },
+        { "BATT_CAPACITY",  MAV_PARAM_TYPE_INT32,   QVariant(3300) },
+        { "BATT_MONITOR",   MAV_PARAM_TYPE_INT8,    QVariant(4) },
+        { "SERIAL0_BAUD",   MAV_PARAM_TYPE_INT32,   QVariant(115) },
+        { "SYSID_SW_MREV",  MAV_PARAM_TYPE_INT16,   QVariant(-120) },
+        { "WPNAV_SPEED",    MAV_PARAM_TYPE_REAL32,  QVariant(500.5f) },
+    };
+
+    QByteArray fileContents = PackedParameterFile::encode(parameters);
+
+    QList<PackedParameterFile::Parameter>   decodedParameters;
+    int                                     totalCount;
+    QString                                 errorString;
+    QVERIFY(PackedParameterFile::decode(fileContents, decodedParameters, totalCount, errorString));
+    QCOMPARE(totalCount, parameters.count());
+    QCOMPARE(decodedParameters.count(), parameters.count());
+    for (int i=0; i<parameters.count(); i++) {
+        QCOMPARE(decodedParameters[i].name,     parameters[i].name);
+        QCOMPARE(decodedParameters[i].mavType,  parameters[i].mavType);
+        QCOMPARE(decodedParameters[i].value.toDouble(), parameters[i].value.toDouble());
+    }
+
+    // Padding between entries must be skipped
+    QByteArray paddedContents = fileContents;
+    paddedContents.insert(6, QByteArray(3, 0));
+    QVERIFY(PackedParameterFile::decode(paddedContents, decodedParameters, totalCount, errorString));
+    QCOMPARE(decodedParameters.count(), parameters.count());
+
+    // Truncated files must fail
+    QCOMPARE(PackedParameterFile::decode(fileContents.left(fileContents.count() - 1), decodedParameters, totalCount, errorString), false);
+    QCOMPARE(PackedParameterFile::decode(QByteArray(), decodedParameters, totalCount, errorString), false);
+}
+
+/// ArduPilot vehicles load the full parameter set through MAVLink FTP
+void ParameterManagerTest::_ftpParameterLoadAPM(void)
+{
+    Q_ASSERT(!_mockLink);
+    _mockLink = MockLink::startAPMArduCopterMockLink(false);
+
+    MultiVehicleManager* vehicleMgr = qgcApp()->toolbox()->multiVehicleManager();
+    QVERIFY(vehicleMgr);
+
+    QSignalSpy spyVehicle(vehicleMgr, SIGNAL(activeVehicleAvailableChanged(bool)));
+    QCOMPARE(spyVehicle.wait(5000), true);
+
+    Vehicle* vehicle = vehicleMgr->activeVehicle();
+    QVERIFY(vehicle);
+
+    // The burst transfer is fast enough that parameters should be ready well before a PARAM_REQUEST_LIST based load could finish
+    QSignalSpy spyParamsReady(vehicleMgr, SIGNAL(parameterReadyVehicleAvailableChanged(bool)));
+    QCOMPARE(spyParamsReady.wait(10000), true);
+    QCOMPARE(vehicle->parameterManager()->missingParameters(), false);
+    QVERIFY(vehicle->parameterManager()->parameterExists(FactSystem::defaultComponentId, QStringLiteral("SYSID_SW_MREV")));
+}
+
+/// Parameter meta data is shared through a registry, its entry must go away along with the last vehicle using it
+void ParameterManagerTest::_sharedMetaDataReleased(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    ParameterManager* parameterManager = _vehicle->parameterManager();
+    QVERIFY(parameterManager->_parameterMetaData);
+    QVERIFY(ParameterManager::_sharedParameterMetaData.values().contains(parameterManager->_parameterMetaData.toWeakRef()));
+
+    _disconnectMockLink();
+    QTRY_VERIFY_WITH_TIMEOUT(ParameterManager::_sharedParameterMetaData.isEmpty(), 5000);
+}
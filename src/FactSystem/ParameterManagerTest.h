@@ -25,6 +25,9 @@ private slots:
     void _requestListNoResponse(void);
     void _requestListMissingParamSuccess(void);
     void _requestListMissingParamFail(void);
+    void _packedParameterFileRoundTrip(void);
+    void _ftpParameterLoadAPM(void);
+    void _sharedMetaDataReleased(void);
 
 private:
     void _noFailureWorker(MockConfiguration::FailureMode_t failureMode);
@@ -41,11 +41,11 @@ SettingsFact::SettingsFact(QString settingsGroup, FactMetaData* metaData, QObjec
             QVariant typedValue;
             QString errorString;
             metaData->convertAndValidateRaw(settings.value(_name, rawDefaultValue), true /* conertOnly */, typedValue, errorString);
-            _rawValue = typedValue;
+            _rawValue.setFromVariant(_type, typedValue);
         } else {
             // Setting is not visible, force to default value always
             settings.setValue(_name, rawDefaultValue);
-            _rawValue = rawDefaultValue;
+            _rawValue.setFromVariant(_type, rawDefaultValue);
         }
     }
 
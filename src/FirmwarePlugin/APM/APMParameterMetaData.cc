@@ -143,9 +143,6 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
     }
     _parameterMetaDataLoaded = true;
 
-    QRegExp parameterCategories = QRegExp("ArduCopter|ArduPlane|APMrover2|ArduSub|AntennaTracker");
-    QString currentCategory;
-
     qCDebug(APMParameterMetaDataLog) << "Loading parameter meta data:" << metaDataFile;
 
     QFile xmlFile(metaDataFile);
@@ -155,11 +152,57 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
     Q_UNUSED(success);
     Q_ASSERT(success);
 
-    QXmlStreamReader xml(xmlFile.readAll());
+    QByteArray xmlData = xmlFile.readAll();
     xmlFile.close();
+
+    // Only parse the xml if there isn't already a compiled index for this exact file
+    QByteArray sourceHash = ParameterMetaDataIndex::sourceHash(xmlData);
+    QString indexFile = ParameterMetaDataIndex::indexFileName(metaDataFile, sourceHash);
+    if (_index.load(indexFile, sourceHash)) {
+        return;
+    }
+
+    QMap<QString, ParameterNametoFactMetaDataMap> vehicleTypeToParametersMap;
+    if (!_parseParameterMetaDataXml(xmlData, vehicleTypeToParametersMap)) {
+        // Don't cache the results of a bad file, just use what we were able to read
+        indexFile.clear();
+    }
+
+    ParameterMetaDataIndex::SectionMap sections;
+    for (auto vehicleIter = vehicleTypeToParametersMap.constBegin(); vehicleIter != vehicleTypeToParametersMap.constEnd(); vehicleIter++) {
+        QMap<QString, ParameterMetaDataIndex::Entry>& entries = sections[vehicleIter.key()];
+        for (const APMFactMetaDataRaw* rawMetaData: vehicleIter.value()) {
+            ParameterMetaDataIndex::Entry entry;
+            entry.name              = rawMetaData->name;
+            entry.category          = rawMetaData->category;
+            entry.group             = rawMetaData->group;
+            entry.shortDescription  = rawMetaData->shortDescription;
+            entry.longDescription   = rawMetaData->longDescription;
+            entry.min               = rawMetaData->min;
+            entry.max               = rawMetaData->max;
+            entry.increment         = rawMetaData->incrementSize;
+            entry.units             = rawMetaData->units;
+            entry.values            = rawMetaData->values;
+            entry.bitmask           = rawMetaData->bitmask;
+            if (rawMetaData->rebootRequired) {
+                entry.flags |= ParameterMetaDataIndex::FlagRebootRequired;
+            }
+            entries[entry.name] = entry;
+        }
+        qDeleteAll(vehicleIter.value());
+    }
+    _index.compile(sections, indexFile, sourceHash);
+}
+
+bool APMParameterMetaData::_parseParameterMetaDataXml(const QByteArray& xmlData, QMap<QString, ParameterNametoFactMetaDataMap>& vehicleTypeToParametersMap)
+{
+    QRegExp parameterCategories = QRegExp("ArduCopter|ArduPlane|APMrover2|ArduSub|AntennaTracker");
+    QString currentCategory;
+
+    QXmlStreamReader xml(xmlData);
     if (xml.hasError()) {
         qCWarning(APMParameterMetaDataLog) << "Badly formed XML, reading failed: " << xml.errorString();
-        return;
+        return false;
     }
 
     bool                badMetaData = true;
@@ -185,13 +228,13 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             } else if (elementName == "vehicles") {
                 if (xmlState.top() != XmlstateParamFileFound) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, vehicles matched";
-                    return;
+                    return false;
                 }
                 xmlState.push(XmlStateFoundVehicles);
             } else if (elementName == "libraries") {
                 if (xmlState.top() != XmlstateParamFileFound) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, libraries matched";
-                    return;
+                    return false;
                 }
                 currentCategory = "libraries";
                 xmlState.push(XmlStateFoundLibraries);
@@ -199,7 +242,7 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 if (xmlState.top() != XmlStateFoundVehicles && xmlState.top() != XmlStateFoundLibraries) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, parameters matched"
                                                        << "but we don't have proper vehicle or libraries yet";
-                    return;
+                    return false;
                 }
 
                 if (xml.attributes().hasAttribute("name")) {
@@ -216,7 +259,7 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                         qCDebug(APMParameterMetaDataVerboseLog) << "not interested in this block of parameters, skipping:" << nameValue;
                         if (skipXMLBlock(xml, "parameters")) {
                             qCWarning(APMParameterMetaDataLog) << "something wrong with the xml, skip of the xml failed";
-                            return;
+                            return false;
                         }
                         xml.readNext();
                         continue;
@@ -226,13 +269,13 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 if (xmlState.top() != XmlStateFoundParameters) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, element param matched"
                                                        << "while we are not yet in parameters";
-                    return;
+                    return false;
                 }
                 xmlState.push(XmlStateFoundParameter);
 
                 if (!xml.attributes().hasAttribute("name")) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, parameter attribute name missing";
-                    return;
+                    return false;
                 }
 
                 QString name = xml.attributes().value("name").toString();
@@ -256,12 +299,12 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                           << "group: " << group;
 
                 Q_ASSERT(!rawMetaData);
-                if (_vehicleTypeToParametersMap[currentCategory].contains(name)) {
+                if (vehicleTypeToParametersMap[currentCategory].contains(name)) {
                     qCDebug(APMParameterMetaDataLog) << "Duplicate parameter found:" << name;
-                    rawMetaData = _vehicleTypeToParametersMap[currentCategory][name];
+                    rawMetaData = vehicleTypeToParametersMap[currentCategory][name];
                 } else {
                     rawMetaData = new APMFactMetaDataRaw();
-                    _vehicleTypeToParametersMap[currentCategory][name] = rawMetaData;
+                    vehicleTypeToParametersMap[currentCategory][name] = rawMetaData;
                     groupMembers[group] << name;
                 }
                 qCDebug(APMParameterMetaDataVerboseLog) << "inserting metadata for field" << name;
@@ -274,12 +317,12 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 // We should be getting meta data now
                 if (xmlState.top() != XmlStateFoundParameter) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, while reading parameter fields wrong state";
-                    return;
+                    return false;
                 }
                 if (!badMetaData) {
                     if (!parseParameterAttributes(xml, rawMetaData)) {
                         qCDebug(APMParameterMetaDataLog) << "Badly formed XML, failed to read parameter attributes";
-                        return;
+                        return false;
                     }
                     continue;
                 }
@@ -296,7 +339,7 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 xmlState.pop();
             } else if (elementName == "parameters") {
                 qCDebug(APMParameterMetaDataVerboseLog) << "end of parameters for category: " << currentCategory;
-                correctGroupMemberships(_vehicleTypeToParametersMap[currentCategory], groupMembers);
+                correctGroupMemberships(vehicleTypeToParametersMap[currentCategory], groupMembers);
                 groupMembers.clear();
                 xmlState.pop();
             } else if (elementName == "vehicles") {
@@ -306,6 +349,8 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
         }
         xml.readNext();
     }
+
+    return true;
 }
 
 void APMParameterMetaData::correctGroupMemberships(ParameterNametoFactMetaDataMap& parameterToFactMetaDataMap,
@@ -429,15 +474,36 @@ void APMParameterMetaData::addMetaDataToFact(Fact* fact, MAV_TYPE vehicleType)
 {
     const QString mavTypeString = mavTypeToString(vehicleType);
     APMFactMetaDataRaw* rawMetaData = nullptr;
+    APMFactMetaDataRaw  indexMetaData;
+
+    // This object is shared by all vehicles using the same meta data file, so each distinct meta data is only built once
+    const QString cacheKey = QStringLiteral("%1/%2/%3").arg(mavTypeString).arg(fact->name()).arg(fact->type());
+    FactMetaData* cachedMetaData = _factMetaDataCache.value(cacheKey, nullptr);
+    if (cachedMetaData) {
+        fact->setMetaData(cachedMetaData);
+        return;
+    }
 
     // check if we have metadata for fact, use generic otherwise
-    if (_vehicleTypeToParametersMap[mavTypeString].contains(fact->name())) {
-        rawMetaData = _vehicleTypeToParametersMap[mavTypeString][fact->name()];
-    } else if (_vehicleTypeToParametersMap["libraries"].contains(fact->name())) {
-        rawMetaData = _vehicleTypeToParametersMap["libraries"][fact->name()];
+    ParameterMetaDataIndex::Entry entry;
+    if (_index.find(mavTypeString, fact->name(), entry) || _index.find(QStringLiteral("libraries"), fact->name(), entry)) {
+        indexMetaData.name              = entry.name;
+        indexMetaData.category          = entry.category;
+        indexMetaData.group             = entry.group;
+        indexMetaData.shortDescription  = entry.shortDescription;
+        indexMetaData.longDescription   = entry.longDescription;
+        indexMetaData.min               = entry.min;
+        indexMetaData.max               = entry.max;
+        indexMetaData.incrementSize     = entry.increment;
+        indexMetaData.units             = entry.units;
+        indexMetaData.rebootRequired    = entry.flags & ParameterMetaDataIndex::FlagRebootRequired;
+        indexMetaData.values            = entry.values;
+        indexMetaData.bitmask           = entry.bitmask;
+        rawMetaData = &indexMetaData;
     }
 
-    FactMetaData *metaData = new FactMetaData(fact->type(), fact);
+    FactMetaData *metaData = new FactMetaData(fact->type(), this);
+    _factMetaDataCache[cacheKey] = metaData;
 
     // we don't have data for this fact
     if (!rawMetaData) {
@@ -13,6 +13,7 @@
 
 #include <QObject>
 #include <QMap>
+#include <QHash>
 #include <QPointer>
 #include <QXmlStreamReader>
 #include <QLoggingCategory>
@@ -20,6 +21,7 @@
 #include "FactSystem.h"
 #include "AutoPilotPlugin.h"
 #include "Vehicle.h"
+#include "ParameterMetaDataIndex.h"
 
 Q_DECLARE_LOGGING_CATEGORY(APMParameterMetaDataLog)
 Q_DECLARE_LOGGING_CATEGORY(APMParameterMetaDataVerboseLog)
@@ -75,6 +77,7 @@ private:
         XmlStateDone
     };    
 
+    bool _parseParameterMetaDataXml(const QByteArray& xmlData, QMap<QString, ParameterNametoFactMetaDataMap>& vehicleTypeToParametersMap);
     QVariant _stringToTypedVariant(const QString& string, FactMetaData::ValueType_t type, bool* convertOk);
     bool skipXMLBlock(QXmlStreamReader& xml, const QString& blockName);
     bool parseParameterAttributes(QXmlStreamReader& xml, APMFactMetaDataRaw *rawMetaData);
@@ -83,7 +86,8 @@ private:
     QString _groupFromParameterName(const QString& name);
 
     bool _parameterMetaDataLoaded;   ///< true: parameter meta data already loaded
-    QMap<QString, ParameterNametoFactMetaDataMap> _vehicleTypeToParametersMap; ///< Maps from a vehicle type to paramametertoFactMeta map>
+    ParameterMetaDataIndex _index;  ///< Compiled meta data, sections are vehicle types plus "libraries"
+    QHash<QString, FactMetaData*> _factMetaDataCache;   ///< Meta data shared by all facts with the same vehicle type, name and value type
 };
 
 #endif
@@ -212,6 +212,10 @@ public:
     /// Returns the parameter which is used to identify the version number of parameter set
     virtual QString getVersionParam(void) { return QString(); }
 
+    /// Returns the MAVLink FTP path of the packed parameter file (see PackedParameterFile) which is used to load all
+    /// parameters in a single transfer. Empty string if firmware does not support it.
+    virtual QString packedParameterFilePath(void) const { return QString(); }
+
     /// Returns the parameter set version info pulled from inside the meta data file. -1 if not found.
     /// Note: The implementation for this must not vary by vehicle type.
     virtual void getParameterMetaDataVersionInfo(const QString& metaDataFile, int& majorVersion, int& minorVersion);
@@ -21,6 +21,7 @@
 #include <QDebug>
 
 static const char* kInvalidConverstion = "Internal Error: No support for string parameters";
+static const char* kIndexSection =       "PX4";
 
 QGC_LOGGING_CATEGORY(PX4ParameterMetaDataLog, "PX4ParameterMetaDataLog")
 
@@ -102,19 +103,37 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
         qWarning() << "Internal error: Unable to open parameter file:" << metaDataFile << xmlFile.errorString();
         return;
     }
-    
-    QXmlStreamReader xml(xmlFile.readAll());
+
+    QByteArray xmlData = xmlFile.readAll();
     xmlFile.close();
+
+    // Only parse the xml if there isn't already a compiled index for this exact file
+    QByteArray sourceHash = ParameterMetaDataIndex::sourceHash(xmlData);
+    QString indexFile = ParameterMetaDataIndex::indexFileName(metaDataFile, sourceHash);
+    if (_index.load(indexFile, sourceHash)) {
+        return;
+    }
+
+    ParameterMetaDataIndex::SectionMap sections;
+    if (!_parseParameterMetaDataXml(xmlData, metaDataFile, sections[kIndexSection])) {
+        // Don't cache the results of a bad file, just use what we were able to read
+        indexFile.clear();
+    }
+    _index.compile(sections, indexFile, sourceHash);
+}
+
+bool PX4ParameterMetaData::_parseParameterMetaDataXml(const QByteArray& xmlData, const QString& metaDataFile, QMap<QString, ParameterMetaDataIndex::Entry>& entries)
+{
+    QXmlStreamReader xml(xmlData);
     if (xml.hasError()) {
         qWarning() << "Badly formed XML" << xml.errorString();
-        return;
+        return false;
     }
     
-    QString         factGroup;
-    QString         errorString;
-    FactMetaData*   metaData = nullptr;
-    int             xmlState = XmlStateNone;
-    bool            badMetaData = true;
+    QString                         factGroup;
+    ParameterMetaDataIndex::Entry   entry;
+    int                             xmlState = XmlStateNone;
+    bool                            badMetaData = true;
     
     while (!xml.atEnd()) {
         if (xml.isStartElement()) {
@@ -123,14 +142,14 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             if (elementName == "parameters") {
                 if (xmlState != XmlStateNone) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 xmlState = XmlStateFoundParameters;
                 
             } else if (elementName == "version") {
                 if (xmlState != XmlStateFoundParameters) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 xmlState = XmlStateFoundVersion;
                 
@@ -139,12 +158,12 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 int intVersion = strVersion.toInt(&convertOk);
                 if (!convertOk) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 if (intVersion <= 2) {
                     // We can't read these old files
                     qDebug() << "Parameter version stamp too old, skipping load. Found:" << intVersion << "Want: 3 File:" << metaDataFile;
-                    return;
+                    return true;
                 }
                 
             } else if (elementName == "parameter_version_major") {
@@ -156,13 +175,13 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 if (xmlState != XmlStateFoundVersion) {
                     // We didn't get a version stamp, assume older version we can't read
                     qDebug() << "Parameter version stamp not found, skipping load" << metaDataFile;
-                    return;
+                    return true;
                 }
                 xmlState = XmlStateFoundGroup;
                 
                 if (!xml.attributes().hasAttribute("name")) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 factGroup = xml.attributes().value("name").toString();
                 qCDebug(PX4ParameterMetaDataLog) << "Found group: " << factGroup;
@@ -170,13 +189,13 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             } else if (elementName == "parameter") {
                 if (xmlState != XmlStateFoundGroup) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 xmlState = XmlStateFoundParameter;
                 
                 if (!xml.attributes().hasAttribute("name") || !xml.attributes().hasAttribute("type")) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 
                 QString name = xml.attributes().value("name").toString();
@@ -209,35 +228,30 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 FactMetaData::ValueType_t foundType = FactMetaData::stringToType(type, unknownType);
                 if (unknownType) {
                     qWarning() << "Parameter meta data with bad type:" << type << " name:" << name;
-                    return;
+                    return false;
                 }
-                
-                // Now that we know type we can create meta data object and add it to the system
-                
-                metaData = new FactMetaData(foundType);
-                Q_CHECK_PTR(metaData);
-                if (_mapParameterName2FactMetaData.contains(name)) {
+
+                entry = ParameterMetaDataIndex::Entry();
+                entry.name = name;
+                entry.type = foundType;
+                if (entries.contains(name)) {
                     // We can't trust the meta data since we have dups
                     qCWarning(PX4ParameterMetaDataLog) << "Duplicate parameter found:" << name;
                     badMetaData = true;
                     // Reset to default meta data
-                    _mapParameterName2FactMetaData[name] = metaData;
+                    entry.flags = ParameterMetaDataIndex::FlagInvalid;
                 } else {
-                    _mapParameterName2FactMetaData[name] = metaData;
-                    metaData->setName(name);
-                    metaData->setCategory(category);
-                    metaData->setGroup(factGroup);
-                    metaData->setReadOnly(readOnly);
-                    metaData->setVolatileValue(volatileValue);
-                    
+                    entry.category = category;
+                    entry.group = factGroup;
+                    if (readOnly) {
+                        entry.flags |= ParameterMetaDataIndex::FlagReadOnly;
+                    }
+                    if (volatileValue) {
+                        entry.flags |= ParameterMetaDataIndex::FlagVolatile;
+                    }
                     if (xml.attributes().hasAttribute("default") && !strDefault.isEmpty()) {
-                        QVariant varDefault;
-                        
-                        if (metaData->convertAndValidateRaw(strDefault, false, varDefault, errorString)) {
-                            metaData->setRawDefaultValue(varDefault);
-                        } else {
-                            qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << name << " type:" << type << " default:" << strDefault << " error:" << errorString;
-                        }
+                        entry.defaultValue = strDefault;
+                        entry.flags |= ParameterMetaDataIndex::FlagHasDefault;
                     }
                 }
                 
@@ -245,136 +259,81 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 // We should be getting meta data now
                 if (xmlState != XmlStateFoundParameter) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
 
                 if (!badMetaData) {
-                    if (metaData) {
-                        if (elementName == "short_desc") {
-                            QString text = xml.readElementText();
-                            text = text.replace("\n", " ");
-                            qCDebug(PX4ParameterMetaDataLog) << "Short description:" << text;
-                            metaData->setShortDescription(text);
-
-                        } else if (elementName == "long_desc") {
-                            QString text = xml.readElementText();
-                            text = text.replace("\n", " ");
-                            qCDebug(PX4ParameterMetaDataLog) << "Long description:" << text;
-                            metaData->setLongDescription(text);
-
-                        } else if (elementName == "min") {
-                            QString text = xml.readElementText();
-                            qCDebug(PX4ParameterMetaDataLog) << "Min:" << text;
-
-                            QVariant varMin;
-                            if (metaData->convertAndValidateRaw(text, false /* convertOnly */, varMin, errorString)) {
-                                metaData->setRawMin(varMin);
-                            } else {
-                                qCWarning(PX4ParameterMetaDataLog) << "Invalid min value, name:" << metaData->name() << " type:" << metaData->type() << " min:" << text << " error:" << errorString;
-                            }
-
-                        } else if (elementName == "max") {
-                            QString text = xml.readElementText();
-                            qCDebug(PX4ParameterMetaDataLog) << "Max:" << text;
-
-                            QVariant varMax;
-                            if (metaData->convertAndValidateRaw(text, false /* convertOnly */, varMax, errorString)) {
-                                metaData->setRawMax(varMax);
-                            } else {
-                                qCWarning(PX4ParameterMetaDataLog) << "Invalid max value, name:" << metaData->name() << " type:" << metaData->type() << " max:" << text << " error:" << errorString;
-                            }
-
-                        } else if (elementName == "unit") {
-                            QString text = xml.readElementText();
-                            qCDebug(PX4ParameterMetaDataLog) << "Unit:" << text;
-                            metaData->setRawUnits(text);
-
-                        } else if (elementName == "decimal") {
-                            QString text = xml.readElementText();
-                            qCDebug(PX4ParameterMetaDataLog) << "Decimal:" << text;
-
-                            bool convertOk;
-                            QVariant varDecimals = QVariant(text).toUInt(&convertOk);
-                            if (convertOk) {
-                                metaData->setDecimalPlaces(varDecimals.toInt());
-                            } else {
-                                qCWarning(PX4ParameterMetaDataLog) << "Invalid decimals value, name:" << metaData->name() << " type:" << metaData->type() << " decimals:" << text << " error: invalid number";
-                            }
-
-                        } else if (elementName == "reboot_required") {
-                            QString text = xml.readElementText();
-                            qCDebug(PX4ParameterMetaDataLog) << "RebootRequired:" << text;
-                            if (text.compare("true", Qt::CaseInsensitive) == 0) {
-                                metaData->setVehicleRebootRequired(true);
-                            }
-
-                        } else if (elementName == "values") {
-                            // doing nothing individual value will follow anyway. May be used for sanity checking.
-
-                        } else if (elementName == "value") {
-                            QString enumValueStr = xml.attributes().value("code").toString();
-                            QString enumString = xml.readElementText();
-                            qCDebug(PX4ParameterMetaDataLog) << "parameter value:"
-                                                             << "value desc:" << enumString << "code:" << enumValueStr;
-
-                            QVariant    enumValue;
-                            QString     errorString;
-                            if (metaData->convertAndValidateRaw(enumValueStr, false /* validate */, enumValue, errorString)) {
-                                metaData->addEnumInfo(enumString, enumValue);
-                            } else {
-                                qCDebug(PX4ParameterMetaDataLog) << "Invalid enum value, name:" << metaData->name()
-                                                                 << " type:" << metaData->type() << " value:" << enumValueStr
-                                                                 << " error:" << errorString;
-                            }
-                        } else if (elementName == "increment") {
-                            double  increment;
-                            bool    ok;
-                            QString text = xml.readElementText();
-                            increment = text.toDouble(&ok);
-                            if (ok) {
-                                metaData->setRawIncrement(increment);
-                            } else {
-                                qCWarning(PX4ParameterMetaDataLog) << "Invalid value for increment, name:" << metaData->name() << " increment:" << text;
-                            }
-
-                        } else if (elementName == "boolean") {
-                            QVariant    enumValue;
-                            metaData->convertAndValidateRaw(1, false /* validate */, enumValue, errorString);
-                            metaData->addEnumInfo(tr("Enabled"), enumValue);
-                            metaData->convertAndValidateRaw(0, false /* validate */, enumValue, errorString);
-                            metaData->addEnumInfo(tr("Disabled"), enumValue);
-
-                        } else if (elementName == "bitmask") {
-                            // doing nothing individual bits will follow anyway. May be used for sanity checking.
-
-                        } else if (elementName == "bit") {
-                            bool ok = false;
-                            unsigned char bit = xml.attributes().value("index").toString().toUInt(&ok);
-                            if (ok) {
-                                QString bitDescription = xml.readElementText();
-                                qCDebug(PX4ParameterMetaDataLog) << "parameter value:"
-                                                                 << "index:" << bit << "description:" << bitDescription;
-
-                                if (bit < 31) {
-                                    QVariant bitmaskRawValue = 1 << bit;
-                                    QVariant bitmaskValue;
-                                    QString errorString;
-                                    if (metaData->convertAndValidateRaw(bitmaskRawValue, true, bitmaskValue, errorString)) {
-                                        metaData->addBitmaskInfo(bitDescription, bitmaskValue);
-                                    } else {
-                                        qCDebug(PX4ParameterMetaDataLog) << "Invalid bitmask value, name:" << metaData->name()
-                                                                         << " type:" << metaData->type() << " value:" << bitmaskValue
-                                                                         << " error:" << errorString;
-                                    }
-                                } else {
-                                    qCWarning(PX4ParameterMetaDataLog) << "Invalid value for bitmask, bit:" << bit;
-                                }
-                            }
+                    if (elementName == "short_desc") {
+                        QString text = xml.readElementText();
+                        text = text.replace("\n", " ");
+                        qCDebug(PX4ParameterMetaDataLog) << "Short description:" << text;
+                        entry.shortDescription = text;
+
+                    } else if (elementName == "long_desc") {
+                        QString text = xml.readElementText();
+                        text = text.replace("\n", " ");
+                        qCDebug(PX4ParameterMetaDataLog) << "Long description:" << text;
+                        entry.longDescription = text;
+
+                    } else if (elementName == "min") {
+                        entry.min = xml.readElementText();
+                        qCDebug(PX4ParameterMetaDataLog) << "Min:" << entry.min;
+
+                    } else if (elementName == "max") {
+                        entry.max = xml.readElementText();
+                        qCDebug(PX4ParameterMetaDataLog) << "Max:" << entry.max;
+
+                    } else if (elementName == "unit") {
+                        entry.units = xml.readElementText();
+                        qCDebug(PX4ParameterMetaDataLog) << "Unit:" << entry.units;
+
+                    } else if (elementName == "decimal") {
+                        QString text = xml.readElementText();
+                        qCDebug(PX4ParameterMetaDataLog) << "Decimal:" << text;
+
+                        bool convertOk;
+                        uint decimals = text.toUInt(&convertOk);
+                        if (convertOk) {
+                            entry.decimalPlaces = static_cast<int>(decimals);
                         } else {
-                            qCDebug(PX4ParameterMetaDataLog) << "Unknown element in XML: " << elementName;
+                            qCWarning(PX4ParameterMetaDataLog) << "Invalid decimals value, name:" << entry.name << " type:" << entry.type << " decimals:" << text << " error: invalid number";
                         }
+
+                    } else if (elementName == "reboot_required") {
+                        QString text = xml.readElementText();
+                        qCDebug(PX4ParameterMetaDataLog) << "RebootRequired:" << text;
+                        if (text.compare("true", Qt::CaseInsensitive) == 0) {
+                            entry.flags |= ParameterMetaDataIndex::FlagRebootRequired;
+                        }
+
+                    } else if (elementName == "values") {
+                        // doing nothing individual value will follow anyway. May be used for sanity checking.
+
+                    } else if (elementName == "value") {
+                        QString enumValueStr = xml.attributes().value("code").toString();
+                        QString enumString = xml.readElementText();
+                        qCDebug(PX4ParameterMetaDataLog) << "parameter value:"
+                                                         << "value desc:" << enumString << "code:" << enumValueStr;
+                        entry.values.append(qMakePair(enumValueStr, enumString));
+
+                    } else if (elementName == "increment") {
+                        entry.increment = xml.readElementText();
+
+                    } else if (elementName == "boolean") {
+                        entry.flags |= ParameterMetaDataIndex::FlagBoolean;
+
+                    } else if (elementName == "bitmask") {
+                        // doing nothing individual bits will follow anyway. May be used for sanity checking.
+
+                    } else if (elementName == "bit") {
+                        QString bitIndex = xml.attributes().value("index").toString();
+                        QString bitDescription = xml.readElementText();
+                        qCDebug(PX4ParameterMetaDataLog) << "parameter value:"
+                                                         << "index:" << bitIndex << "description:" << bitDescription;
+                        entry.bitmask.append(qMakePair(bitIndex, bitDescription));
+
                     } else {
-                        qWarning() << "Internal error";
+                        qCDebug(PX4ParameterMetaDataLog) << "Unknown element in XML: " << elementName;
                     }
                 }
             }
@@ -382,17 +341,9 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             QString elementName = xml.name().toString();
 
             if (elementName == "parameter") {
-                // Done loading this parameter, validate default value
-                if (metaData->defaultValueAvailable()) {
-                    QVariant var;
-
-                    if (!metaData->convertAndValidateRaw(metaData->rawDefaultValue(), false /* convertOnly */, var, errorString)) {
-                        qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << metaData->name() << " type:" << metaData->type() << " default:" << metaData->rawDefaultValue() << " error:" << errorString;
-                    }
-                }
+                entries[entry.name] = entry;
 
                 // Reset for next parameter
-                metaData = nullptr;
                 badMetaData = false;
                 xmlState = XmlStateFoundGroup;
             } else if (elementName == "group") {
@@ -403,6 +354,125 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
         }
         xml.readNext();
     }
+
+    return true;
+}
+
+/// Creates the FactMetaData for a parameter from its index entry. Values are converted and validated here rather than at load
+/// time so that only the parameters the vehicle actually has pay that cost.
+FactMetaData* PX4ParameterMetaData::_createMetaData(const ParameterMetaDataIndex::Entry& entry)
+{
+    QString         errorString;
+    FactMetaData*   metaData = new FactMetaData(static_cast<FactMetaData::ValueType_t>(entry.type), this);
+
+    if (entry.flags & ParameterMetaDataIndex::FlagInvalid) {
+        return metaData;
+    }
+
+    metaData->setName(entry.name);
+    metaData->setCategory(entry.category);
+    metaData->setGroup(entry.group);
+    metaData->setReadOnly(entry.flags & ParameterMetaDataIndex::FlagReadOnly);
+    metaData->setVolatileValue(entry.flags & ParameterMetaDataIndex::FlagVolatile);
+
+    if (entry.flags & ParameterMetaDataIndex::FlagHasDefault) {
+        QVariant varDefault;
+        if (metaData->convertAndValidateRaw(entry.defaultValue, false, varDefault, errorString)) {
+            metaData->setRawDefaultValue(varDefault);
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << entry.name << " type:" << entry.type << " default:" << entry.defaultValue << " error:" << errorString;
+        }
+    }
+
+    metaData->setShortDescription(entry.shortDescription);
+    metaData->setLongDescription(entry.longDescription);
+
+    if (!entry.min.isEmpty()) {
+        QVariant varMin;
+        if (metaData->convertAndValidateRaw(entry.min, false /* convertOnly */, varMin, errorString)) {
+            metaData->setRawMin(varMin);
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid min value, name:" << entry.name << " type:" << entry.type << " min:" << entry.min << " error:" << errorString;
+        }
+    }
+
+    if (!entry.max.isEmpty()) {
+        QVariant varMax;
+        if (metaData->convertAndValidateRaw(entry.max, false /* convertOnly */, varMax, errorString)) {
+            metaData->setRawMax(varMax);
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid max value, name:" << entry.name << " type:" << entry.type << " max:" << entry.max << " error:" << errorString;
+        }
+    }
+
+    if (!entry.units.isEmpty()) {
+        metaData->setRawUnits(entry.units);
+    }
+    if (entry.decimalPlaces >= 0) {
+        metaData->setDecimalPlaces(entry.decimalPlaces);
+    }
+    if (entry.flags & ParameterMetaDataIndex::FlagRebootRequired) {
+        metaData->setVehicleRebootRequired(true);
+    }
+
+    for (const auto& value: entry.values) {
+        QVariant enumValue;
+        if (metaData->convertAndValidateRaw(value.first, false /* validate */, enumValue, errorString)) {
+            metaData->addEnumInfo(value.second, enumValue);
+        } else {
+            qCDebug(PX4ParameterMetaDataLog) << "Invalid enum value, name:" << entry.name
+                                             << " type:" << entry.type << " value:" << value.first
+                                             << " error:" << errorString;
+        }
+    }
+
+    if (!entry.increment.isEmpty()) {
+        bool    ok;
+        double  increment = entry.increment.toDouble(&ok);
+        if (ok) {
+            metaData->setRawIncrement(increment);
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid value for increment, name:" << entry.name << " increment:" << entry.increment;
+        }
+    }
+
+    if (entry.flags & ParameterMetaDataIndex::FlagBoolean) {
+        QVariant enumValue;
+        metaData->convertAndValidateRaw(1, false /* validate */, enumValue, errorString);
+        metaData->addEnumInfo(tr("Enabled"), enumValue);
+        metaData->convertAndValidateRaw(0, false /* validate */, enumValue, errorString);
+        metaData->addEnumInfo(tr("Disabled"), enumValue);
+    }
+
+    for (const auto& bitInfo: entry.bitmask) {
+        bool ok = false;
+        unsigned char bit = static_cast<unsigned char>(bitInfo.first.toUInt(&ok));
+        if (ok) {
+            if (bit < 31) {
+                QVariant bitmaskRawValue = 1 << bit;
+                QVariant bitmaskValue;
+                if (metaData->convertAndValidateRaw(bitmaskRawValue, true, bitmaskValue, errorString)) {
+                    metaData->addBitmaskInfo(bitInfo.second, bitmaskValue);
+                } else {
+                    qCDebug(PX4ParameterMetaDataLog) << "Invalid bitmask value, name:" << entry.name
+                                                     << " type:" << entry.type << " value:" << bitmaskValue
+                                                     << " error:" << errorString;
+                }
+            } else {
+                qCWarning(PX4ParameterMetaDataLog) << "Invalid value for bitmask, bit:" << bit;
+            }
+        }
+    }
+
+    // Validate default value against the final min/max
+    if (metaData->defaultValueAvailable()) {
+        QVariant var;
+        if (!metaData->convertAndValidateRaw(metaData->rawDefaultValue(), false /* convertOnly */, var, errorString)) {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << entry.name << " type:" << entry.type << " default:" << metaData->rawDefaultValue() << " error:" << errorString;
+        }
+    }
+
+    return metaData;
 }
 
 FactMetaData* PX4ParameterMetaData::getMetaDataForFact(const QString& name, MAV_TYPE vehicleType)
@@ -411,17 +481,23 @@ FactMetaData* PX4ParameterMetaData::getMetaDataForFact(const QString& name, MAV_
 
     if (_mapParameterName2FactMetaData.contains(name)) {
         return _mapParameterName2FactMetaData[name];
-    } else {
+    }
+
+    ParameterMetaDataIndex::Entry entry;
+    if (!_index.find(kIndexSection, name, entry)) {
         return nullptr;
     }
+
+    FactMetaData* metaData = _createMetaData(entry);
+    _mapParameterName2FactMetaData[name] = metaData;
+    return metaData;
 }
 
 void PX4ParameterMetaData::addMetaDataToFact(Fact* fact, MAV_TYPE vehicleType)
 {
-    Q_UNUSED(vehicleType)
-
-    if (_mapParameterName2FactMetaData.contains(fact->name())) {
-        fact->setMetaData(_mapParameterName2FactMetaData[fact->name()]);
+    FactMetaData* metaData = getMetaDataForFact(fact->name(), vehicleType);
+    if (metaData) {
+        fact->setMetaData(metaData);
     }
 }
 
@@ -19,6 +19,7 @@
 #include "FactSystem.h"
 #include "AutoPilotPlugin.h"
 #include "Vehicle.h"
+#include "ParameterMetaDataIndex.h"
 
 /// @file
 ///     @author Don Gagne <don@thegagnes.com>
@@ -49,11 +50,15 @@ private:
         XmlStateDone
     };    
 
+    bool            _parseParameterMetaDataXml  (const QByteArray& xmlData, const QString& metaDataFile, QMap<QString, ParameterMetaDataIndex::Entry>& entries);
+    FactMetaData*   _createMetaData             (const ParameterMetaDataIndex::Entry& entry);
+
     QVariant _stringToTypedVariant(const QString& string, FactMetaData::ValueType_t type, bool* convertOk);
     static void _outputFileWarning(const QString& metaDataFile, const QString& error1, const QString& error2);
 
     bool _parameterMetaDataLoaded;   ///< true: parameter meta data already loaded
-    QMap<QString, FactMetaData*> _mapParameterName2FactMetaData; ///< Maps from a parameter name to FactMetaData
+    ParameterMetaDataIndex       _index;                        ///< Compiled meta data, FactMetaData is created from this on demand
+    QMap<QString, FactMetaData*> _mapParameterName2FactMetaData; ///< Maps from a parameter name to FactMetaData created so far
 };
 
 #endif
@@ -0,0 +1,415 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ParameterMetaDataIndex.h"
+
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSettings>
+#include <QHash>
+#include <QRegularExpression>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+QGC_LOGGING_CATEGORY(ParameterMetaDataIndexLog, "ParameterMetaDataIndexLog")
+
+// Index file layout, all values are little endian quint32 unless noted:
+//
+//  Header:     magic, version, source hash (16 bytes), section count, record count, pair count, string table size
+//  Sections:   name, first record, record count                                        (sorted by name)
+//  Records:    name, category, group, short desc, long desc, min, max, increment,
+//              units, default, decimal places (qint32), flags, type (qint32),
+//              first value pair, value pair count, first bitmask pair, bitmask pair count (sorted by name within section)
+//  Pairs:      first, second
+//  Strings:    nul terminated UTF-8, offset 0 is always the empty string
+//
+// All string fields are offsets into the string table.
+
+static const int        _hashSize =         16;
+static const qint64     _headerSize =       (2 * sizeof(quint32)) + _hashSize + (4 * sizeof(quint32));
+static const qint64     _sectionSize =      3 * sizeof(quint32);
+static const qint64     _recordSize =       17 * sizeof(quint32);
+static const qint64     _pairSize =         2 * sizeof(quint32);
+
+enum RecordField {
+    RecordName = 0,
+    RecordCategory,
+    RecordGroup,
+    RecordShortDesc,
+    RecordLongDesc,
+    RecordMin,
+    RecordMax,
+    RecordIncrement,
+    RecordUnits,
+    RecordDefault,
+    RecordDecimalPlaces,
+    RecordFlags,
+    RecordType,
+    RecordValuesFirst,
+    RecordValuesCount,
+    RecordBitmaskFirst,
+    RecordBitmaskCount,
+};
+
+ParameterMetaDataIndex::ParameterMetaDataIndex(void)
+    : _data             (nullptr)
+    , _size             (0)
+    , _sectionCount     (0)
+    , _recordCount      (0)
+    , _pairCount        (0)
+    , _sectionsOffset   (0)
+    , _recordsOffset    (0)
+    , _pairsOffset      (0)
+    , _stringsOffset    (0)
+    , _stringsSize      (0)
+{
+
+}
+
+ParameterMetaDataIndex::~ParameterMetaDataIndex()
+{
+    _close();
+}
+
+QByteArray ParameterMetaDataIndex::sourceHash(const QByteArray& sourceData)
+{
+    return QCryptographicHash::hash(sourceData, QCryptographicHash::Md5);
+}
+
+QString ParameterMetaDataIndex::indexFileName(const QString& metaDataFile, const QByteArray& sourceHash)
+{
+    const QString spath(QFileInfo(QSettings().fileName()).dir().absolutePath());
+    QDir indexDir(spath + QDir::separator() + "ParameterMetaData");
+    return indexDir.filePath(QStringLiteral("%1.%2.qpmi").arg(QFileInfo(metaDataFile).completeBaseName()).arg(QString(sourceHash.toHex())));
+}
+
+void ParameterMetaDataIndex::_close(void)
+{
+    if (_data && _file.isOpen()) {
+        _file.unmap(const_cast<uchar*>(_data));
+    }
+    _file.close();
+    _memoryData.clear();
+    _data = nullptr;
+    _size = 0;
+}
+
+quint32 ParameterMetaDataIndex::_u32(qint64 offset) const
+{
+    return qFromLittleEndian<quint32>(_data + offset);
+}
+
+bool ParameterMetaDataIndex::load(const QString& indexFile, const QByteArray& sourceHash)
+{
+    _close();
+
+    _file.setFileName(indexFile);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    qint64 size = _file.size();
+    const uchar* data = _file.map(0, size);
+    if (!data) {
+        // Not all file systems support mapping, fall back to reading the whole file
+        _memoryData = _file.readAll();
+        _file.close();
+        data = reinterpret_cast<const uchar*>(_memoryData.constData());
+        size = _memoryData.size();
+    }
+
+    if (!_setData(data, size, sourceHash)) {
+        qCDebug(ParameterMetaDataIndexLog) << "Discarding out of date or corrupt index" << indexFile;
+        _close();
+        return false;
+    }
+
+    qCDebug(ParameterMetaDataIndexLog) << "Loaded index" << indexFile << "records" << _recordCount;
+    return true;
+}
+
+bool ParameterMetaDataIndex::_setData(const uchar* data, qint64 size, const QByteArray& sourceHash)
+{
+    _data = data;
+    _size = size;
+
+    if (!data || size < _headerSize) {
+        return false;
+    }
+    if (_u32(0) != _magic || _u32(4) != _version) {
+        return false;
+    }
+    if (sourceHash.size() != _hashSize || std::memcmp(data + 8, sourceHash.constData(), _hashSize) != 0) {
+        return false;
+    }
+
+    qint64 offset = 8 + _hashSize;
+    _sectionCount   = _u32(offset);
+    _recordCount    = _u32(offset + 4);
+    _pairCount      = _u32(offset + 8);
+    _stringsSize    = _u32(offset + 12);
+
+    _sectionsOffset = _headerSize;
+    _recordsOffset  = _sectionsOffset + (_sectionCount * _sectionSize);
+    _pairsOffset    = _recordsOffset + (_recordCount * _recordSize);
+    _stringsOffset  = _pairsOffset + (_pairCount * _pairSize);
+
+    if (_stringsSize == 0 || _stringsOffset + _stringsSize != size) {
+        return false;
+    }
+    // Make sure string lookups can never run off the end of the data
+    if (_data[_stringsOffset] != 0 || _data[size - 1] != 0) {
+        return false;
+    }
+
+    return true;
+}
+
+const char* ParameterMetaDataIndex::_stringData(quint32 offset) const
+{
+    if (offset >= _stringsSize) {
+        return "";
+    }
+    return reinterpret_cast<const char*>(_data + _stringsOffset + offset);
+}
+
+QString ParameterMetaDataIndex::_string(quint32 offset) const
+{
+    return QString::fromUtf8(_stringData(offset));
+}
+
+ParameterMetaDataIndex::StringPairList ParameterMetaDataIndex::_pairs(quint32 first, quint32 count) const
+{
+    StringPairList pairs;
+
+    if (first > _pairCount || count > _pairCount - first) {
+        return pairs;
+    }
+
+    pairs.reserve(static_cast<int>(count));
+    for (quint32 i=first; i<first+count; i++) {
+        qint64 pairOffset = _pairsOffset + (i * _pairSize);
+        pairs.append(qMakePair(_string(_u32(pairOffset)), _string(_u32(pairOffset + 4))));
+    }
+
+    return pairs;
+}
+
+bool ParameterMetaDataIndex::_findSection(const QString& section, quint32& firstRecord, quint32& recordCount) const
+{
+    if (!_data) {
+        return false;
+    }
+
+    const QByteArray sectionBytes = section.toUtf8();
+    for (quint32 i=0; i<_sectionCount; i++) {
+        qint64 sectionOffset = _sectionsOffset + (i * _sectionSize);
+        if (std::strcmp(_stringData(_u32(sectionOffset)), sectionBytes.constData()) == 0) {
+            firstRecord = _u32(sectionOffset + 4);
+            recordCount = _u32(sectionOffset + 8);
+            return firstRecord <= _recordCount && recordCount <= _recordCount - firstRecord;
+        }
+    }
+
+    return false;
+}
+
+int ParameterMetaDataIndex::count(const QString& section) const
+{
+    quint32 firstRecord, recordCount;
+    if (_findSection(section, firstRecord, recordCount)) {
+        return static_cast<int>(recordCount);
+    }
+    return 0;
+}
+
+bool ParameterMetaDataIndex::find(const QString& section, const QString& name, Entry& entry) const
+{
+    quint32 firstRecord, recordCount;
+    if (!_findSection(section, firstRecord, recordCount)) {
+        return false;
+    }
+
+    const QByteArray nameBytes = name.toUtf8();
+
+    // Binary search by name within the section
+    quint32 low = firstRecord;
+    quint32 high = firstRecord + recordCount;
+    while (low < high) {
+        quint32 mid = low + ((high - low) / 2);
+        qint64 recordOffset = _recordsOffset + (mid * _recordSize);
+        int cmp = std::strcmp(_stringData(_u32(recordOffset)), nameBytes.constData());
+        if (cmp < 0) {
+            low = mid + 1;
+        } else if (cmp > 0) {
+            high = mid;
+        } else {
+            auto field = [this, recordOffset](RecordField f) { return _u32(recordOffset + (f * sizeof(quint32))); };
+
+            entry.name              = name;
+            entry.category          = _string(field(RecordCategory));
+            entry.group             = _string(field(RecordGroup));
+            entry.shortDescription  = _string(field(RecordShortDesc));
+            entry.longDescription   = _string(field(RecordLongDesc));
+            entry.min               = _string(field(RecordMin));
+            entry.max               = _string(field(RecordMax));
+            entry.increment         = _string(field(RecordIncrement));
+            entry.units             = _string(field(RecordUnits));
+            entry.defaultValue      = _string(field(RecordDefault));
+            entry.decimalPlaces     = static_cast<qint32>(field(RecordDecimalPlaces));
+            entry.flags             = field(RecordFlags);
+            entry.type              = static_cast<qint32>(field(RecordType));
+            entry.values            = _pairs(field(RecordValuesFirst), field(RecordValuesCount));
+            entry.bitmask           = _pairs(field(RecordBitmaskFirst), field(RecordBitmaskCount));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+QByteArray ParameterMetaDataIndex::build(const SectionMap& sections, const QByteArray& sourceHash)
+{
+    QByteArray              sectionData;
+    QByteArray              recordData;
+    QByteArray              pairData;
+    QByteArray              stringData(1, '\0');
+    QHash<QByteArray, quint32> stringOffsets;
+    quint32                 recordCount = 0;
+    quint32                 pairCount = 0;
+
+    auto appendU32 = [](QByteArray& data, quint32 value) {
+        uchar bytes[sizeof(quint32)];
+        qToLittleEndian<quint32>(value, bytes);
+        data.append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+    };
+    auto addString = [&stringData, &stringOffsets](const QString& string) -> quint32 {
+        if (string.isEmpty()) {
+            return 0;
+        }
+        const QByteArray bytes = string.toUtf8();
+        auto iter = stringOffsets.constFind(bytes);
+        if (iter != stringOffsets.constEnd()) {
+            return iter.value();
+        }
+        quint32 offset = static_cast<quint32>(stringData.size());
+        stringData.append(bytes);
+        stringData.append('\0');
+        stringOffsets.insert(bytes, offset);
+        return offset;
+    };
+    auto addPairs = [&](const StringPairList& pairs) -> quint32 {
+        quint32 first = pairCount;
+        for (const auto& pair: pairs) {
+            appendU32(pairData, addString(pair.first));
+            appendU32(pairData, addString(pair.second));
+            pairCount++;
+        }
+        return first;
+    };
+
+    for (auto sectionIter = sections.constBegin(); sectionIter != sections.constEnd(); sectionIter++) {
+        // Lookups compare UTF-8 bytes, so records are sorted the same way
+        QList<const Entry*> entries;
+        for (const Entry& entry: sectionIter.value()) {
+            entries.append(&entry);
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry* a, const Entry* b) { return a->name.toUtf8() < b->name.toUtf8(); });
+
+        appendU32(sectionData, addString(sectionIter.key()));
+        appendU32(sectionData, recordCount);
+        appendU32(sectionData, static_cast<quint32>(entries.count()));
+
+        for (const Entry* entry: entries) {
+            appendU32(recordData, addString(entry->name));
+            appendU32(recordData, addString(entry->category));
+            appendU32(recordData, addString(entry->group));
+            appendU32(recordData, addString(entry->shortDescription));
+            appendU32(recordData, addString(entry->longDescription));
+            appendU32(recordData, addString(entry->min));
+            appendU32(recordData, addString(entry->max));
+            appendU32(recordData, addString(entry->increment));
+            appendU32(recordData, addString(entry->units));
+            appendU32(recordData, addString(entry->defaultValue));
+            appendU32(recordData, static_cast<quint32>(entry->decimalPlaces));
+            appendU32(recordData, entry->flags);
+            appendU32(recordData, static_cast<quint32>(entry->type));
+            appendU32(recordData, addPairs(entry->values));
+            appendU32(recordData, static_cast<quint32>(entry->values.count()));
+            appendU32(recordData, addPairs(entry->bitmask));
+            appendU32(recordData, static_cast<quint32>(entry->bitmask.count()));
+            recordCount++;
+        }
+    }
+
+    QByteArray index;
+    index.reserve(static_cast<int>(_headerSize) + sectionData.size() + recordData.size() + pairData.size() + stringData.size());
+    appendU32(index, _magic);
+    appendU32(index, _version);
+    index.append(sourceHash.left(_hashSize).leftJustified(_hashSize, '\0'));
+    appendU32(index, static_cast<quint32>(sections.count()));
+    appendU32(index, recordCount);
+    appendU32(index, pairCount);
+    appendU32(index, static_cast<quint32>(stringData.size()));
+    index.append(sectionData);
+    index.append(recordData);
+    index.append(pairData);
+    index.append(stringData);
+
+    return index;
+}
+
+bool ParameterMetaDataIndex::compile(const SectionMap& sections, const QString& indexFile, const QByteArray& sourceHash)
+{
+    _close();
+
+    QByteArray index = build(sections, sourceHash);
+
+    QFileInfo indexInfo(indexFile);
+    indexInfo.dir().mkpath(".");
+
+    QSaveFile file(indexFile);
+    if (file.open(QIODevice::WriteOnly) && file.write(index) == index.size() && file.commit()) {
+        qCDebug(ParameterMetaDataIndexLog) << "Compiled index" << indexFile << "size" << index.size();
+        _removeStaleIndexFiles(indexFile);
+        if (load(indexFile, sourceHash)) {
+            return true;
+        }
+    } else {
+        qCWarning(ParameterMetaDataIndexLog) << "Unable to write index" << indexFile << file.errorString();
+    }
+
+    // Keep going from memory, the index will be compiled again on next load
+    _memoryData = index;
+    if (!_setData(reinterpret_cast<const uchar*>(_memoryData.constData()), _memoryData.size(), sourceHash)) {
+        _close();
+        return false;
+    }
+    return true;
+}
+
+/// An index is only compiled when the XML file changed, so indices for any other hash of the same XML file are out of date
+void ParameterMetaDataIndex::_removeStaleIndexFiles(const QString& indexFile)
+{
+    QFileInfo indexInfo(indexFile);
+
+    // File names are <xml base name>.<hex hash>.qpmi, the hash part keeps "apm" from matching "apm.pdef" indices
+    QString             baseName = indexInfo.completeBaseName().section(QLatin1Char('.'), 0, -2);
+    QRegularExpression  staleName(QStringLiteral("^%1\\.[0-9a-f]{%2}\\.qpmi$").arg(QRegularExpression::escape(baseName)).arg(_hashSize * 2));
+
+    QDir indexDir = indexInfo.dir();
+    for (const QString& fileName: indexDir.entryList(QStringList(baseName + QStringLiteral(".*.qpmi")), QDir::Files)) {
+        if (fileName != indexInfo.fileName() && staleName.match(fileName).hasMatch()) {
+            qCDebug(ParameterMetaDataIndexLog) << "Removing stale index" << fileName;
+            indexDir.remove(fileName);
+        }
+    }
+}
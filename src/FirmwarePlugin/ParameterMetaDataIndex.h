@@ -0,0 +1,125 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QPair>
+#include <QMap>
+#include <QFile>
+#include <QByteArray>
+#include <QDir>
+
+#include "QGCLoggingCategory.h"
+
+Q_DECLARE_LOGGING_CATEGORY(ParameterMetaDataIndexLog)
+
+/// Compact binary form of a firmware parameter meta data XML file.
+///
+/// The XML files are large and parsing them on every vehicle connect is slow. The first time a given XML file is loaded it is
+/// compiled into an index file which consists of a string table and fixed size records sorted by name. Later loads map the
+/// index file into memory and only decode the records for parameters which are actually looked up. The index is keyed by a
+/// hash of the XML contents so a changed XML file is recompiled automatically. Compiling an index removes the indices of
+/// earlier versions of the same XML file.
+///
+/// All values are kept as the strings found in the XML. Conversion to typed FactMetaData values is left to the firmware
+/// specific meta data classes so the index does not need to know the conversion rules of each firmware.
+class ParameterMetaDataIndex
+{
+public:
+    ParameterMetaDataIndex(void);
+    ~ParameterMetaDataIndex();
+
+    enum EntryFlags {
+        FlagRebootRequired  = 1 << 0,
+        FlagReadOnly        = 1 << 1,
+        FlagVolatile        = 1 << 2,
+        FlagBoolean         = 1 << 3,
+        FlagHasDefault      = 1 << 4,
+        FlagInvalid         = 1 << 5,   ///< Meta data can't be trusted, only name and type are valid
+    };
+
+    typedef QList<QPair<QString, QString>> StringPairList;
+
+    /// Decoded form of a single parameter
+    struct Entry {
+        QString         name;
+        QString         category;
+        QString         group;
+        QString         shortDescription;
+        QString         longDescription;
+        QString         min;
+        QString         max;
+        QString         increment;
+        QString         units;
+        QString         defaultValue;
+        int             type =          -1;     ///< FactMetaData::ValueType_t, -1 if not specified
+        int             decimalPlaces = -1;     ///< -1 if not specified
+        quint32         flags =         0;
+        StringPairList  values;                 ///< Enum values: code, description
+        StringPairList  bitmask;                ///< Bitmask values: bit index, description
+    };
+
+    /// Sections of entries, the section name is firmware defined (ArduPilot uses the vehicle type).
+    typedef QMap<QString, QMap<QString, Entry>> SectionMap;
+
+    /// Loads a previously compiled index for the specified source data
+    ///     @return false: no index or index out of date
+    bool load(const QString& indexFile, const QByteArray& sourceHash);
+
+    /// Compiles the sections into index format, writes it to indexFile and then loads it. If the index can't be written
+    /// to disk it is loaded from memory instead. Index files for other hashes of the same XML file are removed.
+    bool compile(const SectionMap& sections, const QString& indexFile, const QByteArray& sourceHash);
+
+    bool isLoaded(void) const { return _data != nullptr; }
+
+    /// Looks up the entry for the specified parameter
+    ///     @return false: parameter not found
+    bool find(const QString& section, const QString& name, Entry& entry) const;
+
+    /// @return Number of entries in the section, 0 if section not found
+    int count(const QString& section) const;
+
+    /// @return Hash used to key the index to the source XML file
+    static QByteArray sourceHash(const QByteArray& sourceData);
+
+    /// @return Index file name for the specified XML file
+    static QString indexFileName(const QString& metaDataFile, const QByteArray& sourceHash);
+
+    static QByteArray build(const SectionMap& sections, const QByteArray& sourceHash);
+
+private:
+    bool            _setData        (const uchar* data, qint64 size, const QByteArray& sourceHash);
+    void            _close          (void);
+    quint32         _u32            (qint64 offset) const;
+    const char*     _stringData     (quint32 offset) const;
+    QString         _string         (quint32 offset) const;
+    StringPairList  _pairs          (quint32 first, quint32 count) const;
+    bool            _findSection    (const QString& section, quint32& firstRecord, quint32& recordCount) const;
+
+    static void     _removeStaleIndexFiles(const QString& indexFile);
+
+    QFile           _file;
+    QByteArray      _memoryData;    ///< Index data when it is not mapped from a file
+    const uchar*    _data;
+    qint64          _size;
+    quint32         _sectionCount;
+    quint32         _recordCount;
+    quint32         _pairCount;
+    qint64          _sectionsOffset;
+    qint64          _recordsOffset;
+    qint64          _pairsOffset;
+    qint64          _stringsOffset;
+    quint32         _stringsSize;
+
+    static const quint32 _magic =   0x494d5051; // "QPMI"
+    static const quint32 _version = 1;
+};
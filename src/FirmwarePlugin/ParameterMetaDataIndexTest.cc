@@ -0,0 +1,199 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ParameterMetaDataIndexTest.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+void ParameterMetaDataIndexTest::init(void)
+{
+    UnitTest::init();
+
+    _indexDir = new QTemporaryDir;
+    QVERIFY(_indexDir->isValid());
+    _hash = ParameterMetaDataIndex::sourceHash(QByteArrayLiteral("<parameters version 1/>"));
+}
+
+void ParameterMetaDataIndexTest::cleanup(void)
+{
+    delete _indexDir;
+    _indexDir = nullptr;
+
+    UnitTest::cleanup();
+}
+
+ParameterMetaDataIndex::SectionMap ParameterMetaDataIndexTest::_sections(void) const
+{
+    ParameterMetaDataIndex::SectionMap  sections;
+    ParameterMetaDataIndex::Entry       entry;
+
+    entry.name =                QStringLiteral("MPC_XY_VEL_MAX");
+    entry.group =               QStringLiteral("Multicopter Position Control");
+    entry.shortDescription =    QStringLiteral("Maximum horizontal velocity");
+    entry.min =                 QStringLiteral("0");
+    entry.max =                 QStringLiteral("20");
+    entry.units =               QStringLiteral("m/s");
+    entry.defaultValue =        QStringLiteral("12");
+    entry.type =                3;
+    entry.decimalPlaces =       2;
+    entry.flags =               ParameterMetaDataIndex::FlagHasDefault;
+    sections[QString()][entry.name] = entry;
+
+    entry = ParameterMetaDataIndex::Entry();
+    entry.name =    QStringLiteral("COM_RC_IN_MODE");
+    entry.type =    2;
+    entry.flags =   ParameterMetaDataIndex::FlagRebootRequired;
+    entry.values << qMakePair(QStringLiteral("0"), QStringLiteral("RC Transmitter"))
+                 << qMakePair(QStringLiteral("1"), QStringLiteral("Joystick/No RC Checks"));
+    sections[QString()][entry.name] = entry;
+
+    entry = ParameterMetaDataIndex::Entry();
+    entry.name =    QStringLiteral("SERIAL1_OPTIONS");
+    entry.bitmask << qMakePair(QStringLiteral("0"), QStringLiteral("InvertRX"))
+                  << qMakePair(QStringLiteral("1"), QStringLiteral("InvertTX"));
+    sections[QStringLiteral("ArduCopter")][entry.name] = entry;
+
+    return sections;
+}
+
+void ParameterMetaDataIndexTest::_compileLoad(void)
+{
+    QString indexFileName = QFileInfo(ParameterMetaDataIndex::indexFileName(QStringLiteral("PX4ParameterFactMetaData.xml"), _hash)).fileName();
+    QCOMPARE(indexFileName, QStringLiteral("PX4ParameterFactMetaData.%1.qpmi").arg(QString(_hash.toHex())));
+    QString indexFile = _indexDir->filePath(indexFileName);
+
+    ParameterMetaDataIndex index;
+    QVERIFY(!index.load(indexFile, _hash));
+    QVERIFY(index.compile(_sections(), indexFile, _hash));
+    QVERIFY(index.isLoaded());
+    QVERIFY(QFile::exists(indexFile));
+
+    // A compiled index is picked up again by later loads
+    ParameterMetaDataIndex loadedIndex;
+    QVERIFY(loadedIndex.load(indexFile, _hash));
+    QCOMPARE(loadedIndex.count(QString()), 2);
+    QCOMPARE(loadedIndex.count(QStringLiteral("ArduCopter")), 1);
+    QCOMPARE(loadedIndex.count(QStringLiteral("ArduPlane")), 0);
+}
+
+void ParameterMetaDataIndexTest::_find(void)
+{
+    ParameterMetaDataIndex          index;
+    ParameterMetaDataIndex::Entry   entry;
+
+    QVERIFY(index.compile(_sections(), _indexDir->filePath(QStringLiteral("find.qpmi")), _hash));
+
+    QVERIFY(index.find(QString(), QStringLiteral("MPC_XY_VEL_MAX"), entry));
+    QCOMPARE(entry.name,                QStringLiteral("MPC_XY_VEL_MAX"));
+    QCOMPARE(entry.group,               QStringLiteral("Multicopter Position Control"));
+    QCOMPARE(entry.shortDescription,    QStringLiteral("Maximum horizontal velocity"));
+    QCOMPARE(entry.min,                 QStringLiteral("0"));
+    QCOMPARE(entry.max,                 QStringLiteral("20"));
+    QCOMPARE(entry.units,               QStringLiteral("m/s"));
+    QCOMPARE(entry.defaultValue,        QStringLiteral("12"));
+    QCOMPARE(entry.type,                3);
+    QCOMPARE(entry.decimalPlaces,       2);
+    QCOMPARE(entry.flags,               static_cast<quint32>(ParameterMetaDataIndex::FlagHasDefault));
+    QVERIFY(entry.category.isEmpty());
+    QVERIFY(entry.values.isEmpty());
+
+    QVERIFY(index.find(QString(), QStringLiteral("COM_RC_IN_MODE"), entry));
+    QCOMPARE(entry.flags,           static_cast<quint32>(ParameterMetaDataIndex::FlagRebootRequired));
+    QCOMPARE(entry.decimalPlaces,   -1);
+    QCOMPARE(entry.values.count(),  2);
+    QCOMPARE(entry.values[1].first,  QStringLiteral("1"));
+    QCOMPARE(entry.values[1].second, QStringLiteral("Joystick/No RC Checks"));
+
+    QVERIFY(index.find(QStringLiteral("ArduCopter"), QStringLiteral("SERIAL1_OPTIONS"), entry));
+    QCOMPARE(entry.type,                -1);
+    QCOMPARE(entry.bitmask.count(),     2);
+    QCOMPARE(entry.bitmask[0].second,   QStringLiteral("InvertRX"));
+
+    // Parameters are only found in their own section
+    QVERIFY(!index.find(QString(), QStringLiteral("SERIAL1_OPTIONS"), entry));
+    QVERIFY(!index.find(QStringLiteral("ArduCopter"), QStringLiteral("MPC_XY_VEL_MAX"), entry));
+    QVERIFY(!index.find(QString(), QStringLiteral("NOT_A_PARAM"), entry));
+}
+
+void ParameterMetaDataIndexTest::_sourceHashMismatch(void)
+{
+    QString                 indexFile = _indexDir->filePath(QStringLiteral("hash.qpmi"));
+    ParameterMetaDataIndex  index;
+
+    QVERIFY(index.compile(_sections(), indexFile, _hash));
+
+    // An index built from other XML contents must not be used
+    QVERIFY(!index.load(indexFile, ParameterMetaDataIndex::sourceHash(QByteArrayLiteral("<parameters version 2/>"))));
+    QVERIFY(!index.isLoaded());
+    QVERIFY(index.load(indexFile, _hash));
+}
+
+void ParameterMetaDataIndexTest::_corruptIndex(void)
+{
+    QByteArray              data = ParameterMetaDataIndex::build(_sections(), _hash);
+    QString                 indexFile = _indexDir->filePath(QStringLiteral("corrupt.qpmi"));
+    ParameterMetaDataIndex  index;
+
+    auto writeIndex = [&indexFile](const QByteArray& indexData) {
+        QFile file(indexFile);
+        return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(indexData) == indexData.size();
+    };
+
+    QVERIFY(writeIndex(data));
+    QVERIFY(index.load(indexFile, _hash));
+
+    // Truncated
+    QVERIFY(writeIndex(data.left(data.size() - 1)));
+    QVERIFY(!index.load(indexFile, _hash));
+    QVERIFY(writeIndex(data.left(8)));
+    QVERIFY(!index.load(indexFile, _hash));
+
+    // Bad magic
+    QByteArray badMagic = data;
+    badMagic[0] = badMagic[0] ^ 0xff;
+    QVERIFY(writeIndex(badMagic));
+    QVERIFY(!index.load(indexFile, _hash));
+
+    // String table not terminated
+    QByteArray unterminated = data;
+    unterminated[unterminated.size() - 1] = 'x';
+    QVERIFY(writeIndex(unterminated));
+    QVERIFY(!index.load(indexFile, _hash));
+}
+
+void ParameterMetaDataIndexTest::_staleIndexRemoved(void)
+{
+    QByteArray oldHash = ParameterMetaDataIndex::sourceHash(QByteArrayLiteral("<parameters version 0/>"));
+    QString    oldHex =  QString(oldHash.toHex());
+
+    QStringList staleFiles = { QStringLiteral("apm.pdef.%1.qpmi").arg(oldHex) };
+    QStringList keptFiles = {
+        QStringLiteral("apm.%1.qpmi").arg(oldHex),                  // Other XML file sharing a name prefix
+        QStringLiteral("PX4ParameterFactMetaData.%1.qpmi").arg(oldHex),
+        QStringLiteral("apm.pdef.notahash.qpmi"),
+        QStringLiteral("apm.pdef.%1.txt").arg(oldHex),
+    };
+    for (const QString& fileName: staleFiles + keptFiles) {
+        QFile file(_indexDir->filePath(fileName));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+
+    QString                 indexFile = _indexDir->filePath(QStringLiteral("apm.pdef.%1.qpmi").arg(QString(_hash.toHex())));
+    ParameterMetaDataIndex  index;
+    QVERIFY(index.compile(_sections(), indexFile, _hash));
+
+    QVERIFY(QFile::exists(indexFile));
+    for (const QString& fileName: staleFiles) {
+        QVERIFY2(!QFile::exists(_indexDir->filePath(fileName)), qPrintable(fileName));
+    }
+    for (const QString& fileName: keptFiles) {
+        QVERIFY2(QFile::exists(_indexDir->filePath(fileName)), qPrintable(fileName));
+    }
+}
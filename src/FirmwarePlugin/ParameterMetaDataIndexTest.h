@@ -0,0 +1,36 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "ParameterMetaDataIndex.h"
+
+#include <QTemporaryDir>
+
+class ParameterMetaDataIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init(void);
+    void cleanup(void);
+
+    void _compileLoad           (void);
+    void _find                  (void);
+    void _sourceHashMismatch    (void);
+    void _corruptIndex          (void);
+    void _staleIndexRemoved     (void);
+
+private:
+    ParameterMetaDataIndex::SectionMap _sections(void) const;
+
+    QTemporaryDir*  _indexDir;
+    QByteArray      _hash;
+};
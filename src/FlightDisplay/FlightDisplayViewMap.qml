@@ -66,6 +66,35 @@ FlightMap {
         }
     }
 
+    // Reloads the trajectory at the level of detail needed for the current map view
+    function updateTrajectory() {
+        if (!activeVehicle) {
+            trajectoryPolyline.path = []
+            return
+        }
+        var coordinateNW = flightMap.toCoordinate(Qt.point(0,0), false /* clipToViewPort */)
+        var coordinateSE = flightMap.toCoordinate(Qt.point(width,height), false /* clipToViewPort */)
+        if (coordinateNW.isValid && coordinateSE.isValid && width > 0 && height > 0) {
+            var metersPerPixel = coordinateNW.distanceTo(coordinateSE) / Math.sqrt(width * width + height * height)
+            trajectoryPolyline.path = activeVehicle.trajectoryPoints.listForView(coordinateNW, coordinateSE, metersPerPixel)
+        } else {
+            trajectoryPolyline.path = activeVehicle.trajectoryPoints.list()
+        }
+    }
+
+    // Re-clusters the camera trigger markers for the current map view
+    function updateCameraTriggers() {
+        if (!activeVehicle) {
+            return
+        }
+        var coordinateNW = flightMap.toCoordinate(Qt.point(0,0), false /* clipToViewPort */)
+        var coordinateSE = flightMap.toCoordinate(Qt.point(width,height), false /* clipToViewPort */)
+        if (coordinateNW.isValid && coordinateSE.isValid && width > 0 && height > 0) {
+            var metersPerPixel = coordinateNW.distanceTo(coordinateSE) / Math.sqrt(width * width + height * height)
+            activeVehicle.cameraTriggerPoints.setViewport(coordinateNW, coordinateSE, metersPerPixel)
+        }
+    }
+
     function pipIn() {
         if(QGroundControl.flightMapZoom > 3) {
             _pipping = true;
@@ -101,10 +130,12 @@ FlightMap {
             QGroundControl.flightMapZoom = zoomLevel
             updateAirspace(false)
         }
+        trajectoryUpdateTimer.restart()
     }
     onCenterChanged: {
         QGroundControl.flightMapPosition = center
         updateAirspace(false)
+        trajectoryUpdateTimer.restart()
     }
 
     // When the user pans the map we stop responding to vehicle coordinate updates until the panRecenterTimer fires
@@ -197,6 +228,17 @@ FlightMap {
         onTriggered:    updateMapToVehiclePosition()
     }
 
+    // Map view changes are coalesced before the trajectory is reloaded
+    Timer {
+        id:             trajectoryUpdateTimer
+        interval:       250
+        running:        false
+        onTriggered: {
+            updateTrajectory()
+            updateCameraTriggers()
+        }
+    }
+
     QGCMapPalette { id: mapPal; lightColors: isSatelliteMap }
 
     Connections {
@@ -229,7 +271,10 @@ FlightMap {
 
         Connections {
             target:                 QGroundControl.multiVehicleManager
-            onActiveVehicleChanged: trajectoryPolyline.path = activeVehicle ? activeVehicle.trajectoryPoints.list() : []
+            onActiveVehicleChanged: {
+                updateTrajectory()
+                updateCameraTriggers()
+            }
         }
 
         Connections {
@@ -237,6 +282,7 @@ FlightMap {
             onPointAdded:           trajectoryPolyline.addCoordinate(coordinate)
             onUpdateLastPoint:      trajectoryPolyline.replaceCoordinate(trajectoryPolyline.pathLength() - 1, coordinate)
             onPointsCleared:        trajectoryPolyline.path = []
+            onLevelsOfDetailChanged: trajectoryUpdateTimer.restart()
         }
     }
 
@@ -252,6 +298,22 @@ FlightMap {
         }
     }
 
+    // Add observed vehicles to the map, selecting one creates a fully managed vehicle for it
+    MapItemView {
+        model: QGroundControl.multiVehicleManager.observerVehicles
+        delegate: VehicleMapItem {
+            coordinate:     model.coordinate
+            altitude:       model.altitude
+            callsign:       qsTr("Vehicle %1").arg(model.vehicleId)
+            heading:        model.heading
+            map:            flightMap
+            clickable:      true
+            z:              QGroundControl.zOrderVehicles
+
+            onVehicleClicked: QGroundControl.multiVehicleManager.promoteObserverVehicle(model.vehicleId)
+        }
+    }
+
     // Add ADSB vehicles to the map
     MapItemView {
         model: QGroundControl.adsbVehicleManager.adsbVehicles
@@ -328,12 +390,13 @@ FlightMap {
         }
     }
 
-    // Camera trigger points
+    // Camera trigger points, clustered for the map view
     MapItemView {
-        model: activeVehicle ? activeVehicle.cameraTriggerPoints : 0
+        model: activeVehicle ? activeVehicle.cameraTriggerPoints.clusters : 0
 
         delegate: CameraTriggerIndicator {
-            coordinate:     object.coordinate
+            coordinate:     model.coordinate
+            imageCount:     model.imageCount
             z:              QGroundControl.zOrderTopMost
         }
     }
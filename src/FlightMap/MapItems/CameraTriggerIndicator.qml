@@ -15,11 +15,13 @@ import QGroundControl.ScreenTools   1.0
 import QGroundControl.Controls      1.0
 import QGroundControl.Vehicle       1.0
 
-/// Marker for displaying a camera trigger on the map
+/// Marker for displaying a camera trigger, or a cluster of camera triggers, on the map
 MapQuickItem {
     anchorPoint.x:  sourceItem.width / 2
     anchorPoint.y:  sourceItem.height / 2
 
+    property int imageCount: 1  ///< Number of images represented by the marker
+
     sourceItem: Rectangle {
         width:      _radius * 2
         height:     _radius * 2
@@ -27,7 +29,7 @@ MapQuickItem {
         color:      "black"
         opacity:    0.4
 
-        readonly property real _radius: ScreenTools.defaultFontPixelHeight * 0.6
+        readonly property real _radius: ScreenTools.defaultFontPixelHeight * (imageCount > 1 ? 0.9 : 0.6)
 
         QGCColoredImage {
             anchors.margins:    3
@@ -36,6 +38,14 @@ MapQuickItem {
             mipmap:             true
             fillMode:           Image.PreserveAspectFit
             source:             "/qmlimages/camera.svg"
+            visible:            imageCount === 1
+        }
+
+        QGCLabel {
+            anchors.centerIn:   parent
+            color:              "white"
+            text:               imageCount
+            visible:            imageCount > 1
         }
     }
 }
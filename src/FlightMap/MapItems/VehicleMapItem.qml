@@ -19,6 +19,8 @@ import QGroundControl.Controls      1.0
 
 /// Marker for displaying a vehicle location on the map
 MapQuickItem {
+    id: _root
+
     property var    vehicle                                                         /// Vehicle object, undefined for ADSB vehicle
     property var    map
     property double altitude:       Number.NaN                                      ///< NAN to not show
@@ -26,6 +28,9 @@ MapQuickItem {
     property double heading:        vehicle ? vehicle.heading.value : Number.NaN    ///< Vehicle heading, NAN for none
     property real   size:           _adsbVehicle ? _adsbSize : _uavSize             /// Size for icon
     property bool   alert:          false                                           /// Collision alert
+    property bool   clickable:      false                                           /// true: vehicleClicked is signalled
+
+    signal vehicleClicked
 
     anchorPoint.x:  vehicleItem.width  / 2
     anchorPoint.y:  vehicleItem.height / 2
@@ -89,5 +94,11 @@ MapQuickItem {
                                                   ""
 
         }
+
+        MouseArea {
+            anchors.fill:   parent
+            enabled:        clickable
+            onClicked:      _root.vehicleClicked()
+        }
     }
 }
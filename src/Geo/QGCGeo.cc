@@ -8,7 +8,10 @@
  ****************************************************************************/
 
 #include <QDebug>
+#include <QPair>
+#include <QPointF>
 #include <QString>
+#include <QVector>
 
 #include <cmath>
 #include <limits>
@@ -154,3 +157,79 @@ bool convertMGRSToGeo(QString mgrs, QGeoCoordinate& coord)
 
     return true;
 }
+
+QList<QGeoCoordinate> simplifyGeoPath(const QList<QGeoCoordinate>& path, double tolerance, bool closed)
+{
+    int cVertices = path.count();
+    if (tolerance <= 0 || cVertices < (closed ? 4 : 3)) {
+        return path;
+    }
+
+    QVector<QPointF> points(cVertices);
+    for (int i=0; i<cVertices; i++) {
+        double north, east, down;
+        convertGeoToNed(path[i], path[0], &north, &east, &down);
+        points[i] = QPointF(east, north);
+    }
+
+    QVector<bool>           keep(cVertices, false);
+    QVector<QPair<int,int>> ranges;
+
+    keep[0] = true;
+    if (closed) {
+        // A ring is split at the vertex furthest from the first one, each half is then simplified as an open path
+        int     furthestIndex = 1;
+        double  furthestDistance = 0;
+        for (int i=1; i<cVertices; i++) {
+            double distance = points[i].x() * points[i].x() + points[i].y() * points[i].y();
+            if (distance > furthestDistance) {
+                furthestDistance = distance;
+                furthestIndex = i;
+            }
+        }
+        keep[furthestIndex] = true;
+        ranges.append(qMakePair(0, furthestIndex));
+        ranges.append(qMakePair(furthestIndex, cVertices));     // cVertices wraps around to the first vertex
+    } else {
+        keep[cVertices - 1] = true;
+        ranges.append(qMakePair(0, cVertices - 1));
+    }
+
+    const double toleranceSquared = tolerance * tolerance;
+    while (!ranges.isEmpty()) {
+        QPair<int,int>  range       = ranges.takeLast();
+        QPointF         start       = points[range.first];
+        QPointF         end         = points[range.second % cVertices];
+        QPointF         segment     = end - start;
+        double          lengthSq    = QPointF::dotProduct(segment, segment);
+        double          maxDistance = -1;
+        int             maxIndex    = -1;
+
+        for (int i=range.first+1; i<range.second; i++) {
+            QPointF offset = points[i] - start;
+            if (lengthSq > 0) {
+                double t = qBound(0.0, QPointF::dotProduct(offset, segment) / lengthSq, 1.0);
+                offset -= segment * t;
+            }
+            double distance = QPointF::dotProduct(offset, offset);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                maxIndex = i;
+            }
+        }
+
+        if (maxIndex != -1 && maxDistance > toleranceSquared) {
+            keep[maxIndex] = true;
+            ranges.append(qMakePair(range.first, maxIndex));
+            ranges.append(qMakePair(maxIndex, range.second));
+        }
+    }
+
+    QList<QGeoCoordinate> simplified;
+    for (int i=0; i<cVertices; i++) {
+        if (keep[i]) {
+            simplified.append(path[i]);
+        }
+    }
+    return simplified;
+}
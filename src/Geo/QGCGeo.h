@@ -105,4 +105,13 @@ QString convertGeoToMGRS(const QGeoCoordinate& coord);
 // The function returns true if conversion succeeded.
 bool convertMGRSToGeo(QString mgrs, QGeoCoordinate& coord);
 
+/**
+ * @brief Douglas-Peucker simplification of a path. Distances are measured on the local tangent plane at the first vertex.
+ * @param[in] path Path to simplify.
+ * @param[in] tolerance Maximum distance in meters between the original and the simplified path.
+ * @param[in] closed true: path is a polygon ring, the segment from the last to the first vertex is included.
+ * @return Simplified path, the first vertex (and the last vertex for open paths) is always kept.
+ */
+QList<QGeoCoordinate> simplifyGeoPath(const QList<QGeoCoordinate>& path, double tolerance, bool closed);
+
 #endif // QGCGEO_H
@@ -460,23 +460,114 @@ void Joystick::run()
     //-- Joystick thread
     _open();
     //-- Reset timers
-    _axisTime.start();
+    _controlTimer.start();
+    _nextPollTime       = 0;
+    _nextSendTime       = 0;
+    _lastSendTime       = -1;
+    _inputChangeTime    = -1;
+    _rawAxisSignalTime  = -1;
+    _statsTime          = 0;
     for (int buttonIndex = 0; buttonIndex < _totalButtonCount; buttonIndex++) {
         if(_buttonActionArray[buttonIndex]) {
             _buttonActionArray[buttonIndex]->buttonTime.start();
         }
     }
+    // Input is read on a short fixed interval so button presses and repeats do not depend on the axis frequency.
+    // MANUAL_CONTROL is sent on its own fixed deadline schedule at the axis frequency, so the send rate does not depend
+    // on how long each cycle takes. Sleeps never go past the next poll, which also bounds how long stopPolling waits.
+    // SDL events are only pumped by JoystickManager on the main thread, this thread just reads the device state.
     while (!_exitThread) {
-        _update();
-        _handleButtons();
-        _handleAxis();
-        QGC::SLEEP::msleep(20);
+        qint64 now = _controlTimer.nsecsElapsed();
+        qint64 wakeTime = std::min(_nextPollTime, _nextSendTime);
+        if (wakeTime > now) {
+            QThread::usleep(static_cast<unsigned long>((wakeTime - now) / 1000));
+            continue;
+        }
+
+        _readInput(now);
+        _nextPollTime = now + _pollIntervalNsecs;
+
+        if (now >= _nextSendTime) {
+            _handleAxis();
+            qint64 sendTime = _controlTimer.nsecsElapsed();
+            _updateManualControlStats(sendTime);
+
+            // Schedule from the previous deadline to avoid drift, but don't try to catch up on missed sends
+            qint64 period = static_cast<qint64>(1.0e9 / static_cast<double>(_axisFrequency));
+            _nextSendTime += period;
+            if (_nextSendTime <= sendTime) {
+                _nextSendTime = sendTime + period;
+            }
+        }
     }
     _close();
 }
 
-void Joystick::_handleButtons()
+/// Reads buttons and axes and handles button actions. The time of the first change since the last MANUAL_CONTROL is
+/// kept for the latency statistics.
+void Joystick::_readInput(qint64 now)
+{
+    _update();
+    bool inputChanged = _handleButtons();
+
+    for (int axisIndex = 0; axisIndex < _axisCount; axisIndex++) {
+        int axisValue = _getAxis(axisIndex);
+        if (axisValue != _rgAxisValues[axisIndex]) {
+            _rgAxisValues[axisIndex] = axisValue;
+            inputChanged = true;
+        }
+    }
+    // Calibration code requires signal to be emitted even if value hasn't changed. The raw values are only for display and
+    // calibration on the main thread, so they are signalled at a fixed rate instead of the axis frequency.
+    if (_rawAxisSignalTime < 0 || now - _rawAxisSignalTime >= _rawAxisSignalIntervalNsecs) {
+        _rawAxisSignalTime = now;
+        for (int axisIndex = 0; axisIndex < _axisCount; axisIndex++) {
+            emit rawAxisValueChanged(axisIndex, _rgAxisValues[axisIndex]);
+        }
+    }
+
+    if (inputChanged && _inputChangeTime < 0) {
+        _inputChangeTime = now;
+    }
+}
+
+void Joystick::_updateManualControlStats(qint64 sendTime)
 {
+    qint64 period = static_cast<qint64>(1.0e9 / static_cast<double>(_axisFrequency));
+
+    // Latency is measured from the read which first saw an input change to the MANUAL_CONTROL carrying it. The time
+    // between the physical change and that read, at most one poll interval, can not be seen from here.
+    if (_inputChangeTime >= 0) {
+        _latencySum += (sendTime - _inputChangeTime) / 1.0e6;
+        _latencyCount++;
+        _inputChangeTime = -1;
+    }
+    if (_lastSendTime >= 0) {
+        _jitterSum += std::abs((sendTime - _lastSendTime) - period) / 1.0e6;
+        _jitterCount++;
+    }
+    _lastSendTime = sendTime;
+
+    //-- Publish once a second, latency keeps its last value while the input does not change
+    if (sendTime - _statsTime >= 1000000000LL) {
+        if (_latencyCount) {
+            _manualControlLatency = static_cast<float>(_latencySum / _latencyCount);
+        }
+        _manualControlJitter    = _jitterCount ? static_cast<float>(_jitterSum / _jitterCount) : 0.0f;
+        _latencySum     = 0;
+        _latencyCount   = 0;
+        _jitterSum      = 0;
+        _jitterCount    = 0;
+        _statsTime      = sendTime;
+        qCDebug(JoystickLog) << "MANUAL_CONTROL latency:jitter (ms)" << _manualControlLatency << _manualControlJitter;
+        emit manualControlStatsChanged();
+    }
+}
+
+/// @return true if any button or hat changed state
+bool Joystick::_handleButtons()
+{
+    bool changed = false;
     int lastBbuttonValues[256];
     //-- Update button states
     for (int buttonIndex = 0; buttonIndex < _buttonCount; buttonIndex++) {
@@ -485,9 +576,11 @@ void Joystick::_handleButtons()
             lastBbuttonValues[buttonIndex] = _rgButtonValues[buttonIndex];
         if (newButtonValue && _rgButtonValues[buttonIndex] == BUTTON_UP) {
             _rgButtonValues[buttonIndex] = BUTTON_DOWN;
+            changed = true;
             emit rawButtonPressedChanged(buttonIndex, newButtonValue);
         } else if (!newButtonValue && _rgButtonValues[buttonIndex] != BUTTON_UP) {
             _rgButtonValues[buttonIndex] = BUTTON_UP;
+            changed = true;
             emit rawButtonPressedChanged(buttonIndex, newButtonValue);
         }
     }
@@ -501,9 +594,11 @@ void Joystick::_handleButtons()
             bool newButtonValue = _getHat(hatIndex, hatButtonIndex);
             if (newButtonValue && _rgButtonValues[rgButtonValueIndex] == BUTTON_UP) {
                 _rgButtonValues[rgButtonValueIndex] = BUTTON_DOWN;
+                changed = true;
                 emit rawButtonPressedChanged(rgButtonValueIndex, newButtonValue);
             } else if (!newButtonValue && _rgButtonValues[rgButtonValueIndex] != BUTTON_UP) {
                 _rgButtonValues[rgButtonValueIndex] = BUTTON_UP;
+                changed = true;
                 emit rawButtonPressedChanged(rgButtonValueIndex, newButtonValue);
             }
         }
@@ -549,104 +644,93 @@ void Joystick::_handleButtons()
             }
         }
     }
+    return changed;
 }
 
 void Joystick::_handleAxis()
 {
-    //-- Get frequency
-    int axisDelay = static_cast<int>(1000.0f / _axisFrequency);
-    //-- Check elapsed time since last run
-    if(_axisTime.elapsed() > axisDelay) {
-        _axisTime.start();
-        //-- Update axis
-        for (int axisIndex = 0; axisIndex < _axisCount; axisIndex++) {
-            int newAxisValue = _getAxis(axisIndex);
-            // Calibration code requires signal to be emitted even if value hasn't changed
-            _rgAxisValues[axisIndex] = newAxisValue;
-            emit rawAxisValueChanged(axisIndex, newAxisValue);
-        }
-        if (_activeVehicle->joystickEnabled() && !_calibrationMode && _calibrated) {
-            int     axis = _rgFunctionAxis[rollFunction];
-            float   roll = _adjustRange(_rgAxisValues[axis],    _rgCalibration[axis], _deadband);
+    //-- Called at the axis frequency by run(), with the axis values from the latest _readInput
+    if (_activeVehicle->joystickEnabled() && !_calibrationMode && _calibrated) {
+        int     axis = _rgFunctionAxis[rollFunction];
+        float   roll = _adjustRange(_rgAxisValues[axis],    _rgCalibration[axis], _deadband);
 
-                    axis = _rgFunctionAxis[pitchFunction];
-            float   pitch = _adjustRange(_rgAxisValues[axis],   _rgCalibration[axis], _deadband);
+                axis = _rgFunctionAxis[pitchFunction];
+        float   pitch = _adjustRange(_rgAxisValues[axis],   _rgCalibration[axis], _deadband);
 
-                    axis = _rgFunctionAxis[yawFunction];
-            float   yaw = _adjustRange(_rgAxisValues[axis],     _rgCalibration[axis],_deadband);
+                axis = _rgFunctionAxis[yawFunction];
+        float   yaw = _adjustRange(_rgAxisValues[axis],     _rgCalibration[axis],_deadband);
 
-                    axis = _rgFunctionAxis[throttleFunction];
-            float   throttle = _adjustRange(_rgAxisValues[axis],_rgCalibration[axis], _throttleMode==ThrottleModeDownZero?false:_deadband);
+                axis = _rgFunctionAxis[throttleFunction];
+        float   throttle = _adjustRange(_rgAxisValues[axis],_rgCalibration[axis], _throttleMode==ThrottleModeDownZero?false:_deadband);
 
-            float   gimbalPitch = 0.0f;
-            float   gimbalYaw   = 0.0f;
+        float   gimbalPitch = 0.0f;
+        float   gimbalYaw   = 0.0f;
 
-            if(_axisCount > 4) {
-                axis = _rgFunctionAxis[gimbalPitchFunction];
-                gimbalPitch = _adjustRange(_rgAxisValues[axis], _rgCalibration[axis],_deadband);
-            }
+        if(_axisCount > 4) {
+            axis = _rgFunctionAxis[gimbalPitchFunction];
+            gimbalPitch = _adjustRange(_rgAxisValues[axis], _rgCalibration[axis],_deadband);
+        }
 
-            if(_axisCount > 5) {
-                axis = _rgFunctionAxis[gimbalYawFunction];
-                gimbalYaw = _adjustRange(_rgAxisValues[axis],   _rgCalibration[axis],_deadband);
-            }
+        if(_axisCount > 5) {
+            axis = _rgFunctionAxis[gimbalYawFunction];
+            gimbalYaw = _adjustRange(_rgAxisValues[axis],   _rgCalibration[axis],_deadband);
+        }
 
-            if (_accumulator) {
-                static float throttle_accu = 0.f;
-                throttle_accu += throttle * (40 / 1000.f); //for throttle to change from min to max it will take 1000ms (40ms is a loop time)
-                throttle_accu = std::max(static_cast<float>(-1.f), std::min(throttle_accu, static_cast<float>(1.f)));
-                throttle = throttle_accu;
-            }
+        if (_accumulator) {
+            static float throttle_accu = 0.f;
+            throttle_accu += throttle / _axisFrequency; //for throttle to change from min to max it will take 1000ms
+            throttle_accu = std::max(static_cast<float>(-1.f), std::min(throttle_accu, static_cast<float>(1.f)));
+            throttle = throttle_accu;
+        }
 
-            if (_circleCorrection) {
-                float roll_limited      = std::max(static_cast<float>(-M_PI_4), std::min(roll,      static_cast<float>(M_PI_4)));
-                float pitch_limited     = std::max(static_cast<float>(-M_PI_4), std::min(pitch,     static_cast<float>(M_PI_4)));
-                float yaw_limited       = std::max(static_cast<float>(-M_PI_4), std::min(yaw,       static_cast<float>(M_PI_4)));
-                float throttle_limited  = std::max(static_cast<float>(-M_PI_4), std::min(throttle,  static_cast<float>(M_PI_4)));
-
-                // Map from unit circle to linear range and limit
-                roll =      std::max(-1.0f, std::min(tanf(asinf(roll_limited)),     1.0f));
-                pitch =     std::max(-1.0f, std::min(tanf(asinf(pitch_limited)),    1.0f));
-                yaw =       std::max(-1.0f, std::min(tanf(asinf(yaw_limited)),      1.0f));
-                throttle =  std::max(-1.0f, std::min(tanf(asinf(throttle_limited)), 1.0f));
-            }
+        if (_circleCorrection) {
+            float roll_limited      = std::max(static_cast<float>(-M_PI_4), std::min(roll,      static_cast<float>(M_PI_4)));
+            float pitch_limited     = std::max(static_cast<float>(-M_PI_4), std::min(pitch,     static_cast<float>(M_PI_4)));
+            float yaw_limited       = std::max(static_cast<float>(-M_PI_4), std::min(yaw,       static_cast<float>(M_PI_4)));
+            float throttle_limited  = std::max(static_cast<float>(-M_PI_4), std::min(throttle,  static_cast<float>(M_PI_4)));
+
+            // Map from unit circle to linear range and limit
+            roll =      std::max(-1.0f, std::min(tanf(asinf(roll_limited)),     1.0f));
+            pitch =     std::max(-1.0f, std::min(tanf(asinf(pitch_limited)),    1.0f));
+            yaw =       std::max(-1.0f, std::min(tanf(asinf(yaw_limited)),      1.0f));
+            throttle =  std::max(-1.0f, std::min(tanf(asinf(throttle_limited)), 1.0f));
+        }
 
-            if ( _exponential < -0.01f) {
-                // Exponential (0% to -50% range like most RC radios)
-                // _exponential is set by a slider in joystickConfigAdvanced.qml
-                // Calculate new RPY with exponential applied
-                roll =      -_exponential*powf(roll, 3) + (1+_exponential)*roll;
-                pitch =     -_exponential*powf(pitch,3) + (1+_exponential)*pitch;
-                yaw =       -_exponential*powf(yaw,  3) + (1+_exponential)*yaw;
-            }
+        if ( _exponential < -0.01f) {
+            // Exponential (0% to -50% range like most RC radios)
+            // _exponential is set by a slider in joystickConfigAdvanced.qml
+            // Calculate new RPY with exponential applied
+            roll =      -_exponential*powf(roll, 3) + (1+_exponential)*roll;
+            pitch =     -_exponential*powf(pitch,3) + (1+_exponential)*pitch;
+            yaw =       -_exponential*powf(yaw,  3) + (1+_exponential)*yaw;
+        }
 
-            // Adjust throttle to 0:1 range
-            if (_throttleMode == ThrottleModeCenterZero && _activeVehicle->supportsThrottleModeCenterZero()) {
-                if (!_activeVehicle->supportsNegativeThrust() || !_negativeThrust) {
-                    throttle = std::max(0.0f, throttle);
-                }
-            } else {
-                throttle = (throttle + 1.0f) / 2.0f;
-            }
-            qCDebug(JoystickValuesLog) << "name:roll:pitch:yaw:throttle:gimbalPitch:gimbalYaw" << name() << roll << -pitch << yaw << throttle << gimbalPitch << gimbalYaw;
-            // NOTE: The buttonPressedBits going to MANUAL_CONTROL are currently used by ArduSub (and it only handles 16 bits)
-            // Set up button bitmap
-            quint64 buttonPressedBits = 0;  // Buttons pressed for manualControl signal
-            for (int buttonIndex = 0; buttonIndex < _totalButtonCount; buttonIndex++) {
-                quint64 buttonBit = static_cast<quint64>(1LL << buttonIndex);
-                if (_rgButtonValues[buttonIndex] != BUTTON_UP) {
-                    // Mark the button as pressed as long as its pressed
-                    buttonPressedBits |= buttonBit;
-                }
+        // Adjust throttle to 0:1 range
+        if (_throttleMode == ThrottleModeCenterZero && _activeVehicle->supportsThrottleModeCenterZero()) {
+            if (!_activeVehicle->supportsNegativeThrust() || !_negativeThrust) {
+                throttle = std::max(0.0f, throttle);
             }
-            uint16_t shortButtons = static_cast<uint16_t>(buttonPressedBits & 0xFFFF);
-            emit manualControl(roll, -pitch, yaw, throttle, shortButtons, _activeVehicle->joystickMode());
-            if(_activeVehicle && _axisCount > 4 && _gimbalEnabled) {
-                //-- TODO: There is nothing consuming this as there are no messages to handle gimbal
-                //   the way MANUAL_CONTROL handles the other channels.
-                emit manualControlGimbal((gimbalPitch + 1.0f) / 2.0f * 90.0f, gimbalYaw * 180.0f);
+        } else {
+            throttle = (throttle + 1.0f) / 2.0f;
+        }
+        qCDebug(JoystickValuesLog) << "name:roll:pitch:yaw:throttle:gimbalPitch:gimbalYaw" << name() << roll << -pitch << yaw << throttle << gimbalPitch << gimbalYaw;
+        // NOTE: The buttonPressedBits going to MANUAL_CONTROL are currently used by ArduSub (and it only handles 16 bits)
+        // Set up button bitmap
+        quint64 buttonPressedBits = 0;  // Buttons pressed for manualControl signal
+        for (int buttonIndex = 0; buttonIndex < _totalButtonCount; buttonIndex++) {
+            quint64 buttonBit = static_cast<quint64>(1LL << buttonIndex);
+            if (_rgButtonValues[buttonIndex] != BUTTON_UP) {
+                // Mark the button as pressed as long as its pressed
+                buttonPressedBits |= buttonBit;
             }
         }
+        uint16_t shortButtons = static_cast<uint16_t>(buttonPressedBits & 0xFFFF);
+        emit manualControl(roll, -pitch, yaw, throttle, shortButtons, _activeVehicle->joystickMode());
+        if(_activeVehicle && _axisCount > 4 && _gimbalEnabled) {
+            //-- TODO: There is nothing consuming this as there are no messages to handle gimbal
+            //   the way MANUAL_CONTROL handles the other channels.
+            emit manualControlGimbal((gimbalPitch + 1.0f) / 2.0f * 90.0f, gimbalYaw * 180.0f);
+        }
     }
 }
 
@@ -928,7 +1012,7 @@ void Joystick::setAxisFrequency(float val)
 {
     //-- Arbitrary limits
     if(val < 0.25f) val = 0.25f;
-    if(val > 50.0f) val = 50.0f;
+    if(val > 200.0f) val = 200.0f;
     _axisFrequency = val;
     _saveSettings();
     emit axisFrequencyChanged();
@@ -14,6 +14,7 @@
 
 #include <QObject>
 #include <QThread>
+#include <QElapsedTimer>
 
 #include "QGCLoggingCategory.h"
 #include "Vehicle.h"
@@ -103,6 +104,8 @@ public:
     Q_PROPERTY(int      throttleMode            READ throttleMode           WRITE setThrottleMode       NOTIFY throttleModeChanged)
     Q_PROPERTY(float    axisFrequency           READ axisFrequency          WRITE setAxisFrequency      NOTIFY axisFrequencyChanged)
     Q_PROPERTY(float    buttonFrequency         READ buttonFrequency        WRITE setButtonFrequency    NOTIFY buttonFrequencyChanged)
+    Q_PROPERTY(float    manualControlLatency    READ manualControlLatency                               NOTIFY manualControlStatsChanged)
+    Q_PROPERTY(float    manualControlJitter     READ manualControlJitter                                NOTIFY manualControlStatsChanged)
     Q_PROPERTY(bool     negativeThrust          READ negativeThrust         WRITE setNegativeThrust     NOTIFY negativeThrustChanged)
     Q_PROPERTY(float    exponential             READ exponential            WRITE setExponential        NOTIFY exponentialChanged)
     Q_PROPERTY(bool     accumulator             READ accumulator            WRITE setAccumulator        NOTIFY accumulatorChanged)
@@ -180,6 +183,12 @@ public:
     /// Set joystick button repeat rate (in Hz)
     void  setButtonFrequency(float val);
 
+    /// Average time (in msecs) from the read which first saw an input change to the MANUAL_CONTROL carrying it being sent.
+    /// The time before the read, at most one poll interval, is not included. Keeps its last value while the input is idle.
+    float manualControlLatency  () { return _manualControlLatency; }
+    /// Average deviation (in msecs) of the MANUAL_CONTROL send interval from the axis frequency
+    float manualControlJitter   () { return _manualControlJitter; }
+
 signals:
     // The raw signals are only meant for use by calibration
     void rawAxisValueChanged        (int index, int value);
@@ -209,6 +218,7 @@ signals:
     void gimbalEnabledChanged       ();
     void axisFrequencyChanged       ();
     void buttonFrequencyChanged     ();
+    void manualControlStatsChanged  ();
     void startContinuousZoom        (int direction);
     void stopContinuousZoom         ();
     void stepZoom                   (int direction);
@@ -237,7 +247,9 @@ protected:
     bool    _validAxis              (int axis);
     bool    _validButton            (int button);
     void    _handleAxis             ();
-    void    _handleButtons          ();
+    bool    _handleButtons          ();
+    void    _readInput              (qint64 now);
+    void    _updateManualControlStats(qint64 sendTime);
     void    _buildActionList        (Vehicle* activeVehicle);
 
     void    _pitchStep              (int direction);
@@ -298,7 +310,24 @@ protected:
 
     static int          _transmitterMode;
     int                 _rgFunctionAxis[maxFunction] = {};
-    QTime               _axisTime;
+
+    // MANUAL_CONTROL scheduling, all times are nsecs from _controlTimer
+    QElapsedTimer       _controlTimer;
+    qint64              _nextPollTime           = 0;
+    qint64              _nextSendTime           = 0;
+    qint64              _lastSendTime           = -1;
+    qint64              _inputChangeTime        = -1;   ///< First input change since the last send, -1 for none
+    qint64              _rawAxisSignalTime      = -1;   ///< Time raw axis values were last signalled, -1 for never
+    qint64              _statsTime              = 0;
+    double              _latencySum             = 0;
+    int                 _latencyCount           = 0;
+    double              _jitterSum              = 0;
+    int                 _jitterCount            = 0;
+    float               _manualControlLatency   = 0;
+    float               _manualControlJitter    = 0;
+
+    static const qint64 _pollIntervalNsecs          = 5000000;      ///< Input is read at 200Hz, the highest axis frequency
+    static const qint64 _rawAxisSignalIntervalNsecs = 20000000;     ///< 50Hz, the highest rate before axis frequency could go up to 200Hz
 
     QmlObjectListModel              _assignableButtonActions;
     QList<AssignedButtonAction*>    _buttonActionArray;
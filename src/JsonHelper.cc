@@ -11,8 +11,12 @@
 #include "QGCQGeoCoordinate.h"
 #include "QmlObjectListModel.h"
 
+#include <QFile>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QObject>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
@@ -215,6 +219,41 @@ bool JsonHelper::isJsonFile(const QByteArray& bytes, QJsonDocument& jsonDoc, QSt
     }
 }
 
+bool JsonHelper::openJsonFile(const QString& jsonFilename, QJsonDocument& jsonDoc, QString& errorString)
+{
+    static QMutex                           cacheMutex;
+    static QHash<QString, QJsonDocument>    resourceCache;
+
+    bool isResource = jsonFilename.startsWith(QStringLiteral(":/"));
+    if (isResource) {
+        QMutexLocker lock(&cacheMutex);
+        auto it = resourceCache.constFind(jsonFilename);
+        if (it != resourceCache.constEnd()) {
+            jsonDoc = it.value();
+            return true;
+        }
+    }
+
+    QFile jsonFile(jsonFilename);
+    if (!jsonFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        errorString = QObject::tr("Unable to open file: %1 error: %2").arg(jsonFilename).arg(jsonFile.errorString());
+        return false;
+    }
+
+    QString parseError;
+    if (!isJsonFile(jsonFile.readAll(), jsonDoc, parseError)) {
+        errorString = QObject::tr("Unable to parse json file: %1 error: %2").arg(jsonFilename).arg(parseError);
+        return false;
+    }
+
+    if (isResource) {
+        QMutexLocker lock(&cacheMutex);
+        resourceCache[jsonFilename] = jsonDoc;
+    }
+
+    return true;
+}
+
 bool JsonHelper::validateQGCJsonFile(const QJsonObject& jsonObject,
                                      const QString&     expectedFileType,
                                      int                minSupportedVersion,
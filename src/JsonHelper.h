@@ -30,6 +30,13 @@ public:
                            QJsonDocument&       jsonDoc,        ///< returned json document
                            QString&             errorString);   ///< error on parse failure
 
+    /// Reads and parses a json file. Resource files (":/...") can't change while running, so these are parsed once and
+    /// later calls return the shared document. Safe to call from any thread.
+    /// @return true: success, false: errorString set
+    static bool openJsonFile(const QString&    jsonFilename,   ///< file to open
+                             QJsonDocument&    jsonDoc,        ///< returned json document
+                             QString&          errorString);   ///< error on open or parse failure
+
     /// Saves the standard file header the json object
     static void saveQGCJsonFileHeader(QJsonObject&      jsonObject, ///< root json object
                                       const QString&    fileType,   ///< file type for file
@@ -11,6 +11,11 @@
 
 #include <QFile>
 #include <QVariant>
+#include <QRegularExpression>
+#include <QXmlStreamReader>
+#include <QtDebug>
+
+#include <algorithm>
 
 const char* KMLFileHelper::_errorPrefix = QT_TR_NOOP("KML file load failed. %1");
 
@@ -100,23 +105,7 @@ bool KMLFileHelper::loadPolygonFromFile(const QString& kmlFile, QList<QGeoCoordi
         rgCoords.append(coord);
     }
 
-    // Determine winding, reverse if needed. QGC wants clockwise winding
-    double sum = 0;
-    for (int i=0; i<rgCoords.count(); i++) {
-        QGeoCoordinate coord1 = rgCoords[i];
-        QGeoCoordinate coord2 = (i == rgCoords.count() - 1) ? rgCoords[0] : rgCoords[i+1];
-
-        sum += (coord2.longitude() - coord1.longitude()) * (coord2.latitude() + coord1.latitude());
-    }
-    bool reverse = sum < 0.0;
-    if (reverse) {
-        QList<QGeoCoordinate> rgReversed;
-
-        for (int i=0; i<rgCoords.count(); i++) {
-            rgReversed.prepend(rgCoords[i]);
-        }
-        rgCoords = rgReversed;
-    }
+    _makeClockwise(rgCoords);
 
     vertices = rgCoords;
 
@@ -165,3 +154,175 @@ bool KMLFileHelper::loadPolylineFromFile(const QString& kmlFile, QList<QGeoCoord
 
     return true;
 }
+
+/// Determine winding, reverse if needed. QGC wants clockwise winding
+void KMLFileHelper::_makeClockwise(QList<QGeoCoordinate>& vertices)
+{
+    double sum = 0;
+    for (int i=0; i<vertices.count(); i++) {
+        const QGeoCoordinate& coord1 = vertices[i];
+        const QGeoCoordinate& coord2 = (i == vertices.count() - 1) ? vertices[0] : vertices[i+1];
+
+        sum += (coord2.longitude() - coord1.longitude()) * (coord2.latitude() + coord1.latitude());
+    }
+    if (sum < 0.0) {
+        std::reverse(vertices.begin(), vertices.end());
+    }
+}
+
+/// Parses the contents of a KML coordinates element: whitespace separated lon,lat[,alt] tuples
+///     @return false: coordinates string is malformed
+bool KMLFileHelper::_parseCoordinates(const QString& coordinatesString, QList<QGeoCoordinate>& coords)
+{
+    coords.clear();
+
+    const QStringList rgCoordinateStrings = coordinatesString.split(QRegularExpression(QStringLiteral("\\s+")), QString::SkipEmptyParts);
+    coords.reserve(rgCoordinateStrings.count());
+    for (const QString& coordinateString: rgCoordinateStrings) {
+        const QStringList rgValueStrings = coordinateString.split(QLatin1Char(','));
+        if (rgValueStrings.count() < 2) {
+            return false;
+        }
+
+        bool lonOk, latOk;
+        QGeoCoordinate coord;
+        coord.setLongitude(rgValueStrings[0].toDouble(&lonOk));
+        coord.setLatitude(rgValueStrings[1].toDouble(&latOk));
+        if (!lonOk || !latOk) {
+            return false;
+        }
+
+        coords.append(coord);
+    }
+
+    return true;
+}
+
+bool KMLFileHelper::loadFeaturesFromFile(const QString& kmlFile, ShapeFileHelper::Features_t& features, QString& errorString, const ShapeFileHelper::ProgressFunc_t& progress, const ShapeFileHelper::CancelledFunc_t& cancelled)
+{
+    QFile file(kmlFile);
+
+    errorString.clear();
+    features.clear();
+
+    if (!file.exists()) {
+        errorString = QString(_errorPrefix).arg(tr("File not found: %1").arg(kmlFile));
+        return false;
+    }
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorString = QString(_errorPrefix).arg(tr("Unable to open file: %1 error: $%2").arg(kmlFile).arg(file.errorString()));
+        return false;
+    }
+
+    const double    fileSize = qMax(file.size(), static_cast<qint64>(1));
+    int             tokenCount = 0;
+    int             skippedCount = 0;
+    bool            inPlacemark = false;
+    QString         dataName;           // Name of the ExtendedData Data element being read
+    QVariantMap     attributes;         // Attributes of the current placemark
+    QStringList     elementStack;       // Open elements below the current one
+
+    // A placemark's geometry can come before its attributes, so features are only completed at the end of the placemark
+    ShapeFileHelper::Features_t placemarkFeatures;
+
+    QXmlStreamReader xml(&file);
+    while (!xml.atEnd()) {
+        xml.readNext();
+
+        if (progress && ++tokenCount % _tokensPerProgressUpdate == 0) {
+            progress(file.pos() / fileSize);
+        }
+
+        if (xml.isStartElement()) {
+            const QStringRef name = xml.name();
+
+            if (name == QLatin1String("Placemark")) {
+                if (cancelled && cancelled()) {
+                    errorString = QString(_errorPrefix).arg(tr("Load cancelled."));
+                    features.clear();
+                    return false;
+                }
+                inPlacemark = true;
+                attributes.clear();
+                placemarkFeatures.clear();
+            } else if (inPlacemark) {
+                const QString parent = elementStack.isEmpty() ? QString() : elementStack.last();
+
+                if (name == QLatin1String("coordinates")) {
+                    bool polygon    = parent == QLatin1String("LinearRing") && elementStack.count() > 1 && elementStack[elementStack.count() - 2] == QLatin1String("outerBoundaryIs");
+                    bool polyline   = parent == QLatin1String("LineString");
+                    QString text    = xml.readElementText();
+
+                    if (polygon || polyline) {
+                        ShapeFileHelper::Feature feature;
+                        feature.type = polygon ? ShapeFileHelper::Polygon : ShapeFileHelper::Polyline;
+                        bool valid = _parseCoordinates(text, feature.coordinates);
+                        if (valid && polygon) {
+                            // Rings are closed by repeating the first vertex
+                            if (feature.coordinates.count() > 1 && feature.coordinates.first() == feature.coordinates.last()) {
+                                feature.coordinates.removeLast();
+                            }
+                            valid = feature.coordinates.count() >= 3;
+                            _makeClockwise(feature.coordinates);
+                        } else if (valid) {
+                            valid = feature.coordinates.count() >= 2;
+                        }
+                        if (valid) {
+                            placemarkFeatures.append(feature);
+                        } else {
+                            skippedCount++;
+                        }
+                    }
+                    continue;
+                } else if ((name == QLatin1String("name") || name == QLatin1String("description")) && parent == QLatin1String("Placemark")) {
+                    attributes[name.toString()] = xml.readElementText(QXmlStreamReader::IncludeChildElements).trimmed();
+                    continue;
+                } else if (name == QLatin1String("Data")) {
+                    dataName = xml.attributes().value(QStringLiteral("name")).toString();
+                } else if (name == QLatin1String("value") && parent == QLatin1String("Data")) {
+                    attributes[dataName] = xml.readElementText(QXmlStreamReader::IncludeChildElements).trimmed();
+                    continue;
+                } else if (name == QLatin1String("SimpleData")) {
+                    QString simpleDataName = xml.attributes().value(QStringLiteral("name")).toString();
+                    attributes[simpleDataName] = xml.readElementText(QXmlStreamReader::IncludeChildElements).trimmed();
+                    continue;
+                }
+            }
+
+            elementStack.append(name.toString());
+        } else if (xml.isEndElement()) {
+            if (!elementStack.isEmpty()) {
+                elementStack.removeLast();
+            }
+            if (inPlacemark && xml.name() == QLatin1String("Placemark")) {
+                inPlacemark = false;
+                for (ShapeFileHelper::Feature& feature: placemarkFeatures) {
+                    feature.attributes = attributes;
+                }
+                features.append(placemarkFeatures);
+            }
+        }
+    }
+
+    if (xml.hasError()) {
+        errorString = QString(_errorPrefix).arg(tr("Unable to parse KML file: %1 error: %2 line: %3").arg(kmlFile).arg(xml.errorString()).arg(xml.lineNumber()));
+        features.clear();
+        return false;
+    }
+
+    if (skippedCount) {
+        qWarning() << "KMLFileHelper::loadFeaturesFromFile skipped invalid geometries" << skippedCount;
+    }
+
+    if (features.isEmpty()) {
+        errorString = QString(_errorPrefix).arg(tr("No supported type found in KML file."));
+        return false;
+    }
+
+    if (progress) {
+        progress(1.0);
+    }
+
+    return true;
+}
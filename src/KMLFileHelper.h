@@ -25,8 +25,16 @@ public:
     static bool loadPolygonFromFile(const QString& kmlFile, QList<QGeoCoordinate>& vertices, QString& errorString);
     static bool loadPolylineFromFile(const QString& kmlFile, QList<QGeoCoordinate>& coords, QString& errorString);
 
+    /// Streams the file, returning the outer boundary of every Polygon and every LineString. Placemark name, description
+    /// and ExtendedData values are returned as the feature attributes.
+    static bool loadFeaturesFromFile(const QString& kmlFile, ShapeFileHelper::Features_t& features, QString& errorString, const ShapeFileHelper::ProgressFunc_t& progress, const ShapeFileHelper::CancelledFunc_t& cancelled);
+
 private:
-    static QDomDocument _loadFile(const QString& kmlFile, QString& errorString);
+    static QDomDocument _loadFile           (const QString& kmlFile, QString& errorString);
+    static bool         _parseCoordinates   (const QString& coordinatesString, QList<QGeoCoordinate>& coords);
+    static void         _makeClockwise      (QList<QGeoCoordinate>& vertices);
 
     static const char* _errorPrefix;
+
+    static const int _tokensPerProgressUpdate = 1000;
 };
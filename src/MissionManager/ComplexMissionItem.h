@@ -65,6 +65,10 @@ public:
     ///     Empty string signals no support for presets.
     virtual QString presetsSettingsGroup(void) { return QString(); }
 
+    /// Completes any contents which are still being built in the background. The item count and lastSequenceNumber are only
+    /// final once this returns, so it is called before sequence numbers are assigned for saving or sending the mission.
+    virtual void completePendingWork(void) { }
+
     bool presetsSupported   (void) { return !presetsSettingsGroup().isEmpty(); }
     bool isIncomplete       (void) const { return _isIncomplete; }
 
@@ -23,6 +23,7 @@
 #include "PlanMasterController.h"
 #include "SettingsManager.h"
 #include "AppSettings.h"
+#include "ShapeFileImporter.h"
 
 #include <QJsonDocument>
 #include <QJsonArray>
@@ -441,6 +442,33 @@ void GeoFenceController::addInclusionPolygon(QGeoCoordinate topLeft, QGeoCoordin
     polygon->setInteractive(true);
 }
 
+int GeoFenceController::addInclusionPolygonsFromShapeImport(ShapeFileImporter* importer)
+{
+    if (!importer || importer->running()) {
+        qWarning() << "Internal error: Import not available";
+        return 0;
+    }
+
+    // Polygons are added to the model as a single batch
+    QList<QObject*> polygons;
+    for (const ShapeFileHelper::Feature& feature: importer->features()) {
+        if (feature.type == ShapeFileHelper::Polygon) {
+            QGCFencePolygon* polygon = new QGCFencePolygon(true /* inclusion */, this);
+            polygon->appendVertices(feature.coordinates);
+            polygons.append(polygon);
+        }
+    }
+
+    if (!polygons.isEmpty()) {
+        _polygons.append(polygons);
+        clearAllInteractive();
+    }
+
+    qCDebug(GeoFenceControllerLog) << "addInclusionPolygonsFromShapeImport" << polygons.count();
+
+    return polygons.count();
+}
+
 void GeoFenceController::addInclusionCircle(QGeoCoordinate topLeft, QGeoCoordinate bottomRight)
 {
     QGeoCoordinate topRight(topLeft.latitude(), bottomRight.longitude());
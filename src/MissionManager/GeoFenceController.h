@@ -21,6 +21,7 @@
 Q_DECLARE_LOGGING_CATEGORY(GeoFenceControllerLog)
 
 class GeoFenceManager;
+class ShapeFileImporter;
 
 class GeoFenceController : public PlanElementController
 {
@@ -48,6 +49,11 @@ public:
     ///     @param bottomRight: Bottom right left coordinate or map viewport
     Q_INVOKABLE void addInclusionCircle(QGeoCoordinate topLeft, QGeoCoordinate bottomRight);
 
+    /// Add an inclusion polygon for each polygon of a finished import
+    ///     @param importer: Import to create the polygons from
+    /// @return Number of polygons added
+    Q_INVOKABLE int addInclusionPolygonsFromShapeImport(ShapeFileImporter* importer);
+
     /// Deletes the specified polygon from the polygon list
     ///     @param index: Index of poygon to delete
     Q_INVOKABLE void deletePolygon(int index);
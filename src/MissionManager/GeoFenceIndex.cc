@@ -0,0 +1,347 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "GeoFenceIndex.h"
+
+#include <QtMath>
+
+#include <algorithm>
+#include <limits>
+
+static const double _metersPerDegreeLat = 111319.49;
+
+GeoFenceIndex::GeoFenceIndex(void)
+    : _hasInclusion         (false)
+    , _cellSize             (1)
+    , _columns              (0)
+    , _rows                 (0)
+    , _refLatitude          (0)
+    , _refLongitude         (0)
+    , _metersPerDegreeLon   (_metersPerDegreeLat)
+{
+
+}
+
+void GeoFenceIndex::clear(void)
+{
+    _fences.clear();
+    _edges.clear();
+    _cellStart.clear();
+    _cellEdges.clear();
+    _circleFences.clear();
+    _hasInclusion   = false;
+    _columns        = 0;
+    _rows           = 0;
+}
+
+void GeoFenceIndex::addPolygon(const QList<QGeoCoordinate>& vertices, bool inclusion)
+{
+    Fence fence;
+
+    fence.inclusion = inclusion;
+    fence.circle    = false;
+    fence.vertices  = vertices;
+    fence.radius    = 0;
+    _fences.append(fence);
+}
+
+void GeoFenceIndex::addCircle(const QGeoCoordinate& center, double radius, bool inclusion)
+{
+    Fence fence;
+
+    fence.inclusion = inclusion;
+    fence.circle    = true;
+    fence.geoCenter = center;
+    fence.radius    = radius;
+    _fences.append(fence);
+}
+
+QPointF GeoFenceIndex::_toLocal(const QGeoCoordinate& coord) const
+{
+    return QPointF((coord.longitude() - _refLongitude) * _metersPerDegreeLon, (coord.latitude() - _refLatitude) * _metersPerDegreeLat);
+}
+
+int GeoFenceIndex::_cellColumn(double x) const
+{
+    return qBound(0, static_cast<int>(qFloor((x - _gridBounds.left()) / _cellSize)), _columns - 1);
+}
+
+int GeoFenceIndex::_cellRow(double y) const
+{
+    return qBound(0, static_cast<int>(qFloor((y - _gridBounds.top()) / _cellSize)), _rows - 1);
+}
+
+template<typename Visitor>
+void GeoFenceIndex::_visitSegmentCells(const QPointF& a, const QPointF& b, Visitor visitor) const
+{
+    int firstRow    = _cellRow(qMin(a.y(), b.y()));
+    int lastRow     = _cellRow(qMax(a.y(), b.y()));
+    double dy       = b.y() - a.y();
+
+    for (int row=firstRow; row<=lastRow; row++) {
+        // Clip the segment to the horizontal band of this row to find the columns it passes through
+        double minX, maxX;
+        if (firstRow == lastRow || qFuzzyIsNull(dy)) {
+            minX = qMin(a.x(), b.x());
+            maxX = qMax(a.x(), b.x());
+        } else {
+            double bandLow  = row == firstRow ? qMin(a.y(), b.y()) : _gridBounds.top() + row * _cellSize;
+            double bandHigh = row == lastRow ? qMax(a.y(), b.y()) : _gridBounds.top() + (row + 1) * _cellSize;
+            double x1       = a.x() + (bandLow - a.y()) * (b.x() - a.x()) / dy;
+            double x2       = a.x() + (bandHigh - a.y()) * (b.x() - a.x()) / dy;
+            minX = qMin(x1, x2);
+            maxX = qMax(x1, x2);
+        }
+
+        int lastColumn = _cellColumn(maxX);
+        for (int column=_cellColumn(minX); column<=lastColumn; column++) {
+            visitor(row * _columns + column);
+        }
+    }
+}
+
+void GeoFenceIndex::build(void)
+{
+    _edges.clear();
+    _cellStart.clear();
+    _cellEdges.clear();
+    _circleFences.clear();
+    _hasInclusion   = false;
+    _columns        = 0;
+    _rows           = 0;
+
+    // Local plane is centered on the fences
+    double north = -90, south = 90, east = -180, west = 180;
+    for (const Fence& fence: _fences) {
+        const QList<QGeoCoordinate> coords = fence.circle ? QList<QGeoCoordinate>({ fence.geoCenter }) : fence.vertices;
+        for (const QGeoCoordinate& coord: coords) {
+            north   = qMax(north, coord.latitude());
+            south   = qMin(south, coord.latitude());
+            east    = qMax(east, coord.longitude());
+            west    = qMin(west, coord.longitude());
+        }
+    }
+    if (north < south) {
+        return;
+    }
+    _refLatitude        = (north + south) / 2.0;
+    _refLongitude       = (east + west) / 2.0;
+    _metersPerDegreeLon = _metersPerDegreeLat * qCos(qDegreesToRadians(_refLatitude));
+
+    QRectF edgeBounds;
+    bool   haveEdgeBounds = false;
+    for (int i=0; i<_fences.count(); i++) {
+        Fence& fence = _fences[i];
+
+        _hasInclusion |= fence.inclusion;
+
+        if (fence.circle) {
+            fence.center    = _toLocal(fence.geoCenter);
+            fence.bounds    = QRectF(fence.center.x() - fence.radius, fence.center.y() - fence.radius, fence.radius * 2, fence.radius * 2);
+            _circleFences.append(i);
+            continue;
+        }
+
+        if (fence.vertices.count() < 3) {
+            fence.bounds = QRectF();
+            continue;
+        }
+
+        QPointF first   = _toLocal(fence.vertices.first());
+        QPointF prev    = first;
+        double  minX    = first.x(), maxX = first.x(), minY = first.y(), maxY = first.y();
+        for (int j=1; j<=fence.vertices.count(); j++) {
+            QPointF next = j == fence.vertices.count() ? first : _toLocal(fence.vertices[j]);
+            _edges.append({ prev, next, i });
+            minX = qMin(minX, next.x());
+            maxX = qMax(maxX, next.x());
+            minY = qMin(minY, next.y());
+            maxY = qMax(maxY, next.y());
+            prev = next;
+        }
+        fence.bounds = QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+        if (haveEdgeBounds) {
+            edgeBounds = QRectF(QPointF(qMin(edgeBounds.left(), minX), qMin(edgeBounds.top(), minY)), QPointF(qMax(edgeBounds.right(), maxX), qMax(edgeBounds.bottom(), maxY)));
+        } else {
+            edgeBounds      = fence.bounds;
+            haveEdgeBounds  = true;
+        }
+    }
+
+    if (_edges.isEmpty()) {
+        return;
+    }
+
+    // Aim for a couple of cells per edge so most cells hold only a few edges
+    _gridBounds = QRectF(edgeBounds.topLeft(), QSizeF(qMax(edgeBounds.width(), 1.0), qMax(edgeBounds.height(), 1.0)));
+    int cellTarget = qBound(1, _edges.count() * 2, _maxCells);
+    _cellSize   = qSqrt(_gridBounds.width() * _gridBounds.height() / cellTarget);
+    _columns    = qMax(1, static_cast<int>(qCeil(_gridBounds.width() / _cellSize)));
+    _rows       = qMax(1, static_cast<int>(qCeil(_gridBounds.height() / _cellSize)));
+
+    // Two passes: count the edges in each cell, then fill
+    _cellStart.fill(0, _columns * _rows + 1);
+    for (const Edge& edge: _edges) {
+        _visitSegmentCells(edge.a, edge.b, [this](int cell) { _cellStart[cell + 1]++; });
+    }
+    for (int cell=0; cell<_columns * _rows; cell++) {
+        _cellStart[cell + 1] += _cellStart[cell];
+    }
+    _cellEdges.resize(_cellStart.last());
+    QVector<int> fill = _cellStart;
+    for (int i=0; i<_edges.count(); i++) {
+        _visitSegmentCells(_edges[i].a, _edges[i].b, [this, &fill, i](int cell) { _cellEdges[fill[cell]++] = i; });
+    }
+}
+
+void GeoFenceIndex::_containingFences(const QPointF& point, InsideFlags_t& inside) const
+{
+    inside.resize(_fences.count());
+    std::fill(inside.begin(), inside.end(), false);
+
+    if (_columns && _gridBounds.contains(point)) {
+        // Ray cast east along the row holding the point. A crossing is only counted in the cell which holds the crossing
+        // point, so edges bucketed into more than one cell of the row are not counted twice.
+        int row = _cellRow(point.y());
+        for (int column=_cellColumn(point.x()); column<_columns; column++) {
+            int cell = row * _columns + column;
+            for (int i=_cellStart[cell]; i<_cellStart[cell + 1]; i++) {
+                const Edge& edge = _edges[_cellEdges[i]];
+                if ((edge.a.y() > point.y()) == (edge.b.y() > point.y())) {
+                    continue;
+                }
+                if (!_fences[edge.fenceIndex].bounds.contains(point)) {
+                    continue;
+                }
+                double crossingX = edge.a.x() + (point.y() - edge.a.y()) * (edge.b.x() - edge.a.x()) / (edge.b.y() - edge.a.y());
+                if (crossingX > point.x() && _cellColumn(crossingX) == column) {
+                    inside[edge.fenceIndex] = !inside[edge.fenceIndex];
+                }
+            }
+        }
+    }
+
+    for (int fenceIndex: _circleFences) {
+        const Fence& fence = _fences[fenceIndex];
+        QPointF offset = point - fence.center;
+        inside[fenceIndex] = QPointF::dotProduct(offset, offset) <= fence.radius * fence.radius;
+    }
+}
+
+bool GeoFenceIndex::_isBreached(const QPointF& point, int* fenceIndex) const
+{
+    InsideFlags_t   inside;
+    bool            insideInclusion = false;
+
+    _containingFences(point, inside);
+
+    for (int i=0; i<_fences.count(); i++) {
+        if (inside[i]) {
+            if (!_fences[i].inclusion) {
+                *fenceIndex = i;
+                return true;
+            }
+            insideInclusion = true;
+        }
+    }
+
+    *fenceIndex = -1;
+    return _hasInclusion && !insideInclusion;
+}
+
+void GeoFenceIndex::_segmentCrossings(const QPointF& from, const QPointF& to, QVector<double>& crossings) const
+{
+    QPointF direction = to - from;
+
+    crossings.clear();
+
+    bool overlapsGrid = _columns &&
+            qMax(from.x(), to.x()) >= _gridBounds.left() && qMin(from.x(), to.x()) <= _gridBounds.right() &&
+            qMax(from.y(), to.y()) >= _gridBounds.top() && qMin(from.y(), to.y()) <= _gridBounds.bottom();
+    if (overlapsGrid) {
+        _visitSegmentCells(from, to, [&](int cell) {
+            for (int i=_cellStart[cell]; i<_cellStart[cell + 1]; i++) {
+                const Edge& edge    = _edges[_cellEdges[i]];
+                QPointF     edgeDir = edge.b - edge.a;
+                double      denom   = direction.x() * edgeDir.y() - direction.y() * edgeDir.x();
+                if (qFuzzyIsNull(denom)) {
+                    continue;
+                }
+                QPointF offset  = edge.a - from;
+                double  t       = (offset.x() * edgeDir.y() - offset.y() * edgeDir.x()) / denom;
+                double  u       = (offset.x() * direction.y() - offset.y() * direction.x()) / denom;
+                if (t >= 0 && t <= 1 && u >= 0 && u <= 1) {
+                    crossings.append(t);
+                }
+            }
+        });
+    }
+
+    double a = QPointF::dotProduct(direction, direction);
+    for (int fenceIndex: _circleFences) {
+        const Fence& fence  = _fences[fenceIndex];
+        QPointF     offset  = from - fence.center;
+        double      b       = 2 * QPointF::dotProduct(offset, direction);
+        double      c       = QPointF::dotProduct(offset, offset) - fence.radius * fence.radius;
+        double      disc    = b * b - 4 * a * c;
+        if (disc < 0 || qFuzzyIsNull(a)) {
+            continue;
+        }
+        double root = qSqrt(disc);
+        for (double t: { (-b - root) / (2 * a), (-b + root) / (2 * a) }) {
+            if (t >= 0 && t <= 1) {
+                crossings.append(t);
+            }
+        }
+    }
+
+    std::sort(crossings.begin(), crossings.end());
+}
+
+GeoFenceIndex::Check GeoFenceIndex::check(const QGeoCoordinate& position, double velocityNorth, double velocityEast, double lookaheadSecs) const
+{
+    Check result = { NoBreach, -1, std::numeric_limits<double>::quiet_NaN() };
+
+    if (_fences.isEmpty() || !position.isValid()) {
+        return result;
+    }
+
+    QPointF point = _toLocal(position);
+    if (_isBreached(point, &result.fenceIndex)) {
+        result.state            = Breached;
+        result.secondsToBreach  = 0;
+        return result;
+    }
+
+    if (lookaheadSecs <= 0 || (qFuzzyIsNull(velocityNorth) && qFuzzyIsNull(velocityEast))) {
+        return result;
+    }
+
+    // The breach state only changes where the projected track crosses a fence boundary, so check the track just past
+    // each crossing until one leaves the vehicle breached
+    QPointF         projected = point + QPointF(velocityEast, velocityNorth) * lookaheadSecs;
+    QVector<double> crossings;
+    _segmentCrossings(point, projected, crossings);
+    for (int i=0; i<crossings.count(); i++) {
+        double next = i == crossings.count() - 1 ? 1.0 : crossings[i + 1];
+        if (next - crossings[i] < 1e-9) {
+            continue;
+        }
+        QPointF after = point + (projected - point) * ((crossings[i] + next) / 2.0);
+        int fenceIndex;
+        if (_isBreached(after, &fenceIndex)) {
+            result.state            = BreachPredicted;
+            result.fenceIndex       = fenceIndex;
+            result.secondsToBreach  = crossings[i] * lookaheadSecs;
+            return result;
+        }
+    }
+
+    return result;
+}
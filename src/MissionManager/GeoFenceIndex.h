@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QGeoCoordinate>
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+#include <QVarLengthArray>
+#include <QVector>
+
+/// Spatial index over a set of inclusion and exclusion fences used to check vehicle positions against them.
+///
+/// Fences are projected onto a local plane around the center of all fences. Each fence keeps its bounding box and all
+/// polygon edges are bucketed into a uniform grid, so a check only looks at the edges near the vehicle no matter how many
+/// fences there are. Containment uses a ray cast along the grid row of the position. Breach prediction walks the cells
+/// covered by the projected velocity vector and reports the first boundary crossing which leaves the vehicle breached.
+///
+/// A position is breached if it is inside any exclusion fence, or if there are inclusion fences and it is not inside any
+/// of them. Fences are 2D only. Fence sets which cross the anti-meridian are not supported.
+class GeoFenceIndex
+{
+public:
+    enum BreachState {
+        NoBreach,
+        BreachPredicted,    ///< Projected velocity vector leads to a breach
+        Breached,           ///< Position is currently breached
+    };
+
+    struct Check {
+        BreachState state;
+        int         fenceIndex;         ///< Fence which is breached, -1 for none or when outside of all inclusion fences
+        double      secondsToBreach;    ///< Time to breach for BreachPredicted, 0 for Breached, NaN for NoBreach
+    };
+
+    GeoFenceIndex(void);
+
+    void clear(void);
+
+    /// Fences are numbered in the order they are added, polygons and circles share the numbering
+    void addPolygon (const QList<QGeoCoordinate>& vertices, bool inclusion);
+    void addCircle  (const QGeoCoordinate& center, double radius, bool inclusion);
+
+    /// Builds the projection and edge grid. Must be called after fences are added and before check is used.
+    void build(void);
+
+    int fenceCount(void) const { return _fences.count(); }
+
+    /// Checks a vehicle position against the fences
+    ///     @param velocityNorth Ground velocity north in m/s
+    ///     @param velocityEast Ground velocity east in m/s
+    ///     @param lookaheadSecs How far ahead along the velocity vector to predict breaches, 0 to only check the position
+    Check check(const QGeoCoordinate& position, double velocityNorth, double velocityEast, double lookaheadSecs) const;
+
+private:
+    struct Fence {
+        bool                    inclusion;
+        bool                    circle;
+        QList<QGeoCoordinate>   vertices;       ///< Polygon only
+        QGeoCoordinate          geoCenter;      ///< Circle only
+        double                  radius;         ///< Circle only
+        QPointF                 center;         ///< Circle only, local plane
+        QRectF                  bounds;         ///< Local plane, x east, y north
+    };
+
+    typedef QVarLengthArray<bool, 256> InsideFlags_t;   ///< Per fence, avoids allocating for a typical number of fences
+
+    struct Edge {
+        QPointF a;
+        QPointF b;
+        int     fenceIndex;
+    };
+
+    QPointF _toLocal                (const QGeoCoordinate& coord) const;
+    bool    _isBreached             (const QPointF& point, int* fenceIndex) const;
+    void    _containingFences       (const QPointF& point, InsideFlags_t& inside) const;
+    void    _segmentCrossings       (const QPointF& from, const QPointF& to, QVector<double>& crossings) const;
+    int     _cellColumn             (double x) const;
+    int     _cellRow                (double y) const;
+
+    /// Calls visitor with the index of every grid cell the segment passes through
+    template<typename Visitor>
+    void    _visitSegmentCells      (const QPointF& a, const QPointF& b, Visitor visitor) const;
+
+    QVector<Fence>                  _fences;
+    QVector<Edge>                   _edges;
+    QVector<int>                    _cellStart;         ///< Index into _cellEdges of the first edge for each cell, one extra entry at the end
+    QVector<int>                    _cellEdges;         ///< Edge indices bucketed by cell
+    QVector<int>                    _circleFences;      ///< Circle fences are checked directly
+    bool                            _hasInclusion;
+    QRectF                          _gridBounds;
+    double                          _cellSize;
+    int                             _columns;
+    int                             _rows;
+    double                          _refLatitude;
+    double                          _refLongitude;
+    double                          _metersPerDegreeLon;
+
+    static const int _maxCells = 1 << 18;
+};
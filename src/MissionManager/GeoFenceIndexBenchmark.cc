@@ -0,0 +1,45 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "GeoFenceIndexBenchmark.h"
+#include "GeoFenceIndexTest.h"
+#include "GeoFenceIndex.h"
+
+#include <QtMath>
+
+void GeoFenceIndexBenchmark::_checksPerSecond(void)
+{
+    const int           cFenceCount     = 500;
+    const int           cVehicleCount   = 50;
+    GeoFenceIndex       index;
+
+    qsrand(2);
+
+    // Exclusion zones scattered inside one large inclusion fence
+    index.addPolygon(GeoFenceIndexTest::squarePolygon(GeoFenceIndexTest::origin, 20000), true /* inclusion */);
+    for (int i=1; i<cFenceCount; i++) {
+        index.addPolygon(GeoFenceIndexTest::randomPolygon(GeoFenceIndexTest::origin.atDistanceAndAzimuth(18000.0 * qrand() / RAND_MAX, 360.0 * qrand() / RAND_MAX), 500), false /* inclusion */);
+    }
+    index.build();
+
+    QList<QGeoCoordinate>   positions;
+    QList<QPointF>          velocities;
+    for (int i=0; i<cVehicleCount; i++) {
+        double heading = qDegreesToRadians(360.0 * qrand() / RAND_MAX);
+        positions.append(GeoFenceIndexTest::origin.atDistanceAndAzimuth(20000.0 * qrand() / RAND_MAX, 360.0 * qrand() / RAND_MAX));
+        velocities.append(QPointF(15 * qCos(heading), 15 * qSin(heading)));
+    }
+
+    // One telemetry update for every vehicle, predicting 10 seconds ahead
+    QBENCHMARK {
+        for (int i=0; i<cVehicleCount; i++) {
+            index.check(positions[i], velocities[i].x(), velocities[i].y(), 10);
+        }
+    }
+}
@@ -0,0 +1,21 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Measures vehicle position checks against a large fence set. The results are checked by GeoFenceIndexTest.
+class GeoFenceIndexBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _checksPerSecond(void);
+};
@@ -0,0 +1,171 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "GeoFenceIndexTest.h"
+
+#include <QtMath>
+
+const QGeoCoordinate GeoFenceIndexTest::origin(47.3977419, 8.5455938);
+
+QList<QGeoCoordinate> GeoFenceIndexTest::squarePolygon(const QGeoCoordinate& center, double halfSide)
+{
+    double                  halfDiagonal = halfSide * M_SQRT2;
+    QList<QGeoCoordinate>   polygon;
+
+    // Clockwise from north west
+    polygon << center.atDistanceAndAzimuth(halfDiagonal, 315)
+            << center.atDistanceAndAzimuth(halfDiagonal, 45)
+            << center.atDistanceAndAzimuth(halfDiagonal, 135)
+            << center.atDistanceAndAzimuth(halfDiagonal, 225);
+    return polygon;
+}
+
+QList<QGeoCoordinate> GeoFenceIndexTest::randomPolygon(const QGeoCoordinate& center, double maxRadius)
+{
+    int                     vertexCount = 3 + qrand() % 40;
+    QList<QGeoCoordinate>   polygon;
+
+    for (int i=0; i<vertexCount; i++) {
+        double radius = maxRadius * (0.1 + 0.9 * qrand() / RAND_MAX);
+        polygon.append(center.atDistanceAndAzimuth(radius, 360.0 * i / vertexCount));
+    }
+    return polygon;
+}
+
+bool GeoFenceIndexTest::_bruteForceContains(const QList<QGeoCoordinate>& polygon, const QGeoCoordinate& coord)
+{
+    bool inside = false;
+
+    for (int i=0, j=polygon.count()-1; i<polygon.count(); j=i++) {
+        const QGeoCoordinate& a = polygon[i];
+        const QGeoCoordinate& b = polygon[j];
+        if ((a.latitude() > coord.latitude()) != (b.latitude() > coord.latitude()) &&
+                coord.longitude() < (b.longitude() - a.longitude()) * (coord.latitude() - a.latitude()) / (b.latitude() - a.latitude()) + a.longitude()) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+void GeoFenceIndexTest::_inclusionExclusion(void)
+{
+    GeoFenceIndex index;
+
+    // No fences is never a breach
+    index.build();
+    QCOMPARE(index.check(origin, 0, 0, 0).state, GeoFenceIndex::NoBreach);
+
+    // 1km square inclusion with a 100m square exclusion in the middle
+    index.addPolygon(squarePolygon(origin, 500), true /* inclusion */);
+    index.addPolygon(squarePolygon(origin, 50), false /* inclusion */);
+    index.build();
+    QCOMPARE(index.fenceCount(), 2);
+
+    GeoFenceIndex::Check check = index.check(origin.atDistanceAndAzimuth(200, 0), 0, 0, 0);
+    QCOMPARE(check.state, GeoFenceIndex::NoBreach);
+    QVERIFY(qIsNaN(check.secondsToBreach));
+
+    check = index.check(origin, 0, 0, 0);
+    QCOMPARE(check.state, GeoFenceIndex::Breached);
+    QCOMPARE(check.fenceIndex, 1);
+    QCOMPARE(check.secondsToBreach, 0.0);
+
+    // Outside of all inclusion fences
+    check = index.check(origin.atDistanceAndAzimuth(600, 90), 0, 0, 0);
+    QCOMPARE(check.state, GeoFenceIndex::Breached);
+    QCOMPARE(check.fenceIndex, -1);
+
+    // Inside any one inclusion fence is enough
+    index.addPolygon(squarePolygon(origin.atDistanceAndAzimuth(1000, 90), 500), true /* inclusion */);
+    index.build();
+    QCOMPARE(index.check(origin.atDistanceAndAzimuth(600, 90), 0, 0, 0).state, GeoFenceIndex::NoBreach);
+
+    index.clear();
+    index.build();
+    QCOMPARE(index.fenceCount(), 0);
+    QCOMPARE(index.check(origin, 0, 0, 0).state, GeoFenceIndex::NoBreach);
+}
+
+void GeoFenceIndexTest::_circleFences(void)
+{
+    GeoFenceIndex index;
+
+    index.addCircle(origin, 300, true /* inclusion */);
+    index.addCircle(origin.atDistanceAndAzimuth(200, 90), 50, false /* inclusion */);
+    index.build();
+
+    QCOMPARE(index.check(origin.atDistanceAndAzimuth(250, 0), 0, 0, 0).state,   GeoFenceIndex::NoBreach);
+    QCOMPARE(index.check(origin.atDistanceAndAzimuth(350, 0), 0, 0, 0).state,   GeoFenceIndex::Breached);
+    QCOMPARE(index.check(origin.atDistanceAndAzimuth(200, 90), 0, 0, 0).state,  GeoFenceIndex::Breached);
+    QCOMPARE(index.check(origin.atDistanceAndAzimuth(200, 90), 0, 0, 0).fenceIndex, 1);
+}
+
+void GeoFenceIndexTest::_breachPrediction(void)
+{
+    GeoFenceIndex index;
+
+    index.addPolygon(squarePolygon(origin, 500), true /* inclusion */);
+    index.addPolygon(squarePolygon(origin.atDistanceAndAzimuth(250, 0), 50), false /* inclusion */);
+    index.build();
+
+    // Flying east at 10m/s, 400m from the inclusion boundary
+    QGeoCoordinate position = origin.atDistanceAndAzimuth(100, 90);
+    GeoFenceIndex::Check check = index.check(position, 0, 10, 60);
+    QCOMPARE(check.state, GeoFenceIndex::BreachPredicted);
+    QCOMPARE(check.fenceIndex, -1);
+    QVERIFY(qAbs(check.secondsToBreach - 40.0) < 0.5);
+
+    // Boundary is past the lookahead
+    QCOMPARE(index.check(position, 0, 10, 30).state, GeoFenceIndex::NoBreach);
+
+    // Lookahead of 0 or no velocity only checks the position
+    QCOMPARE(index.check(position, 0, 10, 0).state, GeoFenceIndex::NoBreach);
+    QCOMPARE(index.check(position, 0, 0, 60).state, GeoFenceIndex::NoBreach);
+
+    // Flying north at 5m/s into the exclusion fence which starts 200m away
+    check = index.check(origin, 5, 0, 60);
+    QCOMPARE(check.state, GeoFenceIndex::BreachPredicted);
+    QCOMPARE(check.fenceIndex, 1);
+    QVERIFY(qAbs(check.secondsToBreach - 40.0) < 0.5);
+
+    // Flying from one inclusion fence into an overlapping one is not a breach
+    index.clear();
+    index.addPolygon(squarePolygon(origin, 500), true /* inclusion */);
+    index.addPolygon(squarePolygon(origin.atDistanceAndAzimuth(900, 90), 500), true /* inclusion */);
+    index.build();
+    QCOMPARE(index.check(origin, 0, 20, 60).state, GeoFenceIndex::NoBreach);
+}
+
+/// Random sets of overlapping concave fences must give the same containment result as checking every fence
+void GeoFenceIndexTest::_matchesBruteForce(void)
+{
+    qsrand(1);
+
+    for (int trial=0; trial<50; trial++) {
+        GeoFenceIndex                   index;
+        QList<QList<QGeoCoordinate>>    polygons;
+        int                             polygonCount = 1 + trial % 30;
+
+        for (int i=0; i<polygonCount; i++) {
+            QGeoCoordinate center = origin.atDistanceAndAzimuth(5000.0 * qrand() / RAND_MAX, 360.0 * qrand() / RAND_MAX);
+            polygons.append(randomPolygon(center, 2000));
+            index.addPolygon(polygons.last(), false /* inclusion */);
+        }
+        index.build();
+
+        for (int i=0; i<1000; i++) {
+            QGeoCoordinate  position    = origin.atDistanceAndAzimuth(8000.0 * qrand() / RAND_MAX, 360.0 * qrand() / RAND_MAX);
+            bool            inside      = false;
+            for (const QList<QGeoCoordinate>& polygon: polygons) {
+                inside |= _bruteForceContains(polygon, position);
+            }
+            QCOMPARE(index.check(position, 0, 0, 0).state == GeoFenceIndex::Breached, inside);
+        }
+    }
+}
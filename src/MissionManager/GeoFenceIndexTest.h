@@ -0,0 +1,37 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "GeoFenceIndex.h"
+
+/// Checks GeoFenceIndex containment and breach prediction results
+class GeoFenceIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    /// Square polygon with clockwise winding
+    static QList<QGeoCoordinate> squarePolygon(const QGeoCoordinate& center, double halfSide);
+
+    /// Star shaped polygon with a random radius at each vertex, so it is usually concave
+    static QList<QGeoCoordinate> randomPolygon(const QGeoCoordinate& center, double maxRadius);
+
+    static const QGeoCoordinate origin;
+
+private slots:
+    void _inclusionExclusion(void);
+    void _circleFences(void);
+    void _breachPrediction(void);
+    void _matchesBruteForce(void);
+
+private:
+    bool _bruteForceContains(const QList<QGeoCoordinate>& polygon, const QGeoCoordinate& coord);
+};
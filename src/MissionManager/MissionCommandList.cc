@@ -40,18 +40,10 @@ void MissionCommandList::_loadMavCmdInfoJson(const QString& jsonFilename, bool b
 
     qCDebug(MissionCommandsLog) << "Loading" << jsonFilename;
 
-    QFile jsonFile(jsonFilename);
-    if (!jsonFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Unable to open file" << jsonFilename << jsonFile.errorString();
-        return;
-    }
-
-    QByteArray bytes = jsonFile.readAll();
-    jsonFile.close();
-    QJsonParseError jsonParseError;
-    QJsonDocument doc = QJsonDocument::fromJson(bytes, &jsonParseError);
-    if (jsonParseError.error != QJsonParseError::NoError) {
-        qWarning() << jsonFilename << "Unable to open json document" << jsonParseError.errorString();
+    QString         errorString;
+    QJsonDocument   doc;
+    if (!JsonHelper::openJsonFile(jsonFilename, doc, errorString)) {
+        qWarning() << errorString;
         return;
     }
 
@@ -79,7 +71,6 @@ void MissionCommandList::_loadMavCmdInfoJson(const QString& jsonFilename, bool b
 
         MissionCommandUIInfo* uiInfo = new MissionCommandUIInfo(this);
 
-        QString errorString;
         if (!uiInfo->loadJsonInfo(info.toObject(), baseCommandList, errorString)) {
             uiInfo->deleteLater();
             qWarning() << jsonFilename << errorString;
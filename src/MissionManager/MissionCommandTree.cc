@@ -38,15 +38,15 @@ void MissionCommandTree::setToolbox(QGCToolbox* toolbox)
 #ifdef UNITTEST_BUILD
     if (_unitTest) {
         // Load unit testing tree
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GENERIC] =           new MissionCommandList(":/unittest/MavCmdInfoCommon.json", true, this);
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_FIXED_WING] =        new MissionCommandList(":/unittest/MavCmdInfoFixedWing.json", false, this);
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_QUADROTOR] =         new MissionCommandList(":/unittest/MavCmdInfoMultiRotor.json", false, this);
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_VTOL_QUADROTOR] =    new MissionCommandList(":/unittest/MavCmdInfoVTOL.json", false, this);
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_SUBMARINE] =         new MissionCommandList(":/unittest/MavCmdInfoSub.json", false, this);
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GROUND_ROVER] =      new MissionCommandList(":/unittest/MavCmdInfoRover.json", false, this);
+        _staticCommandFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GENERIC] =          QStringLiteral(":/unittest/MavCmdInfoCommon.json");
+        _staticCommandFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_FIXED_WING] =       QStringLiteral(":/unittest/MavCmdInfoFixedWing.json");
+        _staticCommandFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_QUADROTOR] =        QStringLiteral(":/unittest/MavCmdInfoMultiRotor.json");
+        _staticCommandFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_VTOL_QUADROTOR] =   QStringLiteral(":/unittest/MavCmdInfoVTOL.json");
+        _staticCommandFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_SUBMARINE] =        QStringLiteral(":/unittest/MavCmdInfoSub.json");
+        _staticCommandFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GROUND_ROVER] =     QStringLiteral(":/unittest/MavCmdInfoRover.json");
     } else {
 #endif
-        // Load all levels of hierarchy
+        // Record all levels of hierarchy, the command lists are loaded as vehicles need them
         for (MAV_AUTOPILOT firmwareType: _toolbox->firmwarePluginManager()->supportedFirmwareTypes()) {
             FirmwarePlugin* plugin = _toolbox->firmwarePluginManager()->firmwarePluginForAutopilot(firmwareType, MAV_TYPE_QUADROTOR);
 
@@ -56,13 +56,32 @@ void MissionCommandTree::setToolbox(QGCToolbox* toolbox)
             for(MAV_TYPE vehicleType: vehicleTypes) {
                 QString overrideFile = plugin->missionCommandOverrides(vehicleType);
                 if (!overrideFile.isEmpty()) {
-                    _staticCommandTree[firmwareType][vehicleType] = new MissionCommandList(overrideFile, firmwareType == MAV_AUTOPILOT_GENERIC && vehicleType == MAV_TYPE_GENERIC /* baseCommandList */, this);
+                    _staticCommandFiles[firmwareType][vehicleType] = overrideFile;
                 }
             }
         }
 #ifdef UNITTEST_BUILD
     }
 #endif
+
+    // The base list provides names for all commands so it is always needed
+    _commandList(MAV_AUTOPILOT_GENERIC, MAV_TYPE_GENERIC);
+}
+
+/// @return Command list for the level of the hierarchy, loading it on first use. nullptr if there is no list for the level.
+MissionCommandList* MissionCommandTree::_commandList(MAV_AUTOPILOT firmwareType, MAV_TYPE vehicleType)
+{
+    MissionCommandList* commandList = _staticCommandTree[firmwareType].value(vehicleType, nullptr);
+
+    if (!commandList) {
+        QString jsonFilename = _staticCommandFiles[firmwareType].value(vehicleType);
+        if (!jsonFilename.isEmpty()) {
+            commandList = new MissionCommandList(jsonFilename, firmwareType == MAV_AUTOPILOT_GENERIC && vehicleType == MAV_TYPE_GENERIC /* baseCommandList */, this);
+            _staticCommandTree[firmwareType][vehicleType] = commandList;
+        }
+    }
+
+    return commandList;
 }
 
 MAV_AUTOPILOT MissionCommandTree::_baseFirmwareType(MAV_AUTOPILOT firmwareType) const
@@ -105,6 +124,10 @@ void MissionCommandTree::_collapseHierarchy(Vehicle*
 
     _baseVehicleInfo(vehicle, baseFirmwareType, baseVehicleType);
 
+    if (!cmdList) {
+        return;
+    }
+
     for (MAV_CMD command: cmdList->commandIds()) {
         MissionCommandUIInfo* uiInfo = cmdList->getUIInfo(command);
         if (uiInfo) {
@@ -133,20 +156,20 @@ void MissionCommandTree::_buildAllCommands(Vehicle* vehicle)
     QMap<MAV_CMD, MissionCommandUIInfo*>& collapsedTree = _allCommands[baseFirmwareType][baseVehicleType];
 
     // Any Firmware, Any Vehicle
-    _collapseHierarchy(vehicle, _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GENERIC], collapsedTree);
+    _collapseHierarchy(vehicle, _commandList(MAV_AUTOPILOT_GENERIC, MAV_TYPE_GENERIC), collapsedTree);
 
     // Any Firmware, Specific Vehicle
     if (baseVehicleType != MAV_TYPE_GENERIC) {
-        _collapseHierarchy(vehicle, _staticCommandTree[MAV_AUTOPILOT_GENERIC][baseVehicleType], collapsedTree);
+        _collapseHierarchy(vehicle, _commandList(MAV_AUTOPILOT_GENERIC, baseVehicleType), collapsedTree);
     }
 
     // Known Firmware, Any Vehicle
     if (baseFirmwareType != MAV_AUTOPILOT_GENERIC) {
-        _collapseHierarchy(vehicle, _staticCommandTree[baseFirmwareType][MAV_TYPE_GENERIC], collapsedTree);
+        _collapseHierarchy(vehicle, _commandList(baseFirmwareType, MAV_TYPE_GENERIC), collapsedTree);
 
         // Known Firmware, Specific Vehicle
         if (baseVehicleType != MAV_TYPE_GENERIC) {
-            _collapseHierarchy(vehicle, _staticCommandTree[baseFirmwareType][baseVehicleType], collapsedTree);
+            _collapseHierarchy(vehicle, _commandList(baseFirmwareType, baseVehicleType), collapsedTree);
         }
     }
 
@@ -75,6 +75,7 @@ private:
     void             _buildAllCommands(Vehicle* vehicle);
     QStringList     _availableCategoriesForVehicle(Vehicle* vehicle);
     void            _baseVehicleInfo(Vehicle* vehicle, MAV_AUTOPILOT& baseFirmwareType, MAV_TYPE& baseVehicleType) const;
+    MissionCommandList* _commandList(MAV_AUTOPILOT firmwareType, MAV_TYPE vehicleType);
 
 private:
     QString             _allCommandsCategory;   ///< Category which contains all available commands
@@ -82,7 +83,10 @@ private:
     SettingsManager*    _settingsManager;
     bool                _unitTest;              ///< true: running in unit test mode
 
-    /// Full hierarchy
+    /// Json files for the full hierarchy
+    QMap<MAV_AUTOPILOT, QMap<MAV_TYPE, QString>>                                _staticCommandFiles;
+
+    /// Full hierarchy, levels are loaded from _staticCommandFiles on first use
     QMap<MAV_AUTOPILOT, QMap<MAV_TYPE, MissionCommandList*>>                    _staticCommandTree;
 
     /// Collapsed hierarchy for specific vehicle type
@@ -31,6 +31,7 @@
 #include "KML.h"
 #include "QGCCorePlugin.h"
 #include "TakeoffMissionItem.h"
+#include "ShapeFileImporter.h"
 
 #define UPDATE_TIMEOUT 5000 ///< How often we check for bounding box changes
 
@@ -242,6 +243,7 @@ void MissionController::sendToVehicle(void)
         qCWarning(MissionControllerLog) << "MissionControllerLog::sendToVehicle called while syncInProgress";
     } else {
         qCDebug(MissionControllerLog) << "MissionControllerLog::sendToVehicle";
+        _completePendingWork();
         _warnIfTerrainFrameUsed();
         if (_visualItems->count() == 1) {
             // This prevents us from sending a possibly bogus home position to the vehicle
@@ -292,6 +294,7 @@ void MissionController::convertToKMLDocument(QDomDocument& document)
     QObject*            deleteParent = new QObject();
     QList<MissionItem*> rgMissionItems;
 
+    _completePendingWork();
     _convertToMissionItems(_visualItems, rgMissionItems, deleteParent);
     if (rgMissionItems.count() == 0) {
         return;
@@ -503,7 +506,79 @@ VisualMissionItem* MissionController::insertComplexMissionItemFromKMLOrSHP(QStri
     return newItem;
 }
 
+int MissionController::insertComplexMissionItemsFromShapeImport(QString itemName, ShapeFileImporter* importer, int visualItemIndex)
+{
+    ShapeFileHelper::ShapeType shapeType;
+
+    if (itemName == patternSurveyName || itemName == patternStructureScanName) {
+        shapeType = ShapeFileHelper::Polygon;
+    } else if (itemName == patternCorridorScanName) {
+        shapeType = ShapeFileHelper::Polyline;
+    } else {
+        qWarning() << "Internal error: Unknown complex item:" << itemName;
+        return 0;
+    }
+
+    if (!importer || importer->running()) {
+        qWarning() << "Internal error: Import not available";
+        return 0;
+    }
+
+    ComplexMissionItem* firstItem = nullptr;
+    int                 itemCount = 0;
+
+    for (const ShapeFileHelper::Feature& feature: importer->features()) {
+        if (feature.type != shapeType) {
+            continue;
+        }
+
+        ComplexMissionItem* newItem = nullptr;
+        if (itemName == patternSurveyName) {
+            SurveyComplexItem* surveyItem = new SurveyComplexItem(_controllerVehicle, _flyView, QString() /* kmlOrShpFile */, _visualItems);
+            surveyItem->surveyAreaPolygon()->appendVertices(feature.coordinates);
+            surveyItem->surveyAreaPolygon()->setDirty(false);
+            newItem = surveyItem;
+        } else if (itemName == patternStructureScanName) {
+            StructureScanComplexItem* structureItem = new StructureScanComplexItem(_controllerVehicle, _flyView, QString() /* kmlOrShpFile */, _visualItems);
+            structureItem->structurePolygon()->appendVertices(feature.coordinates);
+            structureItem->structurePolygon()->setDirty(false);
+            newItem = structureItem;
+        } else {
+            CorridorScanComplexItem* corridorItem = new CorridorScanComplexItem(_controllerVehicle, _flyView, QString() /* kmlOrShpFile */, _visualItems);
+            corridorItem->corridorPolyline()->appendVertices(feature.coordinates);
+            corridorItem->corridorPolyline()->setDirty(false);
+            newItem = corridorItem;
+        }
+
+        // Items are all added before a single recalc, otherwise a large import recalcs the whole mission for each item
+        _addComplexMissionItem(newItem, visualItemIndex == -1 ? -1 : visualItemIndex + itemCount);
+        if (!firstItem) {
+            firstItem = newItem;
+        }
+        itemCount++;
+    }
+
+    if (firstItem) {
+        _recalcAll();
+        setCurrentPlanViewSeqNum(firstItem->sequenceNumber(), true);
+    }
+
+    qCDebug(MissionControllerLog) << "insertComplexMissionItemsFromShapeImport" << itemName << itemCount;
+
+    return itemCount;
+}
+
 void MissionController::_insertComplexMissionItemWorker(const QGeoCoordinate& mapCenterCoordinate, ComplexMissionItem* complexItem, int visualItemIndex, bool makeCurrentItem)
+{
+    _addComplexMissionItem(complexItem, visualItemIndex);
+    _recalcAllWithCoordinate(mapCenterCoordinate);
+
+    if (makeCurrentItem) {
+        setCurrentPlanViewSeqNum(complexItem->sequenceNumber(), true);
+    }
+}
+
+void MissionController::_addComplexMissionItem(ComplexMissionItem* complexItem, int visualItemIndex)
 {
     int sequenceNumber = _nextSequenceNumber();
     bool surveyStyleItem = qobject_cast<SurveyComplexItem*>(complexItem) ||
@@ -550,11 +625,6 @@ void MissionController::_insertComplexMissionItemWorker(const QGeoCoordinate& ma
     if(!complexItem->isSimpleItem()) {
         connect(complexItem, &ComplexMissionItem::boundingCubeChanged, this, &MissionController::_complexBoundingBoxChanged);
     }
-    _recalcAllWithCoordinate(mapCenterCoordinate);
-
-    if (makeCurrentItem) {
-        setCurrentPlanViewSeqNum(complexItem->sequenceNumber(), true);
-    }
 }
 
 void MissionController::removeMissionItem(int viIndex)
@@ -1076,6 +1146,7 @@ void MissionController::save(QJsonObject& json)
 
     // Save the visual items
 
+    _completePendingWork();
     QJsonArray rgJsonMissionItems;
     for (int i=0; i<_visualItems->count(); i++) {
         VisualMissionItem* visualItem = qobject_cast<VisualMissionItem*>(_visualItems->get(i));
@@ -1738,6 +1809,19 @@ void MissionController::_recalcSequence(void)
     _inRecalcSequence = false;
 }
 
+// Complex items may still be building their contents in the background. Once they are complete the sequence numbers are
+// final, so mission items generated afterwards are numbered consistently.
+void MissionController::_completePendingWork(void)
+{
+    for (int i=0; i<_visualItems->count(); i++) {
+        ComplexMissionItem* complexItem = _visualItems->value<ComplexMissionItem*>(i);
+        if (complexItem) {
+            complexItem->completePendingWork();
+        }
+    }
+    _recalcSequence();
+}
+
 // This will update the child item hierarchy
 void MissionController::_recalcChildItems(void)
 {
@@ -27,6 +27,7 @@ class MissionManager;
 class SimpleMissionItem;
 class ComplexMissionItem;
 class MissionSettingsItem;
+class ShapeFileImporter;
 class QDomDocument;
 
 Q_DECLARE_LOGGING_CATEGORY(MissionControllerLog)
@@ -154,6 +155,14 @@ public:
     /// @return Newly created item
     Q_INVOKABLE VisualMissionItem*  insertComplexMissionItemFromKMLOrSHP(QString itemName, QString file, int visualItemIndex, bool makeCurrentItem = false);
 
+    /// Add a complex mission item for each matching shape of a finished import. Survey and Structure Scan items are created
+    /// from the polygons, Corridor Scan items from the polylines.
+    ///     @param itemName: Name of complex item to create (from complexMissionItemNames)
+    ///     @param importer: Import to create the items from
+    ///     @param visualItemIndex: index to insert at, -1 for end of list
+    /// @return Number of items created
+    Q_INVOKABLE int insertComplexMissionItemsFromShapeImport(QString itemName, ShapeFileImporter* importer, int visualItemIndex);
+
     Q_INVOKABLE void resumeMission(int resumeIndex);
 
     /// Updates the altitudes of the items in the current mission to the new default altitude
@@ -290,6 +299,7 @@ private slots:
 private:
     void _init(void);
     void _recalcSequence(void);
+    void _completePendingWork(void);
     void _recalcChildItems(void);
     void _recalcAllWithCoordinate(const QGeoCoordinate& coordinate);
     void _recalcROISpecialVisuals(void);
@@ -323,6 +333,7 @@ private:
     void _addTimeDistance(bool vtolInHover, double hoverTime, double cruiseTime, double extraTime, double distance, int seqNum);
     VisualMissionItem* _insertSimpleMissionItemWorker(QGeoCoordinate coordinate, MAV_CMD command, int visualItemIndex, bool makeCurrentItem);
     void _insertComplexMissionItemWorker(const QGeoCoordinate& mapCenterCoordinate, ComplexMissionItem* complexItem, int visualItemIndex, bool makeCurrentItem);
+    void _addComplexMissionItem(ComplexMissionItem* complexItem, int visualItemIndex);
     void _warnIfTerrainFrameUsed(void);
     bool _isROIBeginItem(SimpleMissionItem* simpleItem);
     bool _isROICancelItem(SimpleMissionItem* simpleItem);
@@ -16,6 +16,9 @@
 #include "QGCApplication.h"
 #include "SettingsManager.h"
 #include "AppSettings.h"
+#include "SurveyComplexItem.h"
+#include "CorridorScanComplexItem.h"
+#include "ShapeFileImporter.h"
 
 MissionControllerTest::MissionControllerTest(void)
     : _multiSpyMissionController(nullptr)
@@ -199,3 +202,49 @@ void MissionControllerTest::_testLoadJsonSectionAvailable(void)
 
     }
 }
+
+void MissionControllerTest::_testInsertFromShapeImport(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+
+    ShapeFileImporter   importer;
+    QSignalSpy          spyFinished(&importer, &ShapeFileImporter::finished);
+
+    // Nothing is inserted while the import is running
+    importer.start(QStringLiteral(":/unittest/ShapeImportMultiFeature.kml"));
+    QCOMPARE(_missionController->insertComplexMissionItemsFromShapeImport(_missionController->surveyComplexItemName(), &importer, -1), 0);
+    QVERIFY(spyFinished.wait(5000));
+    QCOMPARE(importer.polygonCount(), 2);
+    QCOMPARE(importer.polylineCount(), 1);
+
+    QmlObjectListModel* visualItems = _missionController->visualItems();
+
+    // A survey for each polygon, the first new item becomes current
+    QCOMPARE(_missionController->insertComplexMissionItemsFromShapeImport(_missionController->surveyComplexItemName(), &importer, -1), 2);
+    QCOMPARE(visualItems->count(), 3);
+    SurveyComplexItem* firstSurvey = visualItems->value<SurveyComplexItem*>(1);
+    SurveyComplexItem* secondSurvey = visualItems->value<SurveyComplexItem*>(2);
+    QVERIFY(firstSurvey);
+    QVERIFY(secondSurvey);
+    QCOMPARE(firstSurvey->surveyAreaPolygon()->coordinateList(), importer.features()[0].coordinates);
+    QCOMPARE(secondSurvey->surveyAreaPolygon()->coordinateList(), importer.features()[1].coordinates);
+    QVERIFY(!firstSurvey->surveyAreaPolygon()->dirty());
+    QCOMPARE(_missionController->currentPlanViewVIIndex(), 1);
+
+    // Sequence numbers follow on from the previous item
+    QVERIFY(secondSurvey->sequenceNumber() > firstSurvey->lastSequenceNumber());
+
+    // A corridor scan for each polyline, inserted at the requested index
+    QCOMPARE(_missionController->insertComplexMissionItemsFromShapeImport(_missionController->corridorScanComplexItemName(), &importer, 1), 1);
+    QCOMPARE(visualItems->count(), 4);
+    CorridorScanComplexItem* corridorItem = visualItems->value<CorridorScanComplexItem*>(1);
+    QVERIFY(corridorItem);
+    QCOMPARE(corridorItem->corridorPolyline()->coordinateList(), importer.features()[2].coordinates);
+    QCOMPARE(visualItems->value<SurveyComplexItem*>(2), firstSurvey);
+    QVERIFY(firstSurvey->sequenceNumber() > corridorItem->lastSequenceNumber());
+
+    // Items which can not be created from shapes
+    QCOMPARE(_missionController->insertComplexMissionItemsFromShapeImport(QStringLiteral("Unknown"), &importer, -1), 0);
+    QCOMPARE(_missionController->insertComplexMissionItemsFromShapeImport(_missionController->surveyComplexItemName(), nullptr, -1), 0);
+    QCOMPARE(visualItems->count(), 4);
+}
@@ -36,6 +36,7 @@ private slots:
     void _testLoadJsonSectionAvailable(void);
     void _testEmptyVehicleAPM(void);
     void _testEmptyVehiclePX4(void);
+    void _testInsertFromShapeImport(void);
 
 private:
 #if 0
@@ -0,0 +1,274 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "PlanCache.h"
+#include "MissionItem.h"
+#include "QGC.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSettings>
+#include <QtEndian>
+#include <cstring>
+
+QGC_LOGGING_CATEGORY(PlanCacheLog, "PlanCacheLog")
+
+PlanCache::PlanCache(const QString& cacheKey, MAV_MISSION_TYPE planType, const QString& cacheDir)
+    : _cacheKey (cacheKey)
+    , _planType (planType)
+    , _cacheDir (cacheDir.isEmpty() ? planCacheDir() : QDir(cacheDir))
+    , _valid    (false)
+    , _checksum (0)
+    , _opaqueId (0)
+{
+
+}
+
+QDir PlanCache::planCacheDir(void)
+{
+    const QString spath(QFileInfo(QSettings().fileName()).dir().absolutePath());
+    return spath + QDir::separator() + "PlanCache";
+}
+
+QString PlanCache::cacheFile(void) const
+{
+    return _cacheDir.filePath(QStringLiteral("%1_%2.plancache").arg(_cacheKey).arg(_planType));
+}
+
+bool PlanCache::load(void)
+{
+    _valid = false;
+    _checksum = 0;
+    _opaqueId = 0;
+    _items.clear();
+
+    if (_cacheKey.isEmpty()) {
+        return false;
+    }
+
+    QFile file(cacheFile());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream ds(&file);
+    ds.setVersion(QDataStream::Qt_5_9);
+
+    quint32 magic, version, planType, count, checksum, opaqueId;
+    ds >> magic >> version >> planType >> count >> checksum >> opaqueId;
+    if (ds.status() != QDataStream::Ok || magic != _cacheFileMagic || version != _cacheFileVersion || planType != static_cast<quint32>(_planType)) {
+        qCDebug(PlanCacheLog) << "Discarding incompatible plan cache" << file.fileName();
+        return false;
+    }
+
+    QList<Item> items;
+    items.reserve(static_cast<int>(count));
+    for (quint32 i=0; i<count; i++) {
+        qint32  seq, command, frame;
+        float   param1, param2, param3, param4, param7;
+        double  param5, param6;
+        bool    autoContinue, isCurrentItem;
+
+        ds.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        ds >> seq >> command >> frame >> param1 >> param2 >> param3 >> param4;
+        ds.setFloatingPointPrecision(QDataStream::DoublePrecision);
+        ds >> param5 >> param6;
+        ds.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        ds >> param7 >> autoContinue >> isCurrentItem;
+        ds.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+        if (ds.status() != QDataStream::Ok) {
+            qCWarning(PlanCacheLog) << "Plan cache truncated" << file.fileName();
+            return false;
+        }
+        items.append({ seq, static_cast<MAV_CMD>(command), static_cast<MAV_FRAME>(frame), param1, param2, param3, param4, param5, param6, param7, autoContinue, isCurrentItem });
+    }
+
+    if (planChecksum(items) != checksum) {
+        qCWarning(PlanCacheLog) << "Plan cache checksum mismatch" << file.fileName();
+        return false;
+    }
+
+    _items = items;
+    _checksum = checksum;
+    _opaqueId = opaqueId;
+    _valid = true;
+
+    qCDebug(PlanCacheLog) << "Loaded plan cache" << file.fileName() << "count:checksum:opaqueId" << _items.count() << _checksum << _opaqueId;
+
+    return true;
+}
+
+void PlanCache::save(const QList<Item>& items, quint32 opaqueId)
+{
+    _items = items;
+    _checksum = planChecksum(items);
+    _opaqueId = opaqueId;
+    _valid = true;
+
+    if (_cacheKey.isEmpty()) {
+        return;
+    }
+
+    if (!_cacheDir.exists()) {
+        _cacheDir.mkpath(".");
+    }
+
+    QFile file(cacheFile());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(PlanCacheLog) << "Unable to write plan cache" << file.fileName() << file.errorString();
+        return;
+    }
+
+    QDataStream ds(&file);
+    ds.setVersion(QDataStream::Qt_5_9);
+
+    ds << _cacheFileMagic << _cacheFileVersion << static_cast<quint32>(_planType) << static_cast<quint32>(_items.count()) << _checksum << _opaqueId;
+    for (const Item& item: _items) {
+        ds.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        ds << static_cast<qint32>(item.seq) << static_cast<qint32>(item.command) << static_cast<qint32>(item.frame) << item.param1 << item.param2 << item.param3 << item.param4;
+        ds.setFloatingPointPrecision(QDataStream::DoublePrecision);
+        ds << item.param5 << item.param6;
+        ds.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        ds << item.param7 << item.autoContinue << item.isCurrentItem;
+        ds.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    }
+
+    qCDebug(PlanCacheLog) << "Saved plan cache" << file.fileName() << "count:checksum:opaqueId" << _items.count() << _checksum << _opaqueId;
+}
+
+void PlanCache::invalidate(void)
+{
+    _valid = false;
+    _checksum = 0;
+    _opaqueId = 0;
+    _items.clear();
+
+    if (!_cacheKey.isEmpty()) {
+        QFile::remove(cacheFile());
+    }
+}
+
+bool PlanCache::matchesVehicle(int count, quint32 opaqueId) const
+{
+    // An opaque id of 0 means the vehicle does not track plan changes, so nothing is known about its plan
+    return _valid && opaqueId != 0 && opaqueId == _opaqueId && count == _items.count();
+}
+
+quint32 PlanCache::opaqueIdFromMessage(const mavlink_message_t& message)
+{
+    // Wire offset of the opaque_id extension field. MAVLink 2 trims trailing zero bytes from the payload, so the field may be
+    // partially or entirely missing and the missing bytes are zero.
+    int offset;
+    switch (message.msgid) {
+    case MAVLINK_MSG_ID_MISSION_COUNT:
+        offset = 5;
+        break;
+    case MAVLINK_MSG_ID_MISSION_ACK:
+        offset = 4;
+        break;
+    default:
+        return 0;
+    }
+
+    quint8 bytes[sizeof(quint32)] = { 0, 0, 0, 0 };
+    int available = qBound(0, static_cast<int>(message.len) - offset, static_cast<int>(sizeof(bytes)));
+    if (available > 0) {
+        std::memcpy(bytes, _MAV_PAYLOAD(&message) + offset, static_cast<size_t>(available));
+    }
+
+    return qFromLittleEndian<quint32>(bytes);
+}
+
+MissionItem* PlanCache::createMissionItem(const Item& item, QObject* parent)
+{
+    return new MissionItem(item.seq,
+                           item.command,
+                           item.frame,
+                           static_cast<double>(item.param1),
+                           static_cast<double>(item.param2),
+                           static_cast<double>(item.param3),
+                           static_cast<double>(item.param4),
+                           item.param5,
+                           item.param6,
+                           static_cast<double>(item.param7),
+                           item.autoContinue,
+                           item.isCurrentItem,
+                           parent);
+}
+
+PlanCache::Item PlanCache::itemFromMissionItem(const MissionItem& missionItem)
+{
+    return {
+        missionItem.sequenceNumber(),
+        missionItem.command(),
+        missionItem.frame(),
+        static_cast<float>(missionItem.param1()),
+        static_cast<float>(missionItem.param2()),
+        static_cast<float>(missionItem.param3()),
+        static_cast<float>(missionItem.param4()),
+        missionItem.param5(),
+        missionItem.param6(),
+        static_cast<float>(missionItem.param7()),
+        missionItem.autoContinue(),
+        missionItem.isCurrentItem(),
+    };
+}
+
+quint32 PlanCache::itemHash(const Item& item)
+{
+    // Hash the values as the vehicle sees them. Params 1-4 and 7 are floats on the wire. Params 5/6 are sent as 1e7 scaled
+    // integers by MISSION_ITEM_INT, so they are compared at that resolution. This way an item written by QGC and the same item
+    // read back from the vehicle hash to the same value.
+    quint8  buffer[sizeof(qint32) * 3 + sizeof(float) * 5 + sizeof(qint64) * 2 + 1];
+    quint8* p = buffer;
+
+    auto appendInt32 = [&p](qint32 value) {
+        qToLittleEndian<qint32>(value, p);
+        p += sizeof(qint32);
+    };
+    auto appendInt64 = [&p](qint64 value) {
+        qToLittleEndian<qint64>(value, p);
+        p += sizeof(qint64);
+    };
+    auto appendFloat = [&p](float value) {
+        quint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        qToLittleEndian<quint32>(bits, p);
+        p += sizeof(quint32);
+    };
+
+    appendInt32(item.seq);
+    appendInt32(item.command);
+    appendInt32(item.frame);
+    appendFloat(item.param1);
+    appendFloat(item.param2);
+    appendFloat(item.param3);
+    appendFloat(item.param4);
+    appendInt64(qRound64(item.param5 * 1.0e7));
+    appendInt64(qRound64(item.param6 * 1.0e7));
+    appendFloat(item.param7);
+    *p++ = item.autoContinue ? 1 : 0;
+
+    return QGC::crc32(buffer, static_cast<unsigned>(p - buffer), 0);
+}
+
+quint32 PlanCache::planChecksum(const QList<Item>& items)
+{
+    quint32 checksum = 0;
+
+    for (const Item& item: items) {
+        quint32 hash = itemHash(item);
+        quint8  hashBytes[sizeof(hash)];
+        qToLittleEndian<quint32>(hash, hashBytes);
+        checksum = QGC::crc32(hashBytes, sizeof(hashBytes), checksum);
+    }
+
+    return checksum;
+}
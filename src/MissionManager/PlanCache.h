@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QList>
+#include <QDir>
+#include <QDataStream>
+
+#include "QGCMAVLink.h"
+#include "QGCLoggingCategory.h"
+
+class MissionItem;
+
+Q_DECLARE_LOGGING_CATEGORY(PlanCacheLog)
+
+/// On disk cache of the plan items (mission, geofence or rally) which are stored on a vehicle. The cache is keyed by vehicle
+/// and plan type. It holds the items exactly as they are sent over the wire so that they can be compared against items
+/// received from the vehicle without any of the QGC side adjustments made by PlanManager.
+///
+/// The cache is never trusted blindly. Each cached plan is tagged with the opaque id the vehicle reported for it in MISSION_COUNT
+/// or MISSION_ACK. The vehicle changes the opaque id whenever any item of the plan changes, so the cache is only used when the
+/// MISSION_COUNT for a read carries the same non-zero opaque id and count. Vehicles which do not report an opaque id always
+/// have the full plan read.
+class PlanCache
+{
+public:
+    /// Wire representation of a single plan item
+    struct Item {
+        int         seq;
+        MAV_CMD     command;
+        MAV_FRAME   frame;
+        float       param1;
+        float       param2;
+        float       param3;
+        float       param4;
+        double      param5;
+        double      param6;
+        float       param7;
+        bool        autoContinue;
+        bool        isCurrentItem;  ///< Not part of the item hash, the current item changes as the plan is flown
+    };
+
+    /// @param cacheKey Unique identifier for the vehicle. Vehicle UID if available, otherwise firmware type and system id.
+    /// @param cacheDir Directory for the cache file, planCacheDir() if empty
+    PlanCache(const QString& cacheKey, MAV_MISSION_TYPE planType, const QString& cacheDir = QString());
+
+    /// Loads the cache from disk
+    ///     @return true: cache file exists and is valid
+    bool load(void);
+
+    /// Replaces the cached plan with the specified items and saves it to disk
+    ///     @param opaqueId Opaque id reported by the vehicle for the plan, 0 if not known
+    void save(const QList<Item>& items, quint32 opaqueId);
+
+    /// Removes the cache file. Used when the plan on the vehicle is in an unknown state.
+    void invalidate(void);
+
+    bool                isValid     (void) const { return _valid; }
+    int                 count       (void) const { return _items.count(); }
+    quint32             checksum    (void) const { return _checksum; }
+    quint32             opaqueId    (void) const { return _opaqueId; }
+    const QList<Item>&  items       (void) const { return _items; }
+    QString             cacheKey    (void) const { return _cacheKey; }
+    QString             cacheFile   (void) const;
+
+    /// @return true: The vehicle plan described by a MISSION_COUNT is the cached plan
+    bool matchesVehicle(int count, quint32 opaqueId) const;
+
+    /// Creates a new MissionItem from the cached wire item. Caller is responsible for deleting it.
+    static MissionItem* createMissionItem(const Item& item, QObject* parent);
+
+    /// Creates a wire item from a MissionItem which has already been adjusted for sending to the vehicle
+    static Item itemFromMissionItem(const MissionItem& missionItem);
+
+    static quint32  itemHash        (const Item& item);
+    static quint32  planChecksum    (const QList<Item>& items);
+    static QDir     planCacheDir    (void);
+
+    /// @return The opaque_id field of a MISSION_COUNT or MISSION_ACK message, 0 if the sender did not fill it in. The field is
+    /// decoded from the payload so it is available with mavlink headers which predate it.
+    static quint32 opaqueIdFromMessage(const mavlink_message_t& message);
+
+private:
+    QString             _cacheKey;
+    MAV_MISSION_TYPE    _planType;
+    QDir                _cacheDir;
+    bool                _valid;
+    quint32             _checksum;
+    quint32             _opaqueId;
+    QList<Item>         _items;
+
+    static const quint32 _cacheFileMagic =      0x51504c43; // "QPLC"
+    static const quint32 _cacheFileVersion =    2;
+};
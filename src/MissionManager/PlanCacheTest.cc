@@ -0,0 +1,183 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "PlanCacheTest.h"
+#include "MissionItem.h"
+
+#include <QFile>
+#include <QtEndian>
+
+const char* PlanCacheTest::_cacheKey = "unittest";
+
+PlanCacheTest::PlanCacheTest(void)
+{
+
+}
+
+void PlanCacheTest::init(void)
+{
+    UnitTest::init();
+    _cacheDir = new QTemporaryDir;
+    QVERIFY(_cacheDir->isValid());
+}
+
+void PlanCacheTest::cleanup(void)
+{
+    delete _cacheDir;
+    _cacheDir = nullptr;
+    UnitTest::cleanup();
+}
+
+PlanCache* PlanCacheTest::_createCache(MAV_MISSION_TYPE planType)
+{
+    return new PlanCache(_cacheKey, planType, _cacheDir->path());
+}
+
+QList<PlanCache::Item> PlanCacheTest::_createItems(int count)
+{
+    QList<PlanCache::Item> items;
+
+    for (int i=0; i<count; i++) {
+        items.append({ i, MAV_CMD_NAV_WAYPOINT, MAV_FRAME_GLOBAL_RELATIVE_ALT, 1.0f * i, 2.0f, 3.0f, 4.0f, 47.3977419 + (i * 0.0001), 8.5455939, 50.0f + i, true, i == 2 });
+    }
+
+    return items;
+}
+
+void PlanCacheTest::_testSaveLoad(void)
+{
+    QList<PlanCache::Item> items = _createItems(10);
+
+    QScopedPointer<PlanCache> writeCache(_createCache(MAV_MISSION_TYPE_MISSION));
+    writeCache->save(items, 1234);
+    QVERIFY(writeCache->isValid());
+    QCOMPARE(writeCache->checksum(), PlanCache::planChecksum(items));
+    QVERIFY(writeCache->cacheFile().startsWith(_cacheDir->path()));
+
+    QScopedPointer<PlanCache> readCache(_createCache(MAV_MISSION_TYPE_MISSION));
+    QVERIFY(readCache->load());
+    QCOMPARE(readCache->count(), items.count());
+    QCOMPARE(readCache->checksum(), writeCache->checksum());
+    QCOMPARE(readCache->opaqueId(), static_cast<quint32>(1234));
+    for (int i=0; i<items.count(); i++) {
+        QCOMPARE(PlanCache::itemHash(readCache->items()[i]), PlanCache::itemHash(items[i]));
+        QCOMPARE(readCache->items()[i].isCurrentItem, items[i].isCurrentItem);
+    }
+
+    // Cache for a different plan type must be independent
+    QScopedPointer<PlanCache> fenceCache(_createCache(MAV_MISSION_TYPE_FENCE));
+    QCOMPARE(fenceCache->load(), false);
+
+    // Any change to an item must change the checksum
+    items[5].param7 += 1.0f;
+    QVERIFY(PlanCache::planChecksum(items) != writeCache->checksum());
+
+    // The current item moves as the plan is flown, it is not part of the plan
+    items[5].param7 -= 1.0f;
+    items[2].isCurrentItem = false;
+    items[3].isCurrentItem = true;
+    QCOMPARE(PlanCache::planChecksum(items), writeCache->checksum());
+}
+
+void PlanCacheTest::_testWireRoundTrip(void)
+{
+    // An item written from a MissionItem must match the same item as received through MISSION_ITEM_INT
+    MissionItem missionItem(3, MAV_CMD_NAV_WAYPOINT, MAV_FRAME_GLOBAL_RELATIVE_ALT, 0.5, 2, 0, 90, 47.39774191234, 8.54559398765, 52.5, true, true);
+    PlanCache::Item writtenItem = PlanCache::itemFromMissionItem(missionItem);
+
+    PlanCache::Item receivedItem = writtenItem;
+    receivedItem.param5 = static_cast<double>(qRound64(missionItem.param5() * 1.0e7)) / 1.0e7;
+    receivedItem.param6 = static_cast<double>(qRound64(missionItem.param6() * 1.0e7)) / 1.0e7;
+    QCOMPARE(PlanCache::itemHash(receivedItem), PlanCache::itemHash(writtenItem));
+
+    MissionItem* cachedMissionItem = PlanCache::createMissionItem(writtenItem, this);
+    QCOMPARE(cachedMissionItem->sequenceNumber(), missionItem.sequenceNumber());
+    QCOMPARE(cachedMissionItem->command(), missionItem.command());
+    QCOMPARE(cachedMissionItem->frame(), missionItem.frame());
+    QCOMPARE(cachedMissionItem->param4(), missionItem.param4());
+    QCOMPARE(cachedMissionItem->param5(), missionItem.param5());
+    QCOMPARE(cachedMissionItem->param6(), missionItem.param6());
+    QCOMPARE(cachedMissionItem->param7(), missionItem.param7());
+    QCOMPARE(cachedMissionItem->isCurrentItem(), true);
+    delete cachedMissionItem;
+}
+
+void PlanCacheTest::_testMatchesVehicle(void)
+{
+    QScopedPointer<PlanCache> cache(_createCache(MAV_MISSION_TYPE_MISSION));
+
+    QCOMPARE(cache->matchesVehicle(0, 0), false);
+
+    cache->save(_createItems(20), 77);
+    QCOMPARE(cache->matchesVehicle(20, 77), true);
+
+    // A changed plan has a different opaque id, even when the count is the same
+    QCOMPARE(cache->matchesVehicle(20, 78), false);
+    QCOMPARE(cache->matchesVehicle(19, 77), false);
+
+    // Vehicles which do not report an opaque id are never matched
+    cache->save(_createItems(20), 0);
+    QCOMPARE(cache->matchesVehicle(20, 0), false);
+}
+
+void PlanCacheTest::_testOpaqueIdFromMessage(void)
+{
+    mavlink_message_t message;
+
+    // Without the extension field
+    mavlink_msg_mission_count_pack(1, MAV_COMP_ID_AUTOPILOT1, &message, 255, MAV_COMP_ID_MISSIONPLANNER, 10, MAV_MISSION_TYPE_MISSION);
+    QCOMPARE(PlanCache::opaqueIdFromMessage(message), static_cast<quint32>(0));
+
+    // Full and zero trimmed extension fields. MISSION_COUNT has opaque_id at offset 5, MISSION_ACK at offset 4.
+    struct {
+        uint32_t    msgid;
+        int         offset;
+        int         len;
+        quint32     opaqueId;
+    } rgTestCases[] = {
+        { MAVLINK_MSG_ID_MISSION_COUNT, 5, 9, 0x12345678 },
+        { MAVLINK_MSG_ID_MISSION_COUNT, 5, 6, 0x00000042 },
+        { MAVLINK_MSG_ID_MISSION_ACK,   4, 8, 0x87654321 },
+        { MAVLINK_MSG_ID_MISSION_ACK,   4, 5, 0x00000007 },
+    };
+
+    for (const auto& testCase: rgTestCases) {
+        memset(&message, 0, sizeof(message));
+        message.msgid = testCase.msgid;
+        message.len = static_cast<uint8_t>(testCase.len);
+        quint8 opaqueIdBytes[sizeof(quint32)];
+        qToLittleEndian<quint32>(testCase.opaqueId, opaqueIdBytes);
+        memcpy(_MAV_PAYLOAD_NON_CONST(&message) + testCase.offset, opaqueIdBytes, static_cast<size_t>(testCase.len - testCase.offset));
+        QCOMPARE(PlanCache::opaqueIdFromMessage(message), testCase.opaqueId);
+    }
+
+    // Other messages have no opaque id
+    message.msgid = MAVLINK_MSG_ID_HEARTBEAT;
+    QCOMPARE(PlanCache::opaqueIdFromMessage(message), static_cast<quint32>(0));
+}
+
+void PlanCacheTest::_testInvalidate(void)
+{
+    QScopedPointer<PlanCache> cache(_createCache(MAV_MISSION_TYPE_MISSION));
+    cache->save(_createItems(5), 1);
+    QVERIFY(QFile::exists(cache->cacheFile()));
+
+    cache->invalidate();
+    QCOMPARE(cache->isValid(), false);
+    QCOMPARE(QFile::exists(cache->cacheFile()), false);
+    QCOMPARE(cache->load(), false);
+
+    // Corrupted cache files must be rejected
+    cache->save(_createItems(5), 1);
+    QFile file(cache->cacheFile());
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    file.resize(file.size() - 4);
+    file.close();
+    QCOMPARE(cache->load(), false);
+}
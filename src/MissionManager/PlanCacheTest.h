@@ -0,0 +1,41 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "PlanCache.h"
+
+#include <QTemporaryDir>
+
+class PlanCacheTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    PlanCacheTest(void);
+
+private slots:
+    void init(void);
+    void cleanup(void);
+
+    void _testSaveLoad(void);
+    void _testWireRoundTrip(void);
+    void _testMatchesVehicle(void);
+    void _testOpaqueIdFromMessage(void);
+    void _testInvalidate(void);
+
+private:
+    QList<PlanCache::Item>  _createItems(int count);
+    PlanCache*              _createCache(MAV_MISSION_TYPE planType);
+
+    QTemporaryDir*  _cacheDir = nullptr;    ///< Keeps the tests away from the plan cache of the installed application
+
+    static const char* _cacheKey;
+};
@@ -33,6 +33,9 @@ PlanManager::PlanManager(Vehicle* vehicle, MAV_MISSION_TYPE planType)
     , _missionItemCountToRead   (-1)
     , _currentMissionIndex      (-1)
     , _lastCurrentIndex         (-1)
+    , _planCache                (nullptr)
+    , _loadingPlanCache         (false)
+    , _vehicleOpaqueId          (0)
 {
     _ackTimeoutTimer = new QTimer(this);
     _ackTimeoutTimer->setSingleShot(true);
@@ -42,7 +45,7 @@ PlanManager::PlanManager(Vehicle* vehicle, MAV_MISSION_TYPE planType)
 
 PlanManager::~PlanManager()
 {
-
+    delete _planCache;
 }
 
 void PlanManager::_writeMissionItemsWorker(void)
@@ -150,6 +153,10 @@ void PlanManager::_requestList(void)
 
     _itemIndicesToRead.clear();
     _clearMissionItems();
+    _readWireItems.clear();
+    _freshCacheItems.clear();
+    _loadingPlanCache = false;
+    _vehicleOpaqueId = 0;
 
     _dedicatedLink = _vehicle->priorityLink();
     mavlink_msg_mission_request_list_pack_chan(qgcApp()->toolbox()->mavlinkProtocol()->getSystemId(),
@@ -326,9 +333,27 @@ void PlanManager::_handleMissionCount(const mavlink_message_t& message)
 
     _retryCount = 0;
 
+    _vehicleOpaqueId = PlanCache::opaqueIdFromMessage(message);
+
     if (missionCount.count == 0) {
         _readTransactionComplete();
     } else {
+        PlanCache* planCache = _planCacheForVehicle();
+        if (planCache && planCache->load() && planCache->matchesVehicle(missionCount.count, _vehicleOpaqueId)) {
+            // The vehicle still has the plan we cached. ArduPilot updates the home position stored in item 0 on its own
+            // without changing the opaque id, so that item is always read fresh.
+            qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionCount %1 loading plan cache opaqueId:").arg(_planTypeString()) << _vehicleOpaqueId;
+            _missionItemCountToRead = missionCount.count;
+            if (_vehicle->apmFirmware() && _planType == MAV_MISSION_TYPE_MISSION) {
+                _loadingPlanCache = true;
+                _itemIndicesToRead << 0;
+                _requestNextMissionItem();
+            } else {
+                _loadFromPlanCache();
+            }
+            return;
+        }
+
         // Prime read list
         for (int i=0; i<missionCount.count; i++) {
             _itemIndicesToRead << i;
@@ -446,8 +471,27 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message, bool miss
         return;
     }
     
+    PlanCache::Item wireItem = { seq, command, frame,
+                                 static_cast<float>(param1), static_cast<float>(param2), static_cast<float>(param3), static_cast<float>(param4),
+                                 param5, param6, static_cast<float>(param7),
+                                 autoContinue, isCurrentItem };
+
+    if (_loadingPlanCache && _itemIndicesToRead.contains(seq)) {
+        _itemIndicesToRead.removeOne(seq);
+        _freshCacheItems[seq] = wireItem;
+
+        _retryCount = 0;
+        if (_itemIndicesToRead.count() == 0) {
+            _loadFromPlanCache();
+        } else {
+            _requestNextMissionItem();
+        }
+        return;
+    }
+
     if (_itemIndicesToRead.contains(seq)) {
         _itemIndicesToRead.removeOne(seq);
+        _readWireItems.append(wireItem);
 
         MissionItem* item = new MissionItem(seq,
                                             command,
@@ -620,6 +664,9 @@ void PlanManager::_handleMissionAck(const mavlink_message_t& message)
 
     qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionAck %1 type:").arg(_planTypeString()) << _missionResultToString((MAV_MISSION_RESULT)missionAck.type);
 
+    // The final ack of a write or remove all carries the opaque id of the new plan on the vehicle
+    _vehicleOpaqueId = PlanCache::opaqueIdFromMessage(message);
+
     switch (savedExpectedAck) {
     case AckNone:
         // State machine is idle. Vehicle is confused.
@@ -840,6 +887,10 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
     TransactionType_t currentTransactionType = _transactionInProgress;
     _setTransactionInProgress(TransactionNone);
 
+    if (!apmGuidedItemWrite) {
+        _updatePlanCache(currentTransactionType, success);
+    }
+
     switch (currentTransactionType) {
     case TransactionRead:
         if (!success) {
@@ -989,3 +1040,101 @@ void PlanManager::_setTransactionInProgress(TransactionType_t type)
         emit inProgressChanged(inProgress());
     }
 }
+
+bool PlanManager::_planCacheEnabled(void) const
+{
+    // Unit tests exercise the full protocol sequences, so they must not be short circuited by a cache left over from a previous run
+    return !_vehicle->isOfflineEditingVehicle() && !qgcApp()->runningUnitTests();
+}
+
+/// @return The plan cache for the current vehicle, nullptr if caching is not available
+PlanCache* PlanManager::_planCacheForVehicle(void)
+{
+    if (!_planCacheEnabled()) {
+        return nullptr;
+    }
+
+    // Prefer the hardware UID since system ids are frequently reused across vehicles. The cache contents are always
+    // verified against the vehicle so a key collision only costs a full read.
+    QString cacheKey;
+    if (_vehicle->vehicleUID() != 0) {
+        cacheKey = QStringLiteral("uid%1").arg(_vehicle->vehicleUID(), 16, 16, QLatin1Char('0'));
+    } else {
+        cacheKey = QStringLiteral("fw%1_sysid%2").arg(_vehicle->firmwareType()).arg(_vehicle->id());
+    }
+
+    if (!_planCache || _planCache->cacheKey() != cacheKey) {
+        delete _planCache;
+        _planCache = new PlanCache(cacheKey, _planType);
+    }
+
+    return _planCache;
+}
+
+/// Called when the vehicle reported the opaque id of the cached plan. Finishes the read transaction using the cached items.
+void PlanManager::_loadFromPlanCache(void)
+{
+    _loadingPlanCache = false;
+
+    _readWireItems = _planCache->items();
+    for (int seq: _freshCacheItems.keys()) {
+        _readWireItems[seq] = _freshCacheItems[seq];
+    }
+    _freshCacheItems.clear();
+
+    qCDebug(PlanManagerLog) << QStringLiteral("_loadFromPlanCache %1 count:").arg(_planTypeString()) << _readWireItems.count();
+
+    for (const PlanCache::Item& wireItem: _readWireItems) {
+        MissionItem* item = PlanCache::createMissionItem(wireItem, this);
+        if (item->command() == MAV_CMD_DO_JUMP && !_vehicle->firmwarePlugin()->sendHomePositionToVehicle()) {
+            // Home is in position 0
+            item->setParam1((int)item->param1() + 1);
+        }
+        _missionItems.append(item);
+    }
+
+    _readTransactionComplete();
+}
+
+/// Keeps the plan cache in sync with what we know to be on the vehicle at the end of a transaction
+void PlanManager::_updatePlanCache(TransactionType_t transactionType, bool success)
+{
+    PlanCache* planCache = _planCacheForVehicle();
+    if (!planCache) {
+        return;
+    }
+
+    switch (transactionType) {
+    case TransactionRead:
+        if (success) {
+            planCache->save(_readWireItems, _vehicleOpaqueId);
+        }
+        break;
+    case TransactionWrite:
+        if (success) {
+            QList<PlanCache::Item> wireItems;
+            for (const MissionItem* item: _writeMissionItems) {
+                wireItems.append(PlanCache::itemFromMissionItem(*item));
+            }
+            planCache->save(wireItems, _vehicleOpaqueId);
+        } else {
+            // Vehicle may be left with a partial plan
+            planCache->invalidate();
+        }
+        break;
+    case TransactionRemoveAll:
+        if (success) {
+            planCache->save(QList<PlanCache::Item>(), _vehicleOpaqueId);
+        } else {
+            planCache->invalidate();
+        }
+        break;
+    default:
+        break;
+    }
+
+    _readWireItems.clear();
+    _freshCacheItems.clear();
+    _loadingPlanCache = false;
+    _vehicleOpaqueId = 0;
+}
@@ -18,6 +18,7 @@
 #include "QGCMAVLink.h"
 #include "QGCLoggingCategory.h"
 #include "LinkInterface.h"
+#include "PlanCache.h"
 
 class Vehicle;
 
@@ -132,6 +133,10 @@ protected:
     void _connectToMavlink(void);
     void _disconnectFromMavlink(void);
     QString _planTypeString(void);
+    bool _planCacheEnabled(void) const;
+    PlanCache* _planCacheForVehicle(void);
+    void _loadFromPlanCache(void);
+    void _updatePlanCache(TransactionType_t transactionType, bool success);
 
 protected:
     Vehicle*            _vehicle;
@@ -154,6 +159,12 @@ protected:
     int                 _currentMissionIndex;
     int                 _lastCurrentIndex;
 
+    PlanCache*                  _planCache;             ///< On disk copy of the plan last seen on the vehicle, nullptr if not yet created
+    bool                        _loadingPlanCache;      ///< true: Vehicle has the cached plan, reading the items which must be fresh before loading the rest from cache
+    quint32                     _vehicleOpaqueId;       ///< Opaque id of the plan on the vehicle from the last MISSION_COUNT or MISSION_ACK, 0 if not known
+    QList<PlanCache::Item>      _readWireItems;         ///< Wire representation of items read during current read transaction
+    QMap<int, PlanCache::Item>  _freshCacheItems;       ///< Items read from the vehicle to replace the cached copy, keyed by sequence number
+
 private:
     void _setTransactionInProgress(TransactionType_t type);
 };
@@ -13,6 +13,7 @@
 #include "QGCQGeoCoordinate.h"
 #include "QGCApplication.h"
 #include "ShapeFileHelper.h"
+#include "SettingsManager.h"
 
 #include <QGeoRectangle>
 #include <QDebug>
@@ -25,6 +26,10 @@ const char* QGCMapPolygon::jsonPolygonKey = "polygon";
 
 QGCMapPolygon::QGCMapPolygon(QObject* parent)
     : QObject               (parent)
+    , _pathCacheValid       (false)
+    , _polygonFCacheValid   (false)
+    , _polygonModelCreated  (false)
+    , _polygonModelLoading  (false)
     , _dirty                (false)
     , _centerDrag           (false)
     , _ignoreCenterUpdates  (false)
@@ -36,6 +41,10 @@ QGCMapPolygon::QGCMapPolygon(QObject* parent)
 
 QGCMapPolygon::QGCMapPolygon(const QGCMapPolygon& other, QObject* parent)
     : QObject               (parent)
+    , _pathCacheValid       (false)
+    , _polygonFCacheValid   (false)
+    , _polygonModelCreated  (false)
+    , _polygonModelLoading  (false)
     , _dirty                (false)
     , _centerDrag           (false)
     , _ignoreCenterUpdates  (false)
@@ -50,7 +59,6 @@ QGCMapPolygon::QGCMapPolygon(const QGCMapPolygon& other, QObject* parent)
 void QGCMapPolygon::_init(void)
 {
     connect(&_polygonModel, &QmlObjectListModel::dirtyChanged, this, &QGCMapPolygon::_polygonModelDirtyChanged);
-    connect(&_polygonModel, &QmlObjectListModel::countChanged, this, &QGCMapPolygon::_polygonModelCountChanged);
 
     connect(this, &QGCMapPolygon::pathChanged,  this, &QGCMapPolygon::_updateCenter);
     connect(this, &QGCMapPolygon::countChanged, this, &QGCMapPolygon::isValidChanged);
@@ -61,23 +69,72 @@ const QGCMapPolygon& QGCMapPolygon::operator=(const QGCMapPolygon& other)
 {
     clear();
 
-    QVariantList vertices = other.path();
-    QList<QGeoCoordinate> rgCoord;
-    for (const QVariant& vertexVar: vertices) {
-        rgCoord.append(vertexVar.value<QGeoCoordinate>());
-    }
-    appendVertices(rgCoord);
+    appendVertices(other.coordinateList());
 
     setDirty(true);
 
     return *this;
 }
 
+/// Drops the cached path and geometry after an edit and signals count changes
+void QGCMapPolygon::_verticesChanged(int previousCount)
+{
+    _pathCacheValid     = false;
+    _polygonFCacheValid = false;
+
+    if (_vertices.count() != previousCount) {
+        emit countChanged(_vertices.count());
+    }
+}
+
+QVariantList QGCMapPolygon::path(void) const
+{
+    if (!_pathCacheValid) {
+        _pathCache.clear();
+        _pathCache.reserve(_vertices.count());
+        for (const QGeoCoordinate& vertex: _vertices) {
+            _pathCache.append(QVariant::fromValue(vertex));
+        }
+        _pathCacheValid = true;
+    }
+
+    return _pathCache;
+}
+
+QmlObjectListModel* QGCMapPolygon::qmlPathModel(void)
+{
+    if (!_polygonModelCreated) {
+        _polygonModelCreated = true;
+
+        if (_vertices.count()) {
+            QList<QObject*> objects;
+            for (const QGeoCoordinate& vertex: _vertices) {
+                objects.append(new QGCQGeoCoordinate(vertex, this));
+            }
+
+            // Creating the vertex objects is not an edit of the polygon
+            _polygonModelLoading = true;
+            if (!_resetActive) {
+                _polygonModel.beginReset();
+            }
+            _polygonModel.append(objects);
+            if (!_resetActive) {
+                _polygonModel.endReset();
+            }
+            _polygonModel.setDirty(false);
+            _polygonModelLoading = false;
+        }
+    }
+
+    return &_polygonModel;
+}
+
 void QGCMapPolygon::clear(void)
 {
     // Bug workaround, see below
-    while (_polygonPath.count() > 1) {
-        _polygonPath.takeLast();
+    if (_vertices.count() > 1) {
+        _vertices.resize(1);
+        _pathCacheValid = _polygonFCacheValid = false;
     }
     emit pathChanged();
 
@@ -85,9 +142,13 @@ void QGCMapPolygon::clear(void)
     // to be a bug in QGCMapPolygon which causes it to not be redrawn if the list is empty. So
     // we work around it by using the code above to remove all but the last point which in turn
     // will cause the polygon to go away.
-    _polygonPath.clear();
+    _vertices.clear();
+    _pathCacheValid = _polygonFCacheValid = false;
 
-    _polygonModel.clearAndDeleteContents();
+    if (_polygonModelCreated) {
+        _polygonModel.clearAndDeleteContents();
+    }
+    emit countChanged(0);
 
     emit cleared();
 
@@ -96,8 +157,11 @@ void QGCMapPolygon::clear(void)
 
 void QGCMapPolygon::adjustVertex(int vertexIndex, const QGeoCoordinate coordinate)
 {
-    _polygonPath[vertexIndex] = QVariant::fromValue(coordinate);
-    _polygonModel.value<QGCQGeoCoordinate*>(vertexIndex)->setCoordinate(coordinate);
+    _vertices[vertexIndex] = coordinate;
+    _verticesChanged(_vertices.count());
+    if (_polygonModelCreated) {
+        _polygonModel.value<QGCQGeoCoordinate*>(vertexIndex)->setCoordinate(coordinate);
+    }
     if (!_centerDrag) {
         // When dragging center we don't signal path changed until all vertices are updated
         emit pathChanged();
@@ -109,7 +173,7 @@ void QGCMapPolygon::setDirty(bool dirty)
 {
     if (_dirty != dirty) {
         _dirty = dirty;
-        if (!dirty) {
+        if (!dirty && _polygonModelCreated) {
             _polygonModel.setDirty(false);
         }
         emit dirtyChanged(dirty);
@@ -120,9 +184,8 @@ QGeoCoordinate QGCMapPolygon::_coordFromPointF(const QPointF& point) const
 {
     QGeoCoordinate coord;
 
-    if (_polygonPath.count() > 0) {
-        QGeoCoordinate tangentOrigin = _polygonPath[0].value<QGeoCoordinate>();
-        convertNedToGeo(-point.y(), point.x(), 0, tangentOrigin, &coord);
+    if (_vertices.count() > 0) {
+        convertNedToGeo(point.y(), point.x(), 0, _vertices[0], &coord);
     }
 
     return coord;
@@ -130,34 +193,39 @@ QGeoCoordinate QGCMapPolygon::_coordFromPointF(const QPointF& point) const
 
 QPointF QGCMapPolygon::_pointFFromCoord(const QGeoCoordinate& coordinate) const
 {
-    if (_polygonPath.count() > 0) {
-        double y, x, down;
-        QGeoCoordinate tangentOrigin = _polygonPath[0].value<QGeoCoordinate>();
+    if (_vertices.count() > 0) {
+        double north, east, down;
 
-        convertGeoToNed(coordinate, tangentOrigin, &y, &x, &down);
-        return QPointF(x, -y);
+        convertGeoToNed(coordinate, _vertices[0], &north, &east, &down);
+        return QPointF(east, north);
     }
 
     return QPointF();
 }
 
-QPolygonF QGCMapPolygon::_toPolygonF(void) const
+const QPolygonF& QGCMapPolygon::_toPolygonF(void) const
 {
-    QPolygonF polygon;
-
-    if (_polygonPath.count() > 2) {
-        for (int i=0; i<_polygonPath.count(); i++) {
-            polygon.append(_pointFFromCoord(_polygonPath[i].value<QGeoCoordinate>()));
+    if (!_polygonFCacheValid) {
+        _polygonFCache.clear();
+        _polygonFCache.reserve(_vertices.count());
+        for (int i=0; i<_vertices.count(); i++) {
+            // The first vertex is the tangent origin, this also avoids a nan calculation that comes out of convertGeoToNed
+            _polygonFCache.append(i == 0 ? QPointF(0, 0) : _pointFFromCoord(_vertices[i]));
         }
+        _polygonFBounds = _polygonFCache.boundingRect();
+        _polygonFCacheValid = true;
     }
 
-    return polygon;
+    return _polygonFCache;
 }
 
 bool QGCMapPolygon::containsCoordinate(const QGeoCoordinate& coordinate) const
 {
-    if (_polygonPath.count() > 2) {
-        return _toPolygonF().containsPoint(_pointFFromCoord(coordinate), Qt::OddEvenFill);
+    if (_vertices.count() > 2) {
+        const QPolygonF&    polygon = _toPolygonF();
+        QPointF             point   = _pointFFromCoord(coordinate);
+
+        return _polygonFBounds.contains(point) && polygon.containsPoint(point, Qt::OddEvenFill);
     } else {
         return false;
     }
@@ -165,12 +233,16 @@ bool QGCMapPolygon::containsCoordinate(const QGeoCoordinate& coordinate) const
 
 void QGCMapPolygon::setPath(const QList<QGeoCoordinate>& path)
 {
-    _polygonPath.clear();
-    _polygonModel.clearAndDeleteContents();
-    for(const QGeoCoordinate& coord: path) {
-        _polygonPath.append(QVariant::fromValue(coord));
-        _polygonModel.append(new QGCQGeoCoordinate(coord, this));
+    int previousCount = _vertices.count();
+
+    _vertices = path.toVector();
+    if (_polygonModelCreated) {
+        _polygonModel.clearAndDeleteContents();
+        for(const QGeoCoordinate& coord: path) {
+            _polygonModel.append(new QGCQGeoCoordinate(coord, this));
+        }
     }
+    _verticesChanged(previousCount);
 
     setDirty(true);
     emit pathChanged();
@@ -178,22 +250,19 @@ void QGCMapPolygon::setPath(const QList<QGeoCoordinate>& path)
 
 void QGCMapPolygon::setPath(const QVariantList& path)
 {
-    _polygonPath = path;
+    QList<QGeoCoordinate> coords;
 
-    _polygonModel.clearAndDeleteContents();
-    for (int i=0; i<_polygonPath.count(); i++) {
-        _polygonModel.append(new QGCQGeoCoordinate(_polygonPath[i].value<QGeoCoordinate>(), this));
+    for (const QVariant& varCoord: path) {
+        coords.append(varCoord.value<QGeoCoordinate>());
     }
-
-    setDirty(true);
-    emit pathChanged();
+    setPath(coords);
 }
 
 void QGCMapPolygon::saveToJson(QJsonObject& json)
 {
     QJsonValue jsonValue;
 
-    JsonHelper::saveGeoCoordinateArray(_polygonPath, false /* writeAltitude*/, jsonValue);
+    JsonHelper::saveGeoCoordinateArray(coordinateList(), false /* writeAltitude*/, jsonValue);
     json.insert(jsonPolygonKey, jsonValue);
     setDirty(false);
 }
@@ -211,13 +280,18 @@ bool QGCMapPolygon::loadFromJson(const QJsonObject& json, bool required, QString
         return true;
     }
 
-    if (!JsonHelper::loadGeoCoordinateArray(json[jsonPolygonKey], false /* altitudeRequired */, _polygonPath, errorString)) {
+    QList<QGeoCoordinate> rgCoords;
+    if (!JsonHelper::loadGeoCoordinateArray(json[jsonPolygonKey], false /* altitudeRequired */, rgCoords, errorString)) {
         return false;
     }
 
-    for (int i=0; i<_polygonPath.count(); i++) {
-        _polygonModel.append(new QGCQGeoCoordinate(_polygonPath[i].value<QGeoCoordinate>(), this));
+    _vertices = rgCoords.toVector();
+    if (_polygonModelCreated) {
+        for (const QGeoCoordinate& coord: rgCoords) {
+            _polygonModel.append(new QGCQGeoCoordinate(coord, this));
+        }
     }
+    _verticesChanged(0);
 
     setDirty(false);
     emit pathChanged();
@@ -227,24 +301,18 @@ bool QGCMapPolygon::loadFromJson(const QJsonObject& json, bool required, QString
 
 QList<QGeoCoordinate> QGCMapPolygon::coordinateList(void) const
 {
-    QList<QGeoCoordinate> coords;
-
-    for (int i=0; i<_polygonPath.count(); i++) {
-        coords.append(_polygonPath[i].value<QGeoCoordinate>());
-    }
-
-    return coords;
+    return _vertices.toList();
 }
 
 void QGCMapPolygon::splitPolygonSegment(int vertexIndex)
 {
     int nextIndex = vertexIndex + 1;
-    if (nextIndex > _polygonPath.length() - 1) {
+    if (nextIndex > _vertices.count() - 1) {
         nextIndex = 0;
     }
 
-    QGeoCoordinate firstVertex = _polygonPath[vertexIndex].value<QGeoCoordinate>();
-    QGeoCoordinate nextVertex = _polygonPath[nextIndex].value<QGeoCoordinate>();
+    QGeoCoordinate firstVertex = _vertices[vertexIndex];
+    QGeoCoordinate nextVertex = _vertices[nextIndex];
 
     double distance = firstVertex.distanceTo(nextVertex);
     double azimuth = firstVertex.azimuthTo(nextVertex);
@@ -253,29 +321,50 @@ void QGCMapPolygon::splitPolygonSegment(int vertexIndex)
     if (nextIndex == 0) {
         appendVertex(newVertex);
     } else {
-        _polygonModel.insert(nextIndex, new QGCQGeoCoordinate(newVertex, this));
-        _polygonPath.insert(nextIndex, QVariant::fromValue(newVertex));
+        int previousCount = _vertices.count();
+        if (_polygonModelCreated) {
+            _polygonModel.insert(nextIndex, new QGCQGeoCoordinate(newVertex, this));
+        }
+        _vertices.insert(nextIndex, newVertex);
+        _verticesChanged(previousCount);
+        setDirty(true);
         emit pathChanged();
     }
 }
 
 void QGCMapPolygon::appendVertex(const QGeoCoordinate& coordinate)
 {
-    _polygonPath.append(QVariant::fromValue(coordinate));
-    _polygonModel.append(new QGCQGeoCoordinate(coordinate, this));
+    int previousCount = _vertices.count();
+
+    _vertices.append(coordinate);
+    if (_polygonModelCreated) {
+        _polygonModel.append(new QGCQGeoCoordinate(coordinate, this));
+    }
+    _verticesChanged(previousCount);
+    setDirty(true);
     emit pathChanged();
 }
 
 void QGCMapPolygon::appendVertices(const QList<QGeoCoordinate>& coordinates)
 {
-    QList<QObject*> objects;
+    int previousCount = _vertices.count();
 
     _beginResetIfNotActive();
+    _vertices.reserve(_vertices.count() + coordinates.count());
     for (const QGeoCoordinate& coordinate: coordinates) {
-        objects.append(new QGCQGeoCoordinate(coordinate, this));
-        _polygonPath.append(QVariant::fromValue(coordinate));
+        _vertices.append(coordinate);
+    }
+    if (_polygonModelCreated && coordinates.count()) {
+        QList<QObject*> objects;
+        for (const QGeoCoordinate& coordinate: coordinates) {
+            objects.append(new QGCQGeoCoordinate(coordinate, this));
+        }
+        _polygonModel.append(objects);
+    }
+    _verticesChanged(previousCount);
+    if (coordinates.count()) {
+        setDirty(true);
     }
-    _polygonModel.append(objects);
     _endResetIfNotActive();
 
     emit pathChanged();
@@ -283,43 +372,43 @@ void QGCMapPolygon::appendVertices(const QList<QGeoCoordinate>& coordinates)
 
 void QGCMapPolygon::_polygonModelDirtyChanged(bool dirty)
 {
-    if (dirty) {
+    if (dirty && !_polygonModelLoading) {
         setDirty(true);
     }
 }
 
 void QGCMapPolygon::removeVertex(int vertexIndex)
 {
-    if (vertexIndex < 0 && vertexIndex > _polygonPath.length() - 1) {
-        qWarning() << "Call to removePolygonCoordinate with bad vertexIndex:count" << vertexIndex << _polygonPath.length();
+    if (vertexIndex < 0 || vertexIndex > _vertices.count() - 1) {
+        qWarning() << "Call to removePolygonCoordinate with bad vertexIndex:count" << vertexIndex << _vertices.count();
         return;
     }
 
-    if (_polygonPath.length() <= 3) {
+    if (_vertices.count() <= 3) {
         // Don't allow the user to trash the polygon
         return;
     }
 
-    QObject* coordObj = _polygonModel.removeAt(vertexIndex);
-    coordObj->deleteLater();
+    if (_polygonModelCreated) {
+        QObject* coordObj = _polygonModel.removeAt(vertexIndex);
+        coordObj->deleteLater();
+    }
 
-    _polygonPath.removeAt(vertexIndex);
+    int previousCount = _vertices.count();
+    _vertices.remove(vertexIndex);
+    _verticesChanged(previousCount);
+    setDirty(true);
     emit pathChanged();
 }
 
-void QGCMapPolygon::_polygonModelCountChanged(int count)
-{
-    emit countChanged(count);
-}
-
 void QGCMapPolygon::_updateCenter(void)
 {
     if (!_ignoreCenterUpdates) {
         QGeoCoordinate center;
 
-        if (_polygonPath.count() > 2) {
+        if (_vertices.count() > 2) {
             QPointF centroid(0, 0);
-            QPolygonF polygonF = _toPolygonF();
+            const QPolygonF& polygonF = _toPolygonF();
             for (int i=0; i<polygonF.count(); i++) {
                 centroid += polygonF[i];
             }
@@ -342,7 +431,7 @@ void QGCMapPolygon::setCenter(QGeoCoordinate newCenter)
         double azimuth = _center.azimuthTo(newCenter);
 
         for (int i=0; i<count(); i++) {
-            QGeoCoordinate oldVertex = _polygonPath[i].value<QGeoCoordinate>();
+            QGeoCoordinate oldVertex = _vertices[i];
             QGeoCoordinate newVertex = oldVertex.atDistanceAndAzimuth(distance, azimuth);
             adjustVertex(i, newVertex);
         }
@@ -377,35 +466,17 @@ void QGCMapPolygon::setInteractive(bool interactive)
 
 QGeoCoordinate QGCMapPolygon::vertexCoordinate(int vertex) const
 {
-    if (vertex >= 0 && vertex < _polygonPath.count()) {
-        return _polygonPath[vertex].value<QGeoCoordinate>();
+    if (vertex >= 0 && vertex < _vertices.count()) {
+        return _vertices[vertex];
     } else {
-        qWarning() << "QGCMapPolygon::vertexCoordinate bad vertex requested:count" << vertex << _polygonPath.count();
+        qWarning() << "QGCMapPolygon::vertexCoordinate bad vertex requested:count" << vertex << _vertices.count();
         return QGeoCoordinate();
     }
 }
 
 QList<QPointF> QGCMapPolygon::nedPolygon(void) const
 {
-    QList<QPointF>  nedPolygon;
-
-    if (count() > 0) {
-        QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
-
-        for (int i=0; i<_polygonModel.count(); i++) {
-            double y, x, down;
-            QGeoCoordinate vertex = vertexCoordinate(i);
-            if (i == 0) {
-                // This avoids a nan calculation that comes out of convertGeoToNed
-                x = y = 0;
-            } else {
-                convertGeoToNed(vertex, tangentOrigin, &y, &x, &down);
-            }
-            nedPolygon += QPointF(x, y);
-        }
-    }
-
-    return nedPolygon;
+    return _toPolygonF().toList();
 }
 
 
@@ -471,6 +542,12 @@ bool QGCMapPolygon::loadKMLOrSHPFile(const QString& file)
         return false;
     }
 
+    // Detailed boundaries can have far more vertices than are useful for planning
+    double tolerance = qgcApp()->toolbox()->settingsManager()->planViewSettings()->importSimplifyTolerance()->rawValue().toDouble();
+    if (tolerance > 0) {
+        rgCoords = simplifyGeoPath(rgCoords, tolerance, true /* closed */);
+    }
+
     _beginResetIfNotActive();
     clear();
     appendVertices(rgCoords);
@@ -479,16 +556,28 @@ bool QGCMapPolygon::loadKMLOrSHPFile(const QString& file)
     return true;
 }
 
+void QGCMapPolygon::simplify(double tolerance)
+{
+    QList<QGeoCoordinate> rgSimplified = simplifyGeoPath(coordinateList(), tolerance, true /* closed */);
+
+    if (rgSimplified.count() != count()) {
+        _beginResetIfNotActive();
+        clear();
+        appendVertices(rgSimplified);
+        _endResetIfNotActive();
+    }
+}
+
 double QGCMapPolygon::area(void) const
 {
     // https://www.mathopenref.com/coordpolygonarea2.html
 
-    if (_polygonPath.count() < 3) {
+    if (_vertices.count() < 3) {
         return 0;
     }
 
     double coveredArea = 0.0;
-    QList<QPointF> nedVertices = nedPolygon();
+    const QPolygonF& nedVertices = _toPolygonF();
     for (int i=0; i<nedVertices.count(); i++) {
         if (i != 0) {
             coveredArea += nedVertices[i - 1].x() * nedVertices[i].y() - nedVertices[i].x() * nedVertices[i -1].y();
@@ -501,14 +590,14 @@ double QGCMapPolygon::area(void) const
 
 void QGCMapPolygon::verifyClockwiseWinding(void)
 {
-    if (_polygonPath.count() <= 2) {
+    if (_vertices.count() <= 2) {
         return;
     }
 
     double sum = 0;
-    for (int i=0; i<_polygonPath.count(); i++) {
-        QGeoCoordinate coord1 = _polygonPath[i].value<QGeoCoordinate>();
-        QGeoCoordinate coord2 = (i == _polygonPath.count() - 1) ? _polygonPath[0].value<QGeoCoordinate>() : _polygonPath[i+1].value<QGeoCoordinate>();
+    for (int i=0; i<_vertices.count(); i++) {
+        QGeoCoordinate coord1 = _vertices[i];
+        QGeoCoordinate coord2 = (i == _vertices.count() - 1) ? _vertices[0] : _vertices[i+1];
 
         sum += (coord2.longitude() - coord1.longitude()) * (coord2.latitude() + coord1.latitude());
     }
@@ -517,8 +606,8 @@ void QGCMapPolygon::verifyClockwiseWinding(void)
         // Winding is counter-clockwise and needs reversal
 
         QList<QGeoCoordinate> rgReversed;
-        for (const QVariant& varCoord: _polygonPath) {
-            rgReversed.prepend(varCoord.value<QGeoCoordinate>());
+        for (const QGeoCoordinate& vertex: _vertices) {
+            rgReversed.prepend(vertex);
         }
 
         _beginResetIfNotActive();
@@ -13,12 +13,15 @@
 #include <QObject>
 #include <QGeoCoordinate>
 #include <QVariantList>
+#include <QVector>
 #include <QPolygon>
 
 #include "QmlObjectListModel.h"
 
 /// The QGCMapPolygon class provides a polygon which can be displayed on a map using a map visuals control.
-/// It maintains a representation of the polygon on QVariantList and QmlObjectListModel format.
+/// Vertices are stored by value. The QVariantList path and the projected geometry used for containment and area are
+/// cached until the next edit. The QmlObjectListModel of vertex objects is only created once it is requested, which
+/// is normally when the polygon is edited interactively.
 class QGCMapPolygon : public QObject
 {
     Q_OBJECT
@@ -58,10 +61,14 @@ public:
     /// Offsets the current polygon edges by the specified distance in meters
     Q_INVOKABLE void offset(double distance);
 
-    /// Loads a polygon from a KML/SH{ file
+    /// Loads a polygon from a KML/SH{ file. The polygon is simplified using the importSimplifyTolerance plan view setting.
     /// @return true: success
     Q_INVOKABLE bool loadKMLOrSHPFile(const QString& file);
 
+    /// Removes vertices which are within the specified distance of the simplified polygon
+    ///     @param tolerance Distance in meters
+    Q_INVOKABLE void simplify(double tolerance);
+
     /// Returns the path in a list of QGeoCoordinate's format
     QList<QGeoCoordinate> coordinateList(void) const;
 
@@ -93,18 +100,18 @@ public:
 
     // Property methods
 
-    int             count       (void) const { return _polygonPath.count(); }
+    int             count       (void) const { return _vertices.count(); }
     bool            dirty       (void) const { return _dirty; }
     void            setDirty    (bool dirty);
     QGeoCoordinate  center      (void) const { return _center; }
     bool            centerDrag  (void) const { return _centerDrag; }
     bool            interactive (void) const { return _interactive; }
-    bool            isValid     (void) const { return _polygonModel.count() >= 3; }
-    bool            empty       (void) const { return _polygonModel.count() == 0; }
+    bool            isValid     (void) const { return _vertices.count() >= 3; }
+    bool            empty       (void) const { return _vertices.count() == 0; }
 
-    QVariantList        path        (void) const { return _polygonPath; }
-    QmlObjectListModel* qmlPathModel(void) { return &_polygonModel; }
-    QmlObjectListModel& pathModel   (void) { return _polygonModel; }
+    QVariantList        path        (void) const;
+    QmlObjectListModel* qmlPathModel(void);
+    QmlObjectListModel& pathModel   (void) { return *qmlPathModel(); }
 
     void setPath        (const QList<QGeoCoordinate>& path);
     void setPath        (const QVariantList& path);
@@ -126,20 +133,27 @@ signals:
     bool isEmptyChanged     (void);
 
 private slots:
-    void _polygonModelCountChanged(int count);
     void _polygonModelDirtyChanged(bool dirty);
     void _updateCenter(void);
 
 private:
-    void            _init                   (void);
-    QPolygonF       _toPolygonF             (void) const;
-    QGeoCoordinate  _coordFromPointF        (const QPointF& point) const;
-    QPointF         _pointFFromCoord        (const QGeoCoordinate& coordinate) const;
-    void            _beginResetIfNotActive  (void);
-    void            _endResetIfNotActive    (void);
-
-    QVariantList        _polygonPath;
-    QmlObjectListModel  _polygonModel;
+    void                _init                   (void);
+    const QPolygonF&    _toPolygonF             (void) const;
+    QGeoCoordinate      _coordFromPointF        (const QPointF& point) const;
+    QPointF             _pointFFromCoord        (const QGeoCoordinate& coordinate) const;
+    void                _beginResetIfNotActive  (void);
+    void                _endResetIfNotActive    (void);
+    void                _verticesChanged        (int previousCount);
+
+    QVector<QGeoCoordinate> _vertices;
+    mutable QVariantList    _pathCache;
+    mutable bool            _pathCacheValid;
+    mutable QPolygonF       _polygonFCache;         ///< Vertices on the tangent plane at the first vertex, x: east, y: north
+    mutable QRectF          _polygonFBounds;
+    mutable bool            _polygonFCacheValid;
+    QmlObjectListModel      _polygonModel;
+    bool                    _polygonModelCreated;   ///< false: vertex objects have not been requested yet
+    bool                    _polygonModelLoading;
     bool                _dirty;
     QGeoCoordinate      _center;
     bool                _centerDrag;
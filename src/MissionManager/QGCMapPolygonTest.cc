@@ -10,6 +10,7 @@
 #include "QGCMapPolygonTest.h"
 #include "QGCApplication.h"
 #include "QGCQGeoCoordinate.h"
+#include "ShapeFileHelper.h"
 
 QGCMapPolygonTest::QGCMapPolygonTest(void)
 {
@@ -219,3 +220,132 @@ void QGCMapPolygonTest::_testKMLLoad(void)
     QVERIFY(!_mapPolygon->loadKMLOrSHPFile(QStringLiteral(":/unittest/PolygonBadCoordinatesNode.kml")));
     checkExpectedMessageBox();
 }
+
+void QGCMapPolygonTest::_testKMLLoadFeatures(void)
+{
+    ShapeFileHelper::Features_t features;
+    QString                     errorString;
+    double                      lastProgress = 0;
+
+    QVERIFY(ShapeFileHelper::loadFeaturesFromFile(QStringLiteral(":/unittest/ShapeImportMultiFeature.kml"), features, errorString, [&lastProgress](double progress) { lastProgress = progress; }));
+    QVERIFY(errorString.isEmpty());
+    QCOMPARE(lastProgress, 1.0);
+
+    // Both polygons of the multi geometry without the hole, the corridor, but not the point
+    QCOMPARE(features.count(), 3);
+
+    QCOMPARE(features[0].type, ShapeFileHelper::Polygon);
+    QCOMPARE(features[0].coordinates.count(), 4);
+    QCOMPARE(features[0].attributes[QStringLiteral("name")].toString(), QStringLiteral("Parcel 1"));
+    QCOMPARE(features[0].attributes[QStringLiteral("owner")].toString(), QStringLiteral("Field Ops"));
+
+    QCOMPARE(features[1].type, ShapeFileHelper::Polygon);
+    QCOMPARE(features[1].coordinates.count(), 4);
+    QCOMPARE(features[1].attributes, features[0].attributes);
+
+    QCOMPARE(features[2].type, ShapeFileHelper::Polyline);
+    QCOMPARE(features[2].coordinates.count(), 3);
+    QCOMPARE(features[2].attributes[QStringLiteral("name")].toString(), QStringLiteral("Corridor 1"));
+    QCOMPARE(features[2].attributes[QStringLiteral("width")].toString(), QStringLiteral("30"));
+
+    // Polygons are returned with clockwise winding, matching the single polygon load
+    QList<QGeoCoordinate> rgPolygon;
+    QVERIFY(ShapeFileHelper::loadPolygonFromFile(QStringLiteral(":/unittest/ShapeImportMultiFeature.kml"), rgPolygon, errorString));
+    QCOMPARE(features[0].coordinates, rgPolygon);
+
+    QVERIFY(!ShapeFileHelper::loadFeaturesFromFile(QStringLiteral(":/unittest/PolygonBadXml.kml"), features, errorString));
+    QVERIFY(!errorString.isEmpty());
+    QCOMPARE(features.count(), 0);
+
+    // Cancelled load
+    QVERIFY(!ShapeFileHelper::loadFeaturesFromFile(QStringLiteral(":/unittest/ShapeImportMultiFeature.kml"), features, errorString, ShapeFileHelper::ProgressFunc_t(), []() { return true; }));
+}
+
+void QGCMapPolygonTest::_testLazyPathModel(void)
+{
+    // Vertex objects created on first request must match the edits made before that
+    QGCMapPolygon polygon;
+    polygon.appendVertices(_polyPoints);
+    QGeoCoordinate adjustCoord(_polyPoints[1].latitude() + 0.001, _polyPoints[1].longitude());
+    polygon.adjustVertex(1, adjustCoord);
+    polygon.setDirty(false);
+
+    QSignalSpy dirtySpy(&polygon, SIGNAL(dirtyChanged(bool)));
+    QmlObjectListModel* pathModel = polygon.qmlPathModel();
+    QCOMPARE(pathModel->count(), _polyPoints.count());
+    QCOMPARE(pathModel->value<QGCQGeoCoordinate*>(0)->coordinate(), _polyPoints[0]);
+    QCOMPARE(pathModel->value<QGCQGeoCoordinate*>(1)->coordinate(), adjustCoord);
+    QCOMPARE(pathModel->value<QGCQGeoCoordinate*>(3)->coordinate(), _polyPoints[3]);
+
+    // Creating the model is not an edit
+    QVERIFY(!pathModel->dirty());
+    QVERIFY(!polygon.dirty());
+    QCOMPARE(dirtySpy.count(), 0);
+    QCOMPARE(polygon.qmlPathModel(), pathModel);
+
+    // Once created the model follows the polygon
+    polygon.removeVertex(0);
+    QCOMPARE(pathModel->count(), _polyPoints.count() - 1);
+    QCOMPARE(pathModel->value<QGCQGeoCoordinate*>(0)->coordinate(), adjustCoord);
+    polygon.setPath(_polyPoints);
+    QCOMPARE(pathModel->count(), _polyPoints.count());
+    QCOMPARE(pathModel->value<QGCQGeoCoordinate*>(1)->coordinate(), _polyPoints[1]);
+}
+
+/// The cached path and projected geometry must follow every edit
+void QGCMapPolygonTest::_testGeometryCache(void)
+{
+    _mapPolygon->appendVertices(_polyPoints);
+
+    QGeoCoordinate nearSouthEast(_polyPoints[2].latitude() + 0.0005, _polyPoints[2].longitude() - 0.0005);
+    QVERIFY(_mapPolygon->containsCoordinate(nearSouthEast));
+    QVERIFY(_mapPolygon->containsCoordinate(_mapPolygon->center()));
+    QVERIFY(!_mapPolygon->containsCoordinate(QGeoCoordinate(_polyPoints[0].latitude() + 0.001, _polyPoints[0].longitude())));
+    double fullArea = _mapPolygon->area();
+    QVERIFY(fullArea > 0);
+    QCOMPARE(_mapPolygon->path().count(), _polyPoints.count());
+
+    // Moving the south east corner to the center cuts the polygon along the diagonal
+    QGeoCoordinate center = _mapPolygon->center();
+    _mapPolygon->adjustVertex(2, center);
+    QVERIFY(!_mapPolygon->containsCoordinate(nearSouthEast));
+    QCOMPARE(_mapPolygon->path()[2].value<QGeoCoordinate>(), center);
+    QVERIFY(qAbs(_mapPolygon->area() - fullArea / 2) < fullArea * 0.01);
+
+    _mapPolygon->setPath(_polyPoints);
+    QVERIFY(_mapPolygon->containsCoordinate(nearSouthEast));
+    QCOMPARE(_mapPolygon->area(), fullArea);
+
+    _mapPolygon->removeVertex(1);
+    QCOMPARE(_mapPolygon->path().count(), 3);
+    QCOMPARE(_mapPolygon->path()[1].value<QGeoCoordinate>(), _polyPoints[2]);
+    QVERIFY(qAbs(_mapPolygon->area() - fullArea / 2) < fullArea * 0.01);
+
+    _mapPolygon->clear();
+    QVERIFY(!_mapPolygon->containsCoordinate(nearSouthEast));
+    QCOMPARE(_mapPolygon->area(), 0.0);
+    QCOMPARE(_mapPolygon->path().count(), 0);
+}
+
+void QGCMapPolygonTest::_testSimplify(void)
+{
+    // Add a vertex in the middle of each side
+    QList<QGeoCoordinate> rgVertices;
+    for (int i=0; i<_polyPoints.count(); i++) {
+        const QGeoCoordinate& next = _polyPoints[(i + 1) % _polyPoints.count()];
+        rgVertices.append(_polyPoints[i]);
+        rgVertices.append(_polyPoints[i].atDistanceAndAzimuth(_polyPoints[i].distanceTo(next) / 2, _polyPoints[i].azimuthTo(next)));
+    }
+    _mapPolygon->appendVertices(rgVertices);
+    double area = _mapPolygon->area();
+
+    _mapPolygon->simplify(1);
+    QCOMPARE(_mapPolygon->coordinateList(), _polyPoints);
+    QCOMPARE(_pathModel->count(), _polyPoints.count());
+    QVERIFY(qAbs(_mapPolygon->area() - area) < area * 0.001);
+
+    // Nothing left to remove
+    _mapPolygon->setDirty(false);
+    _mapPolygon->simplify(1);
+    QVERIFY(!_mapPolygon->dirty());
+}
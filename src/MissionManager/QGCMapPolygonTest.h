@@ -29,6 +29,10 @@ private slots:
     void _testDirty(void);
     void _testVertexManipulation(void);
     void _testKMLLoad(void);
+    void _testKMLLoadFeatures(void);
+    void _testLazyPathModel(void);
+    void _testGeometryCache(void);
+    void _testSimplify(void);
 
 private:
     enum {
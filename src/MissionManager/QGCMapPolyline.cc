@@ -13,6 +13,7 @@
 #include "QGCQGeoCoordinate.h"
 #include "QGCApplication.h"
 #include "KMLFileHelper.h"
+#include "SettingsManager.h"
 
 #include <QGeoRectangle>
 #include <QDebug>
@@ -25,6 +26,10 @@ const char* QGCMapPolyline::jsonPolylineKey = "polyline";
 
 QGCMapPolyline::QGCMapPolyline(QObject* parent)
     : QObject               (parent)
+    , _pathCacheValid       (false)
+    , _nedCacheValid        (false)
+    , _polylineModelCreated (false)
+    , _polylineModelLoading (false)
     , _dirty                (false)
     , _interactive          (false)
     , _resetActive          (false)
@@ -34,6 +39,10 @@ QGCMapPolyline::QGCMapPolyline(QObject* parent)
 
 QGCMapPolyline::QGCMapPolyline(const QGCMapPolyline& other, QObject* parent)
     : QObject               (parent)
+    , _pathCacheValid       (false)
+    , _nedCacheValid        (false)
+    , _polylineModelCreated (false)
+    , _polylineModelLoading (false)
     , _dirty                (false)
     , _interactive          (false)
     , _resetActive          (false)
@@ -47,9 +56,8 @@ const QGCMapPolyline& QGCMapPolyline::operator=(const QGCMapPolyline& other)
 {
     clear();
 
-    QVariantList vertices = other.path();
-    for (int i=0; i<vertices.count(); i++) {
-        appendVertex(vertices[i].value<QGeoCoordinate>());
+    for (const QGeoCoordinate& vertex: other._vertices) {
+        appendVertex(vertex);
     }
 
     setDirty(true);
@@ -60,18 +68,74 @@ const QGCMapPolyline& QGCMapPolyline::operator=(const QGCMapPolyline& other)
 void QGCMapPolyline::_init(void)
 {
     connect(&_polylineModel, &QmlObjectListModel::dirtyChanged, this, &QGCMapPolyline::_polylineModelDirtyChanged);
-    connect(&_polylineModel, &QmlObjectListModel::countChanged, this, &QGCMapPolyline::_polylineModelCountChanged);
 
     connect(this, &QGCMapPolyline::countChanged, this, &QGCMapPolyline::isValidChanged);
     connect(this, &QGCMapPolyline::countChanged, this, &QGCMapPolyline::isEmptyChanged);
 }
 
+/// Drops the cached path and geometry after an edit and signals count changes
+void QGCMapPolyline::_verticesChanged(int previousCount)
+{
+    _pathCacheValid = false;
+    _nedCacheValid  = false;
+
+    if (_vertices.count() != previousCount) {
+        emit countChanged(_vertices.count());
+    }
+}
+
+QVariantList QGCMapPolyline::path(void) const
+{
+    if (!_pathCacheValid) {
+        _pathCache.clear();
+        _pathCache.reserve(_vertices.count());
+        for (const QGeoCoordinate& vertex: _vertices) {
+            _pathCache.append(QVariant::fromValue(vertex));
+        }
+        _pathCacheValid = true;
+    }
+
+    return _pathCache;
+}
+
+QmlObjectListModel* QGCMapPolyline::qmlPathModel(void)
+{
+    if (!_polylineModelCreated) {
+        _polylineModelCreated = true;
+
+        if (_vertices.count()) {
+            QList<QObject*> objects;
+            for (const QGeoCoordinate& vertex: _vertices) {
+                objects.append(new QGCQGeoCoordinate(vertex, this));
+            }
+
+            // Creating the vertex objects is not an edit of the polyline
+            _polylineModelLoading = true;
+            if (!_resetActive) {
+                _polylineModel.beginReset();
+            }
+            _polylineModel.append(objects);
+            if (!_resetActive) {
+                _polylineModel.endReset();
+            }
+            _polylineModel.setDirty(false);
+            _polylineModelLoading = false;
+        }
+    }
+
+    return &_polylineModel;
+}
+
 void QGCMapPolyline::clear(void)
 {
-    _polylinePath.clear();
+    _vertices.clear();
+    _pathCacheValid = _nedCacheValid = false;
     emit pathChanged();
 
-    _polylineModel.clearAndDeleteContents();
+    if (_polylineModelCreated) {
+        _polylineModel.clearAndDeleteContents();
+    }
+    emit countChanged(0);
 
     emit cleared();
 
@@ -80,9 +144,12 @@ void QGCMapPolyline::clear(void)
 
 void QGCMapPolyline::adjustVertex(int vertexIndex, const QGeoCoordinate coordinate)
 {
-    _polylinePath[vertexIndex] = QVariant::fromValue(coordinate);
+    _vertices[vertexIndex] = coordinate;
+    _verticesChanged(_vertices.count());
     emit pathChanged();
-    _polylineModel.value<QGCQGeoCoordinate*>(vertexIndex)->setCoordinate(coordinate);
+    if (_polylineModelCreated) {
+        _polylineModel.value<QGCQGeoCoordinate*>(vertexIndex)->setCoordinate(coordinate);
+    }
     setDirty(true);
 }
 
@@ -90,7 +157,7 @@ void QGCMapPolyline::setDirty(bool dirty)
 {
     if (_dirty != dirty) {
         _dirty = dirty;
-        if (!dirty) {
+        if (!dirty && _polylineModelCreated) {
             _polylineModel.setDirty(false);
         }
         emit dirtyChanged(dirty);
@@ -100,9 +167,8 @@ QGeoCoordinate QGCMapPolyline::_coordFromPointF(const QPointF& point) const
 {
     QGeoCoordinate coord;
 
-    if (_polylinePath.count() > 0) {
-        QGeoCoordinate tangentOrigin = _polylinePath[0].value<QGeoCoordinate>();
-        convertNedToGeo(-point.y(), point.x(), 0, tangentOrigin, &coord);
+    if (_vertices.count() > 0) {
+        convertNedToGeo(-point.y(), point.x(), 0, _vertices[0], &coord);
     }
 
     return coord;
@@ -110,11 +176,10 @@ QGeoCoordinate QGCMapPolyline::_coordFromPointF(const QPointF& point) const
 
 QPointF QGCMapPolyline::_pointFFromCoord(const QGeoCoordinate& coordinate) const
 {
-    if (_polylinePath.count() > 0) {
+    if (_vertices.count() > 0) {
         double y, x, down;
-        QGeoCoordinate tangentOrigin = _polylinePath[0].value<QGeoCoordinate>();
 
-        convertGeoToNed(coordinate, tangentOrigin, &y, &x, &down);
+        convertGeoToNed(coordinate, _vertices[0], &y, &x, &down);
         return QPointF(x, -y);
     }
 
@@ -123,14 +188,18 @@ QPointF QGCMapPolyline::_pointFFromCoord(const QGeoCoordinate& coordinate) const
 
 void QGCMapPolyline::setPath(const QList<QGeoCoordinate>& path)
 {
+    int previousCount = _vertices.count();
+
     _beginResetIfNotActive();
 
-    _polylinePath.clear();
-    _polylineModel.clearAndDeleteContents();
-    for (const QGeoCoordinate& coord: path) {
-        _polylinePath.append(QVariant::fromValue(coord));
-        _polylineModel.append(new QGCQGeoCoordinate(coord, this));
+    _vertices = path.toVector();
+    if (_polylineModelCreated) {
+        _polylineModel.clearAndDeleteContents();
+        for (const QGeoCoordinate& coord: path) {
+            _polylineModel.append(new QGCQGeoCoordinate(coord, this));
+        }
     }
+    _verticesChanged(previousCount);
 
     setDirty(true);
 
@@ -139,16 +208,12 @@ void QGCMapPolyline::setPath(const QList<QGeoCoordinate>& path)
 
 void QGCMapPolyline::setPath(const QVariantList& path)
 {
-    _beginResetIfNotActive();
+    QList<QGeoCoordinate> coords;
 
-    _polylinePath = path;
-    _polylineModel.clearAndDeleteContents();
-    for (int i=0; i<_polylinePath.count(); i++) {
-        _polylineModel.append(new QGCQGeoCoordinate(_polylinePath[i].value<QGeoCoordinate>(), this));
+    for (const QVariant& varCoord: path) {
+        coords.append(varCoord.value<QGeoCoordinate>());
     }
-    setDirty(true);
-
-    _endResetIfNotActive();
+    setPath(coords);
 }
 
 
@@ -156,7 +221,7 @@ void QGCMapPolyline::saveToJson(QJsonObject& json)
 {
     QJsonValue jsonValue;
 
-    JsonHelper::saveGeoCoordinateArray(_polylinePath, false /* writeAltitude*/, jsonValue);
+    JsonHelper::saveGeoCoordinateArray(coordinateList(), false /* writeAltitude*/, jsonValue);
     json.insert(jsonPolylineKey, jsonValue);
     setDirty(false);
 }
@@ -174,13 +239,18 @@ bool QGCMapPolyline::loadFromJson(const QJsonObject& json, bool required, QStrin
         return true;
     }
 
-    if (!JsonHelper::loadGeoCoordinateArray(json[jsonPolylineKey], false /* altitudeRequired */, _polylinePath, errorString)) {
+    QList<QGeoCoordinate> rgCoords;
+    if (!JsonHelper::loadGeoCoordinateArray(json[jsonPolylineKey], false /* altitudeRequired */, rgCoords, errorString)) {
         return false;
     }
 
-    for (int i=0; i<_polylinePath.count(); i++) {
-        _polylineModel.append(new QGCQGeoCoordinate(_polylinePath[i].value<QGeoCoordinate>(), this));
+    _vertices = rgCoords.toVector();
+    if (_polylineModelCreated) {
+        for (const QGeoCoordinate& coord: rgCoords) {
+            _polylineModel.append(new QGCQGeoCoordinate(coord, this));
+        }
     }
+    _verticesChanged(0);
 
     setDirty(false);
     emit pathChanged();
@@ -190,24 +260,18 @@ bool QGCMapPolyline::loadFromJson(const QJsonObject& json, bool required, QStrin
 
 QList<QGeoCoordinate> QGCMapPolyline::coordinateList(void) const
 {
-    QList<QGeoCoordinate> coords;
-
-    for (int i=0; i<_polylinePath.count(); i++) {
-        coords.append(_polylinePath[i].value<QGeoCoordinate>());
-    }
-
-    return coords;
+    return _vertices.toList();
 }
 
 void QGCMapPolyline::splitSegment(int vertexIndex)
 {
     int nextIndex = vertexIndex + 1;
-    if (nextIndex > _polylinePath.length() - 1) {
+    if (nextIndex > _vertices.count() - 1) {
         return;
     }
 
-    QGeoCoordinate firstVertex = _polylinePath[vertexIndex].value<QGeoCoordinate>();
-    QGeoCoordinate nextVertex = _polylinePath[nextIndex].value<QGeoCoordinate>();
+    QGeoCoordinate firstVertex = _vertices[vertexIndex];
+    QGeoCoordinate nextVertex = _vertices[nextIndex];
 
     double distance = firstVertex.distanceTo(nextVertex);
     double azimuth = firstVertex.azimuthTo(nextVertex);
@@ -216,35 +280,51 @@ void QGCMapPolyline::splitSegment(int vertexIndex)
     if (nextIndex == 0) {
         appendVertex(newVertex);
     } else {
-        _polylineModel.insert(nextIndex, new QGCQGeoCoordinate(newVertex, this));
-        _polylinePath.insert(nextIndex, QVariant::fromValue(newVertex));
+        int previousCount = _vertices.count();
+        if (_polylineModelCreated) {
+            _polylineModel.insert(nextIndex, new QGCQGeoCoordinate(newVertex, this));
+        }
+        _vertices.insert(nextIndex, newVertex);
+        _verticesChanged(previousCount);
+        setDirty(true);
         emit pathChanged();
     }
 }
 
 void QGCMapPolyline::appendVertex(const QGeoCoordinate& coordinate)
 {
-    _polylinePath.append(QVariant::fromValue(coordinate));
-    _polylineModel.append(new QGCQGeoCoordinate(coordinate, this));
+    int previousCount = _vertices.count();
+
+    _vertices.append(coordinate);
+    if (_polylineModelCreated) {
+        _polylineModel.append(new QGCQGeoCoordinate(coordinate, this));
+    }
+    _verticesChanged(previousCount);
+    setDirty(true);
     emit pathChanged();
 }
 
 void QGCMapPolyline::removeVertex(int vertexIndex)
 {
-    if (vertexIndex < 0 || vertexIndex > _polylinePath.length() - 1) {
-        qWarning() << "Call to removeVertex with bad vertexIndex:count" << vertexIndex << _polylinePath.length();
+    if (vertexIndex < 0 || vertexIndex > _vertices.count() - 1) {
+        qWarning() << "Call to removeVertex with bad vertexIndex:count" << vertexIndex << _vertices.count();
         return;
     }
 
-    if (_polylinePath.length() <= 2) {
+    if (_vertices.count() <= 2) {
         // Don't allow the user to trash the polyline
         return;
     }
 
-    QObject* coordObj = _polylineModel.removeAt(vertexIndex);
-    coordObj->deleteLater();
+    if (_polylineModelCreated) {
+        QObject* coordObj = _polylineModel.removeAt(vertexIndex);
+        coordObj->deleteLater();
+    }
 
-    _polylinePath.removeAt(vertexIndex);
+    int previousCount = _vertices.count();
+    _vertices.remove(vertexIndex);
+    _verticesChanged(previousCount);
+    setDirty(true);
     emit pathChanged();
 }
 
@@ -258,8 +338,8 @@ void QGCMapPolyline::setInteractive(bool interactive)
 
 QGeoCoordinate QGCMapPolyline::vertexCoordinate(int vertex) const
 {
-    if (vertex >= 0 && vertex < _polylinePath.count()) {
-        return _polylinePath[vertex].value<QGeoCoordinate>();
+    if (vertex >= 0 && vertex < _vertices.count()) {
+        return _vertices[vertex];
     } else {
         qWarning() << "QGCMapPolyline::vertexCoordinate bad vertex requested";
         return QGeoCoordinate();
@@ -268,25 +348,27 @@ QGeoCoordinate QGCMapPolyline::vertexCoordinate(int vertex) const
 
 QList<QPointF> QGCMapPolyline::nedPolyline(void)
 {
-    QList<QPointF>  nedPolyline;
-
-    if (count() > 0) {
-        QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
-
-        for (int i=0; i<_polylinePath.count(); i++) {
-            double y, x, down;
-            QGeoCoordinate vertex = vertexCoordinate(i);
-            if (i == 0) {
-                // This avoids a nan calculation that comes out of convertGeoToNed
-                x = y = 0;
-            } else {
-                convertGeoToNed(vertex, tangentOrigin, &y, &x, &down);
+    if (!_nedCacheValid) {
+        _nedCache.clear();
+
+        if (count() > 0) {
+            QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
+
+            for (int i=0; i<_vertices.count(); i++) {
+                double y, x, down;
+                if (i == 0) {
+                    // This avoids a nan calculation that comes out of convertGeoToNed
+                    x = y = 0;
+                } else {
+                    convertGeoToNed(_vertices[i], tangentOrigin, &y, &x, &down);
+                }
+                _nedCache += QPointF(x, y);
             }
-            nedPolyline += QPointF(x, y);
         }
+        _nedCacheValid = true;
     }
 
-    return nedPolyline;
+    return _nedCache;
 }
 
 
@@ -357,6 +439,11 @@ bool QGCMapPolyline::loadKMLFile(const QString& kmlFile)
         return false;
     }
 
+    double tolerance = qgcApp()->toolbox()->settingsManager()->planViewSettings()->importSimplifyTolerance()->rawValue().toDouble();
+    if (tolerance > 0) {
+        rgCoords = simplifyGeoPath(rgCoords, tolerance, false /* closed */);
+    }
+
     clear();
     appendVertices(rgCoords);
 
@@ -365,16 +452,23 @@ bool QGCMapPolyline::loadKMLFile(const QString& kmlFile)
     return true;
 }
 
-void QGCMapPolyline::_polylineModelDirtyChanged(bool dirty)
+void QGCMapPolyline::simplify(double tolerance)
 {
-    if (dirty) {
-        setDirty(true);
+    QList<QGeoCoordinate> rgSimplified = simplifyGeoPath(coordinateList(), tolerance, false /* closed */);
+
+    if (rgSimplified.count() != count()) {
+        _beginResetIfNotActive();
+        clear();
+        appendVertices(rgSimplified);
+        _endResetIfNotActive();
     }
 }
 
-void QGCMapPolyline::_polylineModelCountChanged(int count)
+void QGCMapPolyline::_polylineModelDirtyChanged(bool dirty)
 {
-    emit countChanged(count);
+    if (dirty && !_polylineModelLoading) {
+        setDirty(true);
+    }
 }
 
 
@@ -382,10 +476,8 @@ double QGCMapPolyline::length(void) const
 {
     double length = 0;
 
-    for (int i=0; i<_polylinePath.count() - 1; i++) {
-        QGeoCoordinate from = _polylinePath[i].value<QGeoCoordinate>();
-        QGeoCoordinate to = _polylinePath[i+1].value<QGeoCoordinate>();
-        length += from.distanceTo(to);
+    for (int i=0; i<_vertices.count() - 1; i++) {
+        length += _vertices[i].distanceTo(_vertices[i+1]);
     }
 
     return length;
@@ -393,14 +485,25 @@ double QGCMapPolyline::length(void) const
 
 void QGCMapPolyline::appendVertices(const QList<QGeoCoordinate>& coordinates)
 {
+    int previousCount = _vertices.count();
+
     _beginResetIfNotActive();
 
-    QList<QObject*> objects;
+    _vertices.reserve(_vertices.count() + coordinates.count());
     for (const QGeoCoordinate& coordinate: coordinates) {
-        objects.append(new QGCQGeoCoordinate(coordinate, this));
-        _polylinePath.append(QVariant::fromValue(coordinate));
+        _vertices.append(coordinate);
+    }
+    if (_polylineModelCreated && coordinates.count()) {
+        QList<QObject*> objects;
+        for (const QGeoCoordinate& coordinate: coordinates) {
+            objects.append(new QGCQGeoCoordinate(coordinate, this));
+        }
+        _polylineModel.append(objects);
+    }
+    _verticesChanged(previousCount);
+    if (coordinates.count()) {
+        setDirty(true);
     }
-    _polylineModel.append(objects);
 
     _endResetIfNotActive();
 }
@@ -12,9 +12,14 @@
 #include <QObject>
 #include <QGeoCoordinate>
 #include <QVariantList>
+#include <QVector>
+#include <QPointF>
 
 #include "QmlObjectListModel.h"
 
+/// The QGCMapPolyline class provides a polyline which can be displayed on a map using a map visuals control.
+/// Vertices are stored by value, the QVariantList path and NED geometry are cached until the next edit. The
+/// QmlObjectListModel of vertex objects is only created once it is requested.
 class QGCMapPolyline : public QObject
 {
     Q_OBJECT
@@ -50,10 +55,14 @@ public:
     /// @return Offset set of vertices
     QList<QGeoCoordinate> offsetPolyline(double distance);
 
-    /// Loads a polyline from a KML file
+    /// Loads a polyline from a KML file. The polyline is simplified using the importSimplifyTolerance plan view setting.
     /// @return true: success
     Q_INVOKABLE bool loadKMLFile(const QString& kmlFile);
 
+    /// Removes vertices which are within the specified distance of the simplified polyline
+    ///     @param tolerance Distance in meters
+    Q_INVOKABLE void simplify(double tolerance);
+
     Q_INVOKABLE void beginReset (void);
     Q_INVOKABLE void endReset   (void);
 
@@ -81,16 +90,16 @@ public:
     double length(void) const;
 
     // Property methods
-    int             count       (void) const { return _polylinePath.count(); }
+    int             count       (void) const { return _vertices.count(); }
     bool            dirty       (void) const { return _dirty; }
     void            setDirty    (bool dirty);
     bool            interactive (void) const { return _interactive; }
-    QVariantList    path        (void) const { return _polylinePath; }
-    bool            isValid     (void) const { return _polylineModel.count() >= 2; }
-    bool            empty       (void) const { return _polylineModel.count() == 0; }
+    QVariantList    path        (void) const;
+    bool            isValid     (void) const { return _vertices.count() >= 2; }
+    bool            empty       (void) const { return _vertices.count() == 0; }
 
-    QmlObjectListModel* qmlPathModel(void) { return &_polylineModel; }
-    QmlObjectListModel& pathModel   (void) { return _polylineModel; }
+    QmlObjectListModel* qmlPathModel(void);
+    QmlObjectListModel& pathModel   (void) { return *qmlPathModel(); }
 
     void setPath        (const QList<QGeoCoordinate>& path);
     void setPath        (const QVariantList& path);
@@ -108,7 +117,6 @@ signals:
     void isEmptyChanged     (void);
 
 private slots:
-    void _polylineModelCountChanged(int count);
     void _polylineModelDirtyChanged(bool dirty);
 
 private:
@@ -117,9 +125,16 @@ private:
     QPointF         _pointFFromCoord        (const QGeoCoordinate& coordinate) const;
     void            _beginResetIfNotActive  (void);
     void            _endResetIfNotActive    (void);
-
-    QVariantList        _polylinePath;
-    QmlObjectListModel  _polylineModel;
+    void            _verticesChanged        (int previousCount);
+
+    QVector<QGeoCoordinate> _vertices;
+    mutable QVariantList    _pathCache;
+    mutable bool            _pathCacheValid;
+    QList<QPointF>          _nedCache;
+    bool                    _nedCacheValid;
+    QmlObjectListModel      _polylineModel;
+    bool                    _polylineModelCreated;  ///< false: vertex objects have not been requested yet
+    bool                    _polylineModelLoading;
     bool                _dirty;
     bool                _interactive;
     bool                _resetActive;
@@ -116,6 +116,9 @@ void SurveyComplexItem::savePreset(const QString& name)
 {
     QJsonObject saveObject;
 
+    // Presets are saved outside of the mission, so nothing has completed the transects yet
+    completePendingWork();
+
     _saveWorker(saveObject);
     _savePresetJson(name, saveObject);
 }
@@ -142,7 +145,7 @@ void SurveyComplexItem::loadPreset(const QString& name)
 
     QJsonObject presetObject = _loadPresetJson(name);
     _loadV4V5(presetObject, 0, errorString, 5, true /* forPresets */);
-    _rebuildTransects();
+    _rebuildTransectsNow();
 }
 
 bool SurveyComplexItem::load(const QJsonObject& complexObject, int sequenceNumber, QString& errorString)
@@ -186,7 +189,7 @@ bool SurveyComplexItem::load(const QJsonObject& complexObject, int sequenceNumbe
         }
 
         // V2/3 doesn't include individual items so we need to rebuild manually
-        _rebuildTransects();
+        _rebuildTransectsNow();
     }
 
     return true;
@@ -460,7 +463,7 @@ bool SurveyComplexItem::_gridAngleIsNorthSouthTransects()
     return gridAngle < 45.0 || (gridAngle > 360.0 - 45.0) || (gridAngle > 90.0 + 45.0 && gridAngle < 270.0 - 45.0);
 }
 
-void SurveyComplexItem::_adjustTransectsToEntryPointLocation(QList<QList<QGeoCoordinate>>& transects)
+void SurveyComplexItem::_adjustTransectsToEntryPointLocation(int entryPoint, QList<QList<QGeoCoordinate>>& transects)
 {
     if (transects.count() == 0) {
         return;
@@ -469,10 +472,10 @@ void SurveyComplexItem::_adjustTransectsToEntryPointLocation(QList<QList<QGeoCoo
     bool reversePoints = false;
     bool reverseTransects = false;
 
-    if (_entryPoint == EntryLocationBottomLeft || _entryPoint == EntryLocationBottomRight) {
+    if (entryPoint == EntryLocationBottomLeft || entryPoint == EntryLocationBottomRight) {
         reversePoints = true;
     }
-    if (_entryPoint == EntryLocationTopRight || _entryPoint == EntryLocationBottomRight) {
+    if (entryPoint == EntryLocationTopRight || entryPoint == EntryLocationBottomRight) {
         reverseTransects = true;
     }
 
@@ -485,7 +488,7 @@ void SurveyComplexItem::_adjustTransectsToEntryPointLocation(QList<QList<QGeoCoo
         _reverseTransectOrder(transects);
     }
 
-    qCDebug(SurveyComplexItemLog) << "_adjustTransectsToEntryPointLocation Modified entry point:entryLocation" << transects.first().first() << _entryPoint;
+    qCDebug(SurveyComplexItemLog) << "_adjustTransectsToEntryPointLocation Modified entry point:entryLocation" << transects.first().first() << entryPoint;
 }
 
 QPointF SurveyComplexItem::_rotatePoint(const QPointF& point, const QPointF& origin, double angle)
@@ -773,23 +776,6 @@ double SurveyComplexItem::_turnaroundDistance(void) const
 }
 
 void SurveyComplexItem::_rebuildTransectsPhase1(void)
-{
-    bool split = splitConcavePolygons()->rawValue().toBool();
-	if (split) {
-		_rebuildTransectsPhase1WorkerSplitPolygons(false /* refly */);
-	} else {
-		_rebuildTransectsPhase1WorkerSinglePolygon(false /* refly */);
-	}
-    if (_refly90DegreesFact.rawValue().toBool()) {
-    	if (split) {
-    		_rebuildTransectsPhase1WorkerSplitPolygons(true /* refly */);
-    	} else {
-    		_rebuildTransectsPhase1WorkerSinglePolygon(true /* refly */);
-    	}
-    }
-}
-
-void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
 {
     if (_ignoreRecalc) {
         return;
@@ -802,24 +788,70 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         _loadedMissionItemsParent = nullptr;
     }
 
-    // First pass will clear old transect data, refly will append to existing data
-    if (!refly) {
-        _transects.clear();
-        _transectsPathHeightInfo.clear();
+    _transectsPathHeightInfo.clear();
+    _transects = _generateTransects(_transectInput(), []() { return false; });
+}
+
+SurveyComplexItem::TransectGenerator_t SurveyComplexItem::_transectGenerator(void) const
+{
+    TransectInput_t input = _transectInput();
+    return [input](const CancelledFunc_t& cancelled) { return _generateTransects(input, cancelled); };
+}
+
+SurveyComplexItem::TransectInput_t SurveyComplexItem::_transectInput(void) const
+{
+    TransectInput_t input;
+
+    input.polygon               = _surveyAreaPolygon.coordinateList();
+    input.gridAngle             = _gridAngleFact.rawValue().toDouble();
+    input.gridSpacing           = _cameraCalc.adjustedFootprintSide()->rawValue().toDouble();
+    input.entryPoint            = _entryPoint;
+    input.flyAlternateTransects = _flyAlternateTransectsFact.rawValue().toBool();
+    input.splitConcavePolygons  = _splitConcavePolygonsFact.rawValue().toBool();
+    input.refly90Degrees        = _refly90DegreesFact.rawValue().toBool();
+    input.hoverAndCapture       = triggerCamera() && hoverAndCaptureEnabled();
+    input.triggerDistance       = triggerDistance();
+    input.turnaroundDistance    = _hasTurnaround() ? _turnAroundDistanceFact.rawValue().toDouble() : 0;
+
+    return input;
+}
+
+/// Generates the transects from the input alone, may be called from any thread
+///     @param cancelled Polled between the expensive steps, generation stops early once it returns true
+SurveyComplexItem::Transects_t SurveyComplexItem::_generateTransects(const TransectInput_t& input, const CancelledFunc_t& cancelled)
+{
+    Transects_t transects;
+
+    if (input.polygon.count() < 3) {
+        return transects;
     }
 
-    if (_surveyAreaPolygon.count() < 3) {
-        return;
+    bool split = input.splitConcavePolygons;
+    if (split) {
+        _rebuildTransectsPhase1WorkerSplitPolygons(input, false /* refly */, transects, cancelled);
+    } else {
+        _rebuildTransectsPhase1WorkerSinglePolygon(input, false /* refly */, transects);
+    }
+    if (input.refly90Degrees && !cancelled()) {
+        if (split) {
+            _rebuildTransectsPhase1WorkerSplitPolygons(input, true /* refly */, transects, cancelled);
+        } else {
+            _rebuildTransectsPhase1WorkerSinglePolygon(input, true /* refly */, transects);
+        }
     }
 
-    // Convert polygon to NED
+    return transects;
+}
 
+/// Converts the polygon to NED relative to its first vertex
+static QList<QPointF> _polygonToNed(const QList<QGeoCoordinate>& polygon, const QGeoCoordinate& tangentOrigin)
+{
     QList<QPointF> polygonPoints;
-    QGeoCoordinate tangentOrigin = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(0)->coordinate();
-    qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 Convert polygon to NED - _surveyAreaPolygon.count():tangentOrigin" << _surveyAreaPolygon.count() << tangentOrigin;
-    for (int i=0; i<_surveyAreaPolygon.count(); i++) {
+
+    qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 Convert polygon to NED - polygon.count():tangentOrigin" << polygon.count() << tangentOrigin;
+    for (int i=0; i<polygon.count(); i++) {
         double y, x, down;
-        QGeoCoordinate vertex = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(i)->coordinate();
+        const QGeoCoordinate& vertex = polygon[i];
         if (i == 0) {
             // This avoids a nan calculation that comes out of convertGeoToNed
             x = y = 0;
@@ -830,10 +862,20 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 vertex:x:y" << vertex << polygonPoints.last().x() << polygonPoints.last().y();
     }
 
+    return polygonPoints;
+}
+
+void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(const TransectInput_t& input, bool refly, Transects_t& transectsOut)
+{
+    // Convert polygon to NED
+
+    QGeoCoordinate tangentOrigin = input.polygon.first();
+    QList<QPointF> polygonPoints = _polygonToNed(input.polygon, tangentOrigin);
+
     // Generate transects
 
-    double gridAngle = _gridAngleFact.rawValue().toDouble();
-    double gridSpacing = _cameraCalc.adjustedFootprintSide()->rawValue().toDouble();
+    double gridAngle = input.gridAngle;
+    double gridSpacing = input.gridSpacing;
     if (gridSpacing < 0.5) {
         // We can't let gridSpacing get too small otherwise we will end up with too many transects.
         // So we limit to 0.5 meter spacing as min and set to huge value which will cause a single
@@ -893,7 +935,6 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
     //      Create a single transect which goes through the center of the polygon
     //      Intersect it with the polygon
     if (intersectLines.count() < 2) {
-        _surveyAreaPolygon.center();
         QLineF firstLine = lineList.first();
         QPointF lineCenter = firstLine.pointAt(0.5);
         QPointF centerOffset = boundingCenter - lineCenter;
@@ -923,13 +964,13 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         transects.append(transect);
     }
 
-    _adjustTransectsToEntryPointLocation(transects);
+    _adjustTransectsToEntryPointLocation(input.entryPoint, transects);
 
-    if (refly) {
-        _optimizeTransectsForShortestDistance(_transects.last().last().coord, transects);
+    if (refly && !transectsOut.isEmpty()) {
+        _optimizeTransectsForShortestDistance(transectsOut.last().last().coord, transects);
     }
 
-    if (_flyAlternateTransectsFact.rawValue().toBool()) {
+    if (input.flyAlternateTransects) {
         QList<QList<QGeoCoordinate>> alternatingTransects;
         for (int i=0; i<transects.count(); i++) {
             if (!(i & 1)) {
@@ -962,9 +1003,12 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         transects[i] = transectVertices;
     }
 
-    // Convert to CoordInfo transects and append to _transects
-    for (const QList<QGeoCoordinate>& transect : transects) {
-        QGeoCoordinate                                  coord;
+    _appendCoordInfoTransects(input, transects, transectsOut);
+}
+
+void SurveyComplexItem::_appendCoordInfoTransects(const TransectInput_t& input, const QList<QList<QGeoCoordinate>>& geoTransects, Transects_t& transects)
+{
+    for (const QList<QGeoCoordinate>& transect : geoTransects) {
         QList<TransectStyleComplexItem::CoordInfo_t>    coordInfoTransect;
         TransectStyleComplexItem::CoordInfo_t           coordInfo;
 
@@ -974,14 +1018,14 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         coordInfoTransect.append(coordInfo);
 
         // For hover and capture we need points for each camera location within the transect
-        if (triggerCamera() && hoverAndCaptureEnabled()) {
+        if (input.hoverAndCapture) {
             double transectLength = transect[0].distanceTo(transect[1]);
             double transectAzimuth = transect[0].azimuthTo(transect[1]);
-            if (triggerDistance() < transectLength) {
-                int cInnerHoverPoints = static_cast<int>(floor(transectLength / triggerDistance()));
+            if (input.triggerDistance < transectLength) {
+                int cInnerHoverPoints = static_cast<int>(floor(transectLength / input.triggerDistance));
                 qCDebug(SurveyComplexItemLog) << "cInnerHoverPoints" << cInnerHoverPoints;
                 for (int i=0; i<cInnerHoverPoints; i++) {
-                    QGeoCoordinate hoverCoord = transect[0].atDistanceAndAzimuth(triggerDistance() * (i + 1), transectAzimuth);
+                    QGeoCoordinate hoverCoord = transect[0].atDistanceAndAzimuth(input.triggerDistance * (i + 1), transectAzimuth);
                     TransectStyleComplexItem::CoordInfo_t coordInfo = { hoverCoord, CoordTypeInteriorHoverTrigger };
                     coordInfoTransect.insert(1 + i, coordInfo);
                 }
@@ -989,9 +1033,9 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         }
 
         // Extend the transect ends for turnaround
-        if (_hasTurnaround()) {
+        if (input.turnaroundDistance > 0) {
             QGeoCoordinate turnaroundCoord;
-            double turnAroundDistance = _turnAroundDistanceFact.rawValue().toDouble();
+            double turnAroundDistance = input.turnaroundDistance;
 
             double azimuth = transect[0].azimuthTo(transect[1]);
             turnaroundCoord = transect[0].atDistanceAndAzimuth(-turnAroundDistance, azimuth);
@@ -1006,51 +1050,16 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
             coordInfoTransect.append(coordInfo);
         }
 
-        _transects.append(coordInfoTransect);
+        transects.append(coordInfoTransect);
     }
 }
 
-
-void SurveyComplexItem::_rebuildTransectsPhase1WorkerSplitPolygons(bool refly)
+void SurveyComplexItem::_rebuildTransectsPhase1WorkerSplitPolygons(const TransectInput_t& input, bool refly, Transects_t& transects, const CancelledFunc_t& cancelled)
 {
-    if (_ignoreRecalc) {
-        return;
-    }
-
-    // If the transects are getting rebuilt then any previously loaded mission items are now invalid
-    if (_loadedMissionItemsParent) {
-        _loadedMissionItems.clear();
-        _loadedMissionItemsParent->deleteLater();
-        _loadedMissionItemsParent = nullptr;
-    }
-
-    // First pass will clear old transect data, refly will append to existing data
-    if (!refly) {
-        _transects.clear();
-        _transectsPathHeightInfo.clear();
-    }
-
-    if (_surveyAreaPolygon.count() < 3) {
-        return;
-    }
-
     // Convert polygon to NED
 
-    QList<QPointF> polygonPoints;
-    QGeoCoordinate tangentOrigin = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(0)->coordinate();
-    qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 Convert polygon to NED - _surveyAreaPolygon.count():tangentOrigin" << _surveyAreaPolygon.count() << tangentOrigin;
-    for (int i=0; i<_surveyAreaPolygon.count(); i++) {
-        double y, x, down;
-        QGeoCoordinate vertex = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(i)->coordinate();
-        if (i == 0) {
-            // This avoids a nan calculation that comes out of convertGeoToNed
-            x = y = 0;
-        } else {
-            convertGeoToNed(vertex, tangentOrigin, &y, &x, &down);
-        }
-        polygonPoints += QPointF(x, y);
-        qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 vertex:x:y" << vertex << polygonPoints.last().x() << polygonPoints.last().y();
-    }
+    QGeoCoordinate tangentOrigin = input.polygon.first();
+    QList<QPointF> polygonPoints = _polygonToNed(input.polygon, tangentOrigin);
 
     // convert into QPolygonF
     QPolygonF polygon;
@@ -1061,10 +1070,14 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSplitPolygons(bool refly)
 
     // Create list of separate polygons
     QList<QPolygonF> polygons{};
-    _PolygonDecomposeConvex(polygon, polygons);
+    _PolygonDecomposeConvex(polygon, polygons, cancelled);
 
     // iterate over polygons
     for (auto p = polygons.begin(); p != polygons.end(); ++p) {
+        if (cancelled()) {
+            return;
+        }
+
         QPointF* vMatch = nullptr;
         // find matching vertex in previous polygon
         if (p != polygons.begin()) {
@@ -1088,11 +1101,11 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSplitPolygons(bool refly)
         // TODO figure out tangent origin
         // TODO improve selection of entry points
 //        qCDebug(SurveyComplexItemLog) << "Transects from polynom p " << p;
-        _rebuildTransectsFromPolygon(refly, *p, tangentOrigin, vMatch);
+        _rebuildTransectsFromPolygon(input, refly, *p, tangentOrigin, vMatch, transects);
     }
 }
 
-void SurveyComplexItem::_PolygonDecomposeConvex(const QPolygonF& polygon, QList<QPolygonF>& decomposedPolygons)
+void SurveyComplexItem::_PolygonDecomposeConvex(const QPolygonF& polygon, QList<QPolygonF>& decomposedPolygons, const CancelledFunc_t& cancelled)
 {
 	// this follows "Mark Keil's Algorithm" https://mpen.ca/406/keil
     int decompSize = std::numeric_limits<int>::max();
@@ -1106,6 +1119,11 @@ void SurveyComplexItem::_PolygonDecomposeConvex(const QPolygonF& polygon, QList<
 
     for (auto vertex = polygon.begin(); vertex != polygon.end(); ++vertex)
     {
+        // The search is exponential in the number of reflex vertices, give up as soon as the result is no longer wanted
+        if (cancelled()) {
+            return;
+        }
+
         // is vertex reflex?
         bool vertexIsReflex = _VertexIsReflex(polygon, vertex);
 
@@ -1156,10 +1174,10 @@ void SurveyComplexItem::_PolygonDecomposeConvex(const QPolygonF& polygon, QList<
 
             // recursion
             QList<QPolygonF> polyLeftDecomposed{};
-            _PolygonDecomposeConvex(polyLeft, polyLeftDecomposed);
+            _PolygonDecomposeConvex(polyLeft, polyLeftDecomposed, cancelled);
 
             QList<QPolygonF> polyRightDecomposed{};
-            _PolygonDecomposeConvex(polyRight, polyRightDecomposed);
+            _PolygonDecomposeConvex(polyRight, polyRightDecomposed, cancelled);
 
             // compositon
             auto subSize = polyLeftDecomposed.size() + polyRightDecomposed.size();
@@ -1239,12 +1257,12 @@ bool SurveyComplexItem::_VertexIsReflex(const QPolygonF& polygon, const QPointF*
 }
 
 
-void SurveyComplexItem::_rebuildTransectsFromPolygon(bool refly, const QPolygonF& polygon, const QGeoCoordinate& tangentOrigin, const QPointF* const transitionPoint)
+void SurveyComplexItem::_rebuildTransectsFromPolygon(const TransectInput_t& input, bool refly, const QPolygonF& polygon, const QGeoCoordinate& tangentOrigin, const QPointF* const transitionPoint, Transects_t& transectsOut)
 {
     // Generate transects
 
-    double gridAngle = _gridAngleFact.rawValue().toDouble();
-    double gridSpacing = _cameraCalc.adjustedFootprintSide()->rawValue().toDouble();
+    double gridAngle = input.gridAngle;
+    double gridSpacing = input.gridSpacing;
 
     gridAngle = _clampGridAngle90(gridAngle);
     gridAngle += refly ? 90 : 0;
@@ -1292,7 +1310,6 @@ void SurveyComplexItem::_rebuildTransectsFromPolygon(bool refly, const QPolygonF
     //      Create a single transect which goes through the center of the polygon
     //      Intersect it with the polygon
     if (intersectLines.count() < 2) {
-        _surveyAreaPolygon.center();
         QLineF firstLine = lineList.first();
         QPointF lineCenter = firstLine.pointAt(0.5);
         QPointF centerOffset = boundingCenter - lineCenter;
@@ -1332,13 +1349,13 @@ void SurveyComplexItem::_rebuildTransectsFromPolygon(bool refly, const QPolygonF
         transects.append(transect);
     }
 
-    _adjustTransectsToEntryPointLocation(transects);
+    _adjustTransectsToEntryPointLocation(input.entryPoint, transects);
 
-    if (refly) {
-        _optimizeTransectsForShortestDistance(_transects.last().last().coord, transects);
+    if (refly && !transectsOut.isEmpty()) {
+        _optimizeTransectsForShortestDistance(transectsOut.last().last().coord, transects);
     }
 
-    if (_flyAlternateTransectsFact.rawValue().toBool()) {
+    if (input.flyAlternateTransects) {
         QList<QList<QGeoCoordinate>> alternatingTransects;
         for (int i=0; i<transects.count(); i++) {
             if (!(i & 1)) {
@@ -1371,53 +1388,8 @@ void SurveyComplexItem::_rebuildTransectsFromPolygon(bool refly, const QPolygonF
         transects[i] = transectVertices;
     }
 
-    // Convert to CoordInfo transects and append to _transects
-    for (const QList<QGeoCoordinate>& transect: transects) {
-        QGeoCoordinate                                  coord;
-        QList<TransectStyleComplexItem::CoordInfo_t>    coordInfoTransect;
-        TransectStyleComplexItem::CoordInfo_t           coordInfo;
-
-        coordInfo = { transect[0], CoordTypeSurveyEdge };
-        coordInfoTransect.append(coordInfo);
-        coordInfo = { transect[1], CoordTypeSurveyEdge };
-        coordInfoTransect.append(coordInfo);
-
-        // For hover and capture we need points for each camera location within the transect
-        if (triggerCamera() && hoverAndCaptureEnabled()) {
-            double transectLength = transect[0].distanceTo(transect[1]);
-            double transectAzimuth = transect[0].azimuthTo(transect[1]);
-            if (triggerDistance() < transectLength) {
-                int cInnerHoverPoints = static_cast<int>(floor(transectLength / triggerDistance()));
-                qCDebug(SurveyComplexItemLog) << "cInnerHoverPoints" << cInnerHoverPoints;
-                for (int i=0; i<cInnerHoverPoints; i++) {
-                    QGeoCoordinate hoverCoord = transect[0].atDistanceAndAzimuth(triggerDistance() * (i + 1), transectAzimuth);
-                    TransectStyleComplexItem::CoordInfo_t coordInfo = { hoverCoord, CoordTypeInteriorHoverTrigger };
-                    coordInfoTransect.insert(1 + i, coordInfo);
-                }
-            }
-        }
-
-        // Extend the transect ends for turnaround
-        if (_hasTurnaround()) {
-            QGeoCoordinate turnaroundCoord;
-            double turnAroundDistance = _turnAroundDistanceFact.rawValue().toDouble();
-
-            double azimuth = transect[0].azimuthTo(transect[1]);
-            turnaroundCoord = transect[0].atDistanceAndAzimuth(-turnAroundDistance, azimuth);
-            turnaroundCoord.setAltitude(qQNaN());
-            TransectStyleComplexItem::CoordInfo_t coordInfo = { turnaroundCoord, CoordTypeTurnaround };
-            coordInfoTransect.prepend(coordInfo);
-
-            azimuth = transect.last().azimuthTo(transect[transect.count() - 2]);
-            turnaroundCoord = transect.last().atDistanceAndAzimuth(-turnAroundDistance, azimuth);
-            turnaroundCoord.setAltitude(qQNaN());
-            coordInfo = { turnaroundCoord, CoordTypeTurnaround };
-            coordInfoTransect.append(coordInfo);
-        }
-
-        _transects.append(coordInfoTransect);
-    }
-    qCDebug(SurveyComplexItemLog) << "_transects.size() " << _transects.size();
+    _appendCoordInfoTransects(input, transects, transectsOut);
+    qCDebug(SurveyComplexItemLog) << "transectsOut.size() " << transectsOut.size();
 }
 
 void SurveyComplexItem::_recalcComplexDistance(void)
@@ -93,22 +93,39 @@ private:
         CameraTriggerHoverAndCapture
     };
 
-    QPointF _rotatePoint(const QPointF& point, const QPointF& origin, double angle);
-    void _intersectLinesWithRect(const QList<QLineF>& lineList, const QRectF& boundRect, QList<QLineF>& resultLines);
-    void _intersectLinesWithPolygon(const QList<QLineF>& lineList, const QPolygonF& polygon, QList<QLineF>& resultLines);
-    void _adjustLineDirection(const QList<QLineF>& lineList, QList<QLineF>& resultLines);
+    /// Copy of the settings which transect generation depends on. Generation only works from this so it can run on a worker thread.
+    typedef struct {
+        QList<QGeoCoordinate>   polygon;
+        double                  gridAngle;
+        double                  gridSpacing;
+        int                     entryPoint;
+        bool                    flyAlternateTransects;
+        bool                    splitConcavePolygons;
+        bool                    refly90Degrees;
+        bool                    hoverAndCapture;        ///< true: camera is triggering with hover and capture enabled
+        double                  triggerDistance;
+        double                  turnaroundDistance;     ///< 0 for no turnaround
+    } TransectInput_t;
+
+    // Overrides from TransectStyleComplexItem
+    TransectGenerator_t _transectGenerator(void) const final;
+
+    static QPointF _rotatePoint(const QPointF& point, const QPointF& origin, double angle);
+    static void _intersectLinesWithRect(const QList<QLineF>& lineList, const QRectF& boundRect, QList<QLineF>& resultLines);
+    static void _intersectLinesWithPolygon(const QList<QLineF>& lineList, const QPolygonF& polygon, QList<QLineF>& resultLines);
+    static void _adjustLineDirection(const QList<QLineF>& lineList, QList<QLineF>& resultLines);
     int _appendWaypointToMission(QList<MissionItem*>& items, int seqNum, QGeoCoordinate& coord, CameraTriggerCode cameraTrigger, QObject* missionItemParent);
     bool _nextTransectCoord(const QList<QGeoCoordinate>& transectPoints, int pointIndex, QGeoCoordinate& coord);
     bool _appendMissionItemsWorker(QList<MissionItem*>& items, QObject* missionItemParent, int& seqNum, bool hasRefly, bool buildRefly);
-    void _optimizeTransectsForShortestDistance(const QGeoCoordinate& distanceCoord, QList<QList<QGeoCoordinate>>& transects);
-    qreal _ccw(QPointF pt1, QPointF pt2, QPointF pt3);
-    qreal _dp(QPointF pt1, QPointF pt2);
-    void _swapPoints(QList<QPointF>& points, int index1, int index2);
-    void _reverseTransectOrder(QList<QList<QGeoCoordinate>>& transects);
-    void _reverseInternalTransectPoints(QList<QList<QGeoCoordinate>>& transects);
-    void _adjustTransectsToEntryPointLocation(QList<QList<QGeoCoordinate>>& transects);
+    static void _optimizeTransectsForShortestDistance(const QGeoCoordinate& distanceCoord, QList<QList<QGeoCoordinate>>& transects);
+    static qreal _ccw(QPointF pt1, QPointF pt2, QPointF pt3);
+    static qreal _dp(QPointF pt1, QPointF pt2);
+    static void _swapPoints(QList<QPointF>& points, int index1, int index2);
+    static void _reverseTransectOrder(QList<QList<QGeoCoordinate>>& transects);
+    static void _reverseInternalTransectPoints(QList<QList<QGeoCoordinate>>& transects);
+    static void _adjustTransectsToEntryPointLocation(int entryPoint, QList<QList<QGeoCoordinate>>& transects);
     bool _gridAngleIsNorthSouthTransects();
-    double _clampGridAngle90(double gridAngle);
+    static double _clampGridAngle90(double gridAngle);
     void _buildAndAppendMissionItems(QList<MissionItem*>& items, QObject* missionItemParent);
     void _appendLoadedMissionItems  (QList<MissionItem*>& items, QObject* missionItemParent);
     bool _imagesEverywhere(void) const;
@@ -119,16 +136,19 @@ private:
     bool _loadV3(const QJsonObject& complexObject, int sequenceNumber, QString& errorString);
     bool _loadV4V5(const QJsonObject& complexObject, int sequenceNumber, QString& errorString, int version, bool forPresets);
     void _saveWorker(QJsonObject& complexObject);
-    void _rebuildTransectsPhase1Worker(bool refly);
-    void _rebuildTransectsPhase1WorkerSinglePolygon(bool refly);
-    void _rebuildTransectsPhase1WorkerSplitPolygons(bool refly);
-    /// Adds to the _transects array from one polygon
-    void _rebuildTransectsFromPolygon(bool refly, const QPolygonF& polygon, const QGeoCoordinate& tangentOrigin, const QPointF* const transitionPoint);
+    TransectInput_t _transectInput(void) const;
+    static Transects_t _generateTransects(const TransectInput_t& input, const CancelledFunc_t& cancelled);
+    static void _rebuildTransectsPhase1WorkerSinglePolygon(const TransectInput_t& input, bool refly, Transects_t& transects);
+    static void _rebuildTransectsPhase1WorkerSplitPolygons(const TransectInput_t& input, bool refly, Transects_t& transects, const CancelledFunc_t& cancelled);
+    /// Adds to the transects array from one polygon
+    static void _rebuildTransectsFromPolygon(const TransectInput_t& input, bool refly, const QPolygonF& polygon, const QGeoCoordinate& tangentOrigin, const QPointF* const transitionPoint, Transects_t& transects);
+    /// Converts the transects to CoordInfo transects, adding hover and turnaround points, and appends them to the transects array
+    static void _appendCoordInfoTransects(const TransectInput_t& input, const QList<QList<QGeoCoordinate>>& geoTransects, Transects_t& transects);
     // Decompose polygon into list of convex sub polygons
-    void _PolygonDecomposeConvex(const QPolygonF& polygon, QList<QPolygonF>& decomposedPolygons);
+    static void _PolygonDecomposeConvex(const QPolygonF& polygon, QList<QPolygonF>& decomposedPolygons, const CancelledFunc_t& cancelled);
     // return true if vertex a can see vertex b
-    bool _VertexCanSeeOther(const QPolygonF& polygon, const QPointF* vertexA, const QPointF* vertexB);
-    bool _VertexIsReflex(const QPolygonF& polygon, const QPointF* vertex);
+    static bool _VertexCanSeeOther(const QPolygonF& polygon, const QPointF* vertexA, const QPointF* vertexB);
+    static bool _VertexIsReflex(const QPolygonF& polygon, const QPointF* vertex);
 
     QMap<QString, FactMetaData*> _metaDataMap;
 
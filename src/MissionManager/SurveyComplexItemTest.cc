@@ -114,12 +114,19 @@ void SurveyComplexItemTest::_setPolygon(void)
     }
 }
 
+/// Transects are built on a worker thread, the item is not ready for save until the latest ones have been published
+void SurveyComplexItemTest::_waitForTransects(void)
+{
+    QTRY_COMPARE_WITH_TIMEOUT(_surveyItem->readyForSaveState(), VisualMissionItem::ReadyForSave, 5000);
+}
+
 void SurveyComplexItemTest::_testGridAngle(void)
 {
     _setPolygon();
 
     for (double gridAngle=-360.0; gridAngle<=360.0; gridAngle++) {
         _surveyItem->gridAngle()->setRawValue(gridAngle);
+        _waitForTransects();
 
         QVariantList gridPoints = _surveyItem->visualTransectPoints();
         QGeoCoordinate firstTransectEntry = gridPoints[0].value<QGeoCoordinate>();
@@ -141,6 +148,7 @@ void SurveyComplexItemTest::_testEntryLocation(void)
         QList<QGeoCoordinate> rgSeenEntryCoords;
         for (int rotateCount=0; rotateCount<3; rotateCount++) {
             _surveyItem->rotateEntryPoint();
+            _waitForTransects();
             QVERIFY(!rgSeenEntryCoords.contains(_surveyItem->coordinate()));
             rgSeenEntryCoords << _surveyItem->coordinate();
         }
@@ -160,6 +168,7 @@ void SurveyComplexItemTest::_testItemCount(void)
     _surveyItem->hoverAndCapture()->setRawValue(false);
     _surveyItem->cameraTriggerInTurnAround()->setRawValue(false);
     _surveyItem->refly90Degrees()->setRawValue(false);
+    _waitForTransects();
     _surveyItem->appendMissionItems(items, this);
     QCOMPARE(items.count() - 1, _surveyItem->lastSequenceNumber());
     items.clear();
@@ -167,6 +176,7 @@ void SurveyComplexItemTest::_testItemCount(void)
     _surveyItem->hoverAndCapture()->setRawValue(false);
     _surveyItem->cameraTriggerInTurnAround()->setRawValue(true);
     _surveyItem->refly90Degrees()->setRawValue(false);
+    _waitForTransects();
     _surveyItem->appendMissionItems(items, this);
     QCOMPARE(items.count() - 1, _surveyItem->lastSequenceNumber());
     items.clear();
@@ -174,6 +184,7 @@ void SurveyComplexItemTest::_testItemCount(void)
     _surveyItem->hoverAndCapture()->setRawValue(true);
     _surveyItem->cameraTriggerInTurnAround()->setRawValue(false);
     _surveyItem->refly90Degrees()->setRawValue(false);
+    _waitForTransects();
     _surveyItem->appendMissionItems(items, this);
     QCOMPARE(items.count() - 1, _surveyItem->lastSequenceNumber());
     items.clear();
@@ -181,7 +192,32 @@ void SurveyComplexItemTest::_testItemCount(void)
     _surveyItem->hoverAndCapture()->setRawValue(true);
     _surveyItem->cameraTriggerInTurnAround()->setRawValue(false);
     _surveyItem->refly90Degrees()->setRawValue(true);
+    _waitForTransects();
     _surveyItem->appendMissionItems(items, this);
     QCOMPARE(items.count() - 1, _surveyItem->lastSequenceNumber());
     items.clear();
 }
+
+/// Pending transects are completed before sequence numbers are assigned, so building the mission items does not change
+/// the item count
+void SurveyComplexItemTest::_testCompletePendingWork(void)
+{
+    QList<MissionItem*> items;
+
+    _setPolygon();
+    _waitForTransects();
+
+    _surveyItem->hoverAndCapture()->setRawValue(!_surveyItem->hoverAndCapture()->rawValue().toBool());
+    QCOMPARE(_surveyItem->readyForSaveState(), VisualMissionItem::NotReadyForSaveData);
+    _surveyItem->completePendingWork();
+    QCOMPARE(_surveyItem->readyForSaveState(), VisualMissionItem::ReadyForSave);
+
+    int lastSequenceNumber = _surveyItem->lastSequenceNumber();
+    _surveyItem->appendMissionItems(items, this);
+    QCOMPARE(items.count() - 1, lastSequenceNumber);
+    QCOMPARE(_surveyItem->lastSequenceNumber(), lastSequenceNumber);
+
+    // The superseded worker result must not be published over the completed transects
+    QTest::qWait(100);
+    QCOMPARE(_surveyItem->lastSequenceNumber(), lastSequenceNumber);
+}
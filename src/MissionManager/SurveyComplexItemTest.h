@@ -33,11 +33,13 @@ private slots:
     void _testGridAngle(void);
     void _testEntryLocation(void);
     void _testItemCount(void);
+    void _testCompletePendingWork(void);
 
 private:
 
     double _clampGridAngle180(double gridAngle);
     void _setPolygon(void);
+    void _waitForTransects(void);
 
     // SurveyComplexItem signals
 
@@ -0,0 +1,577 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "SurveyCoverage.h"
+
+#include <QColor>
+#include <QHash>
+#include <QLineF>
+#include <QThread>
+#include <QtConcurrent>
+#include <QtMath>
+
+#include <algorithm>
+
+static const double _metersPerDegreeLat = 111319.49;
+
+static inline void _hashCombine(uint& seed, double value)
+{
+    seed ^= qHash(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+/// Interpolates the terrain height at a point along the terrain path. Points must be visited in order along the path,
+/// segment is the cursor into the path which is carried from one point to the next.
+static double _terrainHeightAt(const QVector<QPointF>& terrainPath, const QVector<double>& terrainHeights, int& segment, const QPointF& point)
+{
+    if (terrainPath.count() == 1) {
+        return terrainHeights.first();
+    }
+
+    for (;;) {
+        QPointF a               = terrainPath[segment];
+        QPointF ab              = terrainPath[segment + 1] - a;
+        double  lengthSquared   = QPointF::dotProduct(ab, ab);
+        double  fraction        = lengthSquared > 0 ? QPointF::dotProduct(point - a, ab) / lengthSquared : 1.0;
+
+        if (fraction > 1.0 && segment < terrainPath.count() - 2) {
+            segment++;
+            continue;
+        }
+        fraction = qBound(0.0, fraction, 1.0);
+        return terrainHeights[segment] + (terrainHeights[segment + 1] - terrainHeights[segment]) * fraction;
+    }
+}
+
+SurveyCoverage::SurveyCoverage(void)
+    : _refLatitude          (0)
+    , _refLongitude         (0)
+    , _metersPerDegreeLon   (_metersPerDegreeLat)
+    , _cellSize             (0)
+    , _columns              (0)
+    , _rows                 (0)
+    , _triggerDistance      (0)
+    , _footprintSide        (0)
+    , _footprintFrontal     (0)
+    , _distanceToSurface    (0)
+    , _imageCount           (0)
+    , _insideCells          (0)
+    , _coveredCells         (0)
+    , _overlapSum           (0)
+    , _maxOverlap           (0)
+    , _recalculatedLegs     (0)
+{
+
+}
+
+double SurveyCoverage::coveredPercent(void) const
+{
+    if (!isValid()) {
+        return qQNaN();
+    }
+    return _insideCells ? (100.0 * _coveredCells) / _insideCells : 0;
+}
+
+double SurveyCoverage::meanOverlap(void) const
+{
+    if (!isValid()) {
+        return qQNaN();
+    }
+    return _insideCells ? static_cast<double>(_overlapSum) / _insideCells : 0;
+}
+
+QPointF SurveyCoverage::_toLocal(const QGeoCoordinate& coord) const
+{
+    return QPointF((coord.longitude() - _refLongitude) * _metersPerDegreeLon, (coord.latitude() - _refLatitude) * _metersPerDegreeLat);
+}
+
+QGeoCoordinate SurveyCoverage::_toGeo(const QPointF& point) const
+{
+    return QGeoCoordinate(_refLatitude + point.y() / _metersPerDegreeLat, _refLongitude + point.x() / _metersPerDegreeLon);
+}
+
+/// Legs with different keys are known to differ. Equal keys can still be different legs, so candidates must be compared
+/// in full.
+uint SurveyCoverage::_legKey(const TriggerLeg& leg)
+{
+    uint key = 0;
+
+    for (const QGeoCoordinate& coord: leg.path) {
+        _hashCombine(key, coord.latitude());
+        _hashCombine(key, coord.longitude());
+        _hashCombine(key, coord.altitude());
+    }
+    _hashCombine(key, leg.path.count());
+    for (const QGeoCoordinate& coord: leg.terrain) {
+        _hashCombine(key, coord.latitude());
+        _hashCombine(key, coord.longitude());
+        _hashCombine(key, coord.altitude());
+    }
+    return key;
+}
+
+void SurveyCoverage::_setupGrid(const Input& input)
+{
+    _columns = _rows = 0;
+
+    double footprint = qMin(input.footprintSide, input.footprintFrontal);
+    if (footprint <= 0) {
+        return;
+    }
+
+    double north = -90, south = 90, east = -180, west = 180;
+    for (const QList<QGeoCoordinate>& polygon: input.polygons) {
+        if (polygon.count() < 3) {
+            continue;
+        }
+        for (const QGeoCoordinate& vertex: polygon) {
+            north   = qMax(north, vertex.latitude());
+            south   = qMin(south, vertex.latitude());
+            east    = qMax(east, vertex.longitude());
+            west    = qMin(west, vertex.longitude());
+        }
+    }
+    if (north <= south || east <= west) {
+        return;
+    }
+
+    _refLatitude        = (north + south) / 2.0;
+    _refLongitude       = (east + west) / 2.0;
+    _metersPerDegreeLon = _metersPerDegreeLat * qCos(qDegreesToRadians(_refLatitude));
+
+    QPointF southWest   = _toLocal(QGeoCoordinate(south, west));
+    QPointF northEast   = _toLocal(QGeoCoordinate(north, east));
+    double  width       = northEast.x() - southWest.x();
+    double  height      = northEast.y() - southWest.y();
+
+    // Cells are a fraction of the image footprint, grown for very large areas to bound the memory used
+    _cellSize   = qMax(footprint / _cellsAcrossFootprint, qSqrt(width * height / _maxCells));
+    _columns    = qMax(1, qCeil(width / _cellSize));
+    _rows       = qMax(1, qCeil(height / _cellSize));
+    _gridOrigin = southWest;
+    _polygons   = input.polygons;
+
+    _triggerDistance    = input.triggerDistance;
+    _footprintSide      = input.footprintSide;
+    _footprintFrontal   = input.footprintFrontal;
+    _distanceToSurface  = input.distanceToSurface;
+}
+
+bool SurveyCoverage::_sameGrid(const SurveyCoverage& other) const
+{
+    return isValid() && other.isValid() &&
+            _columns == other._columns &&
+            _rows == other._rows &&
+            _cellSize == other._cellSize &&
+            _gridOrigin == other._gridOrigin &&
+            _refLatitude == other._refLatitude &&
+            _refLongitude == other._refLongitude &&
+            _polygons == other._polygons;
+}
+
+/// Footprints built with the same camera from the same leg are the same
+bool SurveyCoverage::_sameCamera(const SurveyCoverage& other) const
+{
+    return _triggerDistance == other._triggerDistance &&
+            _footprintSide == other._footprintSide &&
+            _footprintFrontal == other._footprintFrontal &&
+            _distanceToSurface == other._distanceToSurface;
+}
+
+int SurveyCoverage::_bandRows(void) const
+{
+    // Enough bands to keep all threads busy even if the footprints are unevenly spread across the rows
+    return qMax(_minBandRows, _rows / (QThread::idealThreadCount() * 4));
+}
+
+QVector<SurveyCoverage::Footprint> SurveyCoverage::_legFootprints(const Input& input, const TriggerLeg& leg) const
+{
+    QVector<Footprint> footprints;
+
+    if (leg.path.count() < 2 || input.triggerDistance <= 0) {
+        return footprints;
+    }
+
+    QVector<QPointF>    path;
+    QVector<double>     distances;
+    for (const QGeoCoordinate& coord: leg.path) {
+        path.append(_toLocal(coord));
+        distances.append(distances.isEmpty() ? 0 : distances.last() + QLineF(path[path.count() - 2], path.last()).length());
+    }
+
+    // Terrain is only usable if the flight path has altitudes to go with it
+    bool                useTerrain = !leg.terrain.isEmpty() && input.distanceToSurface > 0;
+    QVector<QPointF>    terrainPath;
+    QVector<double>     terrainHeights;
+    for (const QGeoCoordinate& coord: leg.path) {
+        useTerrain &= !qIsNaN(coord.altitude());
+    }
+    if (useTerrain) {
+        for (const QGeoCoordinate& coord: leg.terrain) {
+            terrainPath.append(_toLocal(coord));
+            terrainHeights.append(coord.altitude());
+        }
+    }
+
+    // Same number of images as the camera shot count of a transect
+    int     imageCount      = qCeil(distances.last() / input.triggerDistance);
+    int     segment         = 0;
+    int     terrainSegment  = 0;
+    QPointF alongTrack      (0, 1);
+
+    footprints.reserve(imageCount);
+    for (int i=0; i<imageCount; i++) {
+        double distance = i * input.triggerDistance;
+        while (segment < path.count() - 2 && distances[segment + 1] < distance) {
+            segment++;
+        }
+
+        double  segmentLength   = distances[segment + 1] - distances[segment];
+        double  fraction        = segmentLength > 0 ? (distance - distances[segment]) / segmentLength : 0;
+        QPointF a               = path[segment];
+        QPointF b               = path[segment + 1];
+        if (segmentLength > 0) {
+            alongTrack = (b - a) / segmentLength;
+        }
+
+        Footprint footprint;
+        footprint.center        = a + (b - a) * fraction;
+        footprint.alongTrack    = alongTrack;
+
+        double scale = 1.0;
+        if (useTerrain) {
+            double altitude         = leg.path[segment].altitude() + (leg.path[segment + 1].altitude() - leg.path[segment].altitude()) * fraction;
+            double heightAboveGround = altitude - _terrainHeightAt(terrainPath, terrainHeights, terrainSegment, footprint.center);
+            scale = qMax(heightAboveGround, 1.0) / input.distanceToSurface;
+        }
+        footprint.halfFrontal   = input.footprintFrontal * scale / 2.0;
+        footprint.halfSide      = input.footprintSide * scale / 2.0;
+
+        footprints.append(footprint);
+    }
+
+    return footprints;
+}
+
+/// Marks the cells whose centers are inside any of the polygons, one scan line per row
+void SurveyCoverage::_rasterizeArea(const Input& input)
+{
+    QVector<QVector<QPointF>> polygons;
+    for (const QList<QGeoCoordinate>& polygon: input.polygons) {
+        if (polygon.count() >= 3) {
+            QVector<QPointF> localPolygon;
+            for (const QGeoCoordinate& vertex: polygon) {
+                localPolygon.append(_toLocal(vertex));
+            }
+            polygons.append(localPolygon);
+        }
+    }
+
+    _inside.fill(0, _columns * _rows);
+    quint8* inside = _inside.data();
+
+    int             bandRows = _bandRows();
+    QVector<int>    firstRows;
+    for (int row=0; row<_rows; row+=bandRows) {
+        firstRows.append(row);
+    }
+
+    QtConcurrent::blockingMap(firstRows, [this, &polygons, inside, bandRows](int firstRow) {
+        QVector<double> crossings;
+        for (int row=firstRow; row<qMin(_rows, firstRow + bandRows); row++) {
+            double y = _gridOrigin.y() + (row + 0.5) * _cellSize;
+            for (const QVector<QPointF>& polygon: polygons) {
+                crossings.clear();
+                for (int i=0, j=polygon.count()-1; i<polygon.count(); j=i++) {
+                    const QPointF& a = polygon[i];
+                    const QPointF& b = polygon[j];
+                    if ((a.y() > y) != (b.y() > y)) {
+                        crossings.append(a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y()));
+                    }
+                }
+                std::sort(crossings.begin(), crossings.end());
+                for (int i=0; i+1<crossings.count(); i+=2) {
+                    int firstColumn = qMax(0, qCeil((crossings[i] - _gridOrigin.x()) / _cellSize - 0.5));
+                    int lastColumn  = qMin(_columns - 1, qFloor((crossings[i + 1] - _gridOrigin.x()) / _cellSize - 0.5));
+                    for (int column=firstColumn; column<=lastColumn; column++) {
+                        inside[row * _columns + column] = 1;
+                    }
+                }
+            }
+        }
+    });
+}
+
+/// Adds the footprint weights to all cells whose centers are inside the footprints. Footprints are binned into bands of
+/// rows which are rasterized in parallel, so no two threads write to the same cell.
+void SurveyCoverage::_rasterizeFootprints(const QVector<WeightedFootprint_t>& footprints)
+{
+    struct Band {
+        int                             firstRow;
+        int                             lastRow;
+        QVector<WeightedFootprint_t>    footprints;
+    };
+
+    int             bandRows = _bandRows();
+    QVector<Band>   bands;
+    for (int row=0; row<_rows; row+=bandRows) {
+        bands.append({ row, qMin(_rows, row + bandRows) - 1, QVector<WeightedFootprint_t>() });
+    }
+
+    for (const WeightedFootprint_t& weightedFootprint: footprints) {
+        const Footprint& footprint = *weightedFootprint.first;
+
+        double  extentY     = qAbs(footprint.alongTrack.y()) * footprint.halfFrontal + qAbs(footprint.alongTrack.x()) * footprint.halfSide;
+        int     firstRow    = qMax(0, qFloor((footprint.center.y() - extentY - _gridOrigin.y()) / _cellSize));
+        int     lastRow     = qMin(_rows - 1, qFloor((footprint.center.y() + extentY - _gridOrigin.y()) / _cellSize));
+        for (int band=firstRow / bandRows; band<=lastRow / bandRows && firstRow<=lastRow; band++) {
+            bands[band].footprints.append(weightedFootprint);
+        }
+    }
+
+    quint16* overlap = _overlap.data();
+    QtConcurrent::blockingMap(bands, [this, overlap](const Band& band) {
+        for (const WeightedFootprint_t& weightedFootprint: band.footprints) {
+            const Footprint&    footprint   = *weightedFootprint.first;
+            QPointF             acrossTrack (-footprint.alongTrack.y(), footprint.alongTrack.x());
+
+            double  extentX     = qAbs(footprint.alongTrack.x()) * footprint.halfFrontal + qAbs(footprint.alongTrack.y()) * footprint.halfSide;
+            double  extentY     = qAbs(footprint.alongTrack.y()) * footprint.halfFrontal + qAbs(footprint.alongTrack.x()) * footprint.halfSide;
+            int     firstRow    = qMax(band.firstRow, qFloor((footprint.center.y() - extentY - _gridOrigin.y()) / _cellSize));
+            int     lastRow     = qMin(band.lastRow, qFloor((footprint.center.y() + extentY - _gridOrigin.y()) / _cellSize));
+            int     firstColumn = qMax(0, qFloor((footprint.center.x() - extentX - _gridOrigin.x()) / _cellSize));
+            int     lastColumn  = qMin(_columns - 1, qFloor((footprint.center.x() + extentX - _gridOrigin.x()) / _cellSize));
+
+            for (int row=firstRow; row<=lastRow; row++) {
+                for (int column=firstColumn; column<=lastColumn; column++) {
+                    QPointF offset = _gridOrigin + QPointF((column + 0.5) * _cellSize, (row + 0.5) * _cellSize) - footprint.center;
+                    if (qAbs(QPointF::dotProduct(offset, footprint.alongTrack)) <= footprint.halfFrontal &&
+                            qAbs(QPointF::dotProduct(offset, acrossTrack)) <= footprint.halfSide) {
+                        overlap[row * _columns + column] += weightedFootprint.second;
+                    }
+                }
+            }
+        }
+    });
+}
+
+void SurveyCoverage::_updateStatistics(void)
+{
+    _insideCells = _coveredCells = _maxOverlap = 0;
+    _overlapSum = 0;
+    _gapRects.clear();
+
+    // Uncovered runs of cells in each row are merged with an identical run in the row below into rectangles
+    QHash<quint64, int> openGaps;
+    QHash<quint64, int> nextOpenGaps;
+    for (int row=0; row<_rows; row++) {
+        nextOpenGaps.clear();
+        int gapStart = -1;
+        for (int column=0; column<=_columns; column++) {
+            int     cell    = row * _columns + column;
+            bool    gap     = false;
+            if (column < _columns && _inside[cell]) {
+                int overlap = _overlap[cell];
+                _insideCells++;
+                _overlapSum += overlap;
+                _maxOverlap = qMax(_maxOverlap, overlap);
+                if (overlap) {
+                    _coveredCells++;
+                } else {
+                    gap = true;
+                }
+            }
+            if (gap && gapStart == -1) {
+                gapStart = column;
+            } else if (!gap && gapStart != -1) {
+                quint64 span = (static_cast<quint64>(gapStart) << 32) | static_cast<quint64>(column - 1);
+                if (openGaps.contains(span)) {
+                    int gapIndex = openGaps[span];
+                    _gapRects[gapIndex].setBottom(row);
+                    nextOpenGaps[span] = gapIndex;
+                } else {
+                    nextOpenGaps[span] = _gapRects.count();
+                    _gapRects.append(QRect(gapStart, row, column - gapStart, 1));
+                }
+                gapStart = -1;
+            }
+        }
+        openGaps.swap(nextOpenGaps);
+    }
+
+    std::stable_sort(_gapRects.begin(), _gapRects.end(), [](const QRect& a, const QRect& b) {
+        return a.width() * a.height() > b.width() * b.height();
+    });
+}
+
+SurveyCoverage SurveyCoverage::update(const Input& input, const CancelledFunc_t& cancelled) const
+{
+    auto isCancelled = [&cancelled]() { return cancelled && cancelled(); };
+
+    SurveyCoverage coverage;
+    coverage._setupGrid(input);
+    if (!coverage.isValid()) {
+        return coverage;
+    }
+    bool sameGrid = coverage._sameGrid(*this);
+
+    // Unchanged legs keep their footprints, legs are looked up by key so reordered legs are also found
+    QMultiHash<uint, int> previousLegs;
+    QVector<bool>         previousLegReused(_legs.count(), false);
+    if (sameGrid && coverage._sameCamera(*this)) {
+        for (int i=0; i<_legs.count(); i++) {
+            previousLegs.insert(_legs[i].key, i);
+        }
+    }
+
+    QVector<int> recalculatedLegs;
+    coverage._legs.reserve(input.legs.count());
+    for (const TriggerLeg& leg: input.legs) {
+        if (isCancelled()) {
+            return SurveyCoverage();
+        }
+
+        LegFootprints legFootprints;
+        legFootprints.key = _legKey(leg);
+        legFootprints.leg = leg;
+
+        bool reused = false;
+        for (auto it = previousLegs.find(legFootprints.key); it != previousLegs.end() && it.key() == legFootprints.key; ++it) {
+            const TriggerLeg& previousLeg = _legs[it.value()].leg;
+            if (!previousLegReused[it.value()] && previousLeg.path == leg.path && previousLeg.terrain == leg.terrain) {
+                previousLegReused[it.value()] = true;
+                legFootprints.footprints = _legs[it.value()].footprints;
+                reused = true;
+                break;
+            }
+        }
+        if (!reused) {
+            legFootprints.footprints = coverage._legFootprints(input, leg);
+            recalculatedLegs.append(coverage._legs.count());
+        }
+
+        coverage._imageCount += legFootprints.footprints.count();
+        coverage._legs.append(legFootprints);
+    }
+    coverage._recalculatedLegs = recalculatedLegs.count();
+
+    // Only rasterize the difference if that is less work than starting over. The weighted footprints point into the legs,
+    // which are only accessed const from here on.
+    const QVector<LegFootprints>&   legs = coverage._legs;
+    QVector<WeightedFootprint_t>    changedFootprints;
+    for (int legIndex: recalculatedLegs) {
+        for (const Footprint& footprint: legs[legIndex].footprints) {
+            changedFootprints.append(WeightedFootprint_t(&footprint, 1));
+        }
+    }
+    for (int i=0; i<_legs.count() && sameGrid; i++) {
+        if (!previousLegReused[i]) {
+            for (const Footprint& footprint: _legs[i].footprints) {
+                changedFootprints.append(WeightedFootprint_t(&footprint, -1));
+            }
+        }
+    }
+
+    if (sameGrid) {
+        coverage._inside = _inside;
+    } else {
+        coverage._rasterizeArea(input);
+    }
+    if (isCancelled()) {
+        return SurveyCoverage();
+    }
+
+    if (sameGrid && changedFootprints.count() < coverage._imageCount) {
+        coverage._overlap = _overlap;
+        coverage._rasterizeFootprints(changedFootprints);
+    } else {
+        QVector<WeightedFootprint_t> allFootprints;
+        allFootprints.reserve(coverage._imageCount);
+        for (const LegFootprints& legFootprints: legs) {
+            for (const Footprint& footprint: legFootprints.footprints) {
+                allFootprints.append(WeightedFootprint_t(&footprint, 1));
+            }
+        }
+        coverage._overlap.fill(0, coverage._columns * coverage._rows);
+        coverage._rasterizeFootprints(allFootprints);
+    }
+    if (isCancelled()) {
+        return SurveyCoverage();
+    }
+
+    coverage._updateStatistics();
+
+    return coverage;
+}
+
+int SurveyCoverage::overlapAt(const QGeoCoordinate& coord) const
+{
+    if (!isValid()) {
+        return -1;
+    }
+
+    QPointF point   = _toLocal(coord) - _gridOrigin;
+    int     column  = qFloor(point.x() / _cellSize);
+    int     row     = qFloor(point.y() / _cellSize);
+    if (column < 0 || column >= _columns || row < 0 || row >= _rows || !_inside[row * _columns + column]) {
+        return -1;
+    }
+    return _overlap[row * _columns + column];
+}
+
+QList<QList<QGeoCoordinate>> SurveyCoverage::gaps(int maxGaps) const
+{
+    QList<QList<QGeoCoordinate>> gaps;
+
+    for (int i=0; i<qMin(maxGaps, _gapRects.count()); i++) {
+        const QRect& rect = _gapRects[i];
+
+        double west     = _gridOrigin.x() + rect.left() * _cellSize;
+        double east     = _gridOrigin.x() + (rect.right() + 1) * _cellSize;
+        double south    = _gridOrigin.y() + rect.top() * _cellSize;
+        double north    = _gridOrigin.y() + (rect.bottom() + 1) * _cellSize;
+
+        // Clockwise from north west
+        gaps.append(QList<QGeoCoordinate>({ _toGeo(QPointF(west, north)), _toGeo(QPointF(east, north)), _toGeo(QPointF(east, south)), _toGeo(QPointF(west, south)) }));
+    }
+
+    return gaps;
+}
+
+QImage SurveyCoverage::heatMap(QGeoCoordinate& northWest, QGeoCoordinate& southEast) const
+{
+    if (!isValid()) {
+        northWest = southEast = QGeoCoordinate();
+        return QImage();
+    }
+
+    northWest = _toGeo(_gridOrigin + QPointF(0, _rows * _cellSize));
+    southEast = _toGeo(_gridOrigin + QPointF(_columns * _cellSize, 0));
+
+    // Uncovered cells are red, covered cells go from yellow for a single image to green for the most overlap
+    QImage image(_columns, _rows, QImage::Format_ARGB32);
+    image.fill(Qt::transparent);
+    for (int row=0; row<_rows; row++) {
+        QRgb* scanLine = reinterpret_cast<QRgb*>(image.scanLine(_rows - 1 - row));
+        for (int column=0; column<_columns; column++) {
+            int cell = row * _columns + column;
+            if (!_inside[cell]) {
+                continue;
+            }
+            int overlap = _overlap[cell];
+            if (overlap == 0) {
+                scanLine[column] = qRgba(255, 0, 0, 160);
+            } else {
+                double fraction = _maxOverlap > 1 ? static_cast<double>(overlap - 1) / (_maxOverlap - 1) : 1.0;
+                scanLine[column] = QColor::fromHsvF((60.0 + 60.0 * fraction) / 360.0, 1.0, 1.0, 160.0 / 255.0).rgba();
+            }
+        }
+    }
+
+    return image;
+}
@@ -0,0 +1,131 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QGeoCoordinate>
+#include <QImage>
+#include <QList>
+#include <QPair>
+#include <QPointF>
+#include <QRect>
+#include <QVector>
+
+#include <functional>
+
+/// Ground coverage of the images taken along the transects of a survey.
+///
+/// Each camera trigger is turned into an image footprint on a local plane around the survey area, scaled by the height
+/// above terrain at the trigger when terrain heights are known. Footprints are rasterized on the thread pool into a grid
+/// of image counts over the survey area, from which come the coverage statistics, the coverage gaps and an overlap heat
+/// map.
+///
+/// Coverage is a value type. update builds new coverage from the previous one, reusing the footprints of all trigger legs
+/// which did not change. If the grid is also unchanged only the footprints of the changed legs are rasterized again.
+class SurveyCoverage
+{
+public:
+    typedef std::function<bool(void)> CancelledFunc_t;
+
+    /// Part of a transect over which the camera is triggering
+    struct TriggerLeg {
+        QList<QGeoCoordinate>   path;       ///< Flight path, altitudes are only used when terrain is known
+        QList<QGeoCoordinate>   terrain;    ///< Terrain heights along the path as altitudes, empty if not known
+    };
+
+    struct Input {
+        QList<QList<QGeoCoordinate>>    polygons;           ///< Survey area
+        QList<TriggerLeg>               legs;
+        double                          triggerDistance;    ///< Distance between images along a leg, 0 for no images
+        double                          footprintSide;      ///< Image footprint across the leg at distanceToSurface
+        double                          footprintFrontal;   ///< Image footprint along the leg at distanceToSurface
+        double                          distanceToSurface;
+    };
+
+    SurveyCoverage(void);
+
+    /// @return Coverage for the new input
+    ///     @param cancelled Returns true once the result is no longer needed, an invalid coverage is returned early
+    SurveyCoverage update(const Input& input, const CancelledFunc_t& cancelled = CancelledFunc_t()) const;
+
+    bool    isValid         (void) const { return _columns > 0; }
+    int     imageCount      (void) const { return _imageCount; }
+    double  coveredPercent  (void) const;   ///< Percent of the survey area which is in at least one image, NaN if not valid
+    double  meanOverlap     (void) const;   ///< Number of images a point in the survey area is in on average, NaN if not valid
+    int     maxOverlap      (void) const { return _maxOverlap; }
+    int     recalculatedLegs(void) const { return _recalculatedLegs; }  ///< Legs whose footprints were not reused by the last update
+
+    /// @return Number of images at the coordinate, -1 if outside of the survey area
+    int overlapAt(const QGeoCoordinate& coord) const;
+
+    /// @return Rectangular parts of the survey area which are not in any image, largest first
+    QList<QList<QGeoCoordinate>> gaps(int maxGaps) const;
+
+    /// @return Overlap heat map with one pixel per grid cell, north up, transparent outside of the survey area
+    ///     @param[out] northWest Coordinate of the top left corner of the image
+    ///     @param[out] southEast Coordinate of the bottom right corner of the image
+    QImage heatMap(QGeoCoordinate& northWest, QGeoCoordinate& southEast) const;
+
+private:
+    struct Footprint {
+        QPointF center;         ///< Local plane, x east, y north
+        QPointF alongTrack;     ///< Unit vector in flight direction
+        double  halfFrontal;
+        double  halfSide;
+    };
+
+    struct LegFootprints {
+        uint                key;        ///< Hash of the leg, only used to find reuse candidates
+        TriggerLeg          leg;        ///< Leg the footprints were built from, compared in full before reuse
+        QVector<Footprint>  footprints;
+    };
+
+    typedef QPair<const Footprint*, int> WeightedFootprint_t;  ///< Footprint and the amount to add to its cells
+    typedef QList<QList<QGeoCoordinate>> Polygons_t;
+
+    void                _setupGrid              (const Input& input);
+    bool                _sameGrid               (const SurveyCoverage& other) const;
+    bool                _sameCamera             (const SurveyCoverage& other) const;
+    QPointF             _toLocal                (const QGeoCoordinate& coord) const;
+    QGeoCoordinate      _toGeo                  (const QPointF& point) const;
+    QVector<Footprint>  _legFootprints          (const Input& input, const TriggerLeg& leg) const;
+    void                _rasterizeArea          (const Input& input);
+    void                _rasterizeFootprints    (const QVector<WeightedFootprint_t>& footprints);
+    void                _updateStatistics       (void);
+    int                 _bandRows               (void) const;
+
+    static uint _legKey(const TriggerLeg& leg);
+
+    double                  _refLatitude;
+    double                  _refLongitude;
+    double                  _metersPerDegreeLon;
+    QPointF                 _gridOrigin;        ///< South west corner of the grid on the local plane
+    double                  _cellSize;
+    int                     _columns;
+    int                     _rows;
+    Polygons_t              _polygons;          ///< Survey area the grid was built for
+    double                  _triggerDistance;
+    double                  _footprintSide;
+    double                  _footprintFrontal;
+    double                  _distanceToSurface;
+    QVector<quint8>         _inside;            ///< Per cell, 1 for cells inside of the survey area
+    QVector<quint16>        _overlap;           ///< Per cell, number of images
+    QVector<LegFootprints>  _legs;
+    QVector<QRect>          _gapRects;          ///< Cells, largest first
+    int                     _imageCount;
+    int                     _insideCells;
+    int                     _coveredCells;
+    qint64                  _overlapSum;
+    int                     _maxOverlap;
+    int                     _recalculatedLegs;
+
+    static const int _cellsAcrossFootprint  = 8;
+    static const int _maxCells              = 1 << 20;
+    static const int _minBandRows           = 8;
+};
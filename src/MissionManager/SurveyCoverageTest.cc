@@ -0,0 +1,204 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "SurveyCoverageTest.h"
+
+#include <algorithm>
+
+const double SurveyCoverageTest::_surveySize        = 400;
+const double SurveyCoverageTest::_transectSpacing   = 24;
+
+QGeoCoordinate SurveyCoverageTest::_offset(double east, double north, double altitude)
+{
+    QGeoCoordinate coord = QGeoCoordinate(47.3977419, 8.5455938).atDistanceAndAzimuth(north, 0).atDistanceAndAzimuth(east, 90);
+    coord.setAltitude(altitude);
+    return coord;
+}
+
+/// Square survey area with north/south transects which run past the area on both sides. Images are 30m across and 20m
+/// along the transects, with 20% overlap in both directions.
+SurveyCoverage::Input SurveyCoverageTest::_squareSurvey(void)
+{
+    SurveyCoverage::Input input;
+
+    input.polygons.append(QList<QGeoCoordinate>({ _offset(0, _surveySize), _offset(_surveySize, _surveySize), _offset(_surveySize, 0), _offset(0, 0) }));
+    input.triggerDistance   = 16;
+    input.footprintSide     = 30;
+    input.footprintFrontal  = 20;
+    input.distanceToSurface = 50;
+
+    for (double east=_transectSpacing / 2; east<_surveySize; east+=_transectSpacing) {
+        SurveyCoverage::TriggerLeg leg;
+        leg.path << _offset(east, -10) << _offset(east, _surveySize + 10);
+        input.legs.append(leg);
+    }
+
+    return input;
+}
+
+void SurveyCoverageTest::_compareCoverage(const SurveyCoverage& coverage1, const SurveyCoverage& coverage2)
+{
+    QCOMPARE(coverage1.imageCount(), coverage2.imageCount());
+    QCOMPARE(coverage1.coveredPercent(), coverage2.coveredPercent());
+    QCOMPARE(coverage1.meanOverlap(), coverage2.meanOverlap());
+    for (double east=1; east<_surveySize; east+=3.3) {
+        for (double north=1; north<_surveySize; north+=3.3) {
+            QCOMPARE(coverage1.overlapAt(_offset(east, north)), coverage2.overlapAt(_offset(east, north)));
+        }
+    }
+}
+
+void SurveyCoverageTest::_testSingleImage(void)
+{
+    SurveyCoverage::Input input = _squareSurvey();
+    SurveyCoverage::TriggerLeg leg;
+
+    leg.path << _offset(200, 200) << _offset(200, 210);
+    input.legs = { leg };
+
+    SurveyCoverage coverage = SurveyCoverage().update(input);
+    QVERIFY(coverage.isValid());
+    QCOMPARE(coverage.imageCount(), 1);
+    QCOMPARE(coverage.maxOverlap(), 1);
+
+    // Image is centered on the trigger with the frontal footprint along the transect
+    QCOMPARE(coverage.overlapAt(_offset(200, 200)), 1);
+    QCOMPARE(coverage.overlapAt(_offset(200, 208)), 1);
+    QCOMPARE(coverage.overlapAt(_offset(213, 200)), 1);
+    QCOMPARE(coverage.overlapAt(_offset(200, 212)), 0);
+    QCOMPARE(coverage.overlapAt(_offset(217, 200)), 0);
+    QCOMPARE(coverage.overlapAt(_offset(-10, -10)), -1);
+
+    double coveredArea = coverage.coveredPercent() / 100.0 * _surveySize * _surveySize;
+    QVERIFY(qAbs(coveredArea - 30 * 20) < 30);
+}
+
+void SurveyCoverageTest::_testFullCoverage(void)
+{
+    SurveyCoverage coverage = SurveyCoverage().update(_squareSurvey());
+
+    QVERIFY(coverage.isValid());
+    QCOMPARE(coverage.coveredPercent(), 100.0);
+    QVERIFY(coverage.gaps(10).isEmpty());
+
+    // Overlap in both directions gives (30 / 24) * (20 / 16) images per point
+    QVERIFY(qAbs(coverage.meanOverlap() - 1.5625) < 0.05);
+
+    QGeoCoordinate northWest, southEast;
+    QImage heatMap = coverage.heatMap(northWest, southEast);
+    QVERIFY(!heatMap.isNull());
+    QVERIFY(northWest.isValid() && southEast.isValid());
+    QVERIFY(northWest.latitude() > southEast.latitude());
+}
+
+void SurveyCoverageTest::_testCoverageGap(void)
+{
+    SurveyCoverage::Input input = _squareSurvey();
+
+    // Removing a transect leaves a strip between its neighbours uncovered
+    input.legs.removeAt(8);
+    double gapEast = 8 * _transectSpacing + _transectSpacing / 2;
+
+    SurveyCoverage coverage = SurveyCoverage().update(input);
+    QVERIFY(coverage.coveredPercent() < 100.0);
+    QCOMPARE(coverage.overlapAt(_offset(gapEast, 200)), 0);
+
+    QList<QList<QGeoCoordinate>> gaps = coverage.gaps(10);
+    QCOMPARE(gaps.count(), 1);
+    QCOMPARE(gaps[0].count(), 4);
+    QGeoCoordinate gapCenter((gaps[0][0].latitude() + gaps[0][2].latitude()) / 2.0, (gaps[0][0].longitude() + gaps[0][2].longitude()) / 2.0);
+    QVERIFY(qAbs(gapCenter.longitude() - _offset(gapEast, 200).longitude()) < 0.0001);
+}
+
+void SurveyCoverageTest::_testIncrementalUpdate(void)
+{
+    SurveyCoverage::Input   input       = _squareSurvey();
+    SurveyCoverage          coverage    = SurveyCoverage().update(input);
+    QCOMPARE(coverage.recalculatedLegs(), input.legs.count());
+
+    // Nothing changed
+    SurveyCoverage updatedCoverage = coverage.update(input);
+    QCOMPARE(updatedCoverage.recalculatedLegs(), 0);
+    _compareCoverage(updatedCoverage, coverage);
+
+    // Only the changed leg is recalculated and the result is the same as starting over
+    input.legs[3].path[0] = _offset(80, 50);
+    updatedCoverage = coverage.update(input);
+    QCOMPARE(updatedCoverage.recalculatedLegs(), 1);
+    _compareCoverage(updatedCoverage, SurveyCoverage().update(input));
+
+    // Removed legs
+    input.legs.removeAt(5);
+    updatedCoverage = coverage.update(input);
+    QCOMPARE(updatedCoverage.recalculatedLegs(), 1);
+    _compareCoverage(updatedCoverage, SurveyCoverage().update(input));
+
+    // Changing the camera changes all legs
+    input.footprintSide = 40;
+    QCOMPARE(coverage.update(input).recalculatedLegs(), input.legs.count());
+}
+
+/// Reused footprints must come from a leg with the same inputs, not only the same key
+void SurveyCoverageTest::_testLegMatching(void)
+{
+    SurveyCoverage::Input input = _squareSurvey();
+
+    // Reordered and repeated legs are found again
+    input.legs.append(input.legs[0]);
+    SurveyCoverage coverage = SurveyCoverage().update(input);
+    std::reverse(input.legs.begin(), input.legs.end());
+    SurveyCoverage updatedCoverage = coverage.update(input);
+    QCOMPARE(updatedCoverage.recalculatedLegs(), 0);
+    _compareCoverage(updatedCoverage, coverage);
+
+    // Terrain heights and path altitudes are part of a leg
+    input.legs[2].path[0].setAltitude(100);
+    input.legs[2].path[1].setAltitude(100);
+    input.legs[2].terrain << _offset(0, 0, 60) << _offset(0, _surveySize, 60);
+    updatedCoverage = coverage.update(input);
+    QCOMPARE(updatedCoverage.recalculatedLegs(), 1);
+    _compareCoverage(updatedCoverage, SurveyCoverage().update(input));
+
+    input.legs[2].terrain[1].setAltitude(70);
+    SurveyCoverage terrainCoverage = updatedCoverage.update(input);
+    QCOMPARE(terrainCoverage.recalculatedLegs(), 1);
+    _compareCoverage(terrainCoverage, SurveyCoverage().update(input));
+
+    // A changed survey area with the same bounds starts over
+    input.polygons[0].insert(2, _offset(_surveySize / 2, _surveySize / 2));
+    updatedCoverage = terrainCoverage.update(input);
+    QCOMPARE(updatedCoverage.recalculatedLegs(), input.legs.count());
+    _compareCoverage(updatedCoverage, SurveyCoverage().update(input));
+}
+
+void SurveyCoverageTest::_testTerrain(void)
+{
+    SurveyCoverage::Input       input = _squareSurvey();
+    SurveyCoverage::TriggerLeg  leg;
+
+    // Flying 100m AMSL over terrain at 75m puts the camera at half of the 50m distance to surface
+    leg.path << _offset(200, 200, 100) << _offset(200, 210, 100);
+    leg.terrain << _offset(200, 150, 75) << _offset(200, 250, 75);
+    input.legs = { leg };
+
+    SurveyCoverage coverage = SurveyCoverage().update(input);
+    double coveredArea = coverage.coveredPercent() / 100.0 * _surveySize * _surveySize;
+    QVERIFY(qAbs(coveredArea - 15 * 10) < 15);
+    QCOMPARE(coverage.overlapAt(_offset(200, 203)), 1);
+    QCOMPARE(coverage.overlapAt(_offset(200, 207)), 0);
+}
+
+void SurveyCoverageTest::_testCancelled(void)
+{
+    SurveyCoverage coverage = SurveyCoverage().update(_squareSurvey(), []() { return true; });
+
+    QVERIFY(!coverage.isValid());
+    QVERIFY(qIsNaN(coverage.coveredPercent()));
+    QCOMPARE(coverage.overlapAt(_offset(200, 200)), -1);
+}
@@ -0,0 +1,35 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "SurveyCoverage.h"
+
+class SurveyCoverageTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testSingleImage       (void);
+    void _testFullCoverage      (void);
+    void _testCoverageGap       (void);
+    void _testIncrementalUpdate (void);
+    void _testLegMatching       (void);
+    void _testTerrain           (void);
+    void _testCancelled         (void);
+
+private:
+    QGeoCoordinate          _offset         (double east, double north, double altitude = qQNaN());
+    SurveyCoverage::Input   _squareSurvey   (void);
+    void                    _compareCoverage(const SurveyCoverage& coverage1, const SurveyCoverage& coverage2);
+
+    static const double _surveySize;
+    static const double _transectSpacing;
+};
@@ -17,7 +17,9 @@
 #include "AppSettings.h"
 #include "QGCQGeoCoordinate.h"
 
+#include <QFutureWatcher>
 #include <QPolygonF>
+#include <QtConcurrent>
 
 QGC_LOGGING_CATEGORY(TransectStyleComplexItemLog, "TransectStyleComplexItemLog")
 
@@ -57,11 +59,21 @@ TransectStyleComplexItem::TransectStyleComplexItem(Vehicle* vehicle, bool flyVie
     , _terrainAdjustToleranceFact       (settingsGroup, _metaDataMap[terrainAdjustToleranceName])
     , _terrainAdjustMaxClimbRateFact    (settingsGroup, _metaDataMap[terrainAdjustMaxClimbRateName])
     , _terrainAdjustMaxDescentRateFact  (settingsGroup, _metaDataMap[terrainAdjustMaxDescentRateName])
+    , _transectGeneration               (new QAtomicInteger<quint32>(0))
+    , _transectsPending                 (false)
+    , _coverageGeneration               (new QAtomicInteger<quint32>(0))
 {
     _terrainQueryTimer.setInterval(_terrainQueryTimeoutMsecs);
     _terrainQueryTimer.setSingleShot(true);
     connect(&_terrainQueryTimer, &QTimer::timeout, this, &TransectStyleComplexItem::_reallyQueryTransectsPathHeightInfo);
 
+    // Coverage is only calculated once the transects stop changing
+    _coverageTimer.setInterval(_coverageRecalcDelayMSecs);
+    _coverageTimer.setSingleShot(true);
+    connect(&_coverageTimer, &QTimer::timeout, this, &TransectStyleComplexItem::_recalcCoverage);
+    connect(&_cameraCalc, &CameraCalc::imageFootprintSideChanged,       &_coverageTimer, QOverload<>::of(&QTimer::start));
+    connect(&_cameraCalc, &CameraCalc::imageFootprintFrontalChanged,    &_coverageTimer, QOverload<>::of(&QTimer::start));
+
     connect(&_turnAroundDistanceFact,                   &Fact::valueChanged,            this, &TransectStyleComplexItem::_rebuildTransects);
     connect(&_hoverAndCaptureFact,                      &Fact::valueChanged,            this, &TransectStyleComplexItem::_rebuildTransects);
     connect(&_refly90DegreesFact,                       &Fact::valueChanged,            this, &TransectStyleComplexItem::_rebuildTransects);
@@ -114,6 +126,13 @@ TransectStyleComplexItem::TransectStyleComplexItem(Vehicle* vehicle, bool flyVie
     setDirty(false);
 }
 
+TransectStyleComplexItem::~TransectStyleComplexItem()
+{
+    // Cancel any rebuild still running on a worker, it only holds a reference to the generation counter
+    _transectGeneration->fetchAndAddOrdered(1);
+    _coverageGeneration->fetchAndAddOrdered(1);
+}
+
 void TransectStyleComplexItem::_setCameraShots(int cameraShots)
 {
     if (_cameraShots != cameraShots) {
@@ -356,7 +375,90 @@ void TransectStyleComplexItem::_rebuildTransects(void)
         return;
     }
 
+    TransectGenerator_t generator = _transectGenerator();
+    if (!generator) {
+        _rebuildTransectsNow();
+        return;
+    }
+
+    // Bumping the generation makes any rebuild which is still running stale, it will stop at its next cancellation check
+    quint32                                 generation  = static_cast<quint32>(++(*_transectGeneration));
+    QSharedPointer<QAtomicInteger<quint32>> latest      = _transectGeneration;
+    CancelledFunc_t                         cancelled   = [latest, generation]() { return latest->loadAcquire() != generation; };
+
+    if (!_transectsPending) {
+        _transectsPending = true;
+        emit readyForSaveStateChanged();
+    }
+
+    // The watcher is a child of the item so results for an item which has been deleted are never delivered
+    QFutureWatcher<Transects_t>* watcher = new QFutureWatcher<Transects_t>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, generation]() {
+        watcher->deleteLater();
+        if (generation == _transectGeneration->loadAcquire()) {
+            _publishTransects(watcher->result());
+        } else {
+            qCDebug(TransectStyleComplexItemLog) << "Dropping stale transects generation:latest" << generation << _transectGeneration->loadAcquire();
+        }
+    });
+    watcher->setFuture(QtConcurrent::run([generator, cancelled]() {
+        return cancelled() ? Transects_t() : generator(cancelled);
+    }));
+}
+
+void TransectStyleComplexItem::_rebuildTransectsNow(void)
+{
+    if (_ignoreRecalc) {
+        return;
+    }
+
+    _transectGeneration->fetchAndAddOrdered(1);
+
     _rebuildTransectsPhase1();
+    _rebuildTransectsPhase2();
+
+    if (_transectsPending) {
+        _transectsPending = false;
+        emit readyForSaveStateChanged();
+    }
+}
+
+/// Rebuilds on the GUI thread when a rebuild is still running on a worker, the transects it would have published are
+/// superseded
+void TransectStyleComplexItem::completePendingWork(void)
+{
+    if (_transectsPending) {
+        _rebuildTransectsNow();
+    }
+}
+
+void TransectStyleComplexItem::_publishTransects(const Transects_t& transects)
+{
+    // If the transects are getting rebuilt then any previously loaded mission items are now invalid
+    if (_loadedMissionItemsParent) {
+        _loadedMissionItems.clear();
+        _loadedMissionItemsParent->deleteLater();
+        _loadedMissionItemsParent = nullptr;
+    }
+
+    _transects = transects;
+    _transectsPathHeightInfo.clear();
+    _transectsPending = false;
+
+    _rebuildTransectsPhase2();
+
+    emit readyForSaveStateChanged();
+}
+
+/// Applies altitudes to the newly built _transects and updates everything derived from them
+void TransectStyleComplexItem::_rebuildTransectsPhase2(void)
+{
+    // Terrain heights which are still outstanding are for the previous transects
+    if (_terrainPolyPathQuery) {
+        _terrainPolyPathQuery->cancel();
+    }
+
+    _transectsTerrainProfile.clear();
 
     if (_followTerrain) {
         // Query the terrain data. Once available terrain heights will be calculated
@@ -416,6 +518,7 @@ void TransectStyleComplexItem::_rebuildTransects(void)
 
     _recalcComplexDistance();
     _recalcCameraShots();
+    _coverageTimer.start();
 
     emit lastSequenceNumberChanged(lastSequenceNumber());
     emit timeBetweenShotsChanged();
@@ -436,20 +539,6 @@ void TransectStyleComplexItem::_queryTransectsPathHeightInfo(void)
 
 void TransectStyleComplexItem::_reallyQueryTransectsPathHeightInfo(void)
 {
-    // Clear any previous query
-    if (_terrainPolyPathQuery) {
-        // FIXME: We should really be blowing away any previous query here. But internally that is difficult to implement so instead we let
-        // it complete and drop the results.
-#if 0
-        // Toss previous query
-        _terrainPolyPathQuery->deleteLater();
-#else
-        // Let the signal fall on the floor
-        disconnect(_terrainPolyPathQuery, &TerrainPolyPathQuery::terrainDataReceived, this, &TransectStyleComplexItem::_polyPathTerrainData);
-#endif
-        _terrainPolyPathQuery = nullptr;
-    }
-
     // Append all transects into a single PolyPath query
 
     QList<QGeoCoordinate> transectPoints;
@@ -461,8 +550,11 @@ void TransectStyleComplexItem::_reallyQueryTransectsPathHeightInfo(void)
     }
 
     if (transectPoints.count() > 1) {
-        _terrainPolyPathQuery = new TerrainPolyPathQuery(this);
-        connect(_terrainPolyPathQuery, &TerrainPolyPathQuery::terrainDataReceived, this, &TransectStyleComplexItem::_polyPathTerrainData);
+        // The query is reused, a new request replaces any previous one which is still outstanding
+        if (!_terrainPolyPathQuery) {
+            _terrainPolyPathQuery = new TerrainPolyPathQuery(this);
+            connect(_terrainPolyPathQuery, &TerrainPolyPathQuery::terrainDataReceived, this, &TransectStyleComplexItem::_polyPathTerrainData);
+        }
         _terrainPolyPathQuery->requestData(transectPoints);
     }
 }
@@ -488,19 +580,13 @@ void TransectStyleComplexItem::_polyPathTerrainData(bool success, const QList<Te
         // Now that we have terrain data we can adjust
         _adjustTransectsForTerrain();
     }
-
-    if (_terrainPolyPathQuery != sender()) {
-        qWarning() << "TransectStyleComplexItem::_polyPathTerrainData _terrainPolyPathQuery != sender()";
-    }
-    disconnect(_terrainPolyPathQuery, &TerrainPolyPathQuery::terrainDataReceived, this, &TransectStyleComplexItem::_polyPathTerrainData);
-    _terrainPolyPathQuery = nullptr;
 }
 
 TransectStyleComplexItem::ReadyForSaveState TransectStyleComplexItem::readyForSaveState(void) const
 {
     bool terrainReady = _followTerrain ? _transectsPathHeightInfo.count() : true;
     bool polygonNotReady = !_surveyAreaPolygon.isValid();
-    return (polygonNotReady || _wizardMode) ?
+    return (polygonNotReady || _wizardMode || _transectsPending) ?
                 NotReadyForSaveData :
                 (terrainReady ? ReadyForSave : NotReadyForSaveTerrain);
 }
@@ -519,6 +605,18 @@ void TransectStyleComplexItem::_adjustTransectsForTerrain(void)
             _addInterstitialTerrainPoints(_transects[i], _transectsPathHeightInfo[i]);
         }
 
+        // At this point each transect point is at the requested altitude above terrain, which gives the terrain profile
+        // for the image footprints
+        double requestedAltitude = _cameraCalc.distanceToSurface()->rawValue().toDouble();
+        _transectsTerrainProfile.clear();
+        for (const QList<CoordInfo_t>& transect: _transects) {
+            QList<QGeoCoordinate> terrainProfile;
+            for (const CoordInfo_t& coordInfo: transect) {
+                terrainProfile.append(QGeoCoordinate(coordInfo.coord.latitude(), coordInfo.coord.longitude(), coordInfo.coord.altitude() - requestedAltitude));
+            }
+            _transectsTerrainProfile.append(terrainProfile);
+        }
+
         for (int i=0; i<_transects.count(); i++) {
             _adjustForMaxRates(_transects[i]);
         }
@@ -528,6 +626,7 @@ void TransectStyleComplexItem::_adjustTransectsForTerrain(void)
         }
 
         emit lastSequenceNumberChanged(lastSequenceNumber());
+        _coverageTimer.start();
     }
 }
 
@@ -789,3 +888,66 @@ void TransectStyleComplexItem::_handleHoverAndCaptureEnabled(QVariant enabled)
         _cameraTriggerInTurnAroundFact.setRawValue(false);
     }
 }
+
+/// Builds the coverage input from the current transects. Images are taken over the part of each transect which is
+/// not turnaround, unless images are also taken in the turnarounds.
+SurveyCoverage::Input TransectStyleComplexItem::_coverageInput(void) const
+{
+    SurveyCoverage::Input input;
+
+    input.polygons.append(_surveyAreaPolygon.coordinateList());
+    input.triggerDistance   = triggerDistance();
+    input.footprintSide     = _cameraCalc.imageFootprintSide();
+    input.footprintFrontal  = _cameraCalc.imageFootprintFrontal();
+    input.distanceToSurface = _cameraCalc.distanceToSurface()->rawValue().toDouble();
+
+    bool imagesInTurnaround = _cameraTriggerInTurnAroundFact.rawValue().toBool();
+    for (int i=0; i<_transects.count(); i++) {
+        SurveyCoverage::TriggerLeg leg;
+        for (const CoordInfo_t& coordInfo: _transects[i]) {
+            if (imagesInTurnaround || coordInfo.coordType != CoordTypeTurnaround) {
+                leg.path.append(coordInfo.coord);
+            }
+        }
+        if (i < _transectsTerrainProfile.count()) {
+            leg.terrain = _transectsTerrainProfile[i];
+        }
+        input.legs.append(leg);
+    }
+
+    return input;
+}
+
+void TransectStyleComplexItem::_recalcCoverage(void)
+{
+    // Bumping the generation makes any calculation which is still running stale
+    quint32                                 generation  = static_cast<quint32>(++(*_coverageGeneration));
+    QSharedPointer<QAtomicInteger<quint32>> latest      = _coverageGeneration;
+    SurveyCoverage::CancelledFunc_t         cancelled   = [latest, generation]() { return latest->loadAcquire() != generation; };
+    SurveyCoverage                          previous    = _coverage;
+    SurveyCoverage::Input                   input       = _coverageInput();
+
+    QFutureWatcher<SurveyCoverage>* watcher = new QFutureWatcher<SurveyCoverage>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, generation]() {
+        watcher->deleteLater();
+        if (generation != _coverageGeneration->loadAcquire()) {
+            return;
+        }
+
+        _coverage = watcher->result();
+        qCDebug(TransectStyleComplexItemLog) << "Coverage images:recalculatedLegs:percent:meanOverlap" << _coverage.imageCount() << _coverage.recalculatedLegs() << _coverage.coveredPercent() << _coverage.meanOverlap();
+
+        _coverageGaps.clear();
+        for (const QList<QGeoCoordinate>& gap: _coverage.gaps(_maxCoverageGaps)) {
+            QVariantList gapPath;
+            for (const QGeoCoordinate& coord: gap) {
+                gapPath.append(QVariant::fromValue(coord));
+            }
+            _coverageGaps.append(QVariant::fromValue(gapPath));
+        }
+        emit coverageChanged();
+    });
+    watcher->setFuture(QtConcurrent::run([previous, input, cancelled]() {
+        return previous.update(input, cancelled);
+    }));
+}
@@ -17,6 +17,12 @@
 #include "QGCMapPolygon.h"
 #include "CameraCalc.h"
 #include "TerrainQuery.h"
+#include "SurveyCoverage.h"
+
+#include <QAtomicInteger>
+#include <QSharedPointer>
+
+#include <functional>
 
 Q_DECLARE_LOGGING_CATEGORY(TransectStyleComplexItemLog)
 
@@ -26,6 +32,7 @@ class TransectStyleComplexItem : public ComplexMissionItem
 
 public:
     TransectStyleComplexItem(Vehicle* vehicle, bool flyView, QString settignsGroup, QObject* parent);
+    ~TransectStyleComplexItem();
 
     Q_PROPERTY(QGCMapPolygon*   surveyAreaPolygon           READ surveyAreaPolygon                                  CONSTANT)
     Q_PROPERTY(CameraCalc*      cameraCalc                  READ cameraCalc                                         CONSTANT)
@@ -39,6 +46,9 @@ public:
     Q_PROPERTY(double           coveredArea                 READ coveredArea                                        NOTIFY coveredAreaChanged)
     Q_PROPERTY(bool             hoverAndCaptureAllowed      READ hoverAndCaptureAllowed                             CONSTANT)
     Q_PROPERTY(QVariantList     visualTransectPoints        READ visualTransectPoints                               NOTIFY visualTransectPointsChanged)
+    Q_PROPERTY(double           coveragePercent             READ coveragePercent                                    NOTIFY coverageChanged)     ///< NaN until calculated
+    Q_PROPERTY(double           meanOverlap                 READ meanOverlap                                        NOTIFY coverageChanged)     ///< NaN until calculated
+    Q_PROPERTY(QVariantList     coverageGaps                READ coverageGaps                                       NOTIFY coverageChanged)     ///< List of gap polygon paths
 
     Q_PROPERTY(bool             followTerrain               READ followTerrain              WRITE setFollowTerrain  NOTIFY followTerrainChanged)
     Q_PROPERTY(Fact*            terrainAdjustTolerance      READ terrainAdjustTolerance                             CONSTANT)
@@ -48,6 +58,7 @@ public:
     QGCMapPolygon*  surveyAreaPolygon   (void) { return &_surveyAreaPolygon; }
     CameraCalc*     cameraCalc          (void) { return &_cameraCalc; }
     QVariantList    visualTransectPoints(void) { return _visualTransectPoints; }
+    QVariantList    coverageGaps        (void) { return _coverageGaps; }
 
     Fact* turnAroundDistance            (void) { return &_turnAroundDistanceFact; }
     Fact* cameraTriggerInTurnAround     (void) { return &_cameraTriggerInTurnAroundFact; }
@@ -63,6 +74,11 @@ public:
     double          coveredArea             (void) const;
     bool            hoverAndCaptureAllowed  (void) const;
     bool            followTerrain           (void) const { return _followTerrain; }
+    double          coveragePercent         (void) const { return _coverage.coveredPercent(); }
+    double          meanOverlap             (void) const { return _coverage.meanOverlap(); }
+
+    /// Image coverage of the survey area, calculated on a worker shortly after the transects change
+    const SurveyCoverage& coverage          (void) const { return _coverage; }
 
     virtual double  timeBetweenShots        (void) { return 0; } // Most be overridden. Implementation here is needed for unit testing.
 
@@ -80,6 +96,7 @@ public:
 
     double          complexDistance     (void) const final { return _complexDistance; }
     double          greatestDistanceTo  (const QGeoCoordinate &other) const final;
+    void            completePendingWork (void) final;
 
     // Overrides from VisualMissionItem
 
@@ -126,6 +143,7 @@ signals:
     void timeBetweenShotsChanged        (void);
     void visualTransectPointsChanged    (void);
     void coveredAreaChanged             (void);
+    void coverageChanged                (void);
     void followTerrainChanged           (bool followTerrain);
 
 protected slots:
@@ -166,8 +184,20 @@ protected:
         CoordType       coordType;
     } CoordInfo_t;
 
+    typedef QList<QList<CoordInfo_t>>                               Transects_t;
+    typedef std::function<bool(void)>                               CancelledFunc_t;
+    typedef std::function<Transects_t(const CancelledFunc_t&)>      TransectGenerator_t;
+
+    /// Returns a generator which builds the transects from a value copy of the current settings. The generator is run on a
+    /// worker thread so it must not reference the item. It should return early once cancelled returns true, which happens as
+    /// soon as a newer rebuild has been requested. The default empty generator means only _rebuildTransectsPhase1 is supported.
+    virtual TransectGenerator_t _transectGenerator(void) const { return TransectGenerator_t(); }
+
+    /// Rebuilds the transects on the GUI thread, superseding any rebuild still running on a worker
+    void _rebuildTransectsNow(void);
+
     QVariantList                                        _visualTransectPoints;
-    QList<QList<CoordInfo_t>>                           _transects;
+    Transects_t                                         _transects;
     QList<QList<TerrainPathQuery::PathHeightInfo_t>>    _transectsPathHeightInfo;
     TerrainPolyPathQuery*                               _terrainPolyPathQuery;
     QTimer                                              _terrainQueryTimer;
@@ -206,13 +236,30 @@ private slots:
     void _reallyQueryTransectsPathHeightInfo(void);
     void _followTerrainChanged              (bool followTerrain);
     void _handleHoverAndCaptureEnabled      (QVariant enabled);
+    void _recalcCoverage                    (void);
 
 private:
+    void    _rebuildTransectsPhase2         (void);
+    void    _publishTransects               (const Transects_t& transects);
     void    _queryTransectsPathHeightInfo   (void);
     void    _adjustTransectsForTerrain      (void);
     void    _addInterstitialTerrainPoints   (QList<CoordInfo_t>& transect, const QList<TerrainPathQuery::PathHeightInfo_t>& transectPathHeightInfo);
     void    _adjustForMaxRates              (QList<CoordInfo_t>& transect);
     void    _adjustForTolerance             (QList<CoordInfo_t>& transect);
+    SurveyCoverage::Input _coverageInput    (void) const;
     double  _altitudeBetweenCoords          (const QGeoCoordinate& fromCoord, const QGeoCoordinate& toCoord, double percentTowardsTo);
     int     _maxPathHeight                  (const TerrainPathQuery::PathHeightInfo_t& pathHeightInfo, int fromIndex, int toIndex, double& maxHeight);
+
+    /// Id of the latest transect rebuild. Shared with the workers so they can tell when they are stale, even once the item is gone.
+    QSharedPointer<QAtomicInteger<quint32>> _transectGeneration;
+    bool                                    _transectsPending;      ///< true: a worker is generating the latest transects
+
+    QList<QList<QGeoCoordinate>>            _transectsTerrainProfile;   ///< Terrain heights along each transect as altitudes, empty if not following terrain
+    SurveyCoverage                          _coverage;
+    QVariantList                            _coverageGaps;
+    QTimer                                  _coverageTimer;
+    QSharedPointer<QAtomicInteger<quint32>> _coverageGeneration;
+
+    static const int _coverageRecalcDelayMSecs  = 250;
+    static const int _maxCoverageGaps           = 100;
 };
@@ -178,22 +178,23 @@ void VisualMissionItem::_updateTerrainAltitude(void)
 void VisualMissionItem::_reallyUpdateTerrainAltitude(void)
 {
     QGeoCoordinate coord = coordinate();
-    if (specifiesCoordinate() && coord.isValid() && (qIsNaN(_terrainAltitude) || !qFuzzyCompare(_lastLatTerrainQuery, coord.latitude()) || qFuzzyCompare(_lastLonTerrainQuery, coord.longitude()))) {
+    if (specifiesCoordinate() && coord.isValid() && (qIsNaN(_terrainAltitude) || !qFuzzyCompare(_lastLatTerrainQuery, coord.latitude()) || !qFuzzyCompare(_lastLonTerrainQuery, coord.longitude()))) {
         _lastLatTerrainQuery = coord.latitude();
         _lastLonTerrainQuery = coord.longitude();
-        TerrainAtCoordinateQuery* terrain = new TerrainAtCoordinateQuery(this);
-        connect(terrain, &TerrainAtCoordinateQuery::terrainDataReceived, this, &VisualMissionItem::_terrainDataReceived);
+        if (!_terrainAtCoordinateQuery) {
+            _terrainAtCoordinateQuery = new TerrainAtCoordinateQuery(this);
+            connect(_terrainAtCoordinateQuery, &TerrainAtCoordinateQuery::terrainDataReceived, this, &VisualMissionItem::_terrainDataReceived);
+        }
         QList<QGeoCoordinate> rgCoord;
         rgCoord.append(coordinate());
-        terrain->requestData(rgCoord);
+        _terrainAtCoordinateQuery->requestData(rgCoord);
     }
 }
 
 void VisualMissionItem::_terrainDataReceived(bool success, QList<double> heights)
 {
-    _terrainAltitude = success ? heights[0] : qQNaN();
+    _terrainAltitude = success && heights.count() ? heights[0] : qQNaN();
     emit terrainAltitudeChanged(_terrainAltitude);
-    sender()->deleteLater();
 }
 
 void VisualMissionItem::_setBoundingCube(QGCGeoBoundingCube bc)
@@ -26,6 +26,7 @@
 #include "MissionController.h"
 
 class MissionItem;
+class TerrainAtCoordinateQuery;
 
 // Abstract base class for all Simple and Complex visual mission objects.
 class VisualMissionItem : public QObject
@@ -265,7 +266,8 @@ private slots:
 private:
     void _commonInit(void);
 
-    QTimer _updateTerrainTimer;
-    double _lastLatTerrainQuery = 0;
-    double _lastLonTerrainQuery = 0;
+    QTimer                      _updateTerrainTimer;
+    double                      _lastLatTerrainQuery =      0;
+    double                      _lastLonTerrainQuery =      0;
+    TerrainAtCoordinateQuery*   _terrainAtCoordinateQuery = nullptr;   ///< Reused so a new request replaces any outstanding one
 };
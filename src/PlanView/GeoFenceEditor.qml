@@ -3,11 +3,12 @@ import QtQuick.Controls 1.2
 import QtQuick.Layouts  1.2
 import QtPositioning    5.2
 
-import QGroundControl               1.0
-import QGroundControl.ScreenTools   1.0
-import QGroundControl.Controls      1.0
-import QGroundControl.FactSystem    1.0
-import QGroundControl.FactControls  1.0
+import QGroundControl                   1.0
+import QGroundControl.ScreenTools       1.0
+import QGroundControl.Controls          1.0
+import QGroundControl.FactSystem        1.0
+import QGroundControl.FactControls      1.0
+import QGroundControl.ShapeFileHelper   1.0
 
 QGCFlickable {
     id:             root
@@ -140,6 +141,21 @@ QGCFlickable {
                         }
                     }
 
+                    QGCButton {
+                        Layout.fillWidth:   true
+                        text:               shapeFileImporter.running ?
+                                                qsTr("Cancel Import (%1%)").arg(Math.round(shapeFileImporter.progress * 100)) :
+                                                qsTr("Import Polygon Fences...")
+
+                        onClicked: {
+                            if (shapeFileImporter.running) {
+                                shapeFileImporter.cancel()
+                            } else {
+                                kmlOrSHPLoadDialog.openForLoad()
+                            }
+                        }
+                    }
+
                     SectionHeader {
                         id:             polygonSection
                         anchors.left:   parent.left
@@ -352,4 +368,27 @@ QGCFlickable {
             }
         }
     } // Rectangle
+
+    KMLOrSHPFileDialog {
+        id:             kmlOrSHPLoadDialog
+        title:          qsTr("Select Polygon File")
+        selectExisting: true
+
+        onAcceptedForLoad: {
+            shapeFileImporter.start(file)
+            close()
+        }
+    }
+
+    ShapeFileImporter {
+        id: shapeFileImporter
+
+        onFinished: {
+            if (success) {
+                myGeoFenceController.addInclusionPolygonsFromShapeImport(shapeFileImporter)
+            } else {
+                mainWindow.showMessageDialog(qsTr("Import Polygon Fences"), errorString)
+            }
+        }
+    }
 }
@@ -291,6 +291,12 @@ Item {
         _missionController.insertComplexMissionItem(complexItemName, mapCenter(), nextIndex, true /* makeCurrentItem */)
     }
 
+    function isShapeImportItem(complexItemName) {
+        return complexItemName === _missionController.surveyComplexItemName ||
+                complexItemName === _missionController.corridorScanComplexItemName ||
+                complexItemName === _missionController.structureScanComplexItemName
+    }
+
     function selectNextNotReady() {
         var foundCurrent = false
         for (var i=0; i<_missionController.visualItems.count; i++) {
@@ -327,6 +333,35 @@ Item {
         }
     }
 
+    property string _shapeImportItemName    ///< Complex item created for each shape of the running import
+
+    KMLOrSHPFileDialog {
+        id:             shapeImportDialog
+        selectExisting: true
+
+        onAcceptedForLoad: {
+            shapeFileImporter.start(file)
+            close()
+        }
+    }
+
+    ShapeFileImporter {
+        id: shapeFileImporter
+
+        onFinished: {
+            if (success) {
+                var itemCount = _missionController.insertComplexMissionItemsFromShapeImport(_shapeImportItemName, shapeFileImporter, _missionController.currentPlanViewVIIndex + 1)
+                if (itemCount === 0) {
+                    mainWindow.showMessageDialog(qsTr("Import Patterns"), qsTr("The file does not contain any shapes which can be used for %1.").arg(_shapeImportItemName))
+                } else {
+                    mapFitFunctions.fitMapViewportToMissionItems()
+                }
+            } else {
+                mainWindow.showMessageDialog(qsTr("Import Patterns"), shapeFileImporter.errorString)
+            }
+        }
+    }
+
     Component {
         id: moveDialog
         QGCViewDialog {
@@ -994,6 +1029,33 @@ Item {
                     }
                 }
             }
+
+            QGCLabel { text: qsTr("Create a pattern for each shape in a file:") }
+
+            Repeater {
+                model: _missionController.complexMissionItemNames
+
+                QGCButton {
+                    text:               qsTr("%1 Import...").arg(modelData)
+                    Layout.fillWidth:   true
+                    visible:            isShapeImportItem(modelData)
+                    enabled:            !shapeFileImporter.running
+
+                    onClicked: {
+                        _shapeImportItemName =      modelData
+                        shapeImportDialog.title =   modelData === _missionController.corridorScanComplexItemName ? qsTr("Select Polyline File") : qsTr("Select Polygon File")
+                        shapeImportDialog.openForLoad()
+                        dropPanel.hide()
+                    }
+                }
+            }
+
+            QGCButton {
+                text:               qsTr("Cancel Import (%1%)").arg(Math.round(shapeFileImporter.progress * 100))
+                Layout.fillWidth:   true
+                visible:            shapeFileImporter.running
+                onClicked:          shapeFileImporter.cancel()
+            }
         } // Column
     }
 
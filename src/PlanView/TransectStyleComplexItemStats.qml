@@ -24,4 +24,10 @@ Grid {
 
     QGCLabel { text: qsTr("Trigger Distance") }
     QGCLabel { text: missionItem.cameraCalc.adjustedFootprintFrontal.valueString + " " + missionItem.cameraCalc.adjustedFootprintFrontal.units }
+
+    QGCLabel { text: qsTr("Coverage") }
+    QGCLabel { text: isNaN(missionItem.coveragePercent) ? "-" : missionItem.coveragePercent.toFixed(1) + "%" }
+
+    QGCLabel { text: qsTr("Mean Overlap") }
+    QGCLabel { text: isNaN(missionItem.meanOverlap) ? "-" : missionItem.meanOverlap.toFixed(1) + " " + qsTr("images") }
 }
@@ -77,6 +77,21 @@ Item {
         interiorOpacity:    0.5
     }
 
+    // Parts of the survey area which are not in any image. Shown when item is selected.
+    Instantiator {
+        model: _currentItem ? _missionItem.coverageGaps : []
+
+        delegate: MapPolygon {
+            color:          "red"
+            opacity:        0.5
+            border.width:   0
+            path:           modelData
+        }
+
+        onObjectAdded:      map.addMapItem(object)
+        onObjectRemoved:    map.removeMapItem(object)
+    }
+
     // Full set of transects lines. Shown when item is selected.
     Component {
         id: fullTransectsComponent
@@ -26,6 +26,7 @@
 #include <QStringListModel>
 #include <QRegularExpression>
 #include <QFontDatabase>
+#include <QElapsedTimer>
 #include <QQuickWindow>
 
 #ifdef QGC_ENABLE_BLUETOOTH
@@ -61,6 +62,8 @@
 #include "Vehicle.h"
 #include "JoystickConfigController.h"
 #include "JoystickManager.h"
+#include "QGCMapEngineManager.h"
+#include "QGCToolbox.h"
 #include "QmlObjectListModel.h"
 #include "QGCGeoBoundingCube.h"
 #include "MissionManager.h"
@@ -91,6 +94,7 @@
 #include "EditPositionDialogController.h"
 #include "FactValueSliderListModel.h"
 #include "ShapeFileHelper.h"
+#include "ShapeFileImporter.h"
 #include "QGCFileDownload.h"
 #include "FirmwareImage.h"
 #include "MavlinkConsoleController.h"
@@ -98,6 +102,9 @@
 #include "LogReplayLink.h"
 #include "VehicleObjectAvoidance.h"
 #include "TrajectoryPoints.h"
+#include "CameraTriggerPoints.h"
+#include "GeoFenceBreachMonitor.h"
+#include "ObserverVehicleTable.h"
 
 #if defined(QGC_ENABLE_PAIRING)
 #include "PairingManager.h"
@@ -341,6 +348,7 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
     initializeVideoStreaming(argc, argv, savePath.toUtf8().data(), gstDebugLevel.toUtf8().data());
 #endif
 
+    qCDebug(StartupProfilerLog) << "Creating toolbox at boot msecs:" << QGC::bootTimeMilliseconds();
     _toolbox = new QGCToolbox(this);
     _toolbox->setChildToolboxes();
 
@@ -502,6 +510,10 @@ void QGCApplication::_initCommon()
     qmlRegisterUncreatableType<QGCCameraControl>        (kQGCVehicle,                       1, 0, "QGCCameraControl",           kRefOnly);
     qmlRegisterUncreatableType<QGCVideoStreamInfo>      (kQGCVehicle,                       1, 0, "QGCVideoStreamInfo",         kRefOnly);
     qmlRegisterUncreatableType<LinkInterface>           (kQGCVehicle,                       1, 0, "LinkInterface",              kRefOnly);
+    qmlRegisterUncreatableType<CameraTriggerPoints>     (kQGCVehicle,                       1, 0, "CameraTriggerPoints",        kRefOnly);
+    qmlRegisterUncreatableType<GeoFenceBreachMonitor>   (kQGCVehicle,                       1, 0, "GeoFenceBreachMonitor",      kRefOnly);
+    qmlRegisterUncreatableType<ObserverVehicleTable>    (kQGCVehicle,                       1, 0, "ObserverVehicleTable",       kRefOnly);
+    qmlRegisterUncreatableType<CameraTriggerClusterModel>(kQGCVehicle,                      1, 0, "CameraTriggerClusterModel",  kRefOnly);
     qmlRegisterUncreatableType<MissionController>       (kQGCControllers,                   1, 0, "MissionController",          kRefOnly);
     qmlRegisterUncreatableType<GeoFenceController>      (kQGCControllers,                   1, 0, "GeoFenceController",         kRefOnly);
     qmlRegisterUncreatableType<RallyPointController>    (kQGCControllers,                   1, 0, "RallyPointController",       kRefOnly);
@@ -524,6 +536,7 @@ void QGCApplication::_initCommon()
     qmlRegisterUncreatableType<AutoPilotPlugin>     ("QGroundControl.AutoPilotPlugin",      1, 0, "AutoPilotPlugin",            kRefOnly);
     qmlRegisterUncreatableType<VehicleComponent>    ("QGroundControl.AutoPilotPlugin",      1, 0, "VehicleComponent",           kRefOnly);
     qmlRegisterUncreatableType<JoystickManager>     ("QGroundControl.JoystickManager",      1, 0, "JoystickManager",            kRefOnly);
+    qmlRegisterUncreatableType<QGCMapEngineManager> ("QGroundControl.QGCMapEngineManager",  1, 0, "QGCMapEngineManager",        kRefOnly);
     qmlRegisterUncreatableType<Joystick>            ("QGroundControl.JoystickManager",      1, 0, "Joystick",                   kRefOnly);
     qmlRegisterUncreatableType<QGCPositionManager>  ("QGroundControl.QGCPositionManager",   1, 0, "QGCPositionManager",         kRefOnly);
     qmlRegisterUncreatableType<FactValueSliderListModel>("QGroundControl.FactControls",     1, 0, "FactValueSliderListModel",   kRefOnly);
@@ -556,6 +569,7 @@ void QGCApplication::_initCommon()
 #if defined(QGC_ENABLE_MAVLINK_INSPECTOR)
     qmlRegisterType<MAVLinkInspectorController>     (kQGCControllers,                       1, 0, "MAVLinkInspectorController");
 #endif
+    qmlRegisterType<ShapeFileImporter>              ("QGroundControl.ShapeFileHelper",      1, 0, "ShapeFileImporter");
     // Register Qml Singletons
     qmlRegisterSingletonType<QGroundControlQmlGlobal>   ("QGroundControl",                          1, 0, "QGroundControl",         qgroundcontrolQmlGlobalSingletonFactory);
     qmlRegisterSingletonType<ScreenToolsController>     ("QGroundControl.ScreenToolsController",    1, 0, "ScreenToolsController",  screenToolsControllerSingletonFactory);
@@ -574,11 +588,22 @@ bool QGCApplication::_initForNormalAppBoot()
 
     QSettings settings;
 
+    QElapsedTimer timer;
+    timer.start();
+    qCDebug(StartupProfilerLog) << "Creating root window at boot msecs:" << QGC::bootTimeMilliseconds();
     _qmlAppEngine = toolbox()->corePlugin()->createRootWindow(this);
+    qCDebug(StartupProfilerLog) << "Root window created msecs:" << timer.elapsed();
 
     QQuickWindow* rootWindow = (QQuickWindow*)qgcApp()->mainRootWindow();
 
     if (rootWindow) {
+        // Views other than Fly are loaded asynchronously, so the first frame marks the end of startup
+        QMetaObject::Connection* firstFrame = new QMetaObject::Connection;
+        *firstFrame = connect(rootWindow, &QQuickWindow::frameSwapped, this, [firstFrame]() {
+            qCDebug(StartupProfilerLog) << "First frame at boot msecs:" << QGC::bootTimeMilliseconds();
+            QObject::disconnect(*firstFrame);
+            delete firstFrame;
+        });
         rootWindow->scheduleRenderJob (new FinishVideoInitialization (toolbox()->videoManager()),
                 QQuickWindow::BeforeSynchronizingStage);
     }
@@ -0,0 +1,190 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCFrameScheduler.h"
+
+QGC_LOGGING_CATEGORY(QGCFrameSchedulerLog, "QGCFrameSchedulerLog")
+
+QGCFrameScheduler::QGCFrameScheduler(QGCApplication* app, QGCToolbox* toolbox)
+    : QGCTool       (app, toolbox)
+    , _nextTaskId   (1)
+    , _runningTasks (false)
+    , _tasksRemoved (false)
+{
+    resetStatistics();
+    _clock.start();
+
+    _timer.setSingleShot(true);
+    _timer.setTimerType(Qt::PreciseTimer);
+    connect(&_timer, &QTimer::timeout, this, &QGCFrameScheduler::_runDueTasks);
+}
+
+void QGCFrameScheduler::resetStatistics(void)
+{
+    _statistics.wakeups =           0;
+    _statistics.taskRuns =          0;
+    _statistics.signalsEmitted =    0;
+}
+
+int QGCFrameScheduler::registerTask(QObject* receiver, int intervalMSecs, const TaskFunc_t& task)
+{
+    Task newTask;
+
+    newTask.id =            _nextTaskId++;
+    newTask.receiver =      receiver;
+    newTask.intervalMSecs = qMax(intervalMSecs, 1);
+    newTask.dueMSecs =      _nextDueMSecs(_clock.elapsed(), newTask.intervalMSecs);
+    newTask.active =        true;
+    newTask.removed =       false;
+    newTask.func =          task;
+    _tasks.append(newTask);
+
+    if (receiver && !_receivers.contains(receiver)) {
+        _receivers.insert(receiver);
+        connect(receiver, &QObject::destroyed, this, &QGCFrameScheduler::_receiverDestroyed);
+    }
+
+    qCDebug(QGCFrameSchedulerLog) << "registerTask id:interval:receiver" << newTask.id << newTask.intervalMSecs << receiver;
+
+    _scheduleWakeup();
+
+    return newTask.id;
+}
+
+int QGCFrameScheduler::_taskIndex(int taskId) const
+{
+    for (int i=0; i<_tasks.count(); i++) {
+        if (_tasks[i].id == taskId) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void QGCFrameScheduler::unregisterTask(int taskId)
+{
+    int index = _taskIndex(taskId);
+
+    if (index != -1) {
+        _tasks[index].removed = true;
+        _removeTasks();
+    }
+}
+
+void QGCFrameScheduler::unregisterTasks(QObject* receiver)
+{
+    for (Task& task: _tasks) {
+        if (task.receiver == receiver) {
+            task.removed = true;
+        }
+    }
+    if (_receivers.remove(receiver)) {
+        disconnect(receiver, &QObject::destroyed, this, &QGCFrameScheduler::_receiverDestroyed);
+    }
+    _removeTasks();
+}
+
+void QGCFrameScheduler::_receiverDestroyed(QObject* receiver)
+{
+    for (Task& task: _tasks) {
+        if (task.receiver == receiver) {
+            task.removed = true;
+        }
+    }
+    _receivers.remove(receiver);
+    _removeTasks();
+}
+
+/// Removes tasks marked as removed. While tasks are running this is put off until the run is complete, since task
+/// indices must stay stable.
+void QGCFrameScheduler::_removeTasks(void)
+{
+    if (_runningTasks) {
+        _tasksRemoved = true;
+        return;
+    }
+
+    for (int i=_tasks.count()-1; i>=0; i--) {
+        if (_tasks[i].removed) {
+            _tasks.remove(i);
+        }
+    }
+    _tasksRemoved = false;
+
+    _scheduleWakeup();
+}
+
+void QGCFrameScheduler::setTaskActive(int taskId, bool active)
+{
+    int index = _taskIndex(taskId);
+
+    if (index != -1 && _tasks[index].active != active) {
+        _tasks[index].active = active;
+        if (active) {
+            _tasks[index].dueMSecs = _nextDueMSecs(_clock.elapsed(), _tasks[index].intervalMSecs);
+        }
+        _scheduleWakeup();
+    }
+}
+
+void QGCFrameScheduler::_scheduleWakeup(void)
+{
+    if (_runningTasks) {
+        // Wakeup is scheduled once the current run is complete
+        return;
+    }
+
+    qint64 earliestDueMSecs = -1;
+    for (const Task& task: _tasks) {
+        if (task.active && (earliestDueMSecs == -1 || task.dueMSecs < earliestDueMSecs)) {
+            earliestDueMSecs = task.dueMSecs;
+        }
+    }
+
+    if (earliestDueMSecs == -1) {
+        _timer.stop();
+        return;
+    }
+
+    // Wake up on the frame boundary at or after the earliest due time
+    qint64 wakeupMSecs = (earliestDueMSecs + frameIntervalMSecs - 1) / frameIntervalMSecs * frameIntervalMSecs;
+    _timer.start(static_cast<int>(qMax(wakeupMSecs - _clock.elapsed(), static_cast<qint64>(0))));
+}
+
+void QGCFrameScheduler::_runDueTasks(void)
+{
+    qint64 nowMSecs = _clock.elapsed();
+
+    // Timer wakeups are not exact, the frame being run is the one starting at the nearest frame boundary
+    qint64 frameEndMSecs = ((nowMSecs + frameIntervalMSecs / 2) / frameIntervalMSecs + 1) * frameIntervalMSecs;
+
+    _statistics.wakeups++;
+
+    // Tasks registered by a running task are only considered on the next wakeup
+    _runningTasks = true;
+    int taskCount = _tasks.count();
+    for (int i=0; i<taskCount; i++) {
+        if (_tasks[i].active && !_tasks[i].removed && _tasks[i].dueMSecs < frameEndMSecs) {
+            // Wakeups can come slightly before the due time, the next run must still be a full interval later
+            _tasks[i].dueMSecs = _nextDueMSecs(qMax(nowMSecs, _tasks[i].dueMSecs), _tasks[i].intervalMSecs);
+            _statistics.taskRuns++;
+
+            // The task list may grow while the task runs
+            TaskFunc_t func = _tasks[i].func;
+            func();
+        }
+    }
+    _runningTasks = false;
+
+    if (_tasksRemoved) {
+        _removeTasks();
+    } else {
+        _scheduleWakeup();
+    }
+}
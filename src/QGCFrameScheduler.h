@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "QGCLoggingCategory.h"
+#include "QGCToolbox.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+#include <QVector>
+
+#include <functional>
+
+Q_DECLARE_LOGGING_CATEGORY(QGCFrameSchedulerLog)
+
+/// Runs periodic work for many objects from a single timer.
+///
+/// Tasks register for an interval. Due times are multiples of the interval on a common clock, so all tasks with the same
+/// interval come due together no matter when they were registered. The timer only wakes up on frame boundaries and runs
+/// every task which is due within that frame, so for example the deferred value signals of all FactGroups go out in one
+/// batch per frame instead of each group waking up on its own.
+///
+/// Tasks are removed automatically when their receiver is destroyed.
+///
+/// The application wide scheduler is owned by the toolbox, see QGCToolbox::frameScheduler. It is the last tool to be
+/// created, so it is also the last to be destroyed and outlives the Vehicles and other objects owned by the other tools.
+class QGCFrameScheduler : public QGCTool
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<void(void)> TaskFunc_t;
+
+    struct Statistics {
+        quint64 wakeups;            ///< Scheduler timer wakeups
+        quint64 taskRuns;           ///< Tasks run across all wakeups
+        quint64 signalsEmitted;     ///< Signals reported through addSignalsEmitted
+    };
+
+    QGCFrameScheduler(QGCApplication* app, QGCToolbox* toolbox);
+
+    /// Registers a periodic task. The task starts out active.
+    ///     @param receiver Task is removed when the receiver is destroyed
+    ///     @param intervalMSecs Time between runs, tasks run on the first frame boundary at or after they are due
+    /// @return Task id to use with the other methods
+    int registerTask(QObject* receiver, int intervalMSecs, const TaskFunc_t& task);
+
+    void unregisterTask     (int taskId);
+    void unregisterTasks    (QObject* receiver);
+
+    /// Inactive tasks stay registered but do not run
+    void setTaskActive(int taskId, bool active);
+
+    int taskCount(void) const { return _tasks.count(); }
+
+    /// Counts signals sent by a task, so the cost of periodic updates can be measured
+    void addSignalsEmitted(int count) { _statistics.signalsEmitted += static_cast<quint64>(count); }
+
+    Statistics  statistics      (void) const { return _statistics; }
+    void        resetStatistics (void);
+
+    static const int frameIntervalMSecs = 16;   ///< Close to one frame at 60Hz
+
+private slots:
+    void _runDueTasks       (void);
+    void _receiverDestroyed (QObject* receiver);
+
+private:
+    struct Task {
+        int         id;
+        QObject*    receiver;
+        int         intervalMSecs;
+        qint64      dueMSecs;
+        bool        active;
+        bool        removed;
+        TaskFunc_t  func;
+    };
+
+    int     _taskIndex      (int taskId) const;
+    qint64  _nextDueMSecs   (qint64 nowMSecs, int intervalMSecs) const { return (nowMSecs / intervalMSecs + 1) * intervalMSecs; }
+    void    _removeTasks    (void);
+    void    _scheduleWakeup (void);
+
+    QVector<Task>       _tasks;
+    QSet<QObject*>      _receivers;         ///< Receivers whose destroyed signal is connected
+    QElapsedTimer       _clock;
+    QTimer              _timer;
+    int                 _nextTaskId;
+    bool                _runningTasks;
+    bool                _tasksRemoved;      ///< Tasks were unregistered while running tasks
+    Statistics          _statistics;
+};
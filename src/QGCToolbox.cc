@@ -31,6 +31,7 @@
 #include "SettingsManager.h"
 #include "QGCApplication.h"
 #include "ADSBVehicleManager.h"
+#include "QGCFrameScheduler.h"
 #if defined(QGC_ENABLE_PAIRING)
 #include "PairingManager.h"
 #endif
@@ -50,84 +51,129 @@
 #include CUSTOMHEADER
 #endif
 
+#include <QElapsedTimer>
+
+QGC_LOGGING_CATEGORY(StartupProfilerLog, "StartupProfilerLog")
+
+template<class T>
+T* QGCToolbox::_createTool(void)
+{
+    QElapsedTimer timer;
+    timer.start();
+    T* tool = new T(_app, this);
+    qCDebug(StartupProfilerLog) << "Constructor" << T::staticMetaObject.className() << "msecs:" << timer.nsecsElapsed() / 1.0e6;
+    return tool;
+}
+
 QGCToolbox::QGCToolbox(QGCApplication* app)
+    : _app(app)
 {
+    QElapsedTimer timer;
+    timer.start();
+
     // SettingsManager must be first so settings are available to any subsequent tools
-    _settingsManager        = new SettingsManager           (app, this);
+    _settingsManager        = _createTool<SettingsManager>          ();
     //-- Scan and load plugins
     _scanAndLoadPlugins(app);
-    _audioOutput            = new AudioOutput               (app, this);
-    _factSystem             = new FactSystem                (app, this);
-    _firmwarePluginManager  = new FirmwarePluginManager     (app, this);
+    _audioOutput            = _createTool<AudioOutput>              ();
+    _factSystem             = _createTool<FactSystem>               ();
+    _firmwarePluginManager  = _createTool<FirmwarePluginManager>    ();
 #ifndef __mobile__
-    _gpsManager             = new GPSManager                (app, this);
-#endif
-    _imageProvider          = new QGCImageProvider          (app, this);
-    _joystickManager        = new JoystickManager           (app, this);
-    _linkManager            = new LinkManager               (app, this);
-    _mavlinkProtocol        = new MAVLinkProtocol           (app, this);
-    _missionCommandTree     = new MissionCommandTree        (app, this);
-    _multiVehicleManager    = new MultiVehicleManager       (app, this);
-    _mapEngineManager       = new QGCMapEngineManager       (app, this);
-    _uasMessageHandler      = new UASMessageHandler         (app, this);
-    _qgcPositionManager     = new QGCPositionManager        (app, this);
-    _followMe               = new FollowMe                  (app, this);
-    _videoManager           = new VideoManager              (app, this);
-    _mavlinkLogManager      = new MAVLinkLogManager         (app, this);
-    _adsbVehicleManager     = new ADSBVehicleManager        (app, this);
+    _gpsManager             = _createTool<GPSManager>               ();
+#endif
+    _imageProvider          = _createTool<QGCImageProvider>         ();
+    _joystickManager        = _createTool<JoystickManager>          ();
+    _linkManager            = _createTool<LinkManager>              ();
+    _mavlinkProtocol        = _createTool<MAVLinkProtocol>          ();
+    _missionCommandTree     = _createTool<MissionCommandTree>       ();
+    _multiVehicleManager    = _createTool<MultiVehicleManager>      ();
+    _uasMessageHandler      = _createTool<UASMessageHandler>        ();
+    _qgcPositionManager     = _createTool<QGCPositionManager>       ();
+    _followMe               = _createTool<FollowMe>                 ();
+    _videoManager           = _createTool<VideoManager>             ();
+    _mavlinkLogManager      = _createTool<MAVLinkLogManager>        ();
+    _adsbVehicleManager     = _createTool<ADSBVehicleManager>       ();
 #if defined(QGC_ENABLE_PAIRING)
-    _pairingManager         = new PairingManager            (app, this);
+    _pairingManager         = _createTool<PairingManager>           ();
 #endif
     //-- Airmap Manager
     //-- This should be "pluggable" so an arbitrary AirSpace manager can be used
     //-- For now, we instantiate the one and only AirMap provider
 #if defined(QGC_AIRMAP_ENABLED)
-    _airspaceManager        = new AirMapManager             (app, this);
+    _airspaceManager        = _createTool<AirMapManager>            ();
 #else
-    _airspaceManager        = new AirspaceManager           (app, this);
+    _airspaceManager        = _createTool<AirspaceManager>          ();
 #endif
 #if defined(QGC_GST_TAISYNC_ENABLED)
-    _taisyncManager         = new TaisyncManager            (app, this);
+    _taisyncManager         = _createTool<TaisyncManager>           ();
 #endif
 #if defined(QGC_GST_MICROHARD_ENABLED)
-    _microhardManager       = new MicrohardManager          (app, this);
+    _microhardManager       = _createTool<MicrohardManager>         ();
 #endif
+    // Tools are destroyed in the order they are created. The scheduler goes last since objects owned by the other
+    // tools still have tasks registered while they are destroyed.
+    _frameScheduler         = _createTool<QGCFrameScheduler>        ();
+
+    qCDebug(StartupProfilerLog) << "All tools constructed msecs:" << timer.elapsed();
+}
+
+void QGCToolbox::_setToolbox(QGCTool* tool)
+{
+    QElapsedTimer timer;
+    timer.start();
+    tool->setToolbox(this);
+    qCDebug(StartupProfilerLog) << "setToolbox" << tool->metaObject()->className() << "msecs:" << timer.nsecsElapsed() / 1.0e6;
 }
 
 void QGCToolbox::setChildToolboxes(void)
 {
+    QElapsedTimer timer;
+    timer.start();
+
     // SettingsManager must be first so settings are available to any subsequent tools
-    _settingsManager->setToolbox(this);
-    _corePlugin->setToolbox(this);
-    _audioOutput->setToolbox(this);
-    _factSystem->setToolbox(this);
-    _firmwarePluginManager->setToolbox(this);
+    _setToolbox(_settingsManager);
+    _setToolbox(_frameScheduler);
+    _setToolbox(_corePlugin);
+    _setToolbox(_audioOutput);
+    _setToolbox(_factSystem);
+    _setToolbox(_firmwarePluginManager);
 #ifndef __mobile__
-    _gpsManager->setToolbox(this);
-#endif
-    _imageProvider->setToolbox(this);
-    _joystickManager->setToolbox(this);
-    _linkManager->setToolbox(this);
-    _mavlinkProtocol->setToolbox(this);
-    _missionCommandTree->setToolbox(this);
-    _multiVehicleManager->setToolbox(this);
-    _mapEngineManager->setToolbox(this);
-    _uasMessageHandler->setToolbox(this);
-    _followMe->setToolbox(this);
-    _qgcPositionManager->setToolbox(this);
-    _videoManager->setToolbox(this);
-    _mavlinkLogManager->setToolbox(this);
-    _airspaceManager->setToolbox(this);
-    _adsbVehicleManager->setToolbox(this);
+    _setToolbox(_gpsManager);
+#endif
+    _setToolbox(_imageProvider);
+    _setToolbox(_joystickManager);
+    _setToolbox(_linkManager);
+    _setToolbox(_mavlinkProtocol);
+    _setToolbox(_missionCommandTree);
+    _setToolbox(_multiVehicleManager);
+    _setToolbox(_uasMessageHandler);
+    _setToolbox(_followMe);
+    _setToolbox(_qgcPositionManager);
+    _setToolbox(_videoManager);
+    _setToolbox(_mavlinkLogManager);
+    _setToolbox(_airspaceManager);
+    _setToolbox(_adsbVehicleManager);
 #if defined(QGC_GST_TAISYNC_ENABLED)
-    _taisyncManager->setToolbox(this);
+    _setToolbox(_taisyncManager);
 #endif
 #if defined(QGC_GST_MICROHARD_ENABLED)
-    _microhardManager->setToolbox(this);
+    _setToolbox(_microhardManager);
 #endif
 #if defined(QGC_ENABLE_PAIRING)
-    _pairingManager->setToolbox(this);
+    _setToolbox(_pairingManager);
 #endif
+
+    qCDebug(StartupProfilerLog) << "All tools initialized msecs:" << timer.elapsed();
+}
+
+/// The map engine manager is only used by the offline maps settings page
+QGCMapEngineManager* QGCToolbox::mapEngineManager(void)
+{
+    if (!_mapEngineManager) {
+        _mapEngineManager = _createTool<QGCMapEngineManager>();
+        _setToolbox(_mapEngineManager);
+    }
+    return _mapEngineManager;
 }
 
 void QGCToolbox::_scanAndLoadPlugins(QGCApplication* app)
@@ -13,6 +13,10 @@
 
 #include <QObject>
 
+#include "QGCLoggingCategory.h"
+
+Q_DECLARE_LOGGING_CATEGORY(StartupProfilerLog)
+
 class FactSystem;
 class FirmwarePluginManager;
 class AudioOutput;
@@ -25,6 +29,8 @@ class MissionCommandTree;
 class MultiVehicleManager;
 class QGCMapEngineManager;
 class QGCApplication;
+class QGCFrameScheduler;
+class QGCTool;
 class QGCImageProvider;
 class UASMessageHandler;
 class QGCPositionManager;
@@ -45,6 +51,10 @@ class MicrohardManager;
 #endif
 
 /// This is used to manage all of our top level services/tools
+///
+/// QGCMapEngineManager is not needed to bring up the main window, so it is created on first access to its getter. All
+/// other tools are created at startup. Enable StartupProfilerLog to see the time spent constructing and initializing
+/// each tool.
 class QGCToolbox : public QObject {
     Q_OBJECT
 
@@ -58,7 +68,7 @@ public:
     MAVLinkProtocol*            mavlinkProtocol         () { return _mavlinkProtocol; }
     MissionCommandTree*         missionCommandTree      () { return _missionCommandTree; }
     MultiVehicleManager*        multiVehicleManager     () { return _multiVehicleManager; }
-    QGCMapEngineManager*        mapEngineManager        () { return _mapEngineManager; }
+    QGCMapEngineManager*        mapEngineManager        ();
     QGCImageProvider*           imageProvider           () { return _imageProvider; }
     UASMessageHandler*          uasMessageHandler       () { return _uasMessageHandler; }
     FollowMe*                   followMe                () { return _followMe; }
@@ -69,6 +79,7 @@ public:
     SettingsManager*            settingsManager         () { return _settingsManager; }
     AirspaceManager*            airspaceManager         () { return _airspaceManager; }
     ADSBVehicleManager*         adsbVehicleManager      () { return _adsbVehicleManager; }
+    QGCFrameScheduler*          frameScheduler          () { return _frameScheduler; }
 #if defined(QGC_ENABLE_PAIRING)
     PairingManager*             pairingManager          () { return _pairingManager; }
 #endif
@@ -85,7 +96,11 @@ public:
 private:
     void setChildToolboxes(void);
     void _scanAndLoadPlugins(QGCApplication *app);
+    void _setToolbox        (QGCTool* tool);
+
+    template<class T> T* _createTool(void);
 
+    QGCApplication*             _app                    = nullptr;
 
     AudioOutput*                _audioOutput            = nullptr;
     FactSystem*                 _factSystem             = nullptr;
@@ -99,7 +114,7 @@ private:
     MAVLinkProtocol*            _mavlinkProtocol        = nullptr;
     MissionCommandTree*         _missionCommandTree     = nullptr;
     MultiVehicleManager*        _multiVehicleManager    = nullptr;
-    QGCMapEngineManager*        _mapEngineManager       = nullptr;
+    QGCMapEngineManager*        _mapEngineManager       = nullptr;   ///< Created on first access
     UASMessageHandler*          _uasMessageHandler      = nullptr;
     FollowMe*                   _followMe               = nullptr;
     QGCPositionManager*         _qgcPositionManager     = nullptr;
@@ -109,6 +124,7 @@ private:
     SettingsManager*            _settingsManager        = nullptr;
     AirspaceManager*            _airspaceManager        = nullptr;
     ADSBVehicleManager*         _adsbVehicleManager     = nullptr;
+    QGCFrameScheduler*          _frameScheduler         = nullptr;   ///< Created last, destroyed last
 #if defined(QGC_ENABLE_PAIRING)
     PairingManager*             _pairingManager         = nullptr;
 #endif
@@ -67,6 +67,11 @@ Rectangle {
                 ListElement { text: "1x";   value: 1 }
                 ListElement { text: "2x";   value: 2 }
                 ListElement { text: "5x";   value: 5 }
+                ListElement { text: "10x";  value: 10 }
+                ListElement { text: "20x";  value: 20 }
+                ListElement { text: "50x";  value: 50 }
+                ListElement { text: "100x"; value: 100 }
+                ListElement { text: qsTr("Max"); value: 0 }
             }
 
             onActivated: controller.playbackSpeed = model.get(currentIndex).value
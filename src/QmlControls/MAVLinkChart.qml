@@ -26,6 +26,7 @@ ChartView {
     function addDimension(field) {
         if(!chartController) {
             chartController = controller.createChart()
+            chartController.plotWidth = plotArea.width
         }
         var color   = chartView.seriesColors[chartView.count]
         var serie   = createSeries(ChartView.SeriesTypeLine, field.label)
@@ -37,6 +38,12 @@ ChartView {
         chartController.addSeries(field, serie)
     }
 
+    onPlotAreaChanged: {
+        if(chartController) {
+            chartController.plotWidth = plotArea.width
+        }
+    }
+
     function delDimension(field) {
         if(chartController) {
             chartView.removeSeries(field.series)
@@ -115,7 +115,6 @@ bool SHPFileHelper::loadPolygonFromFile(const QString& shpFile, QList<QGeoCoordi
 {
     int         utmZone = 0;
     bool        utmSouthernHemisphere;
-    double      vertexFilterMeters = 5;
     SHPHandle   shpHandle = Q_NULLPTR;
     SHPObject*  shpObject = Q_NULLPTR;
 
@@ -140,13 +139,43 @@ bool SHPFileHelper::loadPolygonFromFile(const QString& shpFile, QList<QGeoCoordi
         goto Error;
     }
 
-    for (int i=0; i<shpObject->nVertices; i++) {
+    vertices = _partCoordinates(shpObject, 0, shpObject->nVertices, utmZone, utmSouthernHemisphere);
+    _filterPolygonVertices(vertices);
+
+Error:
+    if (shpObject) {
+        SHPDestroyObject(shpObject);
+    }
+    if (shpHandle) {
+        SHPClose(shpHandle);
+    }
+    return errorString.isEmpty();
+}
+
+/// @return Coordinates for the vertices [firstVertex, lastVertex) of the shape
+QList<QGeoCoordinate> SHPFileHelper::_partCoordinates(const SHPObject* shpObject, int firstVertex, int lastVertex, int utmZone, bool utmSouthernHemisphere)
+{
+    QList<QGeoCoordinate> coords;
+
+    coords.reserve(lastVertex - firstVertex);
+    for (int i=firstVertex; i<lastVertex; i++) {
         QGeoCoordinate coord;
         if (!utmZone || !convertUTMToGeo(shpObject->padfX[i], shpObject->padfY[i], utmZone, utmSouthernHemisphere, coord)) {
             coord.setLatitude(shpObject->padfY[i]);
             coord.setLongitude(shpObject->padfX[i]);
         }
-        vertices.append(coord);
+        coords.append(coord);
+    }
+
+    return coords;
+}
+
+void SHPFileHelper::_filterPolygonVertices(QList<QGeoCoordinate>& vertices)
+{
+    const double vertexFilterMeters = 5;
+
+    if (vertices.isEmpty()) {
+        return;
     }
 
     // Filter last vertex such that it differs from first
@@ -169,13 +198,168 @@ bool SHPFileHelper::loadPolygonFromFile(const QString& shpFile, QList<QGeoCoordi
             }
         }
     }
+}
+
+QVariantMap SHPFileHelper::_readAttributes(DBFHandle dbfHandle, int record)
+{
+    QVariantMap attributes;
+
+    int cFields = DBFGetFieldCount(dbfHandle);
+    for (int field=0; field<cFields; field++) {
+        char            fieldName[XBASE_FLDNAME_LEN_READ + 1];
+        int             width;
+        int             decimals;
+        DBFFieldType    fieldType = DBFGetFieldInfo(dbfHandle, field, fieldName, &width, &decimals);
+        QString         name = QString::fromUtf8(fieldName);
+
+        if (DBFIsAttributeNULL(dbfHandle, record, field)) {
+            attributes[name] = QVariant();
+            continue;
+        }
+
+        switch (fieldType) {
+        case FTInteger:
+            // Wide integer fields overflow an int, so read them through the string value
+            attributes[name] = QString::fromLatin1(DBFReadStringAttribute(dbfHandle, record, field)).trimmed().toLongLong();
+            break;
+        case FTDouble:
+            attributes[name] = DBFReadDoubleAttribute(dbfHandle, record, field);
+            break;
+        case FTLogical:
+        {
+            const char* value = DBFReadLogicalAttribute(dbfHandle, record, field);
+            attributes[name] = value && (value[0] == 'T' || value[0] == 't' || value[0] == 'Y' || value[0] == 'y');
+            break;
+        }
+        default:
+            attributes[name] = QString::fromUtf8(DBFReadStringAttribute(dbfHandle, record, field)).trimmed();
+            break;
+        }
+    }
+
+    return attributes;
+}
+
+bool SHPFileHelper::loadFeaturesFromFile(const QString& shpFile, ShapeFileHelper::Features_t& features, QString& errorString, const ShapeFileHelper::ProgressFunc_t& progress, const ShapeFileHelper::CancelledFunc_t& cancelled)
+{
+    int                         utmZone = 0;
+    bool                        utmSouthernHemisphere;
+    int                         cEntities;
+    int                         shapeType;
+    int                         skippedCount = 0;
+    ShapeFileHelper::ShapeType  featureType;
+    SHPHandle                   shpHandle = Q_NULLPTR;
+    DBFHandle                   dbfHandle = Q_NULLPTR;
+
+    errorString.clear();
+    features.clear();
+
+    shpHandle = SHPFileHelper::_loadShape(shpFile, &utmZone, &utmSouthernHemisphere, errorString);
+    if (!errorString.isEmpty()) {
+        goto Error;
+    }
+
+    SHPGetInfo(shpHandle, &cEntities, &shapeType, Q_NULLPTR /* padfMinBound */, Q_NULLPTR /* padfMaxBound */);
+    switch (shapeType) {
+    case SHPT_POLYGON:
+    case SHPT_POLYGONZ:
+    case SHPT_POLYGONM:
+        featureType = ShapeFileHelper::Polygon;
+        break;
+    case SHPT_ARC:
+    case SHPT_ARCZ:
+    case SHPT_ARCM:
+        featureType = ShapeFileHelper::Polyline;
+        break;
+    default:
+        errorString = QString(_errorPrefix).arg(tr("No supported types found."));
+        goto Error;
+    }
+
+    // Attributes are optional, the shapes still load without a .dbf file
+    dbfHandle = DBFOpen(shpFile.toUtf8(), "rb");
+    if (dbfHandle && DBFGetRecordCount(dbfHandle) != cEntities) {
+        qWarning() << "SHPFileHelper::loadFeaturesFromFile dbf record count does not match shape count, attributes ignored" << DBFGetRecordCount(dbfHandle) << cEntities;
+        DBFClose(dbfHandle);
+        dbfHandle = Q_NULLPTR;
+    }
+
+    for (int entity=0; entity<cEntities; entity++) {
+        if (cancelled && cancelled()) {
+            errorString = QString(_errorPrefix).arg(tr("Load cancelled."));
+            goto Error;
+        }
+        if (progress) {
+            progress(static_cast<double>(entity) / cEntities);
+        }
+
+        SHPObject* shpObject = SHPReadObject(shpHandle, entity);
+        if (!shpObject) {
+            skippedCount++;
+            continue;
+        }
+
+        QVariantMap attributes;
+        if (dbfHandle) {
+            attributes = _readAttributes(dbfHandle, entity);
+        }
+
+        int cParts = qMax(shpObject->nParts, 1);
+        for (int part=0; part<cParts; part++) {
+            int firstVertex = shpObject->nParts ? shpObject->panPartStart[part] : 0;
+            int lastVertex  = part < shpObject->nParts - 1 ? shpObject->panPartStart[part + 1] : shpObject->nVertices;
+
+            if (featureType == ShapeFileHelper::Polygon) {
+                // Outer rings are clockwise, counter-clockwise rings are holes
+                double area = 0;
+                for (int i=firstVertex; i<lastVertex; i++) {
+                    int next = i == lastVertex - 1 ? firstVertex : i + 1;
+                    area += shpObject->padfX[i] * shpObject->padfY[next] - shpObject->padfX[next] * shpObject->padfY[i];
+                }
+                if (area > 0) {
+                    continue;
+                }
+            }
+
+            ShapeFileHelper::Feature feature;
+            feature.type        = featureType;
+            feature.coordinates = _partCoordinates(shpObject, firstVertex, lastVertex, utmZone, utmSouthernHemisphere);
+            feature.attributes  = attributes;
+            if (featureType == ShapeFileHelper::Polygon) {
+                _filterPolygonVertices(feature.coordinates);
+            }
+
+            if (feature.coordinates.count() >= (featureType == ShapeFileHelper::Polygon ? 3 : 2)) {
+                features.append(feature);
+            } else {
+                skippedCount++;
+            }
+        }
 
-Error:
-    if (shpObject) {
         SHPDestroyObject(shpObject);
     }
+
+    if (skippedCount) {
+        qWarning() << "SHPFileHelper::loadFeaturesFromFile skipped invalid shapes" << skippedCount;
+    }
+    if (features.isEmpty()) {
+        errorString = QString(_errorPrefix).arg(tr("No supported types found."));
+        goto Error;
+    }
+
+    if (progress) {
+        progress(1.0);
+    }
+
+Error:
+    if (dbfHandle) {
+        DBFClose(dbfHandle);
+    }
     if (shpHandle) {
         SHPClose(shpHandle);
     }
+    if (!errorString.isEmpty()) {
+        features.clear();
+    }
     return errorString.isEmpty();
 }
@@ -28,9 +28,16 @@ public:
     static ShapeFileHelper::ShapeType determineShapeType(const QString& shpFile, QString& errorString);
     static bool loadPolygonFromFile(const QString& shpFile, QList<QGeoCoordinate>& vertices, QString& errorString);
 
+    /// Iterates all records of a polygon or arc shape file. Each part of a record is returned as a separate feature, holes
+    /// in polygons are skipped. Values from the matching .dbf file, if there is one, are returned as the feature attributes.
+    static bool loadFeaturesFromFile(const QString& shpFile, ShapeFileHelper::Features_t& features, QString& errorString, const ShapeFileHelper::ProgressFunc_t& progress, const ShapeFileHelper::CancelledFunc_t& cancelled);
+
 private:
-    static bool         _validateSHPFiles(const QString& shpFile, int* utmZone, bool* utmSouthernHemisphere, QString& errorString);
-    static SHPHandle    _loadShape(const QString& shpFile, int* utmZone, bool* utmSouthernHemisphere, QString& errorString);
+    static bool                     _validateSHPFiles       (const QString& shpFile, int* utmZone, bool* utmSouthernHemisphere, QString& errorString);
+    static SHPHandle                _loadShape              (const QString& shpFile, int* utmZone, bool* utmSouthernHemisphere, QString& errorString);
+    static QList<QGeoCoordinate>    _partCoordinates        (const SHPObject* shpObject, int firstVertex, int lastVertex, int utmZone, bool utmSouthernHemisphere);
+    static void                     _filterPolygonVertices  (QList<QGeoCoordinate>& vertices);
+    static QVariantMap              _readAttributes         (DBFHandle dbfHandle, int record);
 
     static const char* _errorPrefix;
 };
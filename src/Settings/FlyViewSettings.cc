@@ -25,3 +25,5 @@ DECLARE_SETTINGSFACT(FlyViewSettings, showAdditionalIndicatorsCompass)
 DECLARE_SETTINGSFACT(FlyViewSettings, lockNoseUpCompass)
 DECLARE_SETTINGSFACT(FlyViewSettings, maxGoToLocationDistance)
 DECLARE_SETTINGSFACT(FlyViewSettings, keepMapCenteredOnVehicle)
+DECLARE_SETTINGSFACT(FlyViewSettings, trajectoryMemoryLimit)
+DECLARE_SETTINGSFACT(FlyViewSettings, geoFenceLookahead)
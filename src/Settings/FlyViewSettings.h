@@ -27,4 +27,6 @@ public:
     DEFINE_SETTINGFACT(lockNoseUpCompass)
     DEFINE_SETTINGFACT(maxGoToLocationDistance)
     DEFINE_SETTINGFACT(keepMapCenteredOnVehicle)
+    DEFINE_SETTINGFACT(trajectoryMemoryLimit)
+    DEFINE_SETTINGFACT(geoFenceLookahead)
 };
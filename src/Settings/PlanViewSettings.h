@@ -23,4 +23,5 @@ public:
     DEFINE_SETTINGFACT(displayPresetsTabFirst)
     DEFINE_SETTINGFACT(aboveTerrainWarning)
     DEFINE_SETTINGFACT(showMissionItemStatus)
+    DEFINE_SETTINGFACT(importSimplifyTolerance)
 };
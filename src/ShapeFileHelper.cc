@@ -97,6 +97,23 @@ bool ShapeFileHelper::loadPolylineFromFile(const QString& file, QList<QGeoCoordi
     return errorString.isEmpty();
 }
 
+bool ShapeFileHelper::loadFeaturesFromFile(const QString& file, Features_t& features, QString& errorString, const ProgressFunc_t& progress, const CancelledFunc_t& cancelled)
+{
+    errorString.clear();
+    features.clear();
+
+    bool fileIsKML = _fileIsKML(file, errorString);
+    if (errorString.isEmpty()) {
+        if (fileIsKML) {
+            KMLFileHelper::loadFeaturesFromFile(file, features, errorString, progress, cancelled);
+        } else {
+            SHPFileHelper::loadFeaturesFromFile(file, features, errorString, progress, cancelled);
+        }
+    }
+
+    return errorString.isEmpty();
+}
+
 QStringList ShapeFileHelper::fileDialogKMLFilters(void) const
 {
     return QStringList(tr("KML Files (*.%1)").arg(AppSettings::kmlFileExtension));
@@ -14,6 +14,8 @@
 #include <QGeoCoordinate>
 #include <QVariant>
 
+#include <functional>
+
 /// Routines for loading polygons or polylines from KML or SHP files.
 class ShapeFileHelper : public QObject
 {
@@ -27,6 +29,16 @@ public:
     };
     Q_ENUM(ShapeType)
 
+    /// Polygon or polyline read from a file along with the attributes of the KML placemark or SHP record it belongs to
+    struct Feature {
+        ShapeType               type;
+        QList<QGeoCoordinate>   coordinates;
+        QVariantMap             attributes;
+    };
+    typedef QList<Feature>                  Features_t;
+    typedef std::function<void(double)>     ProgressFunc_t;     ///< Called with the fraction of the file which has been read
+    typedef std::function<bool(void)>       CancelledFunc_t;
+
     Q_PROPERTY(QStringList fileDialogKMLFilters         READ fileDialogKMLFilters       CONSTANT) ///< File filter list for load/save KML file dialogs
     Q_PROPERTY(QStringList fileDialogKMLOrSHPFilters    READ fileDialogKMLOrSHPFilters  CONSTANT) ///< File filter list for load/save shape file dialogs
 
@@ -41,6 +53,13 @@ public:
     static bool loadPolygonFromFile(const QString& file, QList<QGeoCoordinate>& vertices, QString& errorString);
     static bool loadPolylineFromFile(const QString& file, QList<QGeoCoordinate>& coords, QString& errorString);
 
+    /// Reads all polygons and polylines from the file. The file is streamed so this can be used on large files, but it may
+    /// still take a while. It is safe to call from a worker thread.
+    ///     @param progress Optional progress callback
+    ///     @param cancelled Optional callback which stops the load once it returns true
+    /// @return false: load failed or was cancelled, errorString set
+    static bool loadFeaturesFromFile(const QString& file, Features_t& features, QString& errorString, const ProgressFunc_t& progress = ProgressFunc_t(), const CancelledFunc_t& cancelled = CancelledFunc_t());
+
 private:
     static bool _fileIsKML(const QString& file, QString& errorString);
 
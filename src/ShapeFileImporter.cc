@@ -0,0 +1,145 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ShapeFileImporter.h"
+
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+QGC_LOGGING_CATEGORY(ShapeFileImporterLog, "ShapeFileImporterLog")
+
+ShapeFileImporter::ShapeFileImporter(QObject* parent)
+    : QObject       (parent)
+    , _running      (false)
+    , _progress     (0)
+    , _generation   (new QAtomicInteger<quint32>(0))
+{
+    _progressTimer.setInterval(_progressIntervalMSecs);
+    connect(&_progressTimer, &QTimer::timeout, this, &ShapeFileImporter::_updateProgress);
+}
+
+ShapeFileImporter::~ShapeFileImporter()
+{
+    // Stops a running worker at its next cancellation check
+    cancel();
+}
+
+void ShapeFileImporter::start(const QString& file)
+{
+    // Bumping the generation makes any import which is still running stale
+    quint32                                 generation      = static_cast<quint32>(++(*_generation));
+    QSharedPointer<QAtomicInteger<quint32>> latest          = _generation;
+    QSharedPointer<QAtomicInteger<int>>     workerProgress  (new QAtomicInteger<int>(0));
+
+    ShapeFileHelper::CancelledFunc_t    cancelled   = [latest, generation]() { return latest->loadAcquire() != generation; };
+    ShapeFileHelper::ProgressFunc_t     progress    = [workerProgress](double fraction) { workerProgress->storeRelease(static_cast<int>(fraction * _progressScale)); };
+
+    _workerProgress = workerProgress;
+    _features.clear();
+    emit featuresChanged();
+    _setErrorString(QString());
+    _setProgress(0);
+    _setRunning(true);
+    _progressTimer.start();
+
+    // The watcher is a child of the importer so results are never delivered to an importer which has been deleted
+    QFutureWatcher<ImportResult>* watcher = new QFutureWatcher<ImportResult>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, generation]() {
+        watcher->deleteLater();
+        if (generation != _generation->loadAcquire()) {
+            qCDebug(ShapeFileImporterLog) << "Dropping stale import generation:latest" << generation << _generation->loadAcquire();
+            return;
+        }
+
+        ImportResult result = watcher->result();
+
+        _progressTimer.stop();
+        _features = result.features;
+        emit featuresChanged();
+        _setErrorString(result.errorString);
+        _setProgress(1);
+        _setRunning(false);
+        emit finished(result.success);
+    });
+    watcher->setFuture(QtConcurrent::run([file, progress, cancelled]() {
+        ImportResult    result;
+        QElapsedTimer   timer;
+
+        timer.start();
+        result.success = ShapeFileHelper::loadFeaturesFromFile(file, result.features, result.errorString, progress, cancelled);
+        qCDebug(ShapeFileImporterLog) << "Import complete file:features:msecs" << file << result.features.count() << timer.elapsed();
+
+        return result;
+    }));
+}
+
+void ShapeFileImporter::cancel(void)
+{
+    if (_running) {
+        _generation->fetchAndAddOrdered(1);
+        _progressTimer.stop();
+        _setRunning(false);
+    }
+}
+
+QVariantMap ShapeFileImporter::attributes(int index) const
+{
+    if (index < 0 || index >= _features.count()) {
+        return QVariantMap();
+    }
+    return _features[index].attributes;
+}
+
+int ShapeFileImporter::polygonCount(void) const
+{
+    int count = 0;
+    for (const ShapeFileHelper::Feature& feature: _features) {
+        if (feature.type == ShapeFileHelper::Polygon) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int ShapeFileImporter::polylineCount(void) const
+{
+    return _features.count() - polygonCount();
+}
+
+void ShapeFileImporter::_updateProgress(void)
+{
+    if (_workerProgress) {
+        _setProgress(static_cast<double>(_workerProgress->loadAcquire()) / _progressScale);
+    }
+}
+
+void ShapeFileImporter::_setRunning(bool running)
+{
+    if (running != _running) {
+        _running = running;
+        emit runningChanged(_running);
+    }
+}
+
+void ShapeFileImporter::_setProgress(double progress)
+{
+    if (!qFuzzyCompare(progress, _progress)) {
+        _progress = progress;
+        emit progressChanged(_progress);
+    }
+}
+
+void ShapeFileImporter::_setErrorString(const QString& errorString)
+{
+    if (errorString != _errorString) {
+        _errorString = errorString;
+        emit errorStringChanged(_errorString);
+    }
+}
@@ -0,0 +1,89 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QObject>
+#include <QAtomicInteger>
+#include <QSharedPointer>
+#include <QTimer>
+
+#include "ShapeFileHelper.h"
+#include "QGCLoggingCategory.h"
+
+Q_DECLARE_LOGGING_CATEGORY(ShapeFileImporterLog)
+
+/// Loads all polygons and polylines from a KML or SHP file on a worker thread.
+///
+/// Large files with thousands of features take a while to read, so the import runs off the GUI thread and reports
+/// progress while it runs. Once finished is signalled features() holds the result, which can then be used to create
+/// many mission or fence items in a single batch.
+class ShapeFileImporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    ShapeFileImporter(QObject* parent = nullptr);
+    ~ShapeFileImporter();
+
+    Q_PROPERTY(bool     running         READ running        NOTIFY runningChanged)
+    Q_PROPERTY(double   progress        READ progress       NOTIFY progressChanged)     ///< 0 to 1
+    Q_PROPERTY(int      polygonCount    READ polygonCount   NOTIFY featuresChanged)
+    Q_PROPERTY(int      polylineCount   READ polylineCount  NOTIFY featuresChanged)
+    Q_PROPERTY(QString  errorString     READ errorString    NOTIFY errorStringChanged)
+
+    /// Starts importing the specified file. An import which is still running is cancelled.
+    Q_INVOKABLE void start(const QString& file);
+
+    /// Cancels a running import. finished is not signalled for a cancelled import.
+    Q_INVOKABLE void cancel(void);
+
+    /// @return Attributes of the specified feature
+    Q_INVOKABLE QVariantMap attributes(int index) const;
+
+    bool        running         (void) const { return _running; }
+    double      progress        (void) const { return _progress; }
+    int         polygonCount    (void) const;
+    int         polylineCount   (void) const;
+    QString     errorString     (void) const { return _errorString; }
+
+    const ShapeFileHelper::Features_t& features(void) const { return _features; }
+
+signals:
+    void runningChanged     (bool running);
+    void progressChanged    (double progress);
+    void featuresChanged    (void);
+    void errorStringChanged (QString errorString);
+    void finished           (bool success);
+
+private slots:
+    void _updateProgress(void);
+
+private:
+    struct ImportResult {
+        bool                        success;
+        QString                     errorString;
+        ShapeFileHelper::Features_t features;
+    };
+
+    void _setRunning    (bool running);
+    void _setProgress   (double progress);
+    void _setErrorString(const QString& errorString);
+
+    bool                                    _running;
+    double                                  _progress;
+    QString                                 _errorString;
+    ShapeFileHelper::Features_t             _features;
+    QSharedPointer<QAtomicInteger<quint32>> _generation;            ///< Bumped to cancel the running import
+    QSharedPointer<QAtomicInteger<int>>     _workerProgress;        ///< Progress of the running import in parts per _progressScale
+    QTimer                                  _progressTimer;
+
+    static const int _progressScale =           1000;
+    static const int _progressIntervalMSecs =   100;
+};
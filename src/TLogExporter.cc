@@ -0,0 +1,564 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TLogExporter.h"
+#include "TLogIndex.h"
+#include "CmdLineOptParser.h"
+#include "QGC.h"
+
+#include <QAtomicInt>
+#include <QDataStream>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QtConcurrent>
+#include <QtEndian>
+
+#include <cstring>
+
+QGC_LOGGING_CATEGORY(TLogExporterLog, "TLogExporterLog")
+
+const char* TLogExporter::columnarFileExtension =   "qcol";
+const char* TLogExporter::csvFileExtension =        "csv.gz";
+
+/// Output files for a single mavlink message type. Rows are appended on the parsing thread. Chunks are encoded and written
+/// on the exporter thread pool.
+class TLogExporter::MessageWriter
+{
+public:
+    struct Chunk {
+        int                 rowCount;
+        QList<QByteArray>   columns;
+    };
+
+    MessageWriter(const mavlink_message_info_t* messageInfo, quint32 msgId);
+
+    bool open   (const QString& outputDir, int formats, QStringList& outputFiles, QString& errorMessage);
+    void append (quint64 timestamp, const mavlink_message_t& message);
+    void encode (const Chunk& chunk, QByteArray& columnar, QByteArray& csv) const;
+    void write  (const QByteArray& columnar, const QByteArray& csv);
+
+    int     rowCount    (void) const { return _chunk.rowCount; }
+    bool    failed      (void) const { return _failed.load() != 0; }
+    QString name        (void) const { return _name; }
+    Chunk   takeChunk   (void);
+
+    QFuture<void> lastWrite;    ///< Completion of the most recently queued chunk, chunks must be written in order
+
+private:
+    QByteArray _encodeColumnar  (const Chunk& chunk) const;
+    QByteArray _encodeCsv       (const Chunk& chunk) const;
+    void       _appendCsvValue  (QByteArray& csv, const Column& column, const char* value) const;
+
+    static QByteArray _gzipMember(const QByteArray& data);
+
+    QString                         _name;
+    quint32                         _msgId;
+    QList<Column>                   _columns;       ///< Column descriptions, data is not used
+    QList<int>                      _wireOffsets;   ///< Payload offset for each field column
+    QFile                           _columnarFile;
+    QFile                           _csvFile;
+    Chunk                           _chunk;
+    QAtomicInt                      _failed;
+};
+
+TLogExporter::MessageWriter::MessageWriter(const mavlink_message_info_t* messageInfo, quint32 msgId)
+    : _name     (messageInfo->name)
+    , _msgId    (msgId)
+    , _failed   (0)
+{
+    _columns.append({ QStringLiteral("timestamp_us"),   MAVLINK_TYPE_UINT64_T,  1, QByteArray() });
+    _columns.append({ QStringLiteral("sysid"),          MAVLINK_TYPE_UINT8_T,   1, QByteArray() });
+    _columns.append({ QStringLiteral("compid"),         MAVLINK_TYPE_UINT8_T,   1, QByteArray() });
+
+    for (unsigned int i=0; i<messageInfo->num_fields; i++) {
+        const mavlink_field_info_t& field = messageInfo->fields[i];
+        _columns.append({ field.name, static_cast<quint8>(field.type), qMax(static_cast<int>(field.array_length), 1), QByteArray() });
+        _wireOffsets.append(static_cast<int>(field.wire_offset));
+    }
+
+    _chunk.rowCount = 0;
+    for (int i=0; i<_columns.count(); i++) {
+        _chunk.columns.append(QByteArray());
+    }
+}
+
+bool TLogExporter::MessageWriter::open(const QString& outputDir, int formats, QStringList& outputFiles, QString& errorMessage)
+{
+    QDir dir(outputDir);
+
+    if (formats & FormatColumnar) {
+        _columnarFile.setFileName(dir.filePath(QStringLiteral("%1.%2").arg(_name).arg(columnarFileExtension)));
+        if (!_columnarFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            errorMessage = tr("Unable to create %1: %2").arg(_columnarFile.fileName()).arg(_columnarFile.errorString());
+            return false;
+        }
+        outputFiles.append(_columnarFile.fileName());
+
+        QDataStream ds(&_columnarFile);
+        ds.setVersion(QDataStream::Qt_5_9);
+        ds << _columnarFileMagic << _columnarFileVersion << _name << _msgId << static_cast<quint32>(_columns.count());
+        for (const Column& column: _columns) {
+            ds << column.name << column.type << static_cast<quint32>(column.elementCount);
+        }
+    }
+
+    if (formats & FormatCsv) {
+        _csvFile.setFileName(dir.filePath(QStringLiteral("%1.%2").arg(_name).arg(csvFileExtension)));
+        if (!_csvFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            errorMessage = tr("Unable to create %1: %2").arg(_csvFile.fileName()).arg(_csvFile.errorString());
+            return false;
+        }
+        outputFiles.append(_csvFile.fileName());
+
+        QStringList header;
+        for (const Column& column: _columns) {
+            if (column.elementCount == 1 || column.type == MAVLINK_TYPE_CHAR) {
+                header.append(column.name);
+            } else {
+                for (int i=0; i<column.elementCount; i++) {
+                    header.append(QStringLiteral("%1[%2]").arg(column.name).arg(i));
+                }
+            }
+        }
+        _csvFile.write(_gzipMember(header.join(',').toUtf8() + '\n'));
+    }
+
+    return true;
+}
+
+void TLogExporter::MessageWriter::append(quint64 timestamp, const mavlink_message_t& message)
+{
+    // Mavlink 2 truncates trailing zeros from the payload, they must be restored before the fields can be sliced out
+    char payload[MAVLINK_MAX_PAYLOAD_LEN];
+    memset(payload, 0, sizeof(payload));
+    memcpy(payload, reinterpret_cast<const char*>(&message.payload64[0]), qMin(static_cast<size_t>(message.len), sizeof(payload)));
+
+    _chunk.columns[0].append(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+    _chunk.columns[1].append(static_cast<char>(message.sysid));
+    _chunk.columns[2].append(static_cast<char>(message.compid));
+    for (int i=0; i<_wireOffsets.count(); i++) {
+        const Column& column = _columns[i + 3];
+        _chunk.columns[i + 3].append(payload + _wireOffsets[i], sizeOfType(column.type) * column.elementCount);
+    }
+    _chunk.rowCount++;
+}
+
+TLogExporter::MessageWriter::Chunk TLogExporter::MessageWriter::takeChunk(void)
+{
+    Chunk chunk = _chunk;
+
+    // The next chunk will be the same size, so start out with that capacity
+    _chunk.rowCount = 0;
+    for (int i=0; i<_chunk.columns.count(); i++) {
+        _chunk.columns[i] = QByteArray();
+        _chunk.columns[i].reserve(chunk.columns[i].size());
+    }
+
+    return chunk;
+}
+
+/// Called from the thread pool, any number of chunks may be encoded at the same time
+void TLogExporter::MessageWriter::encode(const Chunk& chunk, QByteArray& columnar, QByteArray& csv) const
+{
+    if (_columnarFile.isOpen()) {
+        columnar = _encodeColumnar(chunk);
+    }
+    if (_csvFile.isOpen()) {
+        csv = _gzipMember(_encodeCsv(chunk));
+    }
+}
+
+/// Called from the thread pool, once the previous chunk has been written
+void TLogExporter::MessageWriter::write(const QByteArray& columnar, const QByteArray& csv)
+{
+    if ((!columnar.isEmpty() && _columnarFile.write(columnar) != columnar.size()) || (!csv.isEmpty() && _csvFile.write(csv) != csv.size())) {
+        qCWarning(TLogExporterLog) << "Write failed" << _name;
+        _failed.store(1);
+    }
+}
+
+QByteArray TLogExporter::MessageWriter::_encodeColumnar(const Chunk& chunk) const
+{
+    QByteArray  bytes;
+    QDataStream ds(&bytes, QIODevice::WriteOnly);
+    ds.setVersion(QDataStream::Qt_5_9);
+
+    ds << static_cast<quint32>(chunk.rowCount);
+    for (const QByteArray& column: chunk.columns) {
+        ds << qCompress(column, _compressionLevel);
+    }
+
+    return bytes;
+}
+
+QByteArray TLogExporter::MessageWriter::_encodeCsv(const Chunk& chunk) const
+{
+    QByteArray csv;
+    csv.reserve(chunk.rowCount * _columns.count() * 12);
+
+    for (int row=0; row<chunk.rowCount; row++) {
+        for (int col=0; col<_columns.count(); col++) {
+            const Column&   column      = _columns[col];
+            int             elementSize = sizeOfType(column.type);
+            const char*     value       = chunk.columns[col].constData() + (row * elementSize * column.elementCount);
+
+            if (col != 0) {
+                csv.append(',');
+            }
+
+            if (column.type == MAVLINK_TYPE_CHAR && column.elementCount > 1) {
+                // Strings are quoted, with embedded quotes doubled
+                csv.append('"');
+                csv.append(QByteArray(value, static_cast<int>(strnlen(value, static_cast<size_t>(column.elementCount)))).replace('"', "\"\""));
+                csv.append('"');
+            } else {
+                for (int i=0; i<column.elementCount; i++) {
+                    if (i != 0) {
+                        csv.append(',');
+                    }
+                    _appendCsvValue(csv, column, value + (i * elementSize));
+                }
+            }
+        }
+        csv.append('\n');
+    }
+
+    return csv;
+}
+
+void TLogExporter::MessageWriter::_appendCsvValue(QByteArray& csv, const Column& column, const char* value) const
+{
+    switch (column.type) {
+    case MAVLINK_TYPE_CHAR:
+    case MAVLINK_TYPE_UINT8_T:
+        csv.append(QByteArray::number(static_cast<quint8>(*value)));
+        break;
+    case MAVLINK_TYPE_INT8_T:
+        csv.append(QByteArray::number(static_cast<qint8>(*value)));
+        break;
+    case MAVLINK_TYPE_UINT16_T:
+        csv.append(QByteArray::number(qFromLittleEndian<quint16>(value)));
+        break;
+    case MAVLINK_TYPE_INT16_T:
+        csv.append(QByteArray::number(qFromLittleEndian<qint16>(value)));
+        break;
+    case MAVLINK_TYPE_UINT32_T:
+        csv.append(QByteArray::number(qFromLittleEndian<quint32>(value)));
+        break;
+    case MAVLINK_TYPE_INT32_T:
+        csv.append(QByteArray::number(qFromLittleEndian<qint32>(value)));
+        break;
+    case MAVLINK_TYPE_UINT64_T:
+        csv.append(QByteArray::number(qFromLittleEndian<quint64>(value)));
+        break;
+    case MAVLINK_TYPE_INT64_T:
+        csv.append(QByteArray::number(qFromLittleEndian<qint64>(value)));
+        break;
+    case MAVLINK_TYPE_FLOAT:
+    {
+        float f;
+        memcpy(&f, value, sizeof(f));
+        csv.append(QByteArray::number(static_cast<double>(f), 'g', 9));
+        break;
+    }
+    case MAVLINK_TYPE_DOUBLE:
+    {
+        double d;
+        memcpy(&d, value, sizeof(d));
+        csv.append(QByteArray::number(d, 'g', 17));
+        break;
+    }
+    }
+}
+
+/// Wraps data in a complete gzip member. Concatenated members form a valid gzip file.
+QByteArray TLogExporter::MessageWriter::_gzipMember(const QByteArray& data)
+{
+    // qCompress output is a 4 byte size, 2 byte zlib header, raw deflate stream and 4 byte adler32. gzip uses the raw deflate
+    // stream with its own header and a crc32/size trailer.
+    static const char   gzipHeader[10] = { '\x1f', '\x8b', '\x08', 0, 0, 0, 0, 0, 0, '\xff' };
+    QByteArray          zlib = qCompress(data, _compressionLevel);
+    QByteArray          member(gzipHeader, sizeof(gzipHeader));
+    char                trailer[8];
+
+    member.append(zlib.constData() + 6, zlib.size() - 10);
+    qToLittleEndian<quint32>(~QGC::crc32(reinterpret_cast<const quint8*>(data.constData()), static_cast<unsigned>(data.size()), 0xffffffff), trailer);
+    qToLittleEndian<quint32>(static_cast<quint32>(data.size()), trailer + 4);
+    member.append(trailer, sizeof(trailer));
+
+    return member;
+}
+
+TLogExporter::TLogExporter(const QString& logFilename, const QString& outputDir)
+    : _logFilename  (logFilename)
+    , _outputDir    (outputDir)
+    , _formats      (FormatAll)
+    , _rowsPerChunk (_defaultRowsPerChunk)
+    , _messageCount (0)
+{
+
+}
+
+TLogExporter::~TLogExporter()
+{
+    _clearWriters();
+}
+
+void TLogExporter::_clearWriters(void)
+{
+    _waitForPending(0);
+    qDeleteAll(_writers);
+    _writers.clear();
+}
+
+int TLogExporter::sizeOfType(quint8 mavlinkType)
+{
+    switch (mavlinkType) {
+    case MAVLINK_TYPE_CHAR:
+    case MAVLINK_TYPE_UINT8_T:
+    case MAVLINK_TYPE_INT8_T:
+        return 1;
+    case MAVLINK_TYPE_UINT16_T:
+    case MAVLINK_TYPE_INT16_T:
+        return 2;
+    case MAVLINK_TYPE_UINT32_T:
+    case MAVLINK_TYPE_INT32_T:
+    case MAVLINK_TYPE_FLOAT:
+        return 4;
+    case MAVLINK_TYPE_UINT64_T:
+    case MAVLINK_TYPE_INT64_T:
+    case MAVLINK_TYPE_DOUBLE:
+        return 8;
+    }
+    return 0;
+}
+
+bool TLogExporter::exportLog(uint8_t mavlinkChannel, QString& errorMessage)
+{
+    errorMessage.clear();
+    _clearWriters();
+    _outputFiles.clear();
+    _messageCount = 0;
+
+    QFile log(_logFilename);
+    if (!log.open(QIODevice::ReadOnly)) {
+        errorMessage = tr("Unable to open log file %1: %2").arg(_logFilename).arg(log.errorString());
+        return false;
+    }
+    if (!QDir().mkpath(_outputDir)) {
+        errorMessage = tr("Unable to create output directory %1").arg(_outputDir);
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    _messageCount = TLogIndex::scanLog(log, mavlinkChannel, [this, &errorMessage](quint64 timestamp, qint64 /* recordOffset */, const mavlink_message_t& message) {
+        if (!errorMessage.isEmpty()) {
+            return;
+        }
+        MessageWriter* writer = _writerForMessage(message, errorMessage);
+        if (writer) {
+            writer->append(timestamp, message);
+            if (writer->rowCount() >= _rowsPerChunk) {
+                _flushWriter(writer);
+            }
+        }
+    });
+
+    for (MessageWriter* writer: _writers) {
+        if (writer && writer->rowCount() > 0) {
+            _flushWriter(writer);
+        }
+    }
+    _waitForPending(0);
+
+    for (MessageWriter* writer: _writers) {
+        if (writer && writer->failed() && errorMessage.isEmpty()) {
+            errorMessage = tr("Unable to write output for %1").arg(writer->name());
+        }
+    }
+    _clearWriters();
+
+    qCDebug(TLogExporterLog) << "Exported messages:types:msecs" << _messageCount << _outputFiles.count() << timer.elapsed();
+
+    return errorMessage.isEmpty();
+}
+
+/// @return Writer for the message type, nullptr if the message is unknown or the writer could not be created (errorMessage set)
+TLogExporter::MessageWriter* TLogExporter::_writerForMessage(const mavlink_message_t& message, QString& errorMessage)
+{
+    auto it = _writers.constFind(message.msgid);
+    if (it != _writers.constEnd()) {
+        return it.value();
+    }
+
+    const mavlink_message_info_t* messageInfo = mavlink_get_message_info(&message);
+    if (!messageInfo) {
+        // Messages from dialects we don't know are skipped
+        _writers[message.msgid] = nullptr;
+        return nullptr;
+    }
+
+    MessageWriter* writer = new MessageWriter(messageInfo, message.msgid);
+    if (!writer->open(_outputDir, _formats, _outputFiles, errorMessage)) {
+        delete writer;
+        return nullptr;
+    }
+    _writers[message.msgid] = writer;
+
+    return writer;
+}
+
+void TLogExporter::_flushWriter(MessageWriter* writer)
+{
+    MessageWriter::Chunk    chunk       = writer->takeChunk();
+    QFuture<void>           previous    = writer->lastWrite;
+
+    // The thread pool runs tasks in the order they are queued, so the previous chunk for this type has always been started
+    // by the time this one waits for it.
+    writer->lastWrite = QtConcurrent::run(&_threadPool, [writer, chunk, previous]() mutable {
+        QByteArray columnar;
+        QByteArray csv;
+        writer->encode(chunk, columnar, csv);
+        previous.waitForFinished();
+        writer->write(columnar, csv);
+    });
+    _pendingWrites.append(writer->lastWrite);
+
+    // Bound memory use by limiting the number of chunks in flight
+    _waitForPending(_threadPool.maxThreadCount() * 4);
+}
+
+void TLogExporter::_waitForPending(int maxPending)
+{
+    while (_pendingWrites.count() > maxPending) {
+        _pendingWrites.takeFirst().waitForFinished();
+    }
+}
+
+bool TLogExporter::readColumnarFile(const QString& filename, QString& messageName, QList<Column>& columns, QString& errorMessage)
+{
+    columns.clear();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMessage = tr("Unable to open %1: %2").arg(filename).arg(file.errorString());
+        return false;
+    }
+
+    QDataStream ds(&file);
+    ds.setVersion(QDataStream::Qt_5_9);
+
+    quint32 magic, version, msgId, columnCount;
+    ds >> magic >> version >> messageName >> msgId >> columnCount;
+    if (ds.status() != QDataStream::Ok || magic != _columnarFileMagic || version != _columnarFileVersion) {
+        errorMessage = tr("%1 is not a columnar export file").arg(filename);
+        return false;
+    }
+
+    for (quint32 i=0; i<columnCount; i++) {
+        Column  column;
+        quint32 elementCount;
+        ds >> column.name >> column.type >> elementCount;
+        column.elementCount = static_cast<int>(elementCount);
+        columns.append(column);
+    }
+
+    while (!ds.atEnd()) {
+        quint32 rowCount;
+        ds >> rowCount;
+        for (Column& column: columns) {
+            QByteArray compressed;
+            ds >> compressed;
+            QByteArray data = qUncompress(compressed);
+            if (data.size() != static_cast<int>(rowCount) * sizeOfType(column.type) * column.elementCount) {
+                errorMessage = tr("%1 is corrupt").arg(filename);
+                return false;
+            }
+            column.data.append(data);
+        }
+        if (ds.status() != QDataStream::Ok) {
+            errorMessage = tr("%1 is truncated").arg(filename);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TLogExporter::isCommandLineExport(int argc, char* argv[])
+{
+    for (int i=1; i<argc; i++) {
+        if (QString(argv[i]).startsWith(QStringLiteral("--export-tlog:"), Qt::CaseInsensitive)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int TLogExporter::runCommandLineExport(int& argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream      out(stdout);
+
+    bool    logFound, dirFound, formatFound, threadsFound;
+    QString logFilename, outputDir, format, threads;
+
+    CmdLineOpt_t rgCmdLineOptions[] = {
+        { "--export-tlog",      &logFound,      &logFilename },
+        { "--export-dir",       &dirFound,      &outputDir },
+        { "--export-format",    &formatFound,   &format },
+        { "--export-threads",   &threadsFound,  &threads },
+    };
+    ParseCmdLineOptions(argc, argv, rgCmdLineOptions, sizeof(rgCmdLineOptions)/sizeof(rgCmdLineOptions[0]), false);
+
+    if (!dirFound || outputDir.isEmpty()) {
+        QFileInfo logInfo(logFilename);
+        outputDir = logInfo.absoluteDir().filePath(logInfo.completeBaseName() + QStringLiteral("_export"));
+    }
+
+    TLogExporter exporter(logFilename, outputDir);
+
+    if (formatFound) {
+        if (format.compare(QStringLiteral("columnar"), Qt::CaseInsensitive) == 0) {
+            exporter.setFormats(FormatColumnar);
+        } else if (format.compare(QStringLiteral("csv"), Qt::CaseInsensitive) == 0) {
+            exporter.setFormats(FormatCsv);
+        } else {
+            out << tr("Unknown export format: %1").arg(format) << endl;
+            return 1;
+        }
+    }
+    if (threadsFound) {
+        exporter.setMaxThreadCount(threads.toInt());
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // No links exist when running headless so the first mavlink channel is always free
+    QString errorMessage;
+    if (!exporter.exportLog(0, errorMessage)) {
+        out << errorMessage << endl;
+        return 1;
+    }
+
+    out << tr("Exported %1 messages from %2 to %3 files in %4 in %5 seconds")
+           .arg(exporter.messageCount())
+           .arg(logFilename)
+           .arg(exporter.outputFiles().count())
+           .arg(outputDir)
+           .arg(timer.elapsed() / 1000.0, 0, 'f', 1) << endl;
+
+    return 0;
+}
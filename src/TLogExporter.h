@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QCoreApplication>
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QThreadPool>
+
+#include "QGCLoggingCategory.h"
+#include "QGCMAVLink.h"
+
+Q_DECLARE_LOGGING_CATEGORY(TLogExporterLog)
+
+/// Converts a telemetry (.tlog) log into typed columnar output, one set of files per mavlink message type.
+///
+/// The log is streamed once and each message is split into its fields using the mavlink message info tables. Rows are
+/// collected column by column into chunks. Full chunks are encoded and compressed on a thread pool, so the message types
+/// are processed in parallel while the chunks of each type are still written in order.
+///
+/// Output formats:
+///     <MESSAGE>.qcol      Chunked binary columns. QDataStream header: magic, version, message name, message id, columns
+///                         (name, MAVLINK_TYPE_*, element count). Then per chunk: row count followed by each column as a
+///                         qCompress'ed array of little endian values.
+///     <MESSAGE>.csv.gz    Comma separated values, gzip compressed. Each chunk is a separate gzip member.
+/// Every message type starts with timestamp_us, sysid and compid columns.
+class TLogExporter
+{
+    Q_DECLARE_TR_FUNCTIONS(TLogExporter)
+
+public:
+    enum Format {
+        FormatColumnar  = 0x01,
+        FormatCsv       = 0x02,
+        FormatAll       = FormatColumnar | FormatCsv,
+    };
+
+    /// Column of a columnar file
+    struct Column {
+        QString     name;
+        quint8      type;           ///< MAVLINK_TYPE_*
+        int         elementCount;   ///< 1 for non-array fields
+        QByteArray  data;           ///< All rows, packed
+    };
+
+    TLogExporter(const QString& logFilename, const QString& outputDir);
+    ~TLogExporter();
+
+    void setFormats         (int formats)       { _formats = formats; }
+    void setRowsPerChunk    (int rowsPerChunk)  { _rowsPerChunk = qMax(rowsPerChunk, 1); }
+    void setMaxThreadCount  (int threadCount)   { _threadPool.setMaxThreadCount(qMax(threadCount, 1)); }
+
+    /// Exports the log, returning once all output has been written
+    ///     @param mavlinkChannel Channel used to parse the log
+    ///     @return false: errorMessage set
+    bool exportLog(uint8_t mavlinkChannel, QString& errorMessage);
+
+    quint64     messageCount    (void) const { return _messageCount; }
+    QStringList outputFiles     (void) const { return _outputFiles; }
+
+    /// Reads a columnar file back in, all chunks are concatenated
+    ///     @return false: errorMessage set
+    static bool readColumnarFile(const QString& filename, QString& messageName, QList<Column>& columns, QString& errorMessage);
+
+    /// @return true: command line requests a headless export
+    static bool isCommandLineExport(int argc, char* argv[]);
+
+    /// Runs the headless export requested on the command line
+    ///     --export-tlog:<log file>        Log to export
+    ///     --export-dir:<directory>        Output directory, defaults to <log name>_export next to the log
+    ///     --export-format:<columnar|csv>  Limit output to a single format
+    ///     --export-threads:<count>        Maximum number of encoding threads
+    ///     @return Process exit code
+    static int runCommandLineExport(int& argc, char* argv[]);
+
+    static int sizeOfType(quint8 mavlinkType);
+
+    static const char* columnarFileExtension;
+    static const char* csvFileExtension;
+
+private:
+    class MessageWriter;
+
+    MessageWriter* _writerForMessage(const mavlink_message_t& message, QString& errorMessage);
+    void           _flushWriter     (MessageWriter* writer);
+    void           _waitForPending  (int maxPending);
+    void           _clearWriters    (void);
+
+    QString                         _logFilename;
+    QString                         _outputDir;
+    int                             _formats;
+    int                             _rowsPerChunk;
+    quint64                         _messageCount;
+    QThreadPool                     _threadPool;
+    QHash<quint32, MessageWriter*>  _writers;
+    QStringList                     _outputFiles;
+    QList<QFuture<void>>            _pendingWrites;
+
+    static const int        _defaultRowsPerChunk =  4096;
+    static const int        _compressionLevel =     1;
+    static const quint32    _columnarFileMagic =    0x4c4f4351; // "QCOL"
+    static const quint32    _columnarFileVersion =  1;
+};
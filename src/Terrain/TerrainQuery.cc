@@ -24,6 +24,8 @@
 #include <QTimer>
 #include <QtLocation/private/qgeotilespec_p.h>
 
+#include <QPair>
+
 #include <cmath>
 
 QGC_LOGGING_CATEGORY(TerrainQueryLog, "TerrainQueryLog")
@@ -275,6 +277,19 @@ TerrainOfflineAirMapQuery::TerrainOfflineAirMapQuery(QObject* parent)
     qCDebug(TerrainQueryVerboseLog) << "supportsSsl" << QSslSocket::supportsSsl() << "sslLibraryBuildVersionString" << QSslSocket::sslLibraryBuildVersionString();
 }
 
+TerrainOfflineAirMapQuery::~TerrainOfflineAirMapQuery()
+{
+    // The tile manager must not signal a query which no longer exists
+    cancelRequests();
+}
+
+void TerrainOfflineAirMapQuery::cancelRequests(void)
+{
+    if (_terrainTileManager.exists() && !_terrainTileManager.isDestroyed()) {
+        _terrainTileManager->cancelQueries(this);
+    }
+}
+
 void TerrainOfflineAirMapQuery::requestCoordinateHeights(const QList<QGeoCoordinate>& coordinates)
 {
     if (qgcApp()->runningUnitTests()) {
@@ -397,6 +412,18 @@ void TerrainTileManager::addPathQuery(TerrainOfflineAirMapQuery* terrainQueryInt
     }
 }
 
+/// Drops the queued requests for the specified query. The queue entries are only marked as cancelled so this is safe to
+/// call from within a terrain signal while the queue is being processed.
+void TerrainTileManager::cancelQueries(TerrainOfflineAirMapQuery* terrainQueryInterface)
+{
+    for (QueuedRequestInfo_t& requestInfo: _requestQueue) {
+        if (requestInfo.terrainQueryInterface == terrainQueryInterface) {
+            qCDebug(TerrainQueryLog) << "TerrainTileManager::cancelQueries" << terrainQueryInterface;
+            requestInfo.terrainQueryInterface = nullptr;
+        }
+    }
+}
+
 /// Either returns altitudes from cache or queues database request
 ///     @param[out] error true: altitude not returned due to error, false: altitudes returned
 /// @return true: altitude returned (check error as well), false: database query queued (altitudes not returned)
@@ -452,6 +479,10 @@ void TerrainTileManager::_tileFailed(void)
     QList<double>    noAltitudes;
 
     for (const QueuedRequestInfo_t& requestInfo: _requestQueue) {
+        if (!requestInfo.terrainQueryInterface) {
+            // Cancelled
+            continue;
+        }
         if (requestInfo.queryMode == QueryMode::QueryModeCoordinates) {
             requestInfo.terrainQueryInterface->_signalCoordinateHeights(false, noAltitudes);
         } else if (requestInfo.queryMode == QueryMode::QueryModePath) {
@@ -512,6 +543,12 @@ void TerrainTileManager::_terrainDone(QByteArray responseBytes, QNetworkReply::N
         QList<double> altitudes;
         QueuedRequestInfo_t& requestInfo = _requestQueue[i];
 
+        if (!requestInfo.terrainQueryInterface) {
+            // Cancelled
+            _requestQueue.removeAt(i);
+            continue;
+        }
+
         if (_getAltitudesForCoordinates(requestInfo.coordinates, altitudes, error)) {
             if (requestInfo.queryMode == QueryMode::QueryModeCoordinates) {
                 if (error) {
@@ -549,18 +586,36 @@ QString TerrainTileManager::_getTileHash(const QGeoCoordinate& coordinate)
     return ret;
 }
 
-TerrainAtCoordinateBatchManager::TerrainAtCoordinateBatchManager(void)
+TerrainAtCoordinateBatchManager::TerrainAtCoordinateBatchManager(TerrainQueryInterface* terrainQuery)
+    : _terrainQuery(terrainQuery ? terrainQuery : &_offlineTerrainQuery)
 {
     _batchTimer.setSingleShot(true);
     _batchTimer.setInterval(_batchTimeout);
     connect(&_batchTimer, &QTimer::timeout, this, &TerrainAtCoordinateBatchManager::_sendNextBatch);
-    connect(&_terrainQuery, &TerrainQueryInterface::coordinateHeightsReceived, this, &TerrainAtCoordinateBatchManager::_coordinateHeights);
+    connect(_terrainQuery, &TerrainQueryInterface::coordinateHeightsReceived, this, &TerrainAtCoordinateBatchManager::_coordinateHeights);
 }
 
 void TerrainAtCoordinateBatchManager::addQuery(TerrainAtCoordinateQuery* terrainAtCoordinateQuery, const QList<QGeoCoordinate>& coordinates)
 {
     if (coordinates.length() > 0) {
-        connect(terrainAtCoordinateQuery, &TerrainAtCoordinateQuery::destroyed, this, &TerrainAtCoordinateBatchManager::_queryObjectDestroyed);
+        connect(terrainAtCoordinateQuery, &TerrainAtCoordinateQuery::destroyed, this, &TerrainAtCoordinateBatchManager::_queryObjectDestroyed, Qt::UniqueConnection);
+
+        // Results for an earlier request from the same query which is already being downloaded are now stale
+        for (SentRequestInfo_t& sentRequestInfo: _sentRequests) {
+            if (sentRequestInfo.terrainAtCoordinateQuery == terrainAtCoordinateQuery) {
+                sentRequestInfo.cancelled = true;
+            }
+        }
+
+        // Coalesce with an earlier request from the same query which has not been sent yet
+        for (QueuedRequestInfo_t& requestInfo: _requestQueue) {
+            if (requestInfo.terrainAtCoordinateQuery == terrainAtCoordinateQuery) {
+                qCDebug(TerrainQueryLog) << "TerrainAtCoordinateBatchManager::addQuery replacing queued request" << terrainAtCoordinateQuery;
+                requestInfo.coordinates = coordinates;
+                return;
+            }
+        }
+
         QueuedRequestInfo_t queuedRequestInfo = { terrainAtCoordinateQuery, coordinates };
         _requestQueue.append(queuedRequestInfo);
         if (!_batchTimer.isActive()) {
@@ -569,6 +624,29 @@ void TerrainAtCoordinateBatchManager::addQuery(TerrainAtCoordinateQuery* terrain
     }
 }
 
+/// Removes the queued request for the query and drops the results of a request which has already been sent
+void TerrainAtCoordinateBatchManager::cancelQuery(TerrainAtCoordinateQuery* terrainAtCoordinateQuery)
+{
+    int i = 0;
+    while (i < _requestQueue.count()) {
+        const QueuedRequestInfo_t& requestInfo = _requestQueue[i];
+        if (requestInfo.terrainAtCoordinateQuery == terrainAtCoordinateQuery) {
+            qCDebug(TerrainQueryLog) << "Removing cancelled query from _requestQueue index:terrainAtCoordinateQuery" << i << requestInfo.terrainAtCoordinateQuery;
+            _requestQueue.removeAt(i);
+        } else {
+            i++;
+        }
+    }
+
+    for (int i=0; i<_sentRequests.count(); i++) {
+        SentRequestInfo_t& sentRequestInfo = _sentRequests[i];
+        if (sentRequestInfo.terrainAtCoordinateQuery == terrainAtCoordinateQuery) {
+            qCDebug(TerrainQueryLog) << "Zombieing cancelled query from _sentRequests index:terrainAtCoordinateQuery" << sentRequestInfo.terrainAtCoordinateQuery;
+            sentRequestInfo.cancelled = true;
+        }
+    }
+}
+
 void TerrainAtCoordinateBatchManager::_sendNextBatch(void)
 {
     qCDebug(TerrainQueryLog) << "TerrainAtCoordinateBatchManager::_sendNextBatch _state:_requestQueue.count:_sentRequests.count" << _stateToString(_state) << _requestQueue.count() << _sentRequests.count();
@@ -586,36 +664,48 @@ void TerrainAtCoordinateBatchManager::_sendNextBatch(void)
 
     _sentRequests.clear();
 
-    // Convert coordinates to point strings for json query
-    QList<QGeoCoordinate> coords;
-    int requestQueueAdded = 0;
+    // Build the list of unique coordinates for the query. Mission items frequently share coordinates, for example
+    // consecutive items at the same location or an item and the start of a complex item, so these are only queried once.
+    QList<QGeoCoordinate>               coords;
+    QHash<QPair<double, double>, int>   coordIndexMap;
+    int                                 requestQueueAdded = 0;
     for (const QueuedRequestInfo_t& requestInfo: _requestQueue) {
-        SentRequestInfo_t sentRequestInfo = { requestInfo.terrainAtCoordinateQuery, false, requestInfo.coordinates.count() };
+        SentRequestInfo_t sentRequestInfo = { requestInfo.terrainAtCoordinateQuery, false, QList<int>() };
+        for (const QGeoCoordinate& coord: requestInfo.coordinates) {
+            QPair<double, double> key(coord.latitude(), coord.longitude());
+            auto it = coordIndexMap.constFind(key);
+            if (it == coordIndexMap.constEnd()) {
+                it = coordIndexMap.insert(key, coords.count());
+                coords.append(coord);
+            }
+            sentRequestInfo.coordIndices.append(it.value());
+        }
         _sentRequests.append(sentRequestInfo);
-        coords += requestInfo.coordinates;
         requestQueueAdded++;
         if (coords.count() > 50) {
             break;
         }
     }
     _requestQueue = _requestQueue.mid(requestQueueAdded);
-    qCDebug(TerrainQueryLog) << "TerrainAtCoordinateBatchManager::_sendNextBatch requesting next batch _state:_requestQueue.count:_sentRequests.count" << _stateToString(_state) << _requestQueue.count() << _sentRequests.count();
+    qCDebug(TerrainQueryLog) << "TerrainAtCoordinateBatchManager::_sendNextBatch requesting next batch _state:_requestQueue.count:_sentRequests.count:coords" << _stateToString(_state) << _requestQueue.count() << _sentRequests.count() << coords.count();
 
     _state = State::Downloading;
-    _terrainQuery.requestCoordinateHeights(coords);
+    _terrainQuery->requestCoordinateHeights(coords);
 }
 
 void TerrainAtCoordinateBatchManager::_batchFailed(void)
 {
     QList<double> noHeights;
 
-    for (const SentRequestInfo_t& sentRequestInfo: _sentRequests) {
-        if (!sentRequestInfo.queryObjectDestroyed) {
-            disconnect(sentRequestInfo.terrainAtCoordinateQuery, &TerrainAtCoordinateQuery::destroyed, this, &TerrainAtCoordinateBatchManager::_queryObjectDestroyed);
+    // Signalling may cause new requests to be added, so work from a copy
+    QList<SentRequestInfo_t> sentRequests = _sentRequests;
+    _sentRequests.clear();
+
+    for (const SentRequestInfo_t& sentRequestInfo: sentRequests) {
+        if (!sentRequestInfo.cancelled) {
             sentRequestInfo.terrainAtCoordinateQuery->_signalTerrainData(false, noHeights);
         }
     }
-    _sentRequests.clear();
 }
 
 void TerrainAtCoordinateBatchManager::_queryObjectDestroyed(QObject* terrainAtCoordinateQuery)
@@ -624,24 +714,7 @@ void TerrainAtCoordinateBatchManager::_queryObjectDestroyed(QObject* terrainAtCo
 
     qCDebug(TerrainQueryLog) << "_TerrainAtCoordinateQueryDestroyed TerrainAtCoordinateQuery" << terrainAtCoordinateQuery;
 
-    int i = 0;
-    while (i < _requestQueue.count()) {
-        const QueuedRequestInfo_t& requestInfo = _requestQueue[i];
-        if (requestInfo.terrainAtCoordinateQuery == terrainAtCoordinateQuery) {
-            qCDebug(TerrainQueryLog) << "Removing deleted provider from _requestQueue index:terrainAtCoordinateQuery" << i << requestInfo.terrainAtCoordinateQuery;
-            _requestQueue.removeAt(i);
-        } else {
-            i++;
-        }
-    }
-
-    for (int i=0; i<_sentRequests.count(); i++) {
-        SentRequestInfo_t& sentRequestInfo = _sentRequests[i];
-        if (sentRequestInfo.terrainAtCoordinateQuery == terrainAtCoordinateQuery) {
-            qCDebug(TerrainQueryLog) << "Zombieing deleted provider from _sentRequests index:terrainAtCoordinateQuery" << sentRequestInfo.terrainAtCoordinateQuery;
-            sentRequestInfo.queryObjectDestroyed = true;
-        }
-    }
+    cancelQuery(static_cast<TerrainAtCoordinateQuery*>(terrainAtCoordinateQuery));
 }
 
 QString TerrainAtCoordinateBatchManager::_stateToString(State state)
@@ -664,20 +737,26 @@ void TerrainAtCoordinateBatchManager::_coordinateHeights(bool success, QList<dou
 
     if (!success) {
         _batchFailed();
+        if (_requestQueue.count()) {
+            _batchTimer.start();
+        }
         return;
     }
 
-    int currentIndex = 0;
-    for (const SentRequestInfo_t& sentRequestInfo: _sentRequests) {
-        if (!sentRequestInfo.queryObjectDestroyed) {
-            qCDebug(TerrainQueryVerboseLog) << "TerrainAtCoordinateBatchManager::_coordinateHeights returned TerrainCoordinateQuery:count" <<  sentRequestInfo.terrainAtCoordinateQuery << sentRequestInfo.cCoord;
-            disconnect(sentRequestInfo.terrainAtCoordinateQuery, &TerrainAtCoordinateQuery::destroyed, this, &TerrainAtCoordinateBatchManager::_queryObjectDestroyed);
-            QList<double> requestAltitudes = heights.mid(currentIndex, sentRequestInfo.cCoord);
+    // Signalling may cause new requests to be added, so work from a copy
+    QList<SentRequestInfo_t> sentRequests = _sentRequests;
+    _sentRequests.clear();
+
+    for (const SentRequestInfo_t& sentRequestInfo: sentRequests) {
+        if (!sentRequestInfo.cancelled) {
+            qCDebug(TerrainQueryVerboseLog) << "TerrainAtCoordinateBatchManager::_coordinateHeights returned TerrainCoordinateQuery:count" <<  sentRequestInfo.terrainAtCoordinateQuery << sentRequestInfo.coordIndices.count();
+            QList<double> requestAltitudes;
+            for (int coordIndex: sentRequestInfo.coordIndices) {
+                requestAltitudes.append(heights.value(coordIndex, qQNaN()));
+            }
             sentRequestInfo.terrainAtCoordinateQuery->_signalTerrainData(true, requestAltitudes);
-            currentIndex += sentRequestInfo.cCoord;
         }
     }
-    _sentRequests.clear();
 
     if (_requestQueue.count()) {
         _batchTimer.start();
@@ -698,6 +777,11 @@ void TerrainAtCoordinateQuery::requestData(const QList<QGeoCoordinate>& coordina
     _TerrainAtCoordinateBatchManager->addQuery(this, coordinates);
 }
 
+void TerrainAtCoordinateQuery::cancel(void)
+{
+    _TerrainAtCoordinateBatchManager->cancelQuery(this);
+}
+
 void TerrainAtCoordinateQuery::_signalTerrainData(bool success, QList<double>& heights)
 {
     emit terrainDataReceived(success, heights);
@@ -715,6 +799,11 @@ void TerrainPathQuery::requestData(const QGeoCoordinate& fromCoord, const QGeoCo
     _terrainQuery.requestPathHeights(fromCoord, toCoord);
 }
 
+void TerrainPathQuery::cancel(void)
+{
+    _terrainQuery.cancelRequests();
+}
+
 void TerrainPathQuery::_pathHeights(bool success, double latStep, double lonStep, const QList<double>& heights)
 {
     PathHeightInfo_t pathHeightInfo;
@@ -727,6 +816,7 @@ void TerrainPathQuery::_pathHeights(bool success, double latStep, double lonStep
 TerrainPolyPathQuery::TerrainPolyPathQuery(QObject* parent)
     : QObject   (parent)
     , _curIndex (0)
+    , _cancelled(false)
 {
     connect(&_pathQuery, &TerrainPathQuery::terrainDataReceived, this, &TerrainPolyPathQuery::_terrainDataReceived);
 }
@@ -746,16 +836,33 @@ void TerrainPolyPathQuery::requestData(const QList<QGeoCoordinate>& polyPath)
 {
     qCDebug(TerrainQueryLog) << "TerrainPolyPathQuery::requestData count" << polyPath.count();
 
+    // Replace any request which is still outstanding
+    _pathQuery.cancel();
+
     // Kick off first request
     _rgCoords = polyPath;
     _curIndex = 0;
+    _cancelled = false;
+    _rgPathHeightInfo.clear();
     _pathQuery.requestData(_rgCoords[0], _rgCoords[1]);
 }
 
+void TerrainPolyPathQuery::cancel(void)
+{
+    qCDebug(TerrainQueryLog) << "TerrainPolyPathQuery::cancel _curIndex:count" << _curIndex << _rgCoords.count();
+
+    _cancelled = true;
+    _pathQuery.cancel();
+}
+
 void TerrainPolyPathQuery::_terrainDataReceived(bool success, const TerrainPathQuery::PathHeightInfo_t& pathHeightInfo)
 {
     qCDebug(TerrainQueryLog) << "TerrainPolyPathQuery::_terrainDataReceived success:_curIndex" << success << _curIndex;
 
+    if (_cancelled) {
+        return;
+    }
+
     if (!success) {
         _rgPathHeightInfo.clear();
         emit terrainDataReceived(false /* success */, _rgPathHeightInfo);
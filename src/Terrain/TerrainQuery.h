@@ -96,6 +96,10 @@ class TerrainOfflineAirMapQuery : public TerrainQueryInterface {
 
 public:
     TerrainOfflineAirMapQuery(QObject* parent = nullptr);
+    ~TerrainOfflineAirMapQuery();
+
+    /// Drops all requests which are still waiting on terrain tiles. No signals are emitted for them.
+    void cancelRequests(void);
 
     // Overrides from TerrainQueryInterface
     void requestCoordinateHeights(const QList<QGeoCoordinate>& coordinates) final;
@@ -117,6 +121,7 @@ public:
 
     void addCoordinateQuery (TerrainOfflineAirMapQuery* terrainQueryInterface, const QList<QGeoCoordinate>& coordinates);
     void addPathQuery       (TerrainOfflineAirMapQuery* terrainQueryInterface, const QGeoCoordinate& startPoint, const QGeoCoordinate& endPoint);
+    void cancelQueries      (TerrainOfflineAirMapQuery* terrainQueryInterface);
 
 private slots:
     void _terrainDone       (QByteArray responseBytes, QNetworkReply::NetworkError error);
@@ -152,14 +157,18 @@ private:
     QHash<QString, TerrainTile> _tiles;
 };
 
-/// Used internally by TerrainAtCoordinateQuery to batch coordinate requests together
+/// Used internally by TerrainAtCoordinateQuery to batch coordinate requests together.
+/// A new request from a query replaces its earlier one which has not been answered yet. Coordinates which are shared by
+/// the requests within a batch are only queried once.
 class TerrainAtCoordinateBatchManager : public QObject {
     Q_OBJECT
 
 public:
-    TerrainAtCoordinateBatchManager(void);
+    /// @param terrainQuery Query used to request the heights for each batch, nullptr for the offline AirMap query
+    TerrainAtCoordinateBatchManager(TerrainQueryInterface* terrainQuery = nullptr);
 
-    void addQuery(TerrainAtCoordinateQuery* terrainAtCoordinateQuery, const QList<QGeoCoordinate>& coordinates);
+    void addQuery   (TerrainAtCoordinateQuery* terrainAtCoordinateQuery, const QList<QGeoCoordinate>& coordinates);
+    void cancelQuery(TerrainAtCoordinateQuery* terrainAtCoordinateQuery);
 
 private slots:
     void _sendNextBatch         (void);
@@ -174,8 +183,8 @@ private:
 
     typedef struct {
         TerrainAtCoordinateQuery*   terrainAtCoordinateQuery;
-        bool                        queryObjectDestroyed;
-        int                         cCoord;
+        bool                        cancelled;          ///< true: query object destroyed or superseded by a newer request
+        QList<int>                  coordIndices;       ///< Index of each requested coordinate within the batch heights
     } SentRequestInfo_t;
 
 
@@ -192,7 +201,8 @@ private:
     State                       _state = State::Idle;
     const int                   _batchTimeout = 500;
     QTimer                      _batchTimer;
-    TerrainOfflineAirMapQuery   _terrainQuery;
+    TerrainOfflineAirMapQuery   _offlineTerrainQuery;
+    TerrainQueryInterface*      _terrainQuery;
 };
 
 /// NOTE: TerrainAtCoordinateQuery is not thread safe. All instances/calls to ElevationProvider must be on main thread.
@@ -203,10 +213,13 @@ public:
     TerrainAtCoordinateQuery(QObject* parent = nullptr);
 
     /// Async terrain query for a list of lon,lat coordinates. When the query is done, the terrainData() signal
-    /// is emitted.
+    /// is emitted. A query object can be reused, a new request replaces any earlier one which has not been answered yet.
     ///     @param coordinates to query
     void requestData(const QList<QGeoCoordinate>& coordinates);
 
+    /// Drops the outstanding request, terrainDataReceived is not signalled for it
+    void cancel(void);
+
     // Internal method
     void _signalTerrainData(bool success, QList<double>& heights);
 
@@ -226,6 +239,9 @@ public:
     ///     @param coordinates to query
     void requestData(const QGeoCoordinate& fromCoord, const QGeoCoordinate& toCoord);
 
+    /// Drops the outstanding request, terrainDataReceived is not signalled for it
+    void cancel(void);
+
     typedef struct {
         double          latStep;    ///< Amount of latitudinal distance between each returned height
         double          lonStep;    ///< Amount of longitudinal distance between each returned height
@@ -258,6 +274,9 @@ public:
     void requestData(const QVariantList& polyPath);
     void requestData(const QList<QGeoCoordinate>& polyPath);
 
+    /// Drops the outstanding request along with its remaining path queries, terrainDataReceived is not signalled for it
+    void cancel(void);
+
 signals:
     /// Signalled when terrain data comes back from server
     void terrainDataReceived(bool success, const QList<TerrainPathQuery::PathHeightInfo_t>& rgPathHeightInfo);
@@ -267,6 +286,7 @@ private slots:
 
 private:
     int                                         _curIndex;
+    bool                                        _cancelled;
     QList<QGeoCoordinate>                       _rgCoords;
     QList<TerrainPathQuery::PathHeightInfo_t>   _rgPathHeightInfo;
     TerrainPathQuery                            _pathQuery;
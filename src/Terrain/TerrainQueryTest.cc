@@ -0,0 +1,136 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TerrainQueryTest.h"
+
+void TerrainQueryTestQuery::answerLastRequest(void)
+{
+    QList<double> heights;
+    for (const QGeoCoordinate& coord: requests.last()) {
+        heights.append(coord.latitude());
+    }
+    emit coordinateHeightsReceived(true, heights);
+}
+
+/// Coordinates shared by the requests in a batch are only queried once, each query still gets a height for every
+/// coordinate it asked for
+void TerrainQueryTest::_sharedCoordinates(void)
+{
+    TerrainQueryTestQuery           terrainQuery;
+    TerrainAtCoordinateBatchManager batchManager(&terrainQuery);
+    TerrainAtCoordinateQuery        query1;
+    TerrainAtCoordinateQuery        query2;
+    QSignalSpy                      spy1(&query1, &TerrainAtCoordinateQuery::terrainDataReceived);
+    QSignalSpy                      spy2(&query2, &TerrainAtCoordinateQuery::terrainDataReceived);
+
+    batchManager.addQuery(&query1, { QGeoCoordinate(10, 1), QGeoCoordinate(20, 2), QGeoCoordinate(10, 1) });
+    batchManager.addQuery(&query2, { QGeoCoordinate(20, 2), QGeoCoordinate(30, 3) });
+    QTRY_COMPARE_WITH_TIMEOUT(terrainQuery.requests.count(), 1, 2000);
+    QCOMPARE(terrainQuery.requests[0], QList<QGeoCoordinate>({ QGeoCoordinate(10, 1), QGeoCoordinate(20, 2), QGeoCoordinate(30, 3) }));
+
+    terrainQuery.answerLastRequest();
+    QCOMPARE(spy1.count(), 1);
+    QCOMPARE(spy2.count(), 1);
+    QCOMPARE(spy1[0][0].toBool(), true);
+    QCOMPARE(spy1[0][1].value<QList<double>>(), QList<double>({ 10, 20, 10 }));
+    QCOMPARE(spy2[0][1].value<QList<double>>(), QList<double>({ 20, 30 }));
+}
+
+/// A new request from a query replaces its queued request, and the results of one which is already downloading
+void TerrainQueryTest::_replacedRequest(void)
+{
+    TerrainQueryTestQuery           terrainQuery;
+    TerrainAtCoordinateBatchManager batchManager(&terrainQuery);
+    TerrainAtCoordinateQuery        query;
+    QSignalSpy                      spy(&query, &TerrainAtCoordinateQuery::terrainDataReceived);
+
+    // Queued requests coalesce
+    batchManager.addQuery(&query, { QGeoCoordinate(10, 1) });
+    batchManager.addQuery(&query, { QGeoCoordinate(20, 2) });
+    QTRY_COMPARE_WITH_TIMEOUT(terrainQuery.requests.count(), 1, 2000);
+    QCOMPARE(terrainQuery.requests[0], QList<QGeoCoordinate>({ QGeoCoordinate(20, 2) }));
+
+    // The downloading request is stale once a new one comes in
+    batchManager.addQuery(&query, { QGeoCoordinate(30, 3) });
+    terrainQuery.answerLastRequest();
+    QCOMPARE(spy.count(), 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(terrainQuery.requests.count(), 2, 2000);
+    QCOMPARE(terrainQuery.requests[1], QList<QGeoCoordinate>({ QGeoCoordinate(30, 3) }));
+    terrainQuery.answerLastRequest();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy[0][1].value<QList<double>>(), QList<double>({ 30 }));
+}
+
+/// Cancelled and destroyed queries are not signalled, whether they are queued or downloading
+void TerrainQueryTest::_cancelledQuery(void)
+{
+    TerrainQueryTestQuery           terrainQuery;
+    TerrainAtCoordinateBatchManager batchManager(&terrainQuery);
+    TerrainAtCoordinateQuery        query1;
+    TerrainAtCoordinateQuery        query2;
+    TerrainAtCoordinateQuery*       query3 = new TerrainAtCoordinateQuery();
+    QSignalSpy                      spy1(&query1, &TerrainAtCoordinateQuery::terrainDataReceived);
+    QSignalSpy                      spy2(&query2, &TerrainAtCoordinateQuery::terrainDataReceived);
+
+    // Queued
+    batchManager.addQuery(&query1, { QGeoCoordinate(10, 1) });
+    batchManager.addQuery(&query2, { QGeoCoordinate(20, 2) });
+    batchManager.cancelQuery(&query2);
+    QTRY_COMPARE_WITH_TIMEOUT(terrainQuery.requests.count(), 1, 2000);
+    QCOMPARE(terrainQuery.requests[0], QList<QGeoCoordinate>({ QGeoCoordinate(10, 1) }));
+    terrainQuery.answerLastRequest();
+    QCOMPARE(spy1.count(), 1);
+    QCOMPARE(spy2.count(), 0);
+
+    // Downloading
+    batchManager.addQuery(&query1, { QGeoCoordinate(10, 1) });
+    batchManager.addQuery(&query2, { QGeoCoordinate(20, 2) });
+    batchManager.addQuery(query3, { QGeoCoordinate(30, 3) });
+    QTRY_COMPARE_WITH_TIMEOUT(terrainQuery.requests.count(), 2, 2000);
+    batchManager.cancelQuery(&query1);
+    delete query3;
+    terrainQuery.answerLastRequest();
+    QCOMPARE(spy1.count(), 1);
+    QCOMPARE(spy2.count(), 1);
+    QCOMPARE(spy2[0][1].value<QList<double>>(), QList<double>({ 20 }));
+}
+
+/// A failed batch is signalled to its queries and requests queued in the meantime still go out
+void TerrainQueryTest::_failedBatch(void)
+{
+    TerrainQueryTestQuery           terrainQuery;
+    TerrainAtCoordinateBatchManager batchManager(&terrainQuery);
+    TerrainAtCoordinateQuery        query1;
+    TerrainAtCoordinateQuery        query2;
+    QSignalSpy                      spy1(&query1, &TerrainAtCoordinateQuery::terrainDataReceived);
+    QSignalSpy                      spy2(&query2, &TerrainAtCoordinateQuery::terrainDataReceived);
+
+    batchManager.addQuery(&query1, { QGeoCoordinate(10, 1) });
+    QTRY_COMPARE_WITH_TIMEOUT(terrainQuery.requests.count(), 1, 2000);
+    batchManager.addQuery(&query2, { QGeoCoordinate(20, 2) });
+
+    emit terrainQuery.coordinateHeightsReceived(false, QList<double>());
+    QCOMPARE(spy1.count(), 1);
+    QCOMPARE(spy1[0][0].toBool(), false);
+    QCOMPARE(spy2.count(), 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(terrainQuery.requests.count(), 2, 2000);
+    QCOMPARE(terrainQuery.requests[1], QList<QGeoCoordinate>({ QGeoCoordinate(20, 2) }));
+    terrainQuery.answerLastRequest();
+    QCOMPARE(spy2.count(), 1);
+    QCOMPARE(spy2[0][0].toBool(), true);
+
+    // A failure with nothing queued leaves the manager ready for new requests
+    batchManager.addQuery(&query1, { QGeoCoordinate(30, 3) });
+    QTRY_COMPARE_WITH_TIMEOUT(terrainQuery.requests.count(), 3, 2000);
+    emit terrainQuery.coordinateHeightsReceived(false, QList<double>());
+    batchManager.addQuery(&query1, { QGeoCoordinate(40, 4) });
+    QTRY_COMPARE_WITH_TIMEOUT(terrainQuery.requests.count(), 4, 2000);
+}
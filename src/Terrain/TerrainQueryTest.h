@@ -0,0 +1,44 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "TerrainQuery.h"
+
+/// Answers coordinate height requests under control of the test
+class TerrainQueryTestQuery : public TerrainQueryInterface
+{
+    Q_OBJECT
+
+public:
+    TerrainQueryTestQuery(QObject* parent = nullptr) : TerrainQueryInterface(parent) { }
+
+    void requestCoordinateHeights   (const QList<QGeoCoordinate>& coordinates) final { requests.append(coordinates); }
+    void requestPathHeights         (const QGeoCoordinate& /* fromCoord */, const QGeoCoordinate& /* toCoord */) final { }
+    void requestCarpetHeights       (const QGeoCoordinate& /* swCoord */, const QGeoCoordinate& /* neCoord */, bool /* statsOnly */) final { }
+
+    /// Answers the last request with the latitude of each coordinate as its height
+    void answerLastRequest(void);
+
+    QList<QList<QGeoCoordinate>> requests;
+};
+
+/// Checks request batching of TerrainAtCoordinateBatchManager: shared coordinates, replaced and cancelled requests and
+/// recovery from failed batches
+class TerrainQueryTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _sharedCoordinates     (void);
+    void _replacedRequest       (void);
+    void _cancelledQuery        (void);
+    void _failedBatch           (void);
+};
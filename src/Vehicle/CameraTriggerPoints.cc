@@ -0,0 +1,239 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CameraTriggerPoints.h"
+
+#include <QHash>
+#include <QPair>
+#include <QtMath>
+
+const int CameraTriggerClusterModel::_coordinateRole = Qt::UserRole;
+const int CameraTriggerClusterModel::_imageCountRole = Qt::UserRole + 1;
+const int CameraTriggerPoints::_coordinateRole = Qt::UserRole;
+
+CameraTriggerClusterModel::CameraTriggerClusterModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+
+}
+
+void CameraTriggerClusterModel::setClusters(const QVector<Cluster>& clusters)
+{
+    if (clusters.count() == _clusters.count()) {
+        // Same number of rows, only the delegates contents change
+        _clusters = clusters;
+        if (!_clusters.isEmpty()) {
+            emit dataChanged(index(0), index(_clusters.count() - 1));
+        }
+        return;
+    }
+
+    beginResetModel();
+    _clusters = clusters;
+    endResetModel();
+    emit countChanged(_clusters.count());
+}
+
+int CameraTriggerClusterModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+
+    return _clusters.count();
+}
+
+QVariant CameraTriggerClusterModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= _clusters.count()) {
+        return QVariant();
+    }
+
+    if (role == _coordinateRole) {
+        return QVariant::fromValue(_clusters[index.row()].coordinate);
+    } else if (role == _imageCountRole) {
+        return _clusters[index.row()].imageCount;
+    } else {
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> CameraTriggerClusterModel::roleNames(void) const
+{
+    QHash<int, QByteArray> hash;
+
+    hash[_coordinateRole] = "coordinate";
+    hash[_imageCountRole] = "imageCount";
+
+    return hash;
+}
+
+CameraTriggerPoints::CameraTriggerPoints(QObject* parent)
+    : QAbstractListModel(parent)
+    , _clusterModel     (this)
+    , _metersPerPixel   (0)
+{
+    _flushTimer.setSingleShot(true);
+    _flushTimer.setInterval(_flushIntervalMSecs);
+    connect(&_flushTimer, &QTimer::timeout, this, &CameraTriggerPoints::_flushPending);
+}
+
+QGeoCoordinate CameraTriggerPoints::get(int index) const
+{
+    if (index < 0 || index >= _points.count()) {
+        return QGeoCoordinate();
+    }
+    return _points[index];
+}
+
+void CameraTriggerPoints::append(const QGeoCoordinate& coordinate)
+{
+    _pendingPoints.append(coordinate);
+    if (!_flushTimer.isActive()) {
+        _flushTimer.start();
+    }
+}
+
+void CameraTriggerPoints::_flushPending(void)
+{
+    if (_pendingPoints.isEmpty()) {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), _points.count(), _points.count() + _pendingPoints.count() - 1);
+    _points += _pendingPoints;
+    endInsertRows();
+    _pendingPoints.clear();
+
+    emit countChanged(_points.count());
+    _updateClusters();
+}
+
+void CameraTriggerPoints::clear(void)
+{
+    _flushTimer.stop();
+    _pendingPoints.clear();
+
+    if (!_points.isEmpty()) {
+        beginResetModel();
+        _points.clear();
+        endResetModel();
+        emit countChanged(0);
+    }
+    _updateClusters();
+}
+
+void CameraTriggerPoints::setViewport(const QGeoCoordinate& topLeft, const QGeoCoordinate& bottomRight, double metersPerPixel)
+{
+    _viewport       = QGeoRectangle(topLeft, bottomRight);
+    _metersPerPixel = metersPerPixel;
+    _updateClusters();
+}
+
+void CameraTriggerPoints::_updateClusters(void)
+{
+    QVector<CameraTriggerClusterModel::Cluster> clusters;
+
+    if (_points.isEmpty() || !_viewport.isValid() || _metersPerPixel <= 0) {
+        _clusterModel.setClusters(clusters);
+        return;
+    }
+
+    // Grid cells are sized in screen space, converted to degrees at the center of the view
+    const double metersPerDegree    = 111319.49;
+    double       cellLat            = (_clusterPixels * _metersPerPixel) / metersPerDegree;
+    double       cellLon            = cellLat / qMax(qCos(qDegreesToRadians(_viewport.center().latitude())), 0.01);
+    double       south              = _viewport.bottomLeft().latitude();
+    double       west               = _viewport.bottomLeft().longitude();
+
+    // Markers just outside the view are still partially visible
+    QGeoRectangle viewport = _viewport;
+    viewport.setWidth(qMin(viewport.width() + 2 * cellLon, 360.0));
+    viewport.setHeight(qMin(viewport.height() + 2 * cellLat, 180.0));
+
+    struct Accumulator {
+        double  latitude;
+        double  longitude;
+        double  altitude;
+        int     imageCount;
+        int     firstIndex;
+    };
+    QVector<Accumulator>        accumulators;
+    QHash<QPair<int,int>, int>  cellToAccumulator;
+
+    for (int i=0; i<_points.count(); i++) {
+        const QGeoCoordinate& point = _points[i];
+        if (!viewport.contains(point)) {
+            continue;
+        }
+
+        double lonOffset = point.longitude() - west;
+        if (lonOffset < -cellLon) {
+            // View crosses the anti-meridian
+            lonOffset += 360.0;
+        }
+        QPair<int,int> cell(qFloor((point.latitude() - south) / cellLat), qFloor(lonOffset / cellLon));
+
+        auto it = cellToAccumulator.find(cell);
+        if (it == cellToAccumulator.end()) {
+            cellToAccumulator.insert(cell, accumulators.count());
+            accumulators.append({ point.latitude(), lonOffset, point.altitude(), 1, i });
+        } else {
+            Accumulator& accumulator = accumulators[it.value()];
+            accumulator.latitude    += point.latitude();
+            accumulator.longitude   += lonOffset;
+            accumulator.altitude    += point.altitude();
+            accumulator.imageCount++;
+        }
+    }
+
+    clusters.reserve(accumulators.count());
+    for (const Accumulator& accumulator: accumulators) {
+        QGeoCoordinate coordinate;
+        if (accumulator.imageCount == 1) {
+            coordinate = _points[accumulator.firstIndex];
+        } else {
+            double longitude = west + accumulator.longitude / accumulator.imageCount;
+            if (longitude > 180.0) {
+                longitude -= 360.0;
+            }
+            coordinate = QGeoCoordinate(accumulator.latitude / accumulator.imageCount, longitude, accumulator.altitude / accumulator.imageCount);
+        }
+        clusters.append({ coordinate, accumulator.imageCount });
+    }
+
+    _clusterModel.setClusters(clusters);
+}
+
+int CameraTriggerPoints::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+
+    return _points.count();
+}
+
+QVariant CameraTriggerPoints::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= _points.count()) {
+        return QVariant();
+    }
+
+    if (role == _coordinateRole) {
+        return QVariant::fromValue(_points[index.row()]);
+    } else {
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> CameraTriggerPoints::roleNames(void) const
+{
+    QHash<int, QByteArray> hash;
+
+    hash[_coordinateRole] = "coordinate";
+
+    return hash;
+}
@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QGeoCoordinate>
+#include <QGeoRectangle>
+#include <QTimer>
+#include <QVector>
+
+/// Camera trigger clusters for the current map view
+class CameraTriggerClusterModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    CameraTriggerClusterModel(QObject* parent = nullptr);
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+    struct Cluster {
+        QGeoCoordinate  coordinate;
+        int             imageCount;
+    };
+
+    int count(void) const { return _clusters.count(); }
+
+    void setClusters(const QVector<Cluster>& clusters);
+
+signals:
+    void countChanged(int count);
+
+private:
+    // Overrides from QAbstractListModel
+    int                     rowCount    (const QModelIndex& parent = QModelIndex()) const override;
+    QVariant                data        (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray>  roleNames   (void) const override;
+
+    QVector<Cluster> _clusters;
+
+    static const int _coordinateRole;
+    static const int _imageCountRole;
+};
+
+/// Camera trigger locations reported by the vehicle.
+///
+/// Trigger points are stored by value and exposed as a list model with a coordinate role. Triggers which arrive in quick
+/// succession are inserted into the model as a single batch. For display, clusters() provides the triggers within the map
+/// view merged into a screen space grid so the number of map items stays bounded no matter how many images were taken.
+class CameraTriggerPoints : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    CameraTriggerPoints(QObject* parent = nullptr);
+
+    Q_PROPERTY(int                          count       READ count      NOTIFY countChanged)
+    Q_PROPERTY(CameraTriggerClusterModel*   clusters    READ clusters   CONSTANT)
+
+    /// @return Trigger location for the specified row
+    Q_INVOKABLE QGeoCoordinate get(int index) const;
+
+    /// Sets the map view used to build clusters()
+    ///     @param metersPerPixel Ground resolution of the map view
+    Q_INVOKABLE void setViewport(const QGeoCoordinate& topLeft, const QGeoCoordinate& bottomRight, double metersPerPixel);
+
+    int                         count       (void) const { return _points.count(); }
+    CameraTriggerClusterModel*  clusters    (void) { return &_clusterModel; }
+
+    /// Queues a trigger location for insertion into the model
+    void append(const QGeoCoordinate& coordinate);
+
+public slots:
+    void clear(void);
+
+signals:
+    void countChanged(int count);
+
+private slots:
+    void _flushPending      (void);
+    void _updateClusters    (void);
+
+private:
+    // Overrides from QAbstractListModel
+    int                     rowCount    (const QModelIndex& parent = QModelIndex()) const override;
+    QVariant                data        (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray>  roleNames   (void) const override;
+
+    QVector<QGeoCoordinate>     _points;
+    QVector<QGeoCoordinate>     _pendingPoints;
+    QTimer                      _flushTimer;
+    CameraTriggerClusterModel   _clusterModel;
+    QGeoRectangle               _viewport;
+    double                      _metersPerPixel;
+
+    static const int    _coordinateRole;
+    static const int    _flushIntervalMSecs =   250;
+    static const int    _clusterPixels =        48;     ///< Size of the screen space cluster grid
+};
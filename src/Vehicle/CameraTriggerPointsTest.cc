@@ -0,0 +1,167 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CameraTriggerPointsTest.h"
+#include "CameraTriggerPoints.h"
+
+namespace {
+
+/// Coordinate offset from origin by the specified number of meters north and east
+QGeoCoordinate _offset(const QGeoCoordinate& origin, double north, double east)
+{
+    return origin.atDistanceAndAzimuth(north, 0).atDistanceAndAzimuth(east, 90);
+}
+
+QVariant _roleData(QAbstractItemModel* model, int row, const QByteArray& roleName)
+{
+    return model->data(model->index(row, 0), model->roleNames().key(roleName));
+}
+
+/// @return Index of the cluster with the specified image count, -1 if none
+int _clusterRow(QAbstractItemModel* model, int imageCount)
+{
+    for (int row=0; row<model->rowCount(); row++) {
+        if (_roleData(model, row, "imageCount").toInt() == imageCount) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+}
+
+/// Triggers arriving in quick succession are inserted as a single batch
+void CameraTriggerPointsTest::_batchedFlush(void)
+{
+    CameraTriggerPoints     points;
+    QAbstractItemModel*     model = &points;
+    QSignalSpy              spyRowsInserted(model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy              spyCountChanged(&points, &CameraTriggerPoints::countChanged);
+    QGeoCoordinate          origin(47.3977419, 8.5455938, 500);
+
+    for (int i=0; i<5; i++) {
+        points.append(_offset(origin, i * 10, 0));
+    }
+    QCOMPARE(points.count(), 0);
+    QCOMPARE(model->rowCount(), 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(points.count(), 5, 1000);
+    QCOMPARE(spyRowsInserted.count(), 1);
+    QList<QVariant> arguments = spyRowsInserted.takeFirst();
+    QCOMPARE(arguments[1].toInt(), 0);
+    QCOMPARE(arguments[2].toInt(), 4);
+    QCOMPARE(spyCountChanged.count(), 1);
+    QCOMPARE(spyCountChanged.takeFirst().at(0).toInt(), 5);
+
+    for (int i=0; i<5; i++) {
+        QCOMPARE(points.get(i), _offset(origin, i * 10, 0));
+        QCOMPARE(_roleData(model, i, "coordinate").value<QGeoCoordinate>(), _offset(origin, i * 10, 0));
+    }
+    QVERIFY(!points.get(-1).isValid());
+    QVERIFY(!points.get(5).isValid());
+
+    // The next batch is appended after the existing rows
+    points.append(_offset(origin, 100, 0));
+    QTRY_COMPARE_WITH_TIMEOUT(points.count(), 6, 1000);
+    QCOMPARE(spyRowsInserted.count(), 1);
+    arguments = spyRowsInserted.takeFirst();
+    QCOMPARE(arguments[1].toInt(), 5);
+    QCOMPARE(arguments[2].toInt(), 5);
+}
+
+/// Clearing drops triggers which were not inserted yet
+void CameraTriggerPointsTest::_clearPending(void)
+{
+    CameraTriggerPoints points;
+    QSignalSpy          spyRowsInserted(&points, &QAbstractItemModel::rowsInserted);
+
+    points.append(QGeoCoordinate(47.3977419, 8.5455938));
+    points.clear();
+    QTest::qWait(500);
+    QCOMPARE(points.count(), 0);
+    QCOMPARE(spyRowsInserted.count(), 0);
+
+    points.append(QGeoCoordinate(47.3977419, 8.5455938));
+    QTRY_COMPARE_WITH_TIMEOUT(points.count(), 1, 1000);
+    points.clear();
+    QCOMPARE(points.count(), 0);
+    QCOMPARE(points.clusters()->count(), 0);
+}
+
+/// Triggers within a grid cell are merged into a single cluster at their mean position
+void CameraTriggerPointsTest::_clusters(void)
+{
+    CameraTriggerPoints points;
+    QAbstractItemModel* clusterModel = points.clusters();
+    QGeoCoordinate      southWest(47.39, 8.54, 0);
+    QGeoCoordinate      northEast = _offset(southWest, 2000, 2000);
+
+    // Ten triggers within a meter of each other near the south west corner, one trigger a kilometer east of them and
+    // one far outside the view
+    for (int i=0; i<10; i++) {
+        points.append(_offset(southWest, 1 + i * 0.1, 1));
+    }
+    QGeoCoordinate single = _offset(southWest, 1, 1000);
+    points.append(single);
+    points.append(_offset(southWest, 10000, 10000));
+    QTRY_COMPARE_WITH_TIMEOUT(points.count(), 12, 1000);
+
+    // No clusters without a view
+    QCOMPARE(points.clusters()->count(), 0);
+
+    // 10 meters per pixel puts the ten triggers in the same cell
+    points.setViewport(QGeoCoordinate(northEast.latitude(), southWest.longitude()), QGeoCoordinate(southWest.latitude(), northEast.longitude()), 10);
+    QCOMPARE(points.clusters()->count(), 2);
+
+    int row = _clusterRow(clusterModel, 10);
+    QVERIFY(row != -1);
+    QGeoCoordinate center = _roleData(clusterModel, row, "coordinate").value<QGeoCoordinate>();
+    QVERIFY(center.distanceTo(_offset(southWest, 1.45, 1)) < 0.01);
+
+    row = _clusterRow(clusterModel, 1);
+    QVERIFY(row != -1);
+    QCOMPARE(_roleData(clusterModel, row, "coordinate").value<QGeoCoordinate>(), single);
+
+    // Zoomed far in each trigger is its own cluster
+    points.setViewport(QGeoCoordinate(northEast.latitude(), southWest.longitude()), QGeoCoordinate(southWest.latitude(), northEast.longitude()), 0.001);
+    QCOMPARE(points.clusters()->count(), 11);
+    for (int row=0; row<clusterModel->rowCount(); row++) {
+        QCOMPARE(_roleData(clusterModel, row, "imageCount").toInt(), 1);
+    }
+}
+
+/// Clusters follow the view and new triggers
+void CameraTriggerPointsTest::_clusterViewport(void)
+{
+    CameraTriggerPoints points;
+    QAbstractItemModel* clusterModel = points.clusters();
+    QSignalSpy          spyCountChanged(points.clusters(), &CameraTriggerClusterModel::countChanged);
+    QSignalSpy          spyDataChanged(clusterModel, &QAbstractItemModel::dataChanged);
+    QGeoCoordinate      southWest(47.39, 8.54, 0);
+    QGeoCoordinate      northEast = _offset(southWest, 2000, 2000);
+
+    points.setViewport(QGeoCoordinate(northEast.latitude(), southWest.longitude()), QGeoCoordinate(southWest.latitude(), northEast.longitude()), 10);
+    points.append(_offset(southWest, 1, 1));
+    QTRY_COMPARE_WITH_TIMEOUT(points.clusters()->count(), 1, 1000);
+    QCOMPARE(spyCountChanged.count(), 1);
+
+    // A new trigger in the same cell changes the cluster contents, not the number of clusters
+    points.append(_offset(southWest, 2, 1));
+    QTRY_COMPARE_WITH_TIMEOUT(points.count(), 2, 1000);
+    QCOMPARE(points.clusters()->count(), 1);
+    QCOMPARE(spyCountChanged.count(), 1);
+    QVERIFY(spyDataChanged.count() > 0);
+    QCOMPARE(_roleData(clusterModel, 0, "imageCount").toInt(), 2);
+
+    // Moving the view away drops the clusters
+    QGeoCoordinate farAway = _offset(southWest, 100000, 0);
+    points.setViewport(_offset(farAway, 1000, 0), _offset(farAway, 0, 1000), 10);
+    QCOMPARE(points.clusters()->count(), 0);
+    QCOMPARE(spyCountChanged.count(), 2);
+}
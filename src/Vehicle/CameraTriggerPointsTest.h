@@ -0,0 +1,24 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Checks batched insertion of camera trigger points and the screen space clusters built from them
+class CameraTriggerPointsTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _batchedFlush      (void);
+    void _clearPending      (void);
+    void _clusters          (void);
+    void _clusterViewport   (void);
+};
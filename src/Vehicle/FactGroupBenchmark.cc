@@ -0,0 +1,52 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FactGroupBenchmark.h"
+#include "Vehicle.h"
+
+void FactGroupBenchmark::_gpsFactGroupUpdates(void)
+{
+    VehicleGPSFactGroup gpsFactGroup;
+    gpsFactGroup.setLiveUpdates(false);
+
+    // Varies the values so every update is a change
+    int iteration = 0;
+
+    // Same set of updates Vehicle::_handleGpsRawInt makes for each GPS_RAW_INT message
+    QBENCHMARK {
+        iteration++;
+        gpsFactGroup.lat()->setRawValue((473977419 + iteration) * 1e-7);
+        gpsFactGroup.lon()->setRawValue((85455938 + iteration) * 1e-7);
+        gpsFactGroup.count()->setRawValue(10 + (iteration & 3));
+        gpsFactGroup.hdop()->setRawValue(0.8 + (iteration & 7) * 0.01);
+        gpsFactGroup.vdop()->setRawValue(1.2 + (iteration & 7) * 0.01);
+        gpsFactGroup.courseOverGround()->setRawValue((iteration % 36000) / 100.0);
+        gpsFactGroup.lock()->setRawValue(GPS_FIX_TYPE_3D_FIX);
+    }
+}
+
+void FactGroupBenchmark::_vibrationFactGroupUpdates(void)
+{
+    VehicleVibrationFactGroup vibrationFactGroup;
+    vibrationFactGroup.setLiveUpdates(false);
+
+    // Varies the values so every update is a change
+    int iteration = 0;
+
+    // Same set of updates Vehicle::_handleVibration makes for each VIBRATION message
+    QBENCHMARK {
+        iteration++;
+        vibrationFactGroup.xAxis()->setRawValue(0.01f * (iteration & 15));
+        vibrationFactGroup.yAxis()->setRawValue(0.02f * (iteration & 15));
+        vibrationFactGroup.zAxis()->setRawValue(0.03f * (iteration & 15));
+        vibrationFactGroup.clipCount1()->setRawValue(iteration >> 10);
+        vibrationFactGroup.clipCount2()->setRawValue(iteration >> 11);
+        vibrationFactGroup.clipCount3()->setRawValue(iteration >> 12);
+    }
+}
@@ -0,0 +1,23 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Measures the cost of telemetry updates into the vehicle FactGroups. Updates are made with value change signals
+/// deferred, the same way Vehicle does it between FactGroup update timer ticks. Correctness is checked by FactGroupTest.
+class FactGroupBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _gpsFactGroupUpdates       (void);
+    void _vibrationFactGroupUpdates (void);
+};
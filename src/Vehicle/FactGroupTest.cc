@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FactGroupTest.h"
+#include "Vehicle.h"
+#include "MultiVehicleManager.h"
+#include "MAVLinkProtocol.h"
+#include "QGCApplication.h"
+
+/// Values updated while signals are deferred must come out of the deferred signal correctly
+void FactGroupTest::_deferredSignalValues(void)
+{
+    VehicleGPSFactGroup gpsFactGroup;
+    gpsFactGroup.setLiveUpdates(false);
+
+    QSignalSpy spyLat(gpsFactGroup.lat(), SIGNAL(valueChanged(QVariant)));
+
+    gpsFactGroup.lat()->setRawValue(47.3977419);
+    gpsFactGroup.lat()->setRawValue(47.3977420);
+    QCOMPARE(spyLat.count(), 0);
+    QVERIFY(gpsFactGroup.lat()->deferredValueChangeSignal());
+
+    gpsFactGroup.lat()->sendDeferredValueChangedSignal();
+    QCOMPARE(spyLat.count(), 1);
+    QCOMPARE(spyLat.takeFirst().at(0).toDouble(), 47.3977420);
+    QCOMPARE(gpsFactGroup.lat()->rawValue().type(), QVariant::Double);
+
+    // Setting the same value again is not a change, this includes NaN
+    gpsFactGroup.lat()->setRawValue(47.3977420);
+    QVERIFY(!gpsFactGroup.lat()->deferredValueChangeSignal());
+    gpsFactGroup.hdop()->setRawValue(std::numeric_limits<double>::quiet_NaN());
+    gpsFactGroup.hdop()->clearDeferredValueChangeSignal();
+    gpsFactGroup.hdop()->setRawValue(std::numeric_limits<double>::quiet_NaN());
+    QVERIFY(!gpsFactGroup.hdop()->deferredValueChangeSignal());
+
+    // Integer facts convert incoming values to their own type
+    gpsFactGroup.count()->setRawValue(12.0);
+    QCOMPARE(gpsFactGroup.count()->rawValue().type(), QVariant::Int);
+    QCOMPARE(gpsFactGroup.count()->rawValue().toInt(), 12);
+}
+
+/// Raw value signals are only built for connected receivers, connected receivers must still see every change
+void FactGroupTest::_rawValueSignals(void)
+{
+    VehicleGPSFactGroup gpsFactGroup;
+    gpsFactGroup.setLiveUpdates(false);
+
+    gpsFactGroup.count()->setRawValue(8);
+    QCOMPARE(gpsFactGroup.count()->rawValue().toInt(), 8);
+
+    QSignalSpy spyRaw(gpsFactGroup.count(), &Fact::rawValueChanged);
+    QSignalSpy spyContainer(gpsFactGroup.count(), &Fact::_containerRawValueChanged);
+
+    gpsFactGroup.count()->setRawValue(9.0);
+    QCOMPARE(spyRaw.count(), 1);
+    QCOMPARE(spyRaw.takeFirst().at(0).value<QVariant>().toInt(), 9);
+    QCOMPARE(spyContainer.count(), 1);
+    QCOMPARE(spyContainer.takeFirst().at(0).value<QVariant>().toInt(), 9);
+
+    gpsFactGroup.count()->setRawValue(9);
+    QCOMPARE(spyRaw.count(), 0);
+
+    // Values from the vehicle only signal rawValueChanged
+    gpsFactGroup.count()->_containerSetRawValue(10);
+    QCOMPARE(spyRaw.count(), 1);
+    QCOMPARE(spyRaw.takeFirst().at(0).value<QVariant>().toInt(), 10);
+    QCOMPARE(spyContainer.count(), 0);
+}
+
+/// A FactGroup update sends the deferred signals of all changed facts and only those
+void FactGroupTest::_updateAllValues(void)
+{
+    VehicleVibrationFactGroup vibrationFactGroup;
+    vibrationFactGroup.setLiveUpdates(false);
+
+    QSignalSpy spyX(vibrationFactGroup.xAxis(), SIGNAL(valueChanged(QVariant)));
+    QSignalSpy spyY(vibrationFactGroup.yAxis(), SIGNAL(valueChanged(QVariant)));
+    QSignalSpy spyClip(vibrationFactGroup.clipCount1(), SIGNAL(valueChanged(QVariant)));
+
+    vibrationFactGroup.xAxis()->setRawValue(0.25f);
+    vibrationFactGroup.clipCount1()->setRawValue(3);
+    QCOMPARE(spyX.count(), 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(spyX.count(), 1, 5000);
+    QCOMPARE(spyClip.count(), 1);
+    QCOMPARE(spyY.count(), 0);
+    QCOMPARE(spyX.takeFirst().at(0).toDouble(), 0.25);
+    QCOMPARE(spyClip.takeFirst().at(0).toInt(), 3);
+    QVERIFY(!vibrationFactGroup.xAxis()->deferredValueChangeSignal());
+}
+
+/// Groups built from the same json file share meta data, changes made through one fact must not show up in the others
+void FactGroupTest::_sharedMetaData(void)
+{
+    VehicleGPSFactGroup gpsFactGroup1;
+    VehicleGPSFactGroup gpsFactGroup2;
+    FactMetaData*       sharedMetaData  = gpsFactGroup1.lock()->metaData();
+
+    QVERIFY(sharedMetaData);
+    QStringList enumStrings = sharedMetaData->enumStrings();
+    QCOMPARE(gpsFactGroup2.lock()->metaData(), sharedMetaData);
+    QCOMPARE(gpsFactGroup1.lat()->metaData(), FactMetaData::sharedMapFromJsonFile(":/json/Vehicle/GPSFact.json").value("lat"));
+
+    // Unknown values are added to the enums of the fact which has the value
+    gpsFactGroup1.lock()->setRawValue(99);
+    QCOMPARE(gpsFactGroup1.lock()->enumIndex(), enumStrings.count());
+    QCOMPARE(gpsFactGroup1.lock()->enumStrings().count(), enumStrings.count() + 1);
+    QVERIFY(gpsFactGroup1.lock()->metaData() != sharedMetaData);
+    QCOMPARE(gpsFactGroup1.lock()->metaData()->parent(), static_cast<QObject*>(gpsFactGroup1.lock()));
+    QCOMPARE(sharedMetaData->enumStrings(), enumStrings);
+    QCOMPARE(gpsFactGroup2.lock()->enumStrings(), enumStrings);
+
+    // Enum info set on one fact stays with that fact
+    gpsFactGroup2.lock()->setEnumInfo(QStringList({ "Off", "On" }), QVariantList({ 0, 1 }));
+    QCOMPARE(gpsFactGroup2.lock()->enumStrings(), QStringList({ "Off", "On" }));
+    QCOMPARE(sharedMetaData->enumStrings(), enumStrings);
+    QCOMPARE(gpsFactGroup1.lock()->enumStrings().count(), enumStrings.count() + 1);
+
+    // New groups still get the unmodified shared meta data
+    VehicleGPSFactGroup gpsFactGroup3;
+    QCOMPARE(gpsFactGroup3.lock()->metaData(), sharedMetaData);
+    QCOMPARE(gpsFactGroup3.lock()->enumStrings(), enumStrings);
+}
+
+/// Firmware plugin meta data adjustments only apply to the vehicle they were made for
+void FactGroupTest::_firmwareMetaData(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    MultiVehicleManager*    vehicleMgr  = qgcApp()->toolbox()->multiVehicleManager();
+    Vehicle*                px4Vehicle  = _vehicle;
+    QStringList             factNames({ "altitudeRelative", "flightTime", "altitudeAMSL", "hobbs", "airSpeed" });
+    QStringList             shortDescriptions;
+
+    for (const QString& factName: factNames) {
+        shortDescriptions.append(px4Vehicle->getFact(factName)->shortDescription());
+    }
+    QCOMPARE(px4Vehicle->altitudeRelative()->shortDescription(), QStringLiteral("Alt (Rel)"));
+
+    // ArduSub renames and hides some of the vehicle facts
+    emit qgcApp()->toolbox()->mavlinkProtocol()->vehicleHeartbeatInfo(_mockLink, 42, MAV_COMP_ID_AUTOPILOT1, MAV_AUTOPILOT_ARDUPILOTMEGA, MAV_TYPE_SUBMARINE);
+    Vehicle* subVehicle = vehicleMgr->getVehicleById(42);
+    QVERIFY(subVehicle);
+    QCOMPARE(subVehicle->altitudeRelative()->shortDescription(), QStringLiteral("Depth"));
+    QCOMPARE(subVehicle->getFact("flightTime")->shortDescription(), QStringLiteral("Dive Time"));
+    QVERIFY(subVehicle->altitudeAMSL()->shortDescription().isEmpty());
+
+    // Vehicles connected before and after the sub keep the json short descriptions
+    emit qgcApp()->toolbox()->mavlinkProtocol()->vehicleHeartbeatInfo(_mockLink, 43, MAV_COMP_ID_AUTOPILOT1, MAV_AUTOPILOT_PX4, MAV_TYPE_QUADROTOR);
+    Vehicle* laterVehicle = vehicleMgr->getVehicleById(43);
+    QVERIFY(laterVehicle);
+    for (int i=0; i<factNames.count(); i++) {
+        QCOMPARE(px4Vehicle->getFact(factNames[i])->shortDescription(), shortDescriptions[i]);
+        QCOMPARE(laterVehicle->getFact(factNames[i])->shortDescription(), shortDescriptions[i]);
+    }
+}
@@ -0,0 +1,25 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Checks deferred value signalling, typed raw value storage and shared meta data for the vehicle FactGroups
+class FactGroupTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _deferredSignalValues  (void);
+    void _rawValueSignals       (void);
+    void _updateAllValues       (void);
+    void _sharedMetaData        (void);
+    void _firmwareMetaData      (void);
+};
@@ -0,0 +1,175 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "GeoFenceBreachMonitor.h"
+#include "Vehicle.h"
+#include "GeoFenceManager.h"
+#include "QGCFencePolygon.h"
+#include "QGCFenceCircle.h"
+#include "QGCApplication.h"
+#include "SettingsManager.h"
+#include "FlyViewSettings.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+
+QGC_LOGGING_CATEGORY(GeoFenceBreachMonitorLog, "GeoFenceBreachMonitorLog")
+
+QHash<QByteArray, QWeakPointer<const GeoFenceIndex>> GeoFenceBreachMonitor::_sharedIndices;
+
+GeoFenceBreachMonitor::GeoFenceBreachMonitor(Vehicle* vehicle, QObject* parent)
+    : QObject           (parent)
+    , _vehicle          (vehicle)
+    , _breachState      (NoBreach)
+    , _secondsToBreach  (qQNaN())
+    , _lookaheadSecs    (0)
+    , _announcedState   (NoBreach)
+{
+    Fact* lookaheadFact = qgcApp()->toolbox()->settingsManager()->flyViewSettings()->geoFenceLookahead();
+    connect(lookaheadFact, &Fact::rawValueChanged, this, &GeoFenceBreachMonitor::_lookaheadChanged);
+    _lookaheadChanged();
+
+    GeoFenceManager* geoFenceManager = _vehicle->geoFenceManager();
+    connect(geoFenceManager, &GeoFenceManager::loadComplete,        this, &GeoFenceBreachMonitor::_updateFencesFromVehicle);
+    connect(geoFenceManager, &GeoFenceManager::sendComplete,        this, &GeoFenceBreachMonitor::_updateFencesFromVehicle);
+    connect(geoFenceManager, &GeoFenceManager::removeAllComplete,   this, &GeoFenceBreachMonitor::_updateFencesFromVehicle);
+
+    connect(_vehicle, &Vehicle::coordinateChanged, this, &GeoFenceBreachMonitor::_checkPosition);
+}
+
+QSharedPointer<const GeoFenceIndex> GeoFenceBreachMonitor::indexForFences(const QList<QGCFencePolygon>& polygons, const QList<QGCFenceCircle>& circles)
+{
+    if (polygons.isEmpty() && circles.isEmpty()) {
+        return QSharedPointer<const GeoFenceIndex>();
+    }
+
+    // QGCMapCircle::radius has no const overload
+    auto circleRadius = [](const QGCFenceCircle& circle) { return const_cast<QGCFenceCircle&>(circle).radius()->rawValue().toDouble(); };
+
+    // Fences are keyed by their contents so vehicles flying the same fences share a single index
+    QByteArray  fenceBytes;
+    QDataStream stream(&fenceBytes, QIODevice::WriteOnly);
+    for (const QGCFencePolygon& polygon: polygons) {
+        stream << polygon.inclusion() << polygon.coordinateList();
+    }
+    for (const QGCFenceCircle& circle: circles) {
+        stream << circle.inclusion() << circle.center() << circleRadius(circle);
+    }
+    QByteArray key = QCryptographicHash::hash(fenceBytes, QCryptographicHash::Sha1);
+
+    QSharedPointer<const GeoFenceIndex> index = _sharedIndices.value(key).toStrongRef();
+    if (index) {
+        return index;
+    }
+
+    // Drop entries for indices which are no longer in use
+    auto it = _sharedIndices.begin();
+    while (it != _sharedIndices.end()) {
+        if (it.value().isNull()) {
+            it = _sharedIndices.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    QSharedPointer<GeoFenceIndex> newIndex(new GeoFenceIndex);
+    for (const QGCFencePolygon& polygon: polygons) {
+        newIndex->addPolygon(polygon.coordinateList(), polygon.inclusion());
+    }
+    for (const QGCFenceCircle& circle: circles) {
+        newIndex->addCircle(circle.center(), circleRadius(circle), circle.inclusion());
+    }
+    newIndex->build();
+
+    _sharedIndices[key] = newIndex;
+
+    return newIndex;
+}
+
+void GeoFenceBreachMonitor::setFences(const QList<QGCFencePolygon>& polygons, const QList<QGCFenceCircle>& circles)
+{
+    int oldFenceCount = fenceCount();
+
+    _index = indexForFences(polygons, circles);
+    qCDebug(GeoFenceBreachMonitorLog) << "setFences vehicle:fenceCount" << _vehicle->id() << fenceCount();
+
+    if (fenceCount() != oldFenceCount) {
+        emit fenceCountChanged(fenceCount());
+    }
+    _checkPosition();
+}
+
+void GeoFenceBreachMonitor::_updateFencesFromVehicle(void)
+{
+    GeoFenceManager* geoFenceManager = _vehicle->geoFenceManager();
+
+    setFences(geoFenceManager->polygons(), geoFenceManager->circles());
+}
+
+void GeoFenceBreachMonitor::_lookaheadChanged(void)
+{
+    _lookaheadSecs = qgcApp()->toolbox()->settingsManager()->flyViewSettings()->geoFenceLookahead()->rawValue().toDouble();
+    _checkPosition();
+}
+
+void GeoFenceBreachMonitor::_checkPosition(void)
+{
+    if (!_index) {
+        _setResult(NoBreach, qQNaN());
+        return;
+    }
+
+    GeoFenceIndex::Check check = _index->check(_vehicle->coordinate(), _vehicle->velocityNorth(), _vehicle->velocityEast(), _lookaheadSecs);
+    _setResult(static_cast<BreachState>(check.state), check.secondsToBreach);
+}
+
+void GeoFenceBreachMonitor::_setResult(BreachState breachState, double secondsToBreach)
+{
+    // Both values are updated before signalling so receivers always see a consistent result
+    bool stateChanged = breachState != _breachState;
+    _breachState = breachState;
+
+    // Time to breach is only signalled in whole tenths of a second, it changes with every position update
+    bool bothNaN = qIsNaN(secondsToBreach) && qIsNaN(_secondsToBreach);
+    bool secondsChanged = !bothNaN && (qIsNaN(secondsToBreach) != qIsNaN(_secondsToBreach) || qRound(secondsToBreach * 10) != qRound(_secondsToBreach * 10));
+    if (secondsChanged) {
+        _secondsToBreach = secondsToBreach;
+    }
+
+    if (stateChanged) {
+        qCDebug(GeoFenceBreachMonitorLog) << "Breach state changed vehicle:state:secondsToBreach" << _vehicle->id() << breachState << secondsToBreach;
+        emit breachStateChanged(_breachState);
+    }
+    if (secondsChanged) {
+        emit secondsToBreachChanged(_secondsToBreach);
+    }
+    if (stateChanged) {
+        _announce();
+    }
+}
+
+void GeoFenceBreachMonitor::_announce(void)
+{
+    if (_breachState == NoBreach) {
+        return;
+    }
+
+    // A predicted breach which turns into an actual one is always announced, any other state is held back if it was
+    // announced recently. This covers jitter between predicted and actual breach as well as plain repeats.
+    bool                    escalation  = _breachState == Breached && _announcedState == BreachPredicted;
+    const QElapsedTimer&    timer       = _announcedTimers[_breachState];
+    if (!escalation && timer.isValid() && timer.elapsed() < _announceRepeatMSecs) {
+        qCDebug(GeoFenceBreachMonitorLog) << "Holding back recently announced state vehicle:state" << _vehicle->id() << _breachState;
+        return;
+    }
+
+    _announcedState = _breachState;
+    _announcedTimers[_breachState].start();
+    emit breachAnnouncement(_breachState, _secondsToBreach);
+}
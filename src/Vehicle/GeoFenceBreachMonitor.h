@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+#include <QSharedPointer>
+#include <QWeakPointer>
+
+#include "GeoFenceIndex.h"
+#include "QGCLoggingCategory.h"
+
+Q_DECLARE_LOGGING_CATEGORY(GeoFenceBreachMonitorLog)
+
+class Vehicle;
+class QGCFencePolygon;
+class QGCFenceCircle;
+
+/// Ground station side geofence monitoring for a vehicle.
+///
+/// The fences which are on the vehicle are indexed with a GeoFenceIndex whenever they are loaded from or sent to the
+/// vehicle. Each position update is checked against them together with the velocity vector projected ahead by the
+/// FlyView geoFenceLookahead setting, so a breach is predicted before the vehicle reaches the fence. Vehicles which
+/// carry the same fences share one index.
+///
+/// breachAnnouncement is signalled when the breach state changes. A state which was already announced within the last
+/// few seconds is held back, so a vehicle flying along a fence line or jittering between a predicted and an actual breach
+/// is not announced constantly. Only going from an announced predicted breach to an actual breach skips the hold back.
+class GeoFenceBreachMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    GeoFenceBreachMonitor(Vehicle* vehicle, QObject* parent = nullptr);
+
+    enum BreachState {
+        NoBreach =          GeoFenceIndex::NoBreach,
+        BreachPredicted =   GeoFenceIndex::BreachPredicted,
+        Breached =          GeoFenceIndex::Breached,
+    };
+    Q_ENUM(BreachState)
+
+    Q_PROPERTY(BreachState  breachState     READ breachState        NOTIFY breachStateChanged)
+    Q_PROPERTY(double       secondsToBreach READ secondsToBreach    NOTIFY secondsToBreachChanged)  ///< NaN when no breach is predicted
+    Q_PROPERTY(int          fenceCount      READ fenceCount         NOTIFY fenceCountChanged)
+
+    BreachState breachState     (void) const { return _breachState; }
+    double      secondsToBreach (void) const { return _secondsToBreach; }
+    int         fenceCount      (void) const { return _index ? _index->fenceCount() : 0; }
+
+    /// Replaces the monitored fences
+    void setFences(const QList<QGCFencePolygon>& polygons, const QList<QGCFenceCircle>& circles);
+
+    /// @return Index for the specified fences, shared with any other monitor using the same fences
+    static QSharedPointer<const GeoFenceIndex> indexForFences(const QList<QGCFencePolygon>& polygons, const QList<QGCFenceCircle>& circles);
+
+signals:
+    void breachStateChanged     (BreachState breachState);
+    void secondsToBreachChanged (double secondsToBreach);
+    void fenceCountChanged      (int fenceCount);
+    void breachAnnouncement     (BreachState breachState, double secondsToBreach);
+
+private slots:
+    void _updateFencesFromVehicle   (void);
+    void _checkPosition             (void);
+    void _lookaheadChanged          (void);
+
+private:
+    void _setResult(BreachState breachState, double secondsToBreach);
+    void _announce (void);
+
+    Vehicle*                            _vehicle;
+    QSharedPointer<const GeoFenceIndex> _index;
+    BreachState                         _breachState;
+    double                              _secondsToBreach;
+    double                              _lookaheadSecs;
+    BreachState                         _announcedState;
+    QMap<BreachState, QElapsedTimer>    _announcedTimers;   ///< Time since each state was last announced
+
+    static QHash<QByteArray, QWeakPointer<const GeoFenceIndex>> _sharedIndices;
+
+    static const int _announceRepeatMSecs = 10000;
+
+    friend class GeoFenceBreachMonitorTest;
+};
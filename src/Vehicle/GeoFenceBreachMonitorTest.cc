@@ -0,0 +1,161 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "GeoFenceBreachMonitorTest.h"
+#include "GeoFenceBreachMonitor.h"
+#include "GeoFenceIndexTest.h"
+#include "GeoFenceManager.h"
+#include "QGCFencePolygon.h"
+#include "QGCFenceCircle.h"
+#include "QmlObjectListModel.h"
+#include "Vehicle.h"
+
+void GeoFenceBreachMonitorTest::_announcements(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+
+    // Stand alone monitor which only sees the results set below
+    GeoFenceBreachMonitor monitor(_vehicle);
+    disconnect(_vehicle, nullptr, &monitor, nullptr);
+
+    QSignalSpy spyAnnouncement(&monitor, &GeoFenceBreachMonitor::breachAnnouncement);
+
+    // Receivers of the state change must see the matching time to breach
+    double secondsAtStateChange = 0;
+    connect(&monitor, &GeoFenceBreachMonitor::breachStateChanged, this, [&]() { secondsAtStateChange = monitor.secondsToBreach(); });
+
+    monitor._setResult(GeoFenceBreachMonitor::BreachPredicted, 30.0);
+    QCOMPARE(secondsAtStateChange, 30.0);
+    QCOMPARE(spyAnnouncement.count(), 1);
+    QList<QVariant> arguments = spyAnnouncement.takeFirst();
+    QCOMPARE(arguments.at(0).value<GeoFenceBreachMonitor::BreachState>(), GeoFenceBreachMonitor::BreachPredicted);
+    QCOMPARE(arguments.at(1).toDouble(), 30.0);
+
+    // A worse state is announced right away
+    monitor._setResult(GeoFenceBreachMonitor::Breached, 0.0);
+    QCOMPARE(spyAnnouncement.count(), 1);
+    QCOMPARE(spyAnnouncement.takeFirst().at(0).value<GeoFenceBreachMonitor::BreachState>(), GeoFenceBreachMonitor::Breached);
+
+    // Leaving the breach is not announced, nor is going straight back into it
+    monitor._setResult(GeoFenceBreachMonitor::NoBreach, qQNaN());
+    QVERIFY(qIsNaN(secondsAtStateChange));
+    monitor._setResult(GeoFenceBreachMonitor::Breached, 0.0);
+    QCOMPARE(spyAnnouncement.count(), 0);
+
+    // Jitter between predicted and actual breach is held back in both directions
+    monitor._setResult(GeoFenceBreachMonitor::BreachPredicted, 20.0);
+    monitor._setResult(GeoFenceBreachMonitor::Breached, 0.0);
+    monitor._setResult(GeoFenceBreachMonitor::BreachPredicted, 20.0);
+    QCOMPARE(spyAnnouncement.count(), 0);
+
+    // Repeats are announced again once the repeat interval is over
+    monitor._announcedTimers[GeoFenceBreachMonitor::BreachPredicted].invalidate();
+    monitor._setResult(GeoFenceBreachMonitor::NoBreach, qQNaN());
+    monitor._setResult(GeoFenceBreachMonitor::BreachPredicted, 15.0);
+    QCOMPARE(spyAnnouncement.count(), 1);
+    QCOMPARE(spyAnnouncement.takeFirst().at(1).toDouble(), 15.0);
+
+    // Escalating from the announced prediction to a breach skips the hold back
+    monitor._setResult(GeoFenceBreachMonitor::Breached, 0.0);
+    QCOMPARE(spyAnnouncement.count(), 1);
+    QCOMPARE(spyAnnouncement.takeFirst().at(0).value<GeoFenceBreachMonitor::BreachState>(), GeoFenceBreachMonitor::Breached);
+
+    // After which the jitter is held back again
+    monitor._setResult(GeoFenceBreachMonitor::BreachPredicted, 10.0);
+    monitor._setResult(GeoFenceBreachMonitor::Breached, 0.0);
+    QCOMPARE(spyAnnouncement.count(), 0);
+
+    _disconnectMockLink();
+}
+
+void GeoFenceBreachMonitorTest::_fences(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    QTRY_VERIFY_WITH_TIMEOUT(_vehicle->coordinate().isValid(), 10000);
+
+    GeoFenceBreachMonitor   monitor(_vehicle);
+    QSignalSpy              spyAnnouncement(&monitor, &GeoFenceBreachMonitor::breachAnnouncement);
+    QGeoCoordinate          vehicleCoord = _vehicle->coordinate();
+    QList<QGCFencePolygon>  polygons;
+    QList<QGCFenceCircle>   circles;
+
+    // Inside an inclusion fence
+    circles.append(QGCFenceCircle(vehicleCoord, 500, true /* inclusion */));
+    monitor.setFences(polygons, circles);
+    QCOMPARE(monitor.fenceCount(), 1);
+    QCOMPARE(monitor.breachState(), GeoFenceBreachMonitor::NoBreach);
+    QCOMPARE(spyAnnouncement.count(), 0);
+
+    // Inside an exclusion fence
+    circles.clear();
+    circles.append(QGCFenceCircle(vehicleCoord, 500, false /* inclusion */));
+    monitor.setFences(polygons, circles);
+    QCOMPARE(monitor.fenceCount(), 1);
+    QCOMPARE(monitor.breachState(), GeoFenceBreachMonitor::Breached);
+    QCOMPARE(spyAnnouncement.count(), 1);
+
+    circles.clear();
+    monitor.setFences(polygons, circles);
+    QCOMPARE(monitor.fenceCount(), 0);
+    QCOMPARE(monitor.breachState(), GeoFenceBreachMonitor::NoBreach);
+
+    _disconnectMockLink();
+}
+
+void GeoFenceBreachMonitorTest::_sharedIndex(void)
+{
+    QList<QGCFencePolygon>  polygons;
+    QList<QGCFenceCircle>   circles;
+
+    QVERIFY(!GeoFenceBreachMonitor::indexForFences(polygons, circles));
+
+    QGCFencePolygon polygon(true /* inclusion */);
+    polygon.appendVertices(GeoFenceIndexTest::squarePolygon(GeoFenceIndexTest::origin, 500));
+    polygons.append(polygon);
+    circles.append(QGCFenceCircle(GeoFenceIndexTest::origin, 100, false /* inclusion */));
+
+    QSharedPointer<const GeoFenceIndex> index = GeoFenceBreachMonitor::indexForFences(polygons, circles);
+    QVERIFY(index);
+    QCOMPARE(index->fenceCount(), 2);
+    QCOMPARE(GeoFenceBreachMonitor::indexForFences(polygons, circles), index);
+
+    // Any change to the fences gives a different index
+    circles.clear();
+    circles.append(QGCFenceCircle(GeoFenceIndexTest::origin, 200, false /* inclusion */));
+    QSharedPointer<const GeoFenceIndex> otherIndex = GeoFenceBreachMonitor::indexForFences(polygons, circles);
+    QVERIFY(otherIndex);
+    QVERIFY(otherIndex != index);
+
+    circles.clear();
+    circles.append(QGCFenceCircle(GeoFenceIndexTest::origin, 100, true /* inclusion */));
+    QVERIFY(GeoFenceBreachMonitor::indexForFences(polygons, circles) != index);
+}
+
+void GeoFenceBreachMonitorTest::_vehicleWiring(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    QTRY_VERIFY_WITH_TIMEOUT(_vehicle->coordinate().isValid(), 10000);
+
+    GeoFenceBreachMonitor*  monitor = _vehicle->geoFenceBreachMonitor();
+    QSignalSpy              spyFenceCount(monitor, &GeoFenceBreachMonitor::fenceCountChanged);
+    QmlObjectListModel      polygonsModel;
+    QmlObjectListModel      circlesModel;
+
+    QGCFencePolygon* polygon = new QGCFencePolygon(true /* inclusion */, &polygonsModel);
+    polygon->appendVertices(GeoFenceIndexTest::squarePolygon(_vehicle->coordinate(), 500));
+    polygonsModel.append(polygon);
+
+    // Fences sent to the vehicle are monitored once the send completes
+    _vehicle->geoFenceManager()->sendToVehicle(QGeoCoordinate(), polygonsModel, circlesModel);
+    QVERIFY(spyFenceCount.wait(10000));
+    QCOMPARE(monitor->fenceCount(), 1);
+    QCOMPARE(monitor->breachState(), GeoFenceBreachMonitor::NoBreach);
+
+    _disconnectMockLink();
+}
@@ -0,0 +1,24 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Checks GeoFenceBreachMonitor announcements, fence updates and the index shared between vehicles
+class GeoFenceBreachMonitorTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _announcements (void);
+    void _fences        (void);
+    void _sharedIndex   (void);
+    void _vehicleWiring (void);
+};
@@ -35,6 +35,7 @@ MultiVehicleManager::MultiVehicleManager(QGCApplication* app, QGCToolbox* toolbo
     , _parameterReadyVehicleAvailable(false)
     , _activeVehicle(nullptr)
     , _offlineEditingVehicle(nullptr)
+    , _observerVehicles(this)
     , _firmwarePluginManager(nullptr)
     , _joystickManager(nullptr)
     , _mavlinkProtocol(nullptr)
@@ -64,8 +65,12 @@ void MultiVehicleManager::setToolbox(QGCToolbox *toolbox)
     qmlRegisterUncreatableType<MultiVehicleManager>("QGroundControl.MultiVehicleManager", 1, 0, "MultiVehicleManager", "Reference only");
 
     connect(_mavlinkProtocol, &MAVLinkProtocol::vehicleHeartbeatInfo, this, &MultiVehicleManager::_vehicleHeartbeatInfo);
+    connect(_mavlinkProtocol, &MAVLinkProtocol::messageReceived, &_observerVehicles, &ObserverVehicleTable::handleMessage);
+    connect(_toolbox->linkManager(), &LinkManager::linkDeleted, &_observerVehicles, &ObserverVehicleTable::removeVehiclesOnLink);
 
     SettingsManager* settingsManager = toolbox->settingsManager();
+    connect(settingsManager->appSettings()->maxManagedVehicles(), &Fact::rawValueChanged, this, &MultiVehicleManager::_promoteObserverVehicles);
+
     _offlineEditingVehicle = new Vehicle(static_cast<MAV_AUTOPILOT>(settingsManager->appSettings()->offlineEditingFirmwareType()->rawValue().toInt()),
                                          static_cast<MAV_TYPE>(settingsManager->appSettings()->offlineEditingVehicleType()->rawValue().toInt()),
                                          _firmwarePluginManager,
@@ -99,7 +104,7 @@ void MultiVehicleManager::_vehicleHeartbeatInfo(LinkInterface* link, int vehicle
     if (_vehicles.count() > 0 && !qgcApp()->toolbox()->corePlugin()->options()->multiVehicleEnabled()) {
         return;
     }
-    if (_ignoreVehicleIds.contains(vehicleId) || getVehicleById(vehicleId) || vehicleId == 0) {
+    if (_ignoreVehicleIds.contains(vehicleId) || _observerVehicles.contains(vehicleId) || getVehicleById(vehicleId) || vehicleId == 0) {
         return;
     }
 
@@ -126,6 +131,18 @@ void MultiVehicleManager::_vehicleHeartbeatInfo(LinkInterface* link, int vehicle
         _app->showMessage(tr("Warning: A vehicle is using the same system id as %1: %2").arg(qgcApp()->applicationName()).arg(vehicleId));
     }
 
+    if (_vehicles.count() >= _maxManagedVehicles()) {
+        // Only keep track of core telemetry until the user selects the vehicle
+        qCDebug(MultiVehicleManagerLog()) << "Managed vehicle limit reached, observing vehicleId" << vehicleId;
+        _observerVehicles.addVehicle({ link, vehicleId, componentId, vehicleFirmwareType, vehicleType });
+        return;
+    }
+
+    _createVehicle(link, vehicleId, componentId, vehicleFirmwareType, vehicleType);
+}
+
+Vehicle* MultiVehicleManager::_createVehicle(LinkInterface* link, int vehicleId, int componentId, int vehicleFirmwareType, int vehicleType)
+{
     Vehicle* vehicle = new Vehicle(link, vehicleId, componentId, (MAV_AUTOPILOT)vehicleFirmwareType, (MAV_TYPE)vehicleType, _firmwarePluginManager, _joystickManager);
     connect(vehicle, &Vehicle::allLinksInactive, this, &MultiVehicleManager::_deleteVehiclePhase1);
     connect(vehicle, &Vehicle::requestProtocolVersion, this, &MultiVehicleManager::_requestProtocolVersion);
@@ -154,6 +171,40 @@ void MultiVehicleManager::_vehicleHeartbeatInfo(LinkInterface* link, int vehicle
     }
 #endif
 
+    return vehicle;
+}
+
+int MultiVehicleManager::_maxManagedVehicles(void) const
+{
+    return _toolbox->settingsManager()->appSettings()->maxManagedVehicles()->rawValue().toInt();
+}
+
+Vehicle* MultiVehicleManager::promoteObserverVehicle(int vehicleId)
+{
+    ObserverVehicleTable::Identity identity = _observerVehicles.takeVehicle(vehicleId);
+
+    if (identity.vehicleId == 0) {
+        qCWarning(MultiVehicleManagerLog) << "promoteObserverVehicle: vehicle is not being observed" << vehicleId;
+        return nullptr;
+    }
+
+    qCDebug(MultiVehicleManagerLog) << "promoteObserverVehicle" << vehicleId;
+
+    Vehicle* vehicle = _createVehicle(identity.link, identity.vehicleId, identity.componentId, identity.firmwareType, identity.vehicleType);
+    setActiveVehicle(vehicle);
+
+    return vehicle;
+}
+
+/// Promotes observed vehicles, longest observed first, while there is room below the managed vehicle limit
+void MultiVehicleManager::_promoteObserverVehicles(void)
+{
+    while (_observerVehicles.count() && _vehicles.count() < _maxManagedVehicles()) {
+        ObserverVehicleTable::Identity identity = _observerVehicles.takeVehicle(_observerVehicles.firstVehicleId());
+
+        qCDebug(MultiVehicleManagerLog) << "Managed vehicle available, promoting vehicleId" << identity.vehicleId;
+        _createVehicle(identity.link, identity.vehicleId, identity.componentId, identity.firmwareType, identity.vehicleType);
+    }
 }
 
 /// This slot is connected to the Vehicle::requestProtocolVersion signal such that the vehicle manager
@@ -254,6 +305,8 @@ void MultiVehicleManager::_deleteVehiclePhase2(void)
 
     delete _vehiclesBeingDeleted[0];
     _vehiclesBeingDeleted.removeAt(0);
+
+    _promoteObserverVehicles();
 }
 
 void MultiVehicleManager::setActiveVehicle(Vehicle* vehicle)
@@ -400,6 +453,10 @@ void MultiVehicleManager::_sendGCSHeartbeat(void)
 
 bool MultiVehicleManager::linkInUse(LinkInterface* link, Vehicle* skipVehicle)
 {
+    if (_observerVehicles.containsLink(link)) {
+        return true;
+    }
+
     for (int i=0; i< _vehicles.count(); i++) {
         Vehicle* vehicle = qobject_cast<Vehicle*>(_vehicles[i]);
 
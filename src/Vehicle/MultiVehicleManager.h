@@ -15,6 +15,7 @@
 #define MultiVehicleManager_H
 
 #include "Vehicle.h"
+#include "ObserverVehicleTable.h"
 #include "QGCMAVLink.h"
 #include "QmlObjectListModel.h"
 #include "QGCToolbox.h"
@@ -44,6 +45,8 @@ public:
     Q_PROPERTY(Vehicle*             activeVehicle                   READ activeVehicle                  WRITE setActiveVehicle          NOTIFY activeVehicleChanged)
     /// The list of all connected vehicles
     Q_PROPERTY(QmlObjectListModel*  vehicles                        READ vehicles                                                       CONSTANT)
+    /// Vehicles beyond AppSettings::maxManagedVehicles, only core telemetry is available for these
+    Q_PROPERTY(ObserverVehicleTable* observerVehicles               READ observerVehicles                                               CONSTANT)
     /// Enable sending heartbeats to the vehicle (defaults to true)
     Q_PROPERTY(bool                 gcsHeartBeatEnabled             READ gcsHeartbeatEnabled            WRITE setGcsHeartbeatEnabled    NOTIFY gcsHeartBeatEnabledChanged)
     /// A disconnected vehicle used for offline editing. It will match the vehicle type specified in Settings.
@@ -55,6 +58,11 @@ public:
 
     Q_INVOKABLE Vehicle* getVehicleById(int vehicleId);
 
+    /// Creates a full Vehicle for an observed vehicle and makes it the active vehicle. This is allowed to go over the
+    /// maxManagedVehicles limit, the limit only applies to vehicles which are added automatically.
+    ///     @return The new Vehicle, nullptr if the vehicle is not being observed
+    Q_INVOKABLE Vehicle* promoteObserverVehicle(int vehicleId);
+
     UAS* activeUas(void) { return _activeVehicle ? _activeVehicle->uas() : nullptr; }
 
     // Property accessors
@@ -68,6 +76,8 @@ public:
 
     QmlObjectListModel* vehicles(void) { return &_vehicles; }
 
+    ObserverVehicleTable* observerVehicles(void) { return &_observerVehicles; }
+
     bool gcsHeartbeatEnabled(void) const { return _gcsHeartbeatEnabled; }
     void setGcsHeartbeatEnabled(bool gcsHeartBeatEnabled);
 
@@ -105,9 +115,12 @@ private slots:
     void _vehicleHeartbeatInfo          (LinkInterface* link, int vehicleId, int componentId, int vehicleFirmwareType, int vehicleType);
     void _requestProtocolVersion        (unsigned version);
     void _coordinateChanged             (QGeoCoordinate coordinate);
+    void _promoteObserverVehicles       (void);
 
 private:
-    bool _vehicleExists(int vehicleId);
+    bool        _vehicleExists      (int vehicleId);
+    Vehicle*    _createVehicle      (LinkInterface* link, int vehicleId, int componentId, int vehicleFirmwareType, int vehicleType);
+    int         _maxManagedVehicles (void) const;
 
     bool        _activeVehicleAvailable;            ///< true: An active vehicle is available
     bool        _parameterReadyVehicleAvailable;    ///< true: An active vehicle with ready parameters is available
@@ -119,7 +132,8 @@ private:
 
     QList<int>  _ignoreVehicleIds;          ///< List of vehicle id for which we ignore further communication
 
-    QmlObjectListModel  _vehicles;
+    QmlObjectListModel      _vehicles;
+    ObserverVehicleTable    _observerVehicles;
 
     FirmwarePluginManager*      _firmwarePluginManager;
     JoystickManager*            _joystickManager;
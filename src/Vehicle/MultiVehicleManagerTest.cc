@@ -0,0 +1,133 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MultiVehicleManagerTest.h"
+#include "MultiVehicleManager.h"
+#include "MAVLinkProtocol.h"
+#include "MockLink.h"
+#include "QGCApplication.h"
+#include "SettingsManager.h"
+
+void MultiVehicleManagerTest::cleanup(void)
+{
+    Fact* maxManagedVehicles = qgcApp()->toolbox()->settingsManager()->appSettings()->maxManagedVehicles();
+    maxManagedVehicles->setRawValue(maxManagedVehicles->rawDefaultValue());
+
+    UnitTest::cleanup();
+}
+
+/// Heartbeat from another vehicle on the mock link
+void MultiVehicleManagerTest::_heartbeat(int vehicleId)
+{
+    emit qgcApp()->toolbox()->mavlinkProtocol()->vehicleHeartbeatInfo(_mockLink, vehicleId, MAV_COMP_ID_AUTOPILOT1, MAV_AUTOPILOT_PX4, MAV_TYPE_QUADROTOR);
+}
+
+void MultiVehicleManagerTest::_setMaxManagedVehicles(int maxManagedVehicles)
+{
+    qgcApp()->toolbox()->settingsManager()->appSettings()->maxManagedVehicles()->setRawValue(maxManagedVehicles);
+}
+
+void MultiVehicleManagerTest::_managedVehicleLimit(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    _setMaxManagedVehicles(1);
+
+    MultiVehicleManager*    vehicleMgr          = qgcApp()->toolbox()->multiVehicleManager();
+    ObserverVehicleTable*   observerVehicles    = vehicleMgr->observerVehicles();
+
+    // Vehicles beyond the limit are only observed, once
+    _heartbeat(42);
+    _heartbeat(42);
+    QCOMPARE(vehicleMgr->vehicles()->count(), 1);
+    QCOMPARE(observerVehicles->count(), 1);
+    QVERIFY(observerVehicles->contains(42));
+    QVERIFY(!vehicleMgr->getVehicleById(42));
+
+    // Selecting an observed vehicle goes over the limit
+    Vehicle* vehicle = vehicleMgr->promoteObserverVehicle(42);
+    QVERIFY(vehicle);
+    QCOMPARE(vehicle->id(), 42);
+    QCOMPARE(vehicleMgr->activeVehicle(), vehicle);
+    QCOMPARE(vehicleMgr->vehicles()->count(), 2);
+    QCOMPARE(observerVehicles->count(), 0);
+
+    QVERIFY(!vehicleMgr->promoteObserverVehicle(43));
+
+    _disconnectMockLink();
+}
+
+void MultiVehicleManagerTest::_promoteOnLimitRaised(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    _setMaxManagedVehicles(1);
+
+    MultiVehicleManager*    vehicleMgr          = qgcApp()->toolbox()->multiVehicleManager();
+    ObserverVehicleTable*   observerVehicles    = vehicleMgr->observerVehicles();
+
+    _heartbeat(42);
+    _heartbeat(43);
+    QCOMPARE(observerVehicles->count(), 2);
+
+    // Longest observed vehicle goes first
+    _setMaxManagedVehicles(2);
+    QCOMPARE(vehicleMgr->vehicles()->count(), 2);
+    QVERIFY(vehicleMgr->getVehicleById(42));
+    QCOMPARE(observerVehicles->count(), 1);
+    QVERIFY(observerVehicles->contains(43));
+
+    _setMaxManagedVehicles(3);
+    QCOMPARE(vehicleMgr->vehicles()->count(), 3);
+    QVERIFY(vehicleMgr->getVehicleById(43));
+    QCOMPARE(observerVehicles->count(), 0);
+
+    _disconnectMockLink();
+}
+
+void MultiVehicleManagerTest::_promoteOnVehicleDeleted(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    _setMaxManagedVehicles(1);
+
+    MultiVehicleManager*    vehicleMgr          = qgcApp()->toolbox()->multiVehicleManager();
+    ObserverVehicleTable*   observerVehicles    = vehicleMgr->observerVehicles();
+
+    _heartbeat(42);
+    _heartbeat(43);
+    _setMaxManagedVehicles(2);
+    Vehicle* vehicle = vehicleMgr->getVehicleById(42);
+    QVERIFY(vehicle);
+
+    // The managed vehicle which goes away makes room for the remaining observed vehicle
+    emit vehicle->allLinksInactive(vehicle);
+    QTRY_VERIFY_WITH_TIMEOUT(vehicleMgr->getVehicleById(43), 1000);
+    QVERIFY(!vehicleMgr->getVehicleById(42));
+    QCOMPARE(vehicleMgr->vehicles()->count(), 2);
+    QCOMPARE(observerVehicles->count(), 0);
+
+    _disconnectMockLink();
+}
+
+void MultiVehicleManagerTest::_linkInUse(void)
+{
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    _setMaxManagedVehicles(1);
+
+    MultiVehicleManager* vehicleMgr = qgcApp()->toolbox()->multiVehicleManager();
+
+    QVERIFY(!vehicleMgr->linkInUse(_mockLink, _vehicle));
+
+    // A link stays in use while vehicles are observed on it
+    _heartbeat(42);
+    QVERIFY(vehicleMgr->linkInUse(_mockLink, _vehicle));
+
+    vehicleMgr->observerVehicles()->removeVehiclesOnLink(_mockLink);
+    QVERIFY(!vehicleMgr->linkInUse(_mockLink, _vehicle));
+
+    _disconnectMockLink();
+}
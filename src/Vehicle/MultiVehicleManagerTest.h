@@ -0,0 +1,30 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Checks that vehicles beyond the managed vehicle limit are observed, and when they are promoted to full Vehicles
+class MultiVehicleManagerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void cleanup(void);
+
+    void _managedVehicleLimit       (void);
+    void _promoteOnLimitRaised      (void);
+    void _promoteOnVehicleDeleted   (void);
+    void _linkInUse                 (void);
+
+private:
+    void _heartbeat             (int vehicleId);
+    void _setMaxManagedVehicles (int maxManagedVehicles);
+};
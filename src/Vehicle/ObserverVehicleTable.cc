@@ -0,0 +1,318 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ObserverVehicleTable.h"
+#include "QGCApplication.h"
+#include "FirmwarePluginManager.h"
+#include "FirmwarePlugin.h"
+
+#include <QtMath>
+
+QGC_LOGGING_CATEGORY(ObserverVehicleTableLog, "ObserverVehicleTableLog")
+
+const int ObserverVehicleTable::_vehicleIdRole =        Qt::UserRole;
+const int ObserverVehicleTable::_coordinateRole =       Qt::UserRole + 1;
+const int ObserverVehicleTable::_altitudeRole =         Qt::UserRole + 2;
+const int ObserverVehicleTable::_headingRole =          Qt::UserRole + 3;
+const int ObserverVehicleTable::_armedRole =            Qt::UserRole + 4;
+const int ObserverVehicleTable::_flightModeRole =       Qt::UserRole + 5;
+const int ObserverVehicleTable::_batteryRemainingRole = Qt::UserRole + 6;
+
+ObserverVehicleTable::ObserverVehicleTable(QObject* parent)
+    : QAbstractListModel(parent)
+    , _rowForId         (256, -1)
+    , _firstChangedRow  (-1)
+    , _lastChangedRow   (-1)
+{
+    _clock.start();
+
+    _flushTimer.setSingleShot(true);
+    _flushTimer.setInterval(_flushIntervalMSecs);
+    connect(&_flushTimer, &QTimer::timeout, this, &ObserverVehicleTable::_flushChangedRows);
+
+    _timeoutTimer.setInterval(_timeoutCheckIntervalMSecs);
+    connect(&_timeoutTimer, &QTimer::timeout, this, &ObserverVehicleTable::_checkHeartbeatTimeouts);
+}
+
+void ObserverVehicleTable::addVehicle(const Identity& identity)
+{
+    if (identity.vehicleId <= 0 || identity.vehicleId >= _rowForId.count() || contains(identity.vehicleId)) {
+        return;
+    }
+
+    qCDebug(ObserverVehicleTableLog) << "addVehicle vehicleId:componentId" << identity.vehicleId << identity.componentId;
+
+    int row = count();
+
+    beginInsertRows(QModelIndex(), row, row);
+    _vehicleIds.append(static_cast<quint8>(identity.vehicleId));
+    _componentIds.append(static_cast<quint8>(identity.componentId));
+    _firmwareTypes.append(static_cast<quint8>(identity.firmwareType));
+    _vehicleTypes.append(static_cast<quint8>(identity.vehicleType));
+    _links.append(identity.link);
+    _latitudes.append(0);
+    _longitudes.append(0);
+    _altitudes.append(qQNaN());
+    _headings.append(qQNaN());
+    _groundSpeeds.append(qQNaN());
+    _baseModes.append(0);
+    _customModes.append(0);
+    _batteryRemaining.append(-1);
+    _lastHeartbeatMSecs.append(_clock.elapsed());
+    _rowForId[identity.vehicleId] = row;
+    endInsertRows();
+
+    if (!_timeoutTimer.isActive()) {
+        _timeoutTimer.start();
+    }
+
+    emit countChanged(count());
+}
+
+ObserverVehicleTable::Identity ObserverVehicleTable::takeVehicle(int vehicleId)
+{
+    Identity    identity = { nullptr, 0, 0, 0, 0 };
+    int         row = _rowForVehicleId(vehicleId);
+
+    if (row != -1) {
+        identity.link =         _links[row];
+        identity.vehicleId =    _vehicleIds[row];
+        identity.componentId =  _componentIds[row];
+        identity.firmwareType = _firmwareTypes[row];
+        identity.vehicleType =  _vehicleTypes[row];
+        _removeRow(row);
+    }
+
+    return identity;
+}
+
+void ObserverVehicleTable::removeVehiclesOnLink(LinkInterface* link)
+{
+    for (int row=count()-1; row>=0; row--) {
+        if (_links[row] == link) {
+            qCDebug(ObserverVehicleTableLog) << "Removing vehicle on deleted link vehicleId" << _vehicleIds[row];
+            _removeRow(row);
+        }
+    }
+}
+
+void ObserverVehicleTable::removeStaleVehicles(int timeoutMSecs)
+{
+    qint64 nowMSecs = _clock.elapsed();
+
+    for (int row=count()-1; row>=0; row--) {
+        if (nowMSecs - _lastHeartbeatMSecs[row] > timeoutMSecs) {
+            qCDebug(ObserverVehicleTableLog) << "Heartbeat timeout vehicleId" << _vehicleIds[row];
+            _removeRow(row);
+        }
+    }
+}
+
+void ObserverVehicleTable::_checkHeartbeatTimeouts(void)
+{
+    removeStaleVehicles(_heartbeatTimeoutMSecs);
+}
+
+void ObserverVehicleTable::_removeRow(int row)
+{
+    beginRemoveRows(QModelIndex(), row, row);
+    _rowForId[_vehicleIds[row]] = -1;
+    _vehicleIds.remove(row);
+    _componentIds.remove(row);
+    _firmwareTypes.remove(row);
+    _vehicleTypes.remove(row);
+    _links.remove(row);
+    _latitudes.remove(row);
+    _longitudes.remove(row);
+    _altitudes.remove(row);
+    _headings.remove(row);
+    _groundSpeeds.remove(row);
+    _baseModes.remove(row);
+    _customModes.remove(row);
+    _batteryRemaining.remove(row);
+    _lastHeartbeatMSecs.remove(row);
+    for (int i=row; i<count(); i++) {
+        _rowForId[_vehicleIds[i]] = i;
+    }
+    endRemoveRows();
+
+    // Pending changes are flushed for the whole remaining range, the row numbers have moved
+    if (_firstChangedRow != -1) {
+        _firstChangedRow = 0;
+        _lastChangedRow = count() - 1;
+        if (_lastChangedRow < 0) {
+            _firstChangedRow = _lastChangedRow = -1;
+        }
+    }
+
+    if (count() == 0) {
+        _timeoutTimer.stop();
+    }
+
+    emit countChanged(count());
+}
+
+void ObserverVehicleTable::handleMessage(LinkInterface* link, mavlink_message_t message)
+{
+    Q_UNUSED(link);
+
+    int row = _rowForVehicleId(message.sysid);
+    if (row == -1) {
+        return;
+    }
+
+    switch (message.msgid) {
+    case MAVLINK_MSG_ID_HEARTBEAT:
+        _handleHeartbeat(row, message);
+        break;
+    case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+        _handleGlobalPositionInt(row, message);
+        break;
+    case MAVLINK_MSG_ID_SYS_STATUS:
+        _handleSysStatus(row, message);
+        break;
+    default:
+        break;
+    }
+}
+
+void ObserverVehicleTable::_handleHeartbeat(int row, const mavlink_message_t& message)
+{
+    if (message.compid != _componentIds[row]) {
+        return;
+    }
+
+    _lastHeartbeatMSecs[row] = _clock.elapsed();
+
+    quint8  baseMode =      mavlink_msg_heartbeat_get_base_mode(&message);
+    quint32 customMode =    mavlink_msg_heartbeat_get_custom_mode(&message);
+    if (baseMode != _baseModes[row] || customMode != _customModes[row]) {
+        _baseModes[row] = baseMode;
+        _customModes[row] = customMode;
+        _rowChanged(row);
+    }
+}
+
+void ObserverVehicleTable::_handleGlobalPositionInt(int row, const mavlink_message_t& message)
+{
+    mavlink_global_position_int_t globalPositionInt;
+    mavlink_msg_global_position_int_decode(&message, &globalPositionInt);
+
+    // ArduPilot sends GLOBAL_POSITION_INT with lat/lon 0/0 when it has no gps signal, see Vehicle::_handleGlobalPositionInt
+    if (globalPositionInt.lat == 0 && globalPositionInt.lon == 0) {
+        return;
+    }
+
+    _latitudes[row] =       globalPositionInt.lat;
+    _longitudes[row] =      globalPositionInt.lon;
+    _altitudes[row] =       globalPositionInt.alt / 1000.0f;
+    _headings[row] =        globalPositionInt.hdg == UINT16_MAX ? qQNaN() : globalPositionInt.hdg / 100.0f;
+    _groundSpeeds[row] =    qSqrt(qreal(globalPositionInt.vx) * globalPositionInt.vx + qreal(globalPositionInt.vy) * globalPositionInt.vy) / 100.0;
+    _rowChanged(row);
+}
+
+void ObserverVehicleTable::_handleSysStatus(int row, const mavlink_message_t& message)
+{
+    qint8 batteryRemaining = mavlink_msg_sys_status_get_battery_remaining(&message);
+
+    if (batteryRemaining != _batteryRemaining[row]) {
+        _batteryRemaining[row] = batteryRemaining;
+        _rowChanged(row);
+    }
+}
+
+void ObserverVehicleTable::_rowChanged(int row)
+{
+    if (_firstChangedRow == -1) {
+        _firstChangedRow = _lastChangedRow = row;
+    } else {
+        _firstChangedRow = qMin(_firstChangedRow, row);
+        _lastChangedRow = qMax(_lastChangedRow, row);
+    }
+    if (!_flushTimer.isActive()) {
+        _flushTimer.start();
+    }
+}
+
+void ObserverVehicleTable::_flushChangedRows(void)
+{
+    if (_firstChangedRow != -1) {
+        emit dataChanged(index(_firstChangedRow), index(_lastChangedRow));
+        _firstChangedRow = _lastChangedRow = -1;
+    }
+}
+
+QGeoCoordinate ObserverVehicleTable::coordinate(int row) const
+{
+    if (_latitudes[row] == 0 && _longitudes[row] == 0) {
+        return QGeoCoordinate();
+    }
+    return QGeoCoordinate(_latitudes[row] * 1e-7, _longitudes[row] * 1e-7, static_cast<double>(_altitudes[row]));
+}
+
+QString ObserverVehicleTable::flightMode(int row) const
+{
+    if (_baseModes[row] == 0 && _customModes[row] == 0) {
+        // No heartbeat decoded yet
+        return QString();
+    }
+
+    FirmwarePlugin* firmwarePlugin = qgcApp()->toolbox()->firmwarePluginManager()->firmwarePluginForAutopilot(static_cast<MAV_AUTOPILOT>(_firmwareTypes[row]),
+                                                                                                              static_cast<MAV_TYPE>(_vehicleTypes[row]));
+    return firmwarePlugin->flightMode(_baseModes[row], _customModes[row]);
+}
+
+int ObserverVehicleTable::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+
+    return count();
+}
+
+QVariant ObserverVehicleTable::data(const QModelIndex& index, int role) const
+{
+    int row = index.row();
+
+    if (!index.isValid() || row < 0 || row >= count()) {
+        return QVariant();
+    }
+
+    if (role == _vehicleIdRole) {
+        return vehicleId(row);
+    } else if (role == _coordinateRole) {
+        return QVariant::fromValue(coordinate(row));
+    } else if (role == _altitudeRole) {
+        return static_cast<double>(_altitudes[row]);
+    } else if (role == _headingRole) {
+        return heading(row);
+    } else if (role == _armedRole) {
+        return armed(row);
+    } else if (role == _flightModeRole) {
+        return flightMode(row);
+    } else if (role == _batteryRemainingRole) {
+        return batteryRemaining(row);
+    } else {
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> ObserverVehicleTable::roleNames(void) const
+{
+    QHash<int, QByteArray> hash;
+
+    hash[_vehicleIdRole] =          "vehicleId";
+    hash[_coordinateRole] =         "coordinate";
+    hash[_altitudeRole] =           "altitude";
+    hash[_headingRole] =            "heading";
+    hash[_armedRole] =              "armed";
+    hash[_flightModeRole] =         "flightMode";
+    hash[_batteryRemainingRole] =   "batteryRemaining";
+
+    return hash;
+}
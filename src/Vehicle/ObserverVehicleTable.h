@@ -0,0 +1,137 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "QGCMAVLink.h"
+#include "QGCLoggingCategory.h"
+
+#include <QAbstractListModel>
+#include <QElapsedTimer>
+#include <QGeoCoordinate>
+#include <QTimer>
+#include <QVector>
+
+class LinkInterface;
+
+Q_DECLARE_LOGGING_CATEGORY(ObserverVehicleTableLog)
+
+/// Vehicles which are heard on a link but are not managed through a full Vehicle.
+///
+/// Only core telemetry is decoded: HEARTBEAT, GLOBAL_POSITION_INT and SYS_STATUS. State is held in a structure of arrays
+/// with one row per vehicle, found through a lookup table indexed by MAVLink system id, so a message for a vehicle which
+/// is not in the table costs a single array read. Changed rows are signalled to QML in batches on a timer.
+///
+/// Vehicles are removed once their heartbeat times out. MultiVehicleManager takes a vehicle out of the table when it is
+/// promoted to a full Vehicle.
+class ObserverVehicleTable : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    ObserverVehicleTable(QObject* parent = nullptr);
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+    /// What is needed to create a full Vehicle for an observed vehicle
+    struct Identity {
+        LinkInterface*  link;
+        int             vehicleId;
+        int             componentId;
+        int             firmwareType;
+        int             vehicleType;
+    };
+
+    int count(void) const { return _vehicleIds.count(); }
+
+    bool    contains        (int vehicleId) const { return _rowForVehicleId(vehicleId) != -1; }
+    bool    containsLink    (LinkInterface* link) const { return _links.contains(link); }
+
+    /// Adds a vehicle to the table, does nothing if the vehicle is already in the table
+    void addVehicle(const Identity& identity);
+
+    /// Removes a vehicle from the table
+    ///     @return Identity of the removed vehicle, vehicleId is 0 if the vehicle was not in the table
+    Identity takeVehicle(int vehicleId);
+
+    /// @return Id of the vehicle which has been in the table the longest, 0 if the table is empty
+    int firstVehicleId(void) const { return _vehicleIds.isEmpty() ? 0 : _vehicleIds[0]; }
+
+    /// Removes all vehicles whose last heartbeat is older than the timeout
+    void removeStaleVehicles(int timeoutMSecs);
+
+    // Row accessors
+    int             vehicleId           (int row) const { return _vehicleIds[row]; }
+    QGeoCoordinate  coordinate          (int row) const;
+    double          heading             (int row) const { return _headings[row]; }     ///< NaN if not known
+    double          groundSpeed         (int row) const { return _groundSpeeds[row]; } ///< NaN if not known
+    bool            armed               (int row) const { return _baseModes[row] & MAV_MODE_FLAG_SAFETY_ARMED; }
+    int             batteryRemaining    (int row) const { return _batteryRemaining[row]; } ///< -1 if not known
+    QString         flightMode          (int row) const;
+
+public slots:
+    void handleMessage          (LinkInterface* link, mavlink_message_t message);
+    void removeVehiclesOnLink   (LinkInterface* link);
+
+signals:
+    void countChanged(int count);
+
+private slots:
+    void _flushChangedRows      (void);
+    void _checkHeartbeatTimeouts(void);
+
+private:
+    // Overrides from QAbstractListModel
+    int                     rowCount    (const QModelIndex& parent = QModelIndex()) const override;
+    QVariant                data        (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray>  roleNames   (void) const override;
+
+    int     _rowForVehicleId        (int vehicleId) const { return vehicleId > 0 && vehicleId < _rowForId.count() ? _rowForId[vehicleId] : -1; }
+    void    _removeRow              (int row);
+    void    _rowChanged             (int row);
+    void    _handleHeartbeat        (int row, const mavlink_message_t& message);
+    void    _handleGlobalPositionInt(int row, const mavlink_message_t& message);
+    void    _handleSysStatus        (int row, const mavlink_message_t& message);
+
+    QVector<int>            _rowForId;              ///< Indexed by system id, -1 for vehicles not in the table
+
+    // One entry per row
+    QVector<quint8>         _vehicleIds;
+    QVector<quint8>         _componentIds;
+    QVector<quint8>         _firmwareTypes;
+    QVector<quint8>         _vehicleTypes;
+    QVector<LinkInterface*> _links;
+    QVector<qint32>         _latitudes;             ///< degE7
+    QVector<qint32>         _longitudes;            ///< degE7
+    QVector<float>          _altitudes;             ///< AMSL meters, NaN if not known
+    QVector<float>          _headings;
+    QVector<float>          _groundSpeeds;
+    QVector<quint8>         _baseModes;
+    QVector<quint32>        _customModes;
+    QVector<qint8>          _batteryRemaining;
+    QVector<qint64>         _lastHeartbeatMSecs;
+
+    QElapsedTimer           _clock;
+    QTimer                  _flushTimer;
+    QTimer                  _timeoutTimer;
+    int                     _firstChangedRow;
+    int                     _lastChangedRow;
+
+    static const int _vehicleIdRole;
+    static const int _coordinateRole;
+    static const int _altitudeRole;
+    static const int _headingRole;
+    static const int _armedRole;
+    static const int _flightModeRole;
+    static const int _batteryRemainingRole;
+
+    static const int _flushIntervalMSecs =          200;
+    static const int _heartbeatTimeoutMSecs =       3500;
+    static const int _timeoutCheckIntervalMSecs =   1000;
+};
@@ -0,0 +1,50 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ObserverVehicleTableBenchmark.h"
+#include "ObserverVehicleTableTest.h"
+
+void ObserverVehicleTableBenchmark::_cpuPerVehicle_data(void)
+{
+    QTest::addColumn<int>("vehicleCount");
+
+    QTest::newRow("10 vehicles")    << 10;
+    QTest::newRow("50 vehicles")    << 50;
+    QTest::newRow("100 vehicles")   << 100;
+    QTest::newRow("200 vehicles")   << 200;
+}
+
+void ObserverVehicleTableBenchmark::_cpuPerVehicle(void)
+{
+    QFETCH(int, vehicleCount);
+
+    ObserverVehicleTable table;
+
+    // One second of a typical telemetry stream for each vehicle: 1Hz heartbeat and SYS_STATUS, 10Hz position and
+    // attitude. Attitude is not decoded but is still dispatched to the table.
+    QVector<mavlink_message_t> messages;
+    for (int vehicleId=1; vehicleId<=vehicleCount; vehicleId++) {
+        ObserverVehicleTableTest::addVehicle(table, vehicleId);
+        messages.append(ObserverVehicleTableTest::heartbeatMessage(vehicleId, ObserverVehicleTableTest::autopilotComponentId, MAV_MODE_FLAG_CUSTOM_MODE_ENABLED, 3 << 16));
+        messages.append(ObserverVehicleTableTest::sysStatusMessage(vehicleId, 80));
+    }
+    for (int i=0; i<10; i++) {
+        for (int vehicleId=1; vehicleId<=vehicleCount; vehicleId++) {
+            messages.append(ObserverVehicleTableTest::globalPositionMessage(vehicleId, 473977419 + i * 100, 85455938 + vehicleId * 100, 488000, static_cast<uint16_t>(i * 3600)));
+            messages.append(ObserverVehicleTableTest::attitudeMessage(vehicleId));
+        }
+    }
+
+    QBENCHMARK {
+        for (const mavlink_message_t& message: messages) {
+            table.handleMessage(nullptr, message);
+        }
+    }
+    QCOMPARE(table.count(), vehicleCount);
+}
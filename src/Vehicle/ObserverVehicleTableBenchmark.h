@@ -0,0 +1,23 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Measures the time ObserverVehicleTable takes to process one second of typical telemetry, with up to 200 observed
+/// vehicles. Only the table is measured, the MAVLink parsing and the MultiVehicleManager dispatch in front of it are not.
+class ObserverVehicleTableBenchmark : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _cpuPerVehicle_data    (void);
+    void _cpuPerVehicle         (void);
+};
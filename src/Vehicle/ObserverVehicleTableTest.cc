@@ -0,0 +1,173 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ObserverVehicleTableTest.h"
+#include "QGCApplication.h"
+#include "FirmwarePluginManager.h"
+#include "FirmwarePlugin.h"
+
+void ObserverVehicleTableTest::addVehicle(ObserverVehicleTable& table, int vehicleId)
+{
+    table.addVehicle({ nullptr, vehicleId, autopilotComponentId, MAV_AUTOPILOT_PX4, MAV_TYPE_QUADROTOR });
+}
+
+mavlink_message_t ObserverVehicleTableTest::heartbeatMessage(int vehicleId, int componentId, uint8_t baseMode, uint32_t customMode)
+{
+    mavlink_message_t   message;
+    mavlink_heartbeat_t heartbeat;
+
+    memset(&heartbeat, 0, sizeof(heartbeat));
+    heartbeat.type =        MAV_TYPE_QUADROTOR;
+    heartbeat.autopilot =   MAV_AUTOPILOT_PX4;
+    heartbeat.base_mode =   baseMode;
+    heartbeat.custom_mode = customMode;
+    mavlink_msg_heartbeat_encode(static_cast<uint8_t>(vehicleId), static_cast<uint8_t>(componentId), &message, &heartbeat);
+    return message;
+}
+
+mavlink_message_t ObserverVehicleTableTest::globalPositionMessage(int vehicleId, int32_t lat, int32_t lon, int32_t alt, uint16_t hdg)
+{
+    mavlink_message_t               message;
+    mavlink_global_position_int_t   globalPositionInt;
+
+    memset(&globalPositionInt, 0, sizeof(globalPositionInt));
+    globalPositionInt.lat = lat;
+    globalPositionInt.lon = lon;
+    globalPositionInt.alt = alt;
+    globalPositionInt.vx =  300;
+    globalPositionInt.vy =  400;
+    globalPositionInt.hdg = hdg;
+    mavlink_msg_global_position_int_encode(static_cast<uint8_t>(vehicleId), autopilotComponentId, &message, &globalPositionInt);
+    return message;
+}
+
+mavlink_message_t ObserverVehicleTableTest::sysStatusMessage(int vehicleId, int8_t batteryRemaining)
+{
+    mavlink_message_t       message;
+    mavlink_sys_status_t    sysStatus;
+
+    memset(&sysStatus, 0, sizeof(sysStatus));
+    sysStatus.battery_remaining = batteryRemaining;
+    mavlink_msg_sys_status_encode(static_cast<uint8_t>(vehicleId), autopilotComponentId, &message, &sysStatus);
+    return message;
+}
+
+mavlink_message_t ObserverVehicleTableTest::attitudeMessage(int vehicleId)
+{
+    mavlink_message_t   message;
+    mavlink_attitude_t  attitude;
+
+    memset(&attitude, 0, sizeof(attitude));
+    mavlink_msg_attitude_encode(static_cast<uint8_t>(vehicleId), autopilotComponentId, &message, &attitude);
+    return message;
+}
+
+void ObserverVehicleTableTest::_decodeTelemetry(void)
+{
+    ObserverVehicleTable    table;
+    QSignalSpy              spyDataChanged(&table, &ObserverVehicleTable::dataChanged);
+
+    addVehicle(table, 42);
+    QCOMPARE(table.count(), 1);
+    QVERIFY(table.contains(42));
+    QVERIFY(!table.coordinate(0).isValid());
+    QVERIFY(qIsNaN(table.heading(0)));
+    QCOMPARE(table.batteryRemaining(0), -1);
+    QVERIFY(table.flightMode(0).isEmpty());
+
+    uint8_t     baseMode =      MAV_MODE_FLAG_CUSTOM_MODE_ENABLED | MAV_MODE_FLAG_SAFETY_ARMED;
+    uint32_t    customMode =    3 << 16;    // PX4 position control main mode
+    table.handleMessage(nullptr, heartbeatMessage(42, autopilotComponentId, baseMode, customMode));
+    table.handleMessage(nullptr, globalPositionMessage(42, 473977419, 85455938, 488000, 9000));
+    table.handleMessage(nullptr, sysStatusMessage(42, 75));
+
+    QGeoCoordinate coord = table.coordinate(0);
+    QCOMPARE(coord.latitude(),  47.3977419);
+    QCOMPARE(coord.longitude(), 8.5455938);
+    QCOMPARE(coord.altitude(),  488.0);
+    QCOMPARE(table.heading(0),      90.0);
+    QCOMPARE(table.groundSpeed(0),  5.0);
+    QVERIFY(table.armed(0));
+    QCOMPARE(table.batteryRemaining(0), 75);
+
+    FirmwarePlugin* firmwarePlugin = qgcApp()->toolbox()->firmwarePluginManager()->firmwarePluginForAutopilot(MAV_AUTOPILOT_PX4, MAV_TYPE_QUADROTOR);
+    QCOMPARE(table.flightMode(0), firmwarePlugin->flightMode(baseMode, customMode));
+
+    // Changes are signalled in a single batch
+    QCOMPARE(spyDataChanged.count(), 0);
+    QVERIFY(spyDataChanged.wait(1000));
+    QCOMPARE(spyDataChanged.count(), 1);
+
+    // Unknown heading
+    table.handleMessage(nullptr, globalPositionMessage(42, 473977419, 85455938, 488000, UINT16_MAX));
+    QVERIFY(qIsNaN(table.heading(0)));
+}
+
+void ObserverVehicleTableTest::_ignoredMessages(void)
+{
+    ObserverVehicleTable table;
+
+    addVehicle(table, 1);
+
+    // Vehicles which are not in the table
+    table.handleMessage(nullptr, globalPositionMessage(2, 473977419, 85455938, 488000, 9000));
+    QVERIFY(!table.contains(2));
+    QVERIFY(!table.coordinate(0).isValid());
+
+    // Heartbeats from other components
+    table.handleMessage(nullptr, heartbeatMessage(1, MAV_COMP_ID_CAMERA, MAV_MODE_FLAG_SAFETY_ARMED, 0));
+    QVERIFY(!table.armed(0));
+
+    // Position without gps
+    table.handleMessage(nullptr, globalPositionMessage(1, 0, 0, 488000, 9000));
+    QVERIFY(!table.coordinate(0).isValid());
+
+    // Only core telemetry is decoded
+    table.handleMessage(nullptr, attitudeMessage(1));
+    QCOMPARE(table.count(), 1);
+
+    // System id 0 is not a vehicle
+    addVehicle(table, 0);
+    QCOMPARE(table.count(), 1);
+}
+
+void ObserverVehicleTableTest::_removeVehicles(void)
+{
+    ObserverVehicleTable table;
+
+    for (int vehicleId=1; vehicleId<=3; vehicleId++) {
+        addVehicle(table, vehicleId);
+    }
+    QCOMPARE(table.firstVehicleId(), 1);
+
+    // Rows after the removed vehicle must still be found by id
+    ObserverVehicleTable::Identity identity = table.takeVehicle(2);
+    QCOMPARE(identity.vehicleId,    2);
+    QCOMPARE(identity.componentId,  static_cast<int>(autopilotComponentId));
+    QCOMPARE(identity.firmwareType, static_cast<int>(MAV_AUTOPILOT_PX4));
+    QCOMPARE(identity.vehicleType,  static_cast<int>(MAV_TYPE_QUADROTOR));
+    QCOMPARE(table.count(), 2);
+    QVERIFY(!table.contains(2));
+    table.handleMessage(nullptr, sysStatusMessage(3, 50));
+    QCOMPARE(table.vehicleId(1), 3);
+    QCOMPARE(table.batteryRemaining(1), 50);
+
+    QCOMPARE(table.takeVehicle(2).vehicleId, 0);
+
+    // Vehicles whose heartbeats stop are removed
+    QTest::qWait(50);
+    table.handleMessage(nullptr, heartbeatMessage(3, autopilotComponentId, 0, 0));
+    table.removeStaleVehicles(25);
+    QCOMPARE(table.count(), 1);
+    QVERIFY(table.contains(3));
+
+    table.removeVehiclesOnLink(nullptr);
+    QCOMPARE(table.count(), 0);
+    QCOMPARE(table.firstVehicleId(), 0);
+}
@@ -0,0 +1,33 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "ObserverVehicleTable.h"
+
+/// Checks ObserverVehicleTable decoding of core telemetry and removal of vehicles
+class ObserverVehicleTableTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    static void                 addVehicle              (ObserverVehicleTable& table, int vehicleId);
+    static mavlink_message_t    heartbeatMessage        (int vehicleId, int componentId, uint8_t baseMode, uint32_t customMode);
+    static mavlink_message_t    globalPositionMessage   (int vehicleId, int32_t lat, int32_t lon, int32_t alt, uint16_t hdg);
+    static mavlink_message_t    sysStatusMessage        (int vehicleId, int8_t batteryRemaining);
+    static mavlink_message_t    attitudeMessage         (int vehicleId);
+
+    static const int autopilotComponentId = MAV_COMP_ID_AUTOPILOT1;
+
+private slots:
+    void _decodeTelemetry   (void);
+    void _ignoredMessages   (void);
+    void _removeVehicles    (void);
+};
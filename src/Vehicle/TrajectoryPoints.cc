@@ -9,6 +9,8 @@
 
 #include "TrajectoryPoints.h"
 #include "Vehicle.h"
+#include "QGCApplication.h"
+#include "SettingsManager.h"
 
 TrajectoryPoints::TrajectoryPoints(Vehicle* vehicle, QObject* parent)
     : QObject       (parent)
@@ -33,39 +35,68 @@ void TrajectoryPoints::_vehicleCoordinateChanged(QGeoCoordinate coordinate)
                 // The new position IS NOT colinear with the last segment. Append the new position to the list.
                 _lastAzimuth = _lastPoint.azimuthTo(coordinate);
                 _lastPoint = coordinate;
-                _points.append(QVariant::fromValue(coordinate));
-                emit pointAdded(coordinate);
+                _appendPoint(coordinate);
             } else {
                 // The new position IS colinear with the last segment. Don't add a new point, just update
                 // the last point to be the new position.
                 _lastPoint = coordinate;
-                _points[_points.count() - 1] = QVariant::fromValue(coordinate);
+                _store.replaceLast(coordinate);
                 emit updateLastPoint(coordinate);
             }
         }
     } else {
         // Add the very first trajectory point to the list
         _lastPoint = coordinate;
-        _points.append(QVariant::fromValue(coordinate));
-        emit pointAdded(coordinate);
+        _appendPoint(coordinate);
     }
 }
 
+void TrajectoryPoints::_appendPoint(const QGeoCoordinate& coordinate)
+{
+    int blockCount = _store.blockCount();
+    _store.append(coordinate);
+    emit pointAdded(coordinate);
+    if (_store.blockCount() != blockCount) {
+        emit levelsOfDetailChanged();
+    }
+}
+
+QVariantList TrajectoryPoints::_toVariantList(const QList<QGeoCoordinate>& coordinates)
+{
+    QVariantList list;
+    list.reserve(coordinates.count());
+    for (const QGeoCoordinate& coordinate: coordinates) {
+        list.append(QVariant::fromValue(coordinate));
+    }
+    return list;
+}
+
+QVariantList TrajectoryPoints::list(void) const
+{
+    return _toVariantList(_store.fullResolutionPoints());
+}
+
+QVariantList TrajectoryPoints::listForView(const QGeoCoordinate& topLeft, const QGeoCoordinate& bottomRight, double metersPerPixel) const
+{
+    return _toVariantList(_store.pointsForView(QGeoRectangle(topLeft, bottomRight), metersPerPixel));
+}
+
 void TrajectoryPoints::start(void)
 {
     clear();
+    _store.setMemoryLimit(qgcApp()->toolbox()->settingsManager()->flyViewSettings()->trajectoryMemoryLimit()->rawValue().toLongLong() * 1024 * 1024);
     connect(_vehicle, &Vehicle::coordinateChanged, this, &TrajectoryPoints::_vehicleCoordinateChanged);
 }
 
 void TrajectoryPoints::stop(void)
 {
-    qDebug() << "Stop" << _points.count();
+    qDebug() << "Stop" << _store.count();
     disconnect(_vehicle, &Vehicle::coordinateChanged, this, &TrajectoryPoints::_vehicleCoordinateChanged);
 }
 
 void TrajectoryPoints::clear(void)
 {
-    _points.clear();
+    _store.clear();
     _lastPoint = QGeoCoordinate();
     _lastAzimuth = qQNaN();
     emit pointsCleared();
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "QmlObjectListModel.h"
+#include "TrajectoryStore.h"
 
 #include <QGeoCoordinate>
 
@@ -22,7 +23,11 @@ class TrajectoryPoints : public QObject
 public:
     TrajectoryPoints(Vehicle* vehicle, QObject* parent = nullptr);
 
-    Q_INVOKABLE QVariantList list(void) const { return _points; }
+    /// @return All trajectory points at full resolution
+    Q_INVOKABLE QVariantList list(void) const;
+
+    /// @return Trajectory points simplified for display at the specified map view
+    Q_INVOKABLE QVariantList listForView(const QGeoCoordinate& topLeft, const QGeoCoordinate& bottomRight, double metersPerPixel) const;
 
     void start  (void);
     void stop   (void);
@@ -34,13 +39,18 @@ signals:
     void pointAdded     (QGeoCoordinate coordinate);
     void updateLastPoint(QGeoCoordinate coordinate);
     void pointsCleared  (void);
+    void levelsOfDetailChanged(void);   ///< Older parts of the trajectory were simplified, display should refresh from listForView
 
 private slots:
     void _vehicleCoordinateChanged(QGeoCoordinate coordinate);
 
 private:
+    void _appendPoint(const QGeoCoordinate& coordinate);
+
+    static QVariantList _toVariantList(const QList<QGeoCoordinate>& coordinates);
+
     Vehicle*        _vehicle;
-    QVariantList    _points;
+    TrajectoryStore _store;
     QGeoCoordinate  _lastPoint;
     double          _lastAzimuth;
 
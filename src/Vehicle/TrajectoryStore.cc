@@ -0,0 +1,361 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TrajectoryStore.h"
+
+#include <QTemporaryFile>
+#include <QtMath>
+
+QGC_LOGGING_CATEGORY(TrajectoryStoreLog, "TrajectoryStoreLog")
+
+TrajectoryStore::TrajectoryStore(void)
+    : _blockCount       (0)
+    , _count            (0)
+    , _memoryLimit      (_defaultMemoryLimit)
+    , _spillFile        (nullptr)
+    , _spilledBlockCount(0)
+{
+    clear();
+}
+
+TrajectoryStore::~TrajectoryStore()
+{
+    delete _spillFile;
+}
+
+void TrajectoryStore::setMemoryLimit(qint64 bytes)
+{
+    _memoryLimit = bytes;
+    _enforceMemoryLimit();
+}
+
+void TrajectoryStore::clear(void)
+{
+    _tail.clear();
+    for (int level=0; level<levelCount; level++) {
+        _levels[level].clear();
+        _firstBlock[level] = 0;
+        _levelPointCount[level] = 0;
+    }
+    _blockCount         = 0;
+    _count              = 0;
+    _spilledBlockCount  = 0;
+
+    delete _spillFile;
+    _spillFile = nullptr;
+}
+
+TrajectoryStore::Point TrajectoryStore::_point(const QGeoCoordinate& coordinate)
+{
+    return { coordinate.latitude(), coordinate.longitude(), static_cast<float>(coordinate.altitude()) };
+}
+
+QGeoCoordinate TrajectoryStore::_coordinate(const Point& point)
+{
+    return QGeoCoordinate(point.latitude, point.longitude, static_cast<double>(point.altitude));
+}
+
+void TrajectoryStore::append(const QGeoCoordinate& coordinate)
+{
+    if (_tail.count() == blockSize) {
+        _closeBlock();
+    }
+    _tail.append(_point(coordinate));
+    _count++;
+}
+
+void TrajectoryStore::replaceLast(const QGeoCoordinate& coordinate)
+{
+    // The tail always holds at least two points once a block has been closed, so the shared boundary point is never replaced
+    if (_tail.isEmpty()) {
+        append(coordinate);
+    } else {
+        _tail.last() = _point(coordinate);
+    }
+}
+
+qint64 TrajectoryStore::memoryUsage(void) const
+{
+    qint64 pointCount = _tail.count();
+    for (int level=0; level<levelCount; level++) {
+        pointCount += _levelPointCount[level];
+    }
+    return pointCount * static_cast<qint64>(sizeof(Point));
+}
+
+double TrajectoryStore::levelTolerance(int level)
+{
+    // Level 0 is full resolution, then 1m, 4m, 16m, ...
+    return level == 0 ? 0.0 : qPow(4.0, level - 1);
+}
+
+int TrajectoryStore::levelForResolution(double metersPerPixel)
+{
+    int level = 0;
+    while (level + 1 < levelCount && levelTolerance(level + 1) <= metersPerPixel) {
+        level++;
+    }
+    return level;
+}
+
+void TrajectoryStore::_closeBlock(void)
+{
+    Block block = _tail;
+
+    for (int level=0; level<levelCount; level++) {
+        Block levelBlock = level == 0 ? block : _simplify(block, levelTolerance(level));
+        if (_levels[level].isEmpty()) {
+            // Evicted levels restart with the new block
+            _firstBlock[level] = _blockCount;
+        }
+        _levels[level].append(levelBlock);
+        _levelPointCount[level] += levelBlock.count();
+    }
+    _blockCount++;
+
+    // The next block starts with the end point of this one
+    _tail.clear();
+    _tail.append(block.last());
+
+    qCDebug(TrajectoryStoreLog) << "Closed block" << _blockCount << "level point counts" << _levelPointCount[0] << _levelPointCount[levelCount - 1];
+
+    _enforceMemoryLimit();
+}
+
+void TrajectoryStore::_enforceMemoryLimit(void)
+{
+    // Evict the oldest blocks from the finest level first. Level 0 is only partially retained before any coarser level
+    // is touched, so each level always holds a suffix of the blocks held by the next coarser level.
+    int level = 0;
+    while (memoryUsage() > _memoryLimit && level < levelCount - 1) {
+        if (_levels[level].isEmpty()) {
+            level++;
+            continue;
+        }
+
+        Block block = _levels[level].takeFirst();
+        _levelPointCount[level] -= block.count();
+        _firstBlock[level]++;
+        if (level == 0) {
+            _spillBlock(block);
+        }
+    }
+}
+
+void TrajectoryStore::_spillBlock(const Block& block)
+{
+    if (!_spillFile) {
+        _spillFile = new QTemporaryFile();
+        if (!_spillFile->open()) {
+            qCWarning(TrajectoryStoreLog) << "Unable to open trajectory spill file, full resolution points will be lost" << _spillFile->errorString();
+        }
+    }
+    if (!_spillFile->isOpen()) {
+        return;
+    }
+
+    qint32 pointCount = block.count();
+    _spillFile->seek(_spillFile->size());
+    _spillFile->write(reinterpret_cast<const char*>(&pointCount), sizeof(pointCount));
+    _spillFile->write(reinterpret_cast<const char*>(block.constData()), pointCount * static_cast<qint64>(sizeof(Point)));
+    _spilledBlockCount++;
+}
+
+/// Douglas-Peucker simplification of a block. Distances are measured on a local flat projection which is plenty
+/// accurate over the extent of a single block.
+TrajectoryStore::Block TrajectoryStore::_simplify(const Block& block, double tolerance)
+{
+    int count = block.count();
+    if (count < 3) {
+        return block;
+    }
+
+    const double metersPerDegree    = 111319.49;
+    const double lonScale           = qCos(qDegreesToRadians(block.first().latitude)) * metersPerDegree;
+    const double toleranceSq        = tolerance * tolerance;
+
+    QVector<double> x(count);
+    QVector<double> y(count);
+    for (int i=0; i<count; i++) {
+        x[i] = (block[i].longitude - block.first().longitude) * lonScale;
+        y[i] = (block[i].latitude - block.first().latitude) * metersPerDegree;
+    }
+
+    QVector<bool>           keep(count, false);
+    QVector<QPair<int,int>> stack;
+    keep[0] = keep[count - 1] = true;
+    stack.append(qMakePair(0, count - 1));
+
+    while (!stack.isEmpty()) {
+        QPair<int,int> range = stack.takeLast();
+        int     first   = range.first;
+        int     last    = range.second;
+        double  dx      = x[last] - x[first];
+        double  dy      = y[last] - y[first];
+        double  lenSq   = dx * dx + dy * dy;
+        double  maxSq   = -1;
+        int     maxIndex = -1;
+
+        for (int i=first+1; i<last; i++) {
+            double px = x[i] - x[first];
+            double py = y[i] - y[first];
+            double distSq;
+            if (lenSq == 0) {
+                distSq = px * px + py * py;
+            } else {
+                double t = qBound(0.0, (px * dx + py * dy) / lenSq, 1.0);
+                double ex = px - t * dx;
+                double ey = py - t * dy;
+                distSq = ex * ex + ey * ey;
+            }
+            if (distSq > maxSq) {
+                maxSq = distSq;
+                maxIndex = i;
+            }
+        }
+
+        if (maxIndex != -1 && maxSq > toleranceSq) {
+            keep[maxIndex] = true;
+            stack.append(qMakePair(first, maxIndex));
+            stack.append(qMakePair(maxIndex, last));
+        }
+    }
+
+    Block simplified;
+    for (int i=0; i<count; i++) {
+        if (keep[i]) {
+            simplified.append(block[i]);
+        }
+    }
+    return simplified;
+}
+
+/// @return Finest level at or above the requested level which still holds the block
+int TrajectoryStore::_levelForBlock(int block, int level) const
+{
+    while (level < levelCount - 1 && (_levels[level].isEmpty() || block < _firstBlock[level])) {
+        level++;
+    }
+    return level;
+}
+
+void TrajectoryStore::_appendBlockCoordinates(QList<QGeoCoordinate>& coordinates, const Block& block)
+{
+    // Consecutive blocks share their boundary point
+    for (int i=coordinates.isEmpty() ? 0 : 1; i<block.count(); i++) {
+        coordinates.append(_coordinate(block[i]));
+    }
+}
+
+QList<QGeoCoordinate> TrajectoryStore::pointsForView(const QGeoRectangle& view, double metersPerPixel) const
+{
+    QList<QGeoCoordinate> coordinates;
+
+    if (_tail.isEmpty()) {
+        return coordinates;
+    }
+
+    int requestedLevel = levelForResolution(metersPerPixel);
+
+    // Culling is skipped for views which wrap the anti-meridian
+    bool    cull    = view.isValid() && view.topLeft().longitude() <= view.bottomRight().longitude();
+    double  north   = view.topLeft().latitude();
+    double  south   = view.bottomRight().latitude();
+    double  west    = view.topLeft().longitude();
+    double  east    = view.bottomRight().longitude();
+
+    auto outCode = [&](const Point& point) {
+        int code = 0;
+        if (cull) {
+            if (point.latitude > north)     { code |= 1; }
+            if (point.latitude < south)     { code |= 2; }
+            if (point.longitude < west)     { code |= 4; }
+            if (point.longitude > east)     { code |= 8; }
+        }
+        return code;
+    };
+
+    // A run of consecutive points which are all beyond the same edge of the view is collapsed to its first and last
+    // point. The straight segment between those stays beyond that edge so the visible part of the path is unchanged.
+    bool    havePrevious    = false;
+    bool    runActive       = false;
+    int     runCode         = 0;
+    Point   runLast         = { 0, 0, 0 };
+    bool    runLastPending  = false;
+
+    auto addPoint = [&](const Point& point) {
+        int code = outCode(point);
+        if (runActive && (runCode & code)) {
+            runCode &= code;
+            runLast = point;
+            runLastPending = true;
+            return;
+        }
+        if (runLastPending) {
+            coordinates.append(_coordinate(runLast));
+            runLastPending = false;
+        }
+        coordinates.append(_coordinate(point));
+        runActive   = code != 0;
+        runCode     = code;
+    };
+
+    auto addBlock = [&](const Block& block) {
+        for (int i=havePrevious ? 1 : 0; i<block.count(); i++) {
+            addPoint(block[i]);
+        }
+        havePrevious = true;
+    };
+
+    for (int block=0; block<_blockCount; block++) {
+        int level = _levelForBlock(block, requestedLevel);
+        addBlock(_levels[level][block - _firstBlock[level]]);
+    }
+    addBlock(_tail);
+
+    if (runLastPending) {
+        coordinates.append(_coordinate(runLast));
+    }
+
+    return coordinates;
+}
+
+QList<QGeoCoordinate> TrajectoryStore::fullResolutionPoints(void) const
+{
+    QList<QGeoCoordinate> coordinates;
+
+    if (_spillFile && _spillFile->isOpen()) {
+        _spillFile->seek(0);
+        for (int i=0; i<_spilledBlockCount; i++) {
+            qint32 pointCount = 0;
+            if (_spillFile->read(reinterpret_cast<char*>(&pointCount), sizeof(pointCount)) != sizeof(pointCount) || pointCount < 0) {
+                qCWarning(TrajectoryStoreLog) << "Trajectory spill file truncated";
+                break;
+            }
+            Block block(pointCount);
+            qint64 cbBlock = pointCount * static_cast<qint64>(sizeof(Point));
+            if (_spillFile->read(reinterpret_cast<char*>(block.data()), cbBlock) != cbBlock) {
+                qCWarning(TrajectoryStoreLog) << "Trajectory spill file truncated";
+                break;
+            }
+            _appendBlockCoordinates(coordinates, block);
+        }
+    } else if (_spilledBlockCount) {
+        qCWarning(TrajectoryStoreLog) << "Full resolution points missing for blocks" << _spilledBlockCount;
+    }
+
+    // Blocks evicted from level 0 but not spilled, because the spill file could not be opened, are taken from the finest level available
+    for (int block=_spillFile && _spillFile->isOpen() ? _spilledBlockCount : 0; block<_blockCount; block++) {
+        int level = _levelForBlock(block, 0);
+        _appendBlockCoordinates(coordinates, _levels[level][block - _firstBlock[level]]);
+    }
+    _appendBlockCoordinates(coordinates, _tail);
+
+    return coordinates;
+}
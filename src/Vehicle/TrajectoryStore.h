@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "QGCLoggingCategory.h"
+
+#include <QGeoCoordinate>
+#include <QGeoRectangle>
+#include <QList>
+#include <QVector>
+
+Q_DECLARE_LOGGING_CATEGORY(TrajectoryStoreLog)
+
+class QTemporaryFile;
+
+/// Bounded memory storage for a vehicle trajectory with a level of detail pyramid for display.
+///
+/// Points are collected into blocks of blockSize points. Once a block is complete it is simplified with Douglas-Peucker
+/// for each level of detail, level 0 being full resolution and each further level having four times the tolerance of the
+/// previous one. Consecutive blocks share their boundary point so each level is a continuous path.
+///
+/// When the memory limit is exceeded the oldest blocks are evicted from the finest level first. Full resolution blocks
+/// are written to a temporary file so the full trajectory is still available for export. Blocks which are no longer
+/// available at the requested level are displayed at the next coarser level which still has them. The coarsest level is
+/// never evicted.
+class TrajectoryStore
+{
+public:
+    /// Compact trajectory point
+    struct Point {
+        double  latitude;
+        double  longitude;
+        float   altitude;
+    };
+
+    TrajectoryStore(void);
+    ~TrajectoryStore();
+
+    /// Sets the limit for the memory used by the points, evicting points as needed
+    void setMemoryLimit(qint64 bytes);
+
+    void append     (const QGeoCoordinate& coordinate);
+    void replaceLast(const QGeoCoordinate& coordinate);
+    void clear      (void);
+
+    bool    isEmpty     (void) const { return _tail.isEmpty(); }
+    qint64  count       (void) const { return _count; }     ///< Number of full resolution points
+    qint64  memoryUsage (void) const;
+    int     blockCount  (void) const { return _blockCount; }
+
+    /// @return Finest level of detail whose tolerance is not greater than the specified ground distance
+    static int levelForResolution(double metersPerPixel);
+
+    /// @return Simplification tolerance in meters for the level of detail
+    static double levelTolerance(int level);
+
+    /// Returns the points needed to display the trajectory
+    ///     @param view Visible area, runs of points which are outside the view and can't cross it are collapsed to their end points. Invalid: no culling.
+    ///     @param metersPerPixel Ground resolution of the display, used to pick the level of detail
+    QList<QGeoCoordinate> pointsForView(const QGeoRectangle& view, double metersPerPixel) const;
+
+    /// @return All points at full resolution, including the ones which were evicted to disk
+    QList<QGeoCoordinate> fullResolutionPoints(void) const;
+
+    static const int levelCount =   6;
+    static const int blockSize =    256;
+
+private:
+    typedef QVector<Point> Block;
+
+    void _closeBlock            (void);
+    void _enforceMemoryLimit    (void);
+    void _spillBlock            (const Block& block);
+    int  _levelForBlock         (int block, int level) const;
+
+    static Point            _point                  (const QGeoCoordinate& coordinate);
+    static QGeoCoordinate   _coordinate             (const Point& point);
+    static Block            _simplify               (const Block& block, double tolerance);
+    static void             _appendBlockCoordinates (QList<QGeoCoordinate>& coordinates, const Block& block);
+
+    Block           _tail;                          ///< Points of the block which is not complete yet, always full resolution
+    QList<Block>    _levels[levelCount];            ///< Retained blocks for each level of detail, oldest first
+    int             _firstBlock[levelCount];        ///< Block number of the first block retained in each level
+    qint64          _levelPointCount[levelCount];   ///< Number of points retained in each level
+    int             _blockCount;                    ///< Number of completed blocks
+    qint64          _count;
+    qint64          _memoryLimit;
+    QTemporaryFile* _spillFile;                     ///< Full resolution blocks evicted from memory
+    int             _spilledBlockCount;
+
+    static const qint64 _defaultMemoryLimit = 16 * 1024 * 1024;
+};
@@ -0,0 +1,151 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TrajectoryStoreTest.h"
+#include "TrajectoryStore.h"
+
+namespace {
+
+const double _metersPerDegree = 111319.49;
+
+/// Points heading east along the equator, alternately offset north and south by offsetMeters
+QList<QGeoCoordinate> _path(int count, double offsetMeters)
+{
+    QList<QGeoCoordinate> path;
+    for (int i=0; i<count; i++) {
+        double offset = (i % 2 ? -offsetMeters : offsetMeters) / _metersPerDegree;
+        path.append(QGeoCoordinate(offset, i * 0.0001, i % 100));
+    }
+    return path;
+}
+
+}
+
+void TrajectoryStoreTest::_levelOfDetail(void)
+{
+    QCOMPARE(TrajectoryStore::levelForResolution(0),    0);
+    QCOMPARE(TrajectoryStore::levelForResolution(1),    1);
+    QCOMPARE(TrajectoryStore::levelForResolution(5),    2);
+    QCOMPARE(TrajectoryStore::levelForResolution(1e6),  TrajectoryStore::levelCount - 1);
+
+    // A 1.5 meter zig zag is kept at the 1 meter level and flattened at the 4 meter level
+    TrajectoryStore         store;
+    QList<QGeoCoordinate>   path = _path(TrajectoryStore::blockSize * 3, 1.5);
+    for (const QGeoCoordinate& coord: path) {
+        store.append(coord);
+    }
+    QCOMPARE(store.count(), static_cast<qint64>(path.count()));
+    QCOMPARE(store.blockCount(), 3);
+
+    QCOMPARE(store.pointsForView(QGeoRectangle(), 0), path);
+    QCOMPARE(store.pointsForView(QGeoRectangle(), 1), path);
+
+    QList<QGeoCoordinate> coarse = store.pointsForView(QGeoRectangle(), 4);
+    QCOMPARE(coarse.first(), path.first());
+    QCOMPARE(coarse.last(), path.last());
+    for (const QGeoCoordinate& coord: coarse) {
+        QVERIFY(path.contains(coord));
+    }
+
+    // Each completed block is down to its end points, the tail is always full resolution
+    int tailCount = path.count() - (TrajectoryStore::blockSize * store.blockCount() - (store.blockCount() - 1)) + 1;
+    QCOMPARE(coarse.count(), store.blockCount() + tailCount);
+}
+
+/// The oldest full resolution blocks are evicted first, and are still available from disk
+void TrajectoryStoreTest::_memoryLimit(void)
+{
+    TrajectoryStore         store;
+    QList<QGeoCoordinate>   path = _path(TrajectoryStore::blockSize * 20, 0);
+    for (const QGeoCoordinate& coord: path) {
+        store.append(coord);
+    }
+    QCOMPARE(store.pointsForView(QGeoRectangle(), 0).count(), path.count());
+
+    qint64 memoryLimit = store.memoryUsage() / 2;
+    store.setMemoryLimit(memoryLimit);
+    QVERIFY(store.memoryUsage() <= memoryLimit);
+
+    // Evicted blocks are displayed from a coarser level
+    QList<QGeoCoordinate> points = store.pointsForView(QGeoRectangle(), 0);
+    QVERIFY(points.count() < path.count());
+    QCOMPARE(points.first(), path.first());
+    QCOMPARE(points.last(), path.last());
+    QVERIFY(points.mid(points.count() - TrajectoryStore::blockSize) == path.mid(path.count() - TrajectoryStore::blockSize));
+
+    QCOMPARE(store.fullResolutionPoints(), path);
+
+    // Blocks are evicted as they are completed, the tail is never evicted
+    TrajectoryStore onePoint;
+    onePoint.append(path.first());
+    qint64 pointSize = onePoint.memoryUsage();
+
+    QList<QGeoCoordinate> morePath = _path(TrajectoryStore::blockSize * 25, 0).mid(path.count());
+    for (const QGeoCoordinate& coord: morePath) {
+        store.append(coord);
+    }
+    QVERIFY(store.memoryUsage() <= memoryLimit + TrajectoryStore::blockSize * pointSize);
+    QCOMPARE(store.fullResolutionPoints(), path + morePath);
+
+    store.clear();
+    QVERIFY(store.isEmpty());
+    QVERIFY(store.fullResolutionPoints().isEmpty());
+}
+
+void TrajectoryStoreTest::_coarsestLevelKept(void)
+{
+    TrajectoryStore         store;
+    QList<QGeoCoordinate>   path = _path(TrajectoryStore::blockSize * 10, 0);
+    for (const QGeoCoordinate& coord: path) {
+        store.append(coord);
+    }
+
+    store.setMemoryLimit(0);
+    QVERIFY(store.memoryUsage() > 0);
+
+    QList<QGeoCoordinate> points = store.pointsForView(QGeoRectangle(), 0);
+    QCOMPARE(points.first(), path.first());
+    QCOMPARE(points.last(), path.last());
+    QCOMPARE(store.pointsForView(QGeoRectangle(), 1e6), points);
+    QCOMPARE(store.fullResolutionPoints(), path);
+}
+
+/// Runs of points beyond the same edge of the view collapse to their end points, points within the view are all kept
+void TrajectoryStoreTest::_viewCulling(void)
+{
+    TrajectoryStore         store;
+    QList<QGeoCoordinate>   path;
+
+    // Out to the east of the view and back
+    for (int i=0; i<=1000; i++) {
+        path.append(QGeoCoordinate(0, i * 0.01, 0));
+    }
+    for (int i=999; i>=0; i--) {
+        path.append(QGeoCoordinate(0.5, i * 0.01, 0));
+    }
+    for (const QGeoCoordinate& coord: path) {
+        store.append(coord);
+    }
+
+    QGeoRectangle view(QGeoCoordinate(1, -1), QGeoCoordinate(-1, 1.005));
+    QList<QGeoCoordinate> points = store.pointsForView(view, 0);
+
+    QList<QGeoCoordinate> expected;
+    for (int i=0; i<path.count(); i++) {
+        bool inView     = view.contains(path[i]);
+        bool runEdge    = i > 0 && i < path.count() - 1 && (view.contains(path[i - 1]) || view.contains(path[i + 1]));
+        if (inView || runEdge) {
+            expected.append(path[i]);
+        }
+    }
+    QCOMPARE(points, expected);
+
+    // No culling without a view
+    QCOMPARE(store.pointsForView(QGeoRectangle(), 0), path);
+}
@@ -0,0 +1,24 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Checks the level of detail pyramid, memory limit eviction, spilling to disk and view culling of TrajectoryStore
+class TrajectoryStoreTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _levelOfDetail     (void);
+    void _memoryLimit       (void);
+    void _coarsestLevelKept (void);
+    void _viewCulling       (void);
+};
@@ -11,6 +11,7 @@
 #include <QDateTime>
 #include <QLocale>
 #include <QQuaternion>
+#include <QtMath>
 
 #include <Eigen/Eigen>
 
@@ -33,7 +34,6 @@
 #include "MissionCommandTree.h"
 #include "QGroundControlQmlGlobal.h"
 #include "SettingsManager.h"
-#include "QGCQGeoCoordinate.h"
 #include "QGCCorePlugin.h"
 #include "QGCOptions.h"
 #include "ADSBVehicleManager.h"
@@ -44,7 +44,10 @@
 #include "PositionManager.h"
 #include "VehicleObjectAvoidance.h"
 #include "TrajectoryPoints.h"
+#include "CameraTriggerPoints.h"
+#include "GeoFenceBreachMonitor.h"
 #include "QGCGeo.h"
+#include "QGCFrameScheduler.h"
 
 #if defined(QGC_AIRMAP_ENABLED)
 #include "AirspaceVehicleManager.h"
@@ -137,6 +140,8 @@ Vehicle::Vehicle(LinkInterface*             link,
     , _onboardControlSensorsUnhealthy(0)
     , _gpsRawIntMessageAvailable(false)
     , _globalPositionIntMessageAvailable(false)
+    , _velocityNorth(0)
+    , _velocityEast(0)
     , _defaultCruiseSpeed(_settingsManager->appSettings()->offlineEditingCruiseSpeed()->rawValue().toDouble())
     , _defaultHoverSpeed(_settingsManager->appSettings()->offlineEditingHoverSpeed()->rawValue().toDouble())
     , _telemetryRRSSI(0)
@@ -170,6 +175,8 @@ Vehicle::Vehicle(LinkInterface*             link,
     , _custom_mode(0)
     , _nextSendMessageMultipleIndex(0)
     , _trajectoryPoints(new TrajectoryPoints(this, this))
+    , _cameraTriggerPoints(new CameraTriggerPoints(this))
+    , _geoFenceBreachMonitor(nullptr)
     , _firmwarePluginManager(firmwarePluginManager)
     , _joystickManager(joystickManager)
     , _flowImageIndex(0)
@@ -284,12 +291,12 @@ Vehicle::Vehicle(LinkInterface*             link,
     }
 
     _firmwarePlugin->initializeVehicle(this);
+    // Vehicle meta data is shared by all vehicles, the adjustments must only apply to this one
     for(auto& factName: factNames()) {
-        _firmwarePlugin->adjustMetaData(vehicleType, getFact(factName)->metaData());
+        _firmwarePlugin->adjustMetaData(vehicleType, getFact(factName)->_metaDataForWrite());
     }
 
-    _sendMultipleTimer.start(_sendMessageMultipleIntraMessageDelay);
-    connect(&_sendMultipleTimer, &QTimer::timeout, this, &Vehicle::_sendMessageMultipleNext);
+    _toolbox->frameScheduler()->registerTask(this, _sendMessageMultipleIntraMessageDelay, [this]() { _sendMessageMultipleNext(); });
 
     connect(&_orbitTelemetryTimer, &QTimer::timeout, this, &Vehicle::_orbitTelemetryTimeout);
 
@@ -298,8 +305,7 @@ Vehicle::Vehicle(LinkInterface*             link,
     emit dynamicCamerasChanged();
 
     // Start csv logger
-    connect(&_csvLogTimer, &QTimer::timeout, this, &Vehicle::_writeCsvLine);
-    _csvLogTimer.start(1000);
+    scheduler->registerTask(this, 1000, [this]() { _writeCsvLine(); });
     _lastBatteryAnnouncement.start();
 }
 
@@ -345,6 +351,8 @@ Vehicle::Vehicle(MAV_AUTOPILOT              firmwareType,
     , _onboardControlSensorsUnhealthy(0)
     , _gpsRawIntMessageAvailable(false)
     , _globalPositionIntMessageAvailable(false)
+    , _velocityNorth(0)
+    , _velocityEast(0)
     , _defaultCruiseSpeed(_settingsManager->appSettings()->offlineEditingCruiseSpeed()->rawValue().toDouble())
     , _defaultHoverSpeed(_settingsManager->appSettings()->offlineEditingHoverSpeed()->rawValue().toDouble())
     , _mavlinkProtocolRequestComplete(true)
@@ -371,6 +379,8 @@ Vehicle::Vehicle(MAV_AUTOPILOT              firmwareType,
     , _custom_mode(0)
     , _nextSendMessageMultipleIndex(0)
     , _trajectoryPoints(new TrajectoryPoints(this, this))
+    , _cameraTriggerPoints(new CameraTriggerPoints(this))
+    , _geoFenceBreachMonitor(nullptr)
     , _firmwarePluginManager(firmwarePluginManager)
     , _joystickManager(nullptr)
     , _flowImageIndex(0)
@@ -465,6 +475,9 @@ void Vehicle::_commonInit()
     connect(_geoFenceManager, &GeoFenceManager::error,          this, &Vehicle::_geoFenceManagerError);
     connect(_geoFenceManager, &GeoFenceManager::loadComplete,   this, &Vehicle::_geoFenceLoadComplete);
 
+    _geoFenceBreachMonitor = new GeoFenceBreachMonitor(this, this);
+    connect(_geoFenceBreachMonitor, &GeoFenceBreachMonitor::breachAnnouncement, this, &Vehicle::_geoFenceBreachAnnouncement);
+
     _rallyPointManager = new RallyPointManager(this);
     connect(_rallyPointManager, &RallyPointManager::error,          this, &Vehicle::_rallyPointManagerError);
     connect(_rallyPointManager, &RallyPointManager::loadComplete,   this, &Vehicle::_rallyPointLoadComplete);
@@ -518,9 +531,8 @@ void Vehicle::_commonInit()
 
     _flightDistanceFact.setRawValue(0);
     _flightTimeFact.setRawValue(0);
-    _flightTimeUpdater.setInterval(1000);
-    _flightTimeUpdater.setSingleShot(false);
-    connect(&_flightTimeUpdater, &QTimer::timeout, this, &Vehicle::_updateFlightTime);
+    _flightTimeUpdaterTaskId = _toolbox->frameScheduler()->registerTask(this, 1000, [this]() { _updateFlightTime(); });
+    _toolbox->frameScheduler()->setTaskActive(_flightTimeUpdaterTaskId, false);
 
     // Set video stream to udp if running ArduSub and Video is disabled
     if (sub() && _settingsManager->videoSettings()->videoSource()->rawValue() == VideoSettings::videoDisabled) {
@@ -545,6 +557,9 @@ Vehicle::~Vehicle()
 {
     qCDebug(VehicleLog) << "~Vehicle" << this;
 
+    // Periodic tasks use members which are about to go away
+    _toolbox->frameScheduler()->unregisterTasks(this);
+
     delete _missionManager;
     _missionManager = nullptr;
 
@@ -858,7 +873,7 @@ void Vehicle::_handleCameraFeedback(const mavlink_message_t& message)
 
     QGeoCoordinate imageCoordinate((double)feedback.lat / qPow(10.0, 7.0), (double)feedback.lng / qPow(10.0, 7.0), feedback.alt_msl);
     qCDebug(VehicleLog) << "_handleCameraFeedback coord:index" << imageCoordinate << feedback.img_idx;
-    _cameraTriggerPoints.append(new QGCQGeoCoordinate(imageCoordinate, this));
+    _cameraTriggerPoints->append(imageCoordinate);
 }
 #endif
 
@@ -907,7 +922,7 @@ void Vehicle::_handleCameraImageCaptured(const mavlink_message_t& message)
     QGeoCoordinate imageCoordinate((double)feedback.lat / qPow(10.0, 7.0), (double)feedback.lon / qPow(10.0, 7.0), feedback.alt);
     qCDebug(VehicleLog) << "_handleCameraFeedback coord:index" << imageCoordinate << feedback.image_index << feedback.capture_result;
     if (feedback.capture_result == 1) {
-        _cameraTriggerPoints.append(new QGCQGeoCoordinate(imageCoordinate, this));
+        _cameraTriggerPoints->append(imageCoordinate);
     }
 }
 
@@ -1150,6 +1165,15 @@ void Vehicle::_handleGpsRawInt(mavlink_message_t& message)
 
     if (gpsRawInt.fix_type >= GPS_FIX_TYPE_3D_FIX) {
         if (!_globalPositionIntMessageAvailable) {
+            if (gpsRawInt.vel != UINT16_MAX && gpsRawInt.cog != UINT16_MAX) {
+                double groundSpeed  = gpsRawInt.vel / 100.0;
+                double course       = qDegreesToRadians(gpsRawInt.cog / 100.0);
+                _velocityNorth  = groundSpeed * qCos(course);
+                _velocityEast   = groundSpeed * qSin(course);
+            } else {
+                _velocityNorth = _velocityEast = 0;
+            }
+
             QGeoCoordinate newPosition(gpsRawInt.lat  / (double)1E7, gpsRawInt.lon / (double)1E7, gpsRawInt.alt  / 1000.0);
             if (newPosition != _coordinate) {
                 _coordinate = newPosition;
@@ -1184,6 +1208,9 @@ void Vehicle::_handleGlobalPositionInt(mavlink_message_t& message)
     }
 
     _globalPositionIntMessageAvailable = true;
+    _velocityNorth  = globalPositionInt.vx / 100.0;
+    _velocityEast   = globalPositionInt.vy / 100.0;
+
     QGeoCoordinate newPosition(globalPositionInt.lat  / (double)1E7, globalPositionInt.lon / (double)1E7, globalPositionInt.alt  / 1000.0);
     if (newPosition != _coordinate) {
         _coordinate = newPosition;
@@ -2565,22 +2592,32 @@ void Vehicle::_rallyPointManagerError(int errorCode, const QString& errorMsg)
     qgcApp()->showMessage(tr("Rally Point transfer failed. Retry transfer. Error: %1").arg(errorMsg));
 }
 
+void Vehicle::_geoFenceBreachAnnouncement()
+{
+    // The monitor decides when to announce, so repeats while the vehicle flies along a fence line are held back there
+    if (_geoFenceBreachMonitor->breachState() == GeoFenceBreachMonitor::Breached) {
+        _say(tr("%1 geofence breached").arg(_vehicleIdSpeech()));
+    } else {
+        _say(tr("%1 geofence breach in %2 seconds").arg(_vehicleIdSpeech()).arg(qCeil(_geoFenceBreachMonitor->secondsToBreach())));
+    }
+}
+
 void Vehicle::_clearCameraTriggerPoints()
 {
-    _cameraTriggerPoints.clearAndDeleteContents();
+    _cameraTriggerPoints->clear();
 }
 
 void Vehicle::_flightTimerStart()
 {
     _flightTimer.start();
-    _flightTimeUpdater.start();
+    _toolbox->frameScheduler()->setTaskActive(_flightTimeUpdaterTaskId, true);
     _flightDistanceFact.setRawValue(0);
     _flightTimeFact.setRawValue(0);
 }
 
 void Vehicle::_flightTimerStop()
 {
-    _flightTimeUpdater.stop();
+    _toolbox->frameScheduler()->setTaskActive(_flightTimeUpdaterTaskId, false);
 }
 
 void Vehicle::_updateFlightTime()
@@ -38,6 +38,8 @@ class QGCCameraManager;
 class Joystick;
 class VehicleObjectAvoidance;
 class TrajectoryPoints;
+class CameraTriggerPoints;
+class GeoFenceBreachMonitor;
 
 #if defined(QGC_AIRMAP_ENABLED)
 class AirspaceVehicleManager;
@@ -542,7 +544,8 @@ public:
     Q_PROPERTY(QString              flightMode              READ flightMode             WRITE setFlightMode             NOTIFY flightModeChanged)
     Q_PROPERTY(bool                 hilMode                 READ hilMode                WRITE setHilMode                NOTIFY hilModeChanged)
     Q_PROPERTY(TrajectoryPoints*    trajectoryPoints        MEMBER _trajectoryPoints                                    CONSTANT)
-    Q_PROPERTY(QmlObjectListModel*  cameraTriggerPoints     READ cameraTriggerPoints                                    CONSTANT)
+    Q_PROPERTY(CameraTriggerPoints* cameraTriggerPoints     READ cameraTriggerPoints                                    CONSTANT)
+    Q_PROPERTY(GeoFenceBreachMonitor* geoFenceBreachMonitor READ geoFenceBreachMonitor                                CONSTANT)
     Q_PROPERTY(float                latitude                READ latitude                                               NOTIFY coordinateChanged)
     Q_PROPERTY(float                longitude               READ longitude                                              NOTIFY coordinateChanged)
     Q_PROPERTY(bool                 messageTypeNone         READ messageTypeNone                                        NOTIFY messageTypeChanged)
@@ -883,7 +886,13 @@ public:
     QString prearmError() const { return _prearmError; }
     void setPrearmError(const QString& prearmError);
 
-    QmlObjectListModel* cameraTriggerPoints () { return &_cameraTriggerPoints; }
+    CameraTriggerPoints* cameraTriggerPoints() { return _cameraTriggerPoints; }
+
+    GeoFenceBreachMonitor* geoFenceBreachMonitor() { return _geoFenceBreachMonitor; }
+
+    /// Ground velocity in m/s from the most recent position update
+    double velocityNorth() const { return _velocityNorth; }
+    double velocityEast () const { return _velocityEast; }
 
     int  flowImageIndex() { return _flowImageIndex; }
 
@@ -1258,6 +1267,7 @@ private slots:
     void _rallyPointLoadComplete        ();
     void _sendMavCommandAgain           ();
     void _clearCameraTriggerPoints      ();
+    void _geoFenceBreachAnnouncement    ();
     void _updateDistanceHeadingToHome   ();
     void _updateHeadingToNextWP         ();
     void _updateDistanceToGCS           ();
@@ -1361,7 +1371,6 @@ private:
     QGCToolbox*         _toolbox;
     SettingsManager*    _settingsManager;
 
-    QTimer              _csvLogTimer;
     QFile               _csvLogFile;
 
     QList<LinkInterface*> _links;
@@ -1397,6 +1406,8 @@ private:
     uint32_t        _onboardControlSensorsUnhealthy;
     bool            _gpsRawIntMessageAvailable;
     bool            _globalPositionIntMessageAvailable;
+    double          _velocityNorth;
+    double          _velocityEast;
     double          _defaultCruiseSpeed;
     double          _defaultHoverSpeed;
     int             _telemetryRRSSI;
@@ -1473,13 +1484,13 @@ private:
     static const int _sendMessageMultipleRetries = 5;
     static const int _sendMessageMultipleIntraMessageDelay = 500;
 
-    QTimer  _sendMultipleTimer;
     int     _nextSendMessageMultipleIndex;
 
     QTime                           _flightTimer;
-    QTimer                          _flightTimeUpdater;
+    int                             _flightTimeUpdaterTaskId = 0;   ///< QGCFrameScheduler task
     TrajectoryPoints*               _trajectoryPoints;
-    QmlObjectListModel              _cameraTriggerPoints;
+    CameraTriggerPoints*            _cameraTriggerPoints;
+    GeoFenceBreachMonitor*          _geoFenceBreachMonitor;
     //QMap<QString, ADSBVehicle*>     _trafficVehicleMap;
 
     // Toolbox references
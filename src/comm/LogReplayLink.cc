@@ -165,27 +165,20 @@ void LogReplayLink::_writeBytes(const QByteArray bytes)
 /// @return A Unix timestamp in microseconds UTC for found message or 0 if parsing failed
 quint64 LogReplayLink::_parseTimestamp(const QByteArray& bytes)
 {
-    quint64 timestamp = qFromBigEndian(*((quint64*)(bytes.constData())));
-    quint64 currentTimestamp = ((quint64)QDateTime::currentMSecsSinceEpoch()) * 1000;
-    
-    // Now if the parsed timestamp is in the future, it must be an old file where the timestamp was stored as
-    // little endian, so switch it.
-    if (timestamp > currentTimestamp) {
-        timestamp = qbswap(timestamp);
+    if (bytes.size() < cbTimestamp) {
+        return 0;
     }
-    
-    return timestamp;
+    return TLogIndex::decodeTimestamp(bytes.constData(), static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000);
 }
 
 /// Reads the next mavlink message from the log
-///     @param bytes[output] Bytes for mavlink message
+///     @param bytes[output] Bytes for mavlink message are appended
 /// @return Unix timestamp in microseconds UTC for NEXT mavlink message or 0 if no message found
 quint64 LogReplayLink::_readNextMavlinkMessage(QByteArray& bytes)
 {
     char                nextByte;
     mavlink_status_t    status;
-
-    bytes.clear();
+    int                 messageStart = bytes.size();
 
     while (_logFile.getChar(&nextByte)) { // Loop over every byte
         mavlink_message_t message;
@@ -193,7 +186,7 @@ quint64 LogReplayLink::_readNextMavlinkMessage(QByteArray& bytes)
 
         if (status.parse_state == MAVLINK_PARSE_STATE_GOT_STX) {
             // This is the possible beginning of a mavlink message, clear any partial bytes
-            bytes.clear();
+            bytes.truncate(messageStart);
         }
         bytes.append(nextByte);
 
@@ -204,63 +197,38 @@ quint64 LogReplayLink::_readNextMavlinkMessage(QByteArray& bytes)
         }
     }
 
+    bytes.truncate(messageStart);
     return 0;
 }
 
-/// Seeks to the beginning of the next successfully parsed mavlink message in the log file.
-///     @param nextMsg[output] Parsed next message that was found
-/// @return A Unix timestamp in microseconds UTC for found message or 0 if parsing failed
-quint64 LogReplayLink::_seekToNextMavlinkMessage(mavlink_message_t* nextMsg)
+/// Positions the log at the first message at or after the specified time. The index gets us to within
+/// TLogIndex::kIndexStride messages, the remainder are stepped over.
+///     @return false: seek failed
+bool LogReplayLink::_seekToTimestamp(quint64 timestampUSecs)
 {
-    char                nextByte;
-    mavlink_status_t    status;
-    qint64              messageStartPos = -1;
+    TLogIndex::Entry entry = _logIndex.entryForTimestamp(timestampUSecs);
 
-    mavlink_reset_channel_status(_mavlinkChannel);
-
-    while (_logFile.getChar(&nextByte)) {
-        bool messageFound = mavlink_parse_char(_mavlinkChannel, nextByte, nextMsg, &status);
-
-        if (status.parse_state == MAVLINK_PARSE_STATE_GOT_STX) {
-            // This is the possible beginning of a mavlink message
-            messageStartPos = _logFile.pos() - 1;
-        }
-        
-        // If we've found a message, jump back to the start of the message, grab the timestamp,
-        // and go back to the end of this file.
-        if (messageFound && messageStartPos != -1) {
-            _logFile.seek(messageStartPos - cbTimestamp);
-            QByteArray rawTime = _logFile.read(cbTimestamp);
-            return _parseTimestamp(rawTime);
-        }
+    if (!_logFile.seek(entry.offset)) {
+        return false;
     }
-    
-    return 0;
-}
-
-quint64 LogReplayLink::_findLastTimestamp(void)
-{
-    char                nextByte;
-    mavlink_status_t    status;
-    quint64             lastTimestamp = 0;
-    mavlink_message_t   msg;
-
-    // We read through the entire file looking for the last good timestamp. This can be somewhat slow, but trying to work from the
-    // end of the file can be way slower due to all the seeking back and forth required. So instead we take the simple reliable approach.
-
-    _logFile.reset();
+    _logCurrentTimeUSecs = _parseTimestamp(_logFile.read(cbTimestamp));
     mavlink_reset_channel_status(_mavlinkChannel);
 
-    while (_logFile.bytesAvailable() > cbTimestamp) {
-        lastTimestamp = _parseTimestamp(_logFile.read(cbTimestamp));
-
-        bool endOfMessage = false;
-        while (!endOfMessage && _logFile.getChar(&nextByte)) {
-            endOfMessage = mavlink_parse_char(_mavlinkChannel, nextByte, &msg, &status);
+    QByteArray bytes;
+    while (_logCurrentTimeUSecs < timestampUSecs) {
+        qint64 recordStart = _logFile.pos();
+        quint64 nextTimeUSecs = _readNextMavlinkMessage(bytes);
+        if (_logFile.atEnd()) {
+            // Stay on the last message
+            _logFile.seek(recordStart);
+            mavlink_reset_channel_status(_mavlinkChannel);
+            break;
         }
+        _logCurrentTimeUSecs = nextTimeUSecs;
+        bytes.clear();
     }
 
-    return lastTimestamp;
+    return true;
 }
 
 bool LogReplayLink::_loadLogFile(void)
@@ -284,9 +252,14 @@ bool LogReplayLink::_loadLogFile(void)
     }
     logFileInfo.setFile(logFilename);
     _logFileSize = logFileInfo.size();
-    
-    startTimeUSecs = _parseTimestamp(_logFile.read(cbTimestamp));
-    endTimeUSecs = _findLastTimestamp();
+
+    // Building the index is the only full pass over the log. It is cached next to the log so it only happens once.
+    if (!_logIndex.load(_logFile, logFilename, _mavlinkChannel)) {
+        errorMsg = tr("The log file '%1' is corrupt or empty.").arg(logFilename);
+        goto Error;
+    }
+    startTimeUSecs = _logIndex.startTimestamp();
+    endTimeUSecs = _logIndex.endTimestamp();
 
     if (endTimeUSecs <= startTimeUSecs) {
         errorMsg = tr("The log file '%1' is corrupt or empty.").arg(logFilename);
@@ -299,8 +272,11 @@ bool LogReplayLink::_loadLogFile(void)
     _logDurationUSecs = endTimeUSecs - startTimeUSecs;
     _logCurrentTimeUSecs = startTimeUSecs;
 
-    // Reset our log file so when we go to read it for the first time, we start at the beginning.
-    _logFile.reset();
+    // Position at the first message so when we go to read it for the first time, we start at the beginning.
+    if (!_seekToTimestamp(startTimeUSecs)) {
+        errorMsg = tr("Unable to seek to new position");
+        goto Error;
+    }
 
     logDurationSecondsTotal = (_logDurationUSecs) / 1000000;
     
@@ -316,48 +292,58 @@ Error:
     return false;
 }
 
-/// This function will read the next available log entry. It will then start
-/// the _readTickTimer timer to read the new log entry at the appropriate time.
-/// It might not perfectly match the timing of the log file, but it will never
-/// induce a static drift into the log file replay.
+/// This function will read all log entries which are due and deliver them to the application in a single
+/// batch. It will then start the _readTickTimer timer to read the next entries at the appropriate time.
+/// It might not perfectly match the timing of the log file, but it will never induce a static drift into
+/// the log file replay.
 void LogReplayLink::_readNextLogEntry(void)
 {
     QByteArray bytes;
 
     // Now parse MAVLink messages, grabbing their timestamps as we go. We stop once we
-    // have at least 3ms until the next one.
+    // have at least _minTickMSecs until the next one.
 
     // We track what the next execution time should be in milliseconds, which we use to set
     // the next timer interrupt.
-    int timeToNextExecutionMSecs = 0;
+    qint64  timeToNextExecutionMSecs = 0;
+    bool    fastAsPossible = _playbackSpeed <= 0;
+    int     messageCount = 0;
+    quint64 currentTimeMSecs = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch());
 
-    while (timeToNextExecutionMSecs < 3) {
+    while (timeToNextExecutionMSecs < _minTickMSecs) {
         // Read the next mavlink message from the log
-        qint64 nextTimeUSecs = _readNextMavlinkMessage(bytes);
-        emit bytesReceived(this, bytes);
-        emit playbackPercentCompleteChanged(((float)(_logCurrentTimeUSecs - _logStartTimeUSecs) / (float)_logDurationUSecs) * 100);
+        quint64 nextTimeUSecs = _readNextMavlinkMessage(bytes);
 
         if (_logFile.atEnd()) {
+            emit bytesReceived(this, bytes);
             _finishPlayback();
             return;
         }
 
         _logCurrentTimeUSecs = nextTimeUSecs;
 
+        if (fastAsPossible) {
+            if (++messageCount >= _maxFastBatchMessages) {
+                break;
+            }
+            continue;
+        }
+
         // Calculate how long we should wait in real time until parsing this message.
         // We pace ourselves relative to the start time of playback to fix any drift (initially set in play())
-
-        quint64 currentTimeMSecs =                  (quint64)QDateTime::currentMSecsSinceEpoch();
         quint64 desiredPlayheadMovementTimeMSecs =  ((_logCurrentTimeUSecs - _playbackStartLogTimeUSecs) / 1000) / _playbackSpeed;
         quint64 desiredCurrentTimeMSecs =           _playbackStartTimeMSecs + desiredPlayheadMovementTimeMSecs;
 
-        timeToNextExecutionMSecs = desiredCurrentTimeMSecs - currentTimeMSecs;
+        timeToNextExecutionMSecs = static_cast<qint64>(desiredCurrentTimeMSecs - currentTimeMSecs);
     }
 
+    // A single delivery per tick keeps high speed replay from flooding the application with one signal per message
+    emit bytesReceived(this, bytes);
+    emit playbackPercentCompleteChanged(((float)(_logCurrentTimeUSecs - _logStartTimeUSecs) / (float)_logDurationUSecs) * 100);
     _signalCurrentLogTimeSecs();
 
-    // And schedule the next execution of this function.
-    _readTickTimer.start(timeToNextExecutionMSecs);
+    // And schedule the next execution of this function. Replay as fast as possible still yields once per batch.
+    _readTickTimer.start(static_cast<int>(qMax(timeToNextExecutionMSecs, static_cast<qint64>(1))));
 }
 
 void LogReplayLink::_play(void)
@@ -394,7 +380,7 @@ void LogReplayLink::_pause(void)
 void LogReplayLink::_resetPlaybackToBeginning(void)
 {
     if (_logFile.isOpen()) {
-        _logFile.reset();
+        _seekToTimestamp(_logStartTimeUSecs);
     }
     
     // And since we haven't starting playback, clear the time of initial playback and the current timestamp.
@@ -422,44 +408,17 @@ void LogReplayLink::movePlayhead(qreal percentComplete)
     }
     
     qreal percentCompleteMult = percentComplete / 100.0;
-    
-    // But if we have a timestamped MAVLink log, then actually aim to hit that percentage in terms of
-    // time through the file.
-    qint64 newFilePos = (qint64)(percentCompleteMult * (qreal)_logFile.size());
-
-    // Now seek to the appropriate position, failing gracefully if we can't.
-    if (!_logFile.seek(newFilePos)) {
-        _replayError(tr("Unable to seek to new position"));
-        return;
-    }
-
-    // But we do align to the next MAVLink message for consistency.
-    mavlink_message_t dummy;
-    _logCurrentTimeUSecs = _seekToNextMavlinkMessage(&dummy);
 
-    // Now calculate the current file location based on time.
-    qreal newRelativeTimeUSecs = (qreal)(_logCurrentTimeUSecs - _logStartTimeUSecs);
-
-    // Calculate the effective baud rate of the file in bytes/s.
-    qreal baudRate = _logFile.size() / (qreal)_logDurationUSecs / 1e6;
-
-    // And the desired time is:
-    qreal desiredTimeUSecs = percentCompleteMult * _logDurationUSecs;
-
-    // And now jump the necessary number of bytes in the proper direction
-    qint64 offset = (newRelativeTimeUSecs - desiredTimeUSecs) * baudRate;
-    if (!_logFile.seek(_logFile.pos() + offset)) {
+    // Jump straight to the desired time through the index
+    quint64 desiredTimeUSecs = _logStartTimeUSecs + static_cast<quint64>(percentCompleteMult * _logDurationUSecs);
+    if (!_seekToTimestamp(desiredTimeUSecs)) {
         _replayError(tr("Unable to seek to new position"));
         return;
     }
-
-    // And scan until we reach the start of a MAVLink message. We make sure to record this timestamp for
-    // smooth jumping around the file.
-    _logCurrentTimeUSecs = _seekToNextMavlinkMessage(&dummy);
     _signalCurrentLogTimeSecs();
 
     // Now update the UI with our actual final position.
-    newRelativeTimeUSecs = (qreal)(_logCurrentTimeUSecs - _logStartTimeUSecs);
+    qreal newRelativeTimeUSecs = (qreal)(_logCurrentTimeUSecs - _logStartTimeUSecs);
     percentComplete = (newRelativeTimeUSecs / _logDurationUSecs) * 100;
     emit playbackPercentCompleteChanged(percentComplete);
 }
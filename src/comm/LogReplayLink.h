@@ -11,6 +11,7 @@
 
 #include "LinkManager.h"
 #include "MAVLinkProtocol.h"
+#include "TLogIndex.h"
 
 #include <QTimer>
 #include <QFile>
@@ -76,7 +77,7 @@ public:
     bool disconnect (void);
 
 public slots:
-    /// Sets the acceleration factor: -100: 0.01X, 0: 1.0X, 100: 100.0X
+    /// Sets the playback speed multiplier. A speed of 0 replays the log as fast as it can be processed.
     void setPlaybackSpeed(qreal playbackSpeed) { emit _setPlaybackSpeedOnThread(playbackSpeed); }
 
 private slots:
@@ -108,8 +109,7 @@ private:
 
     void    _replayError                (const QString& errorMsg);
     quint64 _parseTimestamp             (const QByteArray& bytes);
-    quint64 _seekToNextMavlinkMessage   (mavlink_message_t* nextMsg);
-    quint64 _findLastTimestamp          (void);
+    bool    _seekToTimestamp            (quint64 timestampUSecs);
     quint64 _readNextMavlinkMessage     (QByteArray& bytes);
     bool    _loadLogFile                (void);
     void    _finishPlayback             (void);
@@ -143,8 +143,11 @@ private:
     MAVLinkProtocol*    _mavlink;
     QFile               _logFile;
     quint64             _logFileSize;
+    TLogIndex           _logIndex;
 
-    static const int cbTimestamp = sizeof(quint64);
+    static const int cbTimestamp =              TLogIndex::cbTimestamp;
+    static const int _minTickMSecs =            3;      ///< Messages due within this time are delivered in the current tick
+    static const int _maxFastBatchMessages =    1000;   ///< Messages delivered per tick when replaying as fast as possible
 };
 
 class LogReplayLinkController : public QObject
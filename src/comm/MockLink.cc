@@ -14,6 +14,7 @@
 
 #ifdef UNITTEST_BUILD
 #include "UnitTest.h"
+#include "PackedParameterFile.h"
 #endif
 
 #include <QTimer>
@@ -80,6 +81,8 @@ MockLink::MockLink(SharedLinkConfigurationPointer& config)
     , _currentParamRequestListParamIndex    (-1)
     , _logDownloadCurrentOffset             (0)
     , _logDownloadBytesRemaining            (0)
+    , _logDownloadDisorder                  (false)
+    , _logDownloadRequestCount              (0)
     , _adsbAngle                            (0)
 {
     MockConfiguration* mockConfig = qobject_cast<MockConfiguration*>(_config.data());
@@ -302,6 +305,23 @@ void MockLink::_loadParams(void)
     }
 }
 
+bool MockLink::ftpFileContents(const QString& path, QByteArray& contents)
+{
+    // ArduPilot provides the full parameter set for the autopilot as a packed parameter file. Parameter failure modes disable
+    // it so those tests exercise the PARAM_REQUEST_LIST protocol.
+    if (_firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA && path == QStringLiteral("@PARAM/param.pck") && _failureMode == MockConfiguration::FailNone) {
+        QList<PackedParameterFile::Parameter> parameters;
+
+        for (const QString& paramName: _mapParamName2Value[_vehicleComponentId].keys()) {
+            parameters.append({ paramName, _mapParamName2MavParamType[_vehicleComponentId][paramName], _mapParamName2Value[_vehicleComponentId][paramName] });
+        }
+        contents = PackedParameterFile::encode(parameters);
+        return true;
+    }
+
+    return false;
+}
+
 void MockLink::_sendHeartBeat(void)
 {
     mavlink_message_t   msg;
@@ -1330,14 +1350,73 @@ void MockLink::_handleLogRequestData(const mavlink_message_t& msg)
         return;
     }
 
-    // This will trigger _logDownloadWorker to send data
-    _logDownloadCurrentOffset = request.ofs;
+    _logDownloadRequestCount++;
+
     if (request.ofs + request.count > _logDownloadFileSize) {
         request.count = _logDownloadFileSize - request.ofs;
     }
+
+    if (_logDownloadDisorder) {
+        _sendDisorderedLogData(request.ofs, request.count);
+        return;
+    }
+
+    // This will trigger _logDownloadWorker to send data
+    _logDownloadCurrentOffset = request.ofs;
     _logDownloadBytesRemaining = request.count;
 }
 
+void MockLink::_sendDisorderedLogData(uint32_t offset, uint32_t count)
+{
+    QFile file(_logDownloadFilename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "MockLink::_sendDisorderedLogData open failed" << file.errorString();
+        return;
+    }
+    QByteArray contents = file.readAll();
+
+    const uint32_t  binSize = MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    QList<uint32_t> binOffsets;
+    for (uint32_t binOffset=offset; binOffset<offset + count; binOffset+=binSize) {
+        binOffsets.append(binOffset);
+    }
+
+    if (_logDownloadRequestCount == 1) {
+        // Lose a bin from the middle and swap the bins before it in pairs. The last bin still comes last, so the end of
+        // the request is seen once everything else has had a chance to arrive.
+        if (binOffsets.count() > 2) {
+            int droppedIndex = binOffsets.count() / 2;
+            binOffsets.removeAt(droppedIndex);
+            for (int i=0; i + 1 < droppedIndex; i+=2) {
+                binOffsets.swap(i, i + 1);
+            }
+        }
+    } else {
+        // Late repeat of the next to last bin of the file, which is beyond any later request
+        uint32_t lateOffset = (qMax(_logDownloadFileSize - 1, binSize) / binSize - 1) * binSize;
+        if (lateOffset >= offset + count) {
+            binOffsets.prepend(lateOffset);
+        }
+    }
+
+    for (uint32_t binOffset: binOffsets) {
+        uint8_t buffer[MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN];
+        uint8_t bytes = static_cast<uint8_t>(qMin(binSize, _logDownloadFileSize - binOffset));
+        memcpy(buffer, contents.constData() + binOffset, bytes);
+
+        mavlink_message_t responseMsg;
+        mavlink_msg_log_data_pack_chan(_vehicleSystemId,
+                                       _vehicleComponentId,
+                                       _mavlinkChannel,
+                                       &responseMsg,
+                                       _logDownloadLogId,
+                                       binOffset,
+                                       bytes,
+                                       &buffer[0]);
+        respondWithMavlinkMessage(responseMsg);
+    }
+}
+
 void MockLink::_logDownloadWorker(void)
 {
     if (_logDownloadBytesRemaining != 0) {
@@ -120,6 +120,12 @@ public:
 
     MockLinkFileServer* getFileServer(void) { return _fileServer; }
 
+    /// Returns the contents of files which are simulated by the FTP server other than the file server test cases
+    ///     @param path Fully qualified path of file
+    ///     @param[out] contents File contents
+    /// @return true: file exists, false: no such file
+    bool ftpFileContents(const QString& path, QByteArray& contents);
+
     // Virtuals from LinkInterface
     virtual QString getName(void) const { return _name; }
     virtual void requestReset(void){ }
@@ -151,6 +157,13 @@ public:
     /// Returns the filename for the simulated log file. Only available after a download is requested.
     QString logDownloadFile(void) { return _logDownloadFilename; }
 
+    /// Answers log data requests the way a lossy link delivers them. The first request is answered with one bin missing and
+    /// neighbouring bins swapped, later requests are preceded by a late repeat of a bin from the first request.
+    void setLogDownloadDisorder(bool logDownloadDisorder) { _logDownloadDisorder = logDownloadDisorder; }
+
+    /// @return Number of LOG_REQUEST_DATA messages received
+    int logDownloadRequestCount(void) const { return _logDownloadRequestCount; }
+
     static MockLink* startPX4MockLink            (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
     static MockLink* startGenericMockLink        (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
     static MockLink* startAPMArduCopterMockLink  (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
@@ -202,6 +215,7 @@ private:
     void _sendRCChannels(void);
     void _paramRequestListWorker(void);
     void _logDownloadWorker(void);
+    void _sendDisorderedLogData(uint32_t offset, uint32_t count);
     void _sendADSBVehicles(void);
     void _moveADSBVehicle(void);
 
@@ -254,6 +268,8 @@ private:
     QString _logDownloadFilename;           ///< Filename for log download which is in progress
     uint32_t    _logDownloadCurrentOffset;  ///< Current offset we are sending from
     uint32_t    _logDownloadBytesRemaining; ///< Number of bytes still to send, 0 = send inactive
+    bool        _logDownloadDisorder;
+    int         _logDownloadRequestCount;
 
     QGeoCoordinate  _adsbVehicleCoordinate;
     double          _adsbAngle;
@@ -39,7 +39,9 @@ MockLinkFileServer::MockLinkFileServer(uint8_t systemIdServer, uint8_t component
     _mockLink(mockLink),
     _lastReplyValid(false),
     _lastReplySequence(0),
-    _randomDropsEnabled(false)
+    _randomDropsEnabled(false),
+    _burstDisorder(false),
+    _readRequestCount(0)
 {
     srand(0); // make sure unit tests are deterministic
 }
@@ -128,13 +130,24 @@ void MockLinkFileServer::_openCommand(uint8_t senderSystemId, uint8_t senderComp
     // Check path against one of our known test cases
 
     bool found = false;
-    for (size_t i=0; i<cFileTestCases; i++) {
+    _readFileData.clear();
+    _readRequestCount = 0;
+    if (_files.contains(path)) {
+        found = true;
+        _readFileData = _files[path];
+        _readFileLength = static_cast<uint32_t>(_readFileData.size());
+    }
+    for (size_t i=0; !found && i<cFileTestCases; i++) {
         if (path == rgFileTestCases[i].filename) {
             found = true;
             _readFileLength = rgFileTestCases[i].length;
             break;
         }
     }
+    if (!found && _mockLink->ftpFileContents(path, _readFileData)) {
+        found = true;
+        _readFileLength = static_cast<uint32_t>(_readFileData.size());
+    }
     if (!found) {
         _sendNak(senderSystemId, senderComponentId, FileManager::kErrFail, outgoingSeqNumber, FileManager::kCmdOpenFileRO);
         return;
@@ -163,6 +176,8 @@ void MockLinkFileServer::_readCommand(uint8_t senderSystemId, uint8_t senderComp
     
     uint32_t readOffset = request->hdr.offset;  // offset into file for reading
     uint8_t cDataBytes = 0;                     // current number of data bytes used
+
+    _readRequestCount++;
     
     if (readOffset != 0) {
         // If we get here it means the client is requesting additional data past the first request
@@ -181,10 +196,8 @@ void MockLinkFileServer::_readCommand(uint8_t senderSystemId, uint8_t senderComp
         return;
     }
     
-    // Write file bytes. Data is a repeating sequence of 0x00, 0x01, .. 0xFF.
-    for (; cDataBytes < sizeof(response.data) && readOffset < _readFileLength; readOffset++, cDataBytes++) {
-        response.data[cDataBytes] = readOffset & 0xFF;
-    }
+    cDataBytes = static_cast<uint8_t>(qMin(static_cast<uint32_t>(sizeof(response.data)), _readFileLength - readOffset));
+    _fillReadData(response.data, readOffset, cDataBytes);
     
     // We should always have written something, otherwise there is something wrong with the code above
     Q_ASSERT(cDataBytes);
@@ -198,6 +211,18 @@ void MockLinkFileServer::_readCommand(uint8_t senderSystemId, uint8_t senderComp
     _sendResponse(senderSystemId, senderComponentId, &response, outgoingSeqNumber);
 }
 
+/// Fills in file data for the specified range. Data for test case files is a repeating sequence of 0x00, 0x01, .. 0xFF.
+void MockLinkFileServer::_fillReadData(uint8_t* data, uint32_t offset, uint8_t cBytes)
+{
+    if (_readFileData.isEmpty()) {
+        for (uint8_t i=0; i<cBytes; i++) {
+            data[i] = (offset + i) & 0xFF;
+        }
+    } else {
+        memcpy(data, _readFileData.constData() + offset, cBytes);
+    }
+}
+
 void MockLinkFileServer::_streamCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber)
 {
     uint16_t                outgoingSeqNumber = _nextSeqNumber(seqNumber);
@@ -207,6 +232,11 @@ void MockLinkFileServer::_streamCommand(uint8_t senderSystemId, uint8_t senderCo
 		_sendNak(senderSystemId, senderComponentId, FileManager::kErrFail, outgoingSeqNumber, FileManager::kCmdBurstReadFile);
         return;
     }
+
+    if (_burstDisorder) {
+        _disorderedStreamCommand(senderSystemId, senderComponentId, seqNumber);
+        return;
+    }
     
     uint32_t readOffset = 0;	// offset into file for reading
     uint32_t ackOffset = 0;     // offset for ack
@@ -227,10 +257,9 @@ void MockLinkFileServer::_streamCommand(uint8_t senderSystemId, uint8_t senderCo
             }
         }
         
-        // Write file bytes. Data is a repeating sequence of 0x00, 0x01, .. 0xFF.
-        for (; cDataAck < sizeof(response.data) && readOffset < _readFileLength; readOffset++, cDataAck++) {
-            response.data[cDataAck] = readOffset & 0xFF;
-        }
+        cDataAck = static_cast<uint8_t>(qMin(static_cast<uint32_t>(sizeof(response.data)), _readFileLength - readOffset));
+        _fillReadData(response.data, readOffset, cDataAck);
+        readOffset += cDataAck;
         
         // We should always have written something, otherwise there is something wrong with the code above
         Q_ASSERT(cDataAck);
@@ -250,6 +279,56 @@ void MockLinkFileServer::_streamCommand(uint8_t senderSystemId, uint8_t senderCo
     _sendNak(senderSystemId, senderComponentId, FileManager::kErrEOF, outgoingSeqNumber, FileManager::kCmdBurstReadFile);
 }
 
+/// Sends the whole file as a burst the way a lossy link would deliver it. Each packet keeps the sequence number it would
+/// have had in order.
+void MockLinkFileServer::_disorderedStreamCommand(uint8_t senderSystemId, uint8_t senderComponentId, uint16_t seqNumber)
+{
+    QList<FileManager::Request> packets;
+    uint16_t                    outgoingSeqNumber = seqNumber;
+
+    for (uint32_t readOffset=0; readOffset<_readFileLength; ) {
+        FileManager::Request response;
+
+        memset(&response, 0, sizeof(response));
+        response.hdr.size =         static_cast<uint8_t>(qMin(static_cast<uint32_t>(sizeof(response.data)), _readFileLength - readOffset));
+        response.hdr.session =      _sessionId;
+        response.hdr.offset =       readOffset;
+        response.hdr.opcode =       FileManager::kRspAck;
+        response.hdr.req_opcode =   FileManager::kCmdBurstReadFile;
+        _fillReadData(response.data, readOffset, response.hdr.size);
+        outgoingSeqNumber = _nextSeqNumber(outgoingSeqNumber);
+        response.hdr.seqNumber = outgoingSeqNumber;
+        packets.append(response);
+
+        readOffset += response.hdr.size;
+    }
+
+    QList<FileManager::Request> sendOrder;
+    for (int i=0; i<packets.count(); i++) {
+        if (i % 7 == 3 || i == packets.count() - 1) {
+            // Dropped
+            continue;
+        }
+        if (i % 4 == 0 && i + 1 < packets.count() - 1 && (i + 1) % 7 != 3) {
+            // Delivered after the following packet
+            sendOrder.append(packets[i + 1]);
+            sendOrder.append(packets[i]);
+            i++;
+            continue;
+        }
+        sendOrder.append(packets[i]);
+        if (i % 5 == 1) {
+            // Duplicated
+            sendOrder.append(packets[i]);
+        }
+    }
+
+    for (FileManager::Request& packet: sendOrder) {
+        _sendResponse(senderSystemId, senderComponentId, &packet, packet.hdr.seqNumber);
+    }
+    _sendNak(senderSystemId, senderComponentId, FileManager::kErrEOF, _nextSeqNumber(outgoingSeqNumber), FileManager::kCmdBurstReadFile);
+}
+
 void MockLinkFileServer::_terminateCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber)
 {
     uint16_t outgoingSeqNumber = _nextSeqNumber(seqNumber);
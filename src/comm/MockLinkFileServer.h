@@ -16,6 +16,7 @@
 #include "FileManager.h"
 
 #include <QStringList>
+#include <QMap>
 
 class MockLink;
 
@@ -71,6 +72,16 @@ public:
     
     void enableRandromDrops(bool enable) { _randomDropsEnabled = enable; }
 
+    /// Adds a file of any size which can be downloaded in addition to the file test cases
+    void addFile(const QString& path, const QByteArray& contents) { _files[path] = contents; }
+
+    /// Simulates a lossy link for burst downloads. A fixed pattern of burst packets is dropped, duplicated or delivered out
+    /// of order, including the last packet of the burst.
+    void setBurstDisorder(bool burstDisorder) { _burstDisorder = burstDisorder; }
+
+    /// @return Number of read requests received since the last open command
+    int readRequestCount(void) const { return _readRequestCount; }
+
 signals:
     /// You can connect to this signal to be notified when the server receives a Terminate command.
     void terminateCommandReceived(void);
@@ -86,6 +97,7 @@ private:
     void _openCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
     void _readCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
 	void _streamCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
+    void _disorderedStreamCommand(uint8_t senderSystemId, uint8_t senderComponentId, uint16_t seqNumber);
     void _terminateCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
     void _resetCommand(uint8_t senderSystemId, uint8_t senderComponentId, uint16_t seqNumber);
     uint16_t _nextSeqNumber(uint16_t seqNumber);
@@ -95,8 +107,11 @@ private:
 
     QStringList _fileList;  ///< List of files returned by List command
     
+    void _fillReadData(uint8_t* data, uint32_t offset, uint8_t cBytes);
+
     static const uint8_t    _sessionId;
-    uint8_t                 _readFileLength;    ///< Length of active file being read
+    uint32_t                _readFileLength;    ///< Length of active file being read
+    QByteArray              _readFileData;      ///< Contents of active file being read, empty for generated test case data
     ErrorMode_t             _errMode;           ///< Currently set error mode, as specified by setErrorMode
     const uint8_t           _systemIdServer;    ///< System ID for server
     const uint8_t           _componentIdServer; ///< Component ID for server
@@ -107,5 +122,9 @@ private:
     mavlink_message_t _lastReply;
 
     bool _randomDropsEnabled;
+
+    QMap<QString, QByteArray>   _files;                 ///< Files added through addFile
+    bool                        _burstDisorder;
+    int                         _readRequestCount;
 };
 
@@ -0,0 +1,213 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TLogIndex.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <algorithm>
+
+QGC_LOGGING_CATEGORY(TLogIndexLog, "TLogIndexLog")
+
+TLogIndex::TLogIndex(void)
+    : _startTimestamp   (0)
+    , _endTimestamp     (0)
+    , _messageCount     (0)
+{
+
+}
+
+void TLogIndex::clear(void)
+{
+    _startTimestamp = 0;
+    _endTimestamp   = 0;
+    _messageCount   = 0;
+    _entries.clear();
+}
+
+quint64 TLogIndex::_fixTimestampEndianness(quint64 timestamp, quint64 currentTimeUSecs)
+{
+    return timestamp > currentTimeUSecs ? qbswap(timestamp) : timestamp;
+}
+
+quint64 TLogIndex::decodeTimestamp(const char* bytes, quint64 currentTimeUSecs)
+{
+    return _fixTimestampEndianness(qFromBigEndian<quint64>(bytes), currentTimeUSecs);
+}
+
+bool TLogIndex::load(QIODevice& log, const QString& logFilename, uint8_t mavlinkChannel)
+{
+    if (_loadCache(logFilename)) {
+        return true;
+    }
+
+    if (!build(log, mavlinkChannel)) {
+        return false;
+    }
+    _saveCache(logFilename);
+
+    return true;
+}
+
+bool TLogIndex::build(QIODevice& log, uint8_t mavlinkChannel)
+{
+    clear();
+
+    if (!log.seek(0)) {
+        return false;
+    }
+
+    scanLog(log, mavlinkChannel, [this](quint64 timestamp, qint64 recordOffset, const mavlink_message_t& /* message */) {
+        if (_messageCount % kIndexStride == 0) {
+            _entries.append({ timestamp, recordOffset });
+        }
+        if (_messageCount == 0) {
+            _startTimestamp = timestamp;
+        }
+        _endTimestamp = timestamp;
+        _messageCount++;
+    });
+
+    log.seek(0);
+
+    qCDebug(TLogIndexLog) << "Built index messages:entries:start:end" << _messageCount << _entries.count() << _startTimestamp << _endTimestamp;
+
+    return !_entries.isEmpty();
+}
+
+quint64 TLogIndex::scanLog(QIODevice& log, uint8_t mavlinkChannel, const MessageCallback& callback)
+{
+    quint64             currentTimeUSecs    = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000;
+    quint64             recentBytes         = 0;    // Last eight bytes read, as a big endian value
+    quint64             messageCount        = 0;
+    qint64              filePos             = log.pos();
+    qint64              recordOffset        = -1;
+    quint64             recordTimestamp     = 0;
+    mavlink_message_t   message;
+    mavlink_status_t    status;
+    QByteArray          buffer(_readChunkSize, Qt::Uninitialized);
+
+    mavlink_reset_channel_status(mavlinkChannel);
+
+    // The log is parsed in large chunks rather than a byte at a time from the device. The timestamp for a message is the
+    // eight bytes preceding its start byte, which are always available from recentBytes regardless of chunk boundaries.
+    qint64 bytesRead;
+    while ((bytesRead = log.read(buffer.data(), _readChunkSize)) > 0) {
+        const uchar* bytes = reinterpret_cast<const uchar*>(buffer.constData());
+
+        for (qint64 i=0; i<bytesRead; i++, filePos++) {
+            bool messageFound = mavlink_parse_char(mavlinkChannel, bytes[i], &message, &status);
+
+            if (status.parse_state == MAVLINK_PARSE_STATE_GOT_STX) {
+                recordOffset    = filePos - cbTimestamp;
+                recordTimestamp = recentBytes;
+            }
+            recentBytes = (recentBytes << 8) | bytes[i];
+
+            if (messageFound && recordOffset >= 0) {
+                callback(_fixTimestampEndianness(recordTimestamp, currentTimeUSecs), recordOffset, message);
+                messageCount++;
+                recordOffset = -1;
+            }
+        }
+    }
+
+    mavlink_reset_channel_status(mavlinkChannel);
+
+    return messageCount;
+}
+
+TLogIndex::Entry TLogIndex::entryForTimestamp(quint64 timestamp) const
+{
+    if (_entries.isEmpty()) {
+        return { 0, 0 };
+    }
+
+    auto it = std::upper_bound(_entries.cbegin(), _entries.cend(), timestamp, [](quint64 value, const Entry& entry) { return value < entry.timestamp; });
+    if (it != _entries.cbegin()) {
+        it--;
+    }
+
+    return *it;
+}
+
+bool TLogIndex::_loadCache(const QString& logFilename)
+{
+    clear();
+
+    QFile file(cacheFilename(logFilename));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QFileInfo   logInfo(logFilename);
+    QDataStream ds(&file);
+    ds.setVersion(QDataStream::Qt_5_9);
+
+    // The cache is only valid for the exact log it was built from
+    quint32 magic, version, stride, entryCount;
+    qint64  logSize, logModified;
+    ds >> magic >> version >> stride >> logSize >> logModified;
+    if (ds.status() != QDataStream::Ok || magic != _cacheFileMagic || version != _cacheFileVersion || stride != static_cast<quint32>(kIndexStride) ||
+            logSize != logInfo.size() || logModified != logInfo.lastModified().toMSecsSinceEpoch()) {
+        qCDebug(TLogIndexLog) << "Discarding stale index cache" << file.fileName();
+        return false;
+    }
+
+    ds >> _startTimestamp >> _endTimestamp >> _messageCount >> entryCount;
+
+    // The entry count comes from the file, so it must match the message count and fit in the rest of the file before
+    // anything is allocated for it
+    const qint64 maxEntryCount = (file.size() - file.pos()) / _cacheEntrySize;
+    if (ds.status() != QDataStream::Ok || entryCount > maxEntryCount ||
+            static_cast<quint64>(entryCount) != (_messageCount + kIndexStride - 1) / kIndexStride) {
+        qCWarning(TLogIndexLog) << "Index cache corrupt" << file.fileName();
+        clear();
+        return false;
+    }
+
+    _entries.resize(static_cast<int>(entryCount));
+    for (Entry& entry: _entries) {
+        ds >> entry.timestamp >> entry.offset;
+    }
+
+    if (ds.status() != QDataStream::Ok || _entries.isEmpty() || _entries.last().offset >= logSize) {
+        qCWarning(TLogIndexLog) << "Index cache truncated" << file.fileName();
+        clear();
+        return false;
+    }
+
+    qCDebug(TLogIndexLog) << "Loaded index cache" << file.fileName() << "messages:entries" << _messageCount << _entries.count();
+
+    return true;
+}
+
+void TLogIndex::_saveCache(const QString& logFilename) const
+{
+    // Failing to write the cache, for example when the log is in a read only location, only means the index is rebuilt next time
+    QFile file(cacheFilename(logFilename));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCDebug(TLogIndexLog) << "Unable to write index cache" << file.fileName() << file.errorString();
+        return;
+    }
+
+    QFileInfo   logInfo(logFilename);
+    QDataStream ds(&file);
+    ds.setVersion(QDataStream::Qt_5_9);
+
+    ds << _cacheFileMagic << _cacheFileVersion << static_cast<quint32>(kIndexStride) << logInfo.size() << logInfo.lastModified().toMSecsSinceEpoch();
+    ds << _startTimestamp << _endTimestamp << _messageCount << static_cast<quint32>(_entries.count());
+    for (const Entry& entry: _entries) {
+        ds << entry.timestamp << entry.offset;
+    }
+}
@@ -0,0 +1,93 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QIODevice>
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+#include <functional>
+
+#include "QGCLoggingCategory.h"
+#include "QGCMAVLink.h"
+
+Q_DECLARE_LOGGING_CATEGORY(TLogIndexLog)
+
+/// Timestamp index for a telemetry (.tlog) file. A tlog is a sequence of records, each a big endian quint64 timestamp in
+/// microseconds followed by a mavlink message.
+///
+/// The index holds the position of every kIndexStride'th record. It is built in a single pass over the log and cached next
+/// to it (<log>.qidx), so later loads of the same log do not read the log at all. Seeking to a time is a binary search
+/// followed by a scan over at most kIndexStride records.
+class TLogIndex
+{
+public:
+    /// Position of a tlog record
+    struct Entry {
+        quint64 timestamp;      ///< Record timestamp in microseconds UTC
+        qint64  offset;         ///< File offset of the record timestamp
+    };
+
+    TLogIndex(void);
+
+    /// Loads the cached index for the log if it is still valid, otherwise builds the index from the log and caches it.
+    ///     @param log Open log file
+    ///     @param mavlinkChannel Channel used for parsing while building
+    ///     @return true: index contains at least one message
+    bool load(QIODevice& log, const QString& logFilename, uint8_t mavlinkChannel);
+
+    /// Builds the index by parsing the entire log
+    bool build(QIODevice& log, uint8_t mavlinkChannel);
+
+    void clear(void);
+
+    bool                    isEmpty         (void) const { return _entries.isEmpty(); }
+    quint64                 startTimestamp  (void) const { return _startTimestamp; }
+    quint64                 endTimestamp    (void) const { return _endTimestamp; }
+    quint64                 messageCount    (void) const { return _messageCount; }
+    const QVector<Entry>&   entries         (void) const { return _entries; }
+
+    /// @return Index entry at or before the specified time, first entry if the time is before the start of the log
+    Entry entryForTimestamp(quint64 timestamp) const;
+
+    typedef std::function<void(quint64 timestamp, qint64 recordOffset, const mavlink_message_t& message)> MessageCallback;
+
+    /// Parses the entire log in large chunks, calling the callback for each complete message
+    ///     @return Number of messages found
+    static quint64 scanLog(QIODevice& log, uint8_t mavlinkChannel, const MessageCallback& callback);
+
+    /// Converts the raw big endian timestamp which precedes each message. Old logs stored the timestamp little endian,
+    /// these are detected by the timestamp being in the future.
+    static quint64 decodeTimestamp(const char* bytes, quint64 currentTimeUSecs);
+
+    static QString cacheFilename(const QString& logFilename) { return logFilename + QStringLiteral(".qidx"); }
+
+    /// Number of records between index entries
+    static const int kIndexStride = 32;
+
+    static const int cbTimestamp = sizeof(quint64);
+
+private:
+    bool _loadCache(const QString& logFilename);
+    void _saveCache(const QString& logFilename) const;
+
+    static quint64 _fixTimestampEndianness(quint64 timestamp, quint64 currentTimeUSecs);
+
+    quint64         _startTimestamp;
+    quint64         _endTimestamp;
+    quint64         _messageCount;
+    QVector<Entry>  _entries;
+
+    static const quint32 _cacheFileMagic =      0x51544c49; // "QTLI"
+    static const quint32 _cacheFileVersion =    1;
+    static const int     _readChunkSize =       1024 * 1024;
+    static const int     _cacheEntrySize =      sizeof(quint64) + sizeof(qint64);
+};
@@ -28,6 +28,7 @@
 #include <QStringListModel>
 #include "QGCApplication.h"
 #include "AppMessages.h"
+#include "TLogExporter.h"
 
 #ifndef __mobile__
     #include "QGCSerialPortInfo.h"
@@ -226,6 +227,11 @@ bool checkAndroidWritePermission() {
 int main(int argc, char *argv[])
 {
 #ifndef __mobile__
+    // Headless tlog export runs without the ui, and alongside a running instance
+    if (TLogExporter::isCommandLineExport(argc, argv)) {
+        return TLogExporter::runCommandLineExport(argc, argv);
+    }
+
     RunGuard guard("QGroundControlRunGuardKey");
     if (!guard.tryToRun()) {
         // QApplication is necessary to use QMessageBox
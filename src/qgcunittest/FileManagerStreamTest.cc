@@ -0,0 +1,102 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FileManagerStreamTest.h"
+#include "FileManager.h"
+#include "MockLink.h"
+#include "MockLinkFileServer.h"
+#include "MultiVehicleManager.h"
+#include "QGCApplication.h"
+#include "UAS.h"
+
+const char* FileManagerStreamTest::_streamFilename = "stream.qgc";
+
+void FileManagerStreamTest::init(void)
+{
+    UnitTest::init();
+
+    _connectMockLink();
+
+    _fileServer = _mockLink->getFileServer();
+    QVERIFY(_fileServer);
+    _fileManager = qgcApp()->toolbox()->multiVehicleManager()->activeVehicle()->uas()->getFileManager();
+    QVERIFY(_fileManager);
+
+    _downloadDir = new QTemporaryDir;
+    QVERIFY(_downloadDir->isValid());
+}
+
+void FileManagerStreamTest::cleanup(void)
+{
+    _fileServer->setBurstDisorder(false);
+    _fileServer = nullptr;
+    _fileManager = nullptr;
+
+    delete _downloadDir;
+    _downloadDir = nullptr;
+
+    UnitTest::cleanup();
+}
+
+/// Contents which do not repeat on packet boundaries, so a chunk written at the wrong offset is caught
+QByteArray FileManagerStreamTest::_fileContents(int length)
+{
+    QByteArray contents(length, 0);
+
+    for (int i=0; i<length; i++) {
+        contents[i] = static_cast<char>((i * 7 + i / 251) & 0xFF);
+    }
+
+    return contents;
+}
+
+void FileManagerStreamTest::_streamAndVerify(const QByteArray& contents)
+{
+    QSignalSpy spyComplete  (_fileManager, &FileManager::commandComplete);
+    QSignalSpy spyError     (_fileManager, &FileManager::commandError);
+
+    _fileServer->addFile(_streamFilename, contents);
+    _fileManager->streamPath(_streamFilename, QDir(_downloadDir->path()));
+    QVERIFY(spyComplete.wait(_streamTimeoutMSecs));
+    QCOMPARE(spyError.count(), 0);
+
+    QFile file(QDir(_downloadDir->path()).filePath(_streamFilename));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray downloaded = file.readAll();
+    QCOMPARE(downloaded.size(), contents.size());
+    QVERIFY(downloaded == contents);
+}
+
+void FileManagerStreamTest::_streamInOrder(void)
+{
+    _streamAndVerify(_fileContents(20 * 239 + 17));
+
+    // Nothing was missing, so nothing is read after the burst
+    QCOMPARE(_fileServer->readRequestCount(), 0);
+}
+
+void FileManagerStreamTest::_streamDisordered(void)
+{
+    // The burst loses packets in the middle and at the end, and delivers some twice or late. Everything missing must be
+    // refetched and written at the right offset.
+    _fileServer->setBurstDisorder(true);
+    _streamAndVerify(_fileContents(40 * 239 + 100));
+    QVERIFY(_fileServer->readRequestCount() > 0);
+}
+
+void FileManagerStreamTest::_streamMissingFile(void)
+{
+    QSignalSpy spyError(_fileManager, &FileManager::commandError);
+
+    _fileManager->streamPath("missing.qgc", QDir(_downloadDir->path()));
+    QVERIFY(spyError.wait(_streamTimeoutMSecs));
+
+    // No partial file is left behind
+    QVERIFY(!QFile::exists(QDir(_downloadDir->path()).filePath("missing.qgc")));
+}
@@ -0,0 +1,42 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QTemporaryDir>
+
+class FileManager;
+class MockLinkFileServer;
+
+/// Burst downloads through the MockLink file server, including reassembly of dropped, duplicated and reordered packets
+class FileManagerStreamTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init               (void);
+    void cleanup            (void);
+
+    void _streamInOrder     (void);
+    void _streamDisordered  (void);
+    void _streamMissingFile (void);
+
+private:
+    QByteArray  _fileContents   (int length);
+    void        _streamAndVerify(const QByteArray& contents);
+
+    FileManager*        _fileManager =  nullptr;
+    MockLinkFileServer* _fileServer =   nullptr;
+    QTemporaryDir*      _downloadDir =  nullptr;
+
+    static const char*  _streamFilename;
+    static const int    _streamTimeoutMSecs = 10000;
+};
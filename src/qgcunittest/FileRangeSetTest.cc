@@ -0,0 +1,108 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FileRangeSetTest.h"
+#include "FileRangeSet.h"
+
+typedef QList<QPair<uint32_t, uint32_t>> RangeList_t;   // offset, length
+
+Q_DECLARE_METATYPE(RangeList_t)
+
+void FileRangeSetTest::_merge_data(void)
+{
+    QTest::addColumn<RangeList_t>("added");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<uint>("totalLength");
+    QTest::addColumn<uint>("end");
+
+    QTest::newRow("Disjoint")           << RangeList_t({ { 0, 10 }, { 20, 10 } })                  << 2 << 20u << 30u;
+    QTest::newRow("Adjacent")           << RangeList_t({ { 0, 10 }, { 10, 10 } })                  << 1 << 20u << 20u;
+    QTest::newRow("Adjacent reversed")  << RangeList_t({ { 10, 10 }, { 0, 10 } })                  << 1 << 20u << 20u;
+    QTest::newRow("Overlapping")        << RangeList_t({ { 0, 15 }, { 10, 10 } })                  << 1 << 20u << 20u;
+    QTest::newRow("Contained")          << RangeList_t({ { 0, 30 }, { 10, 5 } })                   << 1 << 30u << 30u;
+    QTest::newRow("Duplicate")          << RangeList_t({ { 5, 10 }, { 5, 10 } })                   << 1 << 10u << 15u;
+    QTest::newRow("Bridging")           << RangeList_t({ { 0, 10 }, { 20, 10 }, { 40, 10 }, { 5, 40 } }) << 1 << 50u << 50u;
+    QTest::newRow("Empty range")        << RangeList_t({ { 0, 10 }, { 20, 0 } })                   << 1 << 10u << 10u;
+    QTest::newRow("Out of order")       << RangeList_t({ { 40, 10 }, { 0, 10 }, { 20, 10 }, { 10, 10 }, { 30, 10 } }) << 1 << 50u << 50u;
+}
+
+void FileRangeSetTest::_merge(void)
+{
+    QFETCH(RangeList_t, added);
+    QFETCH(int,         count);
+    QFETCH(uint,        totalLength);
+    QFETCH(uint,        end);
+
+    FileRangeSet rangeSet;
+    for (const auto& range: added) {
+        rangeSet.add(range.first, range.second);
+    }
+
+    QCOMPARE(rangeSet.count(), count);
+    QCOMPARE(rangeSet.totalLength(), static_cast<uint32_t>(totalLength));
+    QCOMPARE(rangeSet.end(), static_cast<uint32_t>(end));
+
+    rangeSet.clear();
+    QCOMPARE(rangeSet.count(), 0);
+    QCOMPARE(rangeSet.totalLength(), static_cast<uint32_t>(0));
+    QCOMPARE(rangeSet.end(), static_cast<uint32_t>(0));
+}
+
+void FileRangeSetTest::_holes(void)
+{
+    FileRangeSet rangeSet;
+
+    // Nothing received
+    QList<FileRangeSet::Range> holes = rangeSet.holes(100);
+    QCOMPARE(holes.count(), 1);
+    QCOMPARE(holes[0].offset, static_cast<uint32_t>(0));
+    QCOMPARE(holes[0].length, static_cast<uint32_t>(100));
+
+    // Holes at the start, between ranges and at the end
+    rangeSet.add(10, 20);
+    rangeSet.add(50, 10);
+    holes = rangeSet.holes(100);
+    QCOMPARE(holes.count(), 3);
+    QCOMPARE(holes[0].offset, static_cast<uint32_t>(0));
+    QCOMPARE(holes[0].length, static_cast<uint32_t>(10));
+    QCOMPARE(holes[1].offset, static_cast<uint32_t>(30));
+    QCOMPARE(holes[1].length, static_cast<uint32_t>(20));
+    QCOMPARE(holes[2].offset, static_cast<uint32_t>(60));
+    QCOMPARE(holes[2].length, static_cast<uint32_t>(40));
+
+    // Holes are limited to the specified size
+    holes = rangeSet.holes(40);
+    QCOMPARE(holes.count(), 2);
+    QCOMPARE(holes[1].offset, static_cast<uint32_t>(30));
+    QCOMPARE(holes[1].length, static_cast<uint32_t>(10));
+
+    // Filling the holes leaves none
+    rangeSet.add(0, 10);
+    rangeSet.add(30, 20);
+    rangeSet.add(60, 40);
+    QVERIFY(rangeSet.holes(100).isEmpty());
+    QCOMPARE(rangeSet.count(), 1);
+}
+
+void FileRangeSetTest::_contains(void)
+{
+    FileRangeSet rangeSet;
+
+    QVERIFY(!rangeSet.contains(0, 1));
+
+    rangeSet.add(10, 10);
+    rangeSet.add(30, 10);
+    QVERIFY(rangeSet.contains(10, 10));
+    QVERIFY(rangeSet.contains(12, 5));
+    QVERIFY(!rangeSet.contains(5, 10));
+    QVERIFY(!rangeSet.contains(15, 10));
+    QVERIFY(!rangeSet.contains(15, 20));
+    QVERIFY(!rangeSet.contains(20, 5));
+    QVERIFY(rangeSet.contains(30, 10));
+}
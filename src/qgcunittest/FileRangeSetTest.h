@@ -0,0 +1,23 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class FileRangeSetTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _merge_data    (void);
+    void _merge         (void);
+    void _holes         (void);
+    void _contains      (void);
+};
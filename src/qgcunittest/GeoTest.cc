@@ -91,3 +91,59 @@ void GeoTest::_convertNedToGeoAtOrigin_test(void)
     QCOMPARE(coord.longitude(), expectedLon);
     QCOMPARE(coord.altitude(), expectedAlt);
 }
+
+void GeoTest::_simplifyGeoPathOpen_test(void)
+{
+    // Straight line to the east with a 5 meter bump to the north in the middle
+    QList<QGeoCoordinate> path;
+    for (int i=0; i<=10; i++) {
+        QGeoCoordinate coord;
+        convertNedToGeo(i == 5 ? 5 : 0, i * 100, 0, _origin, &coord);
+        path.append(coord);
+    }
+
+    // The vertices next to the bump are 4 meters from the line to its tip
+    QList<QGeoCoordinate> simplified = simplifyGeoPath(path, 4.5, false /* closed */);
+    QCOMPARE(simplified.count(), 3);
+    QCOMPARE(simplified[0], path[0]);
+    QCOMPARE(simplified[1], path[5]);
+    QCOMPARE(simplified[2], path[10]);
+
+    simplified = simplifyGeoPath(path, 10, false /* closed */);
+    QCOMPARE(simplified.count(), 2);
+    QCOMPARE(simplified[0], path[0]);
+    QCOMPARE(simplified[1], path[10]);
+
+    // No tolerance or too few vertices leaves the path as is
+    QCOMPARE(simplifyGeoPath(path, 0, false /* closed */), path);
+    QCOMPARE(simplifyGeoPath(path.mid(0, 2), 10, false /* closed */), path.mid(0, 2));
+}
+
+void GeoTest::_simplifyGeoPathClosed_test(void)
+{
+    // 100 meter square with a vertex in the middle of each side, the last side ends back at the first vertex
+    const double rgNorthEast[][2] = { { 0, 0 }, { 50, 0 }, { 100, 0 }, { 100, 50 }, { 100, 100 }, { 50, 100 }, { 0, 100 }, { 0, 50 } };
+    QList<QGeoCoordinate> ring;
+    for (const auto& northEast: rgNorthEast) {
+        QGeoCoordinate coord;
+        convertNedToGeo(northEast[0], northEast[1], 0, _origin, &coord);
+        ring.append(coord);
+    }
+
+    QList<QGeoCoordinate> simplified = simplifyGeoPath(ring, 1, true /* closed */);
+    QCOMPARE(simplified.count(), 4);
+    QCOMPARE(simplified[0], ring[0]);
+    QCOMPARE(simplified[1], ring[2]);
+    QCOMPARE(simplified[2], ring[4]);
+    QCOMPARE(simplified[3], ring[6]);
+
+    // Starting in the middle of a side, the first vertex is always kept and the closing side is simplified as well
+    ring.append(ring.first());
+    ring.removeFirst();
+    simplified = simplifyGeoPath(ring, 1, true /* closed */);
+    QCOMPARE(simplified.count(), 5);
+    QCOMPARE(simplified[0], ring[0]);
+    QVERIFY(!simplified.contains(ring[2]));
+    QVERIFY(!simplified.contains(ring[4]));
+    QVERIFY(!simplified.contains(ring[6]));
+}
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCFrameSchedulerTest.h"
+#include "QGCFrameScheduler.h"
+#include "QGCApplication.h"
+#include "Vehicle.h"
+
+#include <numeric>
+
+/// Tasks registered at different times with the same interval must come due in the same wakeup
+void QGCFrameSchedulerTest::_sharedWakeups(void)
+{
+    const int           cTaskCount = 100;
+    QGCFrameScheduler   scheduler(qgcApp(), nullptr);
+    QObject             receiver;
+    QVector<int>        runCounts(cTaskCount, 0);
+
+    for (int i=0; i<cTaskCount; i++) {
+        scheduler.registerTask(&receiver, 100, [&runCounts, i]() { runCounts[i]++; });
+        if (i % 10 == 0) {
+            QTest::qWait(7);
+        }
+    }
+    QCOMPARE(scheduler.taskCount(), cTaskCount);
+
+    QTest::qWait(1050);
+
+    // Timers run late on loaded machines, so only the upper bound on the number of runs is exact
+    QGCFrameScheduler::Statistics statistics = scheduler.statistics();
+    for (int i=0; i<cTaskCount; i++) {
+        QVERIFY(runCounts[i] >= 3 && runCounts[i] <= 11);
+        QVERIFY(qAbs(runCounts[i] - runCounts[0]) <= 1);
+    }
+    QCOMPARE(statistics.taskRuns, static_cast<quint64>(std::accumulate(runCounts.begin(), runCounts.end(), 0)));
+
+    // A separate timer per task would have woken up once per run
+    QVERIFY(statistics.wakeups * 10 <= statistics.taskRuns);
+}
+
+void QGCFrameSchedulerTest::_inactiveTasks(void)
+{
+    QGCFrameScheduler   scheduler(qgcApp(), nullptr);
+    int                 runCount = 0;
+
+    int taskId = scheduler.registerTask(this, 20, [&runCount]() { runCount++; });
+    scheduler.setTaskActive(taskId, false);
+    QTest::qWait(100);
+    QCOMPARE(runCount, 0);
+    QCOMPARE(scheduler.statistics().wakeups, static_cast<quint64>(0));
+
+    scheduler.setTaskActive(taskId, true);
+    QTRY_VERIFY_WITH_TIMEOUT(runCount > 0, 1000);
+}
+
+void QGCFrameSchedulerTest::_removedTasks(void)
+{
+    QGCFrameScheduler   scheduler(qgcApp(), nullptr);
+    QObject*            receiver = new QObject;
+    int                 runCount = 0;
+    int                 otherRunCount = 0;
+
+    // Tasks go away with their receiver
+    scheduler.registerTask(receiver, 20, [&runCount]() { runCount++; });
+    scheduler.registerTask(receiver, 40, [&runCount]() { runCount++; });
+    QCOMPARE(scheduler.taskCount(), 2);
+    delete receiver;
+    QCOMPARE(scheduler.taskCount(), 0);
+    QTest::qWait(100);
+    QCOMPARE(runCount, 0);
+
+    // A task may remove other tasks, including ones due in the same wakeup
+    int otherTaskId = 0;
+    int taskId = scheduler.registerTask(this, 20, [&]() { runCount++; scheduler.unregisterTask(otherTaskId); });
+    otherTaskId = scheduler.registerTask(this, 20, [&otherRunCount]() { otherRunCount++; });
+    QTRY_VERIFY_WITH_TIMEOUT(runCount > 0, 1000);
+    QCOMPARE(otherRunCount, 0);
+    QCOMPARE(scheduler.taskCount(), 1);
+
+    scheduler.unregisterTask(taskId);
+    scheduler.unregisterTasks(this);
+    QCOMPARE(scheduler.taskCount(), 0);
+}
+
+/// Deferred value signals for many FactGroups go out in a few shared wakeups
+void QGCFrameSchedulerTest::_factGroupWakeups(void)
+{
+    const int                   cGroupCount = 200;
+    QGCFrameScheduler*          scheduler = qgcApp()->toolbox()->frameScheduler();
+    QList<VehicleGPSFactGroup*> groups;
+
+    for (int i=0; i<cGroupCount; i++) {
+        groups.append(new VehicleGPSFactGroup(this));
+        if (i % 20 == 0) {
+            QTest::qWait(3);
+        }
+    }
+
+    scheduler->resetStatistics();
+    for (VehicleGPSFactGroup* group: groups) {
+        group->lat()->setRawValue(47.3977419);
+        group->lon()->setRawValue(8.5455938);
+    }
+    QTest::qWait(1100);
+
+    // Other tasks registered by the application run from the same scheduler, so only the signals are exact
+    QGCFrameScheduler::Statistics statistics = scheduler->statistics();
+    QCOMPARE(statistics.signalsEmitted, static_cast<quint64>(cGroupCount * 2));
+    QVERIFY(statistics.wakeups < static_cast<quint64>(cGroupCount));
+
+    qDeleteAll(groups);
+}
@@ -0,0 +1,25 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Checks that QGCFrameScheduler runs tasks with the same interval in shared wakeups, including the deferred value
+/// signals of many FactGroups.
+class QGCFrameSchedulerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _sharedWakeups     (void);
+    void _inactiveTasks     (void);
+    void _removedTasks      (void);
+    void _factGroupWakeups  (void);
+};
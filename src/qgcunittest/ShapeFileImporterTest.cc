@@ -0,0 +1,244 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ShapeFileImporterTest.h"
+#include "ShapeFileImporter.h"
+#include "ShapeFileHelper.h"
+
+#include "shapefil.h"
+
+#include <QFile>
+
+void ShapeFileImporterTest::_writePrjFile(const QString& shpFile)
+{
+    QFile prjFile(shpFile.left(shpFile.length() - 4) + QStringLiteral(".prj"));
+    QVERIFY(prjFile.open(QIODevice::WriteOnly | QIODevice::Text));
+    prjFile.write("GEOGCS[\"GCS_WGS_1984\",DATUM[\"D_WGS_1984\",SPHEROID[\"WGS_1984\",6378137,298.257223563]],PRIMEM[\"Greenwich\",0],UNIT[\"Degree\",0.017453292519943295]]\n");
+}
+
+/// Writes a polygon file with two records. The first record has two outer rings with a hole in the first ring, the
+/// second record is a single ring. Outer rings are clockwise, holes counter-clockwise.
+QString ShapeFileImporterTest::_writePolygonFile(const QTemporaryDir& dir)
+{
+    QString shpFile = dir.filePath(QStringLiteral("Fields.shp"));
+
+    SHPHandle shpHandle = SHPCreate(shpFile.toUtf8(), SHPT_POLYGON);
+    DBFHandle dbfHandle = DBFCreate(dir.filePath(QStringLiteral("Fields.dbf")).toUtf8());
+    if (!shpHandle || !dbfHandle) {
+        return QString();
+    }
+    DBFAddField(dbfHandle, "name",  FTString,   32, 0);
+    DBFAddField(dbfHandle, "id",    FTInteger,  10, 0);
+
+    // Record 0: outer ring, hole, second outer ring
+    const int       rgPartStart[]   = { 0, 5, 10 };
+    const double    rgX0[]          = { 8.540, 8.540, 8.545, 8.545, 8.540,      8.541, 8.543, 8.543, 8.541, 8.541,      8.550, 8.550, 8.555, 8.555, 8.550 };
+    const double    rgY0[]          = { 47.390, 47.395, 47.395, 47.390, 47.390, 47.391, 47.391, 47.393, 47.393, 47.391, 47.390, 47.395, 47.395, 47.390, 47.390 };
+    SHPObject* shpObject = SHPCreateObject(SHPT_POLYGON, -1, 3, rgPartStart, nullptr, 15, rgX0, rgY0, nullptr, nullptr);
+    SHPWriteObject(shpHandle, -1, shpObject);
+    SHPDestroyObject(shpObject);
+    DBFWriteStringAttribute(dbfHandle, 0, 0, "Field A");
+    DBFWriteIntegerAttribute(dbfHandle, 0, 1, 7);
+
+    // Record 1: single ring
+    const double rgX1[] = { 8.560, 8.560, 8.565, 8.565, 8.560 };
+    const double rgY1[] = { 47.390, 47.395, 47.395, 47.390, 47.390 };
+    shpObject = SHPCreateSimpleObject(SHPT_POLYGON, 5, rgX1, rgY1, nullptr);
+    SHPWriteObject(shpHandle, -1, shpObject);
+    SHPDestroyObject(shpObject);
+    DBFWriteStringAttribute(dbfHandle, 1, 0, "Field B");
+    DBFWriteIntegerAttribute(dbfHandle, 1, 1, 8);
+
+    SHPClose(shpHandle);
+    DBFClose(dbfHandle);
+    _writePrjFile(shpFile);
+
+    return shpFile;
+}
+
+/// Writes an arc file without a .dbf file, holding a single record with two parts
+QString ShapeFileImporterTest::_writePolylineFile(const QTemporaryDir& dir)
+{
+    QString shpFile = dir.filePath(QStringLiteral("Corridors.shp"));
+
+    SHPHandle shpHandle = SHPCreate(shpFile.toUtf8(), SHPT_ARC);
+    if (!shpHandle) {
+        return QString();
+    }
+
+    const int       rgPartStart[]   = { 0, 3 };
+    const double    rgX[]           = { 8.540, 8.545, 8.550,    8.540, 8.550 };
+    const double    rgY[]           = { 47.390, 47.392, 47.390, 47.400, 47.400 };
+    SHPObject* shpObject = SHPCreateObject(SHPT_ARC, -1, 2, rgPartStart, nullptr, 5, rgX, rgY, nullptr, nullptr);
+    SHPWriteObject(shpHandle, -1, shpObject);
+    SHPDestroyObject(shpObject);
+
+    SHPClose(shpHandle);
+    _writePrjFile(shpFile);
+
+    return shpFile;
+}
+
+void ShapeFileImporterTest::_shpPolygonFeatures(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString shpFile = _writePolygonFile(dir);
+    QVERIFY(!shpFile.isEmpty());
+
+    ShapeFileHelper::Features_t features;
+    QString                     errorString;
+    double                      lastProgress = 0;
+    QVERIFY(ShapeFileHelper::loadFeaturesFromFile(shpFile, features, errorString, [&lastProgress](double progress) { lastProgress = progress; }));
+    QVERIFY(errorString.isEmpty());
+    QCOMPARE(lastProgress, 1.0);
+
+    // Both outer rings of the first record without the hole, then the second record
+    QCOMPARE(features.count(), 3);
+    for (const ShapeFileHelper::Feature& feature: features) {
+        QCOMPARE(feature.type, ShapeFileHelper::Polygon);
+        QCOMPARE(feature.coordinates.count(), 4);
+    }
+    QCOMPARE(features[0].coordinates[0], QGeoCoordinate(47.390, 8.540));
+    QCOMPARE(features[1].coordinates[0], QGeoCoordinate(47.390, 8.550));
+    QCOMPARE(features[2].coordinates[0], QGeoCoordinate(47.390, 8.560));
+
+    // Attributes come from the record each part belongs to
+    QCOMPARE(features[0].attributes[QStringLiteral("name")].toString(), QStringLiteral("Field A"));
+    QCOMPARE(features[0].attributes[QStringLiteral("id")].toLongLong(), 7LL);
+    QCOMPARE(features[1].attributes, features[0].attributes);
+    QCOMPARE(features[2].attributes[QStringLiteral("name")].toString(), QStringLiteral("Field B"));
+    QCOMPARE(features[2].attributes[QStringLiteral("id")].toLongLong(), 8LL);
+}
+
+void ShapeFileImporterTest::_shpPolylineFeatures(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString shpFile = _writePolylineFile(dir);
+    QVERIFY(!shpFile.isEmpty());
+
+    ShapeFileHelper::Features_t features;
+    QString                     errorString;
+    QVERIFY(ShapeFileHelper::loadFeaturesFromFile(shpFile, features, errorString));
+
+    // Each part is a separate polyline, there are no attributes without a .dbf file
+    QCOMPARE(features.count(), 2);
+    QCOMPARE(features[0].type, ShapeFileHelper::Polyline);
+    QCOMPARE(features[0].coordinates.count(), 3);
+    QCOMPARE(features[0].coordinates[1], QGeoCoordinate(47.392, 8.545));
+    QCOMPARE(features[1].type, ShapeFileHelper::Polyline);
+    QCOMPARE(features[1].coordinates.count(), 2);
+    QVERIFY(features[0].attributes.isEmpty());
+}
+
+void ShapeFileImporterTest::_shpErrors(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString shpFile = _writePolygonFile(dir);
+    QVERIFY(!shpFile.isEmpty());
+
+    ShapeFileHelper::Features_t features;
+    QString                     errorString;
+
+    // Cancelled load
+    QVERIFY(!ShapeFileHelper::loadFeaturesFromFile(shpFile, features, errorString, ShapeFileHelper::ProgressFunc_t(), []() { return true; }));
+    QVERIFY(!errorString.isEmpty());
+    QCOMPARE(features.count(), 0);
+
+    // Projection file is required
+    QVERIFY(QFile::remove(dir.filePath(QStringLiteral("Fields.prj"))));
+    QVERIFY(!ShapeFileHelper::loadFeaturesFromFile(shpFile, features, errorString));
+    QVERIFY(!errorString.isEmpty());
+    QCOMPARE(features.count(), 0);
+}
+
+void ShapeFileImporterTest::_importFinished(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString shpFile = _writePolygonFile(dir);
+    QVERIFY(!shpFile.isEmpty());
+
+    ShapeFileImporter   importer;
+    QSignalSpy          spyFinished(&importer, &ShapeFileImporter::finished);
+
+    importer.start(shpFile);
+    QVERIFY(importer.running());
+    QVERIFY(spyFinished.wait(5000));
+    QCOMPARE(spyFinished.count(), 1);
+    QCOMPARE(spyFinished.takeFirst().at(0).toBool(), true);
+
+    QVERIFY(!importer.running());
+    QCOMPARE(importer.progress(), 1.0);
+    QVERIFY(importer.errorString().isEmpty());
+    QCOMPARE(importer.features().count(), 3);
+    QCOMPARE(importer.polygonCount(), 3);
+    QCOMPARE(importer.polylineCount(), 0);
+    QCOMPARE(importer.attributes(2)[QStringLiteral("name")].toString(), QStringLiteral("Field B"));
+    QVERIFY(importer.attributes(3).isEmpty());
+
+    // Failed import
+    QVERIFY(QFile::remove(dir.filePath(QStringLiteral("Fields.prj"))));
+    importer.start(shpFile);
+    QVERIFY(spyFinished.wait(5000));
+    QCOMPARE(spyFinished.takeFirst().at(0).toBool(), false);
+    QVERIFY(!importer.errorString().isEmpty());
+    QCOMPARE(importer.features().count(), 0);
+}
+
+/// A cancelled import never signals finished and leaves no features
+void ShapeFileImporterTest::_importCancelled(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString shpFile = _writePolygonFile(dir);
+    QVERIFY(!shpFile.isEmpty());
+
+    ShapeFileImporter   importer;
+    QSignalSpy          spyFinished(&importer, &ShapeFileImporter::finished);
+    QSignalSpy          spyRunning(&importer, &ShapeFileImporter::runningChanged);
+
+    importer.start(shpFile);
+    importer.cancel();
+    QVERIFY(!importer.running());
+    QCOMPARE(spyRunning.count(), 2);
+
+    QTest::qWait(500);
+    QCOMPARE(spyFinished.count(), 0);
+    QCOMPARE(importer.features().count(), 0);
+
+    // The importer can be used again afterwards
+    importer.start(shpFile);
+    QVERIFY(spyFinished.wait(5000));
+    QCOMPARE(importer.features().count(), 3);
+}
+
+/// Starting a new import drops the results of the one still running
+void ShapeFileImporterTest::_importRestarted(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString polygonFile = _writePolygonFile(dir);
+    QString polylineFile = _writePolylineFile(dir);
+    QVERIFY(!polygonFile.isEmpty());
+    QVERIFY(!polylineFile.isEmpty());
+
+    ShapeFileImporter   importer;
+    QSignalSpy          spyFinished(&importer, &ShapeFileImporter::finished);
+
+    importer.start(polygonFile);
+    importer.start(polylineFile);
+    QVERIFY(spyFinished.wait(5000));
+    QTest::qWait(500);
+    QCOMPARE(spyFinished.count(), 1);
+    QCOMPARE(importer.polygonCount(), 0);
+    QCOMPARE(importer.polylineCount(), 2);
+}
@@ -0,0 +1,33 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QTemporaryDir>
+
+/// Checks loading all features of a SHP file and running imports through ShapeFileImporter
+class ShapeFileImporterTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _shpPolygonFeatures    (void);
+    void _shpPolylineFeatures   (void);
+    void _shpErrors             (void);
+    void _importFinished        (void);
+    void _importCancelled       (void);
+    void _importRestarted       (void);
+
+private:
+    QString _writePolygonFile   (const QTemporaryDir& dir);
+    QString _writePolylineFile  (const QTemporaryDir& dir);
+    void    _writePrjFile       (const QString& shpFile);
+};
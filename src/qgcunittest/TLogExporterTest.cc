@@ -0,0 +1,303 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TLogExporterTest.h"
+#include "TLogExporter.h"
+#include "QGCMAVLink.h"
+#include "QGC.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+
+// Keep clear of the channels reserved by links
+const uint8_t   _mavlinkChannel         = MAVLINK_COMM_NUM_BUFFERS - 1;
+const quint64   _startTimestamp         = 0x0005540000000000ull;
+const qint64    _defaultLogBytes        = 1024 * 1024;
+const int       _defaultBenchmarkMB     = 2;
+const int       _csvRowsPerChunk        = 10;
+
+/// Timestamps increase with the message count. Each of the low four bytes holds a base 250 digit of the count, so none of
+/// them is a mavlink start byte, which the parser would take for the start of a message.
+quint64 _timestamp(quint64 count)
+{
+    quint64 timestamp = _startTimestamp;
+    for (int shift=0; shift<32; shift+=8) {
+        timestamp |= (count % 250) << shift;
+        count /= 250;
+    }
+    return timestamp;
+}
+
+void _writeMessage(QIODevice& device, quint64 timestamp, const mavlink_message_t& message)
+{
+    char    buffer[sizeof(quint64) + MAVLINK_MAX_PACKET_LEN];
+    qToBigEndian(timestamp, buffer);
+    uint16_t len = mavlink_msg_to_send_buffer(reinterpret_cast<uint8_t*>(buffer + sizeof(quint64)), &message);
+    device.write(buffer, sizeof(quint64) + len);
+}
+
+const TLogExporter::Column* _column(const QList<TLogExporter::Column>& columns, const QString& name)
+{
+    for (const TLogExporter::Column& column: columns) {
+        if (column.name == name) {
+            return &column;
+        }
+    }
+    return nullptr;
+}
+
+template<typename T>
+T _value(const TLogExporter::Column* column, int row, int element = 0)
+{
+    T value;
+    memcpy(&value, column->data.constData() + (((row * column->elementCount) + element) * sizeof(T)), sizeof(T));
+    return value;
+}
+
+quint32 _adler32(const QByteArray& data)
+{
+    quint32 a = 1;
+    quint32 b = 0;
+    for (char c: data) {
+        a = (a + static_cast<quint8>(c)) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+/// Decompresses the gzip member at pos, which is expected to hold the specified text, and moves pos past the member.
+///     @return Decompressed text, empty if the member is damaged or does not decompress to the expected text
+QByteArray _gunzipMember(const QByteArray& bytes, int& pos, const QByteArray& expected)
+{
+    static const QByteArray gzipHeader("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10);
+
+    if (bytes.mid(pos, gzipHeader.size()) != gzipHeader) {
+        return QByteArray();
+    }
+
+    // The member ends with the crc32 and size of the expected text
+    char trailer[8];
+    qToLittleEndian<quint32>(~QGC::crc32(reinterpret_cast<const quint8*>(expected.constData()), static_cast<unsigned>(expected.size()), 0xffffffff), trailer);
+    qToLittleEndian<quint32>(static_cast<quint32>(expected.size()), trailer + 4);
+    int deflateStart    = pos + gzipHeader.size();
+    int deflateEnd      = bytes.indexOf(QByteArray(trailer, sizeof(trailer)), deflateStart);
+    if (deflateEnd == -1) {
+        return QByteArray();
+    }
+    pos = deflateEnd + static_cast<int>(sizeof(trailer));
+
+    // qUncompress input is a big endian size, zlib header, raw deflate stream and adler32. The adler32 comes from the expected
+    // text, so zlib fails the decompression if the deflate stream holds anything else.
+    char        sizeBytes[4];
+    char        adlerBytes[4];
+    QByteArray  zlib;
+    qToBigEndian<quint32>(static_cast<quint32>(expected.size()), sizeBytes);
+    qToBigEndian<quint32>(_adler32(expected), adlerBytes);
+    zlib.append(sizeBytes, sizeof(sizeBytes));
+    zlib.append("\x78\x01", 2);
+    zlib.append(bytes.mid(deflateStart, deflateEnd - deflateStart));
+    zlib.append(adlerBytes, sizeof(adlerBytes));
+
+    return qUncompress(zlib);
+}
+
+}
+
+/// Writes a repeating pattern of ATTITUDE, HEARTBEAT and PARAM_VALUE until the log is at least minimumBytes long
+///     @return Number of ATTITUDE messages written
+quint64 TLogExporterTest::_writeLog(QIODevice& device, qint64 minimumBytes)
+{
+    quint64             count = 0;
+    mavlink_message_t   message;
+
+    while (device.pos() < minimumBytes) {
+        quint64 timestamp = _timestamp(count);
+
+        mavlink_msg_attitude_pack_chan(1, 1, _mavlinkChannel, &message, static_cast<uint32_t>(count), count * 0.001f, 0.5f, -0.5f, 0, 0, 0);
+        _writeMessage(device, timestamp, message);
+
+        if (count % 10 == 0) {
+            mavlink_msg_heartbeat_pack_chan(1, 1, _mavlinkChannel, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, static_cast<uint32_t>(count), MAV_STATE_ACTIVE);
+            _writeMessage(device, timestamp, message);
+        }
+        if (count % 100 == 0) {
+            mavlink_msg_param_value_pack_chan(1, 1, _mavlinkChannel, &message, "TEST_PARAM", count, MAV_PARAM_TYPE_REAL32, 1, 0);
+            _writeMessage(device, timestamp, message);
+        }
+        count++;
+    }
+
+    return count;
+}
+
+void TLogExporterTest::_testColumnar(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QString logFilename = dir.filePath("test.tlog");
+    QFile   log(logFilename);
+    QVERIFY(log.open(QIODevice::WriteOnly));
+    quint64 attitudeCount = _writeLog(log, _defaultLogBytes);
+    log.close();
+
+    // Small chunks so each type is written as many chunks from the thread pool
+    TLogExporter    exporter(logFilename, dir.filePath("export"));
+    QString         errorMessage;
+    exporter.setFormats(TLogExporter::FormatColumnar);
+    exporter.setRowsPerChunk(1000);
+    QVERIFY2(exporter.exportLog(_mavlinkChannel, errorMessage), qPrintable(errorMessage));
+    QCOMPARE(exporter.messageCount(), attitudeCount + ((attitudeCount + 9) / 10) + ((attitudeCount + 99) / 100));
+    QCOMPARE(exporter.outputFiles().count(), 3);
+
+    QString                     messageName;
+    QList<TLogExporter::Column> columns;
+    QVERIFY2(TLogExporter::readColumnarFile(dir.filePath("export/ATTITUDE.qcol"), messageName, columns, errorMessage), qPrintable(errorMessage));
+    QCOMPARE(messageName, QStringLiteral("ATTITUDE"));
+
+    const TLogExporter::Column* timestamp   = _column(columns, "timestamp_us");
+    const TLogExporter::Column* sysid       = _column(columns, "sysid");
+    const TLogExporter::Column* timeBoot    = _column(columns, "time_boot_ms");
+    const TLogExporter::Column* roll        = _column(columns, "roll");
+    QVERIFY(timestamp && sysid && timeBoot && roll);
+    QCOMPARE(timeBoot->data.size(), static_cast<int>(attitudeCount * sizeof(uint32_t)));
+
+    int row = static_cast<int>(attitudeCount / 2);
+    QCOMPARE(_value<quint64>(timestamp, row), _timestamp(static_cast<quint64>(row)));
+    QCOMPARE(_value<quint8>(sysid, row), static_cast<quint8>(1));
+    QCOMPARE(_value<uint32_t>(timeBoot, row), static_cast<uint32_t>(row));
+    QCOMPARE(_value<float>(roll, row), row * 0.001f);
+
+    // Array field with zero payload truncation
+    QVERIFY2(TLogExporter::readColumnarFile(dir.filePath("export/PARAM_VALUE.qcol"), messageName, columns, errorMessage), qPrintable(errorMessage));
+    const TLogExporter::Column* paramId = _column(columns, "param_id");
+    QVERIFY(paramId);
+    QCOMPARE(paramId->type, static_cast<quint8>(MAVLINK_TYPE_CHAR));
+    QCOMPARE(paramId->elementCount, 16);
+    QCOMPARE(QByteArray(paramId->data.constData() + paramId->elementCount, paramId->elementCount), QByteArray("TEST_PARAM\0\0\0\0\0\0", 16));
+    QCOMPARE(_value<float>(_column(columns, "param_value"), 1), 100.0f);
+}
+
+/// Compares a csv export with the text expected from the field values of each row
+///     @param rows Field values by name, including the timestamp_us, sysid and compid columns
+void TLogExporterTest::_compareCsv(const QString& filename, const mavlink_message_t& message, const QList<QHash<QString, QByteArray>>& rows)
+{
+    const mavlink_message_info_t* messageInfo = mavlink_get_message_info(&message);
+    QVERIFY(messageInfo);
+
+    QStringList columnNames({ QStringLiteral("timestamp_us"), QStringLiteral("sysid"), QStringLiteral("compid") });
+    for (unsigned int i=0; i<messageInfo->num_fields; i++) {
+        // Test messages have no arrays other than strings, which stay in a single column
+        QVERIFY(messageInfo->fields[i].array_length == 0 || messageInfo->fields[i].type == MAVLINK_TYPE_CHAR);
+        columnNames.append(messageInfo->fields[i].name);
+    }
+
+    QFile csv(filename);
+    QVERIFY(csv.open(QIODevice::ReadOnly));
+    QByteArray  bytes   = csv.readAll();
+    int         pos     = 0;
+
+    // Header and every chunk are complete gzip members
+    QByteArray header = columnNames.join(',').toUtf8() + '\n';
+    QCOMPARE(_gunzipMember(bytes, pos, header), header);
+
+    for (int chunkStart=0; chunkStart<rows.count(); chunkStart+=_csvRowsPerChunk) {
+        QByteArray chunk;
+        for (int row=chunkStart; row<qMin(chunkStart + _csvRowsPerChunk, rows.count()); row++) {
+            QByteArrayList values;
+            for (const QString& columnName: columnNames) {
+                QVERIFY2(rows[row].contains(columnName), qPrintable(columnName));
+                values.append(rows[row][columnName]);
+            }
+            chunk.append(values.join(',') + '\n');
+        }
+        QCOMPARE(_gunzipMember(bytes, pos, chunk), chunk);
+    }
+    QCOMPARE(pos, bytes.size());
+}
+
+void TLogExporterTest::_testCsv(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QString logFilename = dir.filePath("test.tlog");
+    QFile   log(logFilename);
+    QVERIFY(log.open(QIODevice::WriteOnly));
+    quint64 attitudeCount = _writeLog(log, _defaultLogBytes / 16);
+    log.close();
+
+    TLogExporter    exporter(logFilename, dir.filePath("export"));
+    QString         errorMessage;
+    exporter.setFormats(TLogExporter::FormatCsv);
+    exporter.setRowsPerChunk(_csvRowsPerChunk);
+    QVERIFY2(exporter.exportLog(_mavlinkChannel, errorMessage), qPrintable(errorMessage));
+    QCOMPARE(exporter.outputFiles().count(), 3);
+
+    // Expected values are the ones _writeLog packed into the messages
+    QList<QHash<QString, QByteArray>> heartbeatRows;
+    QList<QHash<QString, QByteArray>> paramValueRows;
+    for (quint64 count=0; count<attitudeCount; count++) {
+        QHash<QString, QByteArray> row;
+        row["timestamp_us"] =   QByteArray::number(_timestamp(count));
+        row["sysid"] =          "1";
+        row["compid"] =         "1";
+        if (count % 10 == 0) {
+            QHash<QString, QByteArray> heartbeatRow(row);
+            heartbeatRow["type"] =              QByteArray::number(MAV_TYPE_QUADROTOR);
+            heartbeatRow["autopilot"] =         QByteArray::number(MAV_AUTOPILOT_PX4);
+            heartbeatRow["base_mode"] =         "0";
+            heartbeatRow["custom_mode"] =       QByteArray::number(count);
+            heartbeatRow["system_status"] =     QByteArray::number(MAV_STATE_ACTIVE);
+            heartbeatRow["mavlink_version"] =   "3";
+            heartbeatRows.append(heartbeatRow);
+        }
+        if (count % 100 == 0) {
+            QHash<QString, QByteArray> paramValueRow(row);
+            paramValueRow["param_id"] =     "\"TEST_PARAM\"";
+            paramValueRow["param_value"] =  QByteArray::number(static_cast<double>(static_cast<float>(count)), 'g', 9);
+            paramValueRow["param_type"] =   QByteArray::number(MAV_PARAM_TYPE_REAL32);
+            paramValueRow["param_count"] =  "1";
+            paramValueRow["param_index"] =  "0";
+            paramValueRows.append(paramValueRow);
+        }
+    }
+
+    mavlink_message_t message;
+    mavlink_msg_heartbeat_pack_chan(1, 1, _mavlinkChannel, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, 0, MAV_STATE_ACTIVE);
+    _compareCsv(dir.filePath("export/HEARTBEAT.csv.gz"), message, heartbeatRows);
+    mavlink_msg_param_value_pack_chan(1, 1, _mavlinkChannel, &message, "TEST_PARAM", 0, MAV_PARAM_TYPE_REAL32, 1, 0);
+    _compareCsv(dir.filePath("export/PARAM_VALUE.csv.gz"), message, paramValueRows);
+}
+
+void TLogExporterTest::_benchmarkExport(void)
+{
+    int logMB = qEnvironmentVariableIsSet("QGC_TLOG_BENCHMARK_MB") ? qEnvironmentVariableIntValue("QGC_TLOG_BENCHMARK_MB") : _defaultBenchmarkMB;
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QString logFilename = dir.filePath("benchmark.tlog");
+    QFile   log(logFilename);
+    QVERIFY(log.open(QIODevice::WriteOnly));
+    _writeLog(log, static_cast<qint64>(logMB) * 1024 * 1024);
+    log.close();
+
+    TLogExporter    exporter(logFilename, dir.filePath("export"));
+    QString         errorMessage;
+    QBENCHMARK {
+        QVERIFY2(exporter.exportLog(_mavlinkChannel, errorMessage), qPrintable(errorMessage));
+    }
+    QCOMPARE(exporter.outputFiles().count(), 6);
+}
@@ -0,0 +1,31 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "QGCMAVLink.h"
+
+class QIODevice;
+
+/// Tests TLogExporter against generated logs. The benchmark uses a small log by default, set QGC_TLOG_BENCHMARK_MB to
+/// the log size to benchmark, for example 1024 for a full size flight log.
+class TLogExporterTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testColumnar(void);
+    void _testCsv(void);
+    void _benchmarkExport(void);
+
+private:
+    quint64 _writeLog   (QIODevice& device, qint64 minimumBytes);
+    void    _compareCsv (const QString& filename, const mavlink_message_t& message, const QList<QHash<QString, QByteArray>>& rows);
+};
@@ -0,0 +1,238 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TLogIndexTest.h"
+#include "TLogIndex.h"
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+namespace {
+
+// Keep clear of the channels reserved by links
+const uint8_t   _mavlinkChannel     = MAVLINK_COMM_NUM_BUFFERS - 1;
+// None of the timestamps contain a mavlink start byte, which the parser would take for the start of a message
+const quint64   _startTimestamp     = 1500000002000000ull;
+const quint64   _intervalUs         = 10000;
+const int       _messageCount       = 100;
+
+quint64 _timestamp(int message)
+{
+    return _startTimestamp + (static_cast<quint64>(message) * _intervalUs);
+}
+
+/// @return Size of each record written by _writeLog
+qint64 _recordSize(void)
+{
+    mavlink_message_t   message;
+    uint8_t             buffer[MAVLINK_MAX_PACKET_LEN];
+
+    mavlink_msg_heartbeat_pack_chan(1, 1, _mavlinkChannel, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, 0, MAV_STATE_ACTIVE);
+    return TLogIndex::cbTimestamp + mavlink_msg_to_send_buffer(buffer, &message);
+}
+
+}
+
+/// Writes messageCount heartbeats, each with its own timestamp
+void TLogIndexTest::_writeLog(QIODevice& device, int messageCount)
+{
+    for (int i=0; i<messageCount; i++) {
+        mavlink_message_t   message;
+        char                buffer[TLogIndex::cbTimestamp + MAVLINK_MAX_PACKET_LEN];
+
+        mavlink_msg_heartbeat_pack_chan(1, 1, _mavlinkChannel, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, static_cast<uint32_t>(i), MAV_STATE_ACTIVE);
+        qToBigEndian(_timestamp(i), buffer);
+        uint16_t len = mavlink_msg_to_send_buffer(reinterpret_cast<uint8_t*>(buffer + TLogIndex::cbTimestamp), &message);
+        device.write(buffer, TLogIndex::cbTimestamp + len);
+    }
+}
+
+void TLogIndexTest::_testBuild(void)
+{
+    QBuffer log;
+    log.open(QIODevice::ReadWrite);
+
+    TLogIndex index;
+    QVERIFY(!index.build(log, _mavlinkChannel));
+    QVERIFY(index.isEmpty());
+
+    _writeLog(log, _messageCount);
+    QVERIFY(index.build(log, _mavlinkChannel));
+    QCOMPARE(log.pos(), static_cast<qint64>(0));
+
+    QCOMPARE(index.messageCount(),      static_cast<quint64>(_messageCount));
+    QCOMPARE(index.startTimestamp(),    _timestamp(0));
+    QCOMPARE(index.endTimestamp(),      _timestamp(_messageCount - 1));
+    QCOMPARE(index.entries().count(),   (_messageCount + TLogIndex::kIndexStride - 1) / TLogIndex::kIndexStride);
+    for (int i=0; i<index.entries().count(); i++) {
+        QCOMPARE(index.entries()[i].timestamp,  _timestamp(i * TLogIndex::kIndexStride));
+        QCOMPARE(index.entries()[i].offset,     i * TLogIndex::kIndexStride * _recordSize());
+    }
+
+    // Garbage between records is skipped over
+    QBuffer noisyLog;
+    noisyLog.open(QIODevice::ReadWrite);
+    noisyLog.write(QByteArray(37, '\x55'));
+    _writeLog(noisyLog, _messageCount);
+    QVERIFY(index.build(noisyLog, _mavlinkChannel));
+    QCOMPARE(index.messageCount(), static_cast<quint64>(_messageCount));
+    QCOMPARE(index.entries()[0].offset, static_cast<qint64>(37));
+}
+
+void TLogIndexTest::_testCache(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QString logFilename = dir.filePath("test.tlog");
+    QFile   log(logFilename);
+    QVERIFY(log.open(QIODevice::WriteOnly));
+    _writeLog(log, _messageCount);
+    log.close();
+    QVERIFY(log.open(QIODevice::ReadOnly));
+
+    TLogIndex builtIndex;
+    QVERIFY(builtIndex.load(log, logFilename, _mavlinkChannel));
+    QVERIFY(QFile::exists(TLogIndex::cacheFilename(logFilename)));
+
+    // The cached index is used without reading the log
+    QBuffer     emptyLog;
+    TLogIndex   cachedIndex;
+    emptyLog.open(QIODevice::ReadOnly);
+    QVERIFY(cachedIndex.load(emptyLog, logFilename, _mavlinkChannel));
+    QCOMPARE(cachedIndex.messageCount(),    builtIndex.messageCount());
+    QCOMPARE(cachedIndex.startTimestamp(),  builtIndex.startTimestamp());
+    QCOMPARE(cachedIndex.endTimestamp(),    builtIndex.endTimestamp());
+    QCOMPARE(cachedIndex.entries().count(), builtIndex.entries().count());
+    for (int i=0; i<builtIndex.entries().count(); i++) {
+        QCOMPARE(cachedIndex.entries()[i].timestamp,    builtIndex.entries()[i].timestamp);
+        QCOMPARE(cachedIndex.entries()[i].offset,       builtIndex.entries()[i].offset);
+    }
+}
+
+void TLogIndexTest::_testStaleCache(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QString logFilename = dir.filePath("test.tlog");
+    QFile   log(logFilename);
+    QVERIFY(log.open(QIODevice::WriteOnly));
+    _writeLog(log, _messageCount);
+    log.close();
+    QVERIFY(log.open(QIODevice::ReadOnly));
+
+    TLogIndex index;
+    QVERIFY(index.load(log, logFilename, _mavlinkChannel));
+    log.close();
+
+    // A log which grew since the cache was written is indexed again
+    QVERIFY(log.open(QIODevice::Append));
+    _writeLog(log, 10);
+    log.close();
+
+    QBuffer emptyLog;
+    emptyLog.open(QIODevice::ReadOnly);
+    QVERIFY(!index.load(emptyLog, logFilename, _mavlinkChannel));
+
+    QVERIFY(log.open(QIODevice::ReadOnly));
+    QVERIFY(index.load(log, logFilename, _mavlinkChannel));
+    QCOMPARE(index.messageCount(), static_cast<quint64>(_messageCount + 10));
+}
+
+void TLogIndexTest::_testCorruptCache(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QString logFilename = dir.filePath("test.tlog");
+    QFile   log(logFilename);
+    QVERIFY(log.open(QIODevice::WriteOnly));
+    _writeLog(log, _messageCount);
+    log.close();
+
+    QFileInfo   logInfo(logFilename);
+    quint64     entryCount = (_messageCount + TLogIndex::kIndexStride - 1) / TLogIndex::kIndexStride;
+
+    // Valid header for the log followed by the specified counts and entries
+    auto writeCache = [&](quint64 messageCount, quint32 cacheEntryCount, int entriesWritten) {
+        QFile cache(TLogIndex::cacheFilename(logFilename));
+        QVERIFY(cache.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QDataStream ds(&cache);
+        ds.setVersion(QDataStream::Qt_5_9);
+        ds << static_cast<quint32>(0x51544c49) << static_cast<quint32>(1) << static_cast<quint32>(TLogIndex::kIndexStride) << logInfo.size() << logInfo.lastModified().toMSecsSinceEpoch();
+        ds << _timestamp(0) << _timestamp(_messageCount - 1) << messageCount << cacheEntryCount;
+        for (int i=0; i<entriesWritten; i++) {
+            ds << _timestamp(i * TLogIndex::kIndexStride) << static_cast<qint64>(i * TLogIndex::kIndexStride * _recordSize());
+        }
+    };
+
+    QBuffer emptyLog;
+    emptyLog.open(QIODevice::ReadOnly);
+    TLogIndex index;
+
+    writeCache(_messageCount, static_cast<quint32>(entryCount), static_cast<int>(entryCount));
+    QVERIFY(index.load(emptyLog, logFilename, _mavlinkChannel));
+
+    // An entry count far beyond the file size must be rejected before anything is allocated
+    writeCache(0xfffffff0ull * TLogIndex::kIndexStride, 0xfffffff0, static_cast<int>(entryCount));
+    QVERIFY(!index.load(emptyLog, logFilename, _mavlinkChannel));
+    QVERIFY(index.isEmpty());
+
+    // Entry count which doesn't match the message count
+    writeCache(_messageCount, static_cast<quint32>(entryCount - 1), static_cast<int>(entryCount));
+    QVERIFY(!index.load(emptyLog, logFilename, _mavlinkChannel));
+
+    // Truncated entries
+    writeCache(_messageCount, static_cast<quint32>(entryCount), static_cast<int>(entryCount) - 1);
+    QVERIFY(!index.load(emptyLog, logFilename, _mavlinkChannel));
+}
+
+void TLogIndexTest::_testSeek(void)
+{
+    QBuffer log;
+    log.open(QIODevice::ReadWrite);
+
+    TLogIndex index;
+    QCOMPARE(index.entryForTimestamp(_timestamp(0)).offset, static_cast<qint64>(0));
+
+    _writeLog(log, _messageCount);
+    QVERIFY(index.build(log, _mavlinkChannel));
+
+    const int stride = TLogIndex::kIndexStride;
+
+    // Before the start of the log
+    QCOMPARE(index.entryForTimestamp(0).timestamp, _timestamp(0));
+
+    // Exactly on an entry and between entries
+    QCOMPARE(index.entryForTimestamp(_timestamp(stride * 2)).timestamp,         _timestamp(stride * 2));
+    QCOMPARE(index.entryForTimestamp(_timestamp(stride * 2) - 1).timestamp,     _timestamp(stride));
+    QCOMPARE(index.entryForTimestamp(_timestamp(stride * 2 + 5)).timestamp,     _timestamp(stride * 2));
+    QCOMPARE(index.entryForTimestamp(_timestamp(stride * 2 + 5)).offset,        stride * 2 * _recordSize());
+
+    // Past the end of the log
+    QCOMPARE(index.entryForTimestamp(_timestamp(_messageCount * 2)).timestamp,  index.entries().last().timestamp);
+}
+
+void TLogIndexTest::_testTimestamp(void)
+{
+    quint64 now = _timestamp(_messageCount);
+    char    bytes[TLogIndex::cbTimestamp];
+
+    qToBigEndian(_timestamp(1), bytes);
+    QCOMPARE(TLogIndex::decodeTimestamp(bytes, now), _timestamp(1));
+
+    // Old logs stored the timestamp little endian, which decodes to a time in the future
+    qToLittleEndian(_timestamp(1), bytes);
+    QCOMPARE(TLogIndex::decodeTimestamp(bytes, now), _timestamp(1));
+}
@@ -0,0 +1,31 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class QIODevice;
+
+/// Tests TLogIndex building, the on disk index cache and seeking against generated logs
+class TLogIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testBuild         (void);
+    void _testCache         (void);
+    void _testStaleCache    (void);
+    void _testCorruptCache  (void);
+    void _testSeek          (void);
+    void _testTimestamp     (void);
+
+private:
+    void _writeLog(QIODevice& device, int messageCount);
+};
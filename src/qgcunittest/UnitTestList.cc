@@ -21,21 +21,31 @@
 #include "MissionItemTest.h"
 #include "SimpleMissionItemTest.h"
 #include "SurveyComplexItemTest.h"
+#include "SurveyCoverageTest.h"
 #include "MissionControllerTest.h"
 #include "MissionManagerTest.h"
 //#include "RadioConfigTest.h"
 #include "MavlinkLogTest.h"
 //#include "MainWindowTest.h"
 //#include "FileManagerTest.h"
+#include "FileManagerStreamTest.h"
+#include "FileRangeSetTest.h"
 #include "TCPLinkTest.h"
+#include "TLogExporterTest.h"
+#include "TLogIndexTest.h"
 #include "ParameterManagerTest.h"
+#include "ParameterMetaDataIndexTest.h"
 #include "MissionCommandTreeTest.h"
-//#include "LogDownloadTest.h"
+#include "LogDownloadTest.h"
 #include "SendMavCommandTest.h"
+#include "FactGroupBenchmark.h"
+#include "FactGroupTest.h"
+#include "ObserverVehicleTableBenchmark.h"
 #include "VisualMissionItemTest.h"
 #include "CameraSectionTest.h"
 #include "SpeedSectionTest.h"
 #include "PlanMasterControllerTest.h"
+#include "PlanCacheTest.h"
 #include "MissionSettingsTest.h"
 #include "QGCMapPolygonTest.h"
 #include "AudioOutputTest.h"
@@ -45,6 +55,18 @@
 #include "TransectStyleComplexItemTest.h"
 #include "CameraCalcTest.h"
 #include "FWLandingPatternTest.h"
+#include "GeoFenceIndexBenchmark.h"
+#include "ULogFileTest.h"
+#include "QGCFrameSchedulerTest.h"
+#include "MAVLinkChartDataTest.h"
+#include "TerrainQueryTest.h"
+#include "TrajectoryStoreTest.h"
+#include "CameraTriggerPointsTest.h"
+#include "ShapeFileImporterTest.h"
+#include "GeoFenceBreachMonitorTest.h"
+#include "GeoFenceIndexTest.h"
+#include "MultiVehicleManagerTest.h"
+#include "ObserverVehicleTableTest.h"
 
 UT_REGISTER_TEST(FactSystemTestGeneric)
 UT_REGISTER_TEST(FactSystemTestPX4)
@@ -59,15 +81,25 @@ UT_REGISTER_TEST(MissionControllerTest)
 UT_REGISTER_TEST(MissionManagerTest)
 //UT_REGISTER_TEST(RadioConfigTest)
 UT_REGISTER_TEST(TCPLinkTest)
+UT_REGISTER_TEST(TLogExporterTest)
+UT_REGISTER_TEST(TLogIndexTest)
 //UT_REGISTER_TEST(FileManagerTest)
+UT_REGISTER_TEST(FileManagerStreamTest)
+UT_REGISTER_TEST(FileRangeSetTest)
 UT_REGISTER_TEST(ParameterManagerTest)
+UT_REGISTER_TEST(ParameterMetaDataIndexTest)
 UT_REGISTER_TEST(MissionCommandTreeTest)
-//UT_REGISTER_TEST(LogDownloadTest)
+UT_REGISTER_TEST(LogDownloadTest)
 UT_REGISTER_TEST(SendMavCommandTest)
+UT_REGISTER_TEST(FactGroupBenchmark)
+UT_REGISTER_TEST(FactGroupTest)
+UT_REGISTER_TEST(ObserverVehicleTableBenchmark)
 UT_REGISTER_TEST(SurveyComplexItemTest)
+UT_REGISTER_TEST(SurveyCoverageTest)
 UT_REGISTER_TEST(CameraSectionTest)
 UT_REGISTER_TEST(SpeedSectionTest)
 UT_REGISTER_TEST(PlanMasterControllerTest)
+UT_REGISTER_TEST(PlanCacheTest)
 UT_REGISTER_TEST(MissionSettingsTest)
 UT_REGISTER_TEST(QGCMapPolygonTest)
 UT_REGISTER_TEST(AudioOutputTest)
@@ -77,6 +109,18 @@ UT_REGISTER_TEST(TransectStyleComplexItemTest)
 UT_REGISTER_TEST(QGCMapPolylineTest)
 UT_REGISTER_TEST(CameraCalcTest)
 UT_REGISTER_TEST(FWLandingPatternTest)
+UT_REGISTER_TEST(GeoFenceIndexBenchmark)
+UT_REGISTER_TEST(ULogFileTest)
+UT_REGISTER_TEST(QGCFrameSchedulerTest)
+UT_REGISTER_TEST(MAVLinkChartDataTest)
+UT_REGISTER_TEST(TerrainQueryTest)
+UT_REGISTER_TEST(TrajectoryStoreTest)
+UT_REGISTER_TEST(CameraTriggerPointsTest)
+UT_REGISTER_TEST(ShapeFileImporterTest)
+UT_REGISTER_TEST(GeoFenceBreachMonitorTest)
+UT_REGISTER_TEST(GeoFenceIndexTest)
+UT_REGISTER_TEST(MultiVehicleManagerTest)
+UT_REGISTER_TEST(ObserverVehicleTableTest)
 
 // List of unit test which are currently disabled.
 // If disabling a new test, include reason in comment.
@@ -26,8 +26,8 @@ FileManager::FileManager(QObject* parent, Vehicle* vehicle)
     , _vehicle(vehicle)
     , _dedicatedLink(nullptr)
     , _activeSession(0)
-    , _missingDownloadedBytes(0)
-    , _downloadingMissingParts(false)
+    , _downloadOffset(0)
+    , _refetchProgress(false)
     , _systemIdQGC(0)
 {
     connect(&_ackTimer, &QTimer::timeout, this, &FileManager::_ackTimeout);
@@ -53,13 +53,21 @@ void FileManager::_openAckResponse(Request* openAck)
     Q_ASSERT(openAck->hdr.size == sizeof(uint32_t));
     _downloadFileSize = openAck->openFileLength;
     
+    // Received data is written straight to the local file at its offset, so the file is never held in memory
+    QString downloadFilePath = _readFileDownloadDir.absoluteFilePath(_readFileDownloadFilename);
+    _downloadFile.setFileName(downloadFilePath);
+    if (!_downloadFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        _closeDownloadSession(false /* failure */);
+        _emitErrorMessage(tr("Unable to open local file for writing (%1)").arg(downloadFilePath));
+        return;
+    }
+
     // Start the sequence of read commands
 
     _downloadOffset = 0;            // Start reading at beginning of file
-    _readFileAccumulator.clear();   // Start with an empty file
-    _missingDownloadedBytes = 0;
-    _downloadingMissingParts = false;
-    _missingData.clear();
+    _downloadedRanges.clear();
+    _refetchQueue.clear();
+    _refetchOutstanding.clear();
 
     Request request;
     request.hdr.session = _activeSession;
@@ -71,74 +79,144 @@ void FileManager::_openAckResponse(Request* openAck)
     _sendRequest(&request);
 }
 
-/// request the next missing part of a (partially) downloaded file
-void FileManager::_requestMissingData()
+/// Writes a chunk of received data to the local file at the specified offset
+///     @return false: write failed, download session has been closed
+bool FileManager::_writeDownloadData(uint32_t offset, const uint8_t* data, uint32_t size)
 {
-    if (_missingData.empty()) {
-        _downloadingMissingParts = false;
-        _missingDownloadedBytes = 0;
-        // there might be more data missing at the end
-        if ((uint32_t)_readFileAccumulator.length() != _downloadFileSize) {
-            _downloadOffset = _readFileAccumulator.length();
-            qCDebug(FileManagerLog) << QString("_requestMissingData: missing parts done, downloadOffset(%1) downloadFileSize(%2)")
-                    .arg(_downloadOffset).arg(_downloadFileSize);
-        } else {
-            _closeDownloadSession(true);
-            return;
+    if (size == 0 || _downloadedRanges.contains(offset, size)) {
+        // Duplicate packet
+        return true;
+    }
+
+    if (!_downloadFile.seek(offset) || _downloadFile.write(reinterpret_cast<const char*>(data), size) != static_cast<qint64>(size)) {
+        QString downloadFilePath = _downloadFile.fileName();
+        _closeDownloadSession(false /* failure */);
+        _emitErrorMessage(tr("Unable to write data to local file (%1)").arg(downloadFilePath));
+        return false;
+    }
+    _downloadedRanges.add(offset, size);
+
+    if (_downloadFileSize != 0) {
+        emit commandProgress(100 * ((float)_downloadedRanges.totalLength() / (float)_downloadFileSize));
+    }
+
+    return true;
+}
+
+/// Starts requesting the ranges of the file which were not received during a burst download
+void FileManager::_startRefetch(const QList<FileRangeSet::Range>& holes)
+{
+    _refetchQueue.clear();
+    _refetchOutstanding.clear();
+    _refetchProgress = false;
+
+    // Split the holes into chunks which fit into a single read response
+    const uint32_t maxChunkSize = sizeof(Request::data);
+    for (const FileRangeSet::Range& hole: holes) {
+        for (uint32_t offset=hole.offset; offset<hole.offset + hole.length; offset+=maxChunkSize) {
+            _refetchQueue.enqueue({ offset, qMin(maxChunkSize, hole.offset + hole.length - offset) });
         }
-    } else {
-        qCDebug(FileManagerLog) << QString("_requestMissingData: offset(%1) size(%2)").arg(_missingData.head().offset).arg(_missingData.head().size);
+    }
+
+    qCDebug(FileManagerLog) << QString("_startRefetch: holes(%1) chunks(%2)").arg(holes.count()).arg(_refetchQueue.count());
 
-        _downloadOffset = _missingData.head().offset;
+    _currentOperation = kCORefetch;
+    _sendRefetchRequests();
+}
+
+/// Keeps up to _refetchWindowSize read requests for missing ranges outstanding
+void FileManager::_sendRefetchRequests(void)
+{
+    while (_refetchOutstanding.count() < _refetchWindowSize && !_refetchQueue.isEmpty()) {
+        FileRangeSet::Range range = _refetchQueue.dequeue();
+        _sendRefetchRequest(range.offset, range.length);
     }
 
+    if (_refetchOutstanding.isEmpty()) {
+        // Pass is complete. Short reads may have left some holes, so check again unless the server has stopped sending data.
+        if (_refetchProgress) {
+            _closeDownloadSession(true /* success */);
+        } else {
+            _closeDownloadSession(false /* failure */);
+            _emitErrorMessage(tr("Download: Unable to retrieve missing data"));
+        }
+    } else if (!_ackTimer.isActive()) {
+        _setupAckTimeout();
+    }
+}
+
+void FileManager::_sendRefetchRequest(uint32_t offset, uint32_t length)
+{
+    qCDebug(FileManagerLog) << QString("_sendRefetchRequest: offset(%1) size(%2)").arg(offset).arg(length);
+
     Request request;
-    _currentOperation = kCORead;
     request.hdr.session = _activeSession;
     request.hdr.opcode = kCmdReadFile;
-    request.hdr.offset = _downloadOffset;
-    request.hdr.size = sizeof(request.data);
+    request.hdr.offset = offset;
+    request.hdr.size = static_cast<uint8_t>(length);
 
-    _sendRequest(&request);
+    // Multiple requests are in flight at once so responses are matched up by offset instead of sequence number
+    request.hdr.seqNumber = ++_lastOutgoingRequest.hdr.seqNumber;
+    _refetchOutstanding[offset] = length;
+    _sendRequestNoAck(&request);
 }
 
-/// Closes out a download session by writing the file and doing cleanup.
+/// Respond to a Read ack while refetching missing ranges
+void FileManager::_refetchAckResponse(Request* readAck)
+{
+    if (readAck->hdr.session != _activeSession) {
+        _closeDownloadSession(false /* failure */);
+        _emitErrorMessage(tr("Download: Incorrect session returned"));
+        return;
+    }
+
+    qCDebug(FileManagerLog) << QString("_refetchAckResponse: offset(%1) size(%2)").arg(readAck->hdr.offset).arg(readAck->hdr.size);
+
+    _refetchOutstanding.remove(readAck->hdr.offset);
+
+    uint32_t receivedBefore = _downloadedRanges.totalLength();
+    if (!_writeDownloadData(readAck->hdr.offset, readAck->data, readAck->hdr.size)) {
+        return;
+    }
+    if (_downloadedRanges.totalLength() != receivedBefore) {
+        _refetchProgress = true;
+    }
+
+    _sendRefetchRequests();
+}
+
+/// Closes out a download session and does cleanup. On success any missing ranges are requested again before the download
+/// is considered complete.
 ///     @param success true: successful download completion, false: error during download
 void FileManager::_closeDownloadSession(bool success)
 {
-    qCDebug(FileManagerLog) << QString("_closeDownloadSession: success(%1) missingBytes(%2)").arg(success).arg(_missingDownloadedBytes);
+    qCDebug(FileManagerLog) << QString("_closeDownloadSession: success(%1) received(%2) fileSize(%3)").arg(success).arg(_downloadedRanges.totalLength()).arg(_downloadFileSize);
     
     _currentOperation = kCOIdle;
+    _clearAckTimeout();
+    _refetchQueue.clear();
+    _refetchOutstanding.clear();
     
     if (success) {
-        if (_missingDownloadedBytes > 0 || (uint32_t)_readFileAccumulator.length() < _downloadFileSize) {
-            // we're not done yet: request the missing parts individually (either we had missing parts or
-            // the last (few) packets right before the EOF got dropped)
-            _downloadingMissingParts = true;
-            _requestMissingData();
+        // The file size from the open ack is authoritative. Some servers report 0 for files whose size is not known up front,
+        // in which case the file is complete once there are no holes below the last received byte.
+        uint32_t fileSize = qMax(_downloadFileSize, _downloadedRanges.end());
+        QList<FileRangeSet::Range> holes = _downloadedRanges.holes(fileSize);
+        if (!holes.isEmpty()) {
+            // We're not done yet: either burst packets were dropped or the last (few) packets right before the EOF got dropped
+            _startRefetch(holes);
             return;
         }
 
-        QString downloadFilePath = _readFileDownloadDir.absoluteFilePath(_readFileDownloadFilename);
-
-        QFile file(downloadFilePath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-            _emitErrorMessage(tr("Unable to open local file for writing (%1)").arg(downloadFilePath));
-            return;
-        }
-
-        qint64 bytesWritten = file.write((const char *)_readFileAccumulator, _readFileAccumulator.length());
-        if (bytesWritten != _readFileAccumulator.length()) {
-            file.close();
-            _emitErrorMessage(tr("Unable to write data to local file (%1)").arg(downloadFilePath));
-            return;
-        }
-        file.close();
+        _downloadFile.close();
 
         emit commandComplete();
+    } else if (_downloadFile.isOpen()) {
+        // Don't leave a partial file behind
+        _downloadFile.remove();
     }
     
-    _readFileAccumulator.clear();
+    _downloadedRanges.clear();
     
     // Close the open session
     _sendResetCommand();
@@ -172,52 +250,22 @@ void FileManager::_downloadAckResponse(Request* readAck, bool readFile)
         return;
     }
 
-    if (readAck->hdr.offset != _downloadOffset) {
-        if (readFile) {
-            _closeDownloadSession(false /* failure */);
-            _emitErrorMessage(tr("Download: Offset returned (%1) differs from offset requested/expected (%2)").arg(readAck->hdr.offset).arg(_downloadOffset));
-            return;
-        } else { // burst
-            if (readAck->hdr.offset < _downloadOffset) { // old data: ignore it
-                _setupAckTimeout();
-                return;
-            }
-            // keep track of missing data chunks
-            MissingData missingData;
-            missingData.offset = _downloadOffset;
-            missingData.size = readAck->hdr.offset - _downloadOffset;
-            _missingData.push_back(missingData);
-            _missingDownloadedBytes += readAck->hdr.offset - _downloadOffset;
-            qCDebug(FileManagerLog) << QString("_downloadAckResponse: missing data: offset(%1) size(%2)").arg(missingData.offset).arg(missingData.size);
-            _downloadOffset = readAck->hdr.offset;
-            _readFileAccumulator.resize(_downloadOffset); // placeholder for the missing data
-        }
+    if (readFile && readAck->hdr.offset != _downloadOffset) {
+        _closeDownloadSession(false /* failure */);
+        _emitErrorMessage(tr("Download: Offset returned (%1) differs from offset requested/expected (%2)").arg(readAck->hdr.offset).arg(_downloadOffset));
+        return;
     }
     
     qCDebug(FileManagerLog) << QString("_downloadAckResponse: offset(%1) size(%2) burstComplete(%3)").arg(readAck->hdr.offset).arg(readAck->hdr.size).arg(readAck->hdr.burstComplete);
 
-    if (_downloadingMissingParts) {
-        Q_ASSERT(_missingData.head().offset == _downloadOffset);
-        _missingDownloadedBytes -= readAck->hdr.size;
-        _readFileAccumulator.replace(_downloadOffset, readAck->hdr.size, (const char*)readAck->data, readAck->hdr.size);
-        if (_missingData.head().size <= readAck->hdr.size) {
-            _missingData.pop_front();
-        } else {
-            _missingData.head().size -= readAck->hdr.size;
-            _missingData.head().offset += readAck->hdr.size;
-        }
-    } else {
-        _downloadOffset += readAck->hdr.size;
-        _readFileAccumulator.append((const char*)readAck->data, readAck->hdr.size);
-    }
-    
-    if (_downloadFileSize != 0) {
-        emit commandProgress(100 * ((float)(_readFileAccumulator.length() - _missingDownloadedBytes) / (float)_downloadFileSize));
+    // Burst packets may arrive out of order or with gaps. Each one is written at its own offset, anything which goes
+    // missing is picked up by the refetch once the burst is complete.
+    if (!_writeDownloadData(readAck->hdr.offset, readAck->data, readAck->hdr.size)) {
+        return;
     }
+    _downloadOffset = qMax(_downloadOffset, readAck->hdr.offset + readAck->hdr.size);
 
-    if (_downloadingMissingParts) {
-        _requestMissingData();
-    } else if (readFile || readAck->hdr.burstComplete) {
+    if (readFile || readAck->hdr.burstComplete) {
         // Possibly still more data to read, send next read request
 
         Request request;
@@ -227,7 +275,7 @@ void FileManager::_downloadAckResponse(Request* readAck, bool readFile)
         request.hdr.size = 0;
 
         _sendRequest(&request);
-    } else if (!readFile) {
+    } else {
         // Streaming, so next ack should come automatically
         _setupAckTimeout();
     }
@@ -395,8 +443,9 @@ void FileManager::receiveMessage(mavlink_message_t message)
     // Make sure we have a good sequence number
     uint16_t expectedSeqNumber = _lastOutgoingRequest.hdr.seqNumber + 1;
 
-    // ignore old/reordered packets (handle wrap-around properly)
-    if ((uint16_t)((expectedSeqNumber - 1) - incomingSeqNumber) < (std::numeric_limits<uint16_t>::max()/2)) {
+    // ignore old/reordered packets (handle wrap-around properly). While refetching there are multiple requests in flight, so
+    // responses to earlier requests are expected.
+    if (_currentOperation != kCORefetch && (uint16_t)((expectedSeqNumber - 1) - incomingSeqNumber) < (std::numeric_limits<uint16_t>::max()/2)) {
         qDebug() << "Received old packet: expected seq:" << expectedSeqNumber << "got:" << incomingSeqNumber;
         return;
     }
@@ -409,6 +458,7 @@ void FileManager::receiveMessage(mavlink_message_t message)
         bool doAbort = true;
         switch (_currentOperation) {
             case kCOBurst: // burst download drops are handled in _downloadAckResponse()
+            case kCORefetch:
                 doAbort = false;
                 break;
             case kCORead:
@@ -439,8 +489,11 @@ void FileManager::receiveMessage(mavlink_message_t message)
         }
     }
     
-    // Move past the incoming sequence number for next request
-    _lastOutgoingRequest.hdr.seqNumber = incomingSeqNumber;
+    // Move past the incoming sequence number for next request. Refetch responses can be for older requests, in which case
+    // the sequence number must not go backwards.
+    if (_currentOperation != kCORefetch) {
+        _lastOutgoingRequest.hdr.seqNumber = incomingSeqNumber;
+    }
 
     if (request->hdr.opcode == kRspAck) {
         switch (request->hdr.req_opcode) {
@@ -454,11 +507,13 @@ void FileManager::receiveMessage(mavlink_message_t message)
 				break;
 				
 			case kCmdReadFile:
-				_downloadAckResponse(request, true /* read file */);
-				break;
-				
 			case kCmdBurstReadFile:
-				_downloadAckResponse(request, false /* stream file */);
+                if (_currentOperation == kCORefetch) {
+                    // Late burst packets are still useful while refetching
+                    _refetchAckResponse(request);
+                } else {
+                    _downloadAckResponse(request, request->hdr.req_opcode == kCmdReadFile /* read file */);
+                }
 				break;
 				
             case kCmdCreateFile:
@@ -479,6 +534,20 @@ void FileManager::receiveMessage(mavlink_message_t message)
 
         // Nak's normally have 1 byte of data for error code, except for kErrFailErrno which has additional byte for errno
         Q_ASSERT((errorCode == kErrFailErrno && request->hdr.size == 2) || request->hdr.size == 1);
+
+        if (_currentOperation == kCORefetch) {
+            if (request->hdr.req_opcode == kCmdBurstReadFile) {
+                // Left over from the burst which has already completed
+                if (!_ackTimer.isActive()) {
+                    _setupAckTimeout();
+                }
+                return;
+            }
+            // All refetched ranges are within the file size returned by open, so any Nak is an error
+            _closeDownloadSession(false /* failure */);
+            _emitErrorMessage(tr("Download: Nak received refetching missing data, error: %1").arg(errorString(errorCode)));
+            return;
+        }
         
         _currentOperation = kCOIdle;
 
@@ -753,7 +822,7 @@ void FileManager::_setupAckTimeout(void)
 
     _ackNumTries = 0;
     _ackTimer.setSingleShot(false);
-    _ackTimer.start(ackTimerTimeoutMsecs);
+    _ackTimer.start(_ackTimerTimeoutMsecs);
 }
 
 /// @brief Clears the ack timeout timer
@@ -768,9 +837,15 @@ void FileManager::_ackTimeout(void)
 {
     qCDebug(FileManagerLog) << "_ackTimeout";
     
-    if (++_ackNumTries <= ackTimerMaxRetries) {
+    if (++_ackNumTries <= _ackTimerMaxRetries) {
         qCDebug(FileManagerLog) << "ack timeout - retrying";
-        if (_currentOperation == kCOBurst) {
+        if (_currentOperation == kCORefetch) {
+            // re-request everything which is still outstanding
+            const QList<uint32_t> offsets = _refetchOutstanding.keys();
+            for (uint32_t offset: offsets) {
+                _sendRefetchRequest(offset, _refetchOutstanding[offset]);
+            }
+        } else if (_currentOperation == kCOBurst) {
             // for burst downloads try to initiate a new burst
             Request request;
             request.hdr.session = _activeSession;
@@ -795,6 +870,7 @@ void FileManager::_ackTimeout(void)
     switch (_currentOperation) {
         case kCORead:
         case kCOBurst:
+        case kCORefetch:
             _closeDownloadSession(false /* failure */);
             _emitErrorMessage(tr("Timeout waiting for ack: Download failed"));
             break;
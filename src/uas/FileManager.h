@@ -12,11 +12,13 @@
 
 #include <QObject>
 #include <QDir>
+#include <QFile>
 #include <QTimer>
 #include <QQueue>
 
 #include "UASInterface.h"
 #include "QGCLoggingCategory.h"
+#include "FileRangeSet.h"
 
 #ifdef __GNUC__
   #define PACKED_STRUCT( __Declaration__ ) __Declaration__ __attribute__((packed))
@@ -57,7 +59,8 @@ public:
 	///     @param downloadDir Local directory to download file to
 	void downloadPath(const QString& from, const QDir& downloadDir);
 	
-	/// Stream downloads the specified file.
+	/// Stream downloads the specified file. Burst packets are written to the local file as they arrive, in any order. Ranges
+	/// which were dropped during the burst are requested again afterwards using multiple outstanding read requests.
 	///     @param from File to download from UAS, fully qualified path
 	///     @param downloadDir Local directory to download file to
 	void streamPath(const QString& from, const QDir& downloadDir);
@@ -186,6 +189,7 @@ private:
 			kCOOpenBurst,   // waiting for Open response, followed by Burst download
             kCORead,		// waiting for Read response
 			kCOBurst,		// waiting for Burst response
+            kCORefetch,     // waiting for Read responses for ranges missing after a Burst
             kCOWrite,       // waiting for Write response
             kCOCreate,      // waiting for Create response
             kCOCreateDir,   // waiting for Create Directory response
@@ -202,6 +206,8 @@ private:
     void _fillRequestWithString(Request* request, const QString& str);
     void _openAckResponse(Request* openAck);
     void _downloadAckResponse(Request* readAck, bool readFile);
+    void _refetchAckResponse(Request* readAck);
+    bool _writeDownloadData(uint32_t offset, const uint8_t* data, uint32_t size);
     void _listAckResponse(Request* listAck);
     void _createAckResponse(Request* createAck);
     void _writeAckResponse(Request* writeAck);
@@ -211,7 +217,9 @@ private:
     void _closeDownloadSession(bool success);
     void _closeUploadSession(bool success);
     void _downloadWorker(const QString& from, const QDir& downloadDir, bool readFile);
-    void _requestMissingData();
+    void _startRefetch(const QList<FileRangeSet::Range>& holes);
+    void _sendRefetchRequests(void);
+    void _sendRefetchRequest(uint32_t offset, uint32_t length);
     
     static QString errorString(uint8_t errorCode);
 
@@ -236,21 +244,20 @@ private:
     uint32_t    _writeFileSize;             ///< Size of file being uploaded
     QByteArray  _writeFileAccumulator;      ///< Holds file being uploaded
     
-    struct MissingData {
-        uint32_t offset;
-        uint32_t size;
-    };
-    uint32_t    _downloadOffset;            ///< current download offset
-    uint32_t    _missingDownloadedBytes;    ///< number of missing bytes for burst download
-    QQueue<MissingData> _missingData;       ///< missing chunks of downloaded file (for burst downloads)
-    bool        _downloadingMissingParts;   ///< true if we are currently downloading missing parts
-    QByteArray  _readFileAccumulator;       ///< Holds file being downloaded
+    uint32_t                        _downloadOffset;        ///< current download offset, highest offset received for burst downloads
+    QFile                           _downloadFile;          ///< Local file which received data is written to as it arrives
+    FileRangeSet                    _downloadedRanges;      ///< Ranges of the file which have been received
+    QQueue<FileRangeSet::Range>     _refetchQueue;          ///< Missing ranges still to be requested
+    QMap<uint32_t, uint32_t>        _refetchOutstanding;    ///< Missing ranges which have been requested: offset -> length
+    bool                            _refetchProgress;       ///< true: data was received during the current refetch pass
     QDir        _readFileDownloadDir;       ///< Directory to download file to
     QString     _readFileDownloadFilename;  ///< Filename (no path) for download file
     uint32_t    _downloadFileSize;          ///< Size of file being downloaded
 
     uint8_t     _systemIdQGC;               ///< System ID for QGC
     uint8_t     _systemIdServer;            ///< System ID for server
+
+    static const int _refetchWindowSize = 4;    ///< Maximum number of outstanding read requests while refetching missing ranges
     
     // We give MockLinkFileServer friend access so that it can use the data structures and opcodes
     // to build a mock mavlink file server for testing.
@@ -0,0 +1,79 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FileRangeSet.h"
+
+void FileRangeSet::clear(void)
+{
+    _ranges.clear();
+    _totalLength = 0;
+}
+
+void FileRangeSet::add(uint32_t offset, uint32_t length)
+{
+    if (length == 0) {
+        return;
+    }
+
+    uint32_t start  = offset;
+    uint32_t end    = offset + length;
+
+    // Start with the range which begins at or before the new range, since it may overlap or touch it
+    auto iter = _ranges.upperBound(start);
+    if (iter != _ranges.begin()) {
+        auto prev = iter - 1;
+        if (prev.value() >= start) {
+            iter = prev;
+        }
+    }
+
+    // Swallow all ranges which overlap or touch the new range
+    while (iter != _ranges.end() && iter.key() <= end) {
+        start = qMin(start, iter.key());
+        end = qMax(end, iter.value());
+        _totalLength -= iter.value() - iter.key();
+        iter = _ranges.erase(iter);
+    }
+
+    _ranges.insert(start, end);
+    _totalLength += end - start;
+}
+
+bool FileRangeSet::contains(uint32_t offset, uint32_t length) const
+{
+    auto iter = _ranges.upperBound(offset);
+    if (iter == _ranges.constBegin()) {
+        return false;
+    }
+    iter--;
+    return iter.value() >= offset + length;
+}
+
+uint32_t FileRangeSet::end(void) const
+{
+    return _ranges.isEmpty() ? 0 : _ranges.last();
+}
+
+QList<FileRangeSet::Range> FileRangeSet::holes(uint32_t size) const
+{
+    QList<Range> holes;
+
+    uint32_t offset = 0;
+    for (auto iter = _ranges.constBegin(); iter != _ranges.constEnd() && offset < size; iter++) {
+        if (iter.key() > offset) {
+            holes.append({ offset, qMin(iter.key(), size) - offset });
+        }
+        offset = iter.value();
+    }
+    if (offset < size) {
+        holes.append({ offset, size - offset });
+    }
+
+    return holes;
+}
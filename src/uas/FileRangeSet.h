@@ -0,0 +1,47 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QMap>
+#include <QList>
+
+/// Set of non-overlapping byte ranges within a file. Used by FileManager to keep track of which parts of a download have
+/// been received so the holes left by dropped or reordered burst packets can be requested again.
+class FileRangeSet
+{
+public:
+    struct Range {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    void clear(void);
+
+    /// Adds the specified range to the set, merging it with any overlapping or adjacent ranges
+    void add(uint32_t offset, uint32_t length);
+
+    /// @return true: the specified range is entirely contained within the set
+    bool contains(uint32_t offset, uint32_t length) const;
+
+    /// @return Total number of bytes covered by the set
+    uint32_t totalLength(void) const { return _totalLength; }
+
+    /// @return One past the last byte covered by the set, 0 for an empty set
+    uint32_t end(void) const;
+
+    /// @return The ranges within [0, size) which are not covered by the set
+    QList<Range> holes(uint32_t size) const;
+
+    int count(void) const { return _ranges.count(); }
+
+private:
+    QMap<uint32_t, uint32_t>    _ranges;            ///< Range start offset -> range end offset (exclusive)
+    uint32_t                    _totalLength = 0;
+};
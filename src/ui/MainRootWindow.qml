@@ -344,6 +344,10 @@ ApplicationWindow {
         }
     }
 
+    //-------------------------------------------------------------------------
+    // The views below are not visible at startup. They are compiled and created asynchronously so they do not delay the
+    // first frame of the Fly view.
+
     //-------------------------------------------------------------------------
     /// Plan View
     Loader {
@@ -351,6 +355,7 @@ ApplicationWindow {
         anchors.fill:   parent
         visible:        false
         source:         "PlanView.qml"
+        asynchronous:   true
     }
 
     //-------------------------------------------------------------------------
@@ -360,6 +365,7 @@ ApplicationWindow {
         anchors.fill:   parent
         visible:        false
         source:         "AppSettings.qml"
+        asynchronous:   true
     }
 
     //-------------------------------------------------------------------------
@@ -369,6 +375,7 @@ ApplicationWindow {
         anchors.fill:   parent
         visible:        false
         source:         "SetupView.qml"
+        asynchronous:   true
     }
 
     //-------------------------------------------------------------------------
@@ -378,6 +385,7 @@ ApplicationWindow {
         anchors.fill:   parent
         visible:        false
         source:         "AnalyzeView.qml"
+        asynchronous:   true
     }
 
     //-------------------------------------------------------------------------
@@ -618,6 +618,17 @@ Rectangle {
                                     fact:                   QGroundControl.settingsManager.appSettings.defaultMissionItemAltitude
                                 }
                             }
+
+                            RowLayout {
+                                spacing:    ScreenTools.defaultFontPixelWidth
+                                visible:    QGroundControl.settingsManager.planViewSettings.importSimplifyTolerance.visible
+
+                                QGCLabel { text: qsTr("KML/SHP Import Simplification") }
+                                FactTextField {
+                                    Layout.preferredWidth:  _valueFieldWidth
+                                    fact:                   QGroundControl.settingsManager.planViewSettings.importSimplifyTolerance
+                                }
+                            }
                         }
                     }
 